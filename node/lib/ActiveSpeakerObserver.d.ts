@@ -3,6 +3,17 @@ import { Producer } from './Producer';
 import { EnhancedEventEmitter } from './EnhancedEventEmitter';
 export interface ActiveSpeakerObserverOptions {
     interval?: number;
+    /**
+     * If given, Consumers added to the observer are forwarded only while their
+     * speaker is one of the lastN most recent dominant speakers.
+     */
+    lastN?: number;
+    /**
+     * What to do with Consumers whose speaker is not one of the lastN ones:
+     * 'pause' them (default) or 'downgrade' them to their lowest layers (only
+     * simulcast and SVC Consumers, others are paused).
+     */
+    lastNMode?: 'pause' | 'downgrade';
     /**
      * Custom application data.
      */
@@ -14,15 +25,38 @@ export interface ActiveSpeakerObserverActivity {
      */
     producer: Producer;
 }
+export declare type ActiveSpeakerObserverAddConsumerOptions = {
+    /**
+     * The id of the Consumer to be added.
+     */
+    consumerId: string;
+    /**
+     * The id of the audio Producer (already added to the observer) of the
+     * speaker whose activity drives the Consumer.
+     */
+    producerId: string;
+};
+export declare type ActiveSpeakerObserverRemoveConsumerOptions = {
+    /**
+     * The id of the Consumer to be removed.
+     */
+    consumerId: string;
+};
 export declare type ActiveSpeakerObserverEvents = RtpObserverEvents & {
     dominantspeaker: [{
         producer: Producer;
     }];
+    lastnchange: [{
+        producers: Producer[];
+    }];
 };
 export declare type ActiveSpeakerObserverObserverEvents = RtpObserverObserverEvents & {
     dominantspeaker: [{
         producer: Producer;
     }];
+    lastnchange: [{
+        producers: Producer[];
+    }];
 };
 export declare class ActiveSpeakerObserver extends RtpObserver<ActiveSpeakerObserverEvents> {
     /**
@@ -33,6 +67,14 @@ export declare class ActiveSpeakerObserver extends RtpObserver<ActiveSpeakerObse
      * Observer.
      */
     get observer(): EnhancedEventEmitter<ActiveSpeakerObserverObserverEvents>;
+    /**
+     * Add a Consumer to be paused or downgraded by the last-N policy.
+     */
+    addConsumer({ consumerId, producerId }: ActiveSpeakerObserverAddConsumerOptions): Promise<void>;
+    /**
+     * Remove a Consumer from the last-N policy (it is forwarded normally again).
+     */
+    removeConsumer({ consumerId }: ActiveSpeakerObserverRemoveConsumerOptions): Promise<void>;
     private handleWorkerNotifications;
 }
 //# sourceMappingURL=ActiveSpeakerObserver.d.ts.map
\ No newline at end of file
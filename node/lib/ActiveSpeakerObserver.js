@@ -18,6 +18,22 @@ class ActiveSpeakerObserver extends RtpObserver_1.RtpObserver {
     get observer() {
         return super.observer;
     }
+    /**
+     * Add a Consumer to be paused or downgraded by the last-N policy.
+     */
+    async addConsumer({ consumerId, producerId }) {
+        logger.debug('addConsumer()');
+        const reqData = { consumerId, producerId };
+        await this.channel.request('rtpObserver.addConsumer', this.internal, reqData);
+    }
+    /**
+     * Remove a Consumer from the last-N policy (it is forwarded normally again).
+     */
+    async removeConsumer({ consumerId }) {
+        logger.debug('removeConsumer()');
+        const reqData = { consumerId };
+        await this.channel.request('rtpObserver.removeConsumer', this.internal, reqData);
+    }
     handleWorkerNotifications() {
         this.channel.on(this.internal.rtpObserverId, (event, data) => {
             switch (event) {
@@ -30,6 +46,16 @@ class ActiveSpeakerObserver extends RtpObserver_1.RtpObserver {
                         this.observer.safeEmit('dominantspeaker', dominantSpeaker);
                         break;
                     }
+                case 'lastnchange':
+                    {
+                        const lastN = {
+                            producers: data.producerIds
+                                .map((producerId) => this.getProducerById(producerId))
+                        };
+                        this.safeEmit('lastnchange', lastN);
+                        this.observer.safeEmit('lastnchange', lastN);
+                        break;
+                    }
                 default:
                     {
                         logger.error('ignoring unknown event "%s"', event);
@@ -12,9 +12,16 @@ export interface AudioLevelObserverOptions {
      */
     threshold?: number;
     /**
-     * Interval in ms for checking audio volumes. Default 1000.
+     * Interval in ms for checking audio volumes. Default 1000. Minimum 250 (50
+     * if binaryVolumes is set).
      */
     interval?: number;
+    /**
+     * Whether the worker sends the 'volumes' events in binary format over the
+     * PayloadChannel instead of in JSON, which is cheaper for meters with short
+     * intervals. Default false.
+     */
+    binaryVolumes?: boolean;
     /**
      * Custom application data.
      */
@@ -49,5 +56,6 @@ export declare class AudioLevelObserver extends RtpObserver<AudioLevelObserverEv
      */
     get observer(): EnhancedEventEmitter<AudioLevelObserverObserverEvents>;
     private handleWorkerNotifications;
+    private handleVolumes;
 }
 //# sourceMappingURL=AudioLevelObserver.d.ts.map
\ No newline at end of file
@@ -23,19 +23,7 @@ class AudioLevelObserver extends RtpObserver_1.RtpObserver {
             switch (event) {
                 case 'volumes':
                     {
-                        // Get the corresponding Producer instance and remove entries with
-                        // no Producer (it may have been closed in the meanwhile).
-                        const volumes = data
-                            .map(({ producerId, volume }) => ({
-                            producer: this.getProducerById(producerId),
-                            volume
-                        }))
-                            .filter(({ producer }) => producer);
-                        if (volumes.length > 0) {
-                            this.safeEmit('volumes', volumes);
-                            // Emit observer event.
-                            this.observer.safeEmit('volumes', volumes);
-                        }
+                        this.handleVolumes(data);
                         break;
                     }
                 case 'silence':
@@ -51,6 +39,50 @@ class AudioLevelObserver extends RtpObserver_1.RtpObserver {
                     }
             }
         });
+        this.payloadChannel.on(this.internal.rtpObserverId, (event, data, payload) => {
+            switch (event) {
+                case 'volumes':
+                    {
+                        this.handleVolumes(parseBinaryVolumes(payload));
+                        break;
+                    }
+                default:
+                    {
+                        logger.error('ignoring unknown event "%s" in payload channel listener', event);
+                    }
+            }
+        });
+    }
+    handleVolumes(entries) {
+        // Get the corresponding Producer instance and remove entries with
+        // no Producer (it may have been closed in the meanwhile).
+        const volumes = entries
+            .map(({ producerId, volume }) => ({
+            producer: this.getProducerById(producerId),
+            volume
+        }))
+            .filter(({ producer }) => producer);
+        if (volumes.length > 0) {
+            this.safeEmit('volumes', volumes);
+            // Emit observer event.
+            this.observer.safeEmit('volumes', volumes);
+        }
     }
 }
 exports.AudioLevelObserver = AudioLevelObserver;
+/**
+ * Each entry of the binary 'volumes' notification is the volume (int8), the
+ * length of the Producer id (uint8) and the Producer id.
+ */
+function parseBinaryVolumes(payload) {
+    const entries = [];
+    let offset = 0;
+    while (offset + 2 <= payload.length) {
+        const volume = payload.readInt8(offset);
+        const producerIdLength = payload.readUInt8(offset + 1);
+        const producerId = payload.toString('utf8', offset + 2, offset + 2 + producerIdLength);
+        entries.push({ producerId, volume });
+        offset += 2 + producerIdLength;
+    }
+    return entries;
+}
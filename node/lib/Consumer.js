@@ -179,6 +179,45 @@ class Consumer extends EnhancedEventEmitter_1.EnhancedEventEmitter {
         // Emit observer event.
         this.#observer.safeEmit('close');
     }
+    /**
+     * Request to be sent within a Router bulk request.
+     *
+     * @private
+     */
+    getBulkRequest(method, data) {
+        return { method, internal: this.#internal, data };
+    }
+    /**
+     * Consumer was paused (by pause() or a Router bulk request).
+     *
+     * @private
+     */
+    handlePaused(wasPaused) {
+        this.#paused = true;
+        // Emit observer event.
+        if (!wasPaused)
+            this.#observer.safeEmit('pause');
+    }
+    /**
+     * Consumer was resumed (by resume() or a Router bulk request).
+     *
+     * @private
+     */
+    handleResumed(wasPaused) {
+        this.#paused = false;
+        // Emit observer event.
+        if (wasPaused && !this.#producerPaused)
+            this.#observer.safeEmit('resume');
+    }
+    /**
+     * Preferred layers were set (by setPreferredLayers() or a Router bulk
+     * request).
+     *
+     * @private
+     */
+    handlePreferredLayers(preferredLayers) {
+        this.#preferredLayers = preferredLayers || undefined;
+    }
     /**
      * Dump Consumer.
      */
@@ -200,10 +239,7 @@ class Consumer extends EnhancedEventEmitter_1.EnhancedEventEmitter {
         logger.debug('pause()');
         const wasPaused = this.#paused || this.#producerPaused;
         await this.#channel.request('consumer.pause', this.#internal);
-        this.#paused = true;
-        // Emit observer event.
-        if (!wasPaused)
-            this.#observer.safeEmit('pause');
+        this.handlePaused(wasPaused);
     }
     /**
      * Resume the Consumer.
@@ -212,10 +248,7 @@ class Consumer extends EnhancedEventEmitter_1.EnhancedEventEmitter {
         logger.debug('resume()');
         const wasPaused = this.#paused || this.#producerPaused;
         await this.#channel.request('consumer.resume', this.#internal);
-        this.#paused = false;
-        // Emit observer event.
-        if (wasPaused && !this.#producerPaused)
-            this.#observer.safeEmit('resume');
+        this.handleResumed(wasPaused);
     }
     /**
      * Set preferred video layers.
@@ -224,7 +257,7 @@ class Consumer extends EnhancedEventEmitter_1.EnhancedEventEmitter {
         logger.debug('setPreferredLayers()');
         const reqData = { spatialLayer, temporalLayer };
         const data = await this.#channel.request('consumer.setPreferredLayers', this.#internal, reqData);
-        this.#preferredLayers = data || undefined;
+        this.handlePreferredLayers(data);
     }
     /**
      * Set priority.
@@ -42,6 +42,18 @@ export declare type PipeTransportOptions = {
      * with remote SRTP parameters. Default false.
      */
     enableSrtp?: boolean;
+    /**
+     * Bundle RTP and RTCP packets into datagrams of up to 1400 bytes. Useful to
+     * reduce the number of datagrams (and SRTP operations) if both Routers are
+     * located in different hosts. For this to work, both PipeTransports must
+     * enable this setting. Default false.
+     */
+    enableBundling?: boolean;
+    /**
+     * Max time (in ms) a packet waits for a bundle to be sent if enableBundling
+     * is set. Default 1.
+     */
+    bundlingMaxDelay?: number;
     /**
      * Custom application data.
      */
@@ -25,11 +25,36 @@ export declare type ProducerOptions = {
      * after having asked a previous one. Default 0.
      */
     keyFrameRequestDelay?: number;
+    /**
+     * Just for video. Max size (in bytes) of the latest key frame and following
+     * packets kept for each RTP stream, so new Consumers (or simulcast layer
+     * switches) can start without asking the sender for a new key frame.
+     * Default 0 (disabled).
+     */
+    keyFrameCacheMaxSize?: number;
+    /**
+     * State of the Producer this one continues, as given by
+     * webRtcTransport.exportState(). rtpParameters must be the same as those of
+     * that Producer.
+     */
+    importState?: ProducerExportedState;
     /**
      * Custom application data.
      */
     appData?: Record<string, unknown>;
 };
+/**
+ * Sequence state of the RTP streams of a Producer in an exported
+ * WebRtcTransport. It must be given as is.
+ */
+export declare type ProducerExportedState = {
+    rtpState: {
+        ssrc: number;
+        maxSeq: number;
+        cycles: number;
+        maxPacketTs: number;
+    }[];
+};
 /**
  * Valid types for 'trace' event.
  */
@@ -7,7 +7,7 @@ import { PlainTransport, PlainTransportOptions } from './PlainTransport';
 import { PipeTransport, PipeTransportOptions } from './PipeTransport';
 import { DirectTransport, DirectTransportOptions } from './DirectTransport';
 import { Producer } from './Producer';
-import { Consumer } from './Consumer';
+import { Consumer, ConsumerLayers, ConsumerOptions } from './Consumer';
 import { DataProducer } from './DataProducer';
 import { DataConsumer } from './DataConsumer';
 import { RtpObserver } from './RtpObserver';
@@ -77,6 +77,26 @@ export declare type PipeToRouterResult = {
      */
     pipeDataProducer?: DataProducer;
 };
+export declare type ConsumeManyItem = {
+    /**
+     * Transport in which the Consumer must be created.
+     */
+    transport: Transport;
+    /**
+     * Same options as in transport.consume().
+     */
+    options: ConsumerOptions;
+};
+export declare type ConsumerPreferredLayersItem = {
+    /**
+     * The Consumer.
+     */
+    consumer: Consumer;
+    /**
+     * Same as in consumer.setPreferredLayers().
+     */
+    preferredLayers: ConsumerLayers;
+};
 declare type PipeTransportPair = {
     [key: string]: PipeTransport;
 };
@@ -147,7 +167,14 @@ export declare class Router extends EnhancedEventEmitter<RouterEvents> {
     /**
      * Create a WebRtcTransport.
      */
-    createWebRtcTransport({ webRtcServer, listenIps, port, enableUdp, enableTcp, preferUdp, preferTcp, initialAvailableOutgoingBitrate, enableSctp, numSctpStreams, maxSctpMessageSize, sctpSendBufferSize, appData }: WebRtcTransportOptions): Promise<WebRtcTransport>;
+    createWebRtcTransport({ webRtcServer, listenIps, port, importState, enableUdp, enableTcp, preferUdp, preferTcp, initialAvailableOutgoingBitrate, enableSctp, numSctpStreams, maxSctpMessageSize, sctpSendBufferSize, appData }: WebRtcTransportOptions): Promise<WebRtcTransport>;
+    /**
+     * Get ready to receive the UDP sockets of a WebRtcTransport exported from
+     * another Worker. It returns the Unix socket path to which they must be sent.
+     *
+     * @private
+     */
+    prepareWebRtcTransportImport(): Promise<string>;
     /**
      * Create a PlainTransport.
      */
@@ -155,7 +182,7 @@ export declare class Router extends EnhancedEventEmitter<RouterEvents> {
     /**
      * Create a PipeTransport.
      */
-    createPipeTransport({ listenIp, port, enableSctp, numSctpStreams, maxSctpMessageSize, sctpSendBufferSize, enableRtx, enableSrtp, appData }: PipeTransportOptions): Promise<PipeTransport>;
+    createPipeTransport({ listenIp, port, enableSctp, numSctpStreams, maxSctpMessageSize, sctpSendBufferSize, enableRtx, enableSrtp, enableBundling, bundlingMaxDelay, appData }: PipeTransportOptions): Promise<PipeTransport>;
     /**
      * Create a DirectTransport.
      */
@@ -171,11 +198,33 @@ export declare class Router extends EnhancedEventEmitter<RouterEvents> {
     /**
      * Create an ActiveSpeakerObserver
      */
-    createActiveSpeakerObserver({ interval, appData }?: ActiveSpeakerObserverOptions): Promise<ActiveSpeakerObserver>;
+    createActiveSpeakerObserver({ interval, lastN, lastNMode, appData }?: ActiveSpeakerObserverOptions): Promise<ActiveSpeakerObserver>;
     /**
      * Create an AudioLevelObserver.
      */
-    createAudioLevelObserver({ maxEntries, threshold, interval, appData }?: AudioLevelObserverOptions): Promise<AudioLevelObserver>;
+    createAudioLevelObserver({ maxEntries, threshold, interval, binaryVolumes, appData }?: AudioLevelObserverOptions): Promise<AudioLevelObserver>;
+    /**
+     * Create many Consumers (in the same or different Transports of this Router)
+     * within a single request to the worker. For each given item, the created
+     * Consumer or the Error that prevented its creation is returned.
+     */
+    consumeMany(items: ConsumeManyItem[]): Promise<(Consumer | Error)[]>;
+    /**
+     * Pause many Consumers within a single request to the worker. For each given
+     * Consumer, the Error that prevented pausing it (if any) is returned.
+     */
+    pauseConsumers(consumers: Consumer[]): Promise<(Error | undefined)[]>;
+    /**
+     * Resume many Consumers within a single request to the worker. For each given
+     * Consumer, the Error that prevented resuming it (if any) is returned.
+     */
+    resumeConsumers(consumers: Consumer[]): Promise<(Error | undefined)[]>;
+    /**
+     * Set preferred video layers of many Consumers within a single request to the
+     * worker. For each given item, the Error that prevented setting them (if any)
+     * is returned.
+     */
+    setConsumersPreferredLayers(items: ConsumerPreferredLayersItem[]): Promise<(Error | undefined)[]>;
     /**
      * Check whether the given RTP capabilities can consume the given Producer.
      */
@@ -183,6 +232,11 @@ export declare class Router extends EnhancedEventEmitter<RouterEvents> {
         producerId: string;
         rtpCapabilities: RtpCapabilities;
     }): boolean;
+    /**
+     * Send the given requests within a single bulk request. Bitrate distribution
+     * and key frame requests needed by them are done once in the worker.
+     */
+    private bulkRequest;
 }
 export {};
 //# sourceMappingURL=Router.d.ts.map
\ No newline at end of file
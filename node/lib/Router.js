@@ -160,10 +160,11 @@ class Router extends EnhancedEventEmitter_1.EnhancedEventEmitter {
     /**
      * Create a WebRtcTransport.
      */
-    async createWebRtcTransport({ webRtcServer, listenIps, port, enableUdp = true, enableTcp = false, preferUdp = false, preferTcp = false, initialAvailableOutgoingBitrate = 600000, enableSctp = false, numSctpStreams = { OS: 1024, MIS: 1024 }, maxSctpMessageSize = 262144, sctpSendBufferSize = 262144, appData }) {
+    async createWebRtcTransport({ webRtcServer, listenIps, port, importState, enableUdp = true, enableTcp = false, preferUdp = false, preferTcp = false, initialAvailableOutgoingBitrate = 600000, enableSctp = false, numSctpStreams = { OS: 1024, MIS: 1024 }, maxSctpMessageSize = 262144, sctpSendBufferSize = 262144, appData }) {
         logger.debug('createWebRtcTransport()');
-        if (!webRtcServer && !Array.isArray(listenIps))
-            throw new TypeError('missing webRtcServer and listenIps (one of them is mandatory)');
+        if (!webRtcServer && !Array.isArray(listenIps) && !importState) {
+            throw new TypeError('missing webRtcServer, listenIps and importState (one of them is mandatory)');
+        }
         else if (appData && typeof appData !== 'object')
             throw new TypeError('if given, appData must be an object');
         if (listenIps) {
@@ -190,6 +191,7 @@ class Router extends EnhancedEventEmitter_1.EnhancedEventEmitter {
             webRtcServerId: webRtcServer ? webRtcServer.id : undefined,
             listenIps,
             port,
+            importState,
             enableUdp,
             enableTcp,
             preferUdp,
@@ -227,6 +229,17 @@ class Router extends EnhancedEventEmitter_1.EnhancedEventEmitter {
         this.#observer.safeEmit('newtransport', transport);
         return transport;
     }
+    /**
+     * Get ready to receive the UDP sockets of a WebRtcTransport exported from
+     * another Worker. It returns the Unix socket path to which they must be sent.
+     *
+     * @private
+     */
+    async prepareWebRtcTransportImport() {
+        logger.debug('prepareWebRtcTransportImport()');
+        const { socketPath } = await this.#channel.request('router.prepareWebRtcTransportImport', this.#internal);
+        return socketPath;
+    }
     /**
      * Create a PlainTransport.
      */
@@ -288,7 +301,7 @@ class Router extends EnhancedEventEmitter_1.EnhancedEventEmitter {
     /**
      * Create a PipeTransport.
      */
-    async createPipeTransport({ listenIp, port, enableSctp = false, numSctpStreams = { OS: 1024, MIS: 1024 }, maxSctpMessageSize = 268435456, sctpSendBufferSize = 268435456, enableRtx = false, enableSrtp = false, appData }) {
+    async createPipeTransport({ listenIp, port, enableSctp = false, numSctpStreams = { OS: 1024, MIS: 1024 }, maxSctpMessageSize = 268435456, sctpSendBufferSize = 268435456, enableRtx = false, enableSrtp = false, enableBundling = false, bundlingMaxDelay, appData }) {
         logger.debug('createPipeTransport()');
         if (!listenIp)
             throw new TypeError('missing listenIp');
@@ -317,7 +330,9 @@ class Router extends EnhancedEventEmitter_1.EnhancedEventEmitter {
             sctpSendBufferSize,
             isDataChannel: false,
             enableRtx,
-            enableSrtp
+            enableSrtp,
+            enableBundling,
+            bundlingMaxDelay
         };
         const data = await this.#channel.request('router.createPipeTransport', internal, reqData);
         const transport = new PipeTransport_1.PipeTransport({
@@ -560,12 +575,12 @@ class Router extends EnhancedEventEmitter_1.EnhancedEventEmitter {
     /**
      * Create an ActiveSpeakerObserver
      */
-    async createActiveSpeakerObserver({ interval = 300, appData } = {}) {
+    async createActiveSpeakerObserver({ interval = 300, lastN, lastNMode, appData } = {}) {
         logger.debug('createActiveSpeakerObserver()');
         if (appData && typeof appData !== 'object')
             throw new TypeError('if given, appData must be an object');
         const internal = { ...this.#internal, rtpObserverId: (0, uuid_1.v4)() };
-        const reqData = { interval };
+        const reqData = { interval, lastN, lastNMode };
         await this.#channel.request('router.createActiveSpeakerObserver', internal, reqData);
         const activeSpeakerObserver = new ActiveSpeakerObserver_1.ActiveSpeakerObserver({
             internal,
@@ -585,12 +600,12 @@ class Router extends EnhancedEventEmitter_1.EnhancedEventEmitter {
     /**
      * Create an AudioLevelObserver.
      */
-    async createAudioLevelObserver({ maxEntries = 1, threshold = -80, interval = 1000, appData } = {}) {
+    async createAudioLevelObserver({ maxEntries = 1, threshold = -80, interval = 1000, binaryVolumes = false, appData } = {}) {
         logger.debug('createAudioLevelObserver()');
         if (appData && typeof appData !== 'object')
             throw new TypeError('if given, appData must be an object');
         const internal = { ...this.#internal, rtpObserverId: (0, uuid_1.v4)() };
-        const reqData = { maxEntries, threshold, interval };
+        const reqData = { maxEntries, threshold, interval, binaryVolumes };
         await this.#channel.request('router.createAudioLevelObserver', internal, reqData);
         const audioLevelObserver = new AudioLevelObserver_1.AudioLevelObserver({
             internal,
@@ -607,6 +622,90 @@ class Router extends EnhancedEventEmitter_1.EnhancedEventEmitter {
         this.#observer.safeEmit('newrtpobserver', audioLevelObserver);
         return audioLevelObserver;
     }
+    /**
+     * Create many Consumers (in the same or different Transports of this Router)
+     * within a single request to the worker. For each given item, the created
+     * Consumer or the Error that prevented its creation is returned.
+     */
+    async consumeMany(items) {
+        logger.debug('consumeMany()');
+        if (!Array.isArray(items))
+            throw new TypeError('missing items');
+        const results = new Array(items.length);
+        const consumeItems = [];
+        for (let idx = 0; idx < items.length; ++idx) {
+            const { transport, options } = items[idx];
+            try {
+                if (!transport || !this.#transports.has(transport.id))
+                    throw new TypeError('Transport not found in this Router');
+                else if (transport.constructor.name === 'PipeTransport')
+                    throw new TypeError('PipeTransport not supported');
+                // This may throw.
+                const consumeRequest = transport.prepareConsume(options);
+                consumeItems.push({ idx, transport, consumeRequest });
+            }
+            catch (error) {
+                results[idx] = error;
+            }
+        }
+        const responses = await this.bulkRequest(consumeItems.map(({ consumeRequest }) => ({
+            method: 'transport.consume',
+            internal: consumeRequest.internal,
+            data: consumeRequest.reqData
+        })));
+        consumeItems.forEach(({ idx, transport, consumeRequest }, responseIdx) => {
+            const response = responses[responseIdx];
+            results[idx] = response.accepted
+                ? transport.createConsumer(consumeRequest, response.data)
+                : bulkResponseError(response);
+        });
+        return results;
+    }
+    /**
+     * Pause many Consumers within a single request to the worker. For each given
+     * Consumer, the Error that prevented pausing it (if any) is returned.
+     */
+    async pauseConsumers(consumers) {
+        logger.debug('pauseConsumers()');
+        const wasPaused = consumers.map((consumer) => (consumer.paused || consumer.producerPaused));
+        const responses = await this.bulkRequest(consumers.map((consumer) => consumer.getBulkRequest('consumer.pause')));
+        return responses.map((response, idx) => {
+            if (!response.accepted)
+                return bulkResponseError(response);
+            consumers[idx].handlePaused(wasPaused[idx]);
+        });
+    }
+    /**
+     * Resume many Consumers within a single request to the worker. For each given
+     * Consumer, the Error that prevented resuming it (if any) is returned.
+     */
+    async resumeConsumers(consumers) {
+        logger.debug('resumeConsumers()');
+        const wasPaused = consumers.map((consumer) => (consumer.paused || consumer.producerPaused));
+        const responses = await this.bulkRequest(consumers.map((consumer) => consumer.getBulkRequest('consumer.resume')));
+        return responses.map((response, idx) => {
+            if (!response.accepted)
+                return bulkResponseError(response);
+            consumers[idx].handleResumed(wasPaused[idx]);
+        });
+    }
+    /**
+     * Set preferred video layers of many Consumers within a single request to the
+     * worker. For each given item, the Error that prevented setting them (if any)
+     * is returned.
+     */
+    async setConsumersPreferredLayers(items) {
+        logger.debug('setConsumersPreferredLayers()');
+        const responses = await this.bulkRequest(items.map(({ consumer, preferredLayers }) => (consumer.getBulkRequest('consumer.setPreferredLayers', {
+            spatialLayer: preferredLayers.spatialLayer,
+            temporalLayer: preferredLayers.temporalLayer
+        }))));
+        return responses.map((response, idx) => {
+            if (!response.accepted)
+                return bulkResponseError(response);
+            items[idx].consumer.handlePreferredLayers(response.data);
+        });
+    }
     /**
      * Check whether the given RTP capabilities can consume the given Producer.
      */
@@ -624,5 +723,23 @@ class Router extends EnhancedEventEmitter_1.EnhancedEventEmitter {
             return false;
         }
     }
+    /**
+     * Send the given requests within a single bulk request. Bitrate distribution
+     * and key frame requests needed by them are done once in the worker.
+     */
+    async bulkRequest(requests) {
+        if (requests.length === 0)
+            return [];
+        const data = await this.#channel.request('router.bulkRequest', this.#internal, { requests });
+        return data.responses;
+    }
 }
 exports.Router = Router;
+function bulkResponseError(response) {
+    switch (response.error) {
+        case 'TypeError':
+            return new TypeError(response.reason);
+        default:
+            return new Error(response.reason);
+    }
+}
@@ -73,6 +73,15 @@ export declare type TransportObserverEvents = {
     newdataconsumer: [DataConsumer];
     trace: [TransportTraceEventData];
 };
+/**
+ * @private
+ */
+export declare type ConsumeRequest = {
+    internal: any;
+    reqData: any;
+    data: any;
+    appData?: Record<string, unknown>;
+};
 export declare class Transport<Events extends TransportEvents = TransportEvents, ObserverEvents extends TransportObserverEvents = TransportObserverEvents> extends EnhancedEventEmitter<Events> {
     #private;
     protected readonly internal: {
@@ -170,13 +179,25 @@ export declare class Transport<Events extends TransportEvents = TransportEvents,
     /**
      * Create a Producer.
      */
-    produce({ id, kind, rtpParameters, paused, keyFrameRequestDelay, appData }: ProducerOptions): Promise<Producer>;
+    produce({ id, kind, rtpParameters, paused, keyFrameRequestDelay, keyFrameCacheMaxSize, appData }: ProducerOptions): Promise<Producer>;
     /**
      * Create a Consumer.
      *
      * @virtual
      */
-    consume({ producerId, rtpCapabilities, paused, mid, preferredLayers, ignoreDtx, pipe, appData }: ConsumerOptions): Promise<Consumer>;
+    consume(options: ConsumerOptions): Promise<Consumer>;
+    /**
+     * Validate the given options and build the request to create a Consumer.
+     *
+     * @private
+     */
+    prepareConsume({ producerId, rtpCapabilities, paused, mid, preferredLayers, ignoreDtx, redThreshold, fecMinRtt, pipe, importState, appData }: ConsumerOptions): ConsumeRequest;
+    /**
+     * Create the Consumer once the worker has created it.
+     *
+     * @private
+     */
+    createConsumer({ internal, data, appData }: ConsumeRequest, status: any): Consumer;
     /**
      * Create a DataProducer.
      */
@@ -275,7 +275,7 @@ class Transport extends EnhancedEventEmitter_1.EnhancedEventEmitter {
     /**
      * Create a Producer.
      */
-    async produce({ id = undefined, kind, rtpParameters, paused = false, keyFrameRequestDelay, appData }) {
+    async produce({ id = undefined, kind, rtpParameters, paused = false, keyFrameRequestDelay, keyFrameCacheMaxSize, importState, appData }) {
         logger.debug('produce()');
         if (id && this.#producers.has(id))
             throw new TypeError(`a Producer with same id "${id}" already exists`);
@@ -283,6 +283,8 @@ class Transport extends EnhancedEventEmitter_1.EnhancedEventEmitter {
             throw new TypeError(`invalid kind "${kind}"`);
         else if (appData && typeof appData !== 'object')
             throw new TypeError('if given, appData must be an object');
+        else if (importState && !Array.isArray(importState.rtpState))
+            throw new TypeError('if given, importState must be an exported Producer state');
         // This may throw.
         ortc.validateRtpParameters(rtpParameters);
         // If missing or empty encodings, add one.
@@ -314,7 +316,15 @@ class Transport extends EnhancedEventEmitter_1.EnhancedEventEmitter {
         // This may throw.
         const consumableRtpParameters = ortc.getConsumableRtpParameters(kind, rtpParameters, routerRtpCapabilities, rtpMapping);
         const internal = { ...this.internal, producerId: id || (0, uuid_1.v4)() };
-        const reqData = { kind, rtpParameters, rtpMapping, keyFrameRequestDelay, paused };
+        const reqData = {
+            kind,
+            rtpParameters,
+            rtpMapping,
+            keyFrameRequestDelay,
+            keyFrameCacheMaxSize,
+            paused,
+            rtpState: importState ? importState.rtpState : undefined
+        };
         const status = await this.channel.request('transport.produce', internal, reqData);
         const data = {
             kind,
@@ -345,23 +355,61 @@ class Transport extends EnhancedEventEmitter_1.EnhancedEventEmitter {
      *
      * @virtual
      */
-    async consume({ producerId, rtpCapabilities, paused = false, mid, preferredLayers, ignoreDtx = false, pipe = false, appData }) {
+    async consume(options) {
         logger.debug('consume()');
+        const consumeRequest = this.prepareConsume(options);
+        const status = await this.channel.request('transport.consume', consumeRequest.internal, consumeRequest.reqData);
+        return this.createConsumer(consumeRequest, status);
+    }
+    /**
+     * Validate the given options and build the request to create a Consumer.
+     *
+     * @private
+     */
+    prepareConsume({ producerId, rtpCapabilities, paused = false, mid, preferredLayers, ignoreDtx = false, redThreshold, fecMinRtt, pipe = false, importState, appData }) {
         if (!producerId || typeof producerId !== 'string')
             throw new TypeError('missing producerId');
         else if (appData && typeof appData !== 'object')
             throw new TypeError('if given, appData must be an object');
         else if (mid && (typeof mid !== 'string' || mid.length === 0))
             throw new TypeError('if given, mid must be non empty string');
+        else if (redThreshold !== undefined &&
+            (typeof redThreshold !== 'number' || redThreshold < 0 || redThreshold > 1)) {
+            throw new TypeError('if given, redThreshold must be a number between 0 and 1');
+        }
+        else if (fecMinRtt !== undefined && (typeof fecMinRtt !== 'number' || fecMinRtt < 0)) {
+            throw new TypeError('if given, fecMinRtt must be a non negative number');
+        }
+        else if (importState && typeof importState.rtpState !== 'object') {
+            throw new TypeError('if given, importState must be an exported Consumer state');
+        }
         // This may throw.
         ortc.validateRtpCapabilities(rtpCapabilities);
         const producer = this.getProducerById(producerId);
         if (!producer)
             throw Error(`Producer with id "${producerId}" not found`);
-        // This may throw.
-        const rtpParameters = ortc.getConsumerRtpParameters(producer.consumableRtpParameters, rtpCapabilities, pipe);
+        let rtpParameters;
+        // A Consumer continuing an exported one keeps its RTP parameters (SSRCs
+        // and MID included) so the endpoint does not notice.
+        if (importState) {
+            rtpParameters = utils.clone(importState.rtpParameters);
+            // This may throw.
+            ortc.validateRtpParameters(rtpParameters);
+            // Do not give its MID to later Consumers.
+            const importedMid = Number(rtpParameters.mid);
+            if (Number.isInteger(importedMid) && importedMid >= this.#nextMidForConsumers)
+                this.#nextMidForConsumers = importedMid + 1;
+        }
+        else {
+            // This may throw.
+            rtpParameters = ortc.getConsumerRtpParameters(producer.consumableRtpParameters, rtpCapabilities, pipe, {
+                enableRed: redThreshold !== undefined,
+                // FEC packets are just generated by simple Consumers.
+                enableFec: fecMinRtt !== undefined && producer.type === 'simple'
+            });
+        }
         // Set MID.
-        if (!pipe) {
+        if (!pipe && !importState) {
             if (mid) {
                 rtpParameters.mid = mid;
             }
@@ -383,15 +431,25 @@ class Transport extends EnhancedEventEmitter_1.EnhancedEventEmitter {
             consumableRtpEncodings: producer.consumableRtpParameters.encodings,
             paused,
             preferredLayers,
-            ignoreDtx
+            ignoreDtx,
+            redThreshold,
+            fecMinRtt,
+            rtpState: importState ? importState.rtpState : undefined
         };
-        const status = await this.channel.request('transport.consume', internal, reqData);
         const data = {
             producerId,
             kind: producer.kind,
             rtpParameters,
             type: pipe ? 'pipe' : producer.type
         };
+        return { internal, reqData, data, appData };
+    }
+    /**
+     * Create the Consumer once the worker has created it.
+     *
+     * @private
+     */
+    createConsumer({ internal, data, appData }, status) {
         const consumer = new Consumer_1.Consumer({
             internal,
             data,
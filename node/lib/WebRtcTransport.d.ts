@@ -1,11 +1,15 @@
 import { Transport, TransportListenIp, TransportProtocol, TransportTuple, TransportEvents, TransportObserverEvents, SctpState } from './Transport';
 import { WebRtcServer } from './WebRtcServer';
+import { Router } from './Router';
+import { ProducerExportedState } from './Producer';
+import { ConsumerExportedState } from './Consumer';
 import { SctpParameters, NumSctpStreams } from './SctpParameters';
-import { Either } from './utils';
+import { SrtpCryptoSuite } from './SrtpParameters';
+import { Only } from './utils';
 export declare type WebRtcTransportListenIndividual = {
     /**
      * Listening IP address or addresses in order of preference (first one is the
-     * preferred one). Mandatory unless webRtcServer is given.
+     * preferred one). Mandatory unless webRtcServer or importState is given.
      */
     listenIps: (TransportListenIp | string)[];
     /**
@@ -16,11 +20,20 @@ export declare type WebRtcTransportListenIndividual = {
 };
 export declare type WebRtcTransportListenServer = {
     /**
-     * Instance of WebRtcServer. Mandatory unless listenIps is given.
+     * Instance of WebRtcServer. Mandatory unless listenIps or importState is
+     * given.
      */
     webRtcServer: WebRtcServer;
 };
-export declare type WebRtcTransportListen = Either<WebRtcTransportListenIndividual, WebRtcTransportListenServer>;
+export declare type WebRtcTransportListenImport = {
+    /**
+     * State exported by a WebRtcTransport in a Router of another Worker (see
+     * webRtcTransport.exportState()). Mandatory unless listenIps or webRtcServer
+     * is given.
+     */
+    importState: WebRtcTransportExportedState;
+};
+export declare type WebRtcTransportListen = Only<WebRtcTransportListenIndividual, WebRtcTransportListenServer & WebRtcTransportListenImport> | Only<WebRtcTransportListenServer, WebRtcTransportListenIndividual & WebRtcTransportListenImport> | Only<WebRtcTransportListenImport, WebRtcTransportListenIndividual & WebRtcTransportListenServer>;
 export declare type WebRtcTransportOptionsBase = {
     /**
      * Listen in UDP. Default true.
@@ -95,6 +108,56 @@ export declare type DtlsFingerprint = {
     value: string;
 };
 export declare type IceState = 'new' | 'connected' | 'completed' | 'disconnected' | 'closed';
+/**
+ * ICE, DTLS and SRTP state of a WebRtcTransport given to a WebRtcTransport
+ * created in another Worker so it continues the same session. It must be
+ * given as is.
+ */
+export declare type WebRtcTransportExportedState = {
+    /**
+     * Unix socket path to which the UDP sockets were sent.
+     */
+    socketPath: string;
+    iceParameters: IceParameters;
+    iceState: 'connected' | 'completed';
+    iceSelectedTuple: {
+        socketIndex: number;
+        remoteIp: string;
+        remotePort: number;
+    };
+    udpSockets: {
+        ip: string;
+        port: number;
+        announcedIp?: string;
+    }[];
+    dtlsLocalRole: 'client' | 'server';
+    srtpParameters: {
+        cryptoSuite: SrtpCryptoSuite;
+        localKeyBase64: string;
+        remoteKeyBase64: string;
+    };
+    /**
+     * SRTP rollover counter and index of the last sent SRTCP packet of received
+     * and sent streams.
+     */
+    recvStreams: {
+        ssrc: number;
+        roc: number;
+        rtcpIndex: number;
+    }[];
+    sendStreams: {
+        ssrc: number;
+        roc: number;
+        rtcpIndex: number;
+    }[];
+    /**
+     * State of the Producers and Consumers indexed by their id, to be given as
+     * importState option of transport.produce() and transport.consume() when
+     * creating them again in the new transport.
+     */
+    producers: Record<string, ProducerExportedState>;
+    consumers: Record<string, ConsumerExportedState>;
+};
 export declare type DtlsRole = 'auto' | 'client' | 'server';
 export declare type DtlsState = 'new' | 'connecting' | 'connected' | 'failed' | 'closed';
 export declare type WebRtcTransportStat = {
@@ -219,6 +282,22 @@ export declare class WebRtcTransport extends Transport<WebRtcTransportEvents, We
      * Restart ICE.
      */
     restartIce(): Promise<IceParameters>;
+    /**
+     * Export the ICE, DTLS and SRTP state so a WebRtcTransport created with it
+     * (importState option) in the given Router of another Worker in the same
+     * host takes over the session with the remote endpoint. The UDP sockets are
+     * sent to that Worker now. This transport stops sending and receiving and
+     * should be closed once the new one has been created.
+     *
+     * Just connected transports listening in UDP without WebRtcServer nor SCTP
+     * can be exported. Producers and Consumers must be created again in the new
+     * transport with their exported state (importState option), so their RTP
+     * streams continue. A transport created with an exported state cannot be
+     * exported again.
+     */
+    exportState({ router }: {
+        router: Router;
+    }): Promise<WebRtcTransportExportedState>;
     private handleWorkerNotifications;
 }
 //# sourceMappingURL=WebRtcTransport.d.ts.map
\ No newline at end of file
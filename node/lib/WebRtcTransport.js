@@ -166,6 +166,25 @@ class WebRtcTransport extends Transport_1.Transport {
         this.#data.iceParameters = iceParameters;
         return iceParameters;
     }
+    /**
+     * Export the ICE, DTLS and SRTP state so a WebRtcTransport created with it
+     * (importState option) in the given Router of another Worker in the same
+     * host takes over the session with the remote endpoint. The UDP sockets are
+     * sent to that Worker now. This transport stops sending and receiving and
+     * should be closed once the new one has been created.
+     *
+     * Just connected transports listening in UDP without WebRtcServer nor SCTP
+     * can be exported. Producers and Consumers must be created again in the new
+     * transport with their exported state (importState option), so their RTP
+     * streams continue. A transport created with an exported state cannot be
+     * exported again.
+     */
+    async exportState({ router }) {
+        logger.debug('exportState()');
+        const socketPath = await router.prepareWebRtcTransportImport();
+        const state = await this.channel.request('transport.exportState', this.internal, { socketPath });
+        return state;
+    }
     handleWorkerNotifications() {
         this.channel.on(this.internal.transportId, (event, data) => {
             switch (event) {
@@ -3,6 +3,7 @@ import { Router, RouterOptions } from './Router';
 import { WebRtcServer, WebRtcServerOptions } from './WebRtcServer';
 export declare type WorkerLogLevel = 'debug' | 'warn' | 'error' | 'none';
 export declare type WorkerLogTag = 'info' | 'ice' | 'dtls' | 'rtp' | 'srtp' | 'rtcp' | 'rtx' | 'bwe' | 'score' | 'simulcast' | 'svc' | 'sctp' | 'message';
+export declare type WorkerOverloadDegradationStep = 'retransmissions' | 'layers' | 'rtcp';
 export declare type WorkerSettings = {
     /**
      * Logging level for logs generated by the media worker subprocesses (check
@@ -33,12 +34,59 @@ export declare type WorkerSettings = {
      * certificate is dynamically created.
      */
     dtlsPrivateKeyFile?: string;
+    /**
+     * Maximum memory (in bytes) used by all the RTP retransmission buffers in
+     * the worker. Once reached, oldest packets are discarded first. Default 0
+     * (no limit).
+     */
+    retransmissionBufferMaxMemory?: number;
+    /**
+     * Number of threads running DTLS handshakes so they don't block media
+     * processing in the worker. Default 0 (DTLS handshakes are run within the
+     * worker main thread).
+     */
+    dtlsHandshakeThreads?: number;
+    /**
+     * Use the io_uring I/O path for media sockets (just in Linux >= 6.0 and if
+     * supported by the mediasoup-worker build). Default false.
+     */
+    useIoUring?: boolean;
+    /**
+     * Number of UDP sockets kept bound in advance per listen IP so creation of
+     * WebRTC and plain transports doesn't need to bind new ones. The pool of an
+     * IP is created once a transport listens on it. Default 0 (no pool).
+     */
+    udpSocketPoolSize?: number;
+    /**
+     * Number of entries of the ring through which the worker records its logs.
+     * If set, logs are formatted and sent by a background thread so they don't
+     * load the worker thread (entries are dropped if the ring gets full).
+     * Default 0 (logs are sent synchronously).
+     */
+    logRingSize?: number;
+    /**
+     * Event loop lag (in ms) from which the worker is considered overloaded.
+     * While overloaded, the worker applies the overloadDegradationSteps one by
+     * one and emits 'overloadstatechange'. Default 0 (overload control
+     * disabled).
+     */
+    overloadLoopLagThreshold?: number;
+    /**
+     * Event loop busy time (in percentage) from which the worker is considered
+     * overloaded. Just used if overloadLoopLagThreshold is set. Default 90.
+     */
+    overloadLoopBusyThreshold?: number;
+    /**
+     * Degradation steps applied, in this order, while the worker is overloaded.
+     * Default ['retransmissions', 'layers', 'rtcp'].
+     */
+    overloadDegradationSteps?: WorkerOverloadDegradationStep[];
     /**
      * Custom application data.
      */
     appData?: Record<string, unknown>;
 };
-export declare type WorkerUpdateableSettings = Pick<WorkerSettings, 'logLevel' | 'logTags'>;
+export declare type WorkerUpdateableSettings = Pick<WorkerSettings, 'logLevel' | 'logTags' | 'retransmissionBufferMaxMemory'>;
 /**
  * An object with the fields of the uv_rusage_t struct.
  *
@@ -110,9 +158,37 @@ export declare type WorkerResourceUsage = {
      * Involuntary context switches.
      */
     ru_nivcsw: number;
+    /**
+     * Memory (in bytes) used by RTP retransmission buffers.
+     */
+    retransmissionBufferMemory: number;
+    /**
+     * Number of RTP packets discarded from retransmission buffers due to the
+     * retransmissionBufferMaxMemory limit.
+     */
+    retransmissionBufferEvictedPackets: number;
+};
+export declare type WorkerOverloadState = {
+    /**
+     * Number of degradation steps currently applied.
+     */
+    level: number;
+    /**
+     * Degradation steps currently applied.
+     */
+    appliedSteps: WorkerOverloadDegradationStep[];
+    /**
+     * Last measured event loop lag (in ms).
+     */
+    loopLag: number;
+    /**
+     * Last measured event loop busy time (in percentage).
+     */
+    loopBusy: number;
 };
 export declare type WorkerEvents = {
     died: [Error];
+    overloadstatechange: [WorkerOverloadState];
     '@success': [];
     '@failure': [Error];
 };
@@ -126,7 +202,7 @@ export declare class Worker extends EnhancedEventEmitter<WorkerEvents> {
     /**
      * @private
      */
-    constructor({ logLevel, logTags, rtcMinPort, rtcMaxPort, dtlsCertificateFile, dtlsPrivateKeyFile, appData }: WorkerSettings);
+    constructor({ logLevel, logTags, rtcMinPort, rtcMaxPort, dtlsCertificateFile, dtlsPrivateKeyFile, retransmissionBufferMaxMemory, dtlsHandshakeThreads, useIoUring, udpSocketPoolSize, logRingSize, overloadLoopLagThreshold, overloadLoopBusyThreshold, overloadDegradationSteps, appData }: WorkerSettings);
     /**
      * Worker process identifier (PID).
      */
@@ -176,7 +252,7 @@ export declare class Worker extends EnhancedEventEmitter<WorkerEvents> {
     /**
      * Update settings.
      */
-    updateSettings({ logLevel, logTags }?: WorkerUpdateableSettings): Promise<void>;
+    updateSettings({ logLevel, logTags, retransmissionBufferMaxMemory }?: WorkerUpdateableSettings): Promise<void>;
     /**
      * Create a WebRtcServer.
      */
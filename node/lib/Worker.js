@@ -46,7 +46,7 @@ class Worker extends EnhancedEventEmitter_1.EnhancedEventEmitter {
     /**
      * @private
      */
-    constructor({ logLevel, logTags, rtcMinPort, rtcMaxPort, dtlsCertificateFile, dtlsPrivateKeyFile, appData }) {
+    constructor({ logLevel, logTags, rtcMinPort, rtcMaxPort, dtlsCertificateFile, dtlsPrivateKeyFile, retransmissionBufferMaxMemory, dtlsHandshakeThreads, useIoUring, udpSocketPoolSize, logRingSize, overloadLoopLagThreshold, overloadLoopBusyThreshold, overloadDegradationSteps, appData }) {
         super();
         logger.debug('constructor()');
         let spawnBin = workerBin;
@@ -72,6 +72,30 @@ class Worker extends EnhancedEventEmitter_1.EnhancedEventEmitter {
             spawnArgs.push(`--dtlsCertificateFile=${dtlsCertificateFile}`);
         if (typeof dtlsPrivateKeyFile === 'string' && dtlsPrivateKeyFile)
             spawnArgs.push(`--dtlsPrivateKeyFile=${dtlsPrivateKeyFile}`);
+        if (typeof retransmissionBufferMaxMemory === 'number' &&
+            !Number.isNaN(retransmissionBufferMaxMemory)) {
+            spawnArgs.push(`--retransmissionBufferMaxMemory=${retransmissionBufferMaxMemory}`);
+        }
+        if (typeof dtlsHandshakeThreads === 'number' && !Number.isNaN(dtlsHandshakeThreads))
+            spawnArgs.push(`--dtlsHandshakeThreads=${dtlsHandshakeThreads}`);
+        if (typeof useIoUring === 'boolean')
+            spawnArgs.push(`--useIoUring=${useIoUring}`);
+        if (typeof udpSocketPoolSize === 'number' && !Number.isNaN(udpSocketPoolSize))
+            spawnArgs.push(`--udpSocketPoolSize=${udpSocketPoolSize}`);
+        if (typeof logRingSize === 'number' && !Number.isNaN(logRingSize))
+            spawnArgs.push(`--logRingSize=${logRingSize}`);
+        if (typeof overloadLoopLagThreshold === 'number' &&
+            !Number.isNaN(overloadLoopLagThreshold)) {
+            spawnArgs.push(`--overloadLoopLagThreshold=${overloadLoopLagThreshold}`);
+        }
+        if (typeof overloadLoopBusyThreshold === 'number' &&
+            !Number.isNaN(overloadLoopBusyThreshold)) {
+            spawnArgs.push(`--overloadLoopBusyThreshold=${overloadLoopBusyThreshold}`);
+        }
+        for (const step of (Array.isArray(overloadDegradationSteps) ? overloadDegradationSteps : [])) {
+            if (typeof step === 'string' && step)
+                spawnArgs.push(`--overloadDegradationSteps=${step}`);
+        }
         logger.debug('spawning worker process: %s %s', spawnBin, spawnArgs.join(' '));
         this.#child = (0, child_process_1.spawn)(
         // command
@@ -121,6 +145,11 @@ class Worker extends EnhancedEventEmitter_1.EnhancedEventEmitter {
                 this.emit('@success');
             }
         });
+        // Listen for overload notifications.
+        this.#channel.on(String(this.#pid), (event, data) => {
+            if (event === 'overloadstatechange')
+                this.safeEmit('overloadstatechange', data);
+        });
         this.#child.on('exit', (code, signal) => {
             this.#child = undefined;
             if (!spawnDone) {
@@ -271,9 +300,9 @@ class Worker extends EnhancedEventEmitter_1.EnhancedEventEmitter {
     /**
      * Update settings.
      */
-    async updateSettings({ logLevel, logTags } = {}) {
+    async updateSettings({ logLevel, logTags, retransmissionBufferMaxMemory } = {}) {
         logger.debug('updateSettings()');
-        const reqData = { logLevel, logTags };
+        const reqData = { logLevel, logTags, retransmissionBufferMaxMemory };
         await this.#channel.request('worker.updateSettings', undefined, reqData);
     }
     /**
@@ -116,9 +116,14 @@ export declare function canConsume(consumableParams: RtpParameters, caps: RtpCap
  *
  * It reduces encodings to just one and takes into account given RTP capabilities
  * to reduce codecs, codecs' RTCP feedback and header extensions, and also enables
- * or disabled RTX.
- */
-export declare function getConsumerRtpParameters(consumableParams: RtpParameters, caps: RtpCapabilities, pipe: boolean): RtpParameters;
+ * or disabled RTX. If enableRed is set, it adds the RED codec of the given RTP
+ * capabilities for Opus. If enableFec is set, it adds the RED and ULPFEC codecs
+ * of the given RTP capabilities for video.
+ */
+export declare function getConsumerRtpParameters(consumableParams: RtpParameters, caps: RtpCapabilities, pipe: boolean, { enableRed, enableFec }?: {
+    enableRed?: boolean;
+    enableFec?: boolean;
+}): RtpParameters;
 /**
  * Generate RTP parameters for a pipe Consumer.
  *
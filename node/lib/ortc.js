@@ -455,8 +455,9 @@ function generateRouterRtpCapabilities(mediaCodecs = []) {
         codec.parameters = { ...codec.parameters, ...mediaCodec.parameters };
         // Append to the codec list.
         caps.codecs.push(codec);
-        // Add a RTX video codec if video.
-        if (codec.kind === 'video') {
+        // Add a RTX video codec if video (but not for RED and ULPFEC since their
+        // packets are generated by Consumers).
+        if (codec.kind === 'video' && !isRedCodec(codec) && !isUlpfecCodec(codec)) {
             // Take the first available pt and remove it from the list.
             const pt = dynamicPayloadTypes.shift();
             if (!pt)
@@ -648,9 +649,11 @@ exports.canConsume = canConsume;
  *
  * It reduces encodings to just one and takes into account given RTP capabilities
  * to reduce codecs, codecs' RTCP feedback and header extensions, and also enables
- * or disabled RTX.
+ * or disabled RTX. If enableRed is set, it adds the RED codec of the given RTP
+ * capabilities for Opus. If enableFec is set, it adds the RED and ULPFEC codecs
+ * of the given RTP capabilities for video.
  */
-function getConsumerRtpParameters(consumableParams, caps, pipe) {
+function getConsumerRtpParameters(consumableParams, caps, pipe, { enableRed = false, enableFec = false } = {}) {
     const consumerParams = {
         codecs: [],
         headerExtensions: [],
@@ -687,6 +690,15 @@ function getConsumerRtpParameters(consumableParams, caps, pipe) {
     if (consumerParams.codecs.length === 0 || isRtxCodec(consumerParams.codecs[0])) {
         throw new errors_1.UnsupportedError('no compatible media codecs');
     }
+    // RED and ULPFEC packets are generated by the Consumer, so their codecs are
+    // added even if the Producer does not use them.
+    if (!pipe) {
+        const mediaMimeType = consumerParams.codecs[0].mimeType.toLowerCase();
+        if (enableRed && mediaMimeType === 'audio/opus')
+            addGeneratedCodecs(consumerParams, caps, [isRedCodec]);
+        else if (enableFec && mediaMimeType.startsWith('video/'))
+            addGeneratedCodecs(consumerParams, caps, [isRedCodec, isUlpfecCodec]);
+    }
     consumerParams.headerExtensions = consumableParams.headerExtensions
         .filter((ext) => (caps.headerExtensions
         .some((capExt) => (capExt.preferredId === ext.id &&
@@ -804,6 +816,42 @@ exports.getPipeConsumerRtpParameters = getPipeConsumerRtpParameters;
 function isRtxCodec(codec) {
     return /.+\/rtx$/i.test(codec.mimeType);
 }
+function isRedCodec(codec) {
+    return /.+\/red$/i.test(codec.mimeType);
+}
+function isUlpfecCodec(codec) {
+    return /.+\/ulpfec$/i.test(codec.mimeType);
+}
+/**
+ * Adds to the given Consumer RTP parameters the capability codecs matching
+ * the given checks (all of them or none) with the kind and clock rate of its
+ * media codec.
+ */
+function addGeneratedCodecs(consumerParams, caps, checks) {
+    const mediaCodec = consumerParams.codecs[0];
+    const kind = mediaCodec.mimeType.split('/')[0].toLowerCase();
+    if (consumerParams.codecs.some((codec) => checks.some((check) => check(codec))))
+        return;
+    const capCodecs = checks
+        .map((check) => caps.codecs
+        .find((capCodec) => (check(capCodec) &&
+        capCodec.kind === kind &&
+        capCodec.clockRate === mediaCodec.clockRate &&
+        !consumerParams.codecs
+            .some((codec) => codec.payloadType === capCodec.preferredPayloadType))));
+    if (capCodecs.some((capCodec) => !capCodec))
+        return;
+    for (const capCodec of capCodecs) {
+        consumerParams.codecs.push({
+            mimeType: capCodec.mimeType,
+            payloadType: capCodec.preferredPayloadType,
+            clockRate: capCodec.clockRate,
+            channels: capCodec.channels,
+            parameters: {},
+            rtcpFeedback: []
+        });
+    }
+}
 function matchCodecs(aCodec, bCodec, { strict = false, modify = false } = {}) {
     const aMimeType = aCodec.mimeType.toLowerCase();
     const bMimeType = bCodec.mimeType.toLowerCase();
@@ -178,6 +178,12 @@ const supportedRtpCapabilities = {
             mimeType: 'audio/telephone-event',
             clockRate: 8000
         },
+        {
+            kind: 'audio',
+            mimeType: 'audio/red',
+            clockRate: 48000,
+            channels: 2
+        },
         {
             kind: 'video',
             mimeType: 'video/VP8',
@@ -246,6 +252,16 @@ const supportedRtpCapabilities = {
                 { type: 'goog-remb' },
                 { type: 'transport-cc' }
             ]
+        },
+        {
+            kind: 'video',
+            mimeType: 'video/red',
+            clockRate: 90000
+        },
+        {
+            kind: 'video',
+            mimeType: 'video/ulpfec',
+            clockRate: 90000
         }
     ],
     headerExtensions: [
@@ -6,11 +6,10 @@ export declare function clone(data: any): any;
  * Generates a random positive integer.
  */
 export declare function generateRandomNumber(): number;
-declare type Only<T, U> = {
+export declare type Only<T, U> = {
     [P in keyof T]: T[P];
 } & {
     [P in keyof U]?: never;
 };
 export declare type Either<T, U> = Only<T, U> | Only<U, T>;
-export {};
 //# sourceMappingURL=utils.d.ts.map
\ No newline at end of file
@@ -7,6 +7,19 @@ export interface ActiveSpeakerObserverOptions
 {
 	interval?: number;
 
+	/**
+	 * If given, Consumers added to the observer are forwarded only while their
+	 * speaker is one of the lastN most recent dominant speakers.
+	 */
+	lastN?: number;
+
+	/**
+	 * What to do with Consumers whose speaker is not one of the lastN ones:
+	 * 'pause' them (default) or 'downgrade' them to their lowest layers (only
+	 * simulcast and SVC Consumers, others are paused).
+	 */
+	lastNMode?: 'pause' | 'downgrade';
+
 	/**
 	 * Custom application data.
 	 */
@@ -21,14 +34,38 @@ export interface ActiveSpeakerObserverActivity
 	producer: Producer;
 }
 
+export type ActiveSpeakerObserverAddConsumerOptions =
+{
+	/**
+	 * The id of the Consumer to be added.
+	 */
+	consumerId: string;
+
+	/**
+	 * The id of the audio Producer (already added to the observer) of the
+	 * speaker whose activity drives the Consumer.
+	 */
+	producerId: string;
+}
+
+export type ActiveSpeakerObserverRemoveConsumerOptions =
+{
+	/**
+	 * The id of the Consumer to be removed.
+	 */
+	consumerId: string;
+}
+
 export type ActiveSpeakerObserverEvents = RtpObserverEvents &
 {
 	dominantspeaker: [{ producer: Producer }];
+	lastnchange: [{ producers: Producer[] }];
 }
 
 export type ActiveSpeakerObserverObserverEvents = RtpObserverObserverEvents &
 {
 	dominantspeaker: [{ producer: Producer }];
+	lastnchange: [{ producers: Producer[] }];
 }
 
 const logger = new Logger('ActiveSpeakerObserver');
@@ -53,6 +90,34 @@ export class ActiveSpeakerObserver extends RtpObserver<ActiveSpeakerObserverEven
 		return super.observer;
 	}
 
+	/**
+	 * Add a Consumer to be paused or downgraded by the last-N policy.
+	 */
+	async addConsumer(
+		{ consumerId, producerId }: ActiveSpeakerObserverAddConsumerOptions
+	): Promise<void>
+	{
+		logger.debug('addConsumer()');
+
+		const reqData = { consumerId, producerId };
+
+		await this.channel.request('rtpObserver.addConsumer', this.internal, reqData);
+	}
+
+	/**
+	 * Remove a Consumer from the last-N policy (it is forwarded normally again).
+	 */
+	async removeConsumer(
+		{ consumerId }: ActiveSpeakerObserverRemoveConsumerOptions
+	): Promise<void>
+	{
+		logger.debug('removeConsumer()');
+
+		const reqData = { consumerId };
+
+		await this.channel.request('rtpObserver.removeConsumer', this.internal, reqData);
+	}
+
 	private handleWorkerNotifications(): void
 	{
 		this.channel.on(this.internal.rtpObserverId, (event: string, data?: any) =>
@@ -71,6 +136,19 @@ export class ActiveSpeakerObserver extends RtpObserver<ActiveSpeakerObserverEven
 					break;
 				}
 
+				case 'lastnchange':
+				{
+					const lastN = {
+						producers : (data.producerIds as string[])
+							.map((producerId) => this.getProducerById(producerId))
+					};
+
+					this.safeEmit('lastnchange', lastN);
+					this.observer.safeEmit('lastnchange', lastN);
+
+					break;
+				}
+
 				default:
 				{
 					logger.error('ignoring unknown event "%s"', event);
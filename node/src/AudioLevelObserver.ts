@@ -17,10 +17,18 @@ export interface AudioLevelObserverOptions
 	threshold?: number;
 
 	/**
-	 * Interval in ms for checking audio volumes. Default 1000.
+	 * Interval in ms for checking audio volumes. Default 1000. Minimum 250 (50
+	 * if binaryVolumes is set).
 	 */
 	interval?: number;
 
+	/**
+	 * Whether the worker sends the 'volumes' events in binary format over the
+	 * PayloadChannel instead of in JSON, which is cheaper for meters with short
+	 * intervals. Default false.
+	 */
+	binaryVolumes?: boolean;
+
 	/**
 	 * Custom application data.
 	 */
@@ -83,24 +91,7 @@ export class AudioLevelObserver extends RtpObserver<AudioLevelObserverEvents>
 			{
 				case 'volumes':
 				{
-					// Get the corresponding Producer instance and remove entries with
-					// no Producer (it may have been closed in the meanwhile).
-					const volumes: AudioLevelObserverVolume[] = data
-						.map(({ producerId, volume }: { producerId: string; volume: number }) => (
-							{
-								producer : this.getProducerById(producerId),
-								volume
-							}
-						))
-						.filter(({ producer }: { producer: Producer }) => producer);
-
-					if (volumes.length > 0)
-					{
-						this.safeEmit('volumes', volumes);
-
-						// Emit observer event.
-						this.observer.safeEmit('volumes', volumes);
-					}
+					this.handleVolumes(data);
 
 					break;
 				}
@@ -121,5 +112,71 @@ export class AudioLevelObserver extends RtpObserver<AudioLevelObserverEvents>
 				}
 			}
 		});
+
+		this.payloadChannel.on(
+			this.internal.rtpObserverId,
+			(event: string, data: any | undefined, payload: Buffer) =>
+			{
+				switch (event)
+				{
+					case 'volumes':
+					{
+						this.handleVolumes(parseBinaryVolumes(payload));
+
+						break;
+					}
+
+					default:
+					{
+						logger.error('ignoring unknown event "%s" in payload channel listener', event);
+					}
+				}
+			});
 	}
+
+	private handleVolumes(entries: { producerId: string; volume: number }[]): void
+	{
+		// Get the corresponding Producer instance and remove entries with
+		// no Producer (it may have been closed in the meanwhile).
+		const volumes: AudioLevelObserverVolume[] = entries
+			.map(({ producerId, volume }) => (
+				{
+					producer : this.getProducerById(producerId),
+					volume
+				}
+			))
+			.filter(({ producer }: { producer: Producer }) => producer);
+
+		if (volumes.length > 0)
+		{
+			this.safeEmit('volumes', volumes);
+
+			// Emit observer event.
+			this.observer.safeEmit('volumes', volumes);
+		}
+	}
+}
+
+/**
+ * Each entry of the binary 'volumes' notification is the volume (int8), the
+ * length of the Producer id (uint8) and the Producer id.
+ */
+function parseBinaryVolumes(payload: Buffer): { producerId: string; volume: number }[]
+{
+	const entries = [];
+	let offset = 0;
+
+	while (offset + 2 <= payload.length)
+	{
+		const volume = payload.readInt8(offset);
+		const producerIdLength = payload.readUInt8(offset + 1);
+		const producerId =
+			payload.toString('utf8', offset + 2, offset + 2 + producerIdLength);
+
+		entries.push({ producerId, volume });
+
+		offset += 2 + producerIdLength;
+	}
+
+	return entries;
 }
@@ -55,18 +55,54 @@ export type ConsumerOptions =
 	 */
 	ignoreDtx?: Boolean;
 
+	/**
+	 * Fraction of lost packets (from 0 to 1) reported by the consuming endpoint
+	 * above which Opus packets are sent wrapped into RED (RFC 2198) packets that
+	 * also carry the previous frames. It requires 'audio/red' in the Router and
+	 * in the given rtpCapabilities. If unset, RED is not used.
+	 */
+	redThreshold?: number;
+
+	/**
+	 * Min RTT (in ms) of the consuming endpoint above which video packets are
+	 * protected with ULPFEC (RFC 5109) packets, sent within RED packets, as
+	 * losses are reported. The amount of FEC packets is bounded by the available
+	 * outgoing bitrate. It requires 'video/red' and 'video/ulpfec' in the Router
+	 * and in the given rtpCapabilities and just applies to simple Consumers. If
+	 * unset, FEC is not used.
+	 */
+	fecMinRtt?: number;
+
 	/**
 	 * Whether this Consumer should consume all RTP streams generated by the
 	 * Producer.
 	 */
 	pipe?: boolean;
 
+	/**
+	 * State of the Consumer this one continues, as given by
+	 * webRtcTransport.exportState(). The Consumer takes its RTP parameters (so
+	 * mid is ignored) and continues its RTP stream. Other options must be the
+	 * same as those of that Consumer.
+	 */
+	importState?: ConsumerExportedState;
+
 	/**
 	 * Custom application data.
 	 */
 	appData?: Record<string, unknown>;
 }
 
+/**
+ * RTP parameters and RTP stream state of a Consumer in an exported
+ * WebRtcTransport. It must be given as is.
+ */
+export type ConsumerExportedState =
+{
+	rtpParameters: RtpParameters;
+	rtpState: any;
+}
+
 /**
  * Valid types for 'trace' event.
  */
@@ -461,6 +497,58 @@ export class Consumer extends EnhancedEventEmitter<ConsumerEvents>
 		this.#observer.safeEmit('close');
 	}
 
+	/**
+	 * Request to be sent within a Router bulk request.
+	 *
+	 * @private
+	 */
+	getBulkRequest(
+		method: 'consumer.pause' | 'consumer.resume' | 'consumer.setPreferredLayers',
+		data?: any
+	): { method: string; internal: any; data?: any }
+	{
+		return { method, internal: this.#internal, data };
+	}
+
+	/**
+	 * Consumer was paused (by pause() or a Router bulk request).
+	 *
+	 * @private
+	 */
+	handlePaused(wasPaused: boolean): void
+	{
+		this.#paused = true;
+
+		// Emit observer event.
+		if (!wasPaused)
+			this.#observer.safeEmit('pause');
+	}
+
+	/**
+	 * Consumer was resumed (by resume() or a Router bulk request).
+	 *
+	 * @private
+	 */
+	handleResumed(wasPaused: boolean): void
+	{
+		this.#paused = false;
+
+		// Emit observer event.
+		if (wasPaused && !this.#producerPaused)
+			this.#observer.safeEmit('resume');
+	}
+
+	/**
+	 * Preferred layers were set (by setPreferredLayers() or a Router bulk
+	 * request).
+	 *
+	 * @private
+	 */
+	handlePreferredLayers(preferredLayers?: ConsumerLayers): void
+	{
+		this.#preferredLayers = preferredLayers || undefined;
+	}
+
 	/**
 	 * Dump Consumer.
 	 */
@@ -492,11 +580,7 @@ export class Consumer extends EnhancedEventEmitter<ConsumerEvents>
 
 		await this.#channel.request('consumer.pause', this.#internal);
 
-		this.#paused = true;
-
-		// Emit observer event.
-		if (!wasPaused)
-			this.#observer.safeEmit('pause');
+		this.handlePaused(wasPaused);
 	}
 
 	/**
@@ -510,11 +594,7 @@ export class Consumer extends EnhancedEventEmitter<ConsumerEvents>
 
 		await this.#channel.request('consumer.resume', this.#internal);
 
-		this.#paused = false;
-
-		// Emit observer event.
-		if (wasPaused && !this.#producerPaused)
-			this.#observer.safeEmit('resume');
+		this.handleResumed(wasPaused);
 	}
 
 	/**
@@ -534,7 +614,7 @@ export class Consumer extends EnhancedEventEmitter<ConsumerEvents>
 		const data = await this.#channel.request(
 			'consumer.setPreferredLayers', this.#internal, reqData);
 
-		this.#preferredLayers = data || undefined;
+		this.handlePreferredLayers(data);
 	}
 
 	/**
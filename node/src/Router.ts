@@ -5,13 +5,13 @@ import * as ortc from './ortc';
 import { InvalidStateError } from './errors';
 import { Channel } from './Channel';
 import { PayloadChannel } from './PayloadChannel';
-import { Transport, TransportListenIp } from './Transport';
+import { Transport, TransportListenIp, ConsumeRequest } from './Transport';
 import { WebRtcTransport, WebRtcTransportOptions } from './WebRtcTransport';
 import { PlainTransport, PlainTransportOptions } from './PlainTransport';
 import { PipeTransport, PipeTransportOptions } from './PipeTransport';
 import { DirectTransport, DirectTransportOptions } from './DirectTransport';
 import { Producer } from './Producer';
-import { Consumer } from './Consumer';
+import { Consumer, ConsumerLayers, ConsumerOptions } from './Consumer';
 import { DataProducer } from './DataProducer';
 import { DataConsumer } from './DataConsumer';
 import { RtpObserver } from './RtpObserver';
@@ -99,6 +99,39 @@ export type PipeToRouterResult =
 	pipeDataProducer?: DataProducer;
 }
 
+export type ConsumeManyItem =
+{
+	/**
+	 * Transport in which the Consumer must be created.
+	 */
+	transport: Transport;
+
+	/**
+	 * Same options as in transport.consume().
+	 */
+	options: ConsumerOptions;
+}
+
+export type ConsumerPreferredLayersItem =
+{
+	/**
+	 * The Consumer.
+	 */
+	consumer: Consumer;
+
+	/**
+	 * Same as in consumer.setPreferredLayers().
+	 */
+	preferredLayers: ConsumerLayers;
+}
+
+type BulkRequest =
+{
+	method: string;
+	internal: any;
+	data?: any;
+};
+
 type PipeTransportPair =
 {
 	[key: string]: PipeTransport;
@@ -353,6 +386,7 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 			webRtcServer,
 			listenIps,
 			port,
+			importState,
 			enableUdp = true,
 			enableTcp = false,
 			preferUdp = false,
@@ -368,8 +402,11 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 	{
 		logger.debug('createWebRtcTransport()');
 
-		if (!webRtcServer && !Array.isArray(listenIps))
-			throw new TypeError('missing webRtcServer and listenIps (one of them is mandatory)');
+		if (!webRtcServer && !Array.isArray(listenIps) && !importState)
+		{
+			throw new TypeError(
+				'missing webRtcServer, listenIps and importState (one of them is mandatory)');
+		}
 		else if (appData && typeof appData !== 'object')
 			throw new TypeError('if given, appData must be an object');
 
@@ -406,6 +443,7 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 			webRtcServerId : webRtcServer ? webRtcServer.id : undefined,
 			listenIps,
 			port,
+			importState,
 			enableUdp,
 			enableTcp,
 			preferUdp,
@@ -459,6 +497,22 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 		return transport;
 	}
 
+	/**
+	 * Get ready to receive the UDP sockets of a WebRtcTransport exported from
+	 * another Worker. It returns the Unix socket path to which they must be sent.
+	 *
+	 * @private
+	 */
+	async prepareWebRtcTransportImport(): Promise<string>
+	{
+		logger.debug('prepareWebRtcTransportImport()');
+
+		const { socketPath } = await this.#channel.request(
+			'router.prepareWebRtcTransportImport', this.#internal);
+
+		return socketPath;
+	}
+
 	/**
 	 * Create a PlainTransport.
 	 */
@@ -567,6 +621,8 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 			sctpSendBufferSize = 268435456,
 			enableRtx = false,
 			enableSrtp = false,
+			enableBundling = false,
+			bundlingMaxDelay,
 			appData
 		}: PipeTransportOptions
 	): Promise<PipeTransport>
@@ -605,7 +661,9 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 			sctpSendBufferSize,
 			isDataChannel : false,
 			enableRtx,
-			enableSrtp
+			enableSrtp,
+			enableBundling,
+			bundlingMaxDelay
 		};
 
 		const data =
@@ -995,6 +1053,8 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 	async createActiveSpeakerObserver(
 		{
 			interval = 300,
+			lastN,
+			lastNMode,
 			appData
 		}: ActiveSpeakerObserverOptions = {}
 	): Promise<ActiveSpeakerObserver>
@@ -1005,7 +1065,7 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 			throw new TypeError('if given, appData must be an object');
 		
 		const internal = { ...this.#internal, rtpObserverId: uuidv4() };
-		const reqData = { interval };
+		const reqData = { interval, lastN, lastNMode };
 
 		await this.#channel.request('router.createActiveSpeakerObserver', internal, reqData);
 
@@ -1040,6 +1100,7 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 			maxEntries = 1,
 			threshold = -80,
 			interval = 1000,
+			binaryVolumes = false,
 			appData
 		}: AudioLevelObserverOptions = {}
 	): Promise<AudioLevelObserver>
@@ -1050,7 +1111,7 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 			throw new TypeError('if given, appData must be an object');
 
 		const internal = { ...this.#internal, rtpObserverId: uuidv4() };
-		const reqData = { maxEntries, threshold, interval };
+		const reqData = { maxEntries, threshold, interval, binaryVolumes };
 
 		await this.#channel.request('router.createAudioLevelObserver', internal, reqData);
 
@@ -1077,6 +1138,139 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 		return audioLevelObserver;
 	}
 
+	/**
+	 * Create many Consumers (in the same or different Transports of this Router)
+	 * within a single request to the worker. For each given item, the created
+	 * Consumer or the Error that prevented its creation is returned.
+	 */
+	async consumeMany(items: ConsumeManyItem[]): Promise<(Consumer | Error)[]>
+	{
+		logger.debug('consumeMany()');
+
+		if (!Array.isArray(items))
+			throw new TypeError('missing items');
+
+		const results: (Consumer | Error)[] = new Array(items.length);
+		const consumeItems:
+			{ idx: number; transport: Transport; consumeRequest: ConsumeRequest }[] = [];
+
+		for (let idx = 0; idx < items.length; ++idx)
+		{
+			const { transport, options } = items[idx];
+
+			try
+			{
+				if (!transport || !this.#transports.has(transport.id))
+					throw new TypeError('Transport not found in this Router');
+				else if (transport.constructor.name === 'PipeTransport')
+					throw new TypeError('PipeTransport not supported');
+
+				// This may throw.
+				const consumeRequest = transport.prepareConsume(options);
+
+				consumeItems.push({ idx, transport, consumeRequest });
+			}
+			catch (error)
+			{
+				results[idx] = error as Error;
+			}
+		}
+
+		const responses = await this.bulkRequest(
+			consumeItems.map(({ consumeRequest }) => (
+				{
+					method   : 'transport.consume',
+					internal : consumeRequest.internal,
+					data     : consumeRequest.reqData
+				})));
+
+		consumeItems.forEach(({ idx, transport, consumeRequest }, responseIdx) =>
+		{
+			const response = responses[responseIdx];
+
+			results[idx] = response.accepted
+				? transport.createConsumer(consumeRequest, response.data)
+				: bulkResponseError(response);
+		});
+
+		return results;
+	}
+
+	/**
+	 * Pause many Consumers within a single request to the worker. For each given
+	 * Consumer, the Error that prevented pausing it (if any) is returned.
+	 */
+	async pauseConsumers(consumers: Consumer[]): Promise<(Error | undefined)[]>
+	{
+		logger.debug('pauseConsumers()');
+
+		const wasPaused = consumers.map((consumer) => (
+			consumer.paused || consumer.producerPaused
+		));
+		const responses = await this.bulkRequest(
+			consumers.map((consumer) => consumer.getBulkRequest('consumer.pause')));
+
+		return responses.map((response, idx) =>
+		{
+			if (!response.accepted)
+				return bulkResponseError(response);
+
+			consumers[idx].handlePaused(wasPaused[idx]);
+		});
+	}
+
+	/**
+	 * Resume many Consumers within a single request to the worker. For each given
+	 * Consumer, the Error that prevented resuming it (if any) is returned.
+	 */
+	async resumeConsumers(consumers: Consumer[]): Promise<(Error | undefined)[]>
+	{
+		logger.debug('resumeConsumers()');
+
+		const wasPaused = consumers.map((consumer) => (
+			consumer.paused || consumer.producerPaused
+		));
+		const responses = await this.bulkRequest(
+			consumers.map((consumer) => consumer.getBulkRequest('consumer.resume')));
+
+		return responses.map((response, idx) =>
+		{
+			if (!response.accepted)
+				return bulkResponseError(response);
+
+			consumers[idx].handleResumed(wasPaused[idx]);
+		});
+	}
+
+	/**
+	 * Set preferred video layers of many Consumers within a single request to the
+	 * worker. For each given item, the Error that prevented setting them (if any)
+	 * is returned.
+	 */
+	async setConsumersPreferredLayers(
+		items: ConsumerPreferredLayersItem[]
+	): Promise<(Error | undefined)[]>
+	{
+		logger.debug('setConsumersPreferredLayers()');
+
+		const responses = await this.bulkRequest(
+			items.map(({ consumer, preferredLayers }) => (
+				consumer.getBulkRequest(
+					'consumer.setPreferredLayers',
+					{
+						spatialLayer  : preferredLayers.spatialLayer,
+						temporalLayer : preferredLayers.temporalLayer
+					}))));
+
+		return responses.map((response, idx) =>
+		{
+			if (!response.accepted)
+				return bulkResponseError(response);
+
+			items[idx].consumer.handlePreferredLayers(response.data);
+		});
+	}
+
 	/**
 	 * Check whether the given RTP capabilities can consume the given Producer.
 	 */
@@ -1112,4 +1306,31 @@ export class Router extends EnhancedEventEmitter<RouterEvents>
 			return false;
 		}
 	}
+
+	/**
+	 * Send the given requests within a single bulk request. Bitrate distribution
+	 * and key frame requests needed by them are done once in the worker.
+	 */
+	private async bulkRequest(requests: BulkRequest[]): Promise<any[]>
+	{
+		if (requests.length === 0)
+			return [];
+
+		const data = await this.#channel.request(
+			'router.bulkRequest', this.#internal, { requests });
+
+		return data.responses;
+	}
+}
+
+function bulkResponseError(response: any): Error
+{
+	switch (response.error)
+	{
+		case 'TypeError':
+			return new TypeError(response.reason);
+
+		default:
+			return new Error(response.reason);
+	}
 }
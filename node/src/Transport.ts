@@ -17,7 +17,7 @@ import {
 	DataConsumerOptions,
 	DataConsumerType
 } from './DataConsumer';
-import { RtpCapabilities } from './RtpParameters';
+import { RtpCapabilities, RtpParameters } from './RtpParameters';
 import { SctpParameters, SctpStreamParameters } from './SctpParameters';
 
 export interface TransportListenIp
@@ -105,6 +105,17 @@ export type TransportObserverEvents =
 	trace: [TransportTraceEventData];
 }
 
+/**
+ * @private
+ */
+export type ConsumeRequest =
+{
+	internal: any;
+	reqData: any;
+	data: any;
+	appData?: Record<string, unknown>;
+};
+
 const logger = new Logger('Transport');
 
 export class Transport<Events extends TransportEvents = TransportEvents,
@@ -514,6 +525,8 @@ export class Transport<Events extends TransportEvents = TransportEvents,
 			rtpParameters,
 			paused = false,
 			keyFrameRequestDelay,
+			keyFrameCacheMaxSize,
+			importState,
 			appData
 		}: ProducerOptions
 	): Promise<Producer>
@@ -526,6 +539,8 @@ export class Transport<Events extends TransportEvents = TransportEvents,
 			throw new TypeError(`invalid kind "${kind}"`);
 		else if (appData && typeof appData !== 'object')
 			throw new TypeError('if given, appData must be an object');
+		else if (importState && !Array.isArray(importState.rtpState))
+			throw new TypeError('if given, importState must be an exported Producer state');
 
 		// This may throw.
 		ortc.validateRtpParameters(rtpParameters);
@@ -573,7 +588,16 @@ export class Transport<Events extends TransportEvents = TransportEvents,
 			kind, rtpParameters, routerRtpCapabilities, rtpMapping);
 
 		const internal = { ...this.internal, producerId: id || uuidv4() };
-		const reqData = { kind, rtpParameters, rtpMapping, keyFrameRequestDelay, paused };
+		const reqData =
+		{
+			kind,
+			rtpParameters,
+			rtpMapping,
+			keyFrameRequestDelay,
+			keyFrameCacheMaxSize,
+			paused,
+			rtpState : importState ? importState.rtpState : undefined
+		};
 
 		const status =
 			await this.channel.request('transport.produce', internal, reqData);
@@ -616,7 +640,23 @@ export class Transport<Events extends TransportEvents = TransportEvents,
 	 *
 	 * @virtual
 	 */
-	async consume(
+	async consume(options: ConsumerOptions): Promise<Consumer>
+	{
+		logger.debug('consume()');
+
+		const consumeRequest = this.prepareConsume(options);
+		const status = await this.channel.request(
+			'transport.consume', consumeRequest.internal, consumeRequest.reqData);
+
+		return this.createConsumer(consumeRequest, status);
+	}
+
+	/**
+	 * Validate the given options and build the request to create a Consumer.
+	 *
+	 * @private
+	 */
+	prepareConsume(
 		{
 			producerId,
 			rtpCapabilities,
@@ -624,19 +664,35 @@ export class Transport<Events extends TransportEvents = TransportEvents,
 			mid,
 			preferredLayers,
 			ignoreDtx = false,
+			redThreshold,
+			fecMinRtt,
 			pipe = false,
+			importState,
 			appData
 		}: ConsumerOptions
-	): Promise<Consumer>
+	): ConsumeRequest
 	{
-		logger.debug('consume()');
-
 		if (!producerId || typeof producerId !== 'string')
 			throw new TypeError('missing producerId');
 		else if (appData && typeof appData !== 'object')
 			throw new TypeError('if given, appData must be an object');
 		else if (mid && (typeof mid !== 'string' || mid.length === 0))
 			throw new TypeError('if given, mid must be non empty string');
+		else if (
+			redThreshold !== undefined &&
+			(typeof redThreshold !== 'number' || redThreshold < 0 || redThreshold > 1)
+		)
+		{
+			throw new TypeError('if given, redThreshold must be a number between 0 and 1');
+		}
+		else if (fecMinRtt !== undefined && (typeof fecMinRtt !== 'number' || fecMinRtt < 0))
+		{
+			throw new TypeError('if given, fecMinRtt must be a non negative number');
+		}
+		else if (importState && typeof importState.rtpState !== 'object')
+		{
+			throw new TypeError('if given, importState must be an exported Consumer state');
+		}
 
 		// This may throw.
 		ortc.validateRtpCapabilities(rtpCapabilities!);
@@ -646,12 +702,39 @@ export class Transport<Events extends TransportEvents = TransportEvents,
 		if (!producer)
 			throw Error(`Producer with id "${producerId}" not found`);
 
-		// This may throw.
-		const rtpParameters = ortc.getConsumerRtpParameters(
-			producer.consumableRtpParameters, rtpCapabilities!, pipe);
+		let rtpParameters: RtpParameters;
+
+		// A Consumer continuing an exported one keeps its RTP parameters (SSRCs
+		// and MID included) so the endpoint does not notice.
+		if (importState)
+		{
+			rtpParameters = utils.clone(importState.rtpParameters);
+
+			// This may throw.
+			ortc.validateRtpParameters(rtpParameters);
+
+			// Do not give its MID to later Consumers.
+			const importedMid = Number(rtpParameters.mid);
+
+			if (Number.isInteger(importedMid) && importedMid >= this.#nextMidForConsumers)
+				this.#nextMidForConsumers = importedMid + 1;
+		}
+		else
+		{
+			// This may throw.
+			rtpParameters = ortc.getConsumerRtpParameters(
+				producer.consumableRtpParameters,
+				rtpCapabilities!,
+				pipe,
+				{
+					enableRed : redThreshold !== undefined,
+					// FEC packets are just generated by simple Consumers.
+					enableFec : fecMinRtt !== undefined && producer.type === 'simple'
+				});
+		}
 
 		// Set MID.
-		if (!pipe)
+		if (!pipe && !importState)
 		{
 			if (mid)
 			{
@@ -682,12 +765,11 @@ export class Transport<Events extends TransportEvents = TransportEvents,
 			consumableRtpEncodings : producer.consumableRtpParameters.encodings,
 			paused,
 			preferredLayers,
-			ignoreDtx
+			ignoreDtx,
+			redThreshold,
+			fecMinRtt,
+			rtpState               : importState ? importState.rtpState : undefined
 		};
-
-		const status =
-			await this.channel.request('transport.consume', internal, reqData);
-
 		const data =
 		{
 			producerId,
@@ -696,6 +778,19 @@ export class Transport<Events extends TransportEvents = TransportEvents,
 			type : pipe ? 'pipe' : producer.type
 		};
 
+		return { internal, reqData, data, appData };
+	}
+
+	/**
+	 * Create the Consumer once the worker has created it.
+	 *
+	 * @private
+	 */
+	createConsumer(
+		{ internal, data, appData }: ConsumeRequest,
+		status: any
+	): Consumer
+	{
 		const consumer = new Consumer(
 			{
 				internal,
@@ -26,6 +26,14 @@ export interface WebRtcServerListenInfo
 	 * Listening port.
 	 */
 	port: number;
+
+	/**
+	 * Bind the port with SO_REUSEPORT so other workers (running as threads in
+	 * the same process) can listen in the same IP and port. Packets received by
+	 * a worker that does not own their WebRtcTransport are forwarded to the
+	 * owning one. Just valid for 'udp' protocol. Default false.
+	 */
+	reusePort?: boolean;
 }
 
 export type WebRtcServerOptions =
@@ -10,14 +10,18 @@ import {
 	SctpState
 } from './Transport';
 import { WebRtcServer } from './WebRtcServer';
+import { Router } from './Router';
+import { ProducerExportedState } from './Producer';
+import { ConsumerExportedState } from './Consumer';
 import { SctpParameters, NumSctpStreams } from './SctpParameters';
-import { Either } from './utils';
+import { SrtpCryptoSuite } from './SrtpParameters';
+import { Only } from './utils';
 
 export type WebRtcTransportListenIndividual =
 {
 	/**
 	 * Listening IP address or addresses in order of preference (first one is the
-	 * preferred one). Mandatory unless webRtcServer is given.
+	 * preferred one). Mandatory unless webRtcServer or importState is given.
 	 */
 	listenIps: (TransportListenIp | string)[];
 
@@ -31,13 +35,35 @@ export type WebRtcTransportListenIndividual =
 export type WebRtcTransportListenServer =
 {
 	/**
-	 * Instance of WebRtcServer. Mandatory unless listenIps is given.
+	 * Instance of WebRtcServer. Mandatory unless listenIps or importState is
+	 * given.
 	 */
 	webRtcServer: WebRtcServer;
 }
 
+export type WebRtcTransportListenImport =
+{
+	/**
+	 * State exported by a WebRtcTransport in a Router of another Worker (see
+	 * webRtcTransport.exportState()). Mandatory unless listenIps or webRtcServer
+	 * is given.
+	 */
+	importState: WebRtcTransportExportedState;
+}
+
 export type WebRtcTransportListen =
-	Either<WebRtcTransportListenIndividual, WebRtcTransportListenServer>;
+	| Only<
+		WebRtcTransportListenIndividual,
+		WebRtcTransportListenServer & WebRtcTransportListenImport
+	>
+	| Only<
+		WebRtcTransportListenServer,
+		WebRtcTransportListenIndividual & WebRtcTransportListenImport
+	>
+	| Only<
+		WebRtcTransportListenImport,
+		WebRtcTransportListenIndividual & WebRtcTransportListenServer
+	>;
 
 export type WebRtcTransportOptionsBase =
 {
@@ -134,6 +160,53 @@ export type DtlsFingerprint =
 
 export type IceState = 'new' | 'connected' | 'completed' | 'disconnected' | 'closed';
 
+/**
+ * ICE, DTLS and SRTP state of a WebRtcTransport given to a WebRtcTransport
+ * created in another Worker so it continues the same session. It must be
+ * given as is.
+ */
+export type WebRtcTransportExportedState =
+{
+	/**
+	 * Unix socket path to which the UDP sockets were sent.
+	 */
+	socketPath: string;
+	iceParameters: IceParameters;
+	iceState: 'connected' | 'completed';
+	iceSelectedTuple:
+	{
+		socketIndex: number;
+		remoteIp: string;
+		remotePort: number;
+	};
+	udpSockets:
+	{
+		ip: string;
+		port: number;
+		announcedIp?: string;
+	}[];
+	dtlsLocalRole: 'client' | 'server';
+	srtpParameters:
+	{
+		cryptoSuite: SrtpCryptoSuite;
+		localKeyBase64: string;
+		remoteKeyBase64: string;
+	};
+	/**
+	 * SRTP rollover counter and index of the last sent SRTCP packet of received
+	 * and sent streams.
+	 */
+	recvStreams: { ssrc: number; roc: number; rtcpIndex: number }[];
+	sendStreams: { ssrc: number; roc: number; rtcpIndex: number }[];
+	/**
+	 * State of the Producers and Consumers indexed by their id, to be given as
+	 * importState option of transport.produce() and transport.consume() when
+	 * creating them again in the new transport.
+	 */
+	producers: Record<string, ProducerExportedState>;
+	consumers: Record<string, ConsumerExportedState>;
+}
+
 export type DtlsRole = 'auto' | 'client' | 'server';
 
 export type DtlsState = 'new' | 'connecting' | 'connected' | 'failed' | 'closed';
@@ -421,6 +494,33 @@ export class WebRtcTransport extends
 		return iceParameters;
 	}
 
+	/**
+	 * Export the ICE, DTLS and SRTP state so a WebRtcTransport created with it
+	 * (importState option) in the given Router of another Worker in the same
+	 * host takes over the session with the remote endpoint. The UDP sockets are
+	 * sent to that Worker now. This transport stops sending and receiving and
+	 * should be closed once the new one has been created.
+	 *
+	 * Just connected transports listening in UDP without WebRtcServer nor SCTP
+	 * can be exported. Producers and Consumers must be created again in the new
+	 * transport with their exported state (importState option), so their RTP
+	 * streams continue. A transport created with an exported state cannot be
+	 * exported again.
+	 */
+	async exportState(
+		{ router }: { router: Router }
+	): Promise<WebRtcTransportExportedState>
+	{
+		logger.debug('exportState()');
+
+		const socketPath = await router.prepareWebRtcTransportImport();
+
+		const state = await this.channel.request(
+			'transport.exportState', this.internal, { socketPath });
+
+		return state;
+	}
+
 	private handleWorkerNotifications(): void
 	{
 		this.channel.on(this.internal.transportId, (event: string, data?: any) =>
@@ -27,6 +27,8 @@ export type WorkerLogTag =
   | 'sctp'
   | 'message'
 
+export type WorkerOverloadDegradationStep = 'retransmissions' | 'layers' | 'rtcp';
+
 export type WorkerSettings =
 {
 	/**
@@ -64,13 +66,69 @@ export type WorkerSettings =
 	 */
 	dtlsPrivateKeyFile?: string;
 
+	/**
+	 * Maximum memory (in bytes) used by all the RTP retransmission buffers in
+	 * the worker. Once reached, oldest packets are discarded first. Default 0
+	 * (no limit).
+	 */
+	retransmissionBufferMaxMemory?: number;
+
+	/**
+	 * Number of threads running DTLS handshakes so they don't block media
+	 * processing in the worker. Default 0 (DTLS handshakes are run within the
+	 * worker main thread).
+	 */
+	dtlsHandshakeThreads?: number;
+
+	/**
+	 * Use the io_uring I/O path for media sockets (just in Linux >= 6.0 and if
+	 * supported by the mediasoup-worker build). Default false.
+	 */
+	useIoUring?: boolean;
+
+	/**
+	 * Number of UDP sockets kept bound in advance per listen IP so creation of
+	 * WebRTC and plain transports doesn't need to bind new ones. The pool of an
+	 * IP is created once a transport listens on it. Default 0 (no pool).
+	 */
+	udpSocketPoolSize?: number;
+
+	/**
+	 * Number of entries of the ring through which the worker records its logs.
+	 * If set, logs are formatted and sent by a background thread so they don't
+	 * load the worker thread (entries are dropped if the ring gets full).
+	 * Default 0 (logs are sent synchronously).
+	 */
+	logRingSize?: number;
+
+	/**
+	 * Event loop lag (in ms) from which the worker is considered overloaded.
+	 * While overloaded, the worker applies the overloadDegradationSteps one by
+	 * one and emits 'overloadstatechange'. Default 0 (overload control
+	 * disabled).
+	 */
+	overloadLoopLagThreshold?: number;
+
+	/**
+	 * Event loop busy time (in percentage) from which the worker is considered
+	 * overloaded. Just used if overloadLoopLagThreshold is set. Default 90.
+	 */
+	overloadLoopBusyThreshold?: number;
+
+	/**
+	 * Degradation steps applied, in this order, while the worker is overloaded.
+	 * Default ['retransmissions', 'layers', 'rtcp'].
+	 */
+	overloadDegradationSteps?: WorkerOverloadDegradationStep[];
+
 	/**
 	 * Custom application data.
 	 */
 	appData?: Record<string, unknown>;
 }
 
-export type WorkerUpdateableSettings = Pick<WorkerSettings, 'logLevel' | 'logTags'>;
+export type WorkerUpdateableSettings =
+	Pick<WorkerSettings, 'logLevel' | 'logTags' | 'retransmissionBufferMaxMemory'>;
 
 /**
  * An object with the fields of the uv_rusage_t struct.
@@ -163,11 +221,46 @@ export type WorkerResourceUsage =
 	ru_nivcsw: number;
 
 	/* eslint-enable camelcase */
+
+	/**
+	 * Memory (in bytes) used by RTP retransmission buffers.
+	 */
+	retransmissionBufferMemory: number;
+
+	/**
+	 * Number of RTP packets discarded from retransmission buffers due to the
+	 * retransmissionBufferMaxMemory limit.
+	 */
+	retransmissionBufferEvictedPackets: number;
+}
+
+export type WorkerOverloadState =
+{
+	/**
+	 * Number of degradation steps currently applied.
+	 */
+	level: number;
+
+	/**
+	 * Degradation steps currently applied.
+	 */
+	appliedSteps: WorkerOverloadDegradationStep[];
+
+	/**
+	 * Last measured event loop lag (in ms).
+	 */
+	loopLag: number;
+
+	/**
+	 * Last measured event loop busy time (in percentage).
+	 */
+	loopBusy: number;
 }
 
 export type WorkerEvents = 
 { 
 	died: [Error];
+	overloadstatechange: [WorkerOverloadState];
 	// Private events.
 	'@success': [];
 	'@failure': [Error];
@@ -235,6 +328,14 @@ export class Worker extends EnhancedEventEmitter<WorkerEvents>
 			rtcMaxPort,
 			dtlsCertificateFile,
 			dtlsPrivateKeyFile,
+			retransmissionBufferMaxMemory,
+			dtlsHandshakeThreads,
+			useIoUring,
+			udpSocketPoolSize,
+			logRingSize,
+			overloadLoopLagThreshold,
+			overloadLoopBusyThreshold,
+			overloadDegradationSteps,
 			appData
 		}: WorkerSettings)
 	{
@@ -278,6 +379,52 @@ export class Worker extends EnhancedEventEmitter<WorkerEvents>
 		if (typeof dtlsPrivateKeyFile === 'string' && dtlsPrivateKeyFile)
 			spawnArgs.push(`--dtlsPrivateKeyFile=${dtlsPrivateKeyFile}`);
 
+		if (
+			typeof retransmissionBufferMaxMemory === 'number' &&
+			!Number.isNaN(retransmissionBufferMaxMemory)
+		)
+		{
+			spawnArgs.push(
+				`--retransmissionBufferMaxMemory=${retransmissionBufferMaxMemory}`);
+		}
+
+		if (typeof dtlsHandshakeThreads === 'number' && !Number.isNaN(dtlsHandshakeThreads))
+			spawnArgs.push(`--dtlsHandshakeThreads=${dtlsHandshakeThreads}`);
+
+		if (typeof useIoUring === 'boolean')
+			spawnArgs.push(`--useIoUring=${useIoUring}`);
+
+		if (typeof udpSocketPoolSize === 'number' && !Number.isNaN(udpSocketPoolSize))
+			spawnArgs.push(`--udpSocketPoolSize=${udpSocketPoolSize}`);
+
+		if (typeof logRingSize === 'number' && !Number.isNaN(logRingSize))
+			spawnArgs.push(`--logRingSize=${logRingSize}`);
+
+		if (
+			typeof overloadLoopLagThreshold === 'number' &&
+			!Number.isNaN(overloadLoopLagThreshold)
+		)
+		{
+			spawnArgs.push(`--overloadLoopLagThreshold=${overloadLoopLagThreshold}`);
+		}
+
+		if (
+			typeof overloadLoopBusyThreshold === 'number' &&
+			!Number.isNaN(overloadLoopBusyThreshold)
+		)
+		{
+			spawnArgs.push(`--overloadLoopBusyThreshold=${overloadLoopBusyThreshold}`);
+		}
+
+		for (
+			const step of
+			(Array.isArray(overloadDegradationSteps) ? overloadDegradationSteps : [])
+		)
+		{
+			if (typeof step === 'string' && step)
+				spawnArgs.push(`--overloadDegradationSteps=${step}`);
+		}
+
 		logger.debug(
 			'spawning worker process: %s %s', spawnBin, spawnArgs.join(' '));
 
@@ -345,6 +492,13 @@ export class Worker extends EnhancedEventEmitter<WorkerEvents>
 			}
 		});
 
+		// Listen for overload notifications.
+		this.#channel.on(String(this.#pid), (event: string, data?: any) =>
+		{
+			if (event === 'overloadstatechange')
+				this.safeEmit('overloadstatechange', data as WorkerOverloadState);
+		});
+
 		this.#child.on('exit', (code, signal) =>
 		{
 			this.#child = undefined;
@@ -568,13 +722,14 @@ export class Worker extends EnhancedEventEmitter<WorkerEvents>
 	async updateSettings(
 		{
 			logLevel,
-			logTags
+			logTags,
+			retransmissionBufferMaxMemory
 		}: WorkerUpdateableSettings = {}
 	): Promise<void>
 	{
 		logger.debug('updateSettings()');
 
-		const reqData = { logLevel, logTags };
+		const reqData = { logLevel, logTags, retransmissionBufferMaxMemory };
 
 		await this.#channel.request('worker.updateSettings', undefined, reqData);
 	}
@@ -46,6 +46,14 @@ export async function createWorker(
 		rtcMaxPort = 59999,
 		dtlsCertificateFile,
 		dtlsPrivateKeyFile,
+		retransmissionBufferMaxMemory,
+		dtlsHandshakeThreads,
+		useIoUring,
+		udpSocketPoolSize,
+		logRingSize,
+		overloadLoopLagThreshold,
+		overloadLoopBusyThreshold,
+		overloadDegradationSteps,
 		appData
 	}: WorkerSettings = {}
 ): Promise<Worker>
@@ -63,6 +71,14 @@ export async function createWorker(
 			rtcMaxPort,
 			dtlsCertificateFile,
 			dtlsPrivateKeyFile,
+			retransmissionBufferMaxMemory,
+			dtlsHandshakeThreads,
+			useIoUring,
+			udpSocketPoolSize,
+			logRingSize,
+			overloadLoopLagThreshold,
+			overloadLoopBusyThreshold,
+			overloadDegradationSteps,
 			appData
 		});
 
@@ -643,8 +643,9 @@ export function generateRouterRtpCapabilities(
 		// Append to the codec list.
 		caps.codecs!.push(codec);
 
-		// Add a RTX video codec if video.
-		if (codec.kind === 'video')
+		// Add a RTX video codec if video (but not for RED and ULPFEC since their
+		// packets are generated by Consumers).
+		if (codec.kind === 'video' && !isRedCodec(codec) && !isUlpfecCodec(codec))
 		{
 			// Take the first available pt and remove it from the list.
 			const pt = dynamicPayloadTypes.shift();
@@ -931,12 +932,18 @@ export function canConsume(
  *
  * It reduces encodings to just one and takes into account given RTP capabilities
  * to reduce codecs, codecs' RTCP feedback and header extensions, and also enables
- * or disabled RTX.
+ * or disabled RTX. If enableRed is set, it adds the RED codec of the given RTP
+ * capabilities for Opus. If enableFec is set, it adds the RED and ULPFEC codecs
+ * of the given RTP capabilities for video.
  */
 export function getConsumerRtpParameters(
 	consumableParams: RtpParameters,
 	caps: RtpCapabilities,
-	pipe: boolean
+	pipe: boolean,
+	{
+		enableRed = false,
+		enableFec = false
+	}: { enableRed?: boolean; enableFec?: boolean } = {}
 ): RtpParameters
 {
 	const consumerParams: RtpParameters =
@@ -994,6 +1001,18 @@ export function getConsumerRtpParameters(
 		throw new UnsupportedError('no compatible media codecs');
 	}
 
+	// RED and ULPFEC packets are generated by the Consumer, so their codecs are
+	// added even if the Producer does not use them.
+	if (!pipe)
+	{
+		const mediaMimeType = consumerParams.codecs[0].mimeType.toLowerCase();
+
+		if (enableRed && mediaMimeType === 'audio/opus')
+			addGeneratedCodecs(consumerParams, caps, [ isRedCodec ]);
+		else if (enableFec && mediaMimeType.startsWith('video/'))
+			addGeneratedCodecs(consumerParams, caps, [ isRedCodec, isUlpfecCodec ]);
+	}
+
 	consumerParams.headerExtensions = consumableParams.headerExtensions!
 		.filter((ext) => (
 			caps.headerExtensions!
@@ -1184,6 +1203,60 @@ function isRtxCodec(codec: RtpCodecCapability | RtpCodecParameters): boolean
 	return /.+\/rtx$/i.test(codec.mimeType);
 }
 
+function isRedCodec(codec: RtpCodecCapability | RtpCodecParameters): boolean
+{
+	return /.+\/red$/i.test(codec.mimeType);
+}
+
+function isUlpfecCodec(codec: RtpCodecCapability | RtpCodecParameters): boolean
+{
+	return /.+\/ulpfec$/i.test(codec.mimeType);
+}
+
+/**
+ * Adds to the given Consumer RTP parameters the capability codecs matching
+ * the given checks (all of them or none) with the kind and clock rate of its
+ * media codec.
+ */
+function addGeneratedCodecs(
+	consumerParams: RtpParameters,
+	caps: RtpCapabilities,
+	checks: ((codec: RtpCodecCapability | RtpCodecParameters) => boolean)[]
+): void
+{
+	const mediaCodec = consumerParams.codecs[0];
+	const kind = mediaCodec.mimeType.split('/')[0].toLowerCase();
+
+	if (consumerParams.codecs.some((codec) => checks.some((check) => check(codec))))
+		return;
+
+	const capCodecs = checks
+		.map((check) => caps.codecs!
+			.find((capCodec) => (
+				check(capCodec) &&
+				capCodec.kind === kind &&
+				capCodec.clockRate === mediaCodec.clockRate &&
+				!consumerParams.codecs
+					.some((codec) => codec.payloadType === capCodec.preferredPayloadType)
+			)));
+
+	if (capCodecs.some((capCodec) => !capCodec))
+		return;
+
+	for (const capCodec of capCodecs as RtpCodecCapability[])
+	{
+		consumerParams.codecs.push(
+			{
+				mimeType     : capCodec.mimeType,
+				payloadType  : capCodec.preferredPayloadType!,
+				clockRate    : capCodec.clockRate,
+				channels     : capCodec.channels,
+				parameters   : {},
+				rtcpFeedback : []
+			});
+	}
+}
+
 function matchCodecs(
 	aCodec: RtpCodecCapability | RtpCodecParameters,
 	bCodec: RtpCodecCapability | RtpCodecParameters,
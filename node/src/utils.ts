@@ -19,7 +19,7 @@ export function generateRandomNumber()
 	return randomInt(100_000_000, 999_999_999);
 }
 
-type Only<T, U> = {
+export type Only<T, U> = {
 	[P in keyof T]: T[P];
 } & {
 	[P in keyof U]?: never;
@@ -63,6 +63,10 @@ test('router.createActiveSpeakerObserver() with wrong arguments rejects with Typ
 	await expect(router.createActiveSpeakerObserver({ appData: 'NOT-AN-OBJECT' }))
 		.rejects
 		.toThrow(TypeError);
+
+	await expect(router.createActiveSpeakerObserver({ lastN: 1, lastNMode: 'foo' }))
+		.rejects
+		.toThrow(TypeError);
 }, 2000);
 
 test('activeSpeakerObserver.pause() and resume() succeed', async () =>
@@ -76,6 +80,92 @@ test('activeSpeakerObserver.pause() and resume() succeed', async () =>
 	expect(activeSpeakerObserver.paused).toBe(false);
 }, 2000);
 
+test('activeSpeakerObserver with lastN pauses Consumers of other speakers', async () =>
+{
+	// We need a different Router here.
+	const router2 = await worker.createRouter({ mediaCodecs });
+	const transport1 = await router2.createWebRtcTransport({ listenIps: [ '127.0.0.1' ] });
+	const transport2 = await router2.createWebRtcTransport({ listenIps: [ '127.0.0.1' ] });
+	const producers = [];
+	const consumers = [];
+
+	for (const ssrc of [ 11111111, 22222222 ])
+	{
+		const producer = await transport1.produce(
+			{
+				kind          : 'audio',
+				rtpParameters :
+				{
+					mid    : String(ssrc),
+					codecs :
+					[
+						{
+							mimeType    : 'audio/opus',
+							payloadType : 111,
+							clockRate   : 48000,
+							channels    : 2
+						}
+					],
+					encodings : [ { ssrc } ]
+				}
+			});
+
+		producers.push(producer);
+		consumers.push(await transport2.consume(
+			{
+				producerId      : producer.id,
+				rtpCapabilities : router2.rtpCapabilities
+			}));
+	}
+
+	const activeSpeakerObserver2 = await router2.createActiveSpeakerObserver();
+
+	await activeSpeakerObserver2.addProducer({ producerId: producers[0].id });
+
+	// lastN not enabled.
+	await expect(activeSpeakerObserver2.addConsumer(
+		{ consumerId: consumers[0].id, producerId: producers[0].id }))
+		.rejects
+		.toThrow(TypeError);
+
+	activeSpeakerObserver2.close();
+
+	// Long interval so the dominant speaker does not change during the test.
+	const activeSpeakerObserver3 =
+		await router2.createActiveSpeakerObserver({ interval: 5000, lastN: 1 });
+	const onLastNChange = jest.fn();
+
+	activeSpeakerObserver3.on('lastnchange', onLastNChange);
+
+	await activeSpeakerObserver3.addProducer({ producerId: producers[0].id });
+	await activeSpeakerObserver3.addProducer({ producerId: producers[1].id });
+
+	expect(onLastNChange).toHaveBeenCalledTimes(1);
+	expect(onLastNChange).toHaveBeenCalledWith({ producers: [ producers[0] ] });
+
+	for (let idx = 0; idx < consumers.length; ++idx)
+	{
+		await activeSpeakerObserver3.addConsumer(
+			{ consumerId: consumers[idx].id, producerId: producers[idx].id });
+	}
+
+	await expect(consumers[0].dump())
+		.resolves
+		.toMatchObject({ paused: false, lastNPaused: false });
+
+	await expect(consumers[1].dump())
+		.resolves
+		.toMatchObject({ paused: false, lastNPaused: true });
+
+	await activeSpeakerObserver3.removeConsumer({ consumerId: consumers[1].id });
+
+	await expect(consumers[1].dump())
+		.resolves
+		.toMatchObject({ lastNPaused: false });
+
+	router2.close();
+}, 2000);
+
 test('activeSpeakerObserver.close() succeeds', async () =>
 {
 	// We need different a AudioLevelObserver instance here.
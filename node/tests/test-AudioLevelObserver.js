@@ -108,6 +108,16 @@ test('audioLevelObserver.close() succeeds', async () =>
 
 }, 2000);
 
+test('audioLevelObserver emits "volumes" with the loudest Producers', async () =>
+{
+	await testVolumes({ binaryVolumes: false });
+}, 4000);
+
+test('audioLevelObserver with binaryVolumes emits "volumes" with the loudest Producers', async () =>
+{
+	await testVolumes({ binaryVolumes: true });
+}, 4000);
+
 test('AudioLevelObserver emits "routerclose" if Router is closed', async () =>
 {
 	// We need different Router and AudioLevelObserver instances here.
@@ -133,3 +143,86 @@ test('AudioLevelObserver emits "routerclose" if Worker is closed', async () =>
 
 	expect(audioLevelObserver.closed).toBe(true);
 }, 2000);
+
+async function testVolumes({ binaryVolumes })
+{
+	// We need different Router and AudioLevelObserver instances here.
+	const router2 = await worker.createRouter({ mediaCodecs });
+	const audioLevelObserver2 = await router2.createAudioLevelObserver(
+		{ maxEntries: 2, threshold: -127, interval: 1000, binaryVolumes });
+	const transport = await router2.createDirectTransport();
+	const producers = [];
+
+	for (let idx = 0; idx < 3; ++idx)
+	{
+		const producer = await transport.produce(
+			{
+				kind          : 'audio',
+				rtpParameters :
+				{
+					codecs :
+					[
+						{
+							mimeType    : 'audio/opus',
+							payloadType : 111,
+							clockRate   : 48000,
+							channels    : 2
+						}
+					],
+					headerExtensions :
+					[
+						{
+							uri : 'urn:ietf:params:rtp-hdrext:ssrc-audio-level',
+							id  : 1
+						}
+					],
+					encodings : [ { ssrc: 11111111 + idx } ]
+				}
+			});
+
+		await audioLevelObserver2.addProducer({ producerId: producer.id });
+
+		producers.push(producer);
+	}
+
+	const onVolumes = new Promise((resolve) => audioLevelObserver2.once('volumes', resolve));
+
+	// Each Producer sends a different audio level (-10, -20 and -30 dBov).
+	for (let seq = 1; seq <= 20; ++seq)
+	{
+		for (let idx = 0; idx < producers.length; ++idx)
+		{
+			producers[idx].send(createAudioLevelPacket(
+				{ ssrc: 11111111 + idx, seq, level: 10 * (idx + 1) }));
+		}
+	}
+
+	const volumes = await onVolumes;
+
+	expect(volumes.length).toBe(2);
+	expect(volumes[0].producer).toBe(producers[0]);
+	expect(volumes[0].volume).toBe(-10);
+	expect(volumes[1].producer).toBe(producers[1]);
+	expect(volumes[1].volume).toBe(-20);
+
+	router2.close();
+}
+
+function createAudioLevelPacket({ ssrc, seq, level })
+{
+	const packet = Buffer.alloc(24);
+
+	// Version 2 with header extension and payload type 111.
+	packet.writeUInt8(0x90, 0);
+	packet.writeUInt8(111, 1);
+	packet.writeUInt16BE(seq, 2);
+	packet.writeUInt32BE(seq * 960, 4);
+	packet.writeUInt32BE(ssrc, 8);
+	// One-Byte header extensions with ssrc-audio-level (id 1, length 1).
+	packet.writeUInt16BE(0xBEDE, 12);
+	packet.writeUInt16BE(1, 14);
+	packet.writeUInt8(0x10, 16);
+	packet.writeUInt8(level, 17);
+
+	return packet;
+}
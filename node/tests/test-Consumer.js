@@ -533,6 +533,67 @@ test('transport.consume() can be created with user provided mid', async () =>
 	audioConsumer1.close();
 }, 2000);
 
+test('router.consumeMany() succeeds', async () =>
+{
+	const onObserverNewConsumer = jest.fn();
+
+	transport2.observer.on('newconsumer', onObserverNewConsumer);
+
+	const [ audioConsumer1, videoConsumer1, error ] = await router.consumeMany(
+		[
+			{
+				transport : transport2,
+				options   :
+				{
+					producerId      : audioProducer.id,
+					rtpCapabilities : consumerDeviceCapabilities
+				}
+			},
+			{
+				transport : transport2,
+				options   :
+				{
+					producerId      : videoProducer.id,
+					rtpCapabilities : consumerDeviceCapabilities,
+					paused          : true
+				}
+			},
+			{
+				transport : transport2,
+				options   :
+				{
+					producerId      : 'foo',
+					rtpCapabilities : consumerDeviceCapabilities
+				}
+			}
+		]);
+
+	transport2.observer.removeListener('newconsumer', onObserverNewConsumer);
+
+	expect(onObserverNewConsumer).toHaveBeenCalledTimes(2);
+	expect(audioConsumer1.producerId).toBe(audioProducer.id);
+	expect(audioConsumer1.kind).toBe('audio');
+	expect(audioConsumer1.paused).toBe(false);
+	expect(videoConsumer1.producerId).toBe(videoProducer.id);
+	expect(videoConsumer1.kind).toBe('video');
+	expect(videoConsumer1.paused).toBe(true);
+	expect(error).toBeInstanceOf(Error);
+
+	await expect(router.dump())
+		.resolves
+		.toMatchObject(
+			{
+				mapConsumerIdProducerId :
+				{
+					[audioConsumer1.id] : audioProducer.id,
+					[videoConsumer1.id] : videoProducer.id
+				}
+			});
+
+	videoConsumer1.close();
+	audioConsumer1.close();
+}, 2000);
+
 test('transport.consume() with incompatible rtpCapabilities rejects with UnsupportedError', async () =>
 {
 	let invalidDeviceCapabilities;
@@ -810,6 +871,44 @@ test('consumer.setPreferredLayers() with wrong arguments rejects with TypeError'
 		.toThrow(TypeError);
 }, 2000);
 
+test('router.pauseConsumers() and resumeConsumers() succeed', async () =>
+{
+	await expect(router.pauseConsumers([ audioConsumer, videoConsumer ]))
+		.resolves
+		.toEqual([ undefined, undefined ]);
+
+	expect(audioConsumer.paused).toBe(true);
+	expect(videoConsumer.paused).toBe(true);
+
+	await expect(audioConsumer.dump())
+		.resolves
+		.toMatchObject({ paused: true });
+
+	await expect(router.resumeConsumers([ audioConsumer ]))
+		.resolves
+		.toEqual([ undefined ]);
+
+	expect(audioConsumer.paused).toBe(false);
+	expect(videoConsumer.paused).toBe(true);
+
+	await expect(audioConsumer.dump())
+		.resolves
+		.toMatchObject({ paused: false });
+}, 2000);
+
+test('router.setConsumersPreferredLayers() succeeds', async () =>
+{
+	const [ error1, error2 ] = await router.setConsumersPreferredLayers(
+		[
+			{ consumer: videoConsumer, preferredLayers: { spatialLayer: 1, temporalLayer: 1 } },
+			{ consumer: videoConsumer, preferredLayers: { temporalLayer: 2 } }
+		]);
+
+	expect(error1).toBeUndefined();
+	expect(error2).toBeInstanceOf(TypeError);
+	expect(videoConsumer.preferredLayers).toEqual({ spatialLayer: 1, temporalLayer: 0 });
+}, 2000);
+
 test('consumer.setPriority() succeed', async () =>
 {
 	await videoConsumer.setPriority(2);
@@ -36,13 +36,14 @@ test('createWorker() succeeds', async () =>
 	// eslint-disable-next-line require-atomic-updates
 	worker = await createWorker(
 		{
-			logLevel            : 'debug',
-			logTags             : [ 'info' ],
-			rtcMinPort          : 0,
-			rtcMaxPort          : 9999,
-			dtlsCertificateFile : path.join(__dirname, 'data', 'dtls-cert.pem'),
-			dtlsPrivateKeyFile  : path.join(__dirname, 'data', 'dtls-key.pem'),
-			appData             : { bar: 456 }
+			logLevel             : 'debug',
+			logTags              : [ 'info' ],
+			rtcMinPort           : 0,
+			rtcMaxPort           : 9999,
+			dtlsCertificateFile  : path.join(__dirname, 'data', 'dtls-cert.pem'),
+			dtlsPrivateKeyFile   : path.join(__dirname, 'data', 'dtls-key.pem'),
+			dtlsHandshakeThreads : 2,
+			appData              : { bar: 456 }
 		});
 	expect(worker).toBeType('object');
 	expect(worker.pid).toBeType('number');
@@ -79,6 +80,10 @@ test('createWorker() with wrong settings rejects with TypeError', async () =>
 		.rejects
 		.toThrow(TypeError);
 
+	await expect(createWorker({ dtlsHandshakeThreads: -1 }))
+		.rejects
+		.toThrow(TypeError);
+
 	await expect(createWorker({ appData: 'NOT-AN-OBJECT' }))
 		.rejects
 		.toThrow(TypeError);
@@ -95,6 +100,21 @@ test('worker.updateSettings() succeeds', async () =>
 	worker.close();
 }, 2000);
 
+test('worker.updateSettings() with retransmissionBufferMaxMemory succeeds', async () =>
+{
+	worker = await createWorker({ retransmissionBufferMaxMemory: 10000000 });
+
+	await expect(worker.updateSettings({ retransmissionBufferMaxMemory: 5000000 }))
+		.resolves
+		.toBeUndefined();
+
+	await expect(worker.updateSettings({ retransmissionBufferMaxMemory: -1 }))
+		.rejects
+		.toThrow(TypeError);
+
+	worker.close();
+}, 2000);
+
 test('worker.updateSettings() with wrong settings rejects with TypeError', async () =>
 {
 	worker = await createWorker();
@@ -147,7 +167,11 @@ test('worker.getResourceUsage() succeeds', async () =>
 
 	await expect(worker.getResourceUsage())
 		.resolves
-		.toMatchObject({});
+		.toMatchObject(
+			{
+				retransmissionBufferMemory         : 0,
+				retransmissionBufferEvictedPackets : 0
+			});
 
 	worker.close();
 }, 2000);
@@ -547,6 +547,199 @@ test('getProducerRtpParametersMapping(), getConsumableRtpParameters(), getConsum
 		});
 });
 
+test('getConsumerRtpParameters() with enableRed adds the RED codec for Opus', () =>
+{
+	const mediaCodecs =
+	[
+		{
+			kind      : 'audio',
+			mimeType  : 'audio/opus',
+			clockRate : 48000,
+			channels  : 2
+		},
+		{
+			kind      : 'audio',
+			mimeType  : 'audio/red',
+			clockRate : 48000,
+			channels  : 2
+		}
+	];
+
+	const routerRtpCapabilities = ortc.generateRouterRtpCapabilities(mediaCodecs);
+
+	expect(routerRtpCapabilities.codecs.length).toBe(2);
+	expect(routerRtpCapabilities.codecs[1].mimeType).toBe('audio/red');
+
+	const redPayloadType = routerRtpCapabilities.codecs[1].preferredPayloadType;
+
+	// The Producer does not use RED.
+	const rtpParameters =
+	{
+		codecs :
+		[
+			{
+				mimeType    : 'audio/opus',
+				payloadType : 111,
+				clockRate   : 48000,
+				channels    : 2
+			}
+		],
+		headerExtensions : [],
+		encodings        :
+		[
+			{ ssrc: 11111111 }
+		],
+		rtcp :
+		{
+			cname : 'qwerty1234'
+		}
+	};
+
+	const rtpMapping =
+		ortc.getProducerRtpParametersMapping(rtpParameters, routerRtpCapabilities);
+
+	const consumableRtpParameters = ortc.getConsumableRtpParameters(
+		'audio', rtpParameters, routerRtpCapabilities, rtpMapping);
+
+	expect(consumableRtpParameters.codecs.length).toBe(1);
+
+	let consumerRtpParameters = ortc.getConsumerRtpParameters(
+		consumableRtpParameters, routerRtpCapabilities, false, { enableRed: true });
+
+	expect(consumerRtpParameters.codecs.length).toBe(2);
+	expect(consumerRtpParameters.codecs[0].mimeType).toBe('audio/opus');
+	expect(consumerRtpParameters.codecs[1]).toEqual(
+		{
+			mimeType     : 'audio/red',
+			payloadType  : redPayloadType,
+			clockRate    : 48000,
+			channels     : 2,
+			parameters   : {},
+			rtcpFeedback : []
+		});
+
+	// Not added if not enabled.
+	consumerRtpParameters = ortc.getConsumerRtpParameters(
+		consumableRtpParameters, routerRtpCapabilities, false);
+
+	expect(consumerRtpParameters.codecs.length).toBe(1);
+
+	// Not added if not supported by the consuming endpoint.
+	const rtpCapabilities =
+	{
+		codecs           : routerRtpCapabilities.codecs.slice(0, 1),
+		headerExtensions : []
+	};
+
+	consumerRtpParameters = ortc.getConsumerRtpParameters(
+		consumableRtpParameters, rtpCapabilities, false, { enableRed: true });
+
+	expect(consumerRtpParameters.codecs.length).toBe(1);
+});
+
+test('getConsumerRtpParameters() with enableFec adds the RED and ULPFEC codecs for video', () =>
+{
+	const mediaCodecs =
+	[
+		{
+			kind      : 'video',
+			mimeType  : 'video/VP8',
+			clockRate : 90000
+		},
+		{
+			kind      : 'video',
+			mimeType  : 'video/red',
+			clockRate : 90000
+		},
+		{
+			kind      : 'video',
+			mimeType  : 'video/ulpfec',
+			clockRate : 90000
+		}
+	];
+
+	const routerRtpCapabilities = ortc.generateRouterRtpCapabilities(mediaCodecs);
+
+	// RTX is just added for VP8.
+	expect(routerRtpCapabilities.codecs.length).toBe(4);
+	expect(routerRtpCapabilities.codecs[1].mimeType).toBe('video/rtx');
+	expect(routerRtpCapabilities.codecs[2].mimeType).toBe('video/red');
+	expect(routerRtpCapabilities.codecs[3].mimeType).toBe('video/ulpfec');
+
+	const redPayloadType = routerRtpCapabilities.codecs[2].preferredPayloadType;
+	const ulpfecPayloadType = routerRtpCapabilities.codecs[3].preferredPayloadType;
+
+	// The Producer does not use RED nor ULPFEC.
+	const rtpParameters =
+	{
+		codecs :
+		[
+			{
+				mimeType    : 'video/VP8',
+				payloadType : 96,
+				clockRate   : 90000
+			}
+		],
+		headerExtensions : [],
+		encodings        :
+		[
+			{ ssrc: 11111111 }
+		],
+		rtcp :
+		{
+			cname : 'qwerty1234'
+		}
+	};
+
+	const rtpMapping =
+		ortc.getProducerRtpParametersMapping(rtpParameters, routerRtpCapabilities);
+
+	const consumableRtpParameters = ortc.getConsumableRtpParameters(
+		'video', rtpParameters, routerRtpCapabilities, rtpMapping);
+
+	let consumerRtpParameters = ortc.getConsumerRtpParameters(
+		consumableRtpParameters, routerRtpCapabilities, false, { enableFec: true });
+
+	expect(consumerRtpParameters.codecs.length).toBe(4);
+	expect(consumerRtpParameters.codecs[0].mimeType).toBe('video/VP8');
+	expect(consumerRtpParameters.codecs[1].mimeType).toBe('video/rtx');
+	expect(consumerRtpParameters.codecs[2]).toEqual(
+		{
+			mimeType     : 'video/red',
+			payloadType  : redPayloadType,
+			clockRate    : 90000,
+			parameters   : {},
+			rtcpFeedback : []
+		});
+	expect(consumerRtpParameters.codecs[3]).toEqual(
+		{
+			mimeType     : 'video/ulpfec',
+			payloadType  : ulpfecPayloadType,
+			clockRate    : 90000,
+			parameters   : {},
+			rtcpFeedback : []
+		});
+
+	// Not added for pipe Consumers.
+	consumerRtpParameters = ortc.getConsumerRtpParameters(
+		consumableRtpParameters, routerRtpCapabilities, true, { enableFec: true });
+
+	expect(consumerRtpParameters.codecs.some((codec) => codec.mimeType === 'video/red'))
+		.toBe(false);
+
+	// None added if ULPFEC is not supported by the consuming endpoint.
+	const rtpCapabilities =
+	{
+		codecs           : routerRtpCapabilities.codecs.slice(0, 3),
+		headerExtensions : []
+	};
+
+	consumerRtpParameters = ortc.getConsumerRtpParameters(
+		consumableRtpParameters, rtpCapabilities, false, { enableFec: true });
+
+	expect(consumerRtpParameters.codecs.length).toBe(2);
+});
+
 test('getProducerRtpParametersMapping() with incompatible params throws UnsupportedError', () =>
 {
 	const mediaCodecs =
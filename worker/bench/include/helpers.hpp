@@ -0,0 +1,61 @@
+#ifndef MS_BENCH_HELPERS_HPP
+#define MS_BENCH_HELPERS_HPP
+
+#include "common.hpp"
+#include "Utils.hpp"
+#include <cstring> // std::memcpy(), std::memset()
+
+namespace helpers
+{
+	// Header extension ids used by the generated packets.
+	static constexpr uint8_t MidExtensionId{ 1u };
+	static constexpr uint8_t AbsSendTimeExtensionId{ 3u };
+	static constexpr uint8_t TransportWideCc01ExtensionId{ 5u };
+	// Length of the RTP header (extensions included) written below.
+	static constexpr size_t RtpHeaderLength{ 28u };
+
+	/**
+	 * Writes into the given buffer a RTP packet as sent by browsers (with MID,
+	 * abs-send-time and transport-wide-cc One-Byte extensions) whose payload
+	 * starts with the given codec payload descriptor, and returns its size.
+	 */
+	inline size_t writeRtpPacket(
+	  uint8_t* buffer,
+	  uint8_t payloadType,
+	  uint16_t seq,
+	  uint32_t timestamp,
+	  uint32_t ssrc,
+	  const uint8_t* descriptor,
+	  size_t descriptorLen,
+	  size_t payloadLength)
+	{
+		// clang-format off
+		uint8_t header[] =
+		{
+			0b10010000, 0b00000000, 0x00, 0x00, // Header extension, PT and seq set below.
+			0x00, 0x00, 0x00, 0x00,             // Timestamp.
+			0x00, 0x00, 0x00, 0x00,             // SSRC.
+			0xBE, 0xDE, 0x00, 0x03,             // One-Byte header extension (3 words).
+			0x10, 0x30,                         // MID "0".
+			0x32, 0x12, 0x34, 0x56,             // abs-send-time.
+			0x51, 0x00, 0x01,                   // transport-wide-cc.
+			0x00, 0x00, 0x00                    // Padding.
+		};
+		// clang-format on
+
+		static_assert(sizeof(header) == RtpHeaderLength, "wrong RTP header length");
+
+		header[1] = payloadType & 0x7Fu;
+		Utils::Byte::Set2Bytes(header, 2, seq);
+		Utils::Byte::Set4Bytes(header, 4, timestamp);
+		Utils::Byte::Set4Bytes(header, 8, ssrc);
+
+		std::memcpy(buffer, header, sizeof(header));
+		std::memcpy(buffer + sizeof(header), descriptor, descriptorLen);
+		std::memset(buffer + sizeof(header) + descriptorLen, 0xAB, payloadLength - descriptorLen);
+
+		return sizeof(header) + payloadLength;
+	}
+} // namespace helpers
+
+#endif
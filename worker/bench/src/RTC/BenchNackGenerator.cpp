@@ -0,0 +1,63 @@
+#include "common.hpp"
+#include "helpers.hpp"
+#include "RTC/NackGenerator.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace RTC;
+
+// Packets after which a lost packet is retransmitted.
+static constexpr uint16_t RecoveryDistance{ 10u };
+
+class BenchNackGeneratorListener : public NackGenerator::Listener
+{
+public:
+	void OnNackGeneratorNackRequired(const std::vector<uint16_t>& seqNumbers) override
+	{
+		this->numNacked += seqNumbers.size();
+	}
+	void OnNackGeneratorKeyFrameRequired() override
+	{
+	}
+
+public:
+	size_t numNacked{ 0u };
+};
+
+// With one out of `state.range(0)` packets being lost (zero meaning no losses)
+// and retransmitted RecoveryDistance packets later.
+static void BM_NackGeneratorReceivePacket(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	uint8_t descriptor[] = { 0x90, 0x80, 0x11, 0x00 };
+	auto size            = helpers::writeRtpPacket(
+	  buffer, 96u, 0u, 1000u, 1234u, descriptor, sizeof(descriptor), 1100u);
+	auto* packet = RtpPacket::Parse(buffer, size);
+	auto lossEvery = static_cast<uint16_t>(state.range(0));
+	BenchNackGeneratorListener listener;
+	NackGenerator nackGenerator(&listener, 0u);
+	uint16_t seq{ 0u };
+
+	for (auto _ : state)
+	{
+		++seq;
+
+		if (lossEvery != 0u && seq % lossEvery == 0u)
+			continue;
+
+		packet->SetSequenceNumber(seq);
+		nackGenerator.ReceivePacket(packet, /*isRecovered*/ false);
+
+		if (lossEvery != 0u && seq % lossEvery == RecoveryDistance)
+		{
+			packet->SetSequenceNumber(seq - RecoveryDistance);
+			nackGenerator.ReceivePacket(packet, /*isRecovered*/ true);
+		}
+	}
+
+	state.counters["nacked"] = static_cast<double>(listener.numNacked);
+
+	delete packet;
+}
+BENCHMARK(BM_NackGeneratorReceivePacket)->Arg(0)->Arg(20)->Arg(100);
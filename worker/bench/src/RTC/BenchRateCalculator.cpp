@@ -0,0 +1,45 @@
+#include "common.hpp"
+#include "RTC/RateCalculator.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace RTC;
+
+// With `state.range(0)` packets per millisecond.
+static void BM_RateCalculatorUpdate(benchmark::State& state)
+{
+	RateCalculator rate;
+	auto packetsPerMs = static_cast<size_t>(state.range(0));
+	uint64_t nowMs{ 1000000u };
+	size_t count{ 0u };
+
+	for (auto _ : state)
+	{
+		if (++count % packetsPerMs == 0u)
+			++nowMs;
+
+		rate.Update(1200u, nowMs);
+	}
+
+	benchmark::DoNotOptimize(rate.GetRate(nowMs));
+}
+BENCHMARK(BM_RateCalculatorUpdate)->Arg(1)->Arg(10);
+
+// Same as above but also getting the rate after every update.
+static void BM_RateCalculatorUpdateAndGetRate(benchmark::State& state)
+{
+	RateCalculator rate;
+	auto packetsPerMs = static_cast<size_t>(state.range(0));
+	uint64_t nowMs{ 1000000u };
+	size_t count{ 0u };
+
+	for (auto _ : state)
+	{
+		if (++count % packetsPerMs == 0u)
+			++nowMs;
+
+		rate.Update(1200u, nowMs);
+
+		benchmark::DoNotOptimize(rate.GetRate(nowMs));
+	}
+}
+BENCHMARK(BM_RateCalculatorUpdateAndGetRate)->Arg(1)->Arg(10);
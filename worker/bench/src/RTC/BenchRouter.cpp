@@ -0,0 +1,724 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "MediaSoupErrors.hpp"
+#include "helpers.hpp"
+#include "Utils.hpp"
+#include "Channel/ChannelNotifier.hpp"
+#include "Channel/ChannelRequest.hpp"
+#include "Channel/ChannelSocket.hpp"
+#include "PayloadChannel/Notification.hpp"
+#include "PayloadChannel/PayloadChannelNotifier.hpp"
+#include "PayloadChannel/PayloadChannelSocket.hpp"
+#include "RTC/Router.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RTCP/SenderReport.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm> // std::sort()
+#include <memory>
+#include <string>
+#include <vector>
+
+// End to end fan-out of synthetic media through the real Router, Transport,
+// Producer and Consumer code, without any Node process.
+//
+// Each Producer (an Opus stream plus a 3 spatial layers VP8 simulcast stream)
+// is fed through a DirectTransport and every subscriber consumes all of them
+// over a PlainTransport which sends to a loopback UDP sink (never read).
+//
+// Reported counters:
+// - fwd_pps: RTP packets sent by all the Consumers per second.
+// - cpu_ns_per_fwd: process CPU time per RTP packet sent by a Consumer. The
+//   number of Consumers a core can handle is 1e9 / (cpu_ns_per_fwd * pps),
+//   pps being the packet rate of a single Consumer.
+// - lat_p50_us, lat_p99_us, lat_p999_us: time taken to fan out an injected
+//   packet to all its Consumers.
+// - rss_mb: resident set size of the whole process once done.
+//
+// A subset of the sweep can be run with i.e.
+// `--benchmark_filter='RouterFanOut/producers:4/'`.
+
+namespace
+{
+	// Producer payload types and their mapped ones.
+	constexpr uint8_t OpusPayloadType{ 111u };
+	constexpr uint8_t MappedOpusPayloadType{ 100u };
+	constexpr uint8_t Vp8PayloadType{ 96u };
+	constexpr uint8_t MappedVp8PayloadType{ 101u };
+	constexpr uint8_t RtxPayloadType{ 97u };
+	constexpr uint8_t MappedRtxPayloadType{ 102u };
+
+	constexpr size_t NumSpatialLayers{ 3u };
+	constexpr size_t AudioPayloadLength{ 120u };
+	constexpr size_t VideoPayloadLength{ 1100u };
+	// Frames (a packet each) between keyframes in each video stream.
+	constexpr uint32_t KeyFrameInterval{ 300u };
+	// Interval between runs of the loop (timers, RTCP). Otherwise timers would
+	// use a stale loop time.
+	constexpr uint64_t LoopRunIntervalMs{ 20u };
+	// Interval between RTCP Sender Reports of the Producers (required to switch
+	// simulcast spatial layers).
+	constexpr uint64_t SenderReportsIntervalMs{ 1000u };
+	// Latency of the last injected packets used for percentiles.
+	constexpr size_t NumLatencySamples{ 65536u };
+
+	// Stream (0: audio, 1-3: video spatial layers) of each injected packet of a
+	// Producer, so spatial layers get 1:2:6 of the video packets.
+	constexpr size_t Schedule[]{ 0u, 1u, 2u, 2u, 3u, 3u, 3u, 3u, 3u, 3u };
+	constexpr size_t ScheduleLength{ sizeof(Schedule) / sizeof(Schedule[0]) };
+
+	// L1T3 temporal layer of each packet (a packet per frame).
+	constexpr uint8_t TemporalLayers[]{ 0u, 2u, 1u, 2u };
+
+	ChannelReadFreeFn ChannelRead(
+	  uint8_t** /*message*/,
+	  uint32_t* /*messageLen*/,
+	  size_t* /*messageCtx*/,
+	  const void* /*handle*/,
+	  ChannelReadCtx /*ctx*/)
+	{
+		return nullptr;
+	}
+
+	void ChannelWrite(const uint8_t* /*message*/, uint32_t /*messageLen*/, ChannelWriteCtx /*ctx*/)
+	{
+	}
+
+	PayloadChannelReadFreeFn PayloadChannelRead(
+	  uint8_t** /*message*/,
+	  uint32_t* /*messageLen*/,
+	  size_t* /*messageCtx*/,
+	  uint8_t** /*payload*/,
+	  uint32_t* /*payloadLen*/,
+	  size_t* /*payloadCapacity*/,
+	  const void* /*handle*/,
+	  PayloadChannelReadCtx /*ctx*/)
+	{
+		return nullptr;
+	}
+
+	void PayloadChannelWrite(
+	  const uint8_t* /*message*/,
+	  uint32_t /*messageLen*/,
+	  const uint8_t* /*payload*/,
+	  uint32_t /*payloadLen*/,
+	  ChannelWriteCtx /*ctx*/)
+	{
+	}
+
+	class BenchRouterListener : public RTC::Router::Listener
+	{
+	public:
+		RTC::WebRtcServer* OnRouterNeedWebRtcServer(
+		  RTC::Router* /*router*/, std::string& /*webRtcServerId*/) override
+		{
+			return nullptr;
+		}
+	};
+
+	uint32_t GetAudioSsrc(size_t producerIdx)
+	{
+		return 10000000u + static_cast<uint32_t>(producerIdx * 10u);
+	}
+
+	// The one of the lowest spatial layer, the next ones (and their RTX ones)
+	// are consecutive.
+	uint32_t GetVideoSsrc(size_t producerIdx)
+	{
+		return 20000000u + static_cast<uint32_t>(producerIdx * 10u);
+	}
+
+	json GetOpusCodec(uint8_t payloadType)
+	{
+		return { { "mimeType", "audio/opus" },
+			       { "payloadType", payloadType },
+			       { "clockRate", 48000 },
+			       { "channels", 2 } };
+	}
+
+	json GetVp8Codecs(uint8_t payloadType, uint8_t rtxPayloadType)
+	{
+		json rtcpFeedback{ { { "type", "nack" } },
+			                 { { "type", "nack" }, { "parameter", "pli" } },
+			                 { { "type", "ccm" }, { "parameter", "fir" } } };
+
+		return { { { "mimeType", "video/VP8" },
+			         { "payloadType", payloadType },
+			         { "clockRate", 90000 },
+			         { "rtcpFeedback", rtcpFeedback } },
+			       { { "mimeType", "video/rtx" },
+			         { "payloadType", rtxPayloadType },
+			         { "clockRate", 90000 },
+			         { "parameters", { { "apt", payloadType } } } } };
+	}
+
+	// A RTP stream sent by a Producer.
+	class Stream
+	{
+	public:
+		Stream(uint8_t payloadType, uint32_t ssrc, bool isVideo) : ssrc(ssrc), isVideo(isVideo)
+		{
+			uint8_t descriptor[7]{ 0u };
+
+			this->size = helpers::writeRtpPacket(
+			  this->buffer,
+			  payloadType,
+			  0u,
+			  0u,
+			  ssrc,
+			  descriptor,
+			  sizeof(descriptor),
+			  isVideo ? VideoPayloadLength : AudioPayloadLength);
+		}
+
+	public:
+		void AddSenderReport(
+		  RTC::RTCP::SenderReportPacket& packet, const Utils::Time::Ntp& ntp) const
+		{
+			auto* report = new RTC::RTCP::SenderReport();
+
+			report->SetSsrc(this->ssrc);
+			report->SetNtpSec(ntp.seconds);
+			report->SetNtpFrac(ntp.fractions);
+			report->SetRtpTs(this->timestamp);
+			report->SetPacketCount(this->seq);
+			report->SetOctetCount(this->seq * static_cast<uint32_t>(this->size));
+
+			packet.AddReport(report);
+		}
+
+		// Updates the packet in the buffer to be the next one.
+		void Next()
+		{
+			Utils::Byte::Set2Bytes(this->buffer, 2, ++this->seq);
+
+			if (!this->isVideo)
+			{
+				this->timestamp += 960u;
+				Utils::Byte::Set4Bytes(this->buffer, 4, this->timestamp);
+
+				return;
+			}
+
+			this->timestamp += 3000u;
+			Utils::Byte::Set4Bytes(this->buffer, 4, this->timestamp);
+
+			auto num       = ++this->frame;
+			auto* data     = this->buffer + helpers::RtpHeaderLength;
+			auto pictureId = static_cast<uint16_t>(num & 0x7FFFu);
+
+			// Marker bit, a packet per frame.
+			this->buffer[1] |= 0x80;
+			// X:1, S:1.
+			data[0] = 0x90;
+			// I:1, L:1, T:1.
+			data[1] = 0xE0;
+			// M:1 and pictureId.
+			data[2] = 0x80 | static_cast<uint8_t>(pictureId >> 8);
+			data[3] = static_cast<uint8_t>(pictureId);
+			// TL0PICIDX.
+			data[4] = static_cast<uint8_t>(num / 4u);
+			// TID and Y:1.
+			data[5] = static_cast<uint8_t>(TemporalLayers[num % 4u] << 6) | 0x20;
+			// VP8 payload header, P:0 means keyframe.
+			data[6] = (num % KeyFrameInterval == 0u) ? 0x00 : 0x01;
+		}
+
+	public:
+		uint8_t buffer[RTC::MtuSize + 100];
+		size_t size{ 0u };
+
+	private:
+		uint32_t ssrc{ 0u };
+		bool isVideo{ false };
+		uint16_t seq{ 0u };
+		uint32_t timestamp{ 0u };
+		// Starts with a keyframe.
+		uint32_t frame{ KeyFrameInterval - 1u };
+	};
+
+	class FanOut
+	{
+	public:
+		FanOut(size_t numProducers, size_t numSubscribers)
+		{
+			// Notifications (scores, layers changes, RTCP to the DirectTransport) are
+			// dropped.
+			this->channel.reset(new Channel::ChannelSocket(ChannelRead, nullptr, ChannelWrite, nullptr));
+			this->payloadChannel.reset(new PayloadChannel::PayloadChannelSocket(
+			  PayloadChannelRead, nullptr, PayloadChannelWrite, nullptr));
+
+			Channel::ChannelNotifier::ClassInit(this->channel.get());
+			PayloadChannel::PayloadChannelNotifier::ClassInit(this->payloadChannel.get());
+
+			this->router.reset(new RTC::Router("router", std::addressof(this->routerListener)));
+
+			CreateSink();
+
+			try
+			{
+				CreateEntities(numProducers, numSubscribers);
+			}
+			catch (const MediaSoupError& error)
+			{
+				this->router.reset();
+
+				CloseSink();
+
+				throw;
+			}
+
+			json notification = { { "event", "producer.send" },
+				                    { "internal", { { "transportId", "direct" } } } };
+
+			this->notification.reset(new PayloadChannel::Notification(notification));
+
+			notification["event"] = "transport.sendRtcp";
+
+			this->rtcpNotification.reset(new PayloadChannel::Notification(notification));
+
+			RunLoop();
+		}
+
+		~FanOut()
+		{
+			// Closes all the transports and entities within.
+			this->router.reset();
+
+			this->channel->Close();
+			this->payloadChannel->Close();
+
+			CloseSink();
+		}
+
+	public:
+		// Injects the next packet of the given Producer and returns the time it
+		// took to route it (in nanoseconds).
+		uint64_t Inject(size_t producerIdx, size_t slot)
+		{
+			auto& stream = *this->producerStreams[producerIdx][Schedule[slot % ScheduleLength]];
+
+			stream.Next();
+
+			this->notification->SetPayload(stream.buffer, stream.size);
+
+			auto startNs = DepLibUV::GetTimeNs();
+
+			this->router->HandleNotification(this->notification.get());
+
+			return DepLibUV::GetTimeNs() - startNs;
+		}
+
+		// Runs the loop and sends Sender Reports when due, as a real worker and
+		// real endpoints would do.
+		void Tick()
+		{
+			auto nowMs = DepLibUV::GetTimeMs();
+
+			if (nowMs - this->lastLoopRunMs < LoopRunIntervalMs)
+				return;
+
+			if (nowMs - this->lastSenderReportsMs >= SenderReportsIntervalMs)
+				SendSenderReports();
+
+			RunLoop();
+		}
+
+		// A Sender Report for each stream of every Producer.
+		void SendSenderReports()
+		{
+			auto nowMs = DepLibUV::GetTimeMs();
+			auto ntp   = Utils::Time::TimeMs2Ntp(nowMs);
+
+			this->lastSenderReportsMs = nowMs;
+
+			for (const auto& streams : this->producerStreams)
+			{
+				for (const auto& stream : streams)
+				{
+					RTC::RTCP::SenderReportPacket packet;
+
+					stream->AddSenderReport(packet, ntp);
+
+					auto size = packet.Serialize(this->rtcpBuffer);
+
+					this->rtcpNotification->SetPayload(this->rtcpBuffer, size);
+					this->router->HandleNotification(this->rtcpNotification.get());
+				}
+			}
+		}
+
+		// RTP packets sent so far by all the Consumers.
+		uint64_t GetSentPackets()
+		{
+			uint64_t sentPackets{ 0u };
+
+			for (const auto& consumer : this->consumers)
+			{
+				auto response = Request(
+				  "consumer.getStats",
+				  { { "transportId", consumer.first }, { "consumerId", consumer.second } },
+				  json::object());
+
+				for (const auto& stats : response["data"])
+				{
+					if (stats["type"] == "outbound-rtp")
+						sentPackets += stats["packetCount"].get<uint64_t>();
+				}
+			}
+
+			return sentPackets;
+		}
+
+	private:
+		json Request(const char* method, json internal, json data)
+		{
+			json jsonRequest{ { "id", ++this->requestId },
+				                { "method", method },
+				                { "internal", internal },
+				                { "data", data } };
+			Channel::ChannelRequest request(nullptr, jsonRequest);
+
+			// This may throw.
+			this->router->HandleRequest(std::addressof(request));
+
+			if (request.response.find("error") != request.response.end())
+			{
+				auto error = std::string(method) + " failed: " + request.response.dump();
+
+				throw MediaSoupError(error.c_str());
+			}
+
+			return request.response;
+		}
+
+		void CreateSink()
+		{
+			int err;
+			struct sockaddr_storage addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+			int len = sizeof(addr);
+
+			uv_ip4_addr("127.0.0.1", 0, reinterpret_cast<struct sockaddr_in*>(std::addressof(addr)));
+
+			err = uv_udp_init(DepLibUV::GetLoop(), std::addressof(this->sink));
+
+			if (err != 0)
+				throw MediaSoupError(uv_strerror(err));
+
+			err = uv_udp_bind(
+			  std::addressof(this->sink), reinterpret_cast<struct sockaddr*>(std::addressof(addr)), 0);
+
+			if (err == 0)
+			{
+				err = uv_udp_getsockname(
+				  std::addressof(this->sink),
+				  reinterpret_cast<struct sockaddr*>(std::addressof(addr)),
+				  std::addressof(len));
+			}
+
+			if (err != 0)
+			{
+				uv_close(reinterpret_cast<uv_handle_t*>(std::addressof(this->sink)), nullptr);
+
+				throw MediaSoupError(uv_strerror(err));
+			}
+
+			this->sinkPort =
+			  ntohs(reinterpret_cast<struct sockaddr_in*>(std::addressof(addr))->sin_port);
+		}
+
+		void RunLoop()
+		{
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+			this->lastLoopRunMs = DepLibUV::GetTimeMs();
+		}
+
+		void CloseSink()
+		{
+			uv_close(reinterpret_cast<uv_handle_t*>(std::addressof(this->sink)), nullptr);
+
+			// Let the loop release it.
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		}
+
+		void CreateEntities(size_t numProducers, size_t numSubscribers)
+		{
+			Request(
+			  "router.createDirectTransport",
+			  { { "transportId", "direct" } },
+			  { { "direct", true }, { "maxMessageSize", 262144 } });
+
+			for (size_t p{ 0u }; p < numProducers; ++p)
+			{
+				CreateProducer(p);
+			}
+
+			for (size_t s{ 0u }; s < numSubscribers; ++s)
+			{
+				auto transportId = "plain-" + std::to_string(s);
+
+				Request(
+				  "router.createPlainTransport",
+				  { { "transportId", transportId } },
+				  { { "listenIp", { { "ip", "127.0.0.1" } } },
+				    { "rtcpMux", true },
+				    { "comedia", false } });
+
+				Request(
+				  "transport.connect",
+				  { { "transportId", transportId } },
+				  { { "ip", "127.0.0.1" }, { "port", this->sinkPort } });
+
+				for (size_t p{ 0u }; p < numProducers; ++p)
+				{
+					CreateConsumers(transportId, p);
+				}
+			}
+		}
+
+		void CreateProducer(size_t p)
+		{
+			auto audioSsrc = GetAudioSsrc(p);
+			auto videoSsrc = GetVideoSsrc(p);
+			json encodings = json::array();
+			json mapping   = json::array();
+			json headerExtensions{
+				{ { "uri", "urn:ietf:params:rtp-hdrext:sdes:mid" }, { "id", helpers::MidExtensionId } },
+				{ { "uri", "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time" },
+				  { "id", helpers::AbsSendTimeExtensionId } }
+			};
+			json audioRtpParameters{ { "codecs", { GetOpusCodec(OpusPayloadType) } },
+				                       { "encodings", { { { "ssrc", audioSsrc } } } },
+				                       { "headerExtensions", headerExtensions } };
+			json audioRtpMapping{
+				{ "codecs",
+				  { { { "payloadType", OpusPayloadType },
+				      { "mappedPayloadType", MappedOpusPayloadType } } } },
+				{ "encodings", { { { "ssrc", audioSsrc }, { "mappedSsrc", audioSsrc } } } }
+			};
+
+			Request(
+			  "transport.produce",
+			  { { "transportId", "direct" }, { "producerId", "audio-" + std::to_string(p) } },
+			  { { "kind", "audio" },
+			    { "rtpParameters", audioRtpParameters },
+			    { "rtpMapping", audioRtpMapping },
+			    { "paused", false } });
+
+			for (uint32_t layer{ 0u }; layer < NumSpatialLayers; ++layer)
+			{
+				auto ssrc = videoSsrc + (layer * 2u);
+
+				encodings.push_back({ { "ssrc", ssrc },
+				                      { "rtx", { { "ssrc", ssrc + 1u } } },
+				                      { "scalabilityMode", "L1T3" } });
+				mapping.push_back(
+				  { { "ssrc", ssrc }, { "mappedSsrc", ssrc }, { "scalabilityMode", "L1T3" } });
+			}
+
+			json videoRtpParameters{
+				{ "codecs", GetVp8Codecs(Vp8PayloadType, RtxPayloadType) },
+				{ "encodings", encodings },
+				{ "headerExtensions", headerExtensions }
+			};
+			json videoRtpMapping{
+				{ "codecs",
+				  { { { "payloadType", Vp8PayloadType }, { "mappedPayloadType", MappedVp8PayloadType } },
+				    { { "payloadType", RtxPayloadType },
+				      { "mappedPayloadType", MappedRtxPayloadType } } } },
+				{ "encodings", mapping }
+			};
+
+			Request(
+			  "transport.produce",
+			  { { "transportId", "direct" }, { "producerId", "video-" + std::to_string(p) } },
+			  { { "kind", "video" },
+			    { "rtpParameters", videoRtpParameters },
+			    { "rtpMapping", videoRtpMapping },
+			    { "keyFrameRequestDelay", 0 },
+			    { "paused", false } });
+
+			this->producerStreams.emplace_back();
+
+			auto& streams = this->producerStreams.back();
+
+			streams.emplace_back(new Stream(OpusPayloadType, audioSsrc, false));
+
+			for (uint32_t layer{ 0u }; layer < NumSpatialLayers; ++layer)
+			{
+				streams.emplace_back(new Stream(Vp8PayloadType, videoSsrc + (layer * 2u), true));
+			}
+		}
+
+		void CreateConsumers(const std::string& transportId, size_t p)
+		{
+			auto audioId      = transportId + "-audio-" + std::to_string(p);
+			auto videoId      = transportId + "-video-" + std::to_string(p);
+			auto consumerSsrc = 30000000u + static_cast<uint32_t>(this->consumers.size() * 2u);
+			json consumableEncodings = json::array();
+			json headerExtensions{
+				{ { "uri", "urn:ietf:params:rtp-hdrext:sdes:mid" }, { "id", 1 } },
+				{ { "uri", "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time" }, { "id", 4 } }
+			};
+			json rtcp{ { "cname", transportId }, { "reducedSize", true }, { "mux", true } };
+			json audioRtpParameters{ { "codecs", { GetOpusCodec(MappedOpusPayloadType) } },
+				                       { "encodings", { { { "ssrc", consumerSsrc } } } },
+				                       { "headerExtensions", headerExtensions },
+				                       { "rtcp", rtcp } };
+
+			Request(
+			  "transport.consume",
+			  { { "transportId", transportId }, { "consumerId", audioId } },
+			  { { "producerId", "audio-" + std::to_string(p) },
+			    { "kind", "audio" },
+			    { "type", "simple" },
+			    { "rtpParameters", audioRtpParameters },
+			    { "consumableRtpEncodings", { { { "ssrc", GetAudioSsrc(p) } } } },
+			    { "paused", false } });
+
+			this->consumers.emplace_back(transportId, audioId);
+
+			for (uint32_t layer{ 0u }; layer < NumSpatialLayers; ++layer)
+			{
+				consumableEncodings.push_back(
+				  { { "ssrc", GetVideoSsrc(p) + (layer * 2u) }, { "scalabilityMode", "L1T3" } });
+			}
+
+			json videoRtpParameters{
+				{ "codecs", GetVp8Codecs(MappedVp8PayloadType, MappedRtxPayloadType) },
+				{ "encodings",
+				  { { { "ssrc", consumerSsrc + 1u },
+				      { "rtx", { { "ssrc", consumerSsrc + 1000000u } } },
+				      { "scalabilityMode", "S3T3" } } } },
+				{ "headerExtensions", headerExtensions },
+				{ "rtcp", rtcp }
+			};
+
+			Request(
+			  "transport.consume",
+			  { { "transportId", transportId }, { "consumerId", videoId } },
+			  { { "producerId", "video-" + std::to_string(p) },
+			    { "kind", "video" },
+			    { "type", "simulcast" },
+			    { "rtpParameters", videoRtpParameters },
+			    { "consumableRtpEncodings", consumableEncodings },
+			    { "paused", false } });
+
+			this->consumers.emplace_back(transportId, videoId);
+		}
+
+	private:
+		std::unique_ptr<Channel::ChannelSocket> channel;
+		std::unique_ptr<PayloadChannel::PayloadChannelSocket> payloadChannel;
+		BenchRouterListener routerListener;
+		std::unique_ptr<RTC::Router> router;
+		std::unique_ptr<PayloadChannel::Notification> notification;
+		std::unique_ptr<PayloadChannel::Notification> rtcpNotification;
+		uint8_t rtcpBuffer[RTC::MtuSize];
+		uv_udp_t sink;
+		uint16_t sinkPort{ 0u };
+		uint32_t requestId{ 0u };
+		uint64_t lastLoopRunMs{ 0u };
+		uint64_t lastSenderReportsMs{ 0u };
+		// Pairs of transportId and consumerId.
+		std::vector<std::pair<std::string, std::string>> consumers;
+		std::vector<std::vector<std::unique_ptr<Stream>>> producerStreams;
+	};
+
+	uint64_t GetCpuTimeNs()
+	{
+		uv_rusage_t usage;
+
+		if (uv_getrusage(std::addressof(usage)) != 0)
+			return 0u;
+
+		auto toNs = [](const uv_timeval_t& tv) {
+			return (static_cast<uint64_t>(tv.tv_sec) * 1000000000u) +
+			       (static_cast<uint64_t>(tv.tv_usec) * 1000u);
+		};
+
+		return toNs(usage.ru_utime) + toNs(usage.ru_stime);
+	}
+} // namespace
+
+// With `state.range(0)` Producers consumed by `state.range(1)` subscribers, each
+// iteration injecting a packet of a Producer.
+static void BM_RouterFanOut(benchmark::State& state)
+{
+	auto numProducers   = static_cast<size_t>(state.range(0));
+	auto numSubscribers = static_cast<size_t>(state.range(1));
+	std::unique_ptr<FanOut> fanOut;
+
+	try
+	{
+		fanOut.reset(new FanOut(numProducers, numSubscribers));
+	}
+	catch (const MediaSoupError& error)
+	{
+		state.SkipWithError(error.what());
+
+		return;
+	}
+
+	// Warm up so every Consumer gets its streams and switches to the highest
+	// spatial layer (which requires Sender Reports and a keyframe in it).
+	for (size_t i{ 0u }; i < numProducers * ScheduleLength; ++i)
+	{
+		fanOut->Inject(i % numProducers, i / numProducers);
+	}
+
+	fanOut->SendSenderReports();
+
+	for (size_t i{ 0u }; i < numProducers * KeyFrameInterval * 2u; ++i)
+	{
+		fanOut->Inject(i % numProducers, (i / numProducers) % ScheduleLength);
+		fanOut->Tick();
+	}
+
+	std::vector<uint64_t> latencies(NumLatencySamples, 0u);
+	auto sentPackets = fanOut->GetSentPackets();
+	auto cpuTimeNs   = GetCpuTimeNs();
+	uint64_t num{ 0u };
+
+	for (auto _ : state)
+	{
+		latencies[num % NumLatencySamples] =
+		  fanOut->Inject(num % numProducers, (num / numProducers) % ScheduleLength);
+
+		fanOut->Tick();
+
+		++num;
+	}
+
+	cpuTimeNs   = GetCpuTimeNs() - cpuTimeNs;
+	sentPackets = fanOut->GetSentPackets() - sentPackets;
+
+	latencies.resize(std::min<size_t>(num, NumLatencySamples));
+	std::sort(latencies.begin(), latencies.end());
+
+	auto percentileUs = [&latencies](double percentile) {
+		if (latencies.empty())
+			return 0.0;
+
+		return static_cast<double>(latencies[static_cast<size_t>(
+		         percentile * static_cast<double>(latencies.size() - 1u))]) /
+		       1000.0;
+	};
+
+	size_t rss{ 0u };
+
+	uv_resident_set_memory(std::addressof(rss));
+
+	state.SetItemsProcessed(static_cast<int64_t>(num));
+	state.counters["fwd_pps"] =
+	  benchmark::Counter(static_cast<double>(sentPackets), benchmark::Counter::kIsRate);
+	state.counters["cpu_ns_per_fwd"] =
+	  sentPackets > 0u ? static_cast<double>(cpuTimeNs) / static_cast<double>(sentPackets) : 0.0;
+	state.counters["lat_p50_us"]  = percentileUs(0.5);
+	state.counters["lat_p99_us"]  = percentileUs(0.99);
+	state.counters["lat_p999_us"] = percentileUs(0.999);
+	state.counters["rss_mb"]      = static_cast<double>(rss) / (1024.0 * 1024.0);
+}
+BENCHMARK(BM_RouterFanOut)
+  ->ArgNames({ "producers", "subscribers" })
+  ->ArgsProduct({ { 1, 4, 16 }, { 1, 10, 50, 200 } });
@@ -0,0 +1,85 @@
+#include "common.hpp"
+#include "helpers.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace RTC;
+
+static constexpr uint8_t PayloadType{ 96u };
+static constexpr uint32_t Ssrc{ 1234u };
+static constexpr size_t PayloadLength{ 1100u };
+
+static void BM_RtpPacketParse(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	uint8_t descriptor[] = { 0x90, 0x80, 0x11, 0x00 };
+	auto size            = helpers::writeRtpPacket(
+	  buffer, PayloadType, 1u, 1000u, Ssrc, descriptor, sizeof(descriptor), PayloadLength);
+
+	for (auto _ : state)
+	{
+		auto* packet = RtpPacket::Parse(buffer, size);
+
+		benchmark::DoNotOptimize(packet);
+
+		delete packet;
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+BENCHMARK(BM_RtpPacketParse);
+
+static void BM_RtpPacketClone(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	uint8_t cloneBuffer[RTC::MtuSize + 100];
+	uint8_t descriptor[] = { 0x90, 0x80, 0x11, 0x00 };
+	auto size            = helpers::writeRtpPacket(
+	  buffer, PayloadType, 1u, 1000u, Ssrc, descriptor, sizeof(descriptor), PayloadLength);
+	auto* packet = RtpPacket::Parse(buffer, size);
+
+	for (auto _ : state)
+	{
+		auto* clonedPacket = packet->Clone(cloneBuffer);
+
+		benchmark::DoNotOptimize(clonedPacket);
+
+		delete clonedPacket;
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+
+	delete packet;
+}
+BENCHMARK(BM_RtpPacketClone);
+
+// As done by Consumers when mangling the header extensions of every packet.
+static void BM_RtpPacketSetExtensions(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	uint8_t descriptor[] = { 0x90, 0x80, 0x11, 0x00 };
+	auto size            = helpers::writeRtpPacket(
+	  buffer, PayloadType, 1u, 1000u, Ssrc, descriptor, sizeof(descriptor), PayloadLength);
+	auto* packet = RtpPacket::Parse(buffer, size);
+	uint8_t midValue[]{ '1' };
+	uint8_t absSendTimeValue[]{ 0x12, 0x34, 0x56 };
+	uint8_t transportWideCc01Value[]{ 0x00, 0x02 };
+	std::vector<RtpPacket::GenericExtension> extensions;
+
+	extensions.emplace_back(helpers::MidExtensionId, sizeof(midValue), midValue);
+	extensions.emplace_back(
+	  helpers::AbsSendTimeExtensionId, sizeof(absSendTimeValue), absSendTimeValue);
+	extensions.emplace_back(
+	  helpers::TransportWideCc01ExtensionId, sizeof(transportWideCc01Value), transportWideCc01Value);
+
+	for (auto _ : state)
+	{
+		packet->SetExtensions(1, extensions);
+
+		benchmark::ClobberMemory();
+	}
+
+	delete packet;
+}
+BENCHMARK(BM_RtpPacketSetExtensions);
@@ -0,0 +1,43 @@
+#include "common.hpp"
+#include "RTC/SeqManager.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace RTC;
+
+static void BM_SeqManagerInput(benchmark::State& state)
+{
+	SeqManager<uint16_t> seqManager;
+	uint16_t seq{ 0u };
+	uint16_t output;
+
+	for (auto _ : state)
+	{
+		seqManager.Input(seq++, output);
+
+		benchmark::DoNotOptimize(output);
+	}
+}
+BENCHMARK(BM_SeqManagerInput);
+
+// As done by Consumers dropping packets of non forwarded temporal layers, with
+// one out of `state.range(0)` packets being dropped.
+static void BM_SeqManagerInputWithDrops(benchmark::State& state)
+{
+	SeqManager<uint16_t> seqManager;
+	auto dropEvery = static_cast<uint16_t>(state.range(0));
+	uint16_t seq{ 0u };
+	uint16_t output;
+
+	for (auto _ : state)
+	{
+		if (seq % dropEvery == 0u)
+			seqManager.Drop(seq);
+		else
+			seqManager.Input(seq, output);
+
+		++seq;
+
+		benchmark::DoNotOptimize(output);
+	}
+}
+BENCHMARK(BM_SeqManagerInputWithDrops)->Arg(2)->Arg(4)->Arg(100);
@@ -0,0 +1,137 @@
+#include "common.hpp"
+#include "helpers.hpp"
+#include "Utils.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/SrtpSession.hpp"
+#include <benchmark/benchmark.h>
+#include <cstring> // std::memcpy(), std::memset()
+#include <memory>
+#include <vector>
+
+using namespace RTC;
+
+// Encrypted packets decrypted by the same inbound session (they cannot be
+// decrypted twice due to replay protection).
+static constexpr size_t NumEncryptedPackets{ 1024u };
+
+static size_t GetKeyLength(SrtpSession::CryptoSuite cryptoSuite)
+{
+	switch (cryptoSuite)
+	{
+		case SrtpSession::CryptoSuite::AEAD_AES_256_GCM:
+			return 44u;
+		case SrtpSession::CryptoSuite::AEAD_AES_128_GCM:
+			return 28u;
+		default:
+			return 30u;
+	}
+}
+
+// With the `state.range(0)` crypto suite.
+static void BM_SrtpSessionEncryptRtp(benchmark::State& state)
+{
+	auto cryptoSuite = static_cast<SrtpSession::CryptoSuite>(state.range(0));
+	uint8_t key[44];
+	uint8_t buffer[RTC::MtuSize + 100];
+	uint8_t descriptor[] = { 0x90, 0x80, 0x11, 0x00 };
+	auto size            = helpers::writeRtpPacket(
+	  buffer, 96u, 0u, 1000u, 1234u, descriptor, sizeof(descriptor), 1100u);
+	uint16_t seq{ 0u };
+
+	std::memset(key, 0xAA, sizeof(key));
+
+	SrtpSession session(SrtpSession::Type::OUTBOUND, cryptoSuite, key, GetKeyLength(cryptoSuite));
+
+	for (auto _ : state)
+	{
+		// Packets cannot be encrypted twice with the same sequence number.
+		Utils::Byte::Set2Bytes(buffer, 2, seq++);
+
+		const uint8_t* data = buffer;
+		auto len            = static_cast<int>(size);
+
+		if (!session.EncryptRtp(std::addressof(data), std::addressof(len)))
+		{
+			state.SkipWithError("EncryptRtp() failed");
+
+			break;
+		}
+
+		benchmark::DoNotOptimize(data);
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+BENCHMARK(BM_SrtpSessionEncryptRtp)
+  ->Arg(static_cast<int64_t>(SrtpSession::CryptoSuite::AEAD_AES_256_GCM))
+  ->Arg(static_cast<int64_t>(SrtpSession::CryptoSuite::AEAD_AES_128_GCM))
+  ->Arg(static_cast<int64_t>(SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_80));
+
+// With the `state.range(0)` crypto suite. It includes copying every encrypted
+// packet before decrypting it in place.
+static void BM_SrtpSessionDecryptSrtp(benchmark::State& state)
+{
+	auto cryptoSuite = static_cast<SrtpSession::CryptoSuite>(state.range(0));
+	auto keyLength   = GetKeyLength(cryptoSuite);
+	uint8_t key[44];
+	uint8_t buffer[RTC::MtuSize + 100];
+	uint8_t descriptor[] = { 0x90, 0x80, 0x11, 0x00 };
+	auto size            = helpers::writeRtpPacket(
+	  buffer, 96u, 0u, 1000u, 1234u, descriptor, sizeof(descriptor), 1100u);
+	std::vector<std::vector<uint8_t>> encryptedPackets;
+
+	std::memset(key, 0xAA, sizeof(key));
+
+	SrtpSession outboundSession(SrtpSession::Type::OUTBOUND, cryptoSuite, key, keyLength);
+
+	for (uint16_t seq{ 0u }; seq < NumEncryptedPackets; ++seq)
+	{
+		Utils::Byte::Set2Bytes(buffer, 2, seq);
+
+		const uint8_t* data = buffer;
+		auto len            = static_cast<int>(size);
+
+		if (!outboundSession.EncryptRtp(std::addressof(data), std::addressof(len)))
+		{
+			state.SkipWithError("EncryptRtp() failed");
+
+			return;
+		}
+
+		encryptedPackets.emplace_back(data, data + len);
+	}
+
+	std::unique_ptr<SrtpSession> inboundSession;
+	size_t idx{ 0u };
+
+	for (auto _ : state)
+	{
+		if (idx == 0u)
+		{
+			state.PauseTiming();
+			inboundSession.reset(
+			  new SrtpSession(SrtpSession::Type::INBOUND, cryptoSuite, key, keyLength));
+			state.ResumeTiming();
+		}
+
+		const auto& encryptedPacket = encryptedPackets[idx];
+		auto len                    = static_cast<int>(encryptedPacket.size());
+
+		std::memcpy(buffer, encryptedPacket.data(), encryptedPacket.size());
+
+		if (!inboundSession->DecryptSrtp(buffer, std::addressof(len)))
+		{
+			state.SkipWithError("DecryptSrtp() failed");
+
+			break;
+		}
+
+		idx = (idx + 1u) % NumEncryptedPackets;
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+BENCHMARK(BM_SrtpSessionDecryptSrtp)
+  ->Arg(static_cast<int64_t>(SrtpSession::CryptoSuite::AEAD_AES_256_GCM))
+  ->Arg(static_cast<int64_t>(SrtpSession::CryptoSuite::AEAD_AES_128_GCM))
+  ->Arg(static_cast<int64_t>(SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_80));
@@ -0,0 +1,87 @@
+#include "common.hpp"
+#include "Utils.hpp"
+#include "RTC/StunPacket.hpp"
+#include <benchmark/benchmark.h>
+#include <cstring> // std::memset()
+#include <string>
+
+using namespace RTC;
+
+// Sample request from RFC 5769 (section 2.1).
+// - USERNAME: "evtj:h6vY"
+// - password: "VOkJxbRl1RmTxUk/WvJxBt"
+// clang-format off
+static uint8_t StunBuffer[] =
+{
+	0x00, 0x01, 0x00, 0x58,
+	0x21, 0x12, 0xa4, 0x42,
+	0xb7, 0xe7, 0xa7, 0x01,
+	0xbc, 0x34, 0xd6, 0x86,
+	0xfa, 0x87, 0xdf, 0xae,
+	0x80, 0x22, 0x00, 0x10, // SOFTWARE.
+	0x53, 0x54, 0x55, 0x4e,
+	0x20, 0x74, 0x65, 0x73,
+	0x74, 0x20, 0x63, 0x6c,
+	0x69, 0x65, 0x6e, 0x74,
+	0x00, 0x24, 0x00, 0x04, // PRIORITY.
+	0x6e, 0x00, 0x01, 0xff,
+	0x80, 0x29, 0x00, 0x08, // ICE-CONTROLLED.
+	0x93, 0x2f, 0xf9, 0xb1,
+	0x51, 0x26, 0x3b, 0x36,
+	0x00, 0x06, 0x00, 0x09, // USERNAME.
+	0x65, 0x76, 0x74, 0x6a,
+	0x3a, 0x68, 0x36, 0x76,
+	0x59, 0x20, 0x20, 0x20,
+	0x00, 0x08, 0x00, 0x14, // MESSAGE-INTEGRITY.
+	0x9a, 0xea, 0xa7, 0x0c,
+	0xbf, 0xd8, 0xcb, 0x56,
+	0x78, 0x1e, 0xf2, 0xb5,
+	0xb2, 0xd3, 0xf2, 0x49,
+	0xc1, 0xb5, 0x71, 0xa2,
+	0x80, 0x28, 0x00, 0x04, // FINGERPRINT.
+	0xe5, 0x7a, 0x3b, 0xcf
+};
+// clang-format on
+
+static void BM_StunPacketParse(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		StunPacket packet;
+
+		benchmark::DoNotOptimize(StunPacket::Parse(StunBuffer, sizeof(StunBuffer), packet));
+	}
+}
+BENCHMARK(BM_StunPacketParse);
+
+// Same processing as IceServer does for each received Binding request.
+static void BM_StunPacketBindingRequest(benchmark::State& state)
+{
+	std::string localUsername("evtj");
+	Utils::Crypto::HmacSha1 hmacSha1;
+	uint8_t responseBuffer[1500];
+
+	hmacSha1.SetKey("VOkJxbRl1RmTxUk/WvJxBt");
+
+	struct sockaddr_in addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	std::memset(std::addressof(addr), 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+
+	for (auto _ : state)
+	{
+		StunPacket packet;
+
+		StunPacket::Parse(StunBuffer, sizeof(StunBuffer), packet);
+		packet.CheckAuthentication(localUsername, std::addressof(hmacSha1));
+
+		auto response = packet.CreateSuccessResponse();
+
+		response.SetXorMappedAddress(reinterpret_cast<const struct sockaddr*>(std::addressof(addr)));
+		response.Authenticate(std::addressof(hmacSha1));
+		response.Serialize(responseBuffer);
+
+		benchmark::DoNotOptimize(responseBuffer);
+	}
+}
+BENCHMARK(BM_StunPacketBindingRequest);
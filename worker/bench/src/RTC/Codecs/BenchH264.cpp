@@ -0,0 +1,83 @@
+#include "common.hpp"
+#include "helpers.hpp"
+#include "RTC/Codecs/H264.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace RTC;
+
+// Packets per frame, each one carrying a FU-A fragment of a non IDR slice.
+static constexpr uint32_t PacketsPerFrame{ 4u };
+
+// Writes the FU-A indicator and header of the given packet number.
+static void WritePayloadDescriptor(uint8_t* data, uint32_t num)
+{
+	// NRI:3, type:28 (FU-A).
+	data[0] = 0x7C;
+	// Type:1 (non IDR slice).
+	data[1] = 0x01;
+
+	// Start and end bits.
+	if (num % PacketsPerFrame == 0u)
+		data[1] |= 0x80;
+	else if (num % PacketsPerFrame == PacketsPerFrame - 1u)
+		data[1] |= 0x40;
+}
+
+static RtpPacket* CreatePacket(uint8_t* buffer)
+{
+	uint8_t descriptor[2];
+
+	WritePayloadDescriptor(descriptor, 0u);
+
+	auto size = helpers::writeRtpPacket(
+	  buffer, 96u, 0u, 1000u, 1234u, descriptor, sizeof(descriptor), 1100u);
+
+	return RtpPacket::Parse(buffer, size);
+}
+
+// As done by Producers for every received packet.
+static void BM_H264ProcessRtpPacket(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	auto* packet = CreatePacket(buffer);
+	uint32_t num{ 0u };
+
+	for (auto _ : state)
+	{
+		WritePayloadDescriptor(packet->GetPayload(), num++);
+
+		Codecs::H264::ProcessRtpPacket(packet);
+	}
+
+	delete packet;
+}
+BENCHMARK(BM_H264ProcessRtpPacket);
+
+// Same as above plus the payload descriptor processing done by a Consumer.
+static void BM_H264ProcessRtpPacketAndPayload(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	auto* packet = CreatePacket(buffer);
+	Codecs::EncodingContext::Params params;
+	Codecs::H264::EncodingContext context(params);
+	uint32_t num{ 0u };
+
+	context.SetTargetTemporalLayer(0);
+	context.SetCurrentTemporalLayer(0);
+
+	for (auto _ : state)
+	{
+		WritePayloadDescriptor(packet->GetPayload(), num++);
+
+		Codecs::H264::ProcessRtpPacket(packet);
+
+		bool marker{ false };
+
+		if (packet->ProcessPayload(std::addressof(context), marker))
+			packet->RestorePayload();
+	}
+
+	delete packet;
+}
+BENCHMARK(BM_H264ProcessRtpPacketAndPayload);
@@ -0,0 +1,91 @@
+#include "common.hpp"
+#include "helpers.hpp"
+#include "RTC/Codecs/VP8.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace RTC;
+
+// L1T3 temporal layer of each packet (a packet per frame).
+static constexpr uint8_t TemporalLayers[]{ 0u, 2u, 1u, 2u };
+
+// Writes the payload descriptor (with two bytes pictureId, TL0PICIDX and TID)
+// of the given packet number.
+static void WritePayloadDescriptor(uint8_t* data, uint32_t num)
+{
+	auto pictureId = static_cast<uint16_t>(num & 0x7FFFu);
+
+	// X:1, S:1.
+	data[0] = 0x90;
+	// I:1, L:1, T:1.
+	data[1] = 0xE0;
+	// M:1 and pictureId.
+	data[2] = 0x80 | static_cast<uint8_t>(pictureId >> 8);
+	data[3] = static_cast<uint8_t>(pictureId);
+	// TL0PICIDX.
+	data[4] = static_cast<uint8_t>(num / 4u);
+	// TID and Y:1.
+	data[5] = static_cast<uint8_t>(TemporalLayers[num % 4u] << 6) | 0x20;
+}
+
+static RtpPacket* CreatePacket(uint8_t* buffer)
+{
+	uint8_t descriptor[6];
+
+	WritePayloadDescriptor(descriptor, 0u);
+
+	auto size = helpers::writeRtpPacket(
+	  buffer, 96u, 0u, 1000u, 1234u, descriptor, sizeof(descriptor), 1100u);
+
+	return RtpPacket::Parse(buffer, size);
+}
+
+// As done by Producers for every received packet.
+static void BM_VP8ProcessRtpPacket(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	auto* packet = CreatePacket(buffer);
+	uint32_t num{ 0u };
+
+	for (auto _ : state)
+	{
+		WritePayloadDescriptor(packet->GetPayload(), num++);
+
+		Codecs::VP8::ProcessRtpPacket(packet);
+	}
+
+	delete packet;
+}
+BENCHMARK(BM_VP8ProcessRtpPacket);
+
+// Same as above plus the payload descriptor rewriting done by a Consumer
+// forwarding up to the `state.range(0)` temporal layer.
+static void BM_VP8ProcessRtpPacketAndPayload(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	auto* packet = CreatePacket(buffer);
+	Codecs::EncodingContext::Params params;
+
+	params.temporalLayers = 3u;
+
+	Codecs::VP8::EncodingContext context(params);
+	uint32_t num{ 0u };
+
+	context.SetTargetTemporalLayer(static_cast<int16_t>(state.range(0)));
+	context.SetCurrentTemporalLayer(static_cast<int16_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		WritePayloadDescriptor(packet->GetPayload(), num++);
+
+		Codecs::VP8::ProcessRtpPacket(packet);
+
+		bool marker{ false };
+
+		if (packet->ProcessPayload(std::addressof(context), marker))
+			packet->RestorePayload();
+	}
+
+	delete packet;
+}
+BENCHMARK(BM_VP8ProcessRtpPacketAndPayload)->Arg(0)->Arg(2);
@@ -0,0 +1,92 @@
+#include "common.hpp"
+#include "helpers.hpp"
+#include "RTC/Codecs/VP9.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace RTC;
+
+// L1T3 temporal layer of each packet (a packet per frame).
+static constexpr uint8_t TemporalLayers[]{ 0u, 2u, 1u, 2u };
+
+// Writes the payload descriptor (with two bytes pictureId, layer indices and
+// TL0PICIDX) of the given packet number.
+static void WritePayloadDescriptor(uint8_t* data, uint32_t num)
+{
+	auto pictureId = static_cast<uint16_t>(num & 0x7FFFu);
+
+	// I:1, P:1, L:1, B:1, E:1.
+	data[0] = 0xEC;
+	// M:1 and pictureId.
+	data[1] = 0x80 | static_cast<uint8_t>(pictureId >> 8);
+	data[2] = static_cast<uint8_t>(pictureId);
+	// TID, U:1, SID:0.
+	data[3] = static_cast<uint8_t>(TemporalLayers[num % 4u] << 5) | 0x10;
+	// TL0PICIDX.
+	data[4] = static_cast<uint8_t>(num / 4u);
+}
+
+static RtpPacket* CreatePacket(uint8_t* buffer)
+{
+	uint8_t descriptor[5];
+
+	WritePayloadDescriptor(descriptor, 0u);
+
+	auto size = helpers::writeRtpPacket(
+	  buffer, 96u, 0u, 1000u, 1234u, descriptor, sizeof(descriptor), 1100u);
+
+	return RtpPacket::Parse(buffer, size);
+}
+
+// As done by Producers for every received packet.
+static void BM_VP9ProcessRtpPacket(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	auto* packet = CreatePacket(buffer);
+	uint32_t num{ 0u };
+
+	for (auto _ : state)
+	{
+		WritePayloadDescriptor(packet->GetPayload(), num++);
+
+		Codecs::VP9::ProcessRtpPacket(packet);
+	}
+
+	delete packet;
+}
+BENCHMARK(BM_VP9ProcessRtpPacket);
+
+// Same as above plus the payload descriptor rewriting done by a Consumer
+// forwarding up to the `state.range(0)` temporal layer.
+static void BM_VP9ProcessRtpPacketAndPayload(benchmark::State& state)
+{
+	uint8_t buffer[RTC::MtuSize + 100];
+	auto* packet = CreatePacket(buffer);
+	Codecs::EncodingContext::Params params;
+
+	params.spatialLayers  = 1u;
+	params.temporalLayers = 3u;
+
+	Codecs::VP9::EncodingContext context(params);
+	uint32_t num{ 0u };
+
+	context.SetTargetSpatialLayer(0);
+	context.SetCurrentSpatialLayer(0);
+	context.SetTargetTemporalLayer(static_cast<int16_t>(state.range(0)));
+	context.SetCurrentTemporalLayer(static_cast<int16_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		WritePayloadDescriptor(packet->GetPayload(), num++);
+
+		Codecs::VP9::ProcessRtpPacket(packet);
+
+		bool marker{ false };
+
+		if (packet->ProcessPayload(std::addressof(context), marker))
+			packet->RestorePayload();
+	}
+
+	delete packet;
+}
+BENCHMARK(BM_VP9ProcessRtpPacketAndPayload)->Arg(0)->Arg(2);
@@ -0,0 +1,62 @@
+#include "common.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+using namespace RTC::RTCP;
+
+static constexpr size_t MaxRtcpPacketLen{ 1200u };
+
+// As done by TransportCongestionControlServer for every received packet, with
+// a new feedback packet every `state.range(0)` packets (or once full).
+static void BM_FeedbackRtpTransportPacketAddPacket(benchmark::State& state)
+{
+	std::unique_ptr<FeedbackRtpTransportPacket> packet(new FeedbackRtpTransportPacket(0u, 0u));
+	auto packetsPerFeedback = static_cast<size_t>(state.range(0));
+	uint16_t wideSeqNumber{ 0u };
+	uint64_t nowMs{ 1000000u };
+	size_t numPackets{ 0u };
+
+	for (auto _ : state)
+	{
+		// A packet every 1 or 2 ms.
+		nowMs += 1u + (wideSeqNumber & 1u);
+
+		auto result = packet->AddPacket(wideSeqNumber++, nowMs, MaxRtcpPacketLen);
+
+		// clang-format off
+		if (
+			result != FeedbackRtpTransportPacket::AddPacketResult::SUCCESS ||
+			packet->IsFull() ||
+			++numPackets == packetsPerFeedback
+		)
+		// clang-format on
+		{
+			packet.reset(new FeedbackRtpTransportPacket(0u, 0u));
+
+			numPackets = 0u;
+		}
+	}
+}
+BENCHMARK(BM_FeedbackRtpTransportPacketAddPacket)->Arg(20)->Arg(100);
+
+static void BM_FeedbackRtpTransportPacketSerialize(benchmark::State& state)
+{
+	FeedbackRtpTransportPacket packet(0u, 0u);
+	uint64_t nowMs{ 1000000u };
+
+	for (uint16_t wideSeqNumber{ 0u }; wideSeqNumber < state.range(0); ++wideSeqNumber)
+	{
+		nowMs += 1u + (wideSeqNumber & 1u);
+
+		packet.AddPacket(wideSeqNumber, nowMs, MaxRtcpPacketLen);
+	}
+
+	packet.Finish();
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(packet.Serialize(Buffer));
+	}
+}
+BENCHMARK(BM_FeedbackRtpTransportPacketSerialize)->Arg(20)->Arg(100);
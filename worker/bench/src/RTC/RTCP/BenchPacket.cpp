@@ -0,0 +1,123 @@
+#include "common.hpp"
+#include "RTC/RTCP/CompoundPacket.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
+#include "RTC/RTCP/Packet.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+
+using namespace RTC::RTCP;
+
+static constexpr size_t MaxRtcpPacketLen{ 1200u };
+static const std::string Cname("dcb9fbd5d4baa1ae");
+
+static void AddSenderReport(CompoundPacket& packet, uint32_t ssrc)
+{
+	auto* report = new SenderReport();
+	auto* chunk  = new SdesChunk(ssrc);
+
+	report->SetSsrc(ssrc);
+	report->SetNtpSec(3000000000u);
+	report->SetNtpFrac(123456u);
+	report->SetRtpTs(90000u);
+	report->SetPacketCount(1000u);
+	report->SetOctetCount(1200000u);
+
+	chunk->AddItem(new SdesItem(SdesItem::Type::CNAME, Cname.size(), Cname.c_str()));
+
+	packet.AddSenderReport(report);
+	packet.AddSdesChunk(chunk);
+}
+
+static void AddReceiverReport(CompoundPacket& packet, uint32_t ssrc)
+{
+	auto* report = new ReceiverReport();
+
+	report->SetSsrc(ssrc);
+	report->SetFractionLost(2u);
+	report->SetTotalLost(10);
+	report->SetLastSeq(12345u);
+	report->SetJitter(30u);
+	report->SetLastSenderReport(0x12345678);
+	report->SetDelaySinceLastSenderReport(5000u);
+
+	packet.AddReceiverReport(report);
+}
+
+// As received from browsers: a compound packet with a Receiver Report and a
+// SDES chunk followed by a transport-cc feedback of `state.range(0)` packets.
+static void BM_RtcpPacketParse(benchmark::State& state)
+{
+	uint8_t buffer[1500];
+	CompoundPacket compoundPacket;
+	FeedbackRtpTransportPacket feedbackPacket(1111u, 2222u);
+	auto* chunk = new SdesChunk(1111u);
+
+	AddReceiverReport(compoundPacket, 2222u);
+	chunk->AddItem(new SdesItem(SdesItem::Type::CNAME, Cname.size(), Cname.c_str()));
+	compoundPacket.AddSdesChunk(chunk);
+	compoundPacket.Serialize(buffer);
+
+	for (uint16_t seq{ 0u }; seq < state.range(0); ++seq)
+	{
+		feedbackPacket.AddPacket(seq, 1000000u + seq, MaxRtcpPacketLen);
+	}
+
+	feedbackPacket.Finish();
+
+	auto size = compoundPacket.GetSize();
+
+	size += feedbackPacket.Serialize(buffer + size);
+
+	for (auto _ : state)
+	{
+		auto* packet = Packet::Parse(buffer, size);
+
+		benchmark::DoNotOptimize(packet);
+
+		while (packet)
+		{
+			auto* previousPacket = packet;
+
+			packet = packet->GetNext();
+
+			delete previousPacket;
+		}
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+BENCHMARK(BM_RtcpPacketParse)->Arg(10)->Arg(100);
+
+// As done by Consumers for each sending RTP stream.
+static void BM_RtcpCompoundPacketSerializeSenderReport(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		CompoundPacket packet;
+
+		AddSenderReport(packet, 1111u);
+		packet.Serialize(Buffer);
+
+		benchmark::DoNotOptimize(packet.GetSize());
+	}
+}
+BENCHMARK(BM_RtcpCompoundPacketSerializeSenderReport);
+
+// As done by Transports for `state.range(0)` receiving RTP streams.
+static void BM_RtcpCompoundPacketSerializeReceiverReports(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		CompoundPacket packet;
+
+		for (uint32_t ssrc{ 0u }; ssrc < state.range(0); ++ssrc)
+		{
+			AddReceiverReport(packet, ssrc);
+		}
+
+		packet.Serialize(Buffer);
+
+		benchmark::DoNotOptimize(packet.GetSize());
+	}
+}
+BENCHMARK(BM_RtcpCompoundPacketSerializeReceiverReports)->Arg(1)->Arg(10);
@@ -0,0 +1,60 @@
+#include "DepLibSRTP.hpp"
+#include "DepLibUV.hpp"
+#include "DepLibWebRTC.hpp"
+#include "DepOpenSSL.hpp"
+#include "DepUsrSCTP.hpp"
+#include "LogLevel.hpp"
+#include "Settings.hpp"
+#include "Utils.hpp"
+#include "RTC/DtlsTransport.hpp"
+#include "RTC/SrtpSession.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdlib> // std::getenv()
+
+int main(int argc, char* argv[])
+{
+	LogLevel logLevel{ LogLevel::LOG_NONE };
+
+	// Get logLevel from ENV variable.
+	if (std::getenv("MS_BENCH_LOG_LEVEL"))
+	{
+		if (std::string(std::getenv("MS_BENCH_LOG_LEVEL")) == "debug")
+			logLevel = LogLevel::LOG_DEBUG;
+		else if (std::string(std::getenv("MS_BENCH_LOG_LEVEL")) == "warn")
+			logLevel = LogLevel::LOG_WARN;
+		else if (std::string(std::getenv("MS_BENCH_LOG_LEVEL")) == "error")
+			logLevel = LogLevel::LOG_ERROR;
+	}
+
+	Settings::configuration.logLevel = logLevel;
+
+	// Initialize static stuff.
+	DepLibUV::ClassInit();
+	DepOpenSSL::ClassInit();
+	DepLibSRTP::ClassInit();
+	DepUsrSCTP::ClassInit();
+	DepLibWebRTC::ClassInit();
+	Utils::Crypto::ClassInit();
+	RTC::DtlsTransport::ClassInit();
+	RTC::SrtpSession::ClassInit();
+
+	// Google Benchmark arguments, i.e. `--benchmark_filter=<regex>` or
+	// `--benchmark_format=json` for machine-readable results.
+	benchmark::Initialize(&argc, argv);
+
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	// Free static stuff.
+	DepLibSRTP::ClassDestroy();
+	Utils::Crypto::ClassDestroy();
+	DepLibWebRTC::ClassDestroy();
+	RTC::DtlsTransport::ClassDestroy();
+	DepUsrSCTP::ClassDestroy();
+	DepLibUV::ClassDestroy();
+
+	return 0;
+}
@@ -0,0 +1,303 @@
+#include "common.hpp"
+#include "DepIoUring.hpp"
+#include "DepLibUV.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
+#include "handles/UdpSocketHandler.hpp"
+#include <benchmark/benchmark.h>
+#include <cstring> // std::memset()
+#include <memory>
+
+// UDP receive and send throughput of UdpSocketHandler with the libuv (epoll)
+// I/O path versus the io_uring one, over loopback.
+//
+// A peer socket sends bursts of RTP sized datagrams to the benchmarked socket,
+// which sends every received datagram `fan_out` times to a sink socket (never
+// read) as an SFU does. Each iteration sends a burst and runs the loop until
+// the whole burst has been received.
+//
+// Reported counters:
+// - recv_pps, send_pps: datagrams received and sent by the socket per second.
+// - cpu_ns_per_pkt: process CPU time (kernel included) per datagram received
+//   or sent by the socket.
+
+namespace
+{
+	constexpr size_t DatagramLength{ 1200u };
+	constexpr size_t BurstSize{ 64u };
+	// Bail out if datagrams get lost.
+	constexpr uint64_t BurstTimeoutMs{ 1000u };
+	constexpr uint64_t WakeUpIntervalMs{ 50u };
+
+	uv_udp_t* CreateUvHandle(struct sockaddr_storage& addr)
+	{
+		int err;
+		int len      = sizeof(addr);
+		auto* handle = new uv_udp_t;
+
+		uv_ip4_addr("127.0.0.1", 0, reinterpret_cast<struct sockaddr_in*>(std::addressof(addr)));
+
+		err = uv_udp_init(DepLibUV::GetLoop(), handle);
+
+		if (err != 0)
+		{
+			delete handle;
+
+			throw MediaSoupError(uv_strerror(err));
+		}
+
+		err = uv_udp_bind(handle, reinterpret_cast<struct sockaddr*>(std::addressof(addr)), 0);
+
+		if (err == 0)
+		{
+			err = uv_udp_getsockname(
+			  handle, reinterpret_cast<struct sockaddr*>(std::addressof(addr)), std::addressof(len));
+		}
+
+		if (err != 0)
+		{
+			uv_close(reinterpret_cast<uv_handle_t*>(handle), [](uv_handle_t* handle) { delete handle; });
+
+			throw MediaSoupError(uv_strerror(err));
+		}
+
+		return handle;
+	}
+
+	void CloseUvHandle(uv_handle_t* handle)
+	{
+		uv_close(handle, [](uv_handle_t* handle) { delete handle; });
+	}
+
+	class ForwardingSocket : public UdpSocketHandler
+	{
+	public:
+		ForwardingSocket(uv_udp_t* uvHandle, const struct sockaddr* sinkAddr, size_t fanOut)
+		  : UdpSocketHandler(uvHandle), sinkAddr(sinkAddr), fanOut(fanOut)
+		{
+		}
+
+	public:
+		size_t GetReceivedDatagrams() const
+		{
+			return this->receivedDatagrams;
+		}
+
+		/* Pure virtual methods inherited from UdpSocketHandler. */
+	public:
+		void UserOnUdpDatagramReceived(
+		  const uint8_t* data, size_t len, const struct sockaddr* /*addr*/) override
+		{
+			++this->receivedDatagrams;
+
+			for (size_t i{ 0u }; i < this->fanOut; ++i)
+			{
+				Send(data, len, this->sinkAddr, nullptr);
+			}
+		}
+
+	private:
+		const struct sockaddr* sinkAddr{ nullptr };
+		size_t fanOut{ 0u };
+		size_t receivedDatagrams{ 0u };
+	};
+
+	class Forwarding
+	{
+	public:
+		explicit Forwarding(size_t fanOut)
+		{
+			struct sockaddr_storage socketAddr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+			this->sink = CreateUvHandle(this->sinkAddr);
+
+			try
+			{
+				this->peer = CreateUvHandle(this->peerAddr);
+				this->socket.reset(new ForwardingSocket(
+				  CreateUvHandle(socketAddr),
+				  reinterpret_cast<const struct sockaddr*>(std::addressof(this->sinkAddr)),
+				  fanOut));
+			}
+			catch (const MediaSoupError& /*error*/)
+			{
+				CloseUvHandle(reinterpret_cast<uv_handle_t*>(this->sink));
+
+				if (this->peer)
+					CloseUvHandle(reinterpret_cast<uv_handle_t*>(this->peer));
+
+				RunLoop();
+
+				throw;
+			}
+
+			std::memcpy(std::addressof(this->socketAddr), std::addressof(socketAddr), sizeof(socketAddr));
+			std::memset(this->datagram, 0x80, sizeof(this->datagram));
+
+			// Wake up the loop periodically so a lost datagram can be detected.
+			uv_timer_init(DepLibUV::GetLoop(), std::addressof(this->timer));
+			uv_timer_start(
+			  std::addressof(this->timer),
+			  [](uv_timer_t* /*timer*/) {},
+			  WakeUpIntervalMs,
+			  WakeUpIntervalMs);
+		}
+
+		~Forwarding()
+		{
+			this->socket.reset();
+
+			CloseUvHandle(reinterpret_cast<uv_handle_t*>(this->peer));
+			CloseUvHandle(reinterpret_cast<uv_handle_t*>(this->sink));
+			uv_close(reinterpret_cast<uv_handle_t*>(std::addressof(this->timer)), nullptr);
+
+			RunLoop();
+		}
+
+	public:
+		// Returns false if the burst was not entirely received.
+		bool SendBurst()
+		{
+			uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(this->datagram), DatagramLength);
+			auto* addr      = reinterpret_cast<const struct sockaddr*>(std::addressof(this->socketAddr));
+
+			for (size_t i{ 0u }; i < BurstSize; ++i)
+			{
+				uv_udp_try_send(this->peer, std::addressof(buffer), 1, addr);
+			}
+
+			this->expectedDatagrams += BurstSize;
+
+			auto startMs = DepLibUV::GetTimeMs();
+
+			while (this->socket->GetReceivedDatagrams() < this->expectedDatagrams)
+			{
+				uv_run(DepLibUV::GetLoop(), UV_RUN_ONCE);
+
+				if (DepLibUV::GetTimeMs() - startMs > BurstTimeoutMs)
+					return false;
+			}
+
+			return true;
+		}
+
+		size_t GetReceivedDatagrams() const
+		{
+			return this->socket->GetReceivedDatagrams();
+		}
+
+		size_t GetSentDatagrams() const
+		{
+			return this->socket->GetSentBytes() / DatagramLength;
+		}
+
+	private:
+		static void RunLoop()
+		{
+			for (int i{ 0 }; i < 10; ++i)
+			{
+				uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+			}
+		}
+
+	private:
+		uv_udp_t* sink{ nullptr };
+		uv_udp_t* peer{ nullptr };
+		std::unique_ptr<ForwardingSocket> socket;
+		struct sockaddr_storage sinkAddr;
+		struct sockaddr_storage peerAddr;
+		struct sockaddr_storage socketAddr;
+		uv_timer_t timer;
+		uint8_t datagram[DatagramLength];
+		size_t expectedDatagrams{ 0u };
+	};
+
+	uint64_t GetCpuTimeNs()
+	{
+		uv_rusage_t usage;
+
+		if (uv_getrusage(std::addressof(usage)) != 0)
+			return 0u;
+
+		auto toNs = [](const uv_timeval_t& tv) {
+			return (static_cast<uint64_t>(tv.tv_sec) * 1000000000u) +
+			       (static_cast<uint64_t>(tv.tv_usec) * 1000u);
+		};
+
+		return toNs(usage.ru_utime) + toNs(usage.ru_stime);
+	}
+} // namespace
+
+// With the libuv I/O path (`state.range(0)` 0) or the io_uring one (1), sending
+// every received datagram `state.range(1)` times.
+static void BM_UdpSocketHandlerForward(benchmark::State& state)
+{
+	Settings::configuration.useIoUring = state.range(0) == 1;
+
+	DepIoUring::ClassInit();
+
+	if (Settings::configuration.useIoUring && !DepIoUring::IsEnabled())
+	{
+		Settings::configuration.useIoUring = false;
+
+		state.SkipWithError("io_uring not available");
+
+		return;
+	}
+
+	std::unique_ptr<Forwarding> forwarding;
+
+	try
+	{
+		forwarding.reset(new Forwarding(static_cast<size_t>(state.range(1))));
+	}
+	catch (const MediaSoupError& error)
+	{
+		DepIoUring::ClassDestroy();
+		Settings::configuration.useIoUring = false;
+
+		state.SkipWithError(error.what());
+
+		return;
+	}
+
+	// Warm up.
+	forwarding->SendBurst();
+
+	auto receivedDatagrams = forwarding->GetReceivedDatagrams();
+	auto sentDatagrams     = forwarding->GetSentDatagrams();
+	auto cpuTimeNs         = GetCpuTimeNs();
+
+	for (auto _ : state)
+	{
+		if (!forwarding->SendBurst())
+		{
+			state.SkipWithError("datagrams lost");
+
+			break;
+		}
+	}
+
+	cpuTimeNs         = GetCpuTimeNs() - cpuTimeNs;
+	receivedDatagrams = forwarding->GetReceivedDatagrams() - receivedDatagrams;
+	sentDatagrams     = forwarding->GetSentDatagrams() - sentDatagrams;
+
+	forwarding.reset();
+
+	DepIoUring::ClassDestroy();
+	Settings::configuration.useIoUring = false;
+
+	state.SetItemsProcessed(static_cast<int64_t>(receivedDatagrams));
+	state.counters["recv_pps"] =
+	  benchmark::Counter(static_cast<double>(receivedDatagrams), benchmark::Counter::kIsRate);
+	state.counters["send_pps"] =
+	  benchmark::Counter(static_cast<double>(sentDatagrams), benchmark::Counter::kIsRate);
+	state.counters["cpu_ns_per_pkt"] =
+	  receivedDatagrams + sentDatagrams > 0u
+	    ? static_cast<double>(cpuTimeNs) / static_cast<double>(receivedDatagrams + sentDatagrams)
+	    : 0.0;
+}
+BENCHMARK(BM_UdpSocketHandlerForward)
+  ->ArgNames({ "io_uring", "fan_out" })
+  ->ArgsProduct({ { 0, 1 }, { 1, 8 } })
+  ->UseRealTime();
@@ -44,16 +44,16 @@ void Fuzzer::RTC::RtpStreamSend::Fuzz(const uint8_t* data, size_t len)
 
 	std::string mid;
 	::RTC::RtpStreamSend* stream = new ::RTC::RtpStreamSend(&testRtpStreamListener, params, mid);
+	::RTC::RtpRetransmissionCache retransmissionCache(params.clockRate);
 
 	while (len >= 4u)
 	{
-		std::shared_ptr<::RTC::RtpPacket> sharedPacket;
-
 		// Set 'random' sequence number and timestamp.
 		packet->SetSequenceNumber(Utils::Byte::Get2Bytes(data, offset));
 		packet->SetTimestamp(Utils::Byte::Get4Bytes(data, offset));
 
-		stream->ReceivePacket(packet, sharedPacket);
+		retransmissionCache.SetCurrentPacket(packet);
+		stream->ReceivePacket(packet, std::addressof(retransmissionCache));
 
 		len -= 4u;
 		offset += 4;
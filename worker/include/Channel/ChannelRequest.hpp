@@ -31,11 +31,13 @@ namespace Channel
 			ROUTER_DUMP,
 			ROUTER_CREATE_WEBRTC_TRANSPORT,
 			ROUTER_CREATE_WEBRTC_TRANSPORT_WITH_SERVER,
+			ROUTER_PREPARE_WEBRTC_TRANSPORT_IMPORT,
 			ROUTER_CREATE_PLAIN_TRANSPORT,
 			ROUTER_CREATE_PIPE_TRANSPORT,
 			ROUTER_CREATE_DIRECT_TRANSPORT,
 			ROUTER_CREATE_ACTIVE_SPEAKER_OBSERVER,
 			ROUTER_CREATE_AUDIO_LEVEL_OBSERVER,
+			ROUTER_BULK_REQUEST,
 			TRANSPORT_CLOSE,
 			TRANSPORT_DUMP,
 			TRANSPORT_GET_STATS,
@@ -43,6 +45,7 @@ namespace Channel
 			TRANSPORT_SET_MAX_INCOMING_BITRATE,
 			TRANSPORT_SET_MAX_OUTGOING_BITRATE,
 			TRANSPORT_RESTART_ICE,
+			TRANSPORT_EXPORT_STATE,
 			TRANSPORT_PRODUCE,
 			TRANSPORT_CONSUME,
 			TRANSPORT_PRODUCE_DATA,
@@ -75,7 +78,9 @@ namespace Channel
 			RTP_OBSERVER_PAUSE,
 			RTP_OBSERVER_RESUME,
 			RTP_OBSERVER_ADD_PRODUCER,
-			RTP_OBSERVER_REMOVE_PRODUCER
+			RTP_OBSERVER_REMOVE_PRODUCER,
+			RTP_OBSERVER_ADD_CONSUMER,
+			RTP_OBSERVER_REMOVE_CONSUMER
 		};
 
 	private:
@@ -90,8 +95,13 @@ namespace Channel
 		void Error(const char* reason = nullptr);
 		void TypeError(const char* reason = nullptr);
 
+	private:
+		void Send(json& jsonResponse);
+
 	public:
 		// Passed by argument.
+		// NOTE: If null (requests within a bulk request) the reply is not sent but
+		// stored in response.
 		Channel::ChannelSocket* channel{ nullptr };
 		uint32_t id{ 0u };
 		std::string method;
@@ -100,6 +110,7 @@ namespace Channel
 		json data;
 		// Others.
 		bool replied{ false };
+		json response;
 	};
 } // namespace Channel
 
@@ -5,6 +5,8 @@
 #include "Channel/ChannelRequest.hpp"
 #include "handles/UnixStreamSocket.hpp"
 #include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
 
 namespace Channel
 {
@@ -84,6 +86,8 @@ namespace Channel
 		bool CallbackRead();
 		void Send(json& jsonMessage);
 		void SendLog(const char* message, uint32_t messageLen);
+		// Sends many log lines with as few writes as possible.
+		void SendLogs(const std::vector<std::string>& messages);
 
 	private:
 		void SendImpl(const uint8_t* payload, uint32_t payloadLen);
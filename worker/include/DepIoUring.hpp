@@ -0,0 +1,85 @@
+#ifndef MS_DEP_IO_URING_HPP
+#define MS_DEP_IO_URING_HPP
+
+#include "common.hpp"
+#include <uv.h>
+
+/**
+ * Optional Linux io_uring I/O path for UDP and TCP media sockets, driven by
+ * the libuv loop through an eventfd. It's implemented on top of the kernel
+ * ABI (no liburing needed) and only used if the `useIoUring` setting is
+ * enabled, the worker is built with MS_IO_URING_SUPPORTED and the running
+ * kernel supports it (otherwise the libuv path is used).
+ *
+ * - Receiving is done with a multishot recvmsg (UDP) or recv (TCP) request
+ *   per socket, which pick buffers from a ring of provided buffers.
+ * - Sent datagrams are copied into preallocated slots and their sendmsg
+ *   requests are submitted all together once per loop iteration.
+ */
+class DepIoUring
+{
+public:
+	class RecvListener
+	{
+	public:
+		virtual ~RecvListener() = default;
+
+	public:
+		/**
+		 * Called with a received datagram (addr is given) or a chunk of stream
+		 * data (addr is nullptr). It must return the number of consumed bytes
+		 * and, if lower than len, it's called again with the remaining data
+		 * (unless the receiving has been stopped meanwhile).
+		 */
+		virtual size_t OnIoUringRecv(const uint8_t* data, size_t len, const struct sockaddr* addr) = 0;
+		/**
+		 * Called once the receiving has ended with 0 (stream closed by the peer)
+		 * or with a negative errno value. The receiving is already stopped.
+		 */
+		virtual void OnIoUringRecvEnded(int error) = 0;
+	};
+
+public:
+	using onSendCallback = const std::function<void(bool sent)>;
+
+public:
+	static void ClassInit();
+	static void ClassDestroy();
+	static bool IsEnabled()
+	{
+		return DepIoUring::enabled;
+	}
+	/**
+	 * Start receiving datagrams (uv_udp_t) or stream data (uv_tcp_t) on the
+	 * socket of the given handle. It returns the id to be given to StopRecv()
+	 * or 0 if the libuv path must be used instead.
+	 */
+	static uint64_t StartRecv(uv_handle_t* handle, RecvListener* listener);
+	static void StopRecv(uint64_t id);
+	/**
+	 * Queue a datagram to be sent in the current loop iteration. It returns
+	 * false if it cannot be handled, in which case cb is not taken.
+	 */
+	static bool PrepareSend(
+	  uv_udp_t* handle,
+	  const uint8_t* data,
+	  size_t len,
+	  const struct sockaddr* addr,
+	  DepIoUring::onSendCallback* cb);
+	/**
+	 * Submit the queued datagrams right now, so a datagram sent through libuv
+	 * does not overtake them.
+	 */
+	static void SubmitSends();
+	/**
+	 * Submit the datagrams queued for the socket of the given handle right now,
+	 * or cancel them if the kernel does not take them. It must be called before
+	 * closing the handle since queued requests just hold its fd.
+	 */
+	static void FlushSends(uv_udp_t* handle);
+
+private:
+	thread_local static bool enabled;
+};
+
+#endif
@@ -9,6 +9,8 @@ class DepLibSRTP
 public:
 	static void ClassInit();
 	static void ClassDestroy();
+	// Initializes libsrtp unless already done. Must be called before using it.
+	static void EnsureInitialized();
 	static bool IsError(srtp_err_status_t code)
 	{
 		return (code != srtp_err_status_ok);
@@ -33,6 +33,7 @@ public:
 	static void ClassDestroy();
 	static void CreateChecker();
 	static void CloseChecker();
+	// NOTE: It also initializes usrsctp if not yet done.
 	static uintptr_t GetNextSctpAssociationId();
 	static void RegisterSctpAssociation(RTC::SctpAssociation* sctpAssociation);
 	static void DeregisterSctpAssociation(RTC::SctpAssociation* sctpAssociation);
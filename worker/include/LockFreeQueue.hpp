@@ -0,0 +1,141 @@
+#ifndef MS_LOCK_FREE_QUEUE_HPP
+#define MS_LOCK_FREE_QUEUE_HPP
+
+#include "common.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility> // std::move()
+
+/**
+ * Bounded queue that can be pushed and popped from different threads without
+ * locks. Any number of producers and consumers is allowed. The capacity is
+ * rounded up to a power of two.
+ */
+template<typename T>
+class LockFreeQueue
+{
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T item;
+	};
+
+public:
+	explicit LockFreeQueue(size_t capacity)
+	{
+		size_t size{ 2u };
+
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+
+		this->cells.reset(new Cell[size]);
+		this->mask = size - 1;
+
+		for (size_t idx{ 0u }; idx < size; ++idx)
+		{
+			this->cells[idx].sequence.store(idx, std::memory_order_relaxed);
+		}
+	}
+
+public:
+	size_t GetCapacity() const
+	{
+		return this->mask + 1;
+	}
+	// Returns false if the queue is full (the item is not moved).
+	bool Push(T& item)
+	{
+		return PushInPlace([&item](T& slot) { slot = std::move(item); });
+	}
+	// Returns false if the queue is empty.
+	bool Pop(T& item)
+	{
+		return PopInPlace([&item](T& slot) { item = std::move(slot); });
+	}
+	// Like Push() but the given function fills the slot of the item, so big
+	// items are not copied twice. Returns false if the queue is full.
+	template<typename F>
+	bool PushInPlace(F fill)
+	{
+		Cell* cell;
+		size_t pos = this->enqueuePos.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			cell         = std::addressof(this->cells[pos & this->mask]);
+			size_t seq   = cell->sequence.load(std::memory_order_acquire);
+			intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+			if (dif == 0)
+			{
+				if (this->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (dif < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = this->enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		fill(cell->item);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+	// Like Pop() but the given function reads the item in its slot, which is
+	// not reused until the function returns. Returns false if the queue is
+	// empty.
+	template<typename F>
+	bool PopInPlace(F read)
+	{
+		Cell* cell;
+		size_t pos = this->dequeuePos.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			cell         = std::addressof(this->cells[pos & this->mask]);
+			size_t seq   = cell->sequence.load(std::memory_order_acquire);
+			intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+			if (dif == 0)
+			{
+				if (this->dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (dif < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = this->dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		read(cell->item);
+		cell->sequence.store(pos + this->mask + 1, std::memory_order_release);
+
+		return true;
+	}
+
+private:
+	// Allocated by this.
+	std::unique_ptr<Cell[]> cells;
+	// Others.
+	size_t mask{ 0u };
+	// Keep producer and consumer positions in different cache lines.
+	uint8_t padding1[64];
+	std::atomic<size_t> enqueuePos{ 0u };
+	uint8_t padding2[64];
+	std::atomic<size_t> dequeuePos{ 0u };
+};
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef MS_LOG_RING_HPP
+#define MS_LOG_RING_HPP
+
+#include "common.hpp"
+#include "SpscQueue.hpp"
+#include <uv.h>
+#include <atomic>
+#include <cstring> // std::memcpy()
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Channel
+{
+	class ChannelSocket;
+} // namespace Channel
+
+/**
+ * Binary log ring. The loop thread just records the format string (which must
+ * be a literal) and a copy of the arguments. A background thread formats the
+ * entries and hands the resulting lines back to the loop thread, which sends
+ * them in batches through the Channel. The loop thread and the background
+ * thread are the only producer and consumer of the ring. Lines not yet sent
+ * are bounded: once too many, the ring is not drained so new entries are
+ * dropped (and counted) by Record().
+ *
+ * NOTE: String arguments must be NUL terminated (so "%.*s" cannot be used
+ * with non NUL terminated strings).
+ */
+class LogRing
+{
+public:
+	// Max bytes of arguments stored per entry. Longer strings are truncated.
+	static constexpr size_t MaxArgsLen{ 480u };
+
+public:
+	enum class ArgType : uint8_t
+	{
+		INT = 1,
+		UINT,
+		DOUBLE,
+		STRING,
+		POINTER
+	};
+
+public:
+	struct Entry
+	{
+		const char* format;
+		uint16_t argsLen;
+		uint8_t args[MaxArgsLen];
+	};
+
+public:
+	template<typename... Args>
+	static void Encode(Entry& entry, const char* format, Args... args)
+	{
+		entry.format  = format;
+		entry.argsLen = 0u;
+
+		AddArgs(entry, args...);
+	}
+	// Returns the length of the formatted line. Public for testing.
+	static size_t Format(const Entry& entry, char* buffer, size_t bufferSize);
+
+private:
+	static void AddArgs(Entry& /*entry*/)
+	{
+	}
+	template<typename T, typename... Args>
+	static void AddArgs(Entry& entry, T arg, Args... args)
+	{
+		AddArg(entry, arg);
+		AddArgs(entry, args...);
+	}
+	template<typename T>
+	static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type AddArg(
+	  Entry& entry, T arg)
+	{
+		AddValue(entry, ArgType::INT, static_cast<int64_t>(arg));
+	}
+	template<typename T>
+	static typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type AddArg(
+	  Entry& entry, T arg)
+	{
+		AddValue(entry, ArgType::UINT, static_cast<uint64_t>(arg));
+	}
+	template<typename T>
+	static typename std::enable_if<std::is_enum<T>::value>::type AddArg(Entry& entry, T arg)
+	{
+		AddArg(entry, static_cast<typename std::underlying_type<T>::type>(arg));
+	}
+	static void AddArg(Entry& entry, double arg)
+	{
+		AddValue(entry, ArgType::DOUBLE, arg);
+	}
+	static void AddArg(Entry& entry, const void* arg)
+	{
+		AddValue(entry, ArgType::POINTER, arg);
+	}
+	static void AddArg(Entry& entry, char* arg)
+	{
+		AddArg(entry, const_cast<const char*>(arg));
+	}
+	static void AddArg(Entry& entry, const char* arg)
+	{
+		if (!arg)
+			arg = "(null)";
+
+		// Room for the type, the string and its NUL character.
+		if (entry.argsLen + 2u > MaxArgsLen)
+			return;
+
+		size_t maxLen = MaxArgsLen - entry.argsLen - 2u;
+		size_t len    = strnlen(arg, maxLen);
+
+		entry.args[entry.argsLen++] = static_cast<uint8_t>(ArgType::STRING);
+		std::memcpy(entry.args + entry.argsLen, arg, len);
+		entry.argsLen += len;
+		entry.args[entry.argsLen++] = '\0';
+	}
+	template<typename T>
+	static void AddValue(Entry& entry, ArgType type, T value)
+	{
+		// Arguments that do not fit are printed as '?'.
+		if (entry.argsLen + 1u + sizeof(T) > MaxArgsLen)
+			return;
+
+		entry.args[entry.argsLen++] = static_cast<uint8_t>(type);
+		std::memcpy(entry.args + entry.argsLen, &value, sizeof(T));
+		entry.argsLen += sizeof(T);
+	}
+
+public:
+	LogRing(Channel::ChannelSocket* channel, size_t size);
+	~LogRing();
+
+public:
+	template<typename... Args>
+	void Record(const char* format, Args... args)
+	{
+		// The entry is encoded in its slot.
+		auto encode = [format, args...](Entry& entry) { Encode(entry, format, args...); };
+
+		if (!this->entries.PushInPlace(encode))
+			this->droppedEntries.fetch_add(1u, std::memory_order_relaxed);
+	}
+	uint64_t GetDroppedEntries() const
+	{
+		return this->droppedEntries.load(std::memory_order_relaxed);
+	}
+
+private:
+	void RunThread();
+
+	/* Callbacks fired by UV events. */
+public:
+	void OnUvAsync();
+
+private:
+	// Passed by argument.
+	Channel::ChannelSocket* channel{ nullptr };
+	// Allocated by this.
+	uv_async_t* uvHandle{ nullptr };
+	std::thread thread;
+	// Others.
+	SpscQueue<Entry> entries;
+	std::atomic<uint64_t> droppedEntries{ 0u };
+	std::atomic<bool> closed{ false };
+	// Formatted lines waiting to be sent within the loop thread.
+	std::mutex linesMutex;
+	std::vector<std::string> lines;
+};
+
+#endif
@@ -11,6 +11,11 @@
  *
  * If the macro MS_LOG_STD is defined, all the macros log to stdout/stderr.
  *
+ * If the LogRing is started (see Logger::StartRing()), macros using the
+ * Channel (but MS_DUMP() and MS_DUMP_DATA()) just record the entry into it and
+ * the line is formatted and sent later. Their string arguments must be NUL
+ * terminated.
+ *
  * If the macro MS_LOG_FILE_LINE is defied, all the logging macros print more
  * verbose information, including current file and line.
  *
@@ -88,6 +93,7 @@
 
 #include "common.hpp"
 #include "LogLevel.hpp"
+#include "LogRing.hpp"
 #include "Settings.hpp"
 #include "Channel/ChannelSocket.hpp"
 #include <cstdio>  // std::snprintf(), std::fprintf(), stdout, stderr
@@ -130,16 +136,38 @@ class Logger
 {
 public:
 	static void ClassInit(Channel::ChannelSocket* channel);
+	// Log through a LogRing with the given number of entries.
+	static void StartRing(size_t size);
+	// Send pending entries and log synchronously again.
+	static void StopRing();
 
 public:
 	static const uint64_t pid;
 	thread_local static Channel::ChannelSocket* channel;
 	static const size_t bufferSize {50000};
 	thread_local static char buffer[];
+	thread_local static LogRing* ring;
 };
 
 /* Logging macros. */
 
+// Records the entry into the LogRing if enabled. Otherwise formats and sends
+// it synchronously.
+#define _MS_LOG(desc, ...) \
+	do \
+	{ \
+		if (Logger::ring) \
+		{ \
+			Logger::ring->Record(desc, ##__VA_ARGS__); \
+		} \
+		else \
+		{ \
+			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, desc, ##__VA_ARGS__); \
+			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+		} \
+	} \
+	while (false)
+
 #define _MS_LOG_SEPARATOR_CHAR_STD "\n"
 
 #ifdef MS_LOG_FILE_LINE
@@ -159,8 +187,7 @@ public:
 		{ \
 			if (Settings::configuration.logLevel == LogLevel::LOG_DEBUG) \
 			{ \
-				int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D(trace) " _MS_LOG_STR, _MS_LOG_ARG); \
-				Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+				_MS_LOG("D(trace) " _MS_LOG_STR, _MS_LOG_ARG); \
 			} \
 		} \
 		while (false)
@@ -191,8 +218,7 @@ public:
 	{ \
 		if (Settings::configuration.logLevel == LogLevel::LOG_DEBUG && _MS_TAG_ENABLED(tag)) \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			_MS_LOG("D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 	} \
 	while (false)
@@ -213,8 +239,7 @@ public:
 	{ \
 		if (Settings::configuration.logLevel >= LogLevel::LOG_WARN && _MS_TAG_ENABLED(tag)) \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			_MS_LOG("W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 	} \
 	while (false)
@@ -235,8 +260,7 @@ public:
 	{ \
 		if (Settings::configuration.logLevel == LogLevel::LOG_DEBUG && _MS_TAG_ENABLED_2(tag1, tag2)) \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			_MS_LOG("D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 	} \
 	while (false)
@@ -257,8 +281,7 @@ public:
 	{ \
 		if (Settings::configuration.logLevel >= LogLevel::LOG_WARN && _MS_TAG_ENABLED_2(tag1, tag2)) \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			_MS_LOG("W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 	} \
 	while (false)
@@ -278,8 +301,7 @@ public:
 	#define MS_DEBUG_DEV(desc, ...) \
 		do \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			_MS_LOG("D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 		while (false)
 
@@ -300,8 +322,7 @@ public:
 	#define MS_WARN_DEV(desc, ...) \
 		do \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			_MS_LOG("W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 		while (false)
 
@@ -394,8 +415,7 @@ public:
 	{ \
 		if (Settings::configuration.logLevel >= LogLevel::LOG_ERROR || MS_LOG_DEV_LEVEL >= 1) \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "E" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			_MS_LOG("E" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 	} \
 	while (false)
@@ -0,0 +1,94 @@
+#ifndef MS_OVERLOAD_CONTROLLER_HPP
+#define MS_OVERLOAD_CONTROLLER_HPP
+
+#include "common.hpp"
+#include "handles/Timer.hpp"
+#include <absl/container/flat_hash_map.h>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+/**
+ * Periodically measures the event loop lag and busy time. While the loop is
+ * saturated it applies the given degradation steps one by one (one per
+ * level) and undoes them, in reverse order, once the loop recovers.
+ */
+class OverloadController : public Timer::Listener
+{
+public:
+	enum class Step : uint8_t
+	{
+		// Ignore NACKs (no RTP retransmissions).
+		RETRANSMISSIONS = 1,
+		// Lower the target layers of simulcast and SVC Consumers.
+		LAYERS,
+		// Send RTCP less frequently.
+		RTCP
+	};
+
+public:
+	class Listener
+	{
+	public:
+		virtual ~Listener() = default;
+
+	public:
+		virtual void OnOverloadControllerLevelChange(
+		  OverloadController* overloadController, size_t previousLevel) = 0;
+	};
+
+public:
+	static bool IsStepApplied(Step step)
+	{
+		return (OverloadController::appliedSteps & (1u << static_cast<uint8_t>(step))) != 0u;
+	}
+
+public:
+	static absl::flat_hash_map<std::string, Step> string2Step;
+	static absl::flat_hash_map<Step, std::string> step2String;
+
+private:
+	thread_local static uint32_t appliedSteps;
+
+public:
+	OverloadController(
+	  Listener* listener, uint64_t lagThreshold, uint8_t busyThreshold, const std::vector<Step>& steps);
+	~OverloadController() override;
+
+public:
+	void FillJson(json& jsonObject) const;
+	size_t GetLevel() const
+	{
+		return this->level;
+	}
+	// Feeds a loop lag (ms) and busy (%) measurement. Public for testing.
+	void ProcessSample(uint64_t loopLag, uint8_t loopBusy);
+
+private:
+	void SetLevel(size_t level);
+
+	/* Pure virtual methods inherited from Timer::Listener. */
+public:
+	void OnTimer(Timer* timer) override;
+
+private:
+	// Passed by argument.
+	Listener* listener{ nullptr };
+	uint64_t lagThreshold{ 0u };
+	uint8_t busyThreshold{ 0u };
+	std::vector<Step> steps;
+	// Allocated by this.
+	Timer* timer{ nullptr };
+	// Others.
+	size_t level{ 0u };
+	uint64_t lastSampleAtNs{ 0u };
+	uint64_t lastIdleTimeNs{ 0u };
+	uint64_t loopLag{ 0u };
+	uint8_t loopBusy{ 0u };
+	size_t overloadedSamples{ 0u };
+	size_t relaxedSamples{ 0u };
+};
+
+#endif
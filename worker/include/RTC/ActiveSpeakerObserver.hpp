@@ -4,7 +4,9 @@
 #include "RTC/RtpObserver.hpp"
 #include "handles/Timer.hpp"
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <nlohmann/json.hpp>
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -14,17 +16,31 @@
 // for the input signal.
 // This has been ported from DominantSpeakerIdentification.java in Jitsi.
 // https://github.com/jitsi/jitsi-utils/blob/master/src/main/java/org/jitsi/utils/dsi/DominantSpeakerIdentification.java
+//
+// If lastN is given, Consumers attached to a speaker (audio Producer) are
+// forwarded only while the speaker is one of the lastN most recent dominant
+// speakers. Otherwise they are paused (or downgraded to their lowest layers).
 namespace RTC
 {
 	class ActiveSpeakerObserver : public RTC::RtpObserver, public Timer::Listener
 	{
 	private:
+		// Speakers are stored contiguously and their sample buffers are inline, so
+		// evaluating the activity scores of all of them on every interval does not
+		// chase pointers nor jump across the heap.
 		class Speaker
 		{
 		public:
-			Speaker();
+			// Sizes of the sample buffers (see the constants in the .cpp file).
+			static constexpr uint32_t LevelsBuffLen{ 50u };
+			static constexpr uint32_t ImmediatesBuffLen{ 50u };
+			static constexpr uint32_t MediumsBuffLen{ 10u };
+			static constexpr uint32_t LongsBuffLen{ 1u };
+
+		public:
+			explicit Speaker(RTC::Producer* producer);
 			void EvalActivityScores();
-			double GetActivityScore(int32_t interval);
+			double GetLogActivityScore(int32_t interval) const;
 			void LevelChanged(uint32_t level, uint64_t now);
 			void LevelTimedOut(uint64_t now);
 
@@ -38,27 +54,24 @@ namespace RTC
 			void UpdateMinLevel(int8_t level);
 
 		public:
+			RTC::Producer* producer{ nullptr };
 			bool paused{ false };
-			double immediateActivityScore;
-			double mediumActivityScore;
-			double longActivityScore;
+			double immediateLogActivityScore;
+			double mediumLogActivityScore;
+			double longLogActivityScore;
 			uint64_t lastLevelChangeTime{ 0 };
 
 		private:
 			uint8_t minLevel;
 			uint8_t nextMinLevel;
 			uint32_t nextMinLevelWindowLen{ 0 };
-			std::vector<uint8_t> immediates;
-			std::vector<uint8_t> mediums;
-			std::vector<uint8_t> longs;
-			std::vector<uint8_t> levels;
-			size_t nextLevelIndex;
-		};
-
-		struct ProducerSpeaker
-		{
-			RTC::Producer* producer;
-			Speaker* speaker;
+			std::array<uint8_t, ImmediatesBuffLen> immediates;
+			std::array<uint8_t, MediumsBuffLen> mediums;
+			std::array<uint8_t, LongsBuffLen> longs;
+			// Every sample is stored twice so the latest LevelsBuffLen ones are
+			// contiguous (the most recent first) starting at latestLevelIndex.
+			std::array<uint8_t, LevelsBuffLen * 2> levels;
+			size_t latestLevelIndex;
 		};
 
 	public:
@@ -71,6 +84,9 @@ namespace RTC
 		void ReceiveRtpPacket(RTC::Producer* producer, RTC::RtpPacket* packet) override;
 		void ProducerPaused(RTC::Producer* producer) override;
 		void ProducerResumed(RTC::Producer* producer) override;
+		void AddConsumer(RTC::Consumer* consumer, RTC::Producer* producer) override;
+		void RemoveConsumer(RTC::Consumer* consumer) override;
+		void ConsumerClosed(RTC::Consumer* consumer) override;
 
 	private:
 		void Paused() override;
@@ -78,6 +94,9 @@ namespace RTC
 		void Update();
 		bool CalculateActiveSpeaker();
 		void TimeoutIdleLevels(uint64_t now);
+		void UpdateLastN();
+		bool IsSpeakerForwarded(RTC::Producer* producer) const;
+		void SetConsumerForwarded(RTC::Consumer* consumer, bool forwarded);
 
 		/* Pure virtual methods inherited from Timer. */
 	protected:
@@ -86,11 +105,19 @@ namespace RTC
 	private:
 		static constexpr int relativeSpeachActivitiesLen{ 3 };
 		double relativeSpeachActivities[relativeSpeachActivitiesLen];
-		std::string dominantId{ "" };
+		RTC::Producer* dominantProducer{ nullptr };
 		Timer* periodicTimer{ nullptr };
 		uint16_t interval{ 300u };
-		absl::flat_hash_map<std::string, struct ProducerSpeaker> mapProducerSpeaker;
+		std::vector<Speaker> speakers;
+		// Index of the Speaker of each Producer in the speakers vector.
+		absl::flat_hash_map<RTC::Producer*, size_t> mapProducerSpeaker;
 		uint64_t lastLevelIdleTime{ 0 };
+		uint16_t lastN{ 0u };
+		bool lastNDowngrade{ false };
+		// Producers of the speakers, the most recent dominant one first.
+		std::vector<RTC::Producer*> recentProducers;
+		absl::flat_hash_set<RTC::Producer*> lastNProducers;
+		absl::flat_hash_map<RTC::Consumer*, RTC::Producer*> mapConsumerProducer;
 	};
 } // namespace RTC
 
@@ -5,6 +5,8 @@
 #include "handles/Timer.hpp"
 #include <absl/container/flat_hash_map.h>
 #include <nlohmann/json.hpp>
+#include <utility>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -34,6 +36,8 @@ namespace RTC
 		void Paused() override;
 		void Resumed() override;
 		void Update();
+		void AddLoudest(int8_t volume, RTC::Producer* producer);
+		void EmitBinaryVolumes();
 		void ResetMapProducerDBovs();
 
 		/* Pure virtual methods inherited from Timer. */
@@ -45,10 +49,15 @@ namespace RTC
 		uint16_t maxEntries{ 1u };
 		int8_t threshold{ -80 };
 		uint16_t interval{ 1000u };
+		bool binaryVolumes{ false };
 		// Allocated by this.
 		Timer* periodicTimer{ nullptr };
 		// Others.
 		absl::flat_hash_map<RTC::Producer*, DBovs> mapProducerDBovs;
+		// Loudest Producers in the last interval (a min-heap by volume of up to
+		// maxEntries entries).
+		std::vector<std::pair<int8_t, RTC::Producer*>> loudest;
+		std::vector<uint8_t> binaryVolumesBuffer;
 		bool silence{ true };
 	};
 } // namespace RTC
@@ -58,6 +58,10 @@ namespace RTC
 				void SyncRequired() override
 				{
 				}
+				EncodingContext* Clone() const override
+				{
+					return new EncodingContext(*this);
+				}
 			};
 
 		public:
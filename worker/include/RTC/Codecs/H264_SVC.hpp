@@ -69,6 +69,10 @@ namespace RTC
 				void SyncRequired() override
 				{
 				}
+				EncodingContext* Clone() const override
+				{
+					return new EncodingContext(*this);
+				}
 
 			public:
 				RTC::SeqManager<uint16_t> pictureIdManager;
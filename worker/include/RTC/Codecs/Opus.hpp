@@ -44,6 +44,10 @@ namespace RTC
 				{
 					this->syncRequired = true;
 				}
+				EncodingContext* Clone() const override
+				{
+					return new EncodingContext(*this);
+				}
 
 			public:
 				bool syncRequired{ false };
@@ -86,6 +86,8 @@ namespace RTC
 				this->ignoreDtx = ignoreDtx;
 			}
 			virtual void SyncRequired() = 0;
+			// Returns a new copy of this encoding context.
+			virtual EncodingContext* Clone() const = 0;
 
 		private:
 			Params params;
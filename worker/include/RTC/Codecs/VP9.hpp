@@ -111,6 +111,10 @@ namespace RTC
 				{
 					this->syncRequired = true;
 				}
+				EncodingContext* Clone() const override
+				{
+					return new EncodingContext(*this);
+				}
 
 			public:
 				RTC::SeqManager<uint16_t> pictureIdManager;
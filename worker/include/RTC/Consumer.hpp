@@ -15,6 +15,7 @@
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpStream.hpp"
 #include "RTC/RtpStreamSend.hpp"
+#include "RTC/SeqManager.hpp"
 #include <absl/container/flat_hash_set.h>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -39,6 +40,7 @@ namespace RTC
 			virtual void OnConsumerNeedBitrateChange(RTC::Consumer* consumer)                      = 0;
 			virtual void OnConsumerNeedZeroBitrate(RTC::Consumer* consumer)                        = 0;
 			virtual void OnConsumerProducerClosed(RTC::Consumer* consumer)                         = 0;
+			virtual void OnConsumerForwardedRtpStreamsChange(RTC::Consumer* consumer)              = 0;
 		};
 
 	public:
@@ -71,6 +73,15 @@ namespace RTC
 		virtual void FillJson(json& jsonObject) const;
 		virtual void FillJsonStats(json& jsonArray) const  = 0;
 		virtual void FillJsonScore(json& jsonObject) const = 0;
+		// RTP state to be given as rtpState to a Consumer with same RTP parameters
+		// continuing this one in another worker. Just Consumers sending a single
+		// RTP stream have it.
+		virtual void FillJsonRtpState(json& /*jsonObject*/) const
+		{
+		}
+		virtual void SetRtpState(json& /*data*/)
+		{
+		}
 		RTC::Media::Kind GetKind() const
 		{
 			return this->kind;
@@ -94,6 +105,10 @@ namespace RTC
 
 			return layers;
 		}
+		const std::vector<RTC::RtpEncodingParameters>& GetConsumableRtpEncodings() const
+		{
+			return this->consumableRtpEncodings;
+		}
 		const std::vector<uint32_t>& GetMediaSsrcs() const
 		{
 			return this->mediaSsrcs;
@@ -111,10 +126,72 @@ namespace RTC
 				this->transportConnected &&
 				!this->paused &&
 				!this->producerPaused &&
-				!this->producerClosed
+				!this->producerClosed &&
+				!this->lastNPaused
 			);
 			// clang-format on
 		}
+		// Whether packets of the given Producer stream are being dropped until a
+		// key frame is received.
+		virtual bool IsWaitingForKeyFrame(uint32_t /*mappedSsrc*/) const
+		{
+			return false;
+		}
+		// Whether packets of the given Producer stream may be forwarded given the
+		// current and target layers of the Consumer. Changes are notified via
+		// OnConsumerForwardedRtpStreamsChange().
+		virtual bool IsForwardingRtpStream(uint32_t /*mappedSsrc*/) const
+		{
+			return true;
+		}
+		// RTP rewrite groups. Consumers of the same Producer stream in the same
+		// layer state share the payload, sequence number and timestamp rewrite of
+		// a group leader and just do their own RTP stream and transport handling.
+		// By default Consumers never group.
+		//
+		// Whether this Consumer may lead a group.
+		virtual bool CanLeadRtpRewrite() const
+		{
+			return false;
+		}
+		// Whether this (grouped) Consumer still has the rewrite state of the leader.
+		virtual bool CanShareRtpRewrite(const RTC::Consumer* /*leader*/) const
+		{
+			return false;
+		}
+		// Whether this not yet started Consumer may join a group starting with the
+		// given packet.
+		virtual bool MayJoinRtpRewrite(const RTC::RtpPacket* /*packet*/) const
+		{
+			return false;
+		}
+		// Whether this not yet started Consumer may join the group of the leader
+		// starting with the given packet.
+		virtual bool CanJoinRtpRewrite(
+		  const RTC::Consumer* /*leader*/, const RTC::RtpPacket* /*packet*/) const
+		{
+			return false;
+		}
+		// Takes the rewrite state of the leader when leaving its group.
+		virtual void LeaveRtpRewrite(const RTC::Consumer* /*leader*/)
+		{
+		}
+		// Done by the leader. Returns false if the packet must not be sent.
+		virtual bool RewriteRtpPacket(RTC::RtpPacket* /*packet*/)
+		{
+			return false;
+		}
+		// Done by every Consumer in the group, leader included.
+		virtual void SendRewrittenRtpPacket(
+		  RTC::RtpPacket* /*packet*/,
+		  const RTC::Consumer* /*leader*/,
+		  RTC::RtpRetransmissionCache* /*retransmissionCache*/)
+		{
+		}
+		// Done by the leader once the packet has been sent by the whole group.
+		virtual void RestoreRtpPacket(RTC::RtpPacket* /*packet*/)
+		{
+		}
 		void TransportConnected();
 		void TransportDisconnected();
 		bool IsPaused() const
@@ -127,6 +204,22 @@ namespace RTC
 		}
 		void ProducerPaused();
 		void ProducerResumed();
+		bool IsLastNPaused() const
+		{
+			return this->lastNPaused;
+		}
+		// Called by the RtpObserver driving the last-N policy of this Consumer.
+		void SetLastNPaused(bool lastNPaused);
+		// Consumers with no layers to downgrade to are paused instead.
+		virtual void SetLastNDowngraded(bool lastNDowngraded)
+		{
+			SetLastNPaused(lastNDowngraded);
+		}
+		// Called while the worker is overloaded. Only Consumers with layers do
+		// something.
+		virtual void SetOverloadDowngraded(bool /*overloadDowngraded*/)
+		{
+		}
 		virtual void ProducerRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc)    = 0;
 		virtual void ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) = 0;
 		void ProducerRtpStreamScores(const std::vector<uint8_t>* scores);
@@ -142,7 +235,8 @@ namespace RTC
 		virtual uint32_t IncreaseLayer(uint32_t bitrate, bool considerLoss) = 0;
 		virtual void ApplyLayers()                                          = 0;
 		virtual uint32_t GetDesiredBitrate() const                          = 0;
-		virtual void SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket) = 0;
+		virtual void SendRtpPacket(
+		  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache) = 0;
 		virtual std::vector<RTC::RtpStreamSend*> GetRtpStreams() = 0;
 		virtual void GetRtcp(
 		  RTC::RTCP::CompoundPacket* packet, RTC::RtpStreamSend* rtpStream, uint64_t nowMs) = 0;
@@ -160,6 +254,12 @@ namespace RTC
 		void HandleRequest(Channel::ChannelRequest* request) override;
 
 	protected:
+		void FillJsonRtpStreamState(
+		  json& jsonObject,
+		  const RTC::RtpStreamSend* rtpStream,
+		  const RTC::SeqManager<uint16_t>& rtpSeqManager) const;
+		void SetRtpStreamState(
+		  json& data, RTC::RtpStreamSend* rtpStream, RTC::SeqManager<uint16_t>& rtpSeqManager);
 		void EmitTraceEventRtpAndKeyFrameTypes(RTC::RtpPacket* packet, bool isRtx = false) const;
 		void EmitTraceEventKeyFrameType(RTC::RtpPacket* packet, bool isRtx = false) const;
 		void EmitTraceEventPliType(uint32_t ssrc) const;
@@ -202,6 +302,7 @@ namespace RTC
 		bool paused{ false };
 		bool producerPaused{ false };
 		bool producerClosed{ false };
+		bool lastNPaused{ false };
 	};
 } // namespace RTC
 
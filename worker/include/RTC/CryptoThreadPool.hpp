@@ -0,0 +1,79 @@
+#ifndef MS_RTC_CRYPTO_THREAD_POOL_HPP
+#define MS_RTC_CRYPTO_THREAD_POOL_HPP
+
+#include "common.hpp"
+#include <uv.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+	// Threads running CPU expensive crypto operations (such as DTLS handshake
+	// steps) out of the libuv loop thread. Once a task has been run, it is
+	// handed back to the loop thread through an uv_async handle.
+	// NOTE: Use Close() instead of deleting it.
+	class CryptoThreadPool
+	{
+	public:
+		class Task
+		{
+		public:
+			virtual ~Task() = default;
+
+		public:
+			// Called within a thread of the pool.
+			// NOTE: It must not access anything owned by the loop thread other than
+			// the task itself. Logging is disabled within these threads.
+			virtual void OnCryptoTaskRun() = 0;
+			// Called within the loop thread once OnCryptoTaskRun() has returned.
+			virtual void OnCryptoTaskDone() = 0;
+		};
+
+	public:
+		explicit CryptoThreadPool(size_t numThreads);
+
+	private:
+		~CryptoThreadPool();
+
+	public:
+		// Deletes the pool once no cancelled task is being run and no task is
+		// being notified, so it can be called within OnCryptoTaskDone().
+		void Close();
+		void Push(Task* task);
+		// Removes the given task without waiting for it. Once this method returns,
+		// OnCryptoTaskDone() won't be called. Returns false if the task is being
+		// run, in which case the pool takes ownership of it and deletes it within
+		// the loop thread once run.
+		bool Cancel(Task* task);
+
+		/* Callbacks fired by UV events. */
+	public:
+		void OnUvAsync();
+
+	private:
+		void RunThread();
+		void MaybeDelete();
+
+	private:
+		// Allocated by this.
+		uv_async_t* uvHandle{ nullptr };
+		std::vector<std::thread> threads;
+		// Others.
+		std::mutex mutex;
+		std::condition_variable pendingCondition;
+		std::deque<Task*> pendingTasks;
+		std::vector<Task*> runningTasks;
+		std::deque<Task*> doneTasks;
+		// Tasks cancelled while being run, owned by the pool.
+		std::vector<Task*> cancelledTasks;
+		bool closed{ false };
+		// Just accessed within the loop thread.
+		bool closing{ false };
+		bool notifying{ false };
+	};
+} // namespace RTC
+
+#endif
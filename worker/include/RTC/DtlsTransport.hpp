@@ -2,12 +2,14 @@
 #define MS_RTC_DTLS_TRANSPORT_HPP
 
 #include "common.hpp"
+#include "RTC/CryptoThreadPool.hpp"
 #include "RTC/SrtpSession.hpp"
 #include "handles/Timer.hpp"
 #include <openssl/bio.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 #include <absl/container/flat_hash_map.h>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -59,6 +61,42 @@ namespace RTC
 			const char* name;
 		};
 
+	public:
+		// DTLS handshake step run within the crypto thread pool. While being run
+		// it just accesses the SSL, so the DtlsTransport can be closed meanwhile.
+		// In that case the task takes ownership of the SSL.
+		class HandshakeTask : public RTC::CryptoThreadPool::Task
+		{
+		public:
+			explicit HandshakeTask(DtlsTransport* dtlsTransport) : dtlsTransport(dtlsTransport)
+			{
+			}
+			~HandshakeTask() override;
+
+			/* Pure virtual methods inherited from RTC::CryptoThreadPool::Task. */
+		public:
+			void OnCryptoTaskRun() override;
+			void OnCryptoTaskDone() override;
+
+		public:
+			// Passed by argument.
+			DtlsTransport* dtlsTransport{ nullptr };
+			// Others.
+			SSL* ssl{ nullptr };
+			BIO* sslBioFromNetwork{ nullptr };
+			bool running{ false };
+			bool ownsSsl{ false };
+			// Received DTLS data to be processed.
+			std::vector<uint8_t> data;
+			// Results of processing it.
+			int written{ 0 };
+			int read{ 0 };
+			int sslError{ SSL_ERROR_NONE };
+			unsigned long opensslError{ 0u };
+			bool handshakeDoneNow{ false };
+			std::vector<uint8_t> readData;
+		};
+
 	public:
 		class Listener
 		{
@@ -149,6 +187,8 @@ namespace RTC
 		static absl::flat_hash_map<FingerprintAlgorithm, std::string> fingerprintAlgorithm2String;
 		thread_local static std::vector<Fingerprint> localFingerprints;
 		static std::vector<SrtpCryptoSuiteMapEntry> srtpCryptoSuites;
+		thread_local static RTC::CryptoThreadPool* cryptoThreadPool;
+		thread_local static size_t numInstances;
 
 	public:
 		explicit DtlsTransport(Listener* listener);
@@ -157,6 +197,7 @@ namespace RTC
 	public:
 		void Dump() const;
 		void Run(Role localRole);
+		void SetConnected(Role localRole);
 		std::vector<Fingerprint>& GetLocalFingerprints() const
 		{
 			return DtlsTransport::localFingerprints;
@@ -172,6 +213,10 @@ namespace RTC
 			return this->localRole;
 		}
 		void SendApplicationData(const uint8_t* data, size_t len);
+		bool GetSrtpKeys(
+		  RTC::SrtpSession::CryptoSuite srtpCryptoSuite,
+		  uint8_t* srtpLocalMasterKey,
+		  uint8_t* srtpRemoteMasterKey) const;
 
 	private:
 		bool IsRunning() const
@@ -191,8 +236,17 @@ namespace RTC
 			// Make GCC 4.9 happy.
 			return false;
 		}
+		bool CreateSsl();
 		void Reset();
 		bool CheckStatus(int returnCode);
+		bool CheckSslError(int err);
+		void ProcessSslRead(int read, int sslError, const uint8_t* readData);
+		bool IsHandshakeTaskRunning() const
+		{
+			return this->handshakeTask && this->handshakeTask->running;
+		}
+		void CancelHandshakeTask();
+		void OnHandshakeTaskDone();
 		void SendPendingOutgoingDtlsData();
 		bool SetTimeout();
 		bool ProcessHandshake();
@@ -216,13 +270,18 @@ namespace RTC
 		BIO* sslBioFromNetwork{ nullptr }; // The BIO from which ssl reads.
 		BIO* sslBioToNetwork{ nullptr };   // The BIO in which ssl writes.
 		Timer* timer{ nullptr };
+		HandshakeTask* handshakeTask{ nullptr };
 		// Others.
 		DtlsState state{ DtlsState::NEW };
 		Role localRole{ Role::NONE };
 		Fingerprint remoteFingerprint;
 		bool handshakeDone{ false };
 		bool handshakeDoneNow{ false };
+		// Whether SRTP keys were imported (no DTLS association).
+		bool imported{ false };
 		std::string remoteCert;
+		// DTLS data received while a handshake task is running.
+		std::deque<std::vector<uint8_t>> pendingDtlsData;
 	};
 } // namespace RTC
 
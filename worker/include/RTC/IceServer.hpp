@@ -2,6 +2,7 @@
 #define MS_RTC_ICE_SERVER_HPP
 
 #include "common.hpp"
+#include "Utils.hpp"
 #include "RTC/StunPacket.hpp"
 #include "RTC/TransportTuple.hpp"
 #include <list>
@@ -82,6 +83,9 @@ namespace RTC
 			this->oldPassword = this->password;
 			this->password    = password;
 
+			this->oldHmacSha1.SetKey(this->oldPassword);
+			this->hmacSha1.SetKey(this->password);
+
 			this->remoteNomination = 0u;
 
 			// Notify the listener.
@@ -96,6 +100,10 @@ namespace RTC
 		// This should be just called in 'connected' or completed' state
 		// and the given tuple must be an already valid tuple.
 		void ForceSelectedTuple(const RTC::TransportTuple* tuple);
+		// Restores the given tuple and state (taken from another IceServer with
+		// same credentials) without running ICE. This should be just called in
+		// 'new' state. No state change is notified to the listener.
+		void ImportSelectedTuple(RTC::TransportTuple* tuple, IceState state);
 
 	private:
 		void HandleTuple(
@@ -122,6 +130,9 @@ namespace RTC
 		std::string password;
 		std::string oldUsernameFragment;
 		std::string oldPassword;
+		// HMAC-SHA1 calculators keyed with current and old passwords.
+		Utils::Crypto::HmacSha1 hmacSha1;
+		Utils::Crypto::HmacSha1 oldHmacSha1;
 		uint32_t remoteNomination{ 0u };
 		IceState state{ IceState::NEW };
 		std::list<RTC::TransportTuple> tuples;
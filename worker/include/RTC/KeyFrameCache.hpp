@@ -0,0 +1,49 @@
+#ifndef MS_RTC_KEY_FRAME_CACHE_HPP
+#define MS_RTC_KEY_FRAME_CACHE_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <vector>
+
+namespace RTC
+{
+	// Latest key frame of a Producer RTP stream and the packets received after
+	// it, so Consumers waiting for a key frame can be served with them right
+	// away instead of requesting a new key frame to the endpoint.
+	//
+	// The cache is discarded (until the next key frame is received) once the
+	// stored packets exceed the given size or the key frame gets too old, since
+	// all the packets following a key frame are needed to decode it.
+	class KeyFrameCache
+	{
+	public:
+		explicit KeyFrameCache(size_t maxSize);
+		~KeyFrameCache();
+
+	public:
+		void ReceivePacket(const RTC::RtpPacket* packet);
+		bool HasKeyFrame() const;
+		const std::vector<RTC::RtpPacket*>& GetPackets() const
+		{
+			return this->packets;
+		}
+		size_t GetSize() const
+		{
+			return this->size;
+		}
+		void Clear();
+
+	private:
+		// Passed by argument.
+		size_t maxSize{ 0u };
+		// Allocated by this.
+		std::vector<RTC::RtpPacket*> packets;
+		// Others.
+		size_t size{ 0u };
+		uint16_t keyFrameSeq{ 0u };
+		uint32_t keyFrameTimestamp{ 0u };
+		uint64_t keyFrameReceivedAtMs{ 0u };
+	};
+} // namespace RTC
+
+#endif
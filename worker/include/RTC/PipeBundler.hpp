@@ -0,0 +1,105 @@
+#ifndef MS_RTC_PIPE_BUNDLER_HPP
+#define MS_RTC_PIPE_BUNDLER_HPP
+
+#include "common.hpp"
+#include "Utils.hpp"
+#include "handles/Timer.hpp"
+#include <vector>
+
+namespace RTC
+{
+	// Bundles RTP and RTCP packets sent through a PipeTransport into a single
+	// datagram so the number of datagrams (and SRTP operations and syscalls)
+	// on the link is reduced. The bundle is sent once full or once the given
+	// max delay expires since its first packet was added.
+	//
+	// A bundle is a RTP packet with a reserved SSRC and payload type whose
+	// payload is a sequence of [2 bytes length][packet] entries, so SRTP can
+	// protect it as any other RTP packet. A bundle with a single packet is sent
+	// as that packet.
+	class PipeBundler : public Timer::Listener
+	{
+	public:
+		using onSendCallback = const std::function<void(bool sent)>;
+
+	public:
+		class Listener
+		{
+		public:
+			virtual ~Listener() = default;
+
+		public:
+			/**
+			 * The given data is only valid within this call. The listener takes
+			 * the ownership of cb.
+			 */
+			virtual void OnPipeBundlerSend(
+			  RTC::PipeBundler* pipeBundler, const uint8_t* data, size_t len, onSendCallback* cb) = 0;
+		};
+
+	public:
+		static constexpr uint32_t BundleSsrc{ 0x4D534244u }; // "MSBD".
+		static constexpr uint8_t BundlePayloadType{ 127u };
+		// It leaves room for IPv6 and UDP headers plus the SRTP tag in a 1500
+		// bytes MTU.
+		static constexpr size_t MaxBundleSize{ 1400u };
+		static constexpr size_t HeaderSize{ 12u };
+		static constexpr size_t EntryHeaderSize{ 2u };
+		static constexpr size_t MaxPacketSize{ MaxBundleSize - HeaderSize - EntryHeaderSize };
+
+	public:
+		static bool IsBundle(const uint8_t* data, size_t len)
+		{
+			// clang-format off
+			return (
+				len > HeaderSize &&
+				(data[0] >> 6) == 2u &&
+				(data[1] & 0x7F) == BundlePayloadType &&
+				Utils::Byte::Get4Bytes(data, 8) == BundleSsrc
+			);
+			// clang-format on
+		}
+		/**
+		 * Calls fn with every packet in the given bundle. It returns false if the
+		 * bundle is malformed (packets before the malformed entry are given).
+		 */
+		static bool Unbundle(
+		  const uint8_t* data, size_t len, const std::function<void(const uint8_t*, size_t)>& fn);
+
+	public:
+		PipeBundler(Listener* listener, uint64_t maxDelay);
+		~PipeBundler() override;
+
+	public:
+		/**
+		 * Adds the given packet to the current bundle (and takes the ownership of
+		 * cb). It returns false if the packet is too big to be bundled, in which
+		 * case the current bundle has been sent and the caller must send the
+		 * packet by itself.
+		 */
+		bool Add(const uint8_t* data, size_t len, onSendCallback* cb);
+		void Flush();
+
+	private:
+		void Send();
+
+		/* Pure virtual methods inherited from Timer::Listener. */
+	public:
+		void OnTimer(Timer* timer) override;
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		uint64_t maxDelay{ 0u };
+		// Allocated by this.
+		Timer* timer{ nullptr };
+		// Others.
+		uint8_t buffer[MaxBundleSize];
+		size_t size{ HeaderSize };
+		size_t numPackets{ 0u };
+		uint16_t seq{ 0u };
+		std::vector<onSendCallback*> callbacks;
+	};
+} // namespace RTC
+
+#endif
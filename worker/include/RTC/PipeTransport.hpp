@@ -1,6 +1,7 @@
 #ifndef MS_RTC_PIPE_TRANSPORT_HPP
 #define MS_RTC_PIPE_TRANSPORT_HPP
 
+#include "RTC/PipeBundler.hpp"
 #include "RTC/SrtpSession.hpp"
 #include "RTC/Transport.hpp"
 #include "RTC/TransportTuple.hpp"
@@ -8,7 +9,9 @@
 
 namespace RTC
 {
-	class PipeTransport : public RTC::Transport, public RTC::UdpSocket::Listener
+	class PipeTransport : public RTC::Transport,
+	                      public RTC::UdpSocket::Listener,
+	                      public RTC::PipeBundler::Listener
 	{
 	private:
 		struct ListenIp
@@ -60,18 +63,30 @@ namespace RTC
 		void OnRtpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnRtcpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnSctpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void OnBundleReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void HandleRtpData(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void HandleRtcpData(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 
 		/* Pure virtual methods inherited from RTC::UdpSocket::Listener. */
 	public:
 		void OnUdpSocketPacketReceived(
 		  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) override;
 
+		/* Pure virtual methods inherited from RTC::PipeBundler::Listener. */
+	public:
+		void OnPipeBundlerSend(
+		  RTC::PipeBundler* pipeBundler,
+		  const uint8_t* data,
+		  size_t len,
+		  RTC::PipeBundler::onSendCallback* cb) override;
+
 	private:
 		// Allocated by this.
 		RTC::UdpSocket* udpSocket{ nullptr };
 		RTC::TransportTuple* tuple{ nullptr };
 		RTC::SrtpSession* srtpRecvSession{ nullptr };
 		RTC::SrtpSession* srtpSendSession{ nullptr };
+		RTC::PipeBundler* bundler{ nullptr };
 		// Others.
 		ListenIp listenIp;
 		struct sockaddr_storage remoteAddrStorage;
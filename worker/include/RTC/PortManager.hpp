@@ -3,6 +3,7 @@
 
 #include "common.hpp"
 #include "Settings.hpp"
+#include "handles/Timer.hpp"
 #include <uv.h>
 #include <absl/container/flat_hash_map.h>
 #include <nlohmann/json.hpp>
@@ -20,14 +21,73 @@ namespace RTC
 			TCP
 		};
 
-	public:
-		static uv_udp_t* BindUdp(std::string& ip)
+	private:
+		// Ports of an IP. Free ones are kept in a vector so a random one can be
+		// picked, taken and given back in O(1).
+		class Ports
 		{
-			return reinterpret_cast<uv_udp_t*>(Bind(Transport::UDP, ip));
-		}
-		static uv_udp_t* BindUdp(std::string& ip, uint16_t port)
+		public:
+			explicit Ports(size_t numPorts);
+
+		public:
+			size_t GetNumPorts() const
+			{
+				return this->positions.size();
+			}
+			size_t GetNumFree() const
+			{
+				return this->freePortIdxs.size();
+			}
+			bool IsUsed(size_t portIdx) const
+			{
+				return this->positions[portIdx] == UsedPosition;
+			}
+			size_t GetRandomFree() const;
+			void SetUsed(size_t portIdx);
+			void SetFree(size_t portIdx);
+
+		private:
+			static constexpr uint32_t UsedPosition{ UINT32_MAX };
+
+		private:
+			std::vector<uint16_t> freePortIdxs;
+			// Position of each port in freePortIdxs (UsedPosition if used).
+			std::vector<uint32_t> positions;
+		};
+
+	private:
+		// UDP sockets bound in advance in an IP so they are ready when a transport
+		// needs them. The pool is refilled on next loop iteration after a socket
+		// is taken.
+		class UdpSocketPool : public Timer::Listener
+		{
+		public:
+			UdpSocketPool(const std::string& ip, size_t size);
+			~UdpSocketPool() override;
+
+		public:
+			uv_udp_t* Take();
+
+			/* Pure virtual methods inherited from Timer::Listener. */
+		public:
+			void OnTimer(Timer* timer) override;
+
+		private:
+			// Passed by argument.
+			std::string ip;
+			size_t size{ 0u };
+			// Allocated by this.
+			Timer* timer{ nullptr };
+			std::vector<uv_udp_t*> uvHandles;
+		};
+
+	public:
+		static uv_udp_t* BindUdp(std::string& ip);
+		// If reusePort is set, the socket is bound with SO_REUSEPORT so other
+		// sockets can also bind the same IP and port.
+		static uv_udp_t* BindUdp(std::string& ip, uint16_t port, bool reusePort = false)
 		{
-			return reinterpret_cast<uv_udp_t*>(Bind(Transport::UDP, ip, port));
+			return reinterpret_cast<uv_udp_t*>(Bind(Transport::UDP, ip, port, reusePort));
 		}
 		static uv_tcp_t* BindTcp(std::string& ip)
 		{
@@ -45,17 +105,20 @@ namespace RTC
 		{
 			return Unbind(Transport::TCP, ip, port);
 		}
+		static void CloseUdpSocketPools();
 		static void FillJson(json& jsonObject);
 
 	private:
 		static uv_handle_t* Bind(Transport transport, std::string& ip);
-		static uv_handle_t* Bind(Transport transport, std::string& ip, uint16_t port);
+		static uv_handle_t* Bind(
+		  Transport transport, std::string& ip, uint16_t port, bool reusePort = false);
 		static void Unbind(Transport transport, std::string& ip, uint16_t port);
-		static std::vector<bool>& GetPorts(Transport transport, const std::string& ip);
+		static Ports& GetPorts(Transport transport, const std::string& ip);
 
 	private:
-		thread_local static absl::flat_hash_map<std::string, std::vector<bool>> mapUdpIpPorts;
-		thread_local static absl::flat_hash_map<std::string, std::vector<bool>> mapTcpIpPorts;
+		thread_local static absl::flat_hash_map<std::string, Ports> mapUdpIpPorts;
+		thread_local static absl::flat_hash_map<std::string, Ports> mapTcpIpPorts;
+		thread_local static absl::flat_hash_map<std::string, UdpSocketPool*> mapUdpIpSocketPools;
 	};
 } // namespace RTC
 
@@ -4,6 +4,7 @@
 #include "common.hpp"
 #include "Channel/ChannelRequest.hpp"
 #include "Channel/ChannelSocket.hpp"
+#include "RTC/KeyFrameCache.hpp"
 #include "RTC/KeyFrameRequestManager.hpp"
 #include "RTC/RTCP/CompoundPacket.hpp"
 #include "RTC/RTCP/Packet.hpp"
@@ -12,6 +13,7 @@
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpHeaderExtensionIds.hpp"
 #include "RTC/RtpPacket.hpp"
+#include "RTC/RtpRetransmissionCache.hpp"
 #include "RTC/RtpStreamRecv.hpp"
 #include <nlohmann/json.hpp>
 #include <string>
@@ -94,6 +96,7 @@ namespace RTC
 	public:
 		void FillJson(json& jsonObject) const;
 		void FillJsonStats(json& jsonArray) const;
+		void FillJsonRtpState(json& jsonArray) const;
 		RTC::Media::Kind GetKind() const
 		{
 			return this->kind;
@@ -122,6 +125,24 @@ namespace RTC
 		{
 			return std::addressof(this->rtpStreamScores);
 		}
+		RTC::RtpRetransmissionCache* GetRtpRetransmissionCache(uint32_t mappedSsrc) const
+		{
+			auto it = this->mapMappedSsrcRetransmissionCache.find(mappedSsrc);
+
+			if (it == this->mapMappedSsrcRetransmissionCache.end())
+				return nullptr;
+
+			return it->second;
+		}
+		RTC::KeyFrameCache* GetKeyFrameCache(uint32_t mappedSsrc) const
+		{
+			auto it = this->mapMappedSsrcKeyFrameCache.find(mappedSsrc);
+
+			if (it == this->mapMappedSsrcKeyFrameCache.end())
+				return nullptr;
+
+			return it->second;
+		}
 		ReceiveRtpPacketResult ReceiveRtpPacket(RTC::RtpPacket* packet);
 		void ReceiveRtcpSenderReport(RTC::RTCP::SenderReport* report);
 		void ReceiveRtcpXrDelaySinceLastRr(RTC::RTCP::DelaySinceLastRr::SsrcInfo* ssrcInfo);
@@ -168,6 +189,8 @@ namespace RTC
 		// Allocated by this.
 		absl::flat_hash_map<uint32_t, RTC::RtpStreamRecv*> mapSsrcRtpStream;
 		RTC::KeyFrameRequestManager* keyFrameRequestManager{ nullptr };
+		absl::flat_hash_map<uint32_t, RTC::RtpRetransmissionCache*> mapMappedSsrcRetransmissionCache;
+		absl::flat_hash_map<uint32_t, RTC::KeyFrameCache*> mapMappedSsrcKeyFrameCache;
 		// Others.
 		RTC::Media::Kind kind;
 		RTC::RtpParameters rtpParameters;
@@ -178,8 +201,12 @@ namespace RTC
 		absl::flat_hash_map<uint32_t, RTC::RtpStreamRecv*> mapRtxSsrcRtpStream;
 		absl::flat_hash_map<RTC::RtpStreamRecv*, uint32_t> mapRtpStreamMappedSsrc;
 		absl::flat_hash_map<uint32_t, uint32_t> mapMappedSsrcSsrc;
+		// Imported sequence state of RTP streams not created yet, indexed by SSRC.
+		absl::flat_hash_map<uint32_t, RTC::RtpStream::SeqState> mapSsrcImportedSeqState;
 		struct RTC::RtpHeaderExtensionIds rtpHeaderExtensionIds;
 		bool paused{ false };
+		// Max size (in bytes) of each key frame cache. 0 means disabled.
+		size_t keyFrameCacheMaxSize{ 0u };
 		RTC::RtpPacket* currentRtpPacket{ nullptr };
 		// Timestamp when last RTCP was sent.
 		uint64_t lastRtcpSentTime{ 0u };
@@ -14,10 +14,13 @@
 #include "RTC/RtpStream.hpp"
 #include "RTC/Transport.hpp"
 #include "RTC/WebRtcServer.hpp"
+#include "handles/FdImporter.hpp"
 #include <absl/container/flat_hash_map.h>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -39,12 +42,69 @@ namespace RTC
 			  RTC::Router* router, std::string& webRtcServerId) = 0;
 		};
 
+	private:
+		// Consumers forwarding a Producer RTP stream, stored contiguously so the
+		// fan-out of a packet walks an array rather than a hash set.
+		//
+		// Consumers are grouped so those sharing the RTP rewrite of a leader are
+		// contiguous, the leader first and not yet started Consumers joining the
+		// group last.
+		class RtpStreamConsumers
+		{
+		public:
+			void Add(RTC::Consumer* consumer);
+			void Remove(RTC::Consumer* consumer);
+			// Called before sending the packet to the Consumers. Splits those that
+			// can no longer share the RTP rewrite of their group and, on key frames,
+			// lets not yet started Consumers join a group.
+			void UpdateGroups(const RTC::RtpPacket* packet);
+			// Splits the Consumer from its group if it can no longer share its RTP
+			// rewrite, so it can send packets by itself.
+			void UpdateGroup(RTC::Consumer* consumer);
+			bool IsEmpty() const
+			{
+				return this->consumers.empty();
+			}
+
+		private:
+			void JoinGroups(const RTC::RtpPacket* packet);
+
+		public:
+			std::vector<RTC::Consumer*> consumers;
+			// Size of every group, in the order of consumers.
+			std::vector<size_t> groupSizes;
+
+		private:
+			// Reused to not allocate while regrouping.
+			std::vector<RTC::Consumer*> regroupedConsumers;
+			std::vector<size_t> regroupedGroupSizes;
+			std::vector<RTC::Consumer*> splitConsumers;
+			std::vector<size_t> groupStarts;
+			std::vector<size_t> joinedGroups;
+		};
+
+	private:
+		// Keeps the Router and its Transports handling a bulk request during its
+		// lifetime, so they get out of it even if an exception is thrown.
+		class BulkRequestGuard
+		{
+		public:
+			explicit BulkRequestGuard(RTC::Router* router);
+			~BulkRequestGuard();
+
+		private:
+			RTC::Router* router{ nullptr };
+		};
+
 	public:
 		explicit Router(const std::string& id, Listener* listener);
 		virtual ~Router();
 
 	public:
 		void FillJson(json& jsonObject) const;
+		// Called by the Worker when its OverloadController (un)applies the layers
+		// degradation step.
+		void SetOverloadDowngraded(bool overloadDowngraded);
 
 		/* Methods inherited from Channel::ChannelSocket::RequestHandler. */
 	public:
@@ -64,6 +124,12 @@ namespace RTC
 		void SetNewRtpObserverIdFromInternal(json& internal, std::string& rtpObserverId) const;
 		RTC::RtpObserver* GetRtpObserverFromInternal(json& internal) const;
 		RTC::Producer* GetProducerFromData(json& data) const;
+		RTC::Consumer* GetConsumerFromData(json& data) const;
+		json HandleBulkRequestItem(uint32_t id, json& jsonRequest);
+		bool SendCachedKeyFrame(RTC::Consumer* consumer, RTC::Producer* producer, uint32_t mappedSsrc);
+		void RequestPendingKeyFrames();
+		void UpdateConsumerForwardedRtpStreams(RTC::Consumer* consumer);
+		void UpdatePendingForwardedRtpStreamsConsumers();
 
 		/* Pure virtual methods inherited from RTC::Transport::Listener. */
 	public:
@@ -97,6 +163,8 @@ namespace RTC
 		void OnTransportConsumerProducerClosed(RTC::Transport* transport, RTC::Consumer* consumer) override;
 		void OnTransportConsumerKeyFrameRequested(
 		  RTC::Transport* transport, RTC::Consumer* consumer, uint32_t mappedSsrc) override;
+		void OnTransportConsumerForwardedRtpStreamsChange(
+		  RTC::Transport* transport, RTC::Consumer* consumer) override;
 		void OnTransportNewDataProducer(RTC::Transport* transport, RTC::DataProducer* dataProducer) override;
 		void OnTransportDataProducerClosed(RTC::Transport* transport, RTC::DataProducer* dataProducer) override;
 		void OnTransportDataProducerMessageReceived(
@@ -121,15 +189,32 @@ namespace RTC
 		// Allocated by this.
 		absl::flat_hash_map<std::string, RTC::Transport*> mapTransports;
 		absl::flat_hash_map<std::string, RTC::RtpObserver*> mapRtpObservers;
+		// FdImporters waiting for the UDP sockets of an exported WebRtcTransport,
+		// indexed by socket path.
+		absl::flat_hash_map<std::string, FdImporter*> mapFdImporters;
 		// Others.
 		absl::flat_hash_map<RTC::Producer*, absl::flat_hash_set<RTC::Consumer*>> mapProducerConsumers;
+		// Consumers of each Producer grouped by the Producer RTP stream (mapped
+		// SSRC) whose packets they forward given their current layers.
+		absl::flat_hash_map<RTC::Producer*, absl::flat_hash_map<uint32_t, RtpStreamConsumers>>
+		  mapProducerMappedSsrcConsumers;
 		absl::flat_hash_map<RTC::Consumer*, RTC::Producer*> mapConsumerProducer;
+		absl::flat_hash_map<std::string, RTC::Consumer*> mapConsumers;
 		absl::flat_hash_map<RTC::Producer*, absl::flat_hash_set<RTC::RtpObserver*>> mapProducerRtpObservers;
+		absl::flat_hash_map<RTC::Consumer*, RTC::RtpObserver*> mapConsumerRtpObserver;
 		absl::flat_hash_map<std::string, RTC::Producer*> mapProducers;
 		absl::flat_hash_map<RTC::DataProducer*, absl::flat_hash_set<RTC::DataConsumer*>>
 		  mapDataProducerDataConsumers;
 		absl::flat_hash_map<RTC::DataConsumer*, RTC::DataProducer*> mapDataConsumerDataProducer;
 		absl::flat_hash_map<std::string, RTC::DataProducer*> mapDataProducers;
+		// Whether RTP packets are being provided to Consumers right now.
+		bool sendingRtpPackets{ false };
+		// Consumers whose forwarded RTP streams changed while sending RTP packets.
+		std::vector<RTC::Consumer*> pendingForwardedRtpStreamsConsumers;
+		// Whether a bulk request is being handled right now.
+		bool handlingBulkRequest{ false };
+		// Key frames requested by Consumers while handling a bulk request.
+		std::vector<std::pair<RTC::Consumer*, uint32_t>> pendingKeyFrameRequests;
 	};
 } // namespace RTC
 
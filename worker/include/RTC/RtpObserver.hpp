@@ -2,6 +2,7 @@
 #define MS_RTC_RTP_PACKET_OBSERVER_HPP
 
 #include "common.hpp"
+#include "RTC/Consumer.hpp"
 #include "RTC/Producer.hpp"
 #include "RTC/RtpPacket.hpp"
 #include <string>
@@ -26,6 +27,12 @@ namespace RTC
 		virtual void ReceiveRtpPacket(RTC::Producer* producer, RTC::RtpPacket* packet) = 0;
 		virtual void ProducerPaused(RTC::Producer* producer)                           = 0;
 		virtual void ProducerResumed(RTC::Producer* producer)                          = 0;
+		// Attach a Consumer whose forwarding is driven by the given Producer.
+		virtual void AddConsumer(RTC::Consumer* consumer, RTC::Producer* producer);
+		// Detach a Consumer so it is forwarded normally again.
+		virtual void RemoveConsumer(RTC::Consumer* consumer);
+		// Forget a Consumer which is being closed.
+		virtual void ConsumerClosed(RTC::Consumer* consumer);
 
 	protected:
 		virtual void Paused()  = 0;
@@ -591,6 +591,10 @@ namespace RTC
 
 		RtpPacket* Clone() const;
 
+		RtpPacket* Clone(uint8_t* buffer) const;
+
+		void CopyFrom(const RtpPacket* packet);
+
 		void RtxEncode(uint8_t payloadType, uint32_t ssrc, uint16_t seq);
 
 		bool RtxDecode(uint8_t payloadType, uint32_t ssrc);
@@ -0,0 +1,62 @@
+#ifndef MS_RTC_RTP_RED_ENCODER_HPP
+#define MS_RTC_RTP_RED_ENCODER_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <array>
+
+namespace RTC
+{
+	// Wraps the RTP packets of a stream into RED packets (RFC 2198)
+	// carrying, besides the current (primary) frame, up to `distance` previous
+	// frames, so the remote endpoint can recover from packet losses without
+	// waiting for retransmissions. With a zero distance packets are just
+	// wrapped (as needed for video packets protected by ULPFEC).
+	//
+	// Given packets are not modified (they are shared by all the Consumers of
+	// the Producer). The RED packet is written into a buffer owned by this and
+	// it is valid until the next call to Encode().
+	class RtpRedEncoder
+	{
+	public:
+		static constexpr size_t MaxDistance{ 2u };
+
+	private:
+		// Max length of a redundant block (10 bits in the RED block header).
+		static constexpr size_t MaxFrameLength{ 1023u };
+
+	private:
+		struct Frame
+		{
+			uint32_t timestamp{ 0u };
+			size_t length{ 0u };
+			uint8_t data[MaxFrameLength];
+		};
+
+	public:
+		RtpRedEncoder(uint8_t payloadType, size_t distance);
+		~RtpRedEncoder();
+
+	public:
+		RTC::RtpPacket* Encode(const RTC::RtpPacket* packet);
+		void Reset();
+
+	private:
+		void StoreFrame(const RTC::RtpPacket* packet);
+
+	private:
+		// Passed by argument.
+		uint8_t payloadType{ 0u };
+		size_t distance{ 0u };
+		// Allocated by this.
+		RTC::RtpPacket* redPacket{ nullptr };
+		// Others.
+		// Previous frames, used as a ring buffer of `distance` entries.
+		std::array<Frame, MaxDistance> frames;
+		size_t numFrames{ 0u };
+		size_t nextFrameIdx{ 0u };
+		uint8_t buffer[RTC::MtuSize + 100];
+	};
+} // namespace RTC
+
+#endif
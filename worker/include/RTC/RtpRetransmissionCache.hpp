@@ -0,0 +1,117 @@
+#ifndef MS_RTC_RTP_RETRANSMISSION_CACHE_HPP
+#define MS_RTC_RTP_RETRANSMISSION_CACHE_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <deque>
+#include <limits>
+#include <vector>
+
+namespace RTC
+{
+	// Recent RTP packets of a Producer RTP stream addressable by their original
+	// sequence number. A single instance is shared by all the RtpStreamSend
+	// instances fed by the same Producer RTP stream, so each packet is cloned
+	// and stored once regardless of the number of Consumers. Each RtpStreamSend
+	// just keeps a small entry mapping its own sequence number to the one in
+	// here.
+	//
+	// Packets are kept as long as the largest retransmission buffer size (which
+	// depends on the RTT) among the RtpStreamSend instances storing them.
+	//
+	// Memory used by all the instances in the worker is limited by the
+	// `retransmissionBufferMaxMemory` setting. Once exceeded, the oldest
+	// packets (those less likely to be NACKed) are evicted first, regardless
+	// of the stream they belong to. Instances are kept in a worker-wide min-heap
+	// ordered by the time their first packet was stored, so the oldest packet
+	// is found in constant time.
+	class RtpRetransmissionCache
+	{
+	private:
+		struct Item
+		{
+			std::shared_ptr<RTC::RtpPacket> packet{ nullptr };
+			// Original timestamp of the packet.
+			uint32_t timestamp{ 0u };
+			// Time when the packet was stored.
+			uint64_t storedAtMs{ 0u };
+		};
+
+	public:
+		static size_t GetTotalMemory()
+		{
+			return RtpRetransmissionCache::totalMemory;
+		}
+		static uint64_t GetEvictedPacketCount()
+		{
+			return RtpRetransmissionCache::evictedPacketCount;
+		}
+
+	private:
+		static bool EvictOldestPacket();
+		static void HeapSwap(size_t idx1, size_t idx2);
+
+	private:
+		// Min-heap of instances by the time their first packet was stored.
+		thread_local static std::vector<RtpRetransmissionCache*> heap;
+		thread_local static size_t totalMemory;
+		thread_local static uint64_t evictedPacketCount;
+
+	public:
+		explicit RtpRetransmissionCache(uint32_t clockRate);
+		~RtpRetransmissionCache();
+
+	public:
+		void SetCurrentPacket(const RTC::RtpPacket* packet);
+		uint16_t StoreCurrentPacket(const RTC::RtpPacket* packet, uint32_t retransmissionBufferSize);
+		RTC::RtpPacket* Get(uint16_t seq) const;
+		size_t GetBufferSize() const
+		{
+			return this->buffer.size();
+		}
+		size_t GetPacketCount() const
+		{
+			return this->packetCount;
+		}
+		size_t GetMemory() const
+		{
+			return this->memory;
+		}
+		void Clear();
+
+	private:
+		void Insert(
+		  uint16_t seq, uint32_t timestamp, uint64_t nowMs, std::shared_ptr<RTC::RtpPacket>& packet);
+		void ClearOldPackets(uint32_t timestamp, uint32_t retransmissionBufferSize);
+		void RemoveFirst();
+		uint64_t GetFirstStoredAtMs() const
+		{
+			return this->buffer.empty() ? std::numeric_limits<uint64_t>::max()
+			                            : this->buffer.front().storedAtMs;
+		}
+		void UpdateHeapPosition();
+
+	private:
+		// Passed by argument.
+		uint32_t clockRate{ 0u };
+		// Others.
+		size_t heapIndex{ 0u };
+		uint16_t startSeq{ 0u };
+		std::deque<Item> buffer;
+		size_t packetCount{ 0u };
+		// Memory used by the stored packets (in bytes).
+		size_t memory{ 0u };
+		// Original sequence number and timestamp of the packet being currently
+		// forwarded to the Consumers.
+		uint16_t currentSeq{ 0u };
+		uint32_t currentTimestamp{ 0u };
+		bool hasCurrentPacket{ false };
+		bool currentPacketStored{ false };
+		// Largest retransmission buffer size (ms) of the RtpStreamSend instances
+		// that stored the previous packet and the current one.
+		uint32_t retransmissionBufferSize{ 0u };
+		uint32_t currentRetransmissionBufferSize{ 0u };
+	};
+} // namespace RTC
+
+#endif
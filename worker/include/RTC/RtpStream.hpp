@@ -57,6 +57,20 @@ namespace RTC
 			uint8_t temporalLayers{ 1u };
 		};
 
+		// Sequence state carried to the RtpStream of another worker so it
+		// continues the same stream (see WebRtcTransport::ExportState()).
+		struct SeqState
+		{
+			SeqState() = default;
+			explicit SeqState(json& data);
+
+			void FillJson(json& jsonObject) const;
+
+			uint16_t maxSeq{ 0u };
+			uint32_t cycles{ 0u };
+			uint32_t maxPacketTs{ 0u };
+		};
+
 	public:
 		RtpStream(RTC::RtpStream::Listener* listener, RTC::RtpStream::Params& params, uint8_t initialScore);
 		virtual ~RtpStream();
@@ -160,6 +174,13 @@ namespace RTC
 		{
 			return DepLibUV::GetTimeMs() - this->activeSinceMs;
 		}
+		// Whether at least a RTP packet has been received.
+		bool IsStarted() const
+		{
+			return this->started;
+		}
+		SeqState GetSeqState() const;
+		void SetSeqState(const SeqState& seqState);
 
 	protected:
 		bool UpdateSeq(RTC::RtpPacket* packet);
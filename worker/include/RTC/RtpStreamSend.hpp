@@ -2,6 +2,7 @@
 #define MS_RTC_RTP_STREAM_SEND_HPP
 
 #include "RTC/RateCalculator.hpp"
+#include "RTC/RtpRetransmissionCache.hpp"
 #include "RTC/RtpStream.hpp"
 #include <deque>
 
@@ -27,41 +28,43 @@ namespace RTC
 		struct StorageItem
 		{
 			void Reset();
+			RTC::RtpPacket* GetPacket() const
+			{
+				return this->retransmissionCache->Get(this->cacheSequenceNumber);
+			}
 
-			// Original packet.
-			std::shared_ptr<RTC::RtpPacket> packet{ nullptr };
-			// Correct SSRC since original packet may not have the same.
-			uint32_t ssrc{ 0 };
-			// Correct sequence number since original packet may not have the same.
-			uint16_t sequenceNumber{ 0 };
-			// Correct timestamp since original packet may not have the same.
-			uint32_t timestamp{ 0 };
+			// Shared cache holding the original packet (empty slot if null).
+			RTC::RtpRetransmissionCache* retransmissionCache{ nullptr };
 			// Last time this packet was resent.
 			uint64_t resentAtMs{ 0u };
+			// Correct timestamp since original packet may not have the same.
+			uint32_t timestamp{ 0 };
+			// Sequence number of the original packet in the shared cache.
+			uint16_t cacheSequenceNumber{ 0 };
 			// Number of times this packet was resent.
 			uint8_t sentTimes{ 0u };
+			// Number of times this packet was sent as padding.
+			uint8_t paddedTimes{ 0u };
 		};
 
 	private:
-		// Special container that stores `StorageItem*` elements addressable by
+		// Special container that stores `StorageItem` elements addressable by
 		// their `uint16_t` sequence number, while only taking as little memory as
 		// necessary to store the range covering a maximum of
 		// `MaxRetransmissionDelay` milliseconds.
 		class StorageItemBuffer
 		{
 		public:
-			~StorageItemBuffer();
-
-			StorageItem* GetFirst() const;
-			StorageItem* Get(uint16_t seq) const;
+			StorageItem* GetFirst();
+			StorageItem* Get(uint16_t seq);
 			size_t GetBufferSize() const;
-			void Insert(uint16_t seq, StorageItem* storageItem);
+			StorageItem* Insert(uint16_t seq);
 			void RemoveFirst();
 			void Clear();
 
 		private:
 			uint16_t startSeq{ 0 };
-			std::deque<StorageItem*> buffer;
+			std::deque<StorageItem> buffer;
 		};
 
 	public:
@@ -71,7 +74,7 @@ namespace RTC
 
 		void FillJsonStats(json& jsonObject) override;
 		void SetRtx(uint8_t payloadType, uint32_t ssrc) override;
-		bool ReceivePacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket);
+		bool ReceivePacket(RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache);
 		void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket);
 		void ReceiveKeyFrameRequest(RTC::RTCP::FeedbackPs::MessageType messageType);
 		void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report);
@@ -79,6 +82,7 @@ namespace RTC
 		RTC::RTCP::SenderReport* GetRtcpSenderReport(uint64_t nowMs);
 		RTC::RTCP::DelaySinceLastRr::SsrcInfo* GetRtcpXrDelaySinceLastRr(uint64_t nowMs);
 		RTC::RTCP::SdesChunk* GetRtcpSdesChunk();
+		RTC::RtpPacket* GetRtxPaddingPacket(size_t size);
 		void Pause() override;
 		void Resume() override;
 		uint32_t GetBitrate(uint64_t nowMs) override
@@ -90,7 +94,7 @@ namespace RTC
 		uint32_t GetLayerBitrate(uint64_t nowMs, uint8_t spatialLayer, uint8_t temporalLayer) override;
 
 	private:
-		void StorePacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket);
+		void StorePacket(RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache);
 		void ClearOldPackets(const RtpPacket* packet);
 		void ClearBuffer();
 		void FillRetransmissionContainer(uint16_t seq, uint16_t bitmask);
@@ -40,6 +40,8 @@ namespace RTC
 		void Drop(T input);
 		void Offset(T offset);
 		bool Input(const T input, T& output);
+		void Restore(T base, T maxOutput);
+		T GetBase() const;
 		T GetMaxInput() const;
 		T GetMaxOutput() const;
 
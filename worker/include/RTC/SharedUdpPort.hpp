@@ -0,0 +1,175 @@
+#ifndef MS_RTC_SHARED_UDP_PORT_HPP
+#define MS_RTC_SHARED_UDP_PORT_HPP
+
+#include "common.hpp"
+#include "LockFreeQueue.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/UdpSocket.hpp"
+#include <uv.h>
+#include <absl/container/flat_hash_map.h>
+#include <absl/strings/string_view.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+	// A UDP IP:port bound (with SO_REUSEPORT) by UdpSockets living in different
+	// worker threads of the same process. The kernel spreads remote peers
+	// among those sockets, so packets received by a worker that does not own
+	// their ICE usernameFragment or tuple are handed to the owning one through
+	// a lock-free queue and an uv_async handle. Each member looks up owners in
+	// its own copy of the owners maps, which it brings up to date (under the
+	// group mutex) by applying the changes published since its copy version.
+	// So looking up takes no lock unless the maps have changed, and changing
+	// them costs the same no matter their size.
+	class SharedUdpPort
+	{
+	public:
+		class Listener
+		{
+		public:
+			virtual ~Listener() = default;
+
+		public:
+			// Called within the loop thread of this SharedUdpPort for packets
+			// forwarded by another worker.
+			virtual void OnSharedUdpPortPacketReceived(
+			  RTC::SharedUdpPort* sharedUdpPort,
+			  const uint8_t* data,
+			  size_t len,
+			  const struct sockaddr* remoteAddr) = 0;
+		};
+
+	private:
+		// Fixed size, so the queue slots are allocated once.
+		struct Packet
+		{
+			uint8_t data[RTC::MtuSize + 100];
+			size_t len{ 0u };
+			struct sockaddr_storage remoteAddr;
+		};
+
+	private:
+		// Where packets forwarded to a member are written. Maps of other members
+		// hold a reference to it, so it outlives its member until they catch up.
+		struct Mailbox
+		{
+			explicit Mailbox(size_t capacity) : queue(capacity)
+			{
+			}
+
+			LockFreeQueue<Packet> queue;
+			// Guards uvHandle, which is reset by the member once leaving the group
+			// so nobody signals it once closed.
+			std::mutex mutex;
+			uv_async_t* uvHandle{ nullptr };
+		};
+
+	private:
+		// Owners of local ICE usernameFragments and tuples.
+		struct Maps
+		{
+			absl::flat_hash_map<std::string, std::shared_ptr<Mailbox>>
+			  mapLocalIceUsernameFragmentMailbox;
+			absl::flat_hash_map<uint64_t, std::shared_ptr<Mailbox>> mapTupleMailbox;
+		};
+
+	private:
+		// A change of the owners maps.
+		struct Change
+		{
+			enum class Type : uint8_t
+			{
+				ADD_USERNAME_FRAGMENT,
+				REMOVE_USERNAME_FRAGMENT,
+				ADD_TUPLE,
+				REMOVE_TUPLE,
+				REMOVE_MAILBOX
+			};
+
+			Type type;
+			std::string usernameFragment;
+			uint64_t tupleHash{ 0u };
+			std::shared_ptr<Mailbox> mailbox;
+		};
+
+	private:
+		// Members of all the SharedUdpPorts in the same IP:port.
+		struct Group
+		{
+			// Guards everything but version.
+			std::mutex mutex;
+			std::vector<SharedUdpPort*> members;
+			// Up to date maps, copied by members too far behind the changes.
+			Maps maps;
+			// Changes not yet applied by every member. The first one takes the maps
+			// from firstChangeVersion to firstChangeVersion + 1.
+			std::deque<Change> changes;
+			uint64_t firstChangeVersion{ 0u };
+			// Written with the mutex locked, read without it.
+			std::atomic<uint64_t> version{ 0u };
+		};
+
+	private:
+		static std::mutex globalMutex;
+		static absl::flat_hash_map<std::string, std::shared_ptr<Group>> mapKeyGroup;
+
+	public:
+		SharedUdpPort(Listener* listener, RTC::UdpSocket* udpSocket);
+		~SharedUdpPort();
+
+	public:
+		RTC::UdpSocket* GetUdpSocket() const
+		{
+			return this->udpSocket;
+		}
+		void AddLocalIceUsernameFragment(const std::string& usernameFragment);
+		void RemoveLocalIceUsernameFragment(const std::string& usernameFragment);
+		void AddTuple(uint64_t tupleHash);
+		void RemoveTuple(uint64_t tupleHash);
+		// Hand the packet to the member owning the given local ICE
+		// usernameFragment or tuple. Return false if no other member owns it.
+		bool ForwardStunPacket(
+		  absl::string_view usernameFragment,
+		  uint64_t tupleHash,
+		  const uint8_t* data,
+		  size_t len,
+		  const struct sockaddr* remoteAddr);
+		bool ForwardNonStunPacket(
+		  uint64_t tupleHash, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr);
+
+	private:
+		static void Enqueue(
+		  Mailbox* mailbox, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr);
+		static void ApplyChange(Maps& maps, const Change& change);
+		// Apply the change to the group maps and publish it. Must be called with
+		// the group mutex locked.
+		void PublishChange(Change change);
+		// Bring the maps of this member up to date. Must be called within the
+		// thread forwarding packets.
+		void SyncMaps();
+
+		/* Callbacks fired by UV events. */
+	public:
+		void OnUvAsync();
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		RTC::UdpSocket* udpSocket{ nullptr };
+		// Allocated by this.
+		std::shared_ptr<Mailbox> mailbox;
+		// Others.
+		std::shared_ptr<Group> group;
+		// Accessed just within the thread forwarding packets, but written with
+		// the group mutex locked (so other members read mapsVersion with it).
+		Maps maps;
+		uint64_t mapsVersion{ 0u };
+	};
+} // namespace RTC
+
+#endif
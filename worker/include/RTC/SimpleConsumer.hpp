@@ -2,8 +2,11 @@
 #define MS_RTC_SIMPLE_CONSUMER_HPP
 
 #include "RTC/Consumer.hpp"
+#include "RTC/RtpRedEncoder.hpp"
 #include "RTC/RtpStreamSend.hpp"
 #include "RTC/SeqManager.hpp"
+#include "RTC/UlpfecEncoder.hpp"
+#include <deque>
 
 namespace RTC
 {
@@ -21,6 +24,8 @@ namespace RTC
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) const override;
 		void FillJsonScore(json& jsonObject) const override;
+		void FillJsonRtpState(json& jsonObject) const override;
+		void SetRtpState(json& data) override;
 		bool IsActive() const override
 		{
 			// clang-format off
@@ -31,6 +36,7 @@ namespace RTC
 			);
 			// clang-format on
 		}
+		bool IsWaitingForKeyFrame(uint32_t mappedSsrc) const override;
 		void ProducerRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
 		void ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
 		void ProducerRtpStreamScore(RTC::RtpStream* rtpStream, uint8_t score, uint8_t previousScore) override;
@@ -39,7 +45,8 @@ namespace RTC
 		uint32_t IncreaseLayer(uint32_t bitrate, bool considerLoss) override;
 		void ApplyLayers() override;
 		uint32_t GetDesiredBitrate() const override;
-		void SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket) override;
+		void SendRtpPacket(
+		  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache) override;
 		std::vector<RTC::RtpStreamSend*> GetRtpStreams() override
 		{
 			return this->rtpStreams;
@@ -65,6 +72,10 @@ namespace RTC
 		void CreateRtpStream();
 		void RequestKeyFrame();
 		void EmitScore() const;
+		void UpdateRed();
+		void UpdateFec();
+		void UpdateFecProtectionFactor();
+		void SendFecPackets(RTC::RtpPacket* packet, uint16_t origSeq);
 
 		/* Pure virtual methods inherited from RtpStreamSend::Listener. */
 	public:
@@ -82,6 +93,21 @@ namespace RTC
 		RTC::SeqManager<uint16_t> rtpSeqManager;
 		bool managingBitrate{ false };
 		std::unique_ptr<RTC::Codecs::EncodingContext> encodingContext;
+		// RED (allocated while the remote fraction lost is high enough).
+		bool redSupported{ false };
+		uint8_t redPayloadType{ 0u };
+		uint8_t redFractionLostThreshold{ 0u };
+		std::unique_ptr<RTC::RtpRedEncoder> redEncoder;
+		// ULPFEC (allocated while the remote reports losses on a high RTT link).
+		// Video packets are sent within RED packets while it is allocated.
+		bool fecSupported{ false };
+		uint8_t ulpfecPayloadType{ 0u };
+		float fecMinRtt{ 0 };
+		float fecLossFactor{ 0 };
+		float fecHeadroomFactor{ 0 };
+		std::unique_ptr<RTC::UlpfecEncoder> fecEncoder;
+		// Input seq of the packets followed by FEC packets and number of them.
+		std::deque<std::pair<uint16_t, uint16_t>> fecInsertions;
 	};
 } // namespace RTC
 
@@ -22,6 +22,8 @@ namespace RTC
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) const override;
 		void FillJsonScore(json& jsonObject) const override;
+		void FillJsonRtpState(json& jsonObject) const override;
+		void SetRtpState(json& data) override;
 		RTC::Consumer::Layers GetPreferredLayers() const override
 		{
 			RTC::Consumer::Layers layers;
@@ -47,6 +49,22 @@ namespace RTC
 			);
 			// clang-format on
 		}
+		bool IsWaitingForKeyFrame(uint32_t mappedSsrc) const override;
+		bool IsForwardingRtpStream(uint32_t mappedSsrc) const override;
+		bool CanLeadRtpRewrite() const override;
+		bool CanShareRtpRewrite(const RTC::Consumer* leader) const override;
+		bool MayJoinRtpRewrite(const RTC::RtpPacket* packet) const override;
+		bool CanJoinRtpRewrite(
+		  const RTC::Consumer* leader, const RTC::RtpPacket* packet) const override;
+		void LeaveRtpRewrite(const RTC::Consumer* leader) override;
+		bool RewriteRtpPacket(RTC::RtpPacket* packet) override;
+		void SendRewrittenRtpPacket(
+		  RTC::RtpPacket* packet,
+		  const RTC::Consumer* leader,
+		  RTC::RtpRetransmissionCache* retransmissionCache) override;
+		void RestoreRtpPacket(RTC::RtpPacket* packet) override;
+		void SetLastNDowngraded(bool lastNDowngraded) override;
+		void SetOverloadDowngraded(bool overloadDowngraded) override;
 		void ProducerRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
 		void ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
 		void ProducerRtpStreamScore(RTC::RtpStream* rtpStream, uint8_t score, uint8_t previousScore) override;
@@ -55,7 +73,8 @@ namespace RTC
 		uint32_t IncreaseLayer(uint32_t bitrate, bool considerLoss) override;
 		void ApplyLayers() override;
 		uint32_t GetDesiredBitrate() const override;
-		void SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket) override;
+		void SendRtpPacket(
+		  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache) override;
 		void GetRtcp(RTC::RTCP::CompoundPacket* packet, RTC::RtpStreamSend* rtpStream, uint64_t nowMs) override;
 		std::vector<RTC::RtpStreamSend*> GetRtpStreams() override
 		{
@@ -91,6 +110,31 @@ namespace RTC
 		RTC::RtpStream* GetProducerCurrentRtpStream() const;
 		RTC::RtpStream* GetProducerTargetRtpStream() const;
 		RTC::RtpStream* GetProducerTsReferenceRtpStream() const;
+		void CopyRtpRewrite(const RTC::SimulcastConsumer* consumer);
+		void JoinRtpRewrite(const RTC::SimulcastConsumer* leader);
+		// Lowest layers are used while downgraded by the last-N policy and one
+		// layer less while the worker is overloaded.
+		int16_t GetEffectivePreferredSpatialLayer() const
+		{
+			if (this->lastNDowngraded)
+				return 0;
+			else if (this->overloadDowngraded && this->preferredSpatialLayer > 0)
+				return this->preferredSpatialLayer - 1;
+			else
+				return this->preferredSpatialLayer;
+		}
+		int16_t GetEffectivePreferredTemporalLayer() const
+		{
+			// Lower the temporal layer once there is no spatial layer to lower.
+			bool lowerTemporalLayer = this->overloadDowngraded && this->preferredSpatialLayer <= 0;
+
+			if (this->lastNDowngraded)
+				return 0;
+			else if (lowerTemporalLayer && this->preferredTemporalLayer > 0)
+				return this->preferredTemporalLayer - 1;
+			else
+				return this->preferredTemporalLayer;
+		}
 
 		/* Pure virtual methods inherited from RtpStreamSend::Listener. */
 	public:
@@ -110,6 +154,8 @@ namespace RTC
 		RTC::SeqManager<uint16_t> rtpSeqManager;
 		int16_t preferredSpatialLayer{ -1 };
 		int16_t preferredTemporalLayer{ -1 };
+		bool lastNDowngraded{ false };
+		bool overloadDowngraded{ false };
 		int16_t provisionalTargetSpatialLayer{ -1 };
 		int16_t provisionalTargetTemporalLayer{ -1 };
 		int16_t targetSpatialLayer{ -1 };
@@ -122,6 +168,12 @@ namespace RTC
 		uint32_t tsOffset{ 0u }; // RTP Timestamp offset.
 		bool keyFrameForTsOffsetRequested{ false };
 		uint64_t lastBweDowngradeAtMs{ 0u }; // Last time we moved to lower spatial layer due to BWE.
+		// Whether a packet has already been rewritten for this Consumer.
+		bool rtpRewriteStarted{ false };
+		// Original fields of the packet being rewritten.
+		uint32_t rewrittenOrigSsrc{ 0u };
+		uint16_t rewrittenOrigSeq{ 0u };
+		uint32_t rewrittenOrigTimestamp{ 0u };
 	};
 } // namespace RTC
 
@@ -2,7 +2,9 @@
 #define MS_RTC_SRTP_SESSION_HPP
 
 #include "common.hpp"
+#include <absl/container/flat_hash_map.h>
 #include <srtp.h>
+#include <vector>
 
 namespace RTC
 {
@@ -25,14 +27,32 @@ namespace RTC
 			OUTBOUND
 		};
 
+	public:
+		// Packet indexes of a stream, so a migrated session can continue where
+		// this one is.
+		struct StreamState
+		{
+			uint32_t ssrc{ 0u };
+			uint32_t roc{ 0u };       // RTP rollover counter.
+			uint32_t rtcpIndex{ 0u }; // Index of the last sent SRTCP packet.
+		};
+
 	public:
 		static void ClassInit();
+		// Length of the master key plus master salt for the given crypto suite.
+		static size_t GetMasterLength(CryptoSuite cryptoSuite);
 
 	private:
 		static void OnSrtpEvent(srtp_event_data_t* data);
 
 	public:
 		SrtpSession(Type type, CryptoSuite cryptoSuite, uint8_t* key, size_t keyLen);
+		SrtpSession(
+		  Type type,
+		  CryptoSuite cryptoSuite,
+		  uint8_t* key,
+		  size_t keyLen,
+		  const std::vector<StreamState>& streamStates);
 		~SrtpSession();
 
 	public:
@@ -43,11 +63,29 @@ namespace RTC
 		void RemoveStream(uint32_t ssrc)
 		{
 			srtp_remove_stream(this->session, uint32_t{ htonl(ssrc) });
+
+			this->mapSsrcRtcpIndex.erase(ssrc);
 		}
+		CryptoSuite GetCryptoSuite() const
+		{
+			return this->cryptoSuite;
+		}
+		std::vector<StreamState> GetStreamStates(const std::vector<uint32_t>& ssrcs) const;
+
+	private:
+		void FillPolicy(srtp_policy_t& policy, uint8_t* key, size_t keyLen) const;
+		bool AddStream(srtp_policy_t& policy, const StreamState& state);
 
 	private:
+		// Passed by argument.
+		Type type;
+		CryptoSuite cryptoSuite{ CryptoSuite::NONE };
 		// Allocated by this.
 		srtp_t session{ nullptr };
+		// Others.
+		// Index of the last sent SRTCP packet indexed by sender SSRC. libsrtp has
+		// no public API to get it.
+		absl::flat_hash_map<uint32_t, uint32_t> mapSsrcRtcpIndex;
 	};
 } // namespace RTC
 
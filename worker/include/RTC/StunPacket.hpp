@@ -2,6 +2,8 @@
 #define MS_RTC_STUN_PACKET_HPP
 
 #include "common.hpp"
+#include "Utils.hpp"
+#include <absl/strings/string_view.h>
 #include <string>
 
 namespace RTC
@@ -68,15 +70,15 @@ namespace RTC
 			);
 			// clang-format on
 		}
-		static StunPacket* Parse(const uint8_t* data, size_t len);
+		static bool Parse(const uint8_t* data, size_t len, StunPacket& packet);
 
 	private:
 		static const uint8_t magicCookie[];
 
 	public:
+		StunPacket() = default;
 		StunPacket(
 		  Class klass, Method method, const uint8_t* transactionId, const uint8_t* data, size_t size);
-		~StunPacket();
 
 		void Dump() const;
 		Class GetClass() const
@@ -95,9 +97,10 @@ namespace RTC
 		{
 			return this->size;
 		}
+		// NOTE: Given username is not copied so it must outlive the StunPacket.
 		void SetUsername(const char* username, size_t len)
 		{
-			this->username.assign(username, len);
+			this->username = absl::string_view(username, len);
 		}
 		void SetPriority(uint32_t priority)
 		{
@@ -135,7 +138,7 @@ namespace RTC
 		{
 			this->hasFingerprint = true;
 		}
-		const std::string& GetUsername() const
+		absl::string_view GetUsername() const
 		{
 			return this->username;
 		}
@@ -180,21 +183,21 @@ namespace RTC
 			return this->hasFingerprint;
 		}
 		Authentication CheckAuthentication(
-		  const std::string& localUsername, const std::string& localPassword);
-		StunPacket* CreateSuccessResponse();
-		StunPacket* CreateErrorResponse(uint16_t errorCode);
-		void Authenticate(const std::string& password);
+		  const std::string& localUsername, Utils::Crypto::HmacSha1* localHmacSha1);
+		StunPacket CreateSuccessResponse() const;
+		StunPacket CreateErrorResponse(uint16_t errorCode) const;
+		void Authenticate(Utils::Crypto::HmacSha1* hmacSha1);
 		void Serialize(uint8_t* buffer);
 
 	private:
 		// Passed by argument.
-		Class klass;                             // 2 bytes.
-		Method method;                           // 2 bytes.
+		Class klass{ Class::REQUEST };           // 2 bytes.
+		Method method{ Method::BINDING };        // 2 bytes.
 		const uint8_t* transactionId{ nullptr }; // 12 bytes.
 		uint8_t* data{ nullptr };                // Pointer to binary data.
 		size_t size{ 0u };                       // The full message size (including header).
 		// STUN attributes.
-		std::string username;          // Less than 513 bytes.
+		absl::string_view username;    // Less than 513 bytes.
 		uint32_t priority{ 0u };       // 4 bytes unsigned integer.
 		uint64_t iceControlling{ 0u }; // 8 bytes unsigned integer.
 		uint64_t iceControlled{ 0u };  // 8 bytes unsigned integer.
@@ -205,7 +208,8 @@ namespace RTC
 		bool hasFingerprint{ false };                       // 4 bytes.
 		const struct sockaddr* xorMappedAddress{ nullptr }; // 8 or 20 bytes.
 		uint16_t errorCode{ 0u };                           // 4 bytes (no reason phrase).
-		std::string password;
+		// HMAC-SHA1 calculator used to compute MESSAGE-INTEGRITY.
+		Utils::Crypto::HmacSha1* hmacSha1{ nullptr };
 	};
 } // namespace RTC
 
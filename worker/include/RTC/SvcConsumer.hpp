@@ -23,6 +23,8 @@ namespace RTC
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) const override;
 		void FillJsonScore(json& jsonObject) const override;
+		void FillJsonRtpState(json& jsonObject) const override;
+		void SetRtpState(json& data) override;
 		RTC::Consumer::Layers GetPreferredLayers() const override
 		{
 			RTC::Consumer::Layers layers;
@@ -42,6 +44,8 @@ namespace RTC
 			);
 			// clang-format on
 		}
+		void SetLastNDowngraded(bool lastNDowngraded) override;
+		void SetOverloadDowngraded(bool overloadDowngraded) override;
 		void ProducerRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
 		void ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
 		void ProducerRtpStreamScore(RTC::RtpStream* rtpStream, uint8_t score, uint8_t previousScore) override;
@@ -50,7 +54,8 @@ namespace RTC
 		uint32_t IncreaseLayer(uint32_t bitrate, bool considerLoss) override;
 		void ApplyLayers() override;
 		uint32_t GetDesiredBitrate() const override;
-		void SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket) override;
+		void SendRtpPacket(
+		  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache) override;
 		void GetRtcp(RTC::RTCP::CompoundPacket* packet, RTC::RtpStreamSend* rtpStream, uint64_t nowMs) override;
 		std::vector<RTC::RtpStreamSend*> GetRtpStreams() override
 		{
@@ -80,6 +85,29 @@ namespace RTC
 		void UpdateTargetLayers(int16_t newTargetSpatialLayer, int16_t newTargetTemporalLayer);
 		void EmitScore() const;
 		void EmitLayersChange() const;
+		// Lowest layers are used while downgraded by the last-N policy and one
+		// layer less while the worker is overloaded.
+		int16_t GetEffectivePreferredSpatialLayer() const
+		{
+			if (this->lastNDowngraded)
+				return 0;
+			else if (this->overloadDowngraded && this->preferredSpatialLayer > 0)
+				return this->preferredSpatialLayer - 1;
+			else
+				return this->preferredSpatialLayer;
+		}
+		int16_t GetEffectivePreferredTemporalLayer() const
+		{
+			// Lower the temporal layer once there is no spatial layer to lower.
+			bool lowerTemporalLayer = this->overloadDowngraded && this->preferredSpatialLayer <= 0;
+
+			if (this->lastNDowngraded)
+				return 0;
+			else if (lowerTemporalLayer && this->preferredTemporalLayer > 0)
+				return this->preferredTemporalLayer - 1;
+			else
+				return this->preferredTemporalLayer;
+		}
 
 		/* Pure virtual methods inherited from RtpStreamSend::Listener. */
 	public:
@@ -96,6 +124,8 @@ namespace RTC
 		RTC::SeqManager<uint16_t> rtpSeqManager;
 		int16_t preferredSpatialLayer{ -1 };
 		int16_t preferredTemporalLayer{ -1 };
+		bool lastNDowngraded{ false };
+		bool overloadDowngraded{ false };
 		int16_t provisionalTargetSpatialLayer{ -1 };
 		int16_t provisionalTargetTemporalLayer{ -1 };
 		std::unique_ptr<RTC::Codecs::EncodingContext> encodingContext;
@@ -92,6 +92,8 @@ namespace RTC
 			  RTC::Transport* transport, RTC::Consumer* consumer) = 0;
 			virtual void OnTransportConsumerKeyFrameRequested(
 			  RTC::Transport* transport, RTC::Consumer* consumer, uint32_t mappedSsrc) = 0;
+			virtual void OnTransportConsumerForwardedRtpStreamsChange(
+			  RTC::Transport* transport, RTC::Consumer* consumer) = 0;
 			virtual void OnTransportNewDataProducer(
 			  RTC::Transport* transport, RTC::DataProducer* dataProducer) = 0;
 			virtual void OnTransportDataProducerClosed(
@@ -125,6 +127,11 @@ namespace RTC
 	public:
 		void CloseProducersAndConsumers();
 		void ListenServerClosed();
+		// Bitrate distribution needed by Consumers is done once when the bulk
+		// request ends.
+		void BulkRequestStarted();
+		void BulkRequestEnded();
+		void SetOverloadDowngraded(bool overloadDowngraded);
 		// Subclasses must also invoke the parent Close().
 		virtual void FillJson(json& jsonObject) const;
 		virtual void FillJsonStats(json& jsonArray);
@@ -162,6 +169,9 @@ namespace RTC
 		RTC::Consumer* GetConsumerFromInternal(json& internal) const;
 		RTC::Consumer* GetConsumerByMediaSsrc(uint32_t ssrc) const;
 		RTC::Consumer* GetConsumerByRtxSsrc(uint32_t ssrc) const;
+		void GetRtpStreamSsrcs(
+		  std::vector<uint32_t>& recvSsrcs, std::vector<uint32_t>& sendSsrcs) const;
+		void FillJsonRtpState(json& jsonObject) const;
 		void SetNewDataProducerIdFromInternal(json& internal, std::string& dataProducerId) const;
 		RTC::DataProducer* GetDataProducerFromInternal(json& internal) const;
 		void SetNewDataConsumerIdFromInternal(json& internal, std::string& dataConsumerId) const;
@@ -212,6 +222,7 @@ namespace RTC
 		void OnConsumerNeedBitrateChange(RTC::Consumer* consumer) override;
 		void OnConsumerNeedZeroBitrate(RTC::Consumer* consumer) override;
 		void OnConsumerProducerClosed(RTC::Consumer* consumer) override;
+		void OnConsumerForwardedRtpStreamsChange(RTC::Consumer* consumer) override;
 
 		/* Pure virtual methods inherited from RTC::DataProducer::Listener. */
 	public:
@@ -254,6 +265,8 @@ namespace RTC
 		  RTC::TransportCongestionControlClient* tccClient,
 		  RTC::RtpPacket* packet,
 		  const webrtc::PacedPacketInfo& pacingInfo) override;
+		RTC::RtpPacket* OnTransportCongestionControlClientGetPaddingPacket(
+		  RTC::TransportCongestionControlClient* tccClient, size_t size) override;
 
 		/* Pure virtual methods inherited from RTC::TransportCongestionControlServer::Listener. */
 	public:
@@ -316,6 +329,9 @@ namespace RTC
 		uint32_t maxIncomingBitrate{ 0u };
 		uint32_t maxOutgoingBitrate{ 0u };
 		struct TraceEventTypes traceEventTypes;
+		bool handlingBulkRequest{ false };
+		bool pendingBitrateDistribution{ false };
+		bool pendingForceOutgoingDesiredBitrate{ false };
 	};
 } // namespace RTC
 
@@ -49,6 +49,8 @@ namespace RTC
 			  RTC::TransportCongestionControlClient* tccClient,
 			  RTC::RtpPacket* packet,
 			  const webrtc::PacedPacketInfo& pacingInfo) = 0;
+			virtual RTC::RtpPacket* OnTransportCongestionControlClientGetPaddingPacket(
+			  RTC::TransportCongestionControlClient* tccClient, size_t size) = 0;
 		};
 
 	public:
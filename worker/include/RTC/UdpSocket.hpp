@@ -22,7 +22,10 @@ namespace RTC
 
 	public:
 		UdpSocket(Listener* listener, std::string& ip);
-		UdpSocket(Listener* listener, std::string& ip, uint16_t port);
+		UdpSocket(Listener* listener, std::string& ip, uint16_t port, bool reusePort = false);
+		// Takes the ownership of an already bound socket fd (i.e. imported from
+		// another worker). Its port is not managed by the PortManager.
+		UdpSocket(Listener* listener, int fd);
 		~UdpSocket() override;
 
 		/* Pure virtual methods inherited from ::UdpSocketHandler. */
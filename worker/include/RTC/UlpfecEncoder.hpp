@@ -0,0 +1,79 @@
+#ifndef MS_RTC_ULPFEC_ENCODER_HPP
+#define MS_RTC_ULPFEC_ENCODER_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <array>
+#include <vector>
+
+namespace RTC
+{
+	// Generates ULPFEC packets (RFC 5109) protecting the RTP packets of a video
+	// stream, carried within RED packets (RFC 2198) as WebRTC endpoints expect.
+	//
+	// Sent packets are grouped (up to MaxMediaPackets consecutive ones) and,
+	// once a frame is complete, as many FEC packets as given by the protection
+	// factor are generated. Packets of the group are interleaved among them so
+	// a burst of losses is spread across different FEC packets.
+	//
+	// FEC packets take the sequence numbers following the latest given packet
+	// and are written into buffers owned by this, being valid until the next
+	// call to AddPacket().
+	class UlpfecEncoder
+	{
+	public:
+		// Packets protected by a FEC packet (short packet mask).
+		static constexpr size_t MaxMediaPackets{ 16u };
+		static constexpr size_t MaxFecPackets{ 8u };
+
+	private:
+		struct MediaPacket
+		{
+			uint16_t seq{ 0u };
+			// First two bytes of the RTP header (with the media payload type).
+			uint8_t byte0{ 0u };
+			uint8_t byte1{ 0u };
+			uint32_t timestamp{ 0u };
+			// Protected data (whatever follows the fixed RTP header).
+			size_t length{ 0u };
+			uint8_t data[RTC::MtuSize];
+		};
+
+	public:
+		UlpfecEncoder(uint8_t redPayloadType, uint8_t ulpfecPayloadType);
+		~UlpfecEncoder();
+
+	public:
+		void SetProtectionFactor(float protectionFactor)
+		{
+			this->protectionFactor = protectionFactor;
+		}
+		float GetProtectionFactor() const
+		{
+			return this->protectionFactor;
+		}
+		const std::vector<RTC::RtpPacket*>& AddPacket(const RTC::RtpPacket* packet);
+		void Reset();
+
+	private:
+		void StoreMediaPacket(const RTC::RtpPacket* packet);
+		void GenerateFecPackets(const RTC::RtpPacket* packet, size_t numFecPackets);
+		void ClearFecPackets();
+
+	private:
+		// Passed by argument.
+		uint8_t redPayloadType{ 0u };
+		uint8_t ulpfecPayloadType{ 0u };
+		float protectionFactor{ 0 };
+		// Allocated by this.
+		std::vector<RTC::RtpPacket*> fecPackets;
+		// Others.
+		std::array<MediaPacket, MaxMediaPackets> mediaPackets;
+		size_t numMediaPackets{ 0u };
+		bool started{ false };
+		uint16_t lastSeq{ 0u };
+		uint8_t buffers[MaxFecPackets][RTC::MtuSize + 100];
+	};
+} // namespace RTC
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "Channel/ChannelRequest.hpp"
 #include "RTC/IceCandidate.hpp"
+#include "RTC/SharedUdpPort.hpp"
 #include "RTC/StunPacket.hpp"
 #include "RTC/TcpConnection.hpp"
 #include "RTC/TcpServer.hpp"
@@ -11,6 +12,7 @@
 #include "RTC/WebRtcTransport.hpp"
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
+#include <absl/strings/string_view.h>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
@@ -18,6 +20,7 @@
 namespace RTC
 {
 	class WebRtcServer : public RTC::UdpSocket::Listener,
+	                     public RTC::SharedUdpPort::Listener,
 	                     public RTC::TcpServer::Listener,
 	                     public RTC::TcpConnection::Listener,
 	                     public RTC::WebRtcTransport::WebRtcTransportListener,
@@ -30,6 +33,7 @@ namespace RTC
 			std::string ip;
 			std::string announcedIp;
 			uint16_t port;
+			bool reusePort{ false };
 		};
 
 	private:
@@ -60,7 +64,9 @@ namespace RTC
 		void HandleRequest(Channel::ChannelRequest* request) override;
 
 	private:
-		std::string GetLocalIceUsernameFragmentFromReceivedStunPacket(RTC::StunPacket* packet) const;
+		absl::string_view GetLocalIceUsernameFragmentFromReceivedStunPacket(
+		  const RTC::StunPacket* packet) const;
+		RTC::SharedUdpPort* GetSharedUdpPort(const RTC::TransportTuple* tuple) const;
 		void OnPacketReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnStunDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnNonStunDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
@@ -83,6 +89,14 @@ namespace RTC
 		void OnUdpSocketPacketReceived(
 		  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) override;
 
+		/* Pure virtual methods inherited from RTC::SharedUdpPort::Listener. */
+	public:
+		void OnSharedUdpPortPacketReceived(
+		  RTC::SharedUdpPort* sharedUdpPort,
+		  const uint8_t* data,
+		  size_t len,
+		  const struct sockaddr* remoteAddr) override;
+
 		/* Pure virtual methods inherited from RTC::TcpServer::Listener. */
 	public:
 		void OnRtcTcpConnectionClosed(RTC::TcpServer* tcpServer, RTC::TcpConnection* connection) override;
@@ -99,6 +113,9 @@ namespace RTC
 	private:
 		// Vector of UdpSockets and TcpServers in the user given order.
 		std::vector<UdpSocketOrTcpServer> udpSocketOrTcpServers;
+		// Map of SharedUdpPorts indexed by UdpSocket (just for those listening
+		// with reusePort).
+		absl::flat_hash_map<RTC::UdpSocket*, RTC::SharedUdpPort*> mapUdpSocketSharedUdpPort;
 		// Set of WebRtcTransports.
 		absl::flat_hash_set<RTC::WebRtcTransport*> webRtcTransports;
 		// Map of WebRtcTransports indexed by local ICE usernameFragment.
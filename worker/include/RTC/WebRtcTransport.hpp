@@ -11,6 +11,7 @@
 #include "RTC/Transport.hpp"
 #include "RTC/TransportTuple.hpp"
 #include "RTC/UdpSocket.hpp"
+#include "handles/FdImporter.hpp"
 #include <vector>
 
 namespace RTC
@@ -49,7 +50,11 @@ namespace RTC
 		};
 
 	public:
-		WebRtcTransport(const std::string& id, RTC::Transport::Listener* listener, json& data);
+		WebRtcTransport(
+		  const std::string& id,
+		  RTC::Transport::Listener* listener,
+		  json& data,
+		  FdImporter* fdImporter = nullptr);
 		WebRtcTransport(
 		  const std::string& id,
 		  RTC::Transport::Listener* listener,
@@ -75,6 +80,8 @@ namespace RTC
 		void HandleNotification(PayloadChannel::Notification* notification) override;
 
 	private:
+		void ImportState(json& jsonImportState, FdImporter* fdImporter);
+		void ExportState(const std::string& socketPath, json& data);
 		bool IsConnected() const override;
 		void MayRunDtlsTransport();
 		void SendRtpPacket(
@@ -160,6 +167,7 @@ namespace RTC
 		RTC::SrtpSession* srtpSendSession{ nullptr };
 		// Others.
 		bool connectCalled{ false }; // Whether connect() was succesfully called.
+		bool exported{ false };      // Whether its state was exported to another worker.
 		std::vector<RTC::IceCandidate> iceCandidates;
 		RTC::DtlsTransport::Role dtlsRole{ RTC::DtlsTransport::Role::AUTO };
 	};
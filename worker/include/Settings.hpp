@@ -38,6 +38,28 @@ public:
 		uint16_t rtcMaxPort{ 59999u };
 		std::string dtlsCertificateFile;
 		std::string dtlsPrivateKeyFile;
+		// Max memory (in bytes) used by RTP retransmission buffers (0 means no
+		// limit).
+		size_t retransmissionBufferMaxMemory{ 0u };
+		// Number of threads running DTLS handshakes out of the loop thread (0
+		// means that they run within the loop thread).
+		uint16_t dtlsHandshakeThreads{ 0u };
+		// Use the io_uring I/O path for media sockets if supported (Linux).
+		bool useIoUring{ false };
+		// Number of UDP sockets kept bound in advance per listen IP (0 means no
+		// pool).
+		uint16_t udpSocketPoolSize{ 0u };
+		// Number of entries of the ring through which logs are formatted and sent
+		// by a background thread (0 means that logs are sent synchronously).
+		uint32_t logRingSize{ 0u };
+		// Event loop lag (in ms) from which the worker is considered overloaded
+		// (0 means that the overload controller is disabled).
+		uint32_t overloadLoopLagThreshold{ 0u };
+		// Event loop busy time (in percentage) from which the worker is
+		// considered overloaded.
+		uint8_t overloadLoopBusyThreshold{ 90u };
+		// Degradation steps applied, in order, while the worker is overloaded.
+		std::vector<std::string> overloadDegradationSteps{ "retransmissions", "layers", "rtcp" };
 	};
 
 public:
@@ -49,6 +71,8 @@ private:
 	static void SetLogLevel(std::string& level);
 	static void SetLogTags(const std::vector<std::string>& tags);
 	static void SetDtlsCertificateAndPrivateKeyFiles();
+	static void SetRetransmissionBufferMaxMemory(int64_t value);
+	static void SetOverloadDegradationSteps(const std::vector<std::string>& steps);
 
 public:
 	thread_local static struct Configuration configuration;
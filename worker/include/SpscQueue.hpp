@@ -0,0 +1,108 @@
+#ifndef MS_SPSC_QUEUE_HPP
+#define MS_SPSC_QUEUE_HPP
+
+#include "common.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility> // std::move()
+
+/**
+ * Bounded queue with a single producer thread and a single consumer thread.
+ * Each side just publishes its own position and reads the other one, so no
+ * compare-and-swap is needed (see LockFreeQueue for several producers or
+ * consumers). The capacity is rounded up to a power of two.
+ */
+template<typename T>
+class SpscQueue
+{
+public:
+	explicit SpscQueue(size_t capacity)
+	{
+		size_t size{ 2u };
+
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+
+		this->items.reset(new T[size]);
+		this->mask = size - 1;
+	}
+
+public:
+	size_t GetCapacity() const
+	{
+		return this->mask + 1;
+	}
+	// Returns false if the queue is full (the item is not moved).
+	bool Push(T& item)
+	{
+		return PushInPlace([&item](T& slot) { slot = std::move(item); });
+	}
+	// Returns false if the queue is empty.
+	bool Pop(T& item)
+	{
+		return PopInPlace([&item](T& slot) { item = std::move(slot); });
+	}
+	// Like Push() but the given function fills the slot of the item, so big
+	// items are not copied twice. Returns false if the queue is full.
+	template<typename F>
+	bool PushInPlace(F fill)
+	{
+		size_t pos = this->tail.load(std::memory_order_relaxed);
+
+		// Just read the consumer position once the cached one says it's full.
+		if (pos - this->cachedHead > this->mask)
+		{
+			this->cachedHead = this->head.load(std::memory_order_acquire);
+
+			if (pos - this->cachedHead > this->mask)
+				return false;
+		}
+
+		fill(this->items[pos & this->mask]);
+		this->tail.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+	// Like Pop() but the given function reads the item in its slot, which is
+	// not reused until the function returns. Returns false if the queue is
+	// empty.
+	template<typename F>
+	bool PopInPlace(F read)
+	{
+		size_t pos = this->head.load(std::memory_order_relaxed);
+
+		// Just read the producer position once the cached one says it's empty.
+		if (pos == this->cachedTail)
+		{
+			this->cachedTail = this->tail.load(std::memory_order_acquire);
+
+			if (pos == this->cachedTail)
+				return false;
+		}
+
+		read(this->items[pos & this->mask]);
+		this->head.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+private:
+	// Allocated by this.
+	std::unique_ptr<T[]> items;
+	// Others.
+	size_t mask{ 0u };
+	// Keep producer and consumer positions in different cache lines.
+	uint8_t padding1[64];
+	// Written by the producer.
+	std::atomic<size_t> tail{ 0u };
+	size_t cachedHead{ 0u };
+	uint8_t padding2[64];
+	// Written by the consumer.
+	std::atomic<size_t> head{ 0u };
+	size_t cachedTail{ 0u };
+};
+
+#endif
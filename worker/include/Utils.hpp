@@ -197,6 +197,31 @@ namespace Utils
 
 	class Crypto
 	{
+	public:
+		// HMAC-SHA1 calculator bound to a given key. The key is processed (and
+		// its inner and outer padded digests computed) once in SetKey(), so
+		// computing the HMAC of each message does not need to process it again.
+		class HmacSha1
+		{
+		public:
+			HmacSha1();
+			~HmacSha1();
+			HmacSha1(const HmacSha1&)            = delete;
+			HmacSha1& operator=(const HmacSha1&) = delete;
+
+		public:
+			void SetKey(const std::string& key);
+			bool HasKey() const
+			{
+				return this->hasKey;
+			}
+			const uint8_t* Compute(const uint8_t* data, size_t len);
+
+		private:
+			EVP_MAC_CTX* ctx{ nullptr };
+			bool hasKey{ false };
+		};
+
 	public:
 		static void ClassInit();
 		static void ClassDestroy();
@@ -2,6 +2,7 @@
 #define MS_WORKER_HPP
 
 #include "common.hpp"
+#include "OverloadController.hpp"
 #include "Channel/ChannelRequest.hpp"
 #include "Channel/ChannelSocket.hpp"
 #include "PayloadChannel/Notification.hpp"
@@ -19,7 +20,8 @@ using json = nlohmann::json;
 class Worker : public Channel::ChannelSocket::Listener,
                public PayloadChannel::PayloadChannelSocket::Listener,
                public SignalsHandler::Listener,
-               public RTC::Router::Listener
+               public RTC::Router::Listener,
+               public OverloadController::Listener
 {
 public:
 	explicit Worker(Channel::ChannelSocket* channel, PayloadChannel::PayloadChannelSocket* payloadChannel);
@@ -62,15 +64,22 @@ public:
 public:
 	RTC::WebRtcServer* OnRouterNeedWebRtcServer(RTC::Router* router, std::string& webRtcServerId) override;
 
+	/* Pure virtual methods inherited from OverloadController::Listener. */
+public:
+	void OnOverloadControllerLevelChange(
+	  OverloadController* overloadController, size_t previousLevel) override;
+
 private:
 	// Passed by argument.
 	Channel::ChannelSocket* channel{ nullptr };
 	PayloadChannel::PayloadChannelSocket* payloadChannel{ nullptr };
 	// Allocated by this.
 	SignalsHandler* signalsHandler{ nullptr };
+	OverloadController* overloadController{ nullptr };
 	absl::flat_hash_map<std::string, RTC::WebRtcServer*> mapWebRtcServers;
 	absl::flat_hash_map<std::string, RTC::Router*> mapRouters;
 	// Others.
+	bool layersDowngraded{ false };
 	bool closed{ false };
 };
 
@@ -0,0 +1,51 @@
+#ifndef MS_FD_IMPORTER_HPP
+#define MS_FD_IMPORTER_HPP
+
+#include "common.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * Receives socket file descriptors from another worker process of the same
+ * user in the same host. It listens on a Unix socket in a private directory.
+ * The other worker sends the fds (SCM_RIGHTS) with Export() and, once that is
+ * done, this worker takes them with Import(), so none of them waits for the
+ * other.
+ */
+class FdImporter
+{
+public:
+	/**
+	 * Send the given fds to the FdImporter listening on the given path. The fds
+	 * are not closed.
+	 */
+	static void Export(const std::string& path, const std::vector<int>& fds);
+
+public:
+	FdImporter();
+	FdImporter& operator=(const FdImporter&) = delete;
+	FdImporter(const FdImporter&)            = delete;
+	~FdImporter();
+
+public:
+	/**
+	 * Take the fds already sent by Export(). It fails if they have not been
+	 * sent yet.
+	 */
+	std::vector<int> Import(size_t numFds);
+	const std::string& GetPath() const
+	{
+		return this->path;
+	}
+
+private:
+	void Close();
+
+private:
+	// Others.
+	int listenFd{ -1 };
+	std::string dirPath;
+	std::string path;
+};
+
+#endif
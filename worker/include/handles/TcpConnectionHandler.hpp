@@ -2,10 +2,12 @@
 #define MS_TCP_CONNECTION_HPP
 
 #include "common.hpp"
+#include "DepIoUring.hpp"
 #include <uv.h>
 #include <string>
+#include <vector>
 
-class TcpConnectionHandler
+class TcpConnectionHandler : public DepIoUring::RecvListener
 {
 protected:
 	using onSendCallback = const std::function<void(bool sent)>;
@@ -43,11 +45,20 @@ public:
 		TcpConnectionHandler::onSendCallback* cb{ nullptr };
 	};
 
+private:
+	/* Struct for each Write() queued in pendingData. */
+	struct PendingWrite
+	{
+		size_t len;
+		TcpConnectionHandler::onSendCallback* cb;
+		bool droppable;
+	};
+
 public:
 	explicit TcpConnectionHandler(size_t bufferSize);
 	TcpConnectionHandler& operator=(const TcpConnectionHandler&) = delete;
 	TcpConnectionHandler(const TcpConnectionHandler&)            = delete;
-	virtual ~TcpConnectionHandler();
+	~TcpConnectionHandler() override;
 
 public:
 	void Close();
@@ -66,12 +77,17 @@ public:
 		return this->uvHandle;
 	}
 	void Start();
+	// Data is queued and written (along with the rest of data queued in the
+	// same loop iteration) once the loop iteration ends. If too much data is
+	// queued, droppable data is dropped and, if still too much, the connection
+	// is closed.
 	void Write(
 	  const uint8_t* data1,
 	  size_t len1,
 	  const uint8_t* data2,
 	  size_t len2,
-	  TcpConnectionHandler::onSendCallback* cb);
+	  TcpConnectionHandler::onSendCallback* cb,
+	  bool droppable);
 	void ErrorReceiving();
 	const struct sockaddr* GetLocalAddress() const
 	{
@@ -112,12 +128,21 @@ public:
 
 private:
 	bool SetPeerAddress();
+	void SendPendingData();
+	void DropDroppablePendingData();
+	void DiscardPendingData();
 
 	/* Callbacks fired by UV events. */
 public:
 	void OnUvReadAlloc(size_t suggestedSize, uv_buf_t* buf);
 	void OnUvRead(ssize_t nread, const uv_buf_t* buf);
 	void OnUvWrite(int status, onSendCallback* cb);
+	void OnUvCheck();
+
+	/* Pure virtual methods inherited from DepIoUring::RecvListener. */
+public:
+	size_t OnIoUringRecv(const uint8_t* data, size_t len, const struct sockaddr* addr) override;
+	void OnIoUringRecvEnded(int error) override;
 
 	/* Pure virtual methods that must be implemented by the subclass. */
 protected:
@@ -141,9 +166,19 @@ private:
 	Listener* listener{ nullptr };
 	// Allocated by this.
 	uv_tcp_t* uvHandle{ nullptr };
+	uv_check_t* uvCheckHandle{ nullptr };
 	// Others.
 	struct sockaddr_storage* localAddr{ nullptr };
+	// Data queued in the current loop iteration and its writes.
+	std::vector<uint8_t> pendingData;
+	std::vector<PendingWrite> pendingWrites;
+	// Whether non droppable data did not fit in the queue so the connection
+	// must be closed.
+	bool overflowed{ false };
+	// Whether a uv_write() is in progress.
+	bool writing{ false };
 	bool closed{ false };
+	uint64_t ioUringRecvId{ 0u };
 	size_t recvBytes{ 0u };
 	size_t sentBytes{ 0u };
 	bool isClosedByPeer{ false };
@@ -2,10 +2,11 @@
 #define MS_UDP_SOCKET_HPP
 
 #include "common.hpp"
+#include "DepIoUring.hpp"
 #include <uv.h>
 #include <string>
 
-class UdpSocketHandler
+class UdpSocketHandler : public DepIoUring::RecvListener
 {
 protected:
 	using onSendCallback = const std::function<void(bool sent)>;
@@ -40,7 +41,7 @@ public:
 	explicit UdpSocketHandler(uv_udp_t* uvHandle);
 	UdpSocketHandler& operator=(const UdpSocketHandler&) = delete;
 	UdpSocketHandler(const UdpSocketHandler&)            = delete;
-	virtual ~UdpSocketHandler();
+	~UdpSocketHandler() override;
 
 public:
 	void Close();
@@ -49,6 +50,10 @@ public:
 		return this->closed;
 	}
 	virtual void Dump() const;
+	// Stops reading from the socket (it can still send).
+	void StopReceiving();
+	// Returns a duplicate of the socket fd, owned by the caller.
+	int DupFd() const;
 	void Send(
 	  const uint8_t* data, size_t len, const struct sockaddr* addr, UdpSocketHandler::onSendCallback* cb);
 	const struct sockaddr* GetLocalAddress() const
@@ -85,6 +90,11 @@ public:
 	void OnUvRecv(ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned int flags);
 	void OnUvSend(int status, UdpSocketHandler::onSendCallback* cb);
 
+	/* Pure virtual methods inherited from DepIoUring::RecvListener. */
+public:
+	size_t OnIoUringRecv(const uint8_t* data, size_t len, const struct sockaddr* addr) override;
+	void OnIoUringRecvEnded(int error) override;
+
 	/* Pure virtual methods that must be implemented by the subclass. */
 protected:
 	virtual void UserOnUdpDatagramReceived(
@@ -100,6 +110,8 @@ private:
 	uv_udp_t* uvHandle{ nullptr };
 	// Others.
 	bool closed{ false };
+	bool receiving{ true };
+	uint64_t ioUringRecvId{ 0u };
 	size_t recvBytes{ 0u };
 	size_t sentBytes{ 0u };
 };
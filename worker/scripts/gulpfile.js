@@ -7,6 +7,8 @@ const workerFiles =
 	'../include/**/*.hpp',
 	'../test/src/**/*.cpp',
 	'../test/include/helpers.hpp',
+	'../bench/src/**/*.cpp',
+	'../bench/include/**/*.hpp',
 	'../fuzzer/src/**/*.cpp',
 	'../fuzzer/include/**/*.hpp'
 ];
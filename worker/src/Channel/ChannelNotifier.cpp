@@ -33,6 +33,21 @@ namespace Channel
 		ChannelNotifier::channel->Send(jsonNotification);
 	}
 
+	void ChannelNotifier::Emit(uint64_t targetId, const char* event, json& data)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(ChannelNotifier::channel, "channel unset");
+
+		json jsonNotification = json::object();
+
+		jsonNotification["targetId"] = targetId;
+		jsonNotification["event"]    = event;
+		jsonNotification["data"]     = data;
+
+		ChannelNotifier::channel->Send(jsonNotification);
+	}
+
 	void ChannelNotifier::Emit(const std::string& targetId, const char* event)
 	{
 		MS_TRACE();
@@ -25,11 +25,13 @@ namespace Channel
 		{ "router.dump",                                 ChannelRequest::MethodId::ROUTER_DUMP                                      },
 		{ "router.createWebRtcTransport",                ChannelRequest::MethodId::ROUTER_CREATE_WEBRTC_TRANSPORT                   },
 		{ "router.createWebRtcTransportWithServer",      ChannelRequest::MethodId::ROUTER_CREATE_WEBRTC_TRANSPORT_WITH_SERVER       },
+		{ "router.prepareWebRtcTransportImport",         ChannelRequest::MethodId::ROUTER_PREPARE_WEBRTC_TRANSPORT_IMPORT           },
 		{ "router.createPlainTransport",                 ChannelRequest::MethodId::ROUTER_CREATE_PLAIN_TRANSPORT                    },
 		{ "router.createPipeTransport",                  ChannelRequest::MethodId::ROUTER_CREATE_PIPE_TRANSPORT                     },
 		{ "router.createDirectTransport",                ChannelRequest::MethodId::ROUTER_CREATE_DIRECT_TRANSPORT                   },
 		{ "router.createActiveSpeakerObserver",          ChannelRequest::MethodId::ROUTER_CREATE_ACTIVE_SPEAKER_OBSERVER            },
 		{ "router.createAudioLevelObserver",             ChannelRequest::MethodId::ROUTER_CREATE_AUDIO_LEVEL_OBSERVER               },
+		{ "router.bulkRequest",                          ChannelRequest::MethodId::ROUTER_BULK_REQUEST                              },
 		{ "transport.close",                             ChannelRequest::MethodId::TRANSPORT_CLOSE                                  },
 		{ "transport.dump",                              ChannelRequest::MethodId::TRANSPORT_DUMP                                   },
 		{ "transport.getStats",                          ChannelRequest::MethodId::TRANSPORT_GET_STATS                              },
@@ -37,6 +39,7 @@ namespace Channel
 		{ "transport.setMaxIncomingBitrate",             ChannelRequest::MethodId::TRANSPORT_SET_MAX_INCOMING_BITRATE               },
 		{ "transport.setMaxOutgoingBitrate",             ChannelRequest::MethodId::TRANSPORT_SET_MAX_OUTGOING_BITRATE               },
 		{ "transport.restartIce",                        ChannelRequest::MethodId::TRANSPORT_RESTART_ICE                            },
+		{ "transport.exportState",                       ChannelRequest::MethodId::TRANSPORT_EXPORT_STATE                           },
 		{ "transport.produce",                           ChannelRequest::MethodId::TRANSPORT_PRODUCE                                },
 		{ "transport.consume",                           ChannelRequest::MethodId::TRANSPORT_CONSUME                                },
 		{ "transport.produceData",                       ChannelRequest::MethodId::TRANSPORT_PRODUCE_DATA                           },
@@ -69,7 +72,9 @@ namespace Channel
 		{ "rtpObserver.pause",                           ChannelRequest::MethodId::RTP_OBSERVER_PAUSE                               },
 		{ "rtpObserver.resume",                          ChannelRequest::MethodId::RTP_OBSERVER_RESUME                              },
 		{ "rtpObserver.addProducer",                     ChannelRequest::MethodId::RTP_OBSERVER_ADD_PRODUCER                        },
-		{ "rtpObserver.removeProducer",                  ChannelRequest::MethodId::RTP_OBSERVER_REMOVE_PRODUCER                     }
+		{ "rtpObserver.removeProducer",                  ChannelRequest::MethodId::RTP_OBSERVER_REMOVE_PRODUCER                     },
+		{ "rtpObserver.addConsumer",                     ChannelRequest::MethodId::RTP_OBSERVER_ADD_CONSUMER                        },
+		{ "rtpObserver.removeConsumer",                  ChannelRequest::MethodId::RTP_OBSERVER_REMOVE_CONSUMER                     }
 	};
 	// clang-format on
 
@@ -138,7 +143,7 @@ namespace Channel
 		jsonResponse["id"]       = this->id;
 		jsonResponse["accepted"] = true;
 
-		this->channel->Send(jsonResponse);
+		Send(jsonResponse);
 	}
 
 	void ChannelRequest::Accept(json& data)
@@ -157,7 +162,7 @@ namespace Channel
 		if (data.is_structured())
 			jsonResponse["data"] = data;
 
-		this->channel->Send(jsonResponse);
+		Send(jsonResponse);
 	}
 
 	void ChannelRequest::Error(const char* reason)
@@ -176,7 +181,7 @@ namespace Channel
 		if (reason != nullptr)
 			jsonResponse["reason"] = reason;
 
-		this->channel->Send(jsonResponse);
+		Send(jsonResponse);
 	}
 
 	void ChannelRequest::TypeError(const char* reason)
@@ -195,6 +200,16 @@ namespace Channel
 		if (reason != nullptr)
 			jsonResponse["reason"] = reason;
 
-		this->channel->Send(jsonResponse);
+		Send(jsonResponse);
+	}
+
+	inline void ChannelRequest::Send(json& jsonResponse)
+	{
+		MS_TRACE();
+
+		if (this->channel)
+			this->channel->Send(jsonResponse);
+		else
+			this->response = jsonResponse;
 	}
 } // namespace Channel
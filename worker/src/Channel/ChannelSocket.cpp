@@ -157,6 +157,55 @@ namespace Channel
 		SendImpl(reinterpret_cast<const uint8_t*>(message), messageLen);
 	}
 
+	void ChannelSocket::SendLogs(const std::vector<std::string>& messages)
+	{
+		MS_TRACE_STD();
+
+		if (this->closed)
+			return;
+
+		// Write using function call if provided.
+		if (this->channelWriteFn)
+		{
+			for (const auto& message : messages)
+			{
+				SendLog(message.c_str(), static_cast<uint32_t>(message.length()));
+			}
+
+			return;
+		}
+
+		// Otherwise write as many messages as possible at once.
+		size_t len{ 0u };
+
+		for (const auto& message : messages)
+		{
+			if (message.length() > PayloadMaxLen)
+			{
+				MS_ERROR_STD("message too big");
+
+				continue;
+			}
+
+			auto messageLen = static_cast<uint32_t>(message.length());
+
+			if (len + sizeof(uint32_t) + messageLen > MessageMaxLen)
+			{
+				this->producerSocket->Write(this->writeBuffer, len);
+
+				len = 0u;
+			}
+
+			std::memcpy(this->writeBuffer + len, &messageLen, sizeof(uint32_t));
+			std::memcpy(this->writeBuffer + len + sizeof(uint32_t), message.c_str(), messageLen);
+
+			len += sizeof(uint32_t) + messageLen;
+		}
+
+		if (len != 0u)
+			this->producerSocket->Write(this->writeBuffer, len);
+	}
+
 	bool ChannelSocket::CallbackRead()
 	{
 		MS_TRACE_STD();
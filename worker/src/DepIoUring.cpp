@@ -0,0 +1,905 @@
+#define MS_CLASS "DepIoUring"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "DepIoUring.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "Settings.hpp"
+#ifdef MS_IO_URING_SUPPORTED
+#include <absl/container/flat_hash_map.h>
+#include <algorithm> // std::max()
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring> // std::memset(), std::memcpy(), std::strerror()
+#include <vector>
+#endif
+
+/* Static variables. */
+
+thread_local bool DepIoUring::enabled{ false };
+
+#ifdef MS_IO_URING_SUPPORTED
+
+/* Static. */
+
+static constexpr uint32_t SqEntries{ 1024u };
+// Multishot receive requests may post many CQEs per loop iteration.
+static constexpr uint32_t CqEntries{ 16384u };
+static constexpr uint32_t NumSendSlots{ 2048u };
+// Larger datagrams are sent through libuv.
+static constexpr size_t SendSlotSize{ 1600u };
+// Must be a power of 2.
+static constexpr uint16_t NumRecvBuffers{ 128u };
+// Same max datagram size as libuv (UV__UDP_DGRAM_MAXSIZE) plus the
+// io_uring_recvmsg_out header and the source address of received datagrams.
+static constexpr uint32_t RecvBufferSize{ 65536u + sizeof(struct io_uring_recvmsg_out) +
+                                          sizeof(struct sockaddr_storage) };
+static constexpr uint16_t RecvBufferGroupId{ 0u };
+
+// The request type is stored in the 2 lower bits of the SQE/CQE user_data.
+enum class RequestType : uint64_t
+{
+	RECV   = 0u,
+	SEND   = 1u,
+	CANCEL = 2u
+};
+
+struct Registration
+{
+	int fd{ -1 };
+	bool isStream{ false };
+	struct msghdr msg;
+	DepIoUring::RecvListener* listener{ nullptr };
+};
+
+struct SendSlot
+{
+	struct msghdr msg;
+	struct iovec iov;
+	struct sockaddr_storage addr;
+	DepIoUring::onSendCallback* cb{ nullptr };
+	// Whether the request was turned into a NOP before being submitted.
+	bool cancelled{ false };
+};
+
+struct Ring
+{
+	int fd{ -1 };
+	int eventFd{ -1 };
+	// Submission queue (shared with the kernel).
+	uint8_t* ringPtr{ nullptr };
+	size_t ringSize{ 0u };
+	uint32_t* sqHead{ nullptr };
+	uint32_t* sqTail{ nullptr };
+	uint32_t* sqFlags{ nullptr };
+	uint32_t sqMask{ 0u };
+	uint32_t sqEntries{ 0u };
+	struct io_uring_sqe* sqes{ nullptr };
+	size_t sqesSize{ 0u };
+	// Local SQ tail and number of SQEs not yet submitted.
+	uint32_t sqeTail{ 0u };
+	uint32_t numPendingSqes{ 0u };
+	// Completion queue (shared with the kernel).
+	uint32_t* cqHead{ nullptr };
+	uint32_t* cqTail{ nullptr };
+	uint32_t cqMask{ 0u };
+	struct io_uring_cqe* cqes{ nullptr };
+	// Ring of provided receive buffers (shared with the kernel).
+	struct io_uring_buf_ring* bufRing{ nullptr };
+	size_t bufRingSize{ 0u };
+	uint16_t bufRingTail{ 0u };
+	uint8_t* recvBuffers{ nullptr };
+	// Send slots.
+	std::vector<SendSlot> sendSlots;
+	std::vector<uint32_t> freeSendSlots;
+	uint8_t* sendBuffers{ nullptr };
+	// Receive requests indexed by id.
+	absl::flat_hash_map<uint64_t, Registration*> registrations;
+	uint64_t nextRecvId{ 1u };
+	uv_poll_t* uvPoll{ nullptr };
+	uv_prepare_t* uvPrepare{ nullptr };
+};
+
+thread_local static Ring* ring{ nullptr };
+
+inline static uint64_t getUserData(RequestType type, uint64_t value)
+{
+	return (value << 2) | static_cast<uint64_t>(type);
+}
+
+inline static int ioUringSetup(uint32_t entries, struct io_uring_params* params)
+{
+	return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline static int ioUringEnter(int fd, uint32_t toSubmit, uint32_t minComplete, uint32_t flags)
+{
+	return static_cast<int>(
+	  syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+inline static int ioUringRegister(int fd, uint32_t opcode, void* arg, uint32_t numArgs)
+{
+	return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, numArgs));
+}
+
+static void destroyRing()
+{
+	// NOTE: Closing the ring fd cancels all the pending requests, so do it
+	// before freeing the memory given to them.
+	if (ring->fd != -1)
+		close(ring->fd);
+
+	if (ring->eventFd != -1)
+		close(ring->eventFd);
+
+	if (ring->ringPtr)
+		munmap(ring->ringPtr, ring->ringSize);
+
+	if (ring->sqes)
+		munmap(ring->sqes, ring->sqesSize);
+
+	if (ring->bufRing)
+		munmap(ring->bufRing, ring->bufRingSize);
+
+	for (auto& slot : ring->sendSlots)
+	{
+		delete slot.cb;
+	}
+
+	for (auto& kv : ring->registrations)
+	{
+		delete kv.second;
+	}
+
+	delete[] ring->recvBuffers;
+	delete[] ring->sendBuffers;
+
+	delete ring;
+
+	ring = nullptr;
+}
+
+inline static void recycleRecvBuffer(uint16_t bid)
+{
+	auto mask = static_cast<uint16_t>(NumRecvBuffers - 1u);
+	// NOTE: Don't use bufRing->bufs, its offset is wrong in C++ (the flexible
+	// array is preceded by an empty struct, which is not zero sized in C++).
+	auto& buf =
+	  reinterpret_cast<struct io_uring_buf*>(ring->bufRing)[ring->bufRingTail & mask];
+
+	// NOTE: Don't touch buf.resv, it overlays the ring tail in the first entry.
+	buf.addr = reinterpret_cast<uint64_t>(ring->recvBuffers + (size_t{ bid } * RecvBufferSize));
+	buf.len  = RecvBufferSize;
+	buf.bid  = bid;
+
+	++ring->bufRingTail;
+
+	__atomic_store_n(std::addressof(ring->bufRing->tail), ring->bufRingTail, __ATOMIC_RELEASE);
+}
+
+// Kernels lacking multishot receive (added in Linux 6.0 along with the
+// IORING_OP_SEND_ZC operation) would fail every receive request.
+static bool isMultishotRecvSupported(int fd)
+{
+	size_t numOps{ 256u };
+	std::vector<uint8_t> storage(
+	  sizeof(struct io_uring_probe) + (numOps * sizeof(struct io_uring_probe_op)));
+	auto* probe = reinterpret_cast<struct io_uring_probe*>(storage.data());
+
+	if (ioUringRegister(fd, IORING_REGISTER_PROBE, probe, numOps) != 0)
+		return false;
+
+	if (probe->last_op < IORING_OP_SEND_ZC)
+		return false;
+
+	return (probe->ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+static bool createRing()
+{
+	MS_TRACE();
+
+	ring = new Ring();
+
+	struct io_uring_params params; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	std::memset(std::addressof(params), 0, sizeof(params));
+
+	params.flags      = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER;
+	params.cq_entries = CqEntries;
+
+	ring->fd = ioUringSetup(SqEntries, std::addressof(params));
+
+	if (ring->fd < 0)
+	{
+		MS_WARN_TAG(info, "io_uring_setup() failed: %s", std::strerror(errno));
+
+		ring->fd = -1;
+		destroyRing();
+
+		return false;
+	}
+
+	if (
+	  (params.features & IORING_FEAT_SINGLE_MMAP) == 0 ||
+	  (params.features & IORING_FEAT_NODROP) == 0 || !isMultishotRecvSupported(ring->fd))
+	{
+		MS_WARN_TAG(info, "io_uring features not supported by the kernel");
+
+		destroyRing();
+
+		return false;
+	}
+
+	// Map the SQ and CQ rings (a single mapping) and the SQE array.
+	ring->ringSize = std::max(
+	  params.sq_off.array + (params.sq_entries * sizeof(uint32_t)),
+	  params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe)));
+
+	void* ringPtr = mmap(
+	  nullptr,
+	  ring->ringSize,
+	  PROT_READ | PROT_WRITE,
+	  MAP_SHARED | MAP_POPULATE,
+	  ring->fd,
+	  IORING_OFF_SQ_RING);
+
+	if (ringPtr == MAP_FAILED)
+	{
+		MS_WARN_TAG(info, "mmap() of io_uring rings failed: %s", std::strerror(errno));
+
+		destroyRing();
+
+		return false;
+	}
+
+	ring->ringPtr  = static_cast<uint8_t*>(ringPtr);
+	ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	void* sqesPtr = mmap(
+	  nullptr,
+	  ring->sqesSize,
+	  PROT_READ | PROT_WRITE,
+	  MAP_SHARED | MAP_POPULATE,
+	  ring->fd,
+	  IORING_OFF_SQES);
+
+	if (sqesPtr == MAP_FAILED)
+	{
+		MS_WARN_TAG(info, "mmap() of io_uring SQEs failed: %s", std::strerror(errno));
+
+		destroyRing();
+
+		return false;
+	}
+
+	ring->sqes      = static_cast<struct io_uring_sqe*>(sqesPtr);
+	ring->sqHead    = reinterpret_cast<uint32_t*>(ring->ringPtr + params.sq_off.head);
+	ring->sqTail    = reinterpret_cast<uint32_t*>(ring->ringPtr + params.sq_off.tail);
+	ring->sqFlags   = reinterpret_cast<uint32_t*>(ring->ringPtr + params.sq_off.flags);
+	ring->sqMask    = *reinterpret_cast<uint32_t*>(ring->ringPtr + params.sq_off.ring_mask);
+	ring->sqEntries = params.sq_entries;
+	ring->cqHead    = reinterpret_cast<uint32_t*>(ring->ringPtr + params.cq_off.head);
+	ring->cqTail    = reinterpret_cast<uint32_t*>(ring->ringPtr + params.cq_off.tail);
+	ring->cqMask    = *reinterpret_cast<uint32_t*>(ring->ringPtr + params.cq_off.ring_mask);
+	ring->cqes      = reinterpret_cast<struct io_uring_cqe*>(ring->ringPtr + params.cq_off.cqes);
+	ring->sqeTail   = *ring->sqTail;
+
+	// SQ array entries map 1:1 to SQEs.
+	auto* sqArray = reinterpret_cast<uint32_t*>(ring->ringPtr + params.sq_off.array);
+
+	for (uint32_t idx{ 0u }; idx < params.sq_entries; ++idx)
+	{
+		sqArray[idx] = idx;
+	}
+
+	// Register the eventfd signaled on every completion.
+	ring->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (ring->eventFd == -1)
+	{
+		MS_WARN_TAG(info, "eventfd() failed: %s", std::strerror(errno));
+
+		destroyRing();
+
+		return false;
+	}
+
+	if (ioUringRegister(ring->fd, IORING_REGISTER_EVENTFD, std::addressof(ring->eventFd), 1) != 0)
+	{
+		MS_WARN_TAG(info, "io_uring eventfd registration failed: %s", std::strerror(errno));
+
+		destroyRing();
+
+		return false;
+	}
+
+	// Register the ring of provided receive buffers.
+	ring->bufRingSize = NumRecvBuffers * sizeof(struct io_uring_buf);
+
+	void* bufRingPtr =
+	  mmap(nullptr, ring->bufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (bufRingPtr == MAP_FAILED)
+	{
+		MS_WARN_TAG(info, "mmap() of io_uring buffer ring failed: %s", std::strerror(errno));
+
+		destroyRing();
+
+		return false;
+	}
+
+	ring->bufRing = static_cast<struct io_uring_buf_ring*>(bufRingPtr);
+
+	struct io_uring_buf_reg bufReg; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	std::memset(std::addressof(bufReg), 0, sizeof(bufReg));
+
+	bufReg.ring_addr    = reinterpret_cast<uint64_t>(bufRingPtr);
+	bufReg.ring_entries = NumRecvBuffers;
+	bufReg.bgid         = RecvBufferGroupId;
+
+	if (ioUringRegister(ring->fd, IORING_REGISTER_PBUF_RING, std::addressof(bufReg), 1) != 0)
+	{
+		MS_WARN_TAG(info, "io_uring buffer ring registration failed: %s", std::strerror(errno));
+
+		destroyRing();
+
+		return false;
+	}
+
+	ring->recvBuffers = new uint8_t[size_t{ NumRecvBuffers } * RecvBufferSize];
+
+	for (uint16_t bid{ 0u }; bid < NumRecvBuffers; ++bid)
+	{
+		recycleRecvBuffer(bid);
+	}
+
+	// Allocate the send slots.
+	ring->sendBuffers = new uint8_t[size_t{ NumSendSlots } * SendSlotSize];
+	ring->sendSlots.resize(NumSendSlots);
+	ring->freeSendSlots.reserve(NumSendSlots);
+
+	for (uint32_t idx{ 0u }; idx < NumSendSlots; ++idx)
+	{
+		auto& slot = ring->sendSlots[idx];
+
+		std::memset(std::addressof(slot.msg), 0, sizeof(slot.msg));
+
+		slot.iov.iov_base   = ring->sendBuffers + (size_t{ idx } * SendSlotSize);
+		slot.msg.msg_name   = std::addressof(slot.addr);
+		slot.msg.msg_iov    = std::addressof(slot.iov);
+		slot.msg.msg_iovlen = 1;
+
+		// Use the lower indexes first.
+		ring->freeSendSlots.push_back(NumSendSlots - 1u - idx);
+	}
+
+	return true;
+}
+
+static void submit()
+{
+	if (ring->numPendingSqes == 0u)
+		return;
+
+	__atomic_store_n(ring->sqTail, ring->sqeTail, __ATOMIC_RELEASE);
+
+	int ret = ioUringEnter(ring->fd, ring->numPendingSqes, 0u, 0u);
+
+	// NOTE: It fails with EAGAIN or EBUSY if the kernel is short of resources
+	// or has overflown CQEs, so just retry in the next loop iteration.
+	if (ret < 0)
+	{
+		MS_DEBUG_DEV("io_uring_enter() failed: %s", std::strerror(errno));
+
+		return;
+	}
+
+	ring->numPendingSqes -= static_cast<uint32_t>(ret);
+}
+
+// Returns a zeroed SQE or nullptr if the SQ is full.
+static struct io_uring_sqe* getSqe()
+{
+	auto head = __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+
+	if (ring->sqeTail - head >= ring->sqEntries)
+	{
+		submit();
+
+		head = __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+
+		if (ring->sqeTail - head >= ring->sqEntries)
+			return nullptr;
+	}
+
+	auto* sqe = std::addressof(ring->sqes[ring->sqeTail & ring->sqMask]);
+
+	++ring->sqeTail;
+	++ring->numPendingSqes;
+
+	std::memset(sqe, 0, sizeof(struct io_uring_sqe));
+
+	return sqe;
+}
+
+static bool armRecv(uint64_t id, Registration* registration)
+{
+	auto* sqe = getSqe();
+
+	if (!sqe)
+		return false;
+
+	sqe->fd        = registration->fd;
+	sqe->flags     = IOSQE_BUFFER_SELECT;
+	sqe->ioprio    = IORING_RECV_MULTISHOT;
+	sqe->buf_group = RecvBufferGroupId;
+	sqe->user_data = getUserData(RequestType::RECV, id);
+
+	if (registration->isStream)
+	{
+		sqe->opcode = IORING_OP_RECV;
+	}
+	else
+	{
+		sqe->opcode = IORING_OP_RECVMSG;
+		sqe->addr   = reinterpret_cast<uint64_t>(std::addressof(registration->msg));
+		sqe->len    = 1u;
+	}
+
+	return true;
+}
+
+static void deliver(
+  uint64_t id,
+  DepIoUring::RecvListener* listener,
+  const uint8_t* data,
+  size_t len,
+  const struct sockaddr* addr)
+{
+	while (true)
+	{
+		auto consumed = listener->OnIoUringRecv(data, len, addr);
+
+		if (consumed >= len)
+			return;
+
+		// The receiving may have been stopped (and the listener deleted) meanwhile.
+		if (ring->registrations.find(id) == ring->registrations.end())
+			return;
+
+		if (consumed == 0u)
+		{
+			MS_ERROR("listener did not consume any data, discarding %zu bytes", len);
+
+			return;
+		}
+
+		data += consumed;
+		len -= consumed;
+	}
+}
+
+static void onRecvCompletion(uint64_t id, int32_t res, uint32_t flags)
+{
+	bool hasBuffer = (flags & IORING_CQE_F_BUFFER) != 0u;
+	auto bid       = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+	auto it        = ring->registrations.find(id);
+
+	// Receiving stopped.
+	if (it == ring->registrations.end())
+	{
+		if (hasBuffer)
+			recycleRecvBuffer(bid);
+
+		return;
+	}
+
+	auto* registration = it->second;
+
+	if (res > 0 && hasBuffer)
+	{
+		uint8_t* buffer = ring->recvBuffers + (size_t{ bid } * RecvBufferSize);
+
+		if (registration->isStream)
+		{
+			deliver(id, registration->listener, buffer, static_cast<size_t>(res), nullptr);
+		}
+		else
+		{
+			auto* out = reinterpret_cast<struct io_uring_recvmsg_out*>(buffer);
+			auto* addr =
+			  reinterpret_cast<const struct sockaddr*>(buffer + sizeof(struct io_uring_recvmsg_out));
+			uint8_t* payload = buffer + sizeof(struct io_uring_recvmsg_out) +
+			                   registration->msg.msg_namelen + registration->msg.msg_controllen;
+
+			if ((out->flags & MSG_TRUNC) != 0u)
+			{
+				MS_ERROR("received datagram was truncated due to insufficient buffer, ignoring it");
+			}
+			// NOTE: Ignore empty datagrams.
+			else if (out->payloadlen > 0u)
+			{
+				deliver(id, registration->listener, payload, out->payloadlen, addr);
+			}
+		}
+
+		recycleRecvBuffer(bid);
+	}
+	else if (hasBuffer)
+	{
+		recycleRecvBuffer(bid);
+	}
+
+	// The multishot request is still active.
+	if ((flags & IORING_CQE_F_MORE) != 0u)
+		return;
+
+	// The listener may have stopped the receiving.
+	it = ring->registrations.find(id);
+
+	if (it == ring->registrations.end())
+		return;
+
+	registration = it->second;
+
+	// Rearm the request if it terminated because it ran out of buffers or
+	// because the kernel decided to stop it (but not on stream EOF or error).
+	if (res > 0 || res == -ENOBUFS)
+	{
+		if (armRecv(id, registration))
+			return;
+
+		res = -EBUSY;
+	}
+
+	auto* listener = registration->listener;
+
+	ring->registrations.erase(it);
+	delete registration;
+
+	listener->OnIoUringRecvEnded(res);
+}
+
+static void onSendCompletion(uint32_t idx, int32_t res)
+{
+	auto& slot = ring->sendSlots[idx];
+	auto* cb   = slot.cb;
+	bool sent  = res >= 0 && !slot.cancelled;
+
+	slot.cb        = nullptr;
+	slot.cancelled = false;
+
+	// Release the slot before calling the callback, which may send again.
+	ring->freeSendSlots.push_back(idx);
+
+	if (res < 0)
+		MS_DEBUG_DEV("send error: %s", std::strerror(-res));
+
+	if (cb)
+	{
+		(*cb)(sent);
+		delete cb;
+	}
+}
+
+static void processCompletions()
+{
+	bool overflowFlushed{ false };
+
+	while (true)
+	{
+		auto head = *ring->cqHead;
+		auto tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+
+		if (head == tail)
+		{
+			// Flush CQEs the kernel could not post because the CQ ring was full.
+			// clang-format off
+			if (
+				!overflowFlushed &&
+				(__atomic_load_n(ring->sqFlags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) != 0u
+			)
+			// clang-format on
+			{
+				overflowFlushed = true;
+
+				ioUringEnter(ring->fd, 0u, 0u, IORING_ENTER_GETEVENTS);
+
+				continue;
+			}
+
+			break;
+		}
+
+		const auto* cqe = std::addressof(ring->cqes[head & ring->cqMask]);
+		auto userData   = cqe->user_data;
+		auto res        = cqe->res;
+		auto flags      = cqe->flags;
+
+		// Release the CQE before processing it since it may take long.
+		__atomic_store_n(ring->cqHead, head + 1u, __ATOMIC_RELEASE);
+
+		switch (static_cast<RequestType>(userData & 0x03u))
+		{
+			case RequestType::RECV:
+			{
+				onRecvCompletion(userData >> 2, res, flags);
+
+				break;
+			}
+
+			case RequestType::SEND:
+			{
+				onSendCompletion(static_cast<uint32_t>(userData >> 2), res);
+
+				break;
+			}
+
+			case RequestType::CANCEL:
+			{
+				break;
+			}
+		}
+	}
+}
+
+/* Static methods for UV callbacks. */
+
+inline static void onPoll(uv_poll_t* /*handle*/, int /*status*/, int /*events*/)
+{
+	uint64_t value;
+
+	// Reset the eventfd counter before reaping so no completion is missed.
+	if (read(ring->eventFd, std::addressof(value), sizeof(value)) == -1 && errno != EAGAIN)
+		MS_DEBUG_DEV("eventfd read() failed: %s", std::strerror(errno));
+
+	processCompletions();
+}
+
+inline static void onPrepare(uv_prepare_t* /*handle*/)
+{
+	// Submit all the requests queued within this loop iteration.
+	submit();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
+
+#endif
+
+/* Static methods. */
+
+void DepIoUring::ClassInit()
+{
+	MS_TRACE();
+
+	if (!Settings::configuration.useIoUring)
+		return;
+
+#ifdef MS_IO_URING_SUPPORTED
+	if (!createRing())
+	{
+		MS_WARN_TAG(info, "io_uring not available, using libuv I/O");
+
+		return;
+	}
+
+	ring->uvPoll    = new uv_poll_t;
+	ring->uvPrepare = new uv_prepare_t;
+
+	uv_poll_init(DepLibUV::GetLoop(), ring->uvPoll, ring->eventFd);
+	uv_poll_start(ring->uvPoll, UV_READABLE, static_cast<uv_poll_cb>(onPoll));
+	uv_prepare_init(DepLibUV::GetLoop(), ring->uvPrepare);
+	uv_prepare_start(ring->uvPrepare, static_cast<uv_prepare_cb>(onPrepare));
+
+	// Don't keep the loop alive, sockets do.
+	uv_unref(reinterpret_cast<uv_handle_t*>(ring->uvPoll));
+	uv_unref(reinterpret_cast<uv_handle_t*>(ring->uvPrepare));
+
+	DepIoUring::enabled = true;
+
+	MS_DEBUG_TAG(info, "io_uring I/O enabled");
+#else
+	MS_WARN_TAG(info, "io_uring not supported in this build, using libuv I/O");
+#endif
+}
+
+void DepIoUring::ClassDestroy()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	if (!ring)
+		return;
+
+	// Submit pending sends.
+	submit();
+
+	uv_close(reinterpret_cast<uv_handle_t*>(ring->uvPoll), static_cast<uv_close_cb>(onClose));
+	uv_close(reinterpret_cast<uv_handle_t*>(ring->uvPrepare), static_cast<uv_close_cb>(onClose));
+
+	destroyRing();
+
+	DepIoUring::enabled = false;
+#endif
+}
+
+uint64_t DepIoUring::StartRecv(uv_handle_t* handle, RecvListener* listener)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	if (!ring)
+		return 0u;
+
+	uv_os_fd_t fd;
+
+	if (uv_fileno(handle, std::addressof(fd)) != 0)
+		return 0u;
+
+	auto* registration = new Registration();
+	auto id            = ring->nextRecvId++;
+
+	std::memset(std::addressof(registration->msg), 0, sizeof(registration->msg));
+
+	registration->fd              = fd;
+	registration->isStream        = handle->type == UV_TCP;
+	registration->listener        = listener;
+	registration->msg.msg_namelen = sizeof(struct sockaddr_storage);
+
+	if (!armRecv(id, registration))
+	{
+		delete registration;
+
+		return 0u;
+	}
+
+	ring->registrations[id] = registration;
+
+	return id;
+#else
+	return 0u;
+#endif
+}
+
+void DepIoUring::StopRecv(uint64_t id)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	if (!ring)
+		return;
+
+	auto it = ring->registrations.find(id);
+
+	if (it == ring->registrations.end())
+		return;
+
+	delete it->second;
+	ring->registrations.erase(it);
+
+	// Cancel the multishot request right now since it holds a reference to the
+	// socket, which otherwise would not be closed.
+	auto* sqe = getSqe();
+
+	if (!sqe)
+	{
+		MS_ERROR("cannot cancel io_uring receive request, SQ is full");
+
+		return;
+	}
+
+	sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+	sqe->addr      = getUserData(RequestType::RECV, id);
+	sqe->user_data = getUserData(RequestType::CANCEL, 0u);
+
+	submit();
+#endif
+}
+
+bool DepIoUring::PrepareSend(
+  uv_udp_t* handle,
+  const uint8_t* data,
+  size_t len,
+  const struct sockaddr* addr,
+  DepIoUring::onSendCallback* cb)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	if (!ring || !addr || len > SendSlotSize || ring->freeSendSlots.empty())
+		return false;
+
+	uv_os_fd_t fd;
+
+	if (uv_fileno(reinterpret_cast<uv_handle_t*>(handle), std::addressof(fd)) != 0)
+		return false;
+
+	auto* sqe = getSqe();
+
+	if (!sqe)
+		return false;
+
+	auto idx   = ring->freeSendSlots.back();
+	auto& slot = ring->sendSlots[idx];
+
+	ring->freeSendSlots.pop_back();
+
+	std::memcpy(slot.iov.iov_base, data, len);
+
+	slot.iov.iov_len = len;
+	slot.msg.msg_namelen =
+	  addr->sa_family == AF_INET6 ? sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in);
+	std::memcpy(std::addressof(slot.addr), addr, slot.msg.msg_namelen);
+	slot.cb = cb;
+
+	sqe->opcode    = IORING_OP_SENDMSG;
+	sqe->fd        = fd;
+	sqe->addr      = reinterpret_cast<uint64_t>(std::addressof(slot.msg));
+	sqe->len       = 1u;
+	sqe->user_data = getUserData(RequestType::SEND, idx);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void DepIoUring::SubmitSends()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	if (!ring)
+		return;
+
+	submit();
+#endif
+}
+
+void DepIoUring::FlushSends(uv_udp_t* handle)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	if (!ring)
+		return;
+
+	submit();
+
+	if (ring->numPendingSqes == 0u)
+		return;
+
+	uv_os_fd_t fd;
+
+	if (uv_fileno(reinterpret_cast<uv_handle_t*>(handle), std::addressof(fd)) != 0)
+		return;
+
+	// The kernel did not take them, so turn those of this socket into NOPs to
+	// be completed (as not sent) once submitted.
+	for (auto tail = ring->sqeTail - ring->numPendingSqes; tail != ring->sqeTail; ++tail)
+	{
+		auto* sqe = std::addressof(ring->sqes[tail & ring->sqMask]);
+
+		if (sqe->opcode != IORING_OP_SENDMSG || sqe->fd != fd)
+			continue;
+
+		ring->sendSlots[static_cast<uint32_t>(sqe->user_data >> 2)].cancelled = true;
+
+		sqe->opcode = IORING_OP_NOP;
+		sqe->fd     = -1;
+		sqe->addr   = 0u;
+		sqe->len    = 0u;
+	}
+#endif
+}
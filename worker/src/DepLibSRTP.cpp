@@ -10,6 +10,7 @@
 
 static std::mutex globalSyncMutex;
 static size_t globalInstances = 0;
+static bool globalInitialized = false;
 
 // clang-format off
 std::vector<const char*> DepLibSRTP::errors =
@@ -49,19 +50,12 @@ void DepLibSRTP::ClassInit()
 {
 	MS_TRACE();
 
+	// NOTE: libsrtp is initialized on demand (see EnsureInitialized()) since
+	// srtp_init() runs self tests of every cipher and auth function, which
+	// slows down the worker startup.
 	{
 		std::lock_guard<std::mutex> lock(globalSyncMutex);
 
-		if (globalInstances == 0)
-		{
-			MS_DEBUG_TAG(info, "libsrtp version: \"%s\"", srtp_get_version_string());
-
-			srtp_err_status_t err = srtp_init();
-
-			if (DepLibSRTP::IsError(err))
-				MS_THROW_ERROR("srtp_init() failed: %s", DepLibSRTP::GetErrorString(err));
-		}
-
 		++globalInstances;
 	}
 }
@@ -74,9 +68,32 @@ void DepLibSRTP::ClassDestroy()
 		std::lock_guard<std::mutex> lock(globalSyncMutex);
 		--globalInstances;
 
-		if (globalInstances == 0)
+		if (globalInstances == 0 && globalInitialized)
 		{
 			srtp_shutdown();
+
+			globalInitialized = false;
+		}
+	}
+}
+
+void DepLibSRTP::EnsureInitialized()
+{
+	MS_TRACE();
+
+	{
+		std::lock_guard<std::mutex> lock(globalSyncMutex);
+
+		if (!globalInitialized)
+		{
+			MS_DEBUG_TAG(info, "libsrtp version: \"%s\"", srtp_get_version_string());
+
+			srtp_err_status_t err = srtp_init();
+
+			if (DepLibSRTP::IsError(err))
+				MS_THROW_ERROR("srtp_init() failed: %s", DepLibSRTP::GetErrorString(err));
+
+			globalInitialized = true;
 		}
 	}
 }
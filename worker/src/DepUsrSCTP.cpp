@@ -12,6 +12,7 @@
 static constexpr size_t CheckerInterval{ 10u }; // In ms.
 static std::mutex GlobalSyncMutex;
 static size_t GlobalInstances{ 0u };
+static bool GlobalInitialized{ false };
 
 /* Static methods for usrsctp global callbacks. */
 
@@ -63,22 +64,10 @@ void DepUsrSCTP::ClassInit()
 {
 	MS_TRACE();
 
-	MS_DEBUG_TAG(info, "usrsctp");
-
+	// NOTE: usrsctp is initialized on demand (see GetNextSctpAssociationId())
+	// so workers not using SCTP don't pay for it.
 	std::lock_guard<std::mutex> lock(GlobalSyncMutex);
 
-	if (GlobalInstances == 0)
-	{
-		usrsctp_init_nothreads(0, onSendSctpData, sctpDebug);
-
-		// Disable explicit congestion notifications (ecn).
-		usrsctp_sysctl_set_sctp_ecn_enable(0);
-
-#ifdef SCTP_DEBUG
-		usrsctp_sysctl_set_sctp_debug_on(SCTP_DEBUG_ALL);
-#endif
-	}
-
 	++GlobalInstances;
 }
 
@@ -89,10 +78,12 @@ void DepUsrSCTP::ClassDestroy()
 	std::lock_guard<std::mutex> lock(GlobalSyncMutex);
 	--GlobalInstances;
 
-	if (GlobalInstances == 0)
+	if (GlobalInstances == 0 && GlobalInitialized)
 	{
 		usrsctp_finish();
 
+		GlobalInitialized = false;
+
 		numSctpAssociations   = 0u;
 		nextSctpAssociationId = 0u;
 
@@ -124,6 +115,24 @@ uintptr_t DepUsrSCTP::GetNextSctpAssociationId()
 
 	std::lock_guard<std::mutex> lock(GlobalSyncMutex);
 
+	// Initialize usrsctp once the first SctpAssociation in the process is
+	// created.
+	if (!GlobalInitialized)
+	{
+		MS_DEBUG_TAG(info, "usrsctp");
+
+		usrsctp_init_nothreads(0, onSendSctpData, sctpDebug);
+
+		// Disable explicit congestion notifications (ecn).
+		usrsctp_sysctl_set_sctp_ecn_enable(0);
+
+#ifdef SCTP_DEBUG
+		usrsctp_sysctl_set_sctp_debug_on(SCTP_DEBUG_ALL);
+#endif
+
+		GlobalInitialized = true;
+	}
+
 	// NOTE: usrsctp_connect() fails with a value of 0.
 	if (DepUsrSCTP::nextSctpAssociationId == 0u)
 		++DepUsrSCTP::nextSctpAssociationId;
@@ -0,0 +1,410 @@
+#define MS_CLASS "LogRing"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "LogRing.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Channel/ChannelSocket.hpp"
+#include <algorithm> // std::min()
+#include <chrono>
+#include <cinttypes> // PRIu64
+#include <cstdio>    // std::snprintf()
+#include <iterator>  // std::make_move_iterator()
+#include <limits>    // std::numeric_limits()
+#include <utility>   // std::swap()
+
+/* Static methods for UV callbacks. */
+
+inline static void onAsync(uv_async_t* handle)
+{
+	static_cast<LogRing*>(handle->data)->OnUvAsync();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_async_t*>(handle);
+}
+
+/* Static. */
+
+// Time (in ms) the background thread sleeps once the ring is empty.
+static constexpr uint64_t IdleInterval{ 5u };
+// Max length of a formatted line.
+static constexpr size_t LineMaxLen{ 4096u };
+// Max number of formatted lines waiting to be sent within the loop thread.
+static constexpr size_t MaxPendingLines{ 8192u };
+
+struct ArgValue
+{
+	LogRing::ArgType type;
+	int64_t intValue;
+	uint64_t uintValue;
+	double doubleValue;
+	const char* stringValue;
+	const void* pointerValue;
+};
+
+// Reads the next argument of the entry. Returns false if there is no more.
+static bool readArg(const LogRing::Entry& entry, size_t& pos, ArgValue& value)
+{
+	if (pos >= entry.argsLen)
+		return false;
+
+	value.type = static_cast<LogRing::ArgType>(entry.args[pos++]);
+
+	switch (value.type)
+	{
+		case LogRing::ArgType::INT:
+		{
+			std::memcpy(&value.intValue, entry.args + pos, sizeof(int64_t));
+			pos += sizeof(int64_t);
+
+			value.uintValue   = static_cast<uint64_t>(value.intValue);
+			value.doubleValue = static_cast<double>(value.intValue);
+
+			break;
+		}
+
+		case LogRing::ArgType::UINT:
+		{
+			std::memcpy(&value.uintValue, entry.args + pos, sizeof(uint64_t));
+			pos += sizeof(uint64_t);
+
+			value.intValue    = static_cast<int64_t>(value.uintValue);
+			value.doubleValue = static_cast<double>(value.uintValue);
+
+			break;
+		}
+
+		case LogRing::ArgType::DOUBLE:
+		{
+			std::memcpy(&value.doubleValue, entry.args + pos, sizeof(double));
+			pos += sizeof(double);
+
+			value.intValue  = static_cast<int64_t>(value.doubleValue);
+			value.uintValue = static_cast<uint64_t>(value.intValue);
+
+			break;
+		}
+
+		case LogRing::ArgType::STRING:
+		{
+			value.stringValue = reinterpret_cast<const char*>(entry.args + pos);
+			pos += std::strlen(value.stringValue) + 1;
+
+			break;
+		}
+
+		case LogRing::ArgType::POINTER:
+		{
+			std::memcpy(&value.pointerValue, entry.args + pos, sizeof(const void*));
+			pos += sizeof(const void*);
+
+			break;
+		}
+
+		default:
+		{
+			pos = entry.argsLen;
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Class variables. */
+
+constexpr size_t LogRing::MaxArgsLen;
+
+/* Class methods. */
+
+size_t LogRing::Format(const Entry& entry, char* buffer, size_t bufferSize)
+{
+	size_t written{ 0u };
+	size_t pos{ 0u };
+	const char* ptr = entry.format;
+
+	if (bufferSize == 0u)
+		return 0u;
+
+	while (*ptr != '\0' && written < bufferSize - 1)
+	{
+		if (*ptr != '%')
+		{
+			buffer[written++] = *ptr++;
+
+			continue;
+		}
+
+		++ptr;
+
+		if (*ptr == '%')
+		{
+			buffer[written++] = *ptr++;
+
+			continue;
+		}
+
+		// Copy flags, width and precision. A '*' takes the value from the next
+		// argument.
+		char spec[32];
+		size_t specLen{ 0u };
+		ArgValue value; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		spec[specLen++] = '%';
+
+		while (*ptr != '\0' && std::strchr("-+ #0123456789.*", *ptr))
+		{
+			if (*ptr == '*')
+			{
+				int number = readArg(entry, pos, value) ? static_cast<int>(value.intValue) : 0;
+
+				if (specLen < sizeof(spec) - 16)
+					specLen += std::snprintf(spec + specLen, sizeof(spec) - specLen, "%d", number);
+			}
+			else if (specLen < sizeof(spec) - 4)
+			{
+				spec[specLen++] = *ptr;
+			}
+
+			++ptr;
+		}
+
+		// Skip length modifiers since the stored argument type is used instead.
+		while (*ptr != '\0' && std::strchr("hljztLq", *ptr))
+		{
+			++ptr;
+		}
+
+		char conversion = *ptr;
+
+		if (conversion == '\0')
+			break;
+
+		++ptr;
+
+		char* out      = buffer + written;
+		size_t outSize = bufferSize - written;
+		int len{ 0 };
+
+		if (!readArg(entry, pos, value))
+		{
+			len = std::snprintf(out, outSize, "?");
+		}
+		else
+		{
+			switch (conversion)
+			{
+				case 'd':
+				case 'i':
+				{
+					std::snprintf(spec + specLen, sizeof(spec) - specLen, "ll%c", conversion);
+					len = std::snprintf(out, outSize, spec, static_cast<long long>(value.intValue));
+
+					break;
+				}
+
+				case 'u':
+				case 'o':
+				case 'x':
+				case 'X':
+				{
+					std::snprintf(spec + specLen, sizeof(spec) - specLen, "ll%c", conversion);
+					len =
+					  std::snprintf(out, outSize, spec, static_cast<unsigned long long>(value.uintValue));
+
+					break;
+				}
+
+				case 'c':
+				{
+					std::snprintf(spec + specLen, sizeof(spec) - specLen, "%c", conversion);
+					len = std::snprintf(out, outSize, spec, static_cast<int>(value.intValue));
+
+					break;
+				}
+
+				case 'e':
+				case 'E':
+				case 'f':
+				case 'F':
+				case 'g':
+				case 'G':
+				case 'a':
+				case 'A':
+				{
+					std::snprintf(spec + specLen, sizeof(spec) - specLen, "%c", conversion);
+					len = std::snprintf(out, outSize, spec, value.doubleValue);
+
+					break;
+				}
+
+				case 's':
+				{
+					if (value.type != ArgType::STRING)
+					{
+						len = std::snprintf(out, outSize, "?");
+
+						break;
+					}
+
+					std::snprintf(spec + specLen, sizeof(spec) - specLen, "%c", conversion);
+					len = std::snprintf(out, outSize, spec, value.stringValue);
+
+					break;
+				}
+
+				case 'p':
+				{
+					std::snprintf(spec + specLen, sizeof(spec) - specLen, "%c", conversion);
+					len = std::snprintf(out, outSize, spec, value.pointerValue);
+
+					break;
+				}
+
+				default:
+				{
+					len = std::snprintf(out, outSize, "?");
+				}
+			}
+		}
+
+		if (len > 0)
+			written += std::min(static_cast<size_t>(len), outSize - 1);
+	}
+
+	buffer[written] = '\0';
+
+	return written;
+}
+
+/* Instance methods. */
+
+LogRing::LogRing(Channel::ChannelSocket* channel, size_t size) : channel(channel), entries(size)
+{
+	MS_TRACE();
+
+	int err;
+
+	this->uvHandle       = new uv_async_t;
+	this->uvHandle->data = static_cast<void*>(this);
+
+	err = uv_async_init(DepLibUV::GetLoop(), this->uvHandle, static_cast<uv_async_cb>(onAsync));
+
+	if (err != 0)
+	{
+		delete this->uvHandle;
+		this->uvHandle = nullptr;
+
+		MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+	}
+
+	this->thread = std::thread(&LogRing::RunThread, this);
+}
+
+LogRing::~LogRing()
+{
+	MS_TRACE();
+
+	// The thread formats every remaining entry before exiting.
+	this->closed.store(true, std::memory_order_release);
+	this->thread.join();
+
+	// Send the remaining lines now since the handle won't be called anymore.
+	OnUvAsync();
+
+	uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+}
+
+inline void LogRing::OnUvAsync()
+{
+	MS_TRACE();
+
+	std::vector<std::string> lines;
+
+	{
+		std::lock_guard<std::mutex> lock(this->linesMutex);
+
+		std::swap(lines, this->lines);
+	}
+
+	if (!lines.empty())
+		this->channel->SendLogs(lines);
+}
+
+void LogRing::RunThread()
+{
+	// NOTE: Nothing can be logged within this thread since Logger stuff is
+	// thread local.
+
+	char buffer[LineMaxLen];
+	uint64_t reportedDroppedEntries{ 0u };
+
+	while (true)
+	{
+		// Read it before draining the ring so no entry is left once closed.
+		bool closed = this->closed.load(std::memory_order_acquire);
+		std::vector<std::string> lines;
+		// Once closed the loop thread is waiting for this one, so drain it all.
+		size_t room{ std::numeric_limits<size_t>::max() };
+
+		if (!closed)
+		{
+			std::lock_guard<std::mutex> lock(this->linesMutex);
+
+			room = MaxPendingLines - std::min(this->lines.size(), MaxPendingLines);
+		}
+
+		// Entries are formatted in their ring slots.
+		auto read = [&lines, &buffer](Entry& entry)
+		{
+			size_t len = LogRing::Format(entry, buffer, sizeof(buffer));
+
+			lines.emplace_back(buffer, len);
+		};
+
+		while (lines.size() < room && this->entries.PopInPlace(read))
+		{
+			continue;
+		}
+
+		uint64_t droppedEntries = this->droppedEntries.load(std::memory_order_relaxed);
+
+		if (droppedEntries != reportedDroppedEntries && lines.size() < room)
+		{
+			int len = std::snprintf(
+			  buffer,
+			  sizeof(buffer),
+			  "W" MS_CLASS "::RunThread() | log ring full, entries dropped [total:%" PRIu64 "]",
+			  droppedEntries);
+
+			lines.emplace_back(buffer, static_cast<size_t>(len));
+
+			reportedDroppedEntries = droppedEntries;
+		}
+
+		if (!lines.empty())
+		{
+			{
+				std::lock_guard<std::mutex> lock(this->linesMutex);
+
+				this->lines.insert(
+				  this->lines.end(),
+				  std::make_move_iterator(lines.begin()),
+				  std::make_move_iterator(lines.end()));
+			}
+
+			if (!closed)
+				uv_async_send(this->uvHandle);
+		}
+
+		if (closed)
+			return;
+
+		if (lines.empty())
+			std::this_thread::sleep_for(std::chrono::milliseconds(IdleInterval));
+	}
+}
@@ -9,6 +9,7 @@
 const uint64_t Logger::pid{ static_cast<uint64_t>(uv_os_getpid()) };
 thread_local Channel::ChannelSocket* Logger::channel{ nullptr };
 thread_local char Logger::buffer[Logger::bufferSize];
+thread_local LogRing* Logger::ring{ nullptr };
 
 /* Class methods. */
 
@@ -18,3 +19,25 @@ void Logger::ClassInit(Channel::ChannelSocket* channel)
 
 	MS_TRACE();
 }
+
+void Logger::StartRing(size_t size)
+{
+	MS_TRACE();
+
+	if (Logger::ring)
+		return;
+
+	Logger::ring = new LogRing(Logger::channel, size);
+}
+
+void Logger::StopRing()
+{
+	MS_TRACE();
+
+	auto* ring = Logger::ring;
+
+	// Unset it first so the LogRing is not used while being destroyed.
+	Logger::ring = nullptr;
+
+	delete ring;
+}
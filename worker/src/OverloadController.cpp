@@ -0,0 +1,184 @@
+#define MS_CLASS "OverloadController"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "OverloadController.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+
+/* Static. */
+
+// Interval (in ms) between loop measurements.
+static constexpr uint64_t SampleInterval{ 250u };
+// Consecutive overloaded samples needed to apply the next step.
+static constexpr size_t OverloadedSamplesToEscalate{ 2u };
+// Consecutive relaxed samples needed to undo the last applied step.
+static constexpr size_t RelaxedSamplesToRelax{ 8u };
+// Busy percentage (below the threshold) considered relaxed.
+static constexpr uint8_t BusyHysteresis{ 10u };
+
+/* Class variables. */
+
+thread_local uint32_t OverloadController::appliedSteps{ 0u };
+// clang-format off
+absl::flat_hash_map<std::string, OverloadController::Step> OverloadController::string2Step =
+{
+	{ "retransmissions", OverloadController::Step::RETRANSMISSIONS },
+	{ "layers",          OverloadController::Step::LAYERS          },
+	{ "rtcp",            OverloadController::Step::RTCP            }
+};
+absl::flat_hash_map<OverloadController::Step, std::string> OverloadController::step2String =
+{
+	{ OverloadController::Step::RETRANSMISSIONS, "retransmissions" },
+	{ OverloadController::Step::LAYERS,          "layers"          },
+	{ OverloadController::Step::RTCP,            "rtcp"            }
+};
+// clang-format on
+
+/* Instance methods. */
+
+OverloadController::OverloadController(
+  Listener* listener, uint64_t lagThreshold, uint8_t busyThreshold, const std::vector<Step>& steps)
+  : listener(listener), lagThreshold(lagThreshold), busyThreshold(busyThreshold), steps(steps)
+{
+	MS_TRACE();
+
+	// Make libuv account the time the loop spends waiting for events.
+	int err = uv_loop_configure(DepLibUV::GetLoop(), UV_METRICS_IDLE_TIME);
+
+	if (err != 0)
+	{
+		MS_WARN_TAG(
+		  info, "uv_loop_configure() failed, loop busy time not measured: %s", uv_strerror(err));
+	}
+
+	this->lastSampleAtNs = DepLibUV::GetTimeNs();
+	this->lastIdleTimeNs = uv_metrics_idle_time(DepLibUV::GetLoop());
+
+	this->timer = new Timer(this);
+	this->timer->Start(SampleInterval, SampleInterval);
+}
+
+OverloadController::~OverloadController()
+{
+	MS_TRACE();
+
+	delete this->timer;
+
+	OverloadController::appliedSteps = 0u;
+}
+
+void OverloadController::FillJson(json& jsonObject) const
+{
+	MS_TRACE();
+
+	// Add level.
+	jsonObject["level"] = this->level;
+
+	// Add appliedSteps.
+	jsonObject["appliedSteps"] = json::array();
+	auto jsonAppliedStepsIt    = jsonObject.find("appliedSteps");
+
+	for (size_t idx{ 0u }; idx < this->level; ++idx)
+	{
+		jsonAppliedStepsIt->emplace_back(OverloadController::step2String[this->steps[idx]]);
+	}
+
+	// Add loopLag.
+	jsonObject["loopLag"] = this->loopLag;
+
+	// Add loopBusy.
+	jsonObject["loopBusy"] = this->loopBusy;
+}
+
+void OverloadController::ProcessSample(uint64_t loopLag, uint8_t loopBusy)
+{
+	MS_TRACE();
+
+	this->loopLag  = loopLag;
+	this->loopBusy = loopBusy;
+
+	bool overloaded = loopLag >= this->lagThreshold || loopBusy >= this->busyThreshold;
+	// clang-format off
+	bool relaxed = (
+		loopLag < this->lagThreshold / 2 &&
+		loopBusy + BusyHysteresis < this->busyThreshold
+	);
+	// clang-format on
+
+	if (overloaded)
+	{
+		this->relaxedSamples = 0u;
+
+		if (++this->overloadedSamples < OverloadedSamplesToEscalate)
+			return;
+
+		this->overloadedSamples = 0u;
+
+		if (this->level < this->steps.size())
+			SetLevel(this->level + 1);
+	}
+	else if (relaxed)
+	{
+		this->overloadedSamples = 0u;
+
+		if (++this->relaxedSamples < RelaxedSamplesToRelax)
+			return;
+
+		this->relaxedSamples = 0u;
+
+		if (this->level > 0u)
+			SetLevel(this->level - 1);
+	}
+	else
+	{
+		this->overloadedSamples = 0u;
+		this->relaxedSamples    = 0u;
+	}
+}
+
+void OverloadController::SetLevel(size_t level)
+{
+	MS_TRACE();
+
+	auto previousLevel = this->level;
+
+	this->level                      = level;
+	OverloadController::appliedSteps = 0u;
+
+	for (size_t idx{ 0u }; idx < this->level; ++idx)
+	{
+		OverloadController::appliedSteps |= 1u << static_cast<uint8_t>(this->steps[idx]);
+	}
+
+	MS_WARN_TAG(
+	  info,
+	  "overload level changed [level:%zu, previousLevel:%zu, loopLag:%" PRIu64 ", loopBusy:%" PRIu8
+	  "]",
+	  this->level,
+	  previousLevel,
+	  this->loopLag,
+	  this->loopBusy);
+
+	this->listener->OnOverloadControllerLevelChange(this, previousLevel);
+}
+
+inline void OverloadController::OnTimer(Timer* /*timer*/)
+{
+	MS_TRACE();
+
+	uint64_t nowNs      = DepLibUV::GetTimeNs();
+	uint64_t idleTimeNs = uv_metrics_idle_time(DepLibUV::GetLoop());
+	uint64_t elapsedNs  = nowNs - this->lastSampleAtNs;
+	uint64_t idleNs     = idleTimeNs - this->lastIdleTimeNs;
+	uint64_t elapsedMs  = elapsedNs / 1000000u;
+	uint64_t loopLag    = elapsedMs > SampleInterval ? elapsedMs - SampleInterval : 0u;
+	uint8_t loopBusy{ 0u };
+
+	if (elapsedNs > idleNs)
+		loopBusy = static_cast<uint8_t>(((elapsedNs - idleNs) * 100u) / elapsedNs);
+
+	this->lastSampleAtNs = nowNs;
+	this->lastIdleTimeNs = idleTimeNs;
+
+	ProcessSample(loopLag, loopBusy);
+}
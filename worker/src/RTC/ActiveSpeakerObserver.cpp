@@ -6,6 +6,8 @@
 #include "Utils.hpp"
 #include "Channel/ChannelNotifier.hpp"
 #include "RTC/RtpDictionaries.hpp"
+#include <algorithm> // std::find(), std::rotate()
+#include <cmath>     // std::log()
 
 namespace RTC
 {
@@ -24,10 +26,6 @@ namespace RTC
 	constexpr uint32_t MinLevelWindowLen{ 15 * 1000 / 20 };
 	constexpr uint32_t MediumThreshold{ 7 };
 	constexpr uint32_t SubunitLengthN1{ (MaxLevel - MinLevel + N1 - 1) / N1 };
-	constexpr uint32_t ImmediateBuffLen{ LongCount * N3 * N2 };
-	constexpr uint32_t MediumsBuffLen{ LongCount * N3 };
-	constexpr uint32_t LongsBuffLen{ LongCount };
-	constexpr uint32_t LevelsBuffLen{ LongCount * N3 * N2 };
 	constexpr double MinActivityScore{ 0.0000000001 };
 
 	inline int64_t BinomialCoefficient(int32_t n, int32_t r)
@@ -62,19 +60,54 @@ namespace RTC
 		return activityScore;
 	}
 
+	// The activity score only depends on the number of active subunits (vL), which
+	// is bounded by the number of subunits (nR) of each interval, so all of them are
+	// computed once. Speakers are compared by the logarithm of the ratio of their
+	// scores, so the logarithm of each score is stored.
+	template<uint32_t nR>
+	std::array<double, nR + 1> ComputeLogActivityScores(const double p, const double lambda)
+	{
+		std::array<double, nR + 1> logActivityScores;
+
+		for (uint32_t vL = 0; vL <= nR; ++vL)
+		{
+			logActivityScores[vL] = std::log(ComputeActivityScore(vL, nR, p, lambda));
+		}
+
+		return logActivityScores;
+	}
+
+	static const std::array<double, N1 + 1> ImmediateLogActivityScores{ ComputeLogActivityScores<N1>(
+	  0.5, 0.78) };
+	static const std::array<double, N2 + 1> MediumLogActivityScores{ ComputeLogActivityScores<N2>(
+	  0.5, 24) };
+	static const std::array<double, N3 + 1> LongLogActivityScores{ ComputeLogActivityScores<N3>(
+	  0.5, 47) };
+
+	inline uint8_t ComputeImmediate(uint8_t level, int8_t minLevel)
+	{
+		if (level < minLevel)
+		{
+			level = MinLevel;
+		}
+
+		return level / SubunitLengthN1;
+	}
+
+	template<size_t LittleLen, size_t BigLen>
 	inline bool ComputeBigs(
-	  const std::vector<uint8_t>& littles, std::vector<uint8_t>& bigs, uint8_t threashold)
+	  const std::array<uint8_t, LittleLen>& littles,
+	  std::array<uint8_t, BigLen>& bigs,
+	  uint8_t threashold)
 	{
-		uint32_t littleLen       = littles.size();
-		uint32_t bigLen          = bigs.size();
-		uint32_t littleLenPerBig = littleLen / bigLen;
-		bool changed             = false;
+		constexpr uint32_t LittleLenPerBig{ LittleLen / BigLen };
+		bool changed{ false };
 
-		for (uint32_t b = 0, l = 0; b < bigLen; b++)
+		for (uint32_t b = 0, l = 0; b < BigLen; b++)
 		{
 			uint8_t sum = 0;
 
-			for (uint32_t lEnd = l + littleLenPerBig; l < lEnd; ++l)
+			for (uint32_t lEnd = l + LittleLenPerBig; l < lEnd; ++l)
 			{
 				if (littles[l] > threashold)
 				{
@@ -109,6 +142,33 @@ namespace RTC
 		else if (this->interval > 5000)
 			this->interval = 5000;
 
+		auto jsonLastNIt = data.find("lastN");
+
+		if (jsonLastNIt != data.end())
+		{
+			if (!Utils::Json::IsPositiveInteger(*jsonLastNIt))
+				MS_THROW_TYPE_ERROR("wrong lastN (not a positive integer)");
+
+			this->lastN = jsonLastNIt->get<uint16_t>();
+		}
+
+		auto jsonLastNModeIt = data.find("lastNMode");
+
+		if (jsonLastNModeIt != data.end())
+		{
+			if (!jsonLastNModeIt->is_string())
+				MS_THROW_TYPE_ERROR("wrong lastNMode (not a string)");
+
+			auto lastNMode = jsonLastNModeIt->get<std::string>();
+
+			if (lastNMode == "pause")
+				this->lastNDowngrade = false;
+			else if (lastNMode == "downgrade")
+				this->lastNDowngrade = true;
+			else
+				MS_THROW_TYPE_ERROR("invalid lastNMode");
+		}
+
 		this->periodicTimer = new Timer(this);
 
 		this->periodicTimer->Start(interval, interval);
@@ -128,50 +188,67 @@ namespace RTC
 		if (producer->GetKind() != RTC::Media::Kind::AUDIO)
 			MS_THROW_TYPE_ERROR("not an audio Producer");
 
-		if (this->mapProducerSpeaker.find(producer->id) != this->mapProducerSpeaker.end())
+		if (this->mapProducerSpeaker.find(producer) != this->mapProducerSpeaker.end())
 			MS_THROW_ERROR("Producer already in map");
 
-		this->mapProducerSpeaker[producer->id].producer = producer;
-		this->mapProducerSpeaker[producer->id].speaker  = new Speaker();
+		this->mapProducerSpeaker[producer] = this->speakers.size();
+		this->speakers.emplace_back(producer);
+
+		this->recentProducers.push_back(producer);
+
+		UpdateLastN();
 	}
 
 	void ActiveSpeakerObserver::RemoveProducer(RTC::Producer* producer)
 	{
 		MS_TRACE();
 
-		auto it = this->mapProducerSpeaker.find(producer->id);
+		auto it = this->mapProducerSpeaker.find(producer);
 
 		if (it == this->mapProducerSpeaker.end())
 		{
 			return;
 		}
 
-		if (it->second.speaker != nullptr)
+		// Keep the speakers vector compact by moving the last Speaker into the
+		// slot of the removed one.
+		size_t idx = it->second;
+
+		this->mapProducerSpeaker.erase(it);
+
+		if (idx != this->speakers.size() - 1)
 		{
-			delete it->second.speaker;
-			it->second.speaker = nullptr;
+			this->speakers[idx] = this->speakers.back();
+
+			this->mapProducerSpeaker[this->speakers[idx].producer] = idx;
 		}
 
-		this->mapProducerSpeaker.erase(producer->id);
+		this->speakers.pop_back();
+
+		auto recentProducersIt =
+		  std::find(this->recentProducers.begin(), this->recentProducers.end(), producer);
 
-		if (producer->id == this->dominantId)
+		if (recentProducersIt != this->recentProducers.end())
+			this->recentProducers.erase(recentProducersIt);
+
+		if (producer == this->dominantProducer)
 		{
-			this->dominantId.erase();
+			this->dominantProducer = nullptr;
 			Update();
 		}
+
+		UpdateLastN();
 	}
 
 	void ActiveSpeakerObserver::ProducerResumed(RTC::Producer* producer)
 	{
 		MS_TRACE();
 
-		auto it = this->mapProducerSpeaker.find(producer->id);
+		auto it = this->mapProducerSpeaker.find(producer);
 
 		if (it != this->mapProducerSpeaker.end())
 		{
-			auto& rtpObserver = it->second;
-
-			rtpObserver.speaker->paused = false;
+			this->speakers[it->second].paused = false;
 		}
 	}
 
@@ -179,16 +256,53 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		auto it = this->mapProducerSpeaker.find(producer->id);
+		auto it = this->mapProducerSpeaker.find(producer);
 
 		if (it != this->mapProducerSpeaker.end())
 		{
-			auto& rtpObserver = it->second;
-
-			rtpObserver.speaker->paused = true;
+			this->speakers[it->second].paused = true;
 		}
 	}
 
+	void ActiveSpeakerObserver::AddConsumer(RTC::Consumer* consumer, RTC::Producer* producer)
+	{
+		MS_TRACE();
+
+		if (this->lastN == 0u)
+			MS_THROW_TYPE_ERROR("lastN not enabled");
+
+		if (this->mapProducerSpeaker.find(producer) == this->mapProducerSpeaker.end())
+			MS_THROW_ERROR("Producer not in map");
+
+		if (this->mapConsumerProducer.find(consumer) != this->mapConsumerProducer.end())
+			MS_THROW_ERROR("Consumer already in map");
+
+		this->mapConsumerProducer[consumer] = producer;
+
+		SetConsumerForwarded(consumer, IsSpeakerForwarded(producer));
+	}
+
+	void ActiveSpeakerObserver::RemoveConsumer(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		auto it = this->mapConsumerProducer.find(consumer);
+
+		if (it == this->mapConsumerProducer.end())
+			return;
+
+		this->mapConsumerProducer.erase(it);
+
+		SetConsumerForwarded(consumer, true);
+	}
+
+	void ActiveSpeakerObserver::ConsumerClosed(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		this->mapConsumerProducer.erase(consumer);
+	}
+
 	void ActiveSpeakerObserver::ReceiveRtpPacket(RTC::Producer* producer, RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
@@ -203,14 +317,13 @@ namespace RTC
 			return;
 		uint8_t volume = 127 - level;
 
-		auto it = this->mapProducerSpeaker.find(producer->id);
+		auto it = this->mapProducerSpeaker.find(producer);
 
 		if (it != this->mapProducerSpeaker.end())
 		{
-			auto& rtpObserver = it->second;
-			uint64_t now      = DepLibUV::GetTimeMs();
+			uint64_t now = DepLibUV::GetTimeMs();
 
-			rtpObserver.speaker->LevelChanged(volume, now);
+			this->speakers[it->second].LevelChanged(volume, now);
 		}
 	}
 
@@ -250,12 +363,21 @@ namespace RTC
 			this->lastLevelIdleTime = now;
 		}
 
-		if (!this->mapProducerSpeaker.empty() && CalculateActiveSpeaker())
+		if (!this->speakers.empty() && CalculateActiveSpeaker())
 		{
 			json data          = json::object();
-			data["producerId"] = this->dominantId;
+			data["producerId"] = this->dominantProducer->id;
 
 			Channel::ChannelNotifier::Emit(this->id, "dominantspeaker", data);
+
+			// Move the new dominant speaker to the front of the list.
+			auto it = std::find(
+			  this->recentProducers.begin(), this->recentProducers.end(), this->dominantProducer);
+
+			if (it != this->recentProducers.end())
+				std::rotate(this->recentProducers.begin(), it, it + 1);
+
+			UpdateLastN();
 		}
 	}
 
@@ -263,54 +385,50 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		std::string newDominantId;
-		int32_t speakerCount = this->mapProducerSpeaker.size();
+		RTC::Producer* newDominantProducer{ nullptr };
+		size_t speakerCount = this->speakers.size();
 
 		if (speakerCount == 0)
 		{
-			newDominantId = "";
+			newDominantProducer = nullptr;
 		}
 		else if (speakerCount == 1)
 		{
-			auto it = this->mapProducerSpeaker.begin();
-
-			newDominantId = it->second.producer->id;
+			newDominantProducer = this->speakers[0].producer;
 		}
 		else
 		{
 			Speaker* dominantSpeaker =
-			  (this->dominantId.empty()) ? nullptr : this->mapProducerSpeaker[this->dominantId].speaker;
+			  (this->dominantProducer == nullptr)
+			    ? nullptr
+			    : &this->speakers[this->mapProducerSpeaker[this->dominantProducer]];
 
 			if (dominantSpeaker == nullptr)
 			{
-				auto item       = this->mapProducerSpeaker.begin();
-				newDominantId   = item->first;
-				dominantSpeaker = item->second.speaker;
+				dominantSpeaker     = &this->speakers[0];
+				newDominantProducer = dominantSpeaker->producer;
 			}
 			else
 			{
-				newDominantId = "";
+				newDominantProducer = nullptr;
 			}
 
 			dominantSpeaker->EvalActivityScores();
 			double newDominantC2 = C2;
 
-			for (auto it = this->mapProducerSpeaker.begin(); it != this->mapProducerSpeaker.end(); ++it)
+			for (auto& speaker : this->speakers)
 			{
-				Speaker* speaker      = it->second.speaker;
-				const std::string& id = it->second.producer->id;
-
-				if (id == this->dominantId || speaker->paused)
+				if (speaker.producer == this->dominantProducer || speaker.paused)
 				{
 					continue;
 				}
 
-				speaker->EvalActivityScores();
+				speaker.EvalActivityScores();
 
 				for (int interval = 0; interval < this->relativeSpeachActivitiesLen; ++interval)
 				{
-					this->relativeSpeachActivities[interval] = std::log(
-					  speaker->GetActivityScore(interval) / dominantSpeaker->GetActivityScore(interval));
+					this->relativeSpeachActivities[interval] = speaker.GetLogActivityScore(interval) -
+					                                           dominantSpeaker->GetLogActivityScore(interval);
 				}
 
 				double c1 = this->relativeSpeachActivities[0];
@@ -318,15 +436,15 @@ namespace RTC
 				double c3 = this->relativeSpeachActivities[2];
 				if ((c1 > C1) && (c2 > C2) && (c3 > C3) && (c2 > newDominantC2))
 				{
-					newDominantC2 = c2;
-					newDominantId = id;
+					newDominantC2       = c2;
+					newDominantProducer = speaker.producer;
 				}
 			}
 		}
 
-		if (!newDominantId.empty() && newDominantId != this->dominantId)
+		if (newDominantProducer != nullptr && newDominantProducer != this->dominantProducer)
 		{
-			this->dominantId = newDominantId;
+			this->dominantProducer = newDominantProducer;
 
 			return true;
 		}
@@ -338,30 +456,110 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		for (auto it = this->mapProducerSpeaker.begin(); it != this->mapProducerSpeaker.end(); ++it)
+		for (auto& speaker : this->speakers)
 		{
-			Speaker* speaker      = it->second.speaker;
-			const std::string& id = it->second.producer->id;
-			uint64_t idle         = now - speaker->lastLevelChangeTime;
+			uint64_t idle = now - speaker.lastLevelChangeTime;
 
-			if (SpeakerIdleTimeout < idle && (this->dominantId.empty() || id != this->dominantId))
+			if (SpeakerIdleTimeout < idle && speaker.producer != this->dominantProducer)
 			{
-				speaker->paused = true;
+				speaker.paused = true;
 			}
 			else if (LevelIdleTimeout < idle)
 			{
-				speaker->LevelTimedOut(now);
+				speaker.LevelTimedOut(now);
 			}
 		}
 	}
 
-	ActiveSpeakerObserver::Speaker::Speaker()
-	  : immediateActivityScore(MinActivityScore), mediumActivityScore(MinActivityScore),
-	    longActivityScore(MinActivityScore), lastLevelChangeTime(DepLibUV::GetTimeMs()),
-	    minLevel(MinLevel), nextMinLevel(MinLevel), immediates(ImmediateBuffLen, 0),
-	    mediums(MediumsBuffLen, 0), longs(LongsBuffLen, 0), levels(LevelsBuffLen, 0), nextLevelIndex(0)
+	void ActiveSpeakerObserver::UpdateLastN()
+	{
+		MS_TRACE();
+
+		if (this->lastN == 0u)
+			return;
+
+		absl::flat_hash_set<RTC::Producer*> lastNProducers;
+
+		for (size_t idx{ 0u }; idx < this->recentProducers.size() && idx < this->lastN; ++idx)
+		{
+			lastNProducers.insert(this->recentProducers[idx]);
+		}
+
+		bool changed = lastNProducers != this->lastNProducers;
+
+		this->lastNProducers = std::move(lastNProducers);
+
+		// NOTE: Consumers of speakers that are no longer in the map must also be
+		// forwarded again, so check all of them even if the last-N speakers did
+		// not change.
+		for (auto& kv : this->mapConsumerProducer)
+		{
+			SetConsumerForwarded(kv.first, IsSpeakerForwarded(kv.second));
+		}
+
+		if (!changed)
+			return;
+
+		// Notify the last-N speakers once instead of notifying about every paused
+		// or resumed Consumer.
+		json data = json::object();
+
+		data["producerIds"] = json::array();
+		auto jsonProducerIdsIt = data.find("producerIds");
+
+		for (size_t idx{ 0u }; idx < this->recentProducers.size() && idx < this->lastN; ++idx)
+		{
+			jsonProducerIdsIt->emplace_back(this->recentProducers[idx]->id);
+		}
+
+		Channel::ChannelNotifier::Emit(this->id, "lastnchange", data);
+	}
+
+	bool ActiveSpeakerObserver::IsSpeakerForwarded(RTC::Producer* producer) const
+	{
+		MS_TRACE();
+
+		// Consumers of Producers not (or no longer) in the map are not restricted.
+		// clang-format off
+		return (
+			this->mapProducerSpeaker.find(producer) == this->mapProducerSpeaker.end() ||
+			this->lastNProducers.find(producer) != this->lastNProducers.end()
+		);
+		// clang-format on
+	}
+
+	void ActiveSpeakerObserver::SetConsumerForwarded(RTC::Consumer* consumer, bool forwarded)
+	{
+		MS_TRACE();
+
+		if (this->lastNDowngrade)
+			consumer->SetLastNDowngraded(!forwarded);
+		else
+			consumer->SetLastNPaused(!forwarded);
+	}
+
+	ActiveSpeakerObserver::Speaker::Speaker(RTC::Producer* producer)
+	  : producer(producer), immediateLogActivityScore(std::log(MinActivityScore)),
+	    mediumLogActivityScore(std::log(MinActivityScore)),
+	    longLogActivityScore(std::log(MinActivityScore)), lastLevelChangeTime(DepLibUV::GetTimeMs()),
+	    minLevel(MinLevel), nextMinLevel(MinLevel), latestLevelIndex(0)
 	{
 		MS_TRACE();
+
+		static_assert(ImmediatesBuffLen == LongCount * N3 * N2, "wrong immediates length");
+		static_assert(MediumsBuffLen == LongCount * N3, "wrong mediums length");
+		static_assert(LongsBuffLen == LongCount, "wrong longs length");
+		static_assert(LevelsBuffLen == LongCount * N3 * N2, "wrong levels length");
+
+		// Activity score tables must cover all the possible values of each interval.
+		static_assert(MaxLevel / SubunitLengthN1 <= N1, "wrong immediate activity scores length");
+		static_assert(ImmediatesBuffLen / MediumsBuffLen <= N2, "wrong medium activity scores length");
+		static_assert(MediumsBuffLen / LongsBuffLen <= N3, "wrong long activity scores length");
+
+		this->immediates.fill(0);
+		this->mediums.fill(0);
+		this->longs.fill(0);
+		this->levels.fill(0);
 	}
 
 	void ActiveSpeakerObserver::Speaker::EvalActivityScores()
@@ -384,18 +582,18 @@ namespace RTC
 		}
 	}
 
-	double ActiveSpeakerObserver::Speaker::GetActivityScore(int32_t interval)
+	double ActiveSpeakerObserver::Speaker::GetLogActivityScore(int32_t interval) const
 	{
 		MS_TRACE();
 
 		switch (interval)
 		{
 			case 0:
-				return this->immediateActivityScore;
+				return this->immediateLogActivityScore;
 			case 1:
-				return this->mediumActivityScore;
+				return this->mediumLogActivityScore;
 			case 2:
-				return this->longActivityScore;
+				return this->longLogActivityScore;
 			default:
 				MS_ABORT("interval is invalid");
 		}
@@ -430,11 +628,14 @@ namespace RTC
 			// using a different packetization time or using DTX we need to update more than one sample
 			// when receiving an audio packet.
 			uint32_t intervalsUpdated =
-			  std::min(std::max(static_cast<uint32_t>(elapsed / 20), 1U), LevelsBuffLen);
+			  std::min(std::max(static_cast<uint32_t>(elapsed / 20), 1U), uint32_t{ LevelsBuffLen });
 			for (uint32_t i = 0; i < intervalsUpdated; i++)
 			{
-				this->levels[this->nextLevelIndex] = b;
-				this->nextLevelIndex               = (this->nextLevelIndex + 1) % LevelsBuffLen;
+				// Samples are written backwards so the most recent one comes first.
+				this->latestLevelIndex = (this->latestLevelIndex + LevelsBuffLen - 1) % LevelsBuffLen;
+
+				this->levels[this->latestLevelIndex]                 = b;
+				this->levels[this->latestLevelIndex + LevelsBuffLen] = b;
 			}
 
 			UpdateMinLevel(b);
@@ -452,34 +653,25 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		int8_t minLevel = this->minLevel + SubunitLengthN1;
-		bool changed    = false;
+		int8_t minLevel       = this->minLevel + SubunitLengthN1;
+		const uint8_t* levels = this->levels.data() + this->latestLevelIndex;
+		std::array<uint8_t, ImmediatesBuffLen> immediates;
 
-		for (uint32_t i = 0; i < ImmediateBuffLen; ++i)
+		// The latest levels are contiguous and, as this->immediates, the most
+		// recent value is always in index 0, so this loop can be vectorized.
+		for (uint32_t i = 0; i < ImmediatesBuffLen; ++i)
 		{
-			// this->levels is a circular buffer where new samples are written in the
-			// next vector index. this->immediates is a buffer where the most recent
-			// value is always in index 0.
-			size_t levelIndex = this->nextLevelIndex >= (i + 1)
-			                      ? this->nextLevelIndex - i - 1
-			                      : this->nextLevelIndex + LevelsBuffLen - i - 1;
-			uint8_t level     = this->levels[levelIndex];
-
-			if (level < minLevel)
-			{
-				level = MinLevel;
-			}
-
-			uint8_t immediate = (level / SubunitLengthN1);
+			immediates[i] = ComputeImmediate(levels[i], minLevel);
+		}
 
-			if (this->immediates[i] != immediate)
-			{
-				this->immediates[i] = immediate;
-				changed             = true;
-			}
+		if (immediates == this->immediates)
+		{
+			return false;
 		}
 
-		return changed;
+		this->immediates = immediates;
+
+		return true;
 	}
 
 	bool ActiveSpeakerObserver::Speaker::ComputeMediums()
@@ -500,21 +692,21 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->immediateActivityScore = ComputeActivityScore(this->immediates[0], N1, 0.5, 0.78);
+		this->immediateLogActivityScore = ImmediateLogActivityScores[this->immediates[0]];
 	}
 
 	void ActiveSpeakerObserver::Speaker::EvalMediumActivityScore()
 	{
 		MS_TRACE();
 
-		this->mediumActivityScore = ComputeActivityScore(this->mediums[0], N2, 0.5, 24);
+		this->mediumLogActivityScore = MediumLogActivityScores[this->mediums[0]];
 	}
 
 	void ActiveSpeakerObserver::Speaker::EvalLongActivityScore()
 	{
 		MS_TRACE();
 
-		this->longActivityScore = ComputeActivityScore(this->longs[0], N3, 0.5, 47);
+		this->longLogActivityScore = LongLogActivityScores[this->longs[0]];
 	}
 
 	void ActiveSpeakerObserver::Speaker::UpdateMinLevel(int8_t level)
@@ -6,12 +6,22 @@
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
 #include "Channel/ChannelNotifier.hpp"
+#include "PayloadChannel/PayloadChannelNotifier.hpp"
 #include "RTC/RtpDictionaries.hpp"
-#include <cmath> // std::lround()
-#include <map>
+#include <algorithm> // std::push_heap(), std::pop_heap(), std::sort_heap()
+#include <cmath>     // std::lround()
 
 namespace RTC
 {
+	/* Static. */
+
+	// Comparator of the loudest entries, so the heap front is the quietest one.
+	static bool IsLouder(
+	  const std::pair<int8_t, RTC::Producer*>& a, const std::pair<int8_t, RTC::Producer*>& b)
+	{
+		return a.first > b.first;
+	}
+
 	/* Instance methods. */
 
 	AudioLevelObserver::AudioLevelObserver(const std::string& id, json& data) : RTC::RtpObserver(id)
@@ -52,7 +62,15 @@ namespace RTC
 
 		this->interval = jsonIntervalIt->get<uint16_t>();
 
-		if (this->interval < 250)
+		auto jsonBinaryVolumesIt = data.find("binaryVolumes");
+
+		if (jsonBinaryVolumesIt != data.end() && jsonBinaryVolumesIt->is_boolean())
+			this->binaryVolumes = jsonBinaryVolumesIt->get<bool>();
+
+		// Binary notifications are cheap enough for high frequency meters.
+		if (this->binaryVolumes && this->interval < 50)
+			this->interval = 50;
+		else if (!this->binaryVolumes && this->interval < 250)
 			this->interval = 250;
 		else if (this->interval > 5000)
 			this->interval = 5000;
@@ -146,41 +164,50 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		absl::btree_map<int8_t, RTC::Producer*> mapDBovsProducer;
+		this->loudest.clear();
 
 		for (auto& kv : this->mapProducerDBovs)
 		{
 			auto* producer = kv.first;
 			auto& dBovs    = kv.second;
 
-			if (dBovs.count < 10)
-				continue;
+			if (dBovs.count >= 10)
+			{
+				auto avgDBov = -1 * static_cast<int8_t>(std::lround(dBovs.totalSum / dBovs.count));
 
-			auto avgDBov = -1 * static_cast<int8_t>(std::lround(dBovs.totalSum / dBovs.count));
+				if (avgDBov >= this->threshold)
+					AddLoudest(avgDBov, producer);
+			}
 
-			if (avgDBov >= this->threshold)
-				mapDBovsProducer[avgDBov] = producer;
+			// Reset for the next interval.
+			dBovs.totalSum = 0;
+			dBovs.count    = 0;
 		}
 
-		// Clear the map.
-		ResetMapProducerDBovs();
-
-		if (!mapDBovsProducer.empty())
+		if (!this->loudest.empty())
 		{
 			this->silence = false;
 
-			uint16_t idx{ 0 };
-			auto rit  = mapDBovsProducer.crbegin();
+			// Loudest first.
+			std::sort_heap(this->loudest.begin(), this->loudest.end(), IsLouder);
+
+			if (this->binaryVolumes)
+			{
+				EmitBinaryVolumes();
+
+				return;
+			}
+
 			json data = json::array();
 
-			for (; idx < this->maxEntries && rit != mapDBovsProducer.crend(); ++idx, ++rit)
+			for (auto& entry : this->loudest)
 			{
 				data.emplace_back(json::value_t::object);
 
-				auto& jsonEntry = data[idx];
+				auto& jsonEntry = data.back();
 
-				jsonEntry["producerId"] = rit->second->id;
-				jsonEntry["volume"]     = rit->first;
+				jsonEntry["producerId"] = entry.second->id;
+				jsonEntry["volume"]     = entry.first;
 			}
 
 			Channel::ChannelNotifier::Emit(this->id, "volumes", data);
@@ -193,6 +220,61 @@ namespace RTC
 		}
 	}
 
+	/**
+	 * Keeps the maxEntries loudest Producers so the interval costs
+	 * O(N log maxEntries) instead of sorting all the Producers.
+	 */
+	inline void AudioLevelObserver::AddLoudest(int8_t volume, RTC::Producer* producer)
+	{
+		MS_TRACE();
+
+		if (this->loudest.size() < this->maxEntries)
+		{
+			this->loudest.emplace_back(volume, producer);
+
+			std::push_heap(this->loudest.begin(), this->loudest.end(), IsLouder);
+		}
+		else if (volume > this->loudest.front().first)
+		{
+			std::pop_heap(this->loudest.begin(), this->loudest.end(), IsLouder);
+
+			this->loudest.back() = std::make_pair(volume, producer);
+
+			std::push_heap(this->loudest.begin(), this->loudest.end(), IsLouder);
+		}
+	}
+
+	/**
+	 * Each entry is the volume (int8), the length of the Producer id (uint8) and
+	 * the Producer id.
+	 */
+	void AudioLevelObserver::EmitBinaryVolumes()
+	{
+		MS_TRACE();
+
+		this->binaryVolumesBuffer.clear();
+
+		for (auto& entry : this->loudest)
+		{
+			const auto& producerId = entry.second->id;
+
+			if (producerId.length() > 255)
+			{
+				MS_WARN_DEV("Producer id too long, ignoring volume entry");
+
+				continue;
+			}
+
+			this->binaryVolumesBuffer.push_back(static_cast<uint8_t>(entry.first));
+			this->binaryVolumesBuffer.push_back(static_cast<uint8_t>(producerId.length()));
+			this->binaryVolumesBuffer.insert(
+			  this->binaryVolumesBuffer.end(), producerId.begin(), producerId.end());
+		}
+
+		PayloadChannel::PayloadChannelNotifier::Emit(
+		  this->id, "volumes", this->binaryVolumesBuffer.data(), this->binaryVolumesBuffer.size());
+	}
+
 	void AudioLevelObserver::ResetMapProducerDBovs()
 	{
 		MS_TRACE();
@@ -5,6 +5,7 @@
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
 #include "Channel/ChannelNotifier.hpp"
 #include <iterator> // std::ostream_iterator
 #include <sstream>  // std::ostringstream
@@ -200,6 +201,9 @@ namespace RTC
 		// Add producerPaused.
 		jsonObject["producerPaused"] = this->producerPaused;
 
+		// Add lastNPaused.
+		jsonObject["lastNPaused"] = this->lastNPaused;
+
 		// Add priority.
 		jsonObject["priority"] = this->priority;
 
@@ -433,6 +437,37 @@ namespace RTC
 		Channel::ChannelNotifier::Emit(this->id, "producerresume");
 	}
 
+	// NOTE: Changes are not notified per Consumer. The RtpObserver driving the
+	// last-N policy notifies a summary of them instead.
+	void Consumer::SetLastNPaused(bool lastNPaused)
+	{
+		MS_TRACE();
+
+		if (lastNPaused == this->lastNPaused)
+			return;
+
+		if (lastNPaused)
+		{
+			bool wasActive = IsActive();
+
+			this->lastNPaused = true;
+
+			MS_DEBUG_DEV("Consumer paused by last-N [consumerId:%s]", this->id.c_str());
+
+			if (wasActive)
+				UserOnPaused();
+		}
+		else
+		{
+			this->lastNPaused = false;
+
+			MS_DEBUG_DEV("Consumer resumed by last-N [consumerId:%s]", this->id.c_str());
+
+			if (IsActive())
+				UserOnResumed();
+		}
+	}
+
 	void Consumer::ProducerRtpStreamScores(const std::vector<uint8_t>* scores)
 	{
 		MS_TRACE();
@@ -456,6 +491,75 @@ namespace RTC
 		this->listener->OnConsumerProducerClosed(this);
 	}
 
+	void Consumer::FillJsonRtpStreamState(
+	  json& jsonObject,
+	  const RTC::RtpStreamSend* rtpStream,
+	  const RTC::SeqManager<uint16_t>& rtpSeqManager) const
+	{
+		MS_TRACE();
+
+		// Nothing sent yet.
+		if (!rtpStream->IsStarted())
+			return;
+
+		rtpStream->GetSeqState().FillJson(jsonObject["rtpStream"]);
+
+		jsonObject["rtpSeqManager"]["base"]      = rtpSeqManager.GetBase();
+		jsonObject["rtpSeqManager"]["maxOutput"] = rtpSeqManager.GetMaxOutput();
+	}
+
+	/**
+	 * The RTP stream continues with the next sequence number once synced, as if
+	 * this Consumer had sent the packets of the given state. The state is empty
+	 * if nothing was sent.
+	 */
+	void Consumer::SetRtpStreamState(
+	  json& data, RTC::RtpStreamSend* rtpStream, RTC::SeqManager<uint16_t>& rtpSeqManager)
+	{
+		MS_TRACE();
+
+		if (!data.is_object())
+			MS_THROW_TYPE_ERROR("wrong rtpState (not an object)");
+		else if (data.empty())
+			return;
+
+		auto jsonRtpStreamIt     = data.find("rtpStream");
+		auto jsonRtpSeqManagerIt = data.find("rtpSeqManager");
+
+		// clang-format off
+		if (
+			jsonRtpStreamIt == data.end() ||
+			!jsonRtpStreamIt->is_object() ||
+			jsonRtpSeqManagerIt == data.end() ||
+			!jsonRtpSeqManagerIt->is_object()
+		)
+		// clang-format on
+		{
+			MS_THROW_TYPE_ERROR("wrong rtpState");
+		}
+
+		auto jsonBaseIt      = jsonRtpSeqManagerIt->find("base");
+		auto jsonMaxOutputIt = jsonRtpSeqManagerIt->find("maxOutput");
+
+		// clang-format off
+		if (
+			jsonBaseIt == jsonRtpSeqManagerIt->end() ||
+			!Utils::Json::IsPositiveInteger(*jsonBaseIt) ||
+			jsonMaxOutputIt == jsonRtpSeqManagerIt->end() ||
+			!Utils::Json::IsPositiveInteger(*jsonMaxOutputIt)
+		)
+		// clang-format on
+		{
+			MS_THROW_TYPE_ERROR("wrong rtpState.rtpSeqManager");
+		}
+
+		// This may throw.
+		RTC::RtpStream::SeqState seqState(*jsonRtpStreamIt);
+
+		rtpStream->SetSeqState(seqState);
+		rtpSeqManager.Restore(jsonBaseIt->get<uint16_t>(), jsonMaxOutputIt->get<uint16_t>());
+	}
+
 	void Consumer::EmitTraceEventRtpAndKeyFrameTypes(RTC::RtpPacket* packet, bool isRtx) const
 	{
 		MS_TRACE();
@@ -0,0 +1,231 @@
+#define MS_CLASS "RTC::CryptoThreadPool"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/CryptoThreadPool.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
+#include <algorithm> // std::find()
+
+/* Static methods for UV callbacks. */
+
+inline static void onAsync(uv_async_t* handle)
+{
+	static_cast<RTC::CryptoThreadPool*>(handle->data)->OnUvAsync();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_async_t*>(handle);
+}
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	CryptoThreadPool::CryptoThreadPool(size_t numThreads)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(numThreads > 0, "numThreads must be greater than 0");
+
+		int err;
+
+		this->uvHandle       = new uv_async_t;
+		this->uvHandle->data = static_cast<void*>(this);
+
+		err = uv_async_init(DepLibUV::GetLoop(), this->uvHandle, static_cast<uv_async_cb>(onAsync));
+
+		if (err != 0)
+		{
+			delete this->uvHandle;
+			this->uvHandle = nullptr;
+
+			MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+		}
+
+		for (size_t i{ 0u }; i < numThreads; ++i)
+		{
+			this->threads.emplace_back(&CryptoThreadPool::RunThread, this);
+		}
+
+		MS_DEBUG_TAG(dtls, "crypto thread pool created [threads:%zu]", numThreads);
+	}
+
+	CryptoThreadPool::~CryptoThreadPool()
+	{
+		MS_TRACE();
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			MS_ASSERT(
+			  this->pendingTasks.empty() && this->runningTasks.empty() && this->doneTasks.empty(),
+			  "there are tasks not yet cancelled");
+
+			this->closed = true;
+		}
+
+		this->pendingCondition.notify_all();
+
+		// No task is being run so threads end at once.
+		for (auto& thread : this->threads)
+		{
+			thread.join();
+		}
+
+		uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+	}
+
+	void CryptoThreadPool::Close()
+	{
+		MS_TRACE();
+
+		this->closing = true;
+
+		MaybeDelete();
+	}
+
+	void CryptoThreadPool::Push(Task* task)
+	{
+		MS_TRACE();
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			this->pendingTasks.push_back(task);
+		}
+
+		this->pendingCondition.notify_one();
+	}
+
+	bool CryptoThreadPool::Cancel(Task* task)
+	{
+		MS_TRACE();
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		auto it = std::find(this->pendingTasks.begin(), this->pendingTasks.end(), task);
+
+		if (it != this->pendingTasks.end())
+		{
+			this->pendingTasks.erase(it);
+
+			return true;
+		}
+
+		auto it2 = std::find(this->doneTasks.begin(), this->doneTasks.end(), task);
+
+		if (it2 != this->doneTasks.end())
+		{
+			this->doneTasks.erase(it2);
+
+			return true;
+		}
+
+		// The task is being run. Don't wait for it, just forget about it once run.
+		this->cancelledTasks.push_back(task);
+
+		return false;
+	}
+
+	inline void CryptoThreadPool::OnUvAsync()
+	{
+		MS_TRACE();
+
+		// A notified task may close the pool, so don't delete it until done.
+		this->notifying = true;
+
+		// NOTE: Take done tasks one by one since a task may cancel others when
+		// notified.
+		while (true)
+		{
+			Task* task;
+			bool cancelled;
+
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+
+				if (this->doneTasks.empty())
+					break;
+
+				task = this->doneTasks.front();
+				this->doneTasks.pop_front();
+
+				auto it = std::find(this->cancelledTasks.begin(), this->cancelledTasks.end(), task);
+
+				cancelled = it != this->cancelledTasks.end();
+
+				if (cancelled)
+					this->cancelledTasks.erase(it);
+			}
+
+			if (cancelled)
+				delete task;
+			else
+				task->OnCryptoTaskDone();
+		}
+
+		this->notifying = false;
+
+		// NOTE: This may delete the pool so nothing must be done after it.
+		MaybeDelete();
+	}
+
+	void CryptoThreadPool::RunThread()
+	{
+		// Settings are thread local and the Logger cannot be used out of the loop
+		// thread, so disable logging within this thread.
+		Settings::configuration.logLevel = LogLevel::LOG_NONE;
+
+		while (true)
+		{
+			Task* task;
+
+			{
+				std::unique_lock<std::mutex> lock(this->mutex);
+
+				this->pendingCondition.wait(
+				  lock, [this]() { return this->closed || !this->pendingTasks.empty(); });
+
+				if (this->closed)
+					return;
+
+				task = this->pendingTasks.front();
+				this->pendingTasks.pop_front();
+				this->runningTasks.push_back(task);
+			}
+
+			task->OnCryptoTaskRun();
+
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+
+				this->runningTasks.erase(
+				  std::find(this->runningTasks.begin(), this->runningTasks.end(), task));
+				this->doneTasks.push_back(task);
+			}
+
+			uv_async_send(this->uvHandle);
+		}
+	}
+
+	void CryptoThreadPool::MaybeDelete()
+	{
+		MS_TRACE();
+
+		if (!this->closing || this->notifying)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			// Wait for cancelled tasks to be run, their threads may be using them.
+			if (!this->cancelledTasks.empty())
+				return;
+		}
+
+		delete this;
+	}
+} // namespace RTC
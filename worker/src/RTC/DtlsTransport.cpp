@@ -6,11 +6,13 @@
 #include "MediaSoupErrors.hpp"
 #include "Settings.hpp"
 #include "Utils.hpp"
+#include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <uv.h>
 #include <cstdio>  // std::sprintf(), std::fopen()
 #include <cstring> // std::memcpy(), std::strcmp()
+#include <mutex>
 
 #define LOG_OPENSSL_ERROR(desc)                                                                    \
 	do                                                                                               \
@@ -40,7 +42,18 @@ inline static int onSslCertificateVerify(int /*preverifyOk*/, X509_STORE_CTX* /*
 
 inline static void onSslInfo(const SSL* ssl, int where, int ret)
 {
-	static_cast<RTC::DtlsTransport*>(SSL_get_ex_data(ssl, 0))->OnSslInfo(where, ret);
+	auto* dtlsTransport = static_cast<RTC::DtlsTransport*>(SSL_get_ex_data(ssl, 0));
+
+	if (dtlsTransport)
+	{
+		dtlsTransport->OnSslInfo(where, ret);
+	}
+	// Within a crypto thread just keep what the DtlsTransport needs to know.
+	else if ((where & SSL_CB_HANDSHAKE_DONE) != 0)
+	{
+		static_cast<RTC::DtlsTransport::HandshakeTask*>(SSL_get_ex_data(ssl, 1))->handshakeDoneNow =
+		  true;
+	}
 }
 
 inline static unsigned int onSslDtlsTimer(SSL* /*ssl*/, unsigned int timerUs)
@@ -60,6 +73,7 @@ namespace RTC
 	// clang-format off
 	static constexpr int DtlsMtu{ 1350 };
 	static constexpr int SslReadBufferSize{ 65536 };
+	static constexpr size_t MaxPendingDtlsData{ 32 };
 	// AES-HMAC: http://tools.ietf.org/html/rfc3711
 	static constexpr size_t SrtpMasterKeyLength{ 16 };
 	static constexpr size_t SrtpMasterSaltLength{ 14 };
@@ -73,6 +87,17 @@ namespace RTC
 	static constexpr size_t SrtpAesGcm128MasterLength{ SrtpAesGcm128MasterKeyLength + SrtpAesGcm128MasterSaltLength };
 	// clang-format on
 
+	// The generated certificate and private key (used when no PEM files are
+	// given) are shared by all the workers in the process, along with the
+	// SSL_CTX and fingerprints computed from them, since they are immutable.
+	static std::mutex GlobalSyncMutex;
+	static size_t GlobalInstances{ 0u };
+	static X509* GlobalCertificate{ nullptr };
+	static EVP_PKEY* GlobalPrivateKey{ nullptr };
+	static SSL_CTX* GlobalSslCtx{ nullptr };
+	static std::vector<DtlsTransport::Fingerprint> GlobalLocalFingerprints;
+	thread_local static bool UsingGlobalCertificate{ false };
+
 	/* Class variables. */
 
 	thread_local X509* DtlsTransport::certificate{ nullptr };
@@ -111,6 +136,8 @@ namespace RTC
 		{ RTC::SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_32, "SRTP_AES128_CM_SHA1_32" }
 	};
 	// clang-format on
+	thread_local RTC::CryptoThreadPool* DtlsTransport::cryptoThreadPool{ nullptr };
+	thread_local size_t DtlsTransport::numInstances{ 0u };
 
 	/* Class methods. */
 
@@ -118,23 +145,58 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		// Generate a X509 certificate and private key (unless PEM files are provided).
+		// Read the X509 certificate and private key from the given PEM files.
 		if (
-		  Settings::configuration.dtlsCertificateFile.empty() ||
-		  Settings::configuration.dtlsPrivateKeyFile.empty())
+		  !Settings::configuration.dtlsCertificateFile.empty() &&
+		  !Settings::configuration.dtlsPrivateKeyFile.empty())
+		{
+			ReadCertificateAndPrivateKeyFromFiles();
+
+			// Create a global SSL_CTX.
+			CreateSslCtx();
+
+			// Generate certificate fingerprints.
+			GenerateFingerprints();
+
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(GlobalSyncMutex);
+
+		// First worker in the process, so generate a X509 certificate and private
+		// key, create a SSL_CTX and generate certificate fingerprints.
+		if (GlobalInstances == 0)
 		{
 			GenerateCertificateAndPrivateKey();
+			CreateSslCtx();
+			GenerateFingerprints();
+
+			GlobalCertificate = DtlsTransport::certificate;
+			GlobalPrivateKey  = DtlsTransport::privateKey;
+			GlobalSslCtx      = DtlsTransport::sslCtx;
+
+			X509_up_ref(GlobalCertificate);
+			EVP_PKEY_up_ref(GlobalPrivateKey);
+			SSL_CTX_up_ref(GlobalSslCtx);
+
+			GlobalLocalFingerprints = DtlsTransport::localFingerprints;
 		}
+		// Otherwise reuse the ones created by the first worker.
 		else
 		{
-			ReadCertificateAndPrivateKeyFromFiles();
-		}
+			DtlsTransport::certificate = GlobalCertificate;
+			DtlsTransport::privateKey  = GlobalPrivateKey;
+			DtlsTransport::sslCtx      = GlobalSslCtx;
 
-		// Create a global SSL_CTX.
-		CreateSslCtx();
+			X509_up_ref(DtlsTransport::certificate);
+			EVP_PKEY_up_ref(DtlsTransport::privateKey);
+			SSL_CTX_up_ref(DtlsTransport::sslCtx);
 
-		// Generate certificate fingerprints.
-		GenerateFingerprints();
+			DtlsTransport::localFingerprints = GlobalLocalFingerprints;
+		}
+
+		++GlobalInstances;
+		UsingGlobalCertificate = true;
 	}
 
 	void DtlsTransport::ClassDestroy()
@@ -147,6 +209,34 @@ namespace RTC
 			X509_free(DtlsTransport::certificate);
 		if (DtlsTransport::sslCtx)
 			SSL_CTX_free(DtlsTransport::sslCtx);
+
+		DtlsTransport::privateKey  = nullptr;
+		DtlsTransport::certificate = nullptr;
+		DtlsTransport::sslCtx      = nullptr;
+
+		DtlsTransport::localFingerprints.clear();
+
+		if (!UsingGlobalCertificate)
+			return;
+
+		UsingGlobalCertificate = false;
+
+		std::lock_guard<std::mutex> lock(GlobalSyncMutex);
+
+		--GlobalInstances;
+
+		if (GlobalInstances == 0)
+		{
+			EVP_PKEY_free(GlobalPrivateKey);
+			X509_free(GlobalCertificate);
+			SSL_CTX_free(GlobalSslCtx);
+
+			GlobalPrivateKey  = nullptr;
+			GlobalCertificate = nullptr;
+			GlobalSslCtx      = nullptr;
+
+			GlobalLocalFingerprints.clear();
+		}
 	}
 
 	void DtlsTransport::GenerateCertificateAndPrivateKey()
@@ -503,78 +593,32 @@ namespace RTC
 
 		/* Set SSL. */
 
-		this->ssl = SSL_new(DtlsTransport::sslCtx);
-
-		if (!this->ssl)
-		{
-			LOG_OPENSSL_ERROR("SSL_new() failed");
-
-			goto error;
-		}
-
-		// Set this as custom data.
-		SSL_set_ex_data(this->ssl, 0, static_cast<void*>(this));
-
-		this->sslBioFromNetwork = BIO_new(BIO_s_mem());
-
-		if (!this->sslBioFromNetwork)
-		{
-			LOG_OPENSSL_ERROR("BIO_new() failed");
-
-			SSL_free(this->ssl);
-
-			goto error;
-		}
-
-		this->sslBioToNetwork = BIO_new(BIO_s_mem());
-
-		if (!this->sslBioToNetwork)
-		{
-			LOG_OPENSSL_ERROR("BIO_new() failed");
-
-			BIO_free(this->sslBioFromNetwork);
-			SSL_free(this->ssl);
-
-			goto error;
-		}
-
-		SSL_set_bio(this->ssl, this->sslBioFromNetwork, this->sslBioToNetwork);
-
-		// Set the MTU so that we don't send packets that are too large with no fragmentation.
-		SSL_set_mtu(this->ssl, DtlsMtu);
-		DTLS_set_link_mtu(this->ssl, DtlsMtu);
-
-		// Set callback handler for setting DTLS timer interval.
-		DTLS_set_timer_cb(this->ssl, onSslDtlsTimer);
+		// NOTE: If this is not catched by the caller the program will abort, but
+		// this should never happen.
+		if (!CreateSsl())
+			MS_THROW_ERROR("DtlsTransport instance creation failed");
 
 		// Set the DTLS timer.
 		this->timer = new Timer(this);
 
-		return;
-
-	error:
-
-		// NOTE: At this point SSL_set_bio() was not called so we must free BIOs as
-		// well.
-		if (this->sslBioFromNetwork)
-			BIO_free(this->sslBioFromNetwork);
-
-		if (this->sslBioToNetwork)
-			BIO_free(this->sslBioToNetwork);
-
-		if (this->ssl)
-			SSL_free(this->ssl);
+		// Create the crypto thread pool (if enabled) along with the first instance.
+		if (Settings::configuration.dtlsHandshakeThreads > 0u && DtlsTransport::numInstances == 0u)
+		{
+			DtlsTransport::cryptoThreadPool =
+			  new RTC::CryptoThreadPool(Settings::configuration.dtlsHandshakeThreads);
+		}
 
-		// NOTE: If this is not catched by the caller the program will abort, but
-		// this should never happen.
-		MS_THROW_ERROR("DtlsTransport instance creation failed");
+		++DtlsTransport::numInstances;
 	}
 
 	DtlsTransport::~DtlsTransport()
 	{
 		MS_TRACE();
 
-		if (IsRunning())
+		CancelHandshakeTask();
+
+		// NOTE: The SSL may have been given to a handshake task being run.
+		if (this->ssl && IsRunning() && !this->imported)
 		{
 			// Send close alert to the peer.
 			SSL_shutdown(this->ssl);
@@ -592,6 +636,17 @@ namespace RTC
 
 		// Close the DTLS timer.
 		delete this->timer;
+
+		delete this->handshakeTask;
+
+		// Close the crypto thread pool (if any) along with the last instance.
+		// NOTE: It may be closed within a task callback so it deletes itself once
+		// safe.
+		if (--DtlsTransport::numInstances == 0u && DtlsTransport::cryptoThreadPool)
+		{
+			DtlsTransport::cryptoThreadPool->Close();
+			DtlsTransport::cryptoThreadPool = nullptr;
+		}
 	}
 
 	void DtlsTransport::Dump() const
@@ -702,6 +757,26 @@ namespace RTC
 		}
 	}
 
+	/**
+	 * Used when the DTLS-SRTP keys were negotiated by another DtlsTransport (the
+	 * one of a migrated WebRtcTransport). There is no DTLS association, so
+	 * received DTLS data is ignored and application data cannot be sent.
+	 */
+	void DtlsTransport::SetConnected(Role localRole)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(this->state == DtlsState::NEW, "DTLS transport already running");
+		MS_ASSERT(
+		  localRole == Role::CLIENT || localRole == Role::SERVER,
+		  "local DTLS role must be 'client' or 'server'");
+
+		this->localRole     = localRole;
+		this->state         = DtlsState::CONNECTED;
+		this->handshakeDone = true;
+		this->imported      = true;
+	}
+
 	bool DtlsTransport::SetRemoteFingerprint(Fingerprint fingerprint)
 	{
 		MS_TRACE();
@@ -737,6 +812,53 @@ namespace RTC
 			return;
 		}
 
+		if (this->imported)
+		{
+			MS_DEBUG_TAG(dtls, "ignoring DTLS data, no DTLS association (imported SRTP keys)");
+
+			return;
+		}
+
+		// Run DTLS handshake steps (which may involve costly signatures and key
+		// exchanges) within the crypto thread pool (if any).
+		if (DtlsTransport::cryptoThreadPool && !this->handshakeDone)
+		{
+			// Just a step can be run at a time, so keep data received meanwhile.
+			if (IsHandshakeTaskRunning())
+			{
+				if (this->pendingDtlsData.size() >= MaxPendingDtlsData)
+				{
+					MS_WARN_TAG(dtls, "too many DTLS data received while running DTLS handshake, discarded");
+
+					return;
+				}
+
+				this->pendingDtlsData.emplace_back(data, data + len);
+
+				return;
+			}
+
+			if (!this->handshakeTask)
+				this->handshakeTask = new HandshakeTask(this);
+
+			auto* task = this->handshakeTask;
+
+			task->ssl               = this->ssl;
+			task->sslBioFromNetwork = this->sslBioFromNetwork;
+			task->running           = true;
+			task->handshakeDoneNow  = false;
+			task->data.assign(data, data + len);
+
+			// The task must not access this DtlsTransport within its thread, so make
+			// the SSL callbacks use the task instead.
+			SSL_set_ex_data(this->ssl, 0, nullptr);
+			SSL_set_ex_data(this->ssl, 1, static_cast<void*>(task));
+
+			DtlsTransport::cryptoThreadPool->Push(task);
+
+			return;
+		}
+
 		// Write the received DTLS data into the sslBioFromNetwork.
 		written =
 		  BIO_write(this->sslBioFromNetwork, static_cast<const void*>(data), static_cast<int>(len));
@@ -753,32 +875,7 @@ namespace RTC
 		// Must call SSL_read() to process received DTLS data.
 		read = SSL_read(this->ssl, static_cast<void*>(DtlsTransport::sslReadBuffer), SslReadBufferSize);
 
-		// Send data if it's ready.
-		SendPendingOutgoingDtlsData();
-
-		// Check SSL status and return if it is bad/closed.
-		if (!CheckStatus(read))
-			return;
-
-		// Set/update the DTLS timeout.
-		if (!SetTimeout())
-			return;
-
-		// Application data received. Notify to the listener.
-		if (read > 0)
-		{
-			// It is allowed to receive DTLS data even before validating remote fingerprint.
-			if (!this->handshakeDone)
-			{
-				MS_WARN_TAG(dtls, "ignoring application data received while DTLS handshake not done");
-
-				return;
-			}
-
-			// Notify the listener.
-			this->listener->OnDtlsTransportApplicationDataReceived(
-			  this, (uint8_t*)DtlsTransport::sslReadBuffer, static_cast<size_t>(read));
-		}
+		ProcessSslRead(read, SSL_get_error(this->ssl, read), DtlsTransport::sslReadBuffer);
 	}
 
 	void DtlsTransport::SendApplicationData(const uint8_t* data, size_t len)
@@ -793,6 +890,13 @@ namespace RTC
 			return;
 		}
 
+		if (this->imported)
+		{
+			MS_WARN_TAG(dtls, "cannot send application data, no DTLS association (imported SRTP keys)");
+
+			return;
+		}
+
 		if (len == 0)
 		{
 			MS_WARN_TAG(dtls, "ignoring 0 length data");
@@ -821,66 +925,266 @@ namespace RTC
 		SendPendingOutgoingDtlsData();
 	}
 
-	void DtlsTransport::Reset()
+	/**
+	 * Derives the SRTP master keys (key plus salt) of both endpoints from the
+	 * DTLS association. Given buffers must have room for
+	 * SrtpSession::GetMasterLength() bytes. Returns false if there is no DTLS
+	 * association (see SetConnected()).
+	 */
+	bool DtlsTransport::GetSrtpKeys(
+	  RTC::SrtpSession::CryptoSuite srtpCryptoSuite,
+	  uint8_t* srtpLocalMasterKey,
+	  uint8_t* srtpRemoteMasterKey) const
 	{
 		MS_TRACE();
 
-		int ret;
+		if (this->imported || !this->ssl)
+			return false;
 
-		if (!IsRunning())
-			return;
+		size_t srtpKeyLength{ 0 };
+		size_t srtpSaltLength{ 0 };
+		size_t srtpMasterLength{ 0 };
 
-		MS_WARN_TAG(dtls, "resetting DTLS transport");
+		switch (srtpCryptoSuite)
+		{
+			case RTC::SrtpSession::CryptoSuite::AEAD_AES_256_GCM:
+			{
+				srtpKeyLength    = SrtpAesGcm256MasterKeyLength;
+				srtpSaltLength   = SrtpAesGcm256MasterSaltLength;
+				srtpMasterLength = SrtpAesGcm256MasterLength;
 
-		// Stop the DTLS timer.
-		this->timer->Stop();
+				break;
+			}
 
-		// We need to reset the SSL instance so we need to "shutdown" it, but we
-		// don't want to send a Close Alert to the peer, so just don't call
-		// SendPendingOutgoingDTLSData().
-		SSL_shutdown(this->ssl);
+			case RTC::SrtpSession::CryptoSuite::AEAD_AES_128_GCM:
+			{
+				srtpKeyLength    = SrtpAesGcm128MasterKeyLength;
+				srtpSaltLength   = SrtpAesGcm128MasterSaltLength;
+				srtpMasterLength = SrtpAesGcm128MasterLength;
 
-		this->localRole        = Role::NONE;
-		this->state            = DtlsState::NEW;
-		this->handshakeDone    = false;
-		this->handshakeDoneNow = false;
+				break;
+			}
 
-		// Reset SSL status.
-		// NOTE: For this to properly work, SSL_shutdown() must be called before.
-		// NOTE: This may fail if not enough DTLS handshake data has been received,
-		// but we don't care so just clear the error queue.
-		ret = SSL_clear(this->ssl);
+			case RTC::SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_80:
+			case RTC::SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_32:
+			{
+				srtpKeyLength    = SrtpMasterKeyLength;
+				srtpSaltLength   = SrtpMasterSaltLength;
+				srtpMasterLength = SrtpMasterLength;
 
-		if (ret == 0)
-			ERR_clear_error();
-	}
+				break;
+			}
 
-	inline bool DtlsTransport::CheckStatus(int returnCode)
-	{
-		MS_TRACE();
+			default:
+			{
+				MS_ABORT("unknown SRTP crypto suite");
+			}
+		}
 
-		int err;
-		bool wasHandshakeDone = this->handshakeDone;
+		auto* srtpMaterial = new uint8_t[srtpMasterLength * 2];
+		uint8_t* srtpLocalKey{ nullptr };
+		uint8_t* srtpLocalSalt{ nullptr };
+		uint8_t* srtpRemoteKey{ nullptr };
+		uint8_t* srtpRemoteSalt{ nullptr };
+		int ret;
+
+		ret = SSL_export_keying_material(
+		  this->ssl, srtpMaterial, srtpMasterLength * 2, "EXTRACTOR-dtls_srtp", 19, nullptr, 0, 0);
 
-		err = SSL_get_error(this->ssl, returnCode);
+		MS_ASSERT(ret != 0, "SSL_export_keying_material() failed");
 
-		switch (err)
+		switch (this->localRole)
 		{
-			case SSL_ERROR_NONE:
-				break;
+			case Role::SERVER:
+			{
+				srtpRemoteKey  = srtpMaterial;
+				srtpLocalKey   = srtpRemoteKey + srtpKeyLength;
+				srtpRemoteSalt = srtpLocalKey + srtpKeyLength;
+				srtpLocalSalt  = srtpRemoteSalt + srtpSaltLength;
 
-			case SSL_ERROR_SSL:
-				LOG_OPENSSL_ERROR("SSL status: SSL_ERROR_SSL");
 				break;
+			}
 
-			case SSL_ERROR_WANT_READ:
-				break;
+			case Role::CLIENT:
+			{
+				srtpLocalKey   = srtpMaterial;
+				srtpRemoteKey  = srtpLocalKey + srtpKeyLength;
+				srtpLocalSalt  = srtpRemoteKey + srtpKeyLength;
+				srtpRemoteSalt = srtpLocalSalt + srtpSaltLength;
 
-			case SSL_ERROR_WANT_WRITE:
-				MS_WARN_TAG(dtls, "SSL status: SSL_ERROR_WANT_WRITE");
 				break;
+			}
 
-			case SSL_ERROR_WANT_X509_LOOKUP:
+			default:
+			{
+				MS_ABORT("no DTLS role set");
+			}
+		}
+
+		// Create the SRTP local master key.
+		std::memcpy(srtpLocalMasterKey, srtpLocalKey, srtpKeyLength);
+		std::memcpy(srtpLocalMasterKey + srtpKeyLength, srtpLocalSalt, srtpSaltLength);
+		// Create the SRTP remote master key.
+		std::memcpy(srtpRemoteMasterKey, srtpRemoteKey, srtpKeyLength);
+		std::memcpy(srtpRemoteMasterKey + srtpKeyLength, srtpRemoteSalt, srtpSaltLength);
+
+		OPENSSL_cleanse(srtpMaterial, srtpMasterLength * 2);
+
+		delete[] srtpMaterial;
+
+		return true;
+	}
+
+	bool DtlsTransport::CreateSsl()
+	{
+		MS_TRACE();
+
+		this->ssl = SSL_new(DtlsTransport::sslCtx);
+
+		if (!this->ssl)
+		{
+			LOG_OPENSSL_ERROR("SSL_new() failed");
+
+			goto error;
+		}
+
+		// Set this as custom data.
+		SSL_set_ex_data(this->ssl, 0, static_cast<void*>(this));
+
+		this->sslBioFromNetwork = BIO_new(BIO_s_mem());
+
+		if (!this->sslBioFromNetwork)
+		{
+			LOG_OPENSSL_ERROR("BIO_new() failed");
+
+			goto error;
+		}
+
+		this->sslBioToNetwork = BIO_new(BIO_s_mem());
+
+		if (!this->sslBioToNetwork)
+		{
+			LOG_OPENSSL_ERROR("BIO_new() failed");
+
+			goto error;
+		}
+
+		SSL_set_bio(this->ssl, this->sslBioFromNetwork, this->sslBioToNetwork);
+
+		// Set the MTU so that we don't send packets that are too large with no fragmentation.
+		SSL_set_mtu(this->ssl, DtlsMtu);
+		DTLS_set_link_mtu(this->ssl, DtlsMtu);
+
+		// Set callback handler for setting DTLS timer interval.
+		DTLS_set_timer_cb(this->ssl, onSslDtlsTimer);
+
+		return true;
+
+	error:
+
+		// NOTE: At this point SSL_set_bio() was not called so we must free BIOs as
+		// well.
+		if (this->sslBioFromNetwork)
+			BIO_free(this->sslBioFromNetwork);
+
+		if (this->sslBioToNetwork)
+			BIO_free(this->sslBioToNetwork);
+
+		if (this->ssl)
+			SSL_free(this->ssl);
+
+		this->ssl               = nullptr;
+		this->sslBioFromNetwork = nullptr;
+		this->sslBioToNetwork   = nullptr;
+
+		return false;
+	}
+
+	void DtlsTransport::Reset()
+	{
+		MS_TRACE();
+
+		int ret;
+
+		CancelHandshakeTask();
+
+		// The SSL was given to a handshake task being run, so create a new one
+		// instead of resetting it.
+		// NOTE: If this is not catched by the caller the program will abort, but
+		// this should never happen.
+		if (!this->ssl)
+		{
+			if (!CreateSsl())
+				MS_THROW_ERROR("SSL creation failed");
+
+			this->timer->Stop();
+
+			this->localRole        = Role::NONE;
+			this->state            = DtlsState::NEW;
+			this->handshakeDone    = false;
+			this->handshakeDoneNow = false;
+
+			return;
+		}
+
+		if (!IsRunning())
+			return;
+
+		MS_WARN_TAG(dtls, "resetting DTLS transport");
+
+		// Stop the DTLS timer.
+		this->timer->Stop();
+
+		// We need to reset the SSL instance so we need to "shutdown" it, but we
+		// don't want to send a Close Alert to the peer, so just don't call
+		// SendPendingOutgoingDTLSData().
+		SSL_shutdown(this->ssl);
+
+		this->localRole        = Role::NONE;
+		this->state            = DtlsState::NEW;
+		this->handshakeDone    = false;
+		this->handshakeDoneNow = false;
+
+		// Reset SSL status.
+		// NOTE: For this to properly work, SSL_shutdown() must be called before.
+		// NOTE: This may fail if not enough DTLS handshake data has been received,
+		// but we don't care so just clear the error queue.
+		ret = SSL_clear(this->ssl);
+
+		if (ret == 0)
+			ERR_clear_error();
+	}
+
+	inline bool DtlsTransport::CheckStatus(int returnCode)
+	{
+		MS_TRACE();
+
+		return CheckSslError(SSL_get_error(this->ssl, returnCode));
+	}
+
+	inline bool DtlsTransport::CheckSslError(int err)
+	{
+		MS_TRACE();
+
+		bool wasHandshakeDone = this->handshakeDone;
+
+		switch (err)
+		{
+			case SSL_ERROR_NONE:
+				break;
+
+			case SSL_ERROR_SSL:
+				LOG_OPENSSL_ERROR("SSL status: SSL_ERROR_SSL");
+				break;
+
+			case SSL_ERROR_WANT_READ:
+				break;
+
+			case SSL_ERROR_WANT_WRITE:
+				MS_WARN_TAG(dtls, "SSL status: SSL_ERROR_WANT_WRITE");
+				break;
+
+			case SSL_ERROR_WANT_X509_LOOKUP:
 				MS_DEBUG_TAG(dtls, "SSL status: SSL_ERROR_WANT_X509_LOOKUP");
 				break;
 
@@ -950,6 +1254,70 @@ namespace RTC
 		}
 	}
 
+	/**
+	 * Handles the result of calling SSL_read() (and SSL_get_error() with its
+	 * return value) with the DTLS data received from the network.
+	 */
+	inline void DtlsTransport::ProcessSslRead(int read, int sslError, const uint8_t* readData)
+	{
+		MS_TRACE();
+
+		// Send data if it's ready.
+		SendPendingOutgoingDtlsData();
+
+		// Check SSL status and return if it is bad/closed.
+		if (!CheckSslError(sslError))
+			return;
+
+		// Set/update the DTLS timeout.
+		if (!SetTimeout())
+			return;
+
+		// Application data received. Notify to the listener.
+		if (read > 0)
+		{
+			// It is allowed to receive DTLS data even before validating remote fingerprint.
+			if (!this->handshakeDone)
+			{
+				MS_WARN_TAG(dtls, "ignoring application data received while DTLS handshake not done");
+
+				return;
+			}
+
+			// Notify the listener.
+			this->listener->OnDtlsTransportApplicationDataReceived(
+			  this, readData, static_cast<size_t>(read));
+		}
+	}
+
+	inline void DtlsTransport::CancelHandshakeTask()
+	{
+		MS_TRACE();
+
+		if (IsHandshakeTaskRunning())
+		{
+			if (DtlsTransport::cryptoThreadPool->Cancel(this->handshakeTask))
+			{
+				this->handshakeTask->running = false;
+
+				SSL_set_ex_data(this->ssl, 0, static_cast<void*>(this));
+			}
+			// The task is being run so the pool will delete it once run. Give it the
+			// SSL (along with its BIOs) instead of waiting for it.
+			else
+			{
+				this->handshakeTask->ownsSsl = true;
+				this->handshakeTask          = nullptr;
+
+				this->ssl               = nullptr;
+				this->sslBioFromNetwork = nullptr;
+				this->sslBioToNetwork   = nullptr;
+			}
+		}
+
+		this->pendingDtlsData.clear();
+	}
+
 	inline void DtlsTransport::SendPendingOutgoingDtlsData()
 	{
 		MS_TRACE();
@@ -1200,94 +1568,11 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		size_t srtpKeyLength{ 0 };
-		size_t srtpSaltLength{ 0 };
-		size_t srtpMasterLength{ 0 };
-
-		switch (srtpCryptoSuite)
-		{
-			case RTC::SrtpSession::CryptoSuite::AEAD_AES_256_GCM:
-			{
-				srtpKeyLength    = SrtpAesGcm256MasterKeyLength;
-				srtpSaltLength   = SrtpAesGcm256MasterSaltLength;
-				srtpMasterLength = SrtpAesGcm256MasterLength;
-
-				break;
-			}
-
-			case RTC::SrtpSession::CryptoSuite::AEAD_AES_128_GCM:
-			{
-				srtpKeyLength    = SrtpAesGcm128MasterKeyLength;
-				srtpSaltLength   = SrtpAesGcm128MasterSaltLength;
-				srtpMasterLength = SrtpAesGcm128MasterLength;
-
-				break;
-			}
-
-			case RTC::SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_80:
-			case RTC::SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_32:
-			{
-				srtpKeyLength    = SrtpMasterKeyLength;
-				srtpSaltLength   = SrtpMasterSaltLength;
-				srtpMasterLength = SrtpMasterLength;
-
-				break;
-			}
-
-			default:
-			{
-				MS_ABORT("unknown SRTP crypto suite");
-			}
-		}
-
-		auto* srtpMaterial = new uint8_t[srtpMasterLength * 2];
-		uint8_t* srtpLocalKey{ nullptr };
-		uint8_t* srtpLocalSalt{ nullptr };
-		uint8_t* srtpRemoteKey{ nullptr };
-		uint8_t* srtpRemoteSalt{ nullptr };
+		auto srtpMasterLength     = RTC::SrtpSession::GetMasterLength(srtpCryptoSuite);
 		auto* srtpLocalMasterKey  = new uint8_t[srtpMasterLength];
 		auto* srtpRemoteMasterKey = new uint8_t[srtpMasterLength];
-		int ret;
 
-		ret = SSL_export_keying_material(
-		  this->ssl, srtpMaterial, srtpMasterLength * 2, "EXTRACTOR-dtls_srtp", 19, nullptr, 0, 0);
-
-		MS_ASSERT(ret != 0, "SSL_export_keying_material() failed");
-
-		switch (this->localRole)
-		{
-			case Role::SERVER:
-			{
-				srtpRemoteKey  = srtpMaterial;
-				srtpLocalKey   = srtpRemoteKey + srtpKeyLength;
-				srtpRemoteSalt = srtpLocalKey + srtpKeyLength;
-				srtpLocalSalt  = srtpRemoteSalt + srtpSaltLength;
-
-				break;
-			}
-
-			case Role::CLIENT:
-			{
-				srtpLocalKey   = srtpMaterial;
-				srtpRemoteKey  = srtpLocalKey + srtpKeyLength;
-				srtpLocalSalt  = srtpRemoteKey + srtpKeyLength;
-				srtpRemoteSalt = srtpLocalSalt + srtpSaltLength;
-
-				break;
-			}
-
-			default:
-			{
-				MS_ABORT("no DTLS role set");
-			}
-		}
-
-		// Create the SRTP local master key.
-		std::memcpy(srtpLocalMasterKey, srtpLocalKey, srtpKeyLength);
-		std::memcpy(srtpLocalMasterKey + srtpKeyLength, srtpLocalSalt, srtpSaltLength);
-		// Create the SRTP remote master key.
-		std::memcpy(srtpRemoteMasterKey, srtpRemoteKey, srtpKeyLength);
-		std::memcpy(srtpRemoteMasterKey + srtpKeyLength, srtpRemoteSalt, srtpSaltLength);
+		GetSrtpKeys(srtpCryptoSuite, srtpLocalMasterKey, srtpRemoteMasterKey);
 
 		// Set state and notify the listener.
 		this->state = DtlsState::CONNECTED;
@@ -1300,7 +1585,9 @@ namespace RTC
 		  srtpMasterLength,
 		  this->remoteCert);
 
-		delete[] srtpMaterial;
+		OPENSSL_cleanse(srtpLocalMasterKey, srtpMasterLength);
+		OPENSSL_cleanse(srtpRemoteMasterKey, srtpMasterLength);
+
 		delete[] srtpLocalMasterKey;
 		delete[] srtpRemoteMasterKey;
 	}
@@ -1421,6 +1708,14 @@ namespace RTC
 			return;
 		}
 
+		// The DTLS timer will be set again once the running handshake task is done.
+		if (IsHandshakeTaskRunning())
+		{
+			MS_DEBUG_DEV("handshake task is running so return");
+
+			return;
+		}
+
 		// DTLSv1_handle_timeout is called when a DTLS handshake timeout expires.
 		// If no timeout had expired, it returns 0. Otherwise, it retransmits the
 		// previous flight of handshake messages and returns 1. If too many timeouts
@@ -1446,4 +1741,94 @@ namespace RTC
 			this->listener->OnDtlsTransportFailed(this);
 		}
 	}
+
+	inline void DtlsTransport::OnHandshakeTaskDone()
+	{
+		MS_TRACE();
+
+		auto& task = *this->handshakeTask;
+
+		task.running = false;
+
+		SSL_set_ex_data(this->ssl, 0, static_cast<void*>(this));
+
+		if (task.written != static_cast<int>(task.data.size()))
+		{
+			MS_WARN_TAG(
+			  dtls,
+			  "OpenSSL BIO_write() wrote less (%zu bytes) than given data (%zu bytes)",
+			  static_cast<size_t>(task.written),
+			  task.data.size());
+		}
+
+		if (task.opensslError != 0u)
+			ERR_raise(ERR_GET_LIB(task.opensslError), ERR_GET_REASON(task.opensslError));
+
+		if (task.handshakeDoneNow)
+		{
+			MS_DEBUG_TAG(dtls, "DTLS handshake done");
+
+			this->handshakeDoneNow = true;
+		}
+
+		ProcessSslRead(task.read, task.sslError, task.readData.data());
+
+		// Process DTLS data received while the task was running. It may start a
+		// new task.
+		while (!IsHandshakeTaskRunning() && !this->pendingDtlsData.empty())
+		{
+			auto data = std::move(this->pendingDtlsData.front());
+
+			this->pendingDtlsData.pop_front();
+
+			ProcessDtlsData(data.data(), data.size());
+		}
+	}
+
+	/* Instance methods of DtlsTransport::HandshakeTask. */
+
+	DtlsTransport::HandshakeTask::~HandshakeTask()
+	{
+		MS_TRACE();
+
+		// NOTE: SSL_free() also frees its BIOs.
+		if (this->ownsSsl)
+			SSL_free(this->ssl);
+	}
+
+	void DtlsTransport::HandshakeTask::OnCryptoTaskRun()
+	{
+		MS_TRACE();
+
+		this->written = BIO_write(
+		  this->sslBioFromNetwork,
+		  static_cast<const void*>(this->data.data()),
+		  static_cast<int>(this->data.size()));
+
+		this->read =
+		  SSL_read(this->ssl, static_cast<void*>(DtlsTransport::sslReadBuffer), SslReadBufferSize);
+		this->sslError = SSL_get_error(this->ssl, this->read);
+
+		// The OpenSSL error queue is thread local, so keep its first error (if
+		// any) so it can be raised again within the loop thread.
+		this->opensslError = ERR_peek_error();
+
+		ERR_clear_error();
+
+		// Application data may be read along with the last handshake message.
+		if (this->read > 0)
+		{
+			this->readData.assign(
+			  DtlsTransport::sslReadBuffer, DtlsTransport::sslReadBuffer + this->read);
+		}
+		else
+			this->readData.clear();
+	}
+
+	void DtlsTransport::HandshakeTask::OnCryptoTaskDone()
+	{
+		MS_TRACE();
+
+		this->dtlsTransport->OnHandshakeTaskDone();
+	}
 } // namespace RTC
@@ -21,6 +21,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		this->hmacSha1.SetKey(password);
+
 		// Notify the listener.
 		this->listener->OnIceServerLocalUsernameFragmentAdded(this, usernameFragment);
 	}
@@ -63,12 +65,10 @@ namespace RTC
 				  static_cast<unsigned int>(packet->GetMethod()));
 
 				// Reply 400.
-				RTC::StunPacket* response = packet->CreateErrorResponse(400);
-
-				response->Serialize(StunSerializeBuffer);
-				this->listener->OnIceServerSendStunPacket(this, response, tuple);
+				RTC::StunPacket response = packet->CreateErrorResponse(400);
 
-				delete response;
+				response.Serialize(StunSerializeBuffer);
+				this->listener->OnIceServerSendStunPacket(this, &response, tuple);
 			}
 			else
 			{
@@ -89,12 +89,10 @@ namespace RTC
 				MS_WARN_TAG(ice, "STUN Binding Request without FINGERPRINT => 400");
 
 				// Reply 400.
-				RTC::StunPacket* response = packet->CreateErrorResponse(400);
-
-				response->Serialize(StunSerializeBuffer);
-				this->listener->OnIceServerSendStunPacket(this, response, tuple);
+				RTC::StunPacket response = packet->CreateErrorResponse(400);
 
-				delete response;
+				response.Serialize(StunSerializeBuffer);
+				this->listener->OnIceServerSendStunPacket(this, &response, tuple);
 			}
 			else
 			{
@@ -114,18 +112,17 @@ namespace RTC
 					MS_WARN_TAG(ice, "mising required attributes in STUN Binding Request => 400");
 
 					// Reply 400.
-					RTC::StunPacket* response = packet->CreateErrorResponse(400);
+					RTC::StunPacket response = packet->CreateErrorResponse(400);
 
-					response->Serialize(StunSerializeBuffer);
-					this->listener->OnIceServerSendStunPacket(this, response, tuple);
-
-					delete response;
+					response.Serialize(StunSerializeBuffer);
+					this->listener->OnIceServerSendStunPacket(this, &response, tuple);
 
 					return;
 				}
 
 				// Check authentication.
-				switch (packet->CheckAuthentication(this->usernameFragment, this->password))
+				switch (
+				  packet->CheckAuthentication(this->usernameFragment, std::addressof(this->hmacSha1)))
 				{
 					case RTC::StunPacket::Authentication::OK:
 					{
@@ -151,7 +148,7 @@ namespace RTC
 						if (
 							!this->oldUsernameFragment.empty() &&
 							!this->oldPassword.empty() &&
-							packet->CheckAuthentication(this->oldUsernameFragment, this->oldPassword) == RTC::StunPacket::Authentication::OK
+							packet->CheckAuthentication(this->oldUsernameFragment, std::addressof(this->oldHmacSha1)) == RTC::StunPacket::Authentication::OK
 						)
 						// clang-format on
 						{
@@ -163,12 +160,10 @@ namespace RTC
 						MS_WARN_TAG(ice, "wrong authentication in STUN Binding Request => 401");
 
 						// Reply 401.
-						RTC::StunPacket* response = packet->CreateErrorResponse(401);
-
-						response->Serialize(StunSerializeBuffer);
-						this->listener->OnIceServerSendStunPacket(this, response, tuple);
+						RTC::StunPacket response = packet->CreateErrorResponse(401);
 
-						delete response;
+						response.Serialize(StunSerializeBuffer);
+						this->listener->OnIceServerSendStunPacket(this, &response, tuple);
 
 						return;
 					}
@@ -178,12 +173,10 @@ namespace RTC
 						MS_WARN_TAG(ice, "cannot check authentication in STUN Binding Request => 400");
 
 						// Reply 400.
-						RTC::StunPacket* response = packet->CreateErrorResponse(400);
+						RTC::StunPacket response = packet->CreateErrorResponse(400);
 
-						response->Serialize(StunSerializeBuffer);
-						this->listener->OnIceServerSendStunPacket(this, response, tuple);
-
-						delete response;
+						response.Serialize(StunSerializeBuffer);
+						this->listener->OnIceServerSendStunPacket(this, &response, tuple);
 
 						return;
 					}
@@ -195,12 +188,10 @@ namespace RTC
 					MS_WARN_TAG(ice, "peer indicates ICE-CONTROLLED in STUN Binding Request => 487");
 
 					// Reply 487 (Role Conflict).
-					RTC::StunPacket* response = packet->CreateErrorResponse(487);
-
-					response->Serialize(StunSerializeBuffer);
-					this->listener->OnIceServerSendStunPacket(this, response, tuple);
+					RTC::StunPacket response = packet->CreateErrorResponse(487);
 
-					delete response;
+					response.Serialize(StunSerializeBuffer);
+					this->listener->OnIceServerSendStunPacket(this, &response, tuple);
 
 					return;
 				}
@@ -211,22 +202,20 @@ namespace RTC
 				  packet->HasUseCandidate() ? "true" : "false");
 
 				// Create a success response.
-				RTC::StunPacket* response = packet->CreateSuccessResponse();
+				RTC::StunPacket response = packet->CreateSuccessResponse();
 
 				// Add XOR-MAPPED-ADDRESS.
-				response->SetXorMappedAddress(tuple->GetRemoteAddress());
+				response.SetXorMappedAddress(tuple->GetRemoteAddress());
 
 				// Authenticate the response.
 				if (this->oldPassword.empty())
-					response->Authenticate(this->password);
+					response.Authenticate(std::addressof(this->hmacSha1));
 				else
-					response->Authenticate(this->oldPassword);
+					response.Authenticate(std::addressof(this->oldHmacSha1));
 
 				// Send back.
-				response->Serialize(StunSerializeBuffer);
-				this->listener->OnIceServerSendStunPacket(this, response, tuple);
-
-				delete response;
+				response.Serialize(StunSerializeBuffer);
+				this->listener->OnIceServerSendStunPacket(this, &response, tuple);
 
 				uint32_t nomination{ 0u };
 
@@ -338,6 +327,21 @@ namespace RTC
 		SetSelectedTuple(storedTuple);
 	}
 
+	void IceServer::ImportSelectedTuple(RTC::TransportTuple* tuple, IceState state)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(this->state == IceState::NEW, "cannot import a tuple if not in 'new' state");
+		MS_ASSERT(
+		  state == IceState::CONNECTED || state == IceState::COMPLETED,
+		  "imported state must be 'connected' or 'completed'");
+
+		auto* storedTuple = AddTuple(tuple);
+
+		this->selectedTuple = storedTuple;
+		this->state         = state;
+	}
+
 	void IceServer::HandleTuple(
 	  RTC::TransportTuple* tuple, bool hasUseCandidate, bool hasNomination, uint32_t nomination)
 	{
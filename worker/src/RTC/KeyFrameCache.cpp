@@ -0,0 +1,109 @@
+#define MS_CLASS "RTC::KeyFrameCache"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/KeyFrameCache.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "RTC/SeqManager.hpp"
+
+namespace RTC
+{
+	/* Static. */
+
+	// Max age of the cached key frame. Sending older ones would make the Consumer
+	// receive a too long burst of packets.
+	static constexpr uint64_t MaxKeyFrameAge{ 2000u }; // In ms.
+
+	/* Instance methods. */
+
+	KeyFrameCache::KeyFrameCache(size_t maxSize) : maxSize(maxSize)
+	{
+		MS_TRACE();
+	}
+
+	KeyFrameCache::~KeyFrameCache()
+	{
+		MS_TRACE();
+
+		Clear();
+	}
+
+	/**
+	 * Called with every (already mangled) packet of the Producer RTP stream.
+	 */
+	void KeyFrameCache::ReceivePacket(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		auto nowMs = DepLibUV::GetTimeMs();
+
+		if (packet->IsKeyFrame())
+		{
+			// A new key frame (rather than another packet of the cached one) makes
+			// previous packets useless.
+			if (this->packets.empty() || packet->GetTimestamp() != this->keyFrameTimestamp)
+			{
+				Clear();
+
+				this->keyFrameSeq          = packet->GetSequenceNumber();
+				this->keyFrameTimestamp    = packet->GetTimestamp();
+				this->keyFrameReceivedAtMs = nowMs;
+			}
+		}
+		// No key frame to append the packet to.
+		else if (this->packets.empty())
+		{
+			return;
+		}
+		// Ignore packets previous to the key frame (such as retransmitted ones).
+		else if (RTC::SeqManager<uint16_t>::IsSeqLowerThan(
+		           packet->GetSequenceNumber(), this->keyFrameSeq))
+		{
+			return;
+		}
+
+		// clang-format off
+		if (
+			this->size + packet->GetSize() > this->maxSize ||
+			nowMs - this->keyFrameReceivedAtMs > MaxKeyFrameAge
+		)
+		// clang-format on
+		{
+			MS_DEBUG_DEV(
+			  "discarding key frame cache [ssrc:%" PRIu32 ", packets:%zu, size:%zu]",
+			  packet->GetSsrc(),
+			  this->packets.size(),
+			  this->size);
+
+			Clear();
+
+			return;
+		}
+
+		this->packets.push_back(packet->Clone());
+		this->size += packet->GetSize();
+	}
+
+	bool KeyFrameCache::HasKeyFrame() const
+	{
+		MS_TRACE();
+
+		if (this->packets.empty())
+			return false;
+
+		return DepLibUV::GetTimeMs() - this->keyFrameReceivedAtMs <= MaxKeyFrameAge;
+	}
+
+	void KeyFrameCache::Clear()
+	{
+		MS_TRACE();
+
+		for (auto* packet : this->packets)
+		{
+			delete packet;
+		}
+
+		this->packets.clear();
+		this->size = 0u;
+	}
+} // namespace RTC
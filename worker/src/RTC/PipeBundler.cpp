@@ -0,0 +1,165 @@
+#define MS_CLASS "RTC::PipeBundler"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/PipeBundler.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include <cstring> // std::memcpy()
+#include <utility> // std::move()
+
+namespace RTC
+{
+	/* Class methods. */
+
+	bool PipeBundler::Unbundle(
+	  const uint8_t* data, size_t len, const std::function<void(const uint8_t*, size_t)>& fn)
+	{
+		MS_TRACE();
+
+		size_t offset{ HeaderSize };
+
+		while (offset < len)
+		{
+			if (offset + EntryHeaderSize > len)
+				return false;
+
+			size_t packetLen = Utils::Byte::Get2Bytes(data, offset);
+
+			offset += EntryHeaderSize;
+
+			if (packetLen == 0u || offset + packetLen > len)
+				return false;
+
+			fn(data + offset, packetLen);
+
+			offset += packetLen;
+		}
+
+		return true;
+	}
+
+	/* Instance methods. */
+
+	PipeBundler::PipeBundler(Listener* listener, uint64_t maxDelay)
+	  : listener(listener), maxDelay(maxDelay)
+	{
+		MS_TRACE();
+
+		this->timer = new Timer(this);
+
+		// Fixed RTP header: version 2, no padding/extension/CSRCs.
+		this->buffer[0] = 0b10000000;
+		this->buffer[1] = BundlePayloadType;
+		Utils::Byte::Set4Bytes(this->buffer, 8, BundleSsrc);
+	}
+
+	PipeBundler::~PipeBundler()
+	{
+		MS_TRACE();
+
+		delete this->timer;
+
+		// Bundled packets won't be sent.
+		for (auto* cb : this->callbacks)
+		{
+			(*cb)(false);
+			delete cb;
+		}
+	}
+
+	bool PipeBundler::Add(const uint8_t* data, size_t len, onSendCallback* cb)
+	{
+		MS_TRACE();
+
+		if (len > MaxPacketSize)
+		{
+			// Keep packets order.
+			Flush();
+
+			return false;
+		}
+
+		if (this->size + EntryHeaderSize + len > MaxBundleSize)
+			Flush();
+
+		Utils::Byte::Set2Bytes(this->buffer, this->size, static_cast<uint16_t>(len));
+		std::memcpy(this->buffer + this->size + EntryHeaderSize, data, len);
+
+		this->size += EntryHeaderSize + len;
+		++this->numPackets;
+
+		if (cb)
+			this->callbacks.push_back(cb);
+
+		if (this->numPackets == 1u)
+			this->timer->Start(this->maxDelay);
+
+		return true;
+	}
+
+	void PipeBundler::Flush()
+	{
+		MS_TRACE();
+
+		if (this->numPackets == 0u)
+			return;
+
+		this->timer->Stop();
+
+		Send();
+	}
+
+	void PipeBundler::Send()
+	{
+		MS_TRACE();
+
+		onSendCallback* cb{ nullptr };
+
+		if (this->callbacks.size() == 1u)
+		{
+			cb = this->callbacks[0];
+		}
+		else if (!this->callbacks.empty())
+		{
+			auto callbacks = std::make_shared<std::vector<onSendCallback*>>(std::move(this->callbacks));
+
+			cb = new onSendCallback([callbacks](bool sent) {
+				for (auto* callback : *callbacks)
+				{
+					(*callback)(sent);
+					delete callback;
+				}
+			});
+		}
+
+		this->callbacks.clear();
+
+		// Reset the bundle before notifying the listener, which may add packets.
+		auto size       = this->size;
+		auto numPackets = this->numPackets;
+
+		this->size       = HeaderSize;
+		this->numPackets = 0u;
+
+		// A single packet doesn't need to be bundled.
+		if (numPackets == 1u)
+		{
+			this->listener->OnPipeBundlerSend(
+			  this, this->buffer + HeaderSize + EntryHeaderSize, size - HeaderSize - EntryHeaderSize, cb);
+
+			return;
+		}
+
+		Utils::Byte::Set2Bytes(this->buffer, 2, this->seq++);
+		Utils::Byte::Set4Bytes(this->buffer, 4, static_cast<uint32_t>(DepLibUV::GetTimeMs()));
+
+		this->listener->OnPipeBundlerSend(this, this->buffer, size, cb);
+	}
+
+	inline void PipeBundler::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		Send();
+	}
+} // namespace RTC
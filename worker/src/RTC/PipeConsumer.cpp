@@ -184,7 +184,8 @@ namespace RTC
 		return 0u;
 	}
 
-	void PipeConsumer::SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void PipeConsumer::SendRtpPacket(
+	  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache)
 	{
 		MS_TRACE();
 
@@ -253,7 +254,7 @@ namespace RTC
 		}
 
 		// Process the packet.
-		if (rtpStream->ReceivePacket(packet, sharedPacket))
+		if (rtpStream->ReceivePacket(packet, retransmissionCache))
 		{
 			// Send the packet.
 			this->listener->OnConsumerSendRtpPacket(this, packet);
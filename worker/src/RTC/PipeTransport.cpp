@@ -18,6 +18,8 @@ namespace RTC
 	std::string PipeTransport::srtpCryptoSuiteString{ "AEAD_AES_256_GCM" };
 	// MAster length of AEAD_AES_256_GCM.
 	size_t PipeTransport::srtpMasterLength{ 44 };
+	// Packets of a received bundle are copied here before being processed.
+	thread_local static uint8_t UnbundleBuffer[RTC::MtuSize + 100];
 
 	/* Instance methods. */
 
@@ -86,6 +88,37 @@ namespace RTC
 			this->srtpKeyBase64 = Utils::String::Base64Encode(this->srtpKey);
 		}
 
+		auto jsonEnableBundlingIt = data.find("enableBundling");
+
+		// clang-format off
+		if (
+			jsonEnableBundlingIt != data.end() &&
+			jsonEnableBundlingIt->is_boolean() &&
+			jsonEnableBundlingIt->get<bool>()
+		)
+		// clang-format on
+		{
+			uint64_t bundlingMaxDelay{ 1u };
+			auto jsonBundlingMaxDelayIt = data.find("bundlingMaxDelay");
+
+			if (jsonBundlingMaxDelayIt != data.end())
+			{
+				// clang-format off
+				if (
+					!jsonBundlingMaxDelayIt->is_number_unsigned() ||
+					jsonBundlingMaxDelayIt->get<uint64_t>() == 0u
+				)
+				// clang-format on
+				{
+					MS_THROW_TYPE_ERROR("wrong bundlingMaxDelay (not a positive number)");
+				}
+
+				bundlingMaxDelay = jsonBundlingMaxDelayIt->get<uint64_t>();
+			}
+
+			this->bundler = new RTC::PipeBundler(this, bundlingMaxDelay);
+		}
+
 		try
 		{
 			// This may throw.
@@ -101,6 +134,9 @@ namespace RTC
 			delete this->udpSocket;
 			this->udpSocket = nullptr;
 
+			delete this->bundler;
+			this->bundler = nullptr;
+
 			throw;
 		}
 	}
@@ -109,6 +145,10 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Delete it first since it may call send callbacks.
+		delete this->bundler;
+		this->bundler = nullptr;
+
 		delete this->udpSocket;
 		this->udpSocket = nullptr;
 
@@ -449,6 +489,10 @@ namespace RTC
 			return;
 		}
 
+		// The bundle will be protected and sent once ready.
+		if (this->bundler && this->bundler->Add(packet->GetData(), packet->GetSize(), cb))
+			return;
+
 		const uint8_t* data = packet->GetData();
 		auto intLen         = static_cast<int>(packet->GetSize());
 
@@ -478,6 +522,9 @@ namespace RTC
 		if (!IsConnected())
 			return;
 
+		if (this->bundler && this->bundler->Add(packet->GetData(), packet->GetSize(), nullptr))
+			return;
+
 		const uint8_t* data = packet->GetData();
 		auto intLen         = static_cast<int>(packet->GetSize());
 
@@ -499,6 +546,9 @@ namespace RTC
 		if (!IsConnected())
 			return;
 
+		if (this->bundler && this->bundler->Add(packet->GetData(), packet->GetSize(), nullptr))
+			return;
+
 		const uint8_t* data = packet->GetData();
 		auto intLen         = static_cast<int>(packet->GetSize());
 
@@ -615,7 +665,21 @@ namespace RTC
 			return;
 		}
 
-		RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, static_cast<size_t>(intLen));
+		if (this->bundler && RTC::PipeBundler::IsBundle(data, static_cast<size_t>(intLen)))
+		{
+			OnBundleReceived(tuple, data, static_cast<size_t>(intLen));
+
+			return;
+		}
+
+		HandleRtpData(tuple, data, static_cast<size_t>(intLen));
+	}
+
+	inline void PipeTransport::HandleRtpData(RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
 
 		if (!packet)
 		{
@@ -657,6 +721,13 @@ namespace RTC
 			return;
 		}
 
+		HandleRtcpData(tuple, data, static_cast<size_t>(intLen));
+	}
+
+	inline void PipeTransport::HandleRtcpData(RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
 		// Verify that the packet's tuple matches our tuple.
 		if (!this->tuple->Compare(tuple))
 		{
@@ -665,7 +736,7 @@ namespace RTC
 			return;
 		}
 
-		RTC::RTCP::Packet* packet = RTC::RTCP::Packet::Parse(data, static_cast<size_t>(intLen));
+		RTC::RTCP::Packet* packet = RTC::RTCP::Packet::Parse(data, len);
 
 		if (!packet)
 		{
@@ -698,6 +769,36 @@ namespace RTC
 		RTC::Transport::ReceiveSctpData(data, len);
 	}
 
+	inline void PipeTransport::OnBundleReceived(
+	  RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		// Verify that the packet's tuple matches our tuple.
+		if (!this->tuple->Compare(tuple))
+		{
+			MS_DEBUG_TAG(rtp, "ignoring bundle from unknown IP:port");
+
+			return;
+		}
+
+		auto fn = [this, tuple](const uint8_t* packetData, size_t packetLen) {
+			// NOTE: Packets may be modified in place (and grow), so don't let them
+			// overwrite the following ones.
+			std::memcpy(UnbundleBuffer, packetData, packetLen);
+
+			if (RTC::RTCP::Packet::IsRtcp(UnbundleBuffer, packetLen))
+				HandleRtcpData(tuple, UnbundleBuffer, packetLen);
+			else if (RTC::RtpPacket::IsRtp(UnbundleBuffer, packetLen))
+				HandleRtpData(tuple, UnbundleBuffer, packetLen);
+			else
+				MS_WARN_DEV("ignoring bundled packet of unknown type");
+		};
+
+		if (!RTC::PipeBundler::Unbundle(data, len, fn))
+			MS_WARN_TAG(rtp, "received bundle is malformed");
+	}
+
 	inline void PipeTransport::OnUdpSocketPacketReceived(
 	  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr)
 	{
@@ -707,4 +808,41 @@ namespace RTC
 
 		OnPacketReceived(&tuple, data, len);
 	}
+
+	inline void PipeTransport::OnPipeBundlerSend(
+	  RTC::PipeBundler* /*pipeBundler*/,
+	  const uint8_t* data,
+	  size_t len,
+	  RTC::PipeBundler::onSendCallback* cb)
+	{
+		MS_TRACE();
+
+		auto intLen = static_cast<int>(len);
+
+		// A bundle is protected as a single RTP packet.
+		if (HasSrtp())
+		{
+			bool encrypted = RTC::RTCP::Packet::IsRtcp(data, len)
+			                   ? this->srtpSendSession->EncryptRtcp(&data, &intLen)
+			                   : this->srtpSendSession->EncryptRtp(&data, &intLen);
+
+			if (!encrypted)
+			{
+				if (cb)
+				{
+					(*cb)(false);
+					delete cb;
+				}
+
+				return;
+			}
+		}
+
+		len = static_cast<size_t>(intLen);
+
+		this->tuple->Send(data, len, cb);
+
+		// Increase send transmission.
+		RTC::Transport::DataSent(len);
+	}
 } // namespace RTC
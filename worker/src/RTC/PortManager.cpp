@@ -7,6 +7,7 @@
 #include "MediaSoupErrors.hpp"
 #include "Settings.hpp"
 #include "Utils.hpp"
+#include <cerrno> // errno
 #include <tuple>   // std:make_tuple()
 #include <utility> // std::piecewise_construct
 
@@ -26,11 +27,57 @@ namespace RTC
 {
 	/* Class variables. */
 
-	thread_local absl::flat_hash_map<std::string, std::vector<bool>> PortManager::mapUdpIpPorts;
-	thread_local absl::flat_hash_map<std::string, std::vector<bool>> PortManager::mapTcpIpPorts;
+	thread_local absl::flat_hash_map<std::string, PortManager::Ports> PortManager::mapUdpIpPorts;
+	thread_local absl::flat_hash_map<std::string, PortManager::Ports> PortManager::mapTcpIpPorts;
+	thread_local absl::flat_hash_map<std::string, PortManager::UdpSocketPool*>
+	  PortManager::mapUdpIpSocketPools;
 
 	/* Class methods. */
 
+	uv_udp_t* PortManager::BindUdp(std::string& ip)
+	{
+		MS_TRACE();
+
+		if (Settings::configuration.udpSocketPoolSize == 0u)
+			return reinterpret_cast<uv_udp_t*>(Bind(Transport::UDP, ip));
+
+		// First normalize the IP. This may throw if invalid IP.
+		Utils::IP::NormalizeIp(ip);
+
+		auto it = PortManager::mapUdpIpSocketPools.find(ip);
+
+		// The pool of an IP is created once a socket is needed on it, so just next
+		// ones benefit from it.
+		if (it == PortManager::mapUdpIpSocketPools.end())
+		{
+			PortManager::mapUdpIpSocketPools[ip] =
+			  new UdpSocketPool(ip, Settings::configuration.udpSocketPoolSize);
+
+			return reinterpret_cast<uv_udp_t*>(Bind(Transport::UDP, ip));
+		}
+
+		auto* pool     = it->second;
+		auto* uvHandle = pool->Take();
+
+		if (uvHandle)
+			return uvHandle;
+
+		return reinterpret_cast<uv_udp_t*>(Bind(Transport::UDP, ip));
+	}
+
+	void PortManager::CloseUdpSocketPools()
+	{
+		MS_TRACE();
+
+		for (auto& kv : PortManager::mapUdpIpSocketPools)
+		{
+			auto* pool = kv.second;
+
+			delete pool;
+		}
+		PortManager::mapUdpIpSocketPools.clear();
+	}
+
 	uv_handle_t* PortManager::Bind(Transport transport, std::string& ip)
 	{
 		MS_TRACE();
@@ -43,9 +90,18 @@ namespace RTC
 		struct sockaddr_storage bindAddr; // NOLINT(cppcoreguidelines-pro-type-member-init)
 		size_t portIdx;
 		int flags{ 0 };
-		std::vector<bool>& ports = PortManager::GetPorts(transport, ip);
+		Ports& ports = PortManager::GetPorts(transport, ip);
 		size_t attempt{ 0u };
-		size_t numAttempts = ports.size();
+		size_t numAttempts = ports.GetNumFree();
+		// Ports in which bind() failed (probably used by another process). They
+		// are given back once done so they are tried again in next binds.
+		std::vector<size_t> failedPortIdxs;
+		auto releaseFailedPorts = [&ports, &failedPortIdxs]() {
+			for (auto failedPortIdx : failedPortIdxs)
+			{
+				ports.SetFree(failedPortIdx);
+			}
+		};
 		uv_handle_t* uvHandle{ nullptr };
 		uint16_t port;
 		std::string transportStr;
@@ -93,20 +149,18 @@ namespace RTC
 			}
 		}
 
-		// Choose a random port index to start from.
-		portIdx = static_cast<size_t>(Utils::Crypto::GetRandomUInt(
-		  static_cast<uint32_t>(0), static_cast<uint32_t>(ports.size() - 1)));
-
-		// Iterate all ports until getting one available. Fail if none found and also
-		// if bind() fails N times in theoretically available ports.
+		// Pick random available ports until bind() succeeds in one. Fail if there
+		// are no more available ports.
 		while (true)
 		{
 			// Increase attempt number.
 			++attempt;
 
-			// If we have tried all the ports in the range throw.
-			if (attempt > numAttempts)
+			// If we have tried all the available ports in the range throw.
+			if (ports.GetNumFree() == 0u)
 			{
+				releaseFailedPorts();
+
 				MS_THROW_ERROR(
 				  "no more available ports [transport:%s, ip:'%s', numAttempt:%zu]",
 				  transportStr.c_str(),
@@ -114,10 +168,11 @@ namespace RTC
 				  numAttempts);
 			}
 
-			// Increase current port index.
-			portIdx = (portIdx + 1) % ports.size();
+			// Take a random available port.
+			portIdx = ports.GetRandomFree();
+			ports.SetUsed(portIdx);
 
-			// So the corresponding port is the vector position plus the RTC minimum port.
+			// So the corresponding port is the index plus the RTC minimum port.
 			port = static_cast<uint16_t>(portIdx + Settings::configuration.rtcMinPort);
 
 			MS_DEBUG_DEV(
@@ -128,20 +183,6 @@ namespace RTC
 			  attempt,
 			  numAttempts);
 
-			// Check whether this port is not available.
-			if (ports[portIdx])
-			{
-				MS_DEBUG_DEV(
-				  "port in use, trying again [transport:%s, ip:'%s', port:%" PRIu16 ", attempt:%zu/%zu]",
-				  transportStr.c_str(),
-				  ip.c_str(),
-				  port,
-				  attempt,
-				  numAttempts);
-
-				continue;
-			}
-
 			// Here we already have a theoretically available port. Now let's check
 			// whether no other process is binding into it.
 
@@ -176,6 +217,9 @@ namespace RTC
 			{
 				delete uvHandle;
 
+				failedPortIdxs.push_back(portIdx);
+				releaseFailedPorts();
+
 				switch (transport)
 				{
 					case Transport::UDP:
@@ -261,11 +305,15 @@ namespace RTC
 			// If it failed, close the handle and check the reason.
 			uv_close(reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onClose));
 
+			failedPortIdxs.push_back(portIdx);
+
 			switch (err)
 			{
 				// If bind() fails due to "too many open files" just throw.
 				case UV_EMFILE:
 				{
+					releaseFailedPorts();
+
 					MS_THROW_ERROR(
 					  "port bind failed due to too many open files [transport:%s, ip:'%s', port:%" PRIu16
 					  ", attempt:%zu/%zu]",
@@ -281,6 +329,8 @@ namespace RTC
 				// If cannot bind in the given IP, throw.
 				case UV_EADDRNOTAVAIL:
 				{
+					releaseFailedPorts();
+
 					MS_THROW_ERROR(
 					  "port bind failed due to address not available [transport:%s, ip:'%s', port:%" PRIu16
 					  ", attempt:%zu/%zu]",
@@ -300,8 +350,8 @@ namespace RTC
 			}
 		}
 
-		// If here, we got an available port. Mark it as unavailable.
-		ports[portIdx] = true;
+		// If here, we got an available port (already marked as used).
+		releaseFailedPorts();
 
 		MS_DEBUG_DEV(
 		  "bind succeeded [transport:%s, ip:'%s', port:%" PRIu16 ", attempt:%zu/%zu]",
@@ -314,7 +364,8 @@ namespace RTC
 		return static_cast<uv_handle_t*>(uvHandle);
 	}
 
-	uv_handle_t* PortManager::Bind(Transport transport, std::string& ip, uint16_t port)
+	uv_handle_t* PortManager::Bind(
+	  Transport transport, std::string& ip, uint16_t port, bool reusePort)
 	{
 		MS_TRACE();
 
@@ -388,8 +439,12 @@ namespace RTC
 		{
 			case Transport::UDP:
 				uvHandle = reinterpret_cast<uv_handle_t*>(new uv_udp_t());
-				err      = uv_udp_init_ex(
-          DepLibUV::GetLoop(), reinterpret_cast<uv_udp_t*>(uvHandle), UV_UDP_RECVMMSG);
+				// When reusing the port, the socket must be created now (by giving its
+				// family) so SO_REUSEPORT can be set before binding it.
+				err = uv_udp_init_ex(
+				  DepLibUV::GetLoop(),
+				  reinterpret_cast<uv_udp_t*>(uvHandle),
+				  UV_UDP_RECVMMSG | (reusePort ? family : AF_UNSPEC));
 				break;
 
 			case Transport::TCP:
@@ -414,6 +469,32 @@ namespace RTC
 			}
 		}
 
+		if (reusePort)
+		{
+			MS_ASSERT(transport == Transport::UDP, "reusePort is just supported for UDP");
+
+#ifdef SO_REUSEPORT
+			uv_os_fd_t fd;
+			int on{ 1 };
+
+			err = uv_fileno(uvHandle, &fd);
+
+			if (err == 0 && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0)
+				err = uv_translate_sys_error(errno);
+
+			if (err != 0)
+			{
+				uv_close(reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onClose));
+
+				MS_THROW_ERROR("setting SO_REUSEPORT failed: %s", uv_strerror(err));
+			}
+#else
+			uv_close(reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onClose));
+
+			MS_THROW_TYPE_ERROR("SO_REUSEPORT not supported in this platform");
+#endif
+		}
+
 		switch (transport)
 		{
 			case Transport::UDP:
@@ -519,7 +600,8 @@ namespace RTC
 				auto& ports = it->second;
 
 				// Mark the port as available.
-				ports[portIdx] = false;
+				if (ports.IsUsed(portIdx))
+					ports.SetFree(portIdx);
 
 				break;
 			}
@@ -534,20 +616,21 @@ namespace RTC
 				auto& ports = it->second;
 
 				// Mark the port as available.
-				ports[portIdx] = false;
+				if (ports.IsUsed(portIdx))
+					ports.SetFree(portIdx);
 
 				break;
 			}
 		}
 	}
 
-	std::vector<bool>& PortManager::GetPorts(Transport transport, const std::string& ip)
+	PortManager::Ports& PortManager::GetPorts(Transport transport, const std::string& ip)
 	{
 		MS_TRACE();
 
 		// Make GCC happy so it does not print:
 		// "control reaches end of non-void function [-Wreturn-type]"
-		static std::vector<bool> emptyPorts;
+		static Ports emptyPorts(0u);
 
 		switch (transport)
 		{
@@ -564,13 +647,12 @@ namespace RTC
 				}
 
 				// Otherwise add an entry in the map and return it.
-				uint16_t numPorts =
+				size_t numPorts =
 				  Settings::configuration.rtcMaxPort - Settings::configuration.rtcMinPort + 1;
 
-				// Emplace a new vector filled with numPorts false values, meaning that
-				// all ports are available.
+				// Emplace new Ports with all of them available.
 				auto pair = PortManager::mapUdpIpPorts.emplace(
-				  std::piecewise_construct, std::make_tuple(ip), std::make_tuple(numPorts, false));
+				  std::piecewise_construct, std::make_tuple(ip), std::make_tuple(numPorts));
 
 				// pair.first is an iterator to the inserted value.
 				auto& ports = pair.first->second;
@@ -591,13 +673,12 @@ namespace RTC
 				}
 
 				// Otherwise add an entry in the map and return it.
-				uint16_t numPorts =
+				size_t numPorts =
 				  Settings::configuration.rtcMaxPort - Settings::configuration.rtcMinPort + 1;
 
-				// Emplace a new vector filled with numPorts false values, meaning that
-				// all ports are available.
+				// Emplace new Ports with all of them available.
 				auto pair = PortManager::mapTcpIpPorts.emplace(
-				  std::piecewise_construct, std::make_tuple(ip), std::make_tuple(numPorts, false));
+				  std::piecewise_construct, std::make_tuple(ip), std::make_tuple(numPorts));
 
 				// pair.first is an iterator to the inserted value.
 				auto& ports = pair.first->second;
@@ -625,9 +706,9 @@ namespace RTC
 			(*jsonUdpIt)[ip] = json::array();
 			auto jsonIpIt    = jsonUdpIt->find(ip);
 
-			for (size_t i{ 0 }; i < ports.size(); ++i)
+			for (size_t i{ 0 }; i < ports.GetNumPorts(); ++i)
 			{
-				if (!ports[i])
+				if (!ports.IsUsed(i))
 					continue;
 
 				auto port = static_cast<uint16_t>(i + Settings::configuration.rtcMinPort);
@@ -648,9 +729,9 @@ namespace RTC
 			(*jsonTcpIt)[ip] = json::array();
 			auto jsonIpIt    = jsonTcpIt->find(ip);
 
-			for (size_t i{ 0 }; i < ports.size(); ++i)
+			for (size_t i{ 0 }; i < ports.GetNumPorts(); ++i)
 			{
-				if (!ports[i])
+				if (!ports.IsUsed(i))
 					continue;
 
 				auto port = static_cast<uint16_t>(i + Settings::configuration.rtcMinPort);
@@ -659,4 +740,140 @@ namespace RTC
 			}
 		}
 	}
+
+	/* Ports instance methods. */
+
+	PortManager::Ports::Ports(size_t numPorts) : positions(numPorts)
+	{
+		MS_TRACE();
+
+		this->freePortIdxs.reserve(numPorts);
+
+		for (size_t portIdx{ 0u }; portIdx < numPorts; ++portIdx)
+		{
+			this->positions[portIdx] = static_cast<uint32_t>(portIdx);
+			this->freePortIdxs.push_back(static_cast<uint16_t>(portIdx));
+		}
+	}
+
+	size_t PortManager::Ports::GetRandomFree() const
+	{
+		MS_TRACE();
+
+		MS_ASSERT(!this->freePortIdxs.empty(), "no free ports");
+
+		auto position = Utils::Crypto::GetRandomUInt(
+		  static_cast<uint32_t>(0), static_cast<uint32_t>(this->freePortIdxs.size() - 1));
+
+		return this->freePortIdxs[position];
+	}
+
+	void PortManager::Ports::SetUsed(size_t portIdx)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(!IsUsed(portIdx), "port already used");
+
+		auto position    = this->positions[portIdx];
+		auto lastPortIdx = this->freePortIdxs.back();
+
+		// Move the last free port into the position of the given one.
+		this->freePortIdxs[position] = lastPortIdx;
+		this->positions[lastPortIdx] = position;
+		this->freePortIdxs.pop_back();
+
+		this->positions[portIdx] = UsedPosition;
+	}
+
+	void PortManager::Ports::SetFree(size_t portIdx)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(IsUsed(portIdx), "port already free");
+
+		this->positions[portIdx] = static_cast<uint32_t>(this->freePortIdxs.size());
+		this->freePortIdxs.push_back(static_cast<uint16_t>(portIdx));
+	}
+
+	/* UdpSocketPool instance methods. */
+
+	PortManager::UdpSocketPool::UdpSocketPool(const std::string& ip, size_t size)
+	  : ip(ip), size(size)
+	{
+		MS_TRACE();
+
+		this->uvHandles.reserve(size);
+
+		this->timer = new Timer(this);
+
+		// Fill it on next loop iteration.
+		this->timer->Start(0u);
+	}
+
+	PortManager::UdpSocketPool::~UdpSocketPool()
+	{
+		MS_TRACE();
+
+		delete this->timer;
+
+		for (auto* uvHandle : this->uvHandles)
+		{
+			struct sockaddr_storage localAddr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+			int len = sizeof(localAddr);
+			int family;
+			std::string localIp;
+			uint16_t localPort;
+
+			int err =
+			  uv_udp_getsockname(uvHandle, reinterpret_cast<struct sockaddr*>(&localAddr), &len);
+
+			uv_close(reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onClose));
+
+			if (err != 0)
+				continue;
+
+			Utils::IP::GetAddressInfo(
+			  reinterpret_cast<const struct sockaddr*>(&localAddr), family, localIp, localPort);
+
+			PortManager::UnbindUdp(localIp, localPort);
+		}
+	}
+
+	uv_udp_t* PortManager::UdpSocketPool::Take()
+	{
+		MS_TRACE();
+
+		if (!this->timer->IsActive())
+			this->timer->Start(0u);
+
+		if (this->uvHandles.empty())
+			return nullptr;
+
+		auto* uvHandle = this->uvHandles.back();
+
+		this->uvHandles.pop_back();
+
+		return uvHandle;
+	}
+
+	inline void PortManager::UdpSocketPool::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		while (this->uvHandles.size() < this->size)
+		{
+			try
+			{
+				this->uvHandles.push_back(
+				  reinterpret_cast<uv_udp_t*>(PortManager::Bind(Transport::UDP, this->ip)));
+			}
+			catch (const MediaSoupError& error)
+			{
+				MS_WARN_TAG(
+				  ice, "failed to fill UDP socket pool [ip:'%s']: %s", this->ip.c_str(), error.what());
+
+				break;
+			}
+		}
+	}
 } // namespace RTC
@@ -212,6 +212,30 @@ namespace RTC
 			this->paused = jsonPausedIt->get<bool>();
 		}
 
+		// rtpState is optional (given when continuing a Producer of another worker).
+		auto jsonRtpStateIt = data.find("rtpState");
+
+		if (jsonRtpStateIt != data.end())
+		{
+			if (!jsonRtpStateIt->is_array())
+				MS_THROW_TYPE_ERROR("wrong rtpState (not an array)");
+
+			for (auto& jsonEntry : *jsonRtpStateIt)
+			{
+				if (!jsonEntry.is_object())
+					MS_THROW_TYPE_ERROR("wrong entry in rtpState (not an object)");
+
+				auto jsonSsrcIt = jsonEntry.find("ssrc");
+
+				if (jsonSsrcIt == jsonEntry.end() || !Utils::Json::IsPositiveInteger(*jsonSsrcIt))
+					MS_THROW_TYPE_ERROR("wrong entry in rtpState (missing ssrc)");
+
+				// This may throw.
+				this->mapSsrcImportedSeqState[jsonSsrcIt->get<uint32_t>()] =
+				  RTC::RtpStream::SeqState(jsonEntry);
+			}
+		}
+
 		// The number of encodings in rtpParameters must match the number of encodings
 		// in rtpMapping.
 		if (this->rtpParameters.encodings.size() != this->rtpMapping.encodings.size())
@@ -308,6 +332,18 @@ namespace RTC
 			}
 
 			this->keyFrameRequestManager = new RTC::KeyFrameRequestManager(this, keyFrameRequestDelay);
+
+			auto jsonKeyFrameCacheMaxSizeIt = data.find("keyFrameCacheMaxSize");
+
+			// clang-format off
+			if (
+				jsonKeyFrameCacheMaxSizeIt != data.end() &&
+				jsonKeyFrameCacheMaxSizeIt->is_number_unsigned()
+			)
+			// clang-format on
+			{
+				this->keyFrameCacheMaxSize = jsonKeyFrameCacheMaxSizeIt->get<size_t>();
+			}
 		}
 	}
 
@@ -330,10 +366,55 @@ namespace RTC
 		this->mapRtpStreamMappedSsrc.clear();
 		this->mapMappedSsrcSsrc.clear();
 
+		// Delete all retransmission caches.
+		for (auto& kv : this->mapMappedSsrcRetransmissionCache)
+		{
+			auto* retransmissionCache = kv.second;
+
+			delete retransmissionCache;
+		}
+
+		this->mapMappedSsrcRetransmissionCache.clear();
+
+		// Delete all key frame caches.
+		for (auto& kv : this->mapMappedSsrcKeyFrameCache)
+		{
+			auto* keyFrameCache = kv.second;
+
+			delete keyFrameCache;
+		}
+
+		this->mapMappedSsrcKeyFrameCache.clear();
+
 		// Delete the KeyFrameRequestManager.
 		delete this->keyFrameRequestManager;
 	}
 
+	/**
+	 * Sequence state of the received RTP streams, to be given as rtpState to a
+	 * Producer continuing this one in another worker.
+	 */
+	void Producer::FillJsonRtpState(json& jsonArray) const
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->mapSsrcRtpStream)
+		{
+			auto ssrc       = kv.first;
+			auto* rtpStream = kv.second;
+
+			if (!rtpStream->IsStarted())
+				continue;
+
+			jsonArray.emplace_back(json::value_t::object);
+
+			auto& jsonEntry = jsonArray.back();
+
+			jsonEntry["ssrc"] = ssrc;
+			rtpStream->GetSeqState().FillJson(jsonEntry);
+		}
+	}
+
 	void Producer::FillJson(json& jsonObject) const
 	{
 		MS_TRACE();
@@ -509,6 +590,14 @@ namespace RTC
 					rtpStream->Pause();
 				}
 
+				// Cached key frames won't be valid once resumed.
+				for (auto& kv : this->mapMappedSsrcKeyFrameCache)
+				{
+					auto* keyFrameCache = kv.second;
+
+					keyFrameCache->Clear();
+				}
+
 				this->paused = true;
 
 				MS_DEBUG_DEV("Producer paused [producerId:%s]", this->id.c_str());
@@ -705,6 +794,11 @@ namespace RTC
 		// Post-process the packet.
 		PostProcessRtpPacket(packet);
 
+		auto* keyFrameCache = GetKeyFrameCache(packet->GetSsrc());
+
+		if (keyFrameCache)
+			keyFrameCache->ReceivePacket(packet);
+
 		this->listener->OnProducerRtpPacketReceived(this, packet);
 
 		return result;
@@ -1145,6 +1239,16 @@ namespace RTC
 		// Create a RtpStreamRecv for receiving a media stream.
 		auto* rtpStream = new RTC::RtpStreamRecv(this, params, SendNackDelay);
 
+		// Continue the stream of the Producer in the other worker.
+		auto mapSsrcImportedSeqStateIt = this->mapSsrcImportedSeqState.find(ssrc);
+
+		if (mapSsrcImportedSeqStateIt != this->mapSsrcImportedSeqState.end())
+		{
+			rtpStream->SetSeqState(mapSsrcImportedSeqStateIt->second);
+
+			this->mapSsrcImportedSeqState.erase(mapSsrcImportedSeqStateIt);
+		}
+
 		// Insert into the maps.
 		this->mapSsrcRtpStream[ssrc]              = rtpStream;
 		this->rtpStreamByEncodingIdx[encodingIdx] = rtpStream;
@@ -1154,6 +1258,21 @@ namespace RTC
 		this->mapRtpStreamMappedSsrc[rtpStream]             = encodingMapping.mappedSsrc;
 		this->mapMappedSsrcSsrc[encodingMapping.mappedSsrc] = ssrc;
 
+		// Create the retransmission cache shared by all the Consumers of this stream.
+		auto& retransmissionCache = this->mapMappedSsrcRetransmissionCache[encodingMapping.mappedSsrc];
+
+		if (!retransmissionCache)
+			retransmissionCache = new RTC::RtpRetransmissionCache(params.clockRate);
+
+		// Create the key frame cache if enabled.
+		if (this->keyFrameCacheMaxSize > 0u)
+		{
+			auto& keyFrameCache = this->mapMappedSsrcKeyFrameCache[encodingMapping.mappedSsrc];
+
+			if (!keyFrameCache)
+				keyFrameCache = new RTC::KeyFrameCache(this->keyFrameCacheMaxSize);
+		}
+
 		// If the Producer is paused tell it to the new RtpStreamRecv.
 		if (this->paused)
 			rtpStream->Pause();
@@ -11,6 +11,9 @@
 #include "RTC/PipeTransport.hpp"
 #include "RTC/PlainTransport.hpp"
 #include "RTC/WebRtcTransport.hpp"
+#include <algorithm> // std::find()
+#include <limits>    // std::numeric_limits
+#include <utility>   // std::make_pair()
 
 namespace RTC
 {
@@ -43,16 +46,40 @@ namespace RTC
 		}
 		this->mapRtpObservers.clear();
 
+		// Close all FdImporters.
+		for (auto& kv : this->mapFdImporters)
+		{
+			auto* fdImporter = kv.second;
+
+			delete fdImporter;
+		}
+		this->mapFdImporters.clear();
+
 		// Clear other maps.
 		this->mapProducerConsumers.clear();
+		this->mapProducerMappedSsrcConsumers.clear();
 		this->mapConsumerProducer.clear();
+		this->mapConsumers.clear();
 		this->mapProducerRtpObservers.clear();
+		this->mapConsumerRtpObserver.clear();
 		this->mapProducers.clear();
 		this->mapDataProducerDataConsumers.clear();
 		this->mapDataConsumerDataProducer.clear();
 		this->mapDataProducers.clear();
 	}
 
+	void Router::SetOverloadDowngraded(bool overloadDowngraded)
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->mapTransports)
+		{
+			auto* transport = kv.second;
+
+			transport->SetOverloadDowngraded(overloadDowngraded);
+		}
+	}
+
 	void Router::FillJson(json& jsonObject) const
 	{
 		MS_TRACE();
@@ -185,8 +212,43 @@ namespace RTC
 				// This may throw.
 				SetNewTransportIdFromInternal(request->internal, transportId);
 
-				// This may throw.
-				auto* webRtcTransport = new RTC::WebRtcTransport(transportId, this, request->data);
+				FdImporter* fdImporter{ nullptr };
+				auto jsonImportStateIt = request->data.find("importState");
+
+				// The UDP sockets of an exported WebRtcTransport are taken from the
+				// FdImporter they were sent to.
+				if (jsonImportStateIt != request->data.end())
+				{
+					auto jsonSocketPathIt = jsonImportStateIt->find("socketPath");
+
+					if (jsonSocketPathIt == jsonImportStateIt->end() || !jsonSocketPathIt->is_string())
+						MS_THROW_TYPE_ERROR("missing importState.socketPath");
+
+					auto fdImporterIt = this->mapFdImporters.find(jsonSocketPathIt->get<std::string>());
+
+					if (fdImporterIt == this->mapFdImporters.end())
+						MS_THROW_ERROR("no WebRtcTransport import prepared for importState.socketPath");
+
+					// It is used once, whatever the result.
+					fdImporter = fdImporterIt->second;
+					this->mapFdImporters.erase(fdImporterIt);
+				}
+
+				RTC::WebRtcTransport* webRtcTransport{ nullptr };
+
+				try
+				{
+					// This may throw.
+					webRtcTransport = new RTC::WebRtcTransport(transportId, this, request->data, fdImporter);
+				}
+				catch (const MediaSoupError& error)
+				{
+					delete fdImporter;
+
+					throw;
+				}
+
+				delete fdImporter;
 
 				// Insert into the map.
 				this->mapTransports[transportId] = webRtcTransport;
@@ -289,6 +351,22 @@ namespace RTC
 				break;
 			}
 
+			case Channel::ChannelRequest::MethodId::ROUTER_PREPARE_WEBRTC_TRANSPORT_IMPORT:
+			{
+				// This may throw.
+				auto* fdImporter = new FdImporter();
+
+				this->mapFdImporters[fdImporter->GetPath()] = fdImporter;
+
+				json data = json::object();
+
+				data["socketPath"] = fdImporter->GetPath();
+
+				request->Accept(data);
+
+				break;
+			}
+
 			case Channel::ChannelRequest::MethodId::ROUTER_CREATE_PLAIN_TRANSPORT:
 			{
 				std::string transportId;
@@ -434,6 +512,22 @@ namespace RTC
 					rtpObservers.erase(rtpObserver);
 				}
 
+				// Detach the Consumers driven by the closed one.
+				for (auto it = this->mapConsumerRtpObserver.begin();
+				     it != this->mapConsumerRtpObserver.end();)
+				{
+					if (it->second == rtpObserver)
+					{
+						rtpObserver->RemoveConsumer(it->first);
+
+						this->mapConsumerRtpObserver.erase(it++);
+					}
+					else
+					{
+						++it;
+					}
+				}
+
 				MS_DEBUG_DEV("RtpObserver closed [rtpObserverId:%s]", rtpObserver->id.c_str());
 
 				// Delete it.
@@ -500,6 +594,75 @@ namespace RTC
 				break;
 			}
 
+			case Channel::ChannelRequest::MethodId::RTP_OBSERVER_ADD_CONSUMER:
+			{
+				// This may throw.
+				RTC::RtpObserver* rtpObserver = GetRtpObserverFromInternal(request->internal);
+				RTC::Consumer* consumer       = GetConsumerFromData(request->data);
+				RTC::Producer* producer       = GetProducerFromData(request->data);
+
+				if (this->mapConsumerRtpObserver.find(consumer) != this->mapConsumerRtpObserver.end())
+					MS_THROW_ERROR("Consumer already added to a RtpObserver");
+
+				rtpObserver->AddConsumer(consumer, producer);
+
+				// Add to the map.
+				this->mapConsumerRtpObserver[consumer] = rtpObserver;
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::ChannelRequest::MethodId::RTP_OBSERVER_REMOVE_CONSUMER:
+			{
+				// This may throw.
+				RTC::RtpObserver* rtpObserver = GetRtpObserverFromInternal(request->internal);
+				RTC::Consumer* consumer       = GetConsumerFromData(request->data);
+
+				auto it = this->mapConsumerRtpObserver.find(consumer);
+
+				if (it != this->mapConsumerRtpObserver.end() && it->second == rtpObserver)
+				{
+					rtpObserver->RemoveConsumer(consumer);
+
+					// Remove from the map.
+					this->mapConsumerRtpObserver.erase(it);
+				}
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::ChannelRequest::MethodId::ROUTER_BULK_REQUEST:
+			{
+				auto jsonRequestsIt = request->data.find("requests");
+
+				if (jsonRequestsIt == request->data.end() || !jsonRequestsIt->is_array())
+					MS_THROW_TYPE_ERROR("missing requests");
+
+				json data = json::object();
+
+				data["responses"] = json::array();
+				auto jsonResponsesIt = data.find("responses");
+
+				// Bitrate distribution and key frame requests needed by the affected
+				// Consumers are done once all the requests have been handled.
+				{
+					BulkRequestGuard bulkRequestGuard(this);
+
+					for (auto& jsonRequest : *jsonRequestsIt)
+					{
+						jsonResponsesIt->push_back(HandleBulkRequestItem(request->id, jsonRequest));
+					}
+				}
+
+				request->Accept(data);
+
+				break;
+			}
+
 			// Any other request must be delivered to the corresponding Transport.
 			default:
 			{
@@ -634,6 +797,252 @@ namespace RTC
 		return producer;
 	}
 
+	RTC::Consumer* Router::GetConsumerFromData(json& data) const
+	{
+		MS_TRACE();
+
+		auto jsonConsumerIdIt = data.find("consumerId");
+
+		if (jsonConsumerIdIt == data.end() || !jsonConsumerIdIt->is_string())
+		{
+			MS_THROW_TYPE_ERROR("missing consumerId");
+		}
+
+		auto it = this->mapConsumers.find(jsonConsumerIdIt->get_ref<const std::string&>());
+
+		if (it == this->mapConsumers.end())
+			MS_THROW_ERROR("Consumer not found");
+
+		RTC::Consumer* consumer = it->second;
+
+		return consumer;
+	}
+
+	json Router::HandleBulkRequestItem(uint32_t id, json& jsonRequest)
+	{
+		MS_TRACE();
+
+		json jsonResponse = json::object();
+
+		if (!jsonRequest.is_object())
+		{
+			jsonResponse["error"]  = "TypeError";
+			jsonResponse["reason"] = "wrong request (not an object)";
+
+			return jsonResponse;
+		}
+
+		// Requests within a bulk request are given its id.
+		jsonRequest["id"] = id;
+
+		try
+		{
+			// Its reply is stored rather than sent.
+			Channel::ChannelRequest request(nullptr, jsonRequest);
+
+			switch (request.methodId)
+			{
+				case Channel::ChannelRequest::MethodId::TRANSPORT_CONSUME:
+				case Channel::ChannelRequest::MethodId::CONSUMER_PAUSE:
+				case Channel::ChannelRequest::MethodId::CONSUMER_RESUME:
+				case Channel::ChannelRequest::MethodId::CONSUMER_SET_PREFERRED_LAYERS:
+				{
+					try
+					{
+						HandleRequest(&request);
+					}
+					catch (const MediaSoupTypeError& error)
+					{
+						request.TypeError(error.what());
+					}
+					catch (const MediaSoupError& error)
+					{
+						request.Error(error.what());
+					}
+
+					break;
+				}
+
+				default:
+				{
+					request.TypeError("method not allowed in bulk request");
+				}
+			}
+
+			jsonResponse = request.response;
+		}
+		catch (const MediaSoupError& error)
+		{
+			jsonResponse["error"]  = "Error";
+			jsonResponse["reason"] = error.what();
+		}
+
+		return jsonResponse;
+	}
+
+	bool Router::SendCachedKeyFrame(
+	  RTC::Consumer* consumer, RTC::Producer* producer, uint32_t mappedSsrc)
+	{
+		MS_TRACE();
+
+		auto* keyFrameCache = producer->GetKeyFrameCache(mappedSsrc);
+
+		// If the Consumer is waiting for a key frame, provide it with the cached
+		// one (and packets following it) instead of requesting a new one.
+		// NOTE: Not while sending RTP packets to Consumers, since a Consumer may
+		// request a key frame within SendRtpPacket().
+		// clang-format off
+		if (
+			!keyFrameCache ||
+			this->sendingRtpPackets ||
+			!keyFrameCache->HasKeyFrame() ||
+			!consumer->IsWaitingForKeyFrame(mappedSsrc)
+		)
+		// clang-format on
+		{
+			return false;
+		}
+
+		MS_DEBUG_TAG(
+		  rtp,
+		  "sending cached key frame to Consumer [mappedSsrc:%" PRIu32 ", packets:%zu]",
+		  mappedSsrc,
+		  keyFrameCache->GetPackets().size());
+
+		// The Consumer sends the cached packets by itself, so it must not share the
+		// RTP rewrite of a group.
+		for (auto& kv : this->mapProducerMappedSsrcConsumers.at(producer))
+		{
+			kv.second.UpdateGroup(consumer);
+		}
+
+		auto* retransmissionCache = producer->GetRtpRetransmissionCache(mappedSsrc);
+		const auto& mid           = consumer->GetRtpParameters().mid;
+
+		this->sendingRtpPackets = true;
+
+		for (auto* packet : keyFrameCache->GetPackets())
+		{
+			if (retransmissionCache)
+				retransmissionCache->SetCurrentPacket(packet);
+
+			if (!mid.empty())
+				packet->UpdateMid(mid);
+
+			consumer->SendRtpPacket(packet, retransmissionCache);
+		}
+
+		this->sendingRtpPackets = false;
+
+		UpdatePendingForwardedRtpStreamsConsumers();
+
+		// The Consumer may have discarded the cached key frame.
+		return !consumer->IsWaitingForKeyFrame(mappedSsrc);
+	}
+
+	void Router::RequestPendingKeyFrames()
+	{
+		MS_TRACE();
+
+		if (this->pendingKeyFrameRequests.empty())
+			return;
+
+		auto keyFrameRequests = std::move(this->pendingKeyFrameRequests);
+
+		this->pendingKeyFrameRequests.clear();
+
+		// Producer streams a key frame has already been requested for.
+		std::vector<std::pair<RTC::Producer*, uint32_t>> requestedKeyFrames;
+
+		for (auto& kv : keyFrameRequests)
+		{
+			auto* consumer             = kv.first;
+			auto mappedSsrc            = kv.second;
+			auto mapConsumerProducerIt = this->mapConsumerProducer.find(consumer);
+
+			// The Consumer may have been closed meanwhile.
+			if (mapConsumerProducerIt == this->mapConsumerProducer.end())
+				continue;
+
+			auto* producer = mapConsumerProducerIt->second;
+
+			if (SendCachedKeyFrame(consumer, producer, mappedSsrc))
+				continue;
+
+			auto requestedKeyFrame = std::make_pair(producer, mappedSsrc);
+
+			// clang-format off
+			if (
+				std::find(requestedKeyFrames.begin(), requestedKeyFrames.end(), requestedKeyFrame) !=
+				requestedKeyFrames.end()
+			)
+			// clang-format on
+			{
+				continue;
+			}
+
+			requestedKeyFrames.push_back(requestedKeyFrame);
+
+			producer->RequestKeyFrame(mappedSsrc);
+		}
+	}
+
+	void Router::UpdateConsumerForwardedRtpStreams(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		// Not yet (or no longer) associated to a Producer.
+		auto mapConsumerProducerIt = this->mapConsumerProducer.find(consumer);
+
+		if (mapConsumerProducerIt == this->mapConsumerProducer.end())
+			return;
+
+		// Sets being iterated must not be modified, so do it later.
+		if (this->sendingRtpPackets)
+		{
+			this->pendingForwardedRtpStreamsConsumers.push_back(consumer);
+
+			return;
+		}
+
+		auto* producer               = mapConsumerProducerIt->second;
+		auto& mapMappedSsrcConsumers = this->mapProducerMappedSsrcConsumers.at(producer);
+
+		for (const auto& encoding : consumer->GetConsumableRtpEncodings())
+		{
+			auto& rtpStreamConsumers = mapMappedSsrcConsumers[encoding.ssrc];
+
+			if (consumer->IsForwardingRtpStream(encoding.ssrc))
+			{
+				rtpStreamConsumers.Add(consumer);
+
+				// The Consumer may send packets of other streams by itself now.
+				rtpStreamConsumers.UpdateGroup(consumer);
+			}
+			else
+			{
+				rtpStreamConsumers.Remove(consumer);
+			}
+		}
+	}
+
+	void Router::UpdatePendingForwardedRtpStreamsConsumers()
+	{
+		MS_TRACE();
+
+		if (this->pendingForwardedRtpStreamsConsumers.empty())
+			return;
+
+		auto consumers = std::move(this->pendingForwardedRtpStreamsConsumers);
+
+		this->pendingForwardedRtpStreamsConsumers.clear();
+
+		for (auto* consumer : consumers)
+		{
+			UpdateConsumerForwardedRtpStreams(consumer);
+		}
+	}
+
 	inline void Router::OnTransportNewProducer(RTC::Transport* /*transport*/, RTC::Producer* producer)
 	{
 		MS_TRACE();
@@ -650,6 +1059,7 @@ namespace RTC
 		// Insert the Producer in the maps.
 		this->mapProducers[producer->id] = producer;
 		this->mapProducerConsumers[producer];
+		this->mapProducerMappedSsrcConsumers[producer];
 		this->mapProducerRtpObservers[producer];
 	}
 
@@ -695,6 +1105,7 @@ namespace RTC
 		// Remove the Producer from the maps.
 		this->mapProducers.erase(mapProducersIt);
 		this->mapProducerConsumers.erase(mapProducerConsumersIt);
+		this->mapProducerMappedSsrcConsumers.erase(producer);
 		this->mapProducerRtpObservers.erase(mapProducerRtpObserversIt);
 	}
 
@@ -794,25 +1205,74 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		auto& consumers = this->mapProducerConsumers.at(producer);
-
-		if (!consumers.empty())
+		// Just the Consumers forwarding the Producer RTP stream of the packet (i.e.
+		// not those receiving a different simulcast stream) are considered.
+		auto& mapMappedSsrcConsumers  = this->mapProducerMappedSsrcConsumers.at(producer);
+		auto mapMappedSsrcConsumersIt = mapMappedSsrcConsumers.find(packet->GetSsrc());
+
+		// clang-format off
+		if (
+			mapMappedSsrcConsumersIt != mapMappedSsrcConsumers.end() &&
+			!mapMappedSsrcConsumersIt->second.IsEmpty()
+		)
+		// clang-format on
 		{
-			// Cloned ref-counted packet that RtpStreamSend will store for as long as
-			// needed avoiding multiple allocations unless absolutely necessary.
-			// Clone only happens if needed.
-			std::shared_ptr<RTC::RtpPacket> sharedPacket;
+			// NOTE: Iterate a contiguous array rather than a hash set.
+			auto& rtpStreamConsumers = mapMappedSsrcConsumersIt->second;
+			auto& consumers          = rtpStreamConsumers.consumers;
 
-			for (auto* consumer : consumers)
+			// Retransmission cache of the Producer RTP stream shared by all the
+			// Consumers. The packet is only cloned (once) if some of them needs it.
+			auto* retransmissionCache = producer->GetRtpRetransmissionCache(packet->GetSsrc());
+
+			if (retransmissionCache)
+				retransmissionCache->SetCurrentPacket(packet);
+
+			rtpStreamConsumers.UpdateGroups(packet);
+
+			this->sendingRtpPackets = true;
+
+			size_t groupStart{ 0u };
+
+			for (auto groupSize : rtpStreamConsumers.groupSizes)
 			{
-				// Update MID RTP extension value.
-				const auto& mid = consumer->GetRtpParameters().mid;
+				auto* leader = consumers[groupStart];
 
-				if (!mid.empty())
-					packet->UpdateMid(mid);
+				if (groupSize == 1u)
+				{
+					// Update MID RTP extension value.
+					const auto& mid = leader->GetRtpParameters().mid;
 
-				consumer->SendRtpPacket(packet, sharedPacket);
+					if (!mid.empty())
+						packet->UpdateMid(mid);
+
+					leader->SendRtpPacket(packet, retransmissionCache);
+				}
+				// The packet is rewritten once for the whole group.
+				else if (leader->RewriteRtpPacket(packet))
+				{
+					for (auto idx = groupStart; idx < groupStart + groupSize; ++idx)
+					{
+						auto* consumer = consumers[idx];
+
+						// Update MID RTP extension value.
+						const auto& mid = consumer->GetRtpParameters().mid;
+
+						if (!mid.empty())
+							packet->UpdateMid(mid);
+
+						consumer->SendRewrittenRtpPacket(packet, leader, retransmissionCache);
+					}
+
+					leader->RestoreRtpPacket(packet);
+				}
+
+				groupStart += groupSize;
 			}
+
+			this->sendingRtpPackets = false;
+
+			UpdatePendingForwardedRtpStreamsConsumers();
 		}
 
 		auto it = this->mapProducerRtpObservers.find(producer);
@@ -873,6 +1333,9 @@ namespace RTC
 
 		consumers.insert(consumer);
 		this->mapConsumerProducer[consumer] = producer;
+		this->mapConsumers[consumer->id]    = consumer;
+
+		UpdateConsumerForwardedRtpStreams(consumer);
 
 		// Get all streams in the Producer and provide the Consumer with them.
 		for (const auto& kv : producer->GetRtpStreams())
@@ -914,8 +1377,25 @@ namespace RTC
 
 		consumers.erase(consumer);
 
-		// Remove the Consumer from the map.
+		// Remove the Consumer from the sets of Consumers of the Producer streams.
+		for (auto& kv : this->mapProducerMappedSsrcConsumers.at(producer))
+		{
+			kv.second.Remove(consumer);
+		}
+
+		// Remove the Consumer from the maps.
 		this->mapConsumerProducer.erase(mapConsumerProducerIt);
+		this->mapConsumers.erase(consumer->id);
+
+		// Tell the RtpObserver driving the Consumer (if any) that it was closed.
+		auto mapConsumerRtpObserverIt = this->mapConsumerRtpObserver.find(consumer);
+
+		if (mapConsumerRtpObserverIt != this->mapConsumerRtpObserver.end())
+		{
+			mapConsumerRtpObserverIt->second->ConsumerClosed(consumer);
+
+			this->mapConsumerRtpObserver.erase(mapConsumerRtpObserverIt);
+		}
 	}
 
 	inline void Router::OnTransportConsumerProducerClosed(
@@ -934,8 +1414,19 @@ namespace RTC
 		  mapConsumerProducerIt != this->mapConsumerProducer.end(),
 		  "Consumer not present in mapConsumerProducer");
 
-		// Remove the Consumer from the map.
+		// Remove the Consumer from the maps.
 		this->mapConsumerProducer.erase(mapConsumerProducerIt);
+		this->mapConsumers.erase(consumer->id);
+
+		// Tell the RtpObserver driving the Consumer (if any) that it was closed.
+		auto mapConsumerRtpObserverIt = this->mapConsumerRtpObserver.find(consumer);
+
+		if (mapConsumerRtpObserverIt != this->mapConsumerRtpObserver.end())
+		{
+			mapConsumerRtpObserverIt->second->ConsumerClosed(consumer);
+
+			this->mapConsumerRtpObserver.erase(mapConsumerRtpObserverIt);
+		}
 	}
 
 	inline void Router::OnTransportConsumerKeyFrameRequested(
@@ -943,11 +1434,31 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Within a bulk request, key frame requests are done once it ends so those
+		// of many Consumers of the same Producer stream become a single one.
+		if (this->handlingBulkRequest)
+		{
+			this->pendingKeyFrameRequests.emplace_back(consumer, mappedSsrc);
+
+			return;
+		}
+
 		auto* producer = this->mapConsumerProducer.at(consumer);
 
+		if (SendCachedKeyFrame(consumer, producer, mappedSsrc))
+			return;
+
 		producer->RequestKeyFrame(mappedSsrc);
 	}
 
+	inline void Router::OnTransportConsumerForwardedRtpStreamsChange(
+	  RTC::Transport* /*transport*/, RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		UpdateConsumerForwardedRtpStreams(consumer);
+	}
+
 	inline void Router::OnTransportNewDataProducer(
 	  RTC::Transport* /*transport*/, RTC::DataProducer* dataProducer)
 	{
@@ -1121,4 +1632,307 @@ namespace RTC
 		// Delete it.
 		delete transport;
 	}
+
+	/* Instance methods of RtpStreamConsumers. */
+
+	void Router::RtpStreamConsumers::Add(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		if (std::find(this->consumers.begin(), this->consumers.end(), consumer) != this->consumers.end())
+			return;
+
+		this->consumers.push_back(consumer);
+		this->groupSizes.push_back(1u);
+	}
+
+	void Router::RtpStreamConsumers::Remove(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		auto it = std::find(this->consumers.begin(), this->consumers.end(), consumer);
+
+		if (it == this->consumers.end())
+			return;
+
+		auto idx = static_cast<size_t>(it - this->consumers.begin());
+		size_t groupIdx{ 0u };
+		size_t groupStart{ 0u };
+
+		while (groupStart + this->groupSizes[groupIdx] <= idx)
+		{
+			groupStart += this->groupSizes[groupIdx++];
+		}
+
+		auto* leader = this->consumers[groupStart];
+
+		if (this->groupSizes[groupIdx] > 1u)
+		{
+			// The next Consumer leads the group, taking the rewrite state of the leader.
+			if (consumer == leader)
+				this->consumers[idx + 1]->LeaveRtpRewrite(leader);
+			// The Consumer may send packets by itself later.
+			else
+				consumer->LeaveRtpRewrite(leader);
+		}
+
+		this->consumers.erase(it);
+
+		if (--this->groupSizes[groupIdx] == 0u)
+			this->groupSizes.erase(this->groupSizes.begin() + groupIdx);
+	}
+
+	void Router::RtpStreamConsumers::UpdateGroups(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		bool isKeyFrame = packet->IsKeyFrame();
+
+		// No groups, so nothing to split.
+		if (this->groupSizes.size() == this->consumers.size())
+		{
+			if (isKeyFrame)
+				JoinGroups(packet);
+
+			return;
+		}
+
+		this->regroupedConsumers.clear();
+		this->regroupedGroupSizes.clear();
+		this->splitConsumers.clear();
+
+		size_t groupStart{ 0u };
+
+		for (auto groupSize : this->groupSizes)
+		{
+			auto groupEnd = groupStart + groupSize;
+			auto idx      = groupStart;
+			auto* leader  = this->consumers[idx++];
+
+			// While the leader cannot lead, the next Consumer does, taking the
+			// rewrite state of the leader.
+			while (idx < groupEnd && !leader->CanLeadRtpRewrite())
+			{
+				auto* consumer = this->consumers[idx++];
+
+				consumer->LeaveRtpRewrite(leader);
+				this->splitConsumers.push_back(leader);
+
+				leader = consumer;
+			}
+
+			this->regroupedConsumers.push_back(leader);
+
+			size_t regroupedGroupSize{ 1u };
+
+			for (; idx < groupEnd; ++idx)
+			{
+				auto* consumer = this->consumers[idx];
+
+				if (consumer->CanShareRtpRewrite(leader) || consumer->CanJoinRtpRewrite(leader, packet))
+				{
+					this->regroupedConsumers.push_back(consumer);
+					++regroupedGroupSize;
+				}
+				else
+				{
+					consumer->LeaveRtpRewrite(leader);
+					this->splitConsumers.push_back(consumer);
+				}
+			}
+
+			this->regroupedGroupSizes.push_back(regroupedGroupSize);
+
+			groupStart = groupEnd;
+		}
+
+		for (auto* consumer : this->splitConsumers)
+		{
+			this->regroupedConsumers.push_back(consumer);
+			this->regroupedGroupSizes.push_back(1u);
+		}
+
+		std::swap(this->consumers, this->regroupedConsumers);
+		std::swap(this->groupSizes, this->regroupedGroupSizes);
+
+		if (isKeyFrame)
+			JoinGroups(packet);
+	}
+
+	void Router::RtpStreamConsumers::UpdateGroup(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		auto it = std::find(this->consumers.begin(), this->consumers.end(), consumer);
+
+		if (it == this->consumers.end())
+			return;
+
+		auto idx = static_cast<size_t>(it - this->consumers.begin());
+		size_t groupIdx{ 0u };
+		size_t groupStart{ 0u };
+
+		while (groupStart + this->groupSizes[groupIdx] <= idx)
+		{
+			groupStart += this->groupSizes[groupIdx++];
+		}
+
+		if (this->groupSizes[groupIdx] == 1u)
+			return;
+
+		auto* leader = this->consumers[groupStart];
+
+		if (consumer == leader)
+		{
+			if (consumer->CanLeadRtpRewrite())
+				return;
+
+			// The next Consumer leads the group, taking the rewrite state of the leader.
+			this->consumers[idx + 1]->LeaveRtpRewrite(leader);
+		}
+		else
+		{
+			if (consumer->CanShareRtpRewrite(leader))
+				return;
+
+			consumer->LeaveRtpRewrite(leader);
+		}
+
+		this->consumers.erase(it);
+		--this->groupSizes[groupIdx];
+
+		this->consumers.push_back(consumer);
+		this->groupSizes.push_back(1u);
+	}
+
+	void Router::RtpStreamConsumers::JoinGroups(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		static constexpr size_t NoGroup{ std::numeric_limits<size_t>::max() };
+
+		this->groupStarts.clear();
+		this->joinedGroups.clear();
+
+		size_t groupStart{ 0u };
+
+		for (auto groupSize : this->groupSizes)
+		{
+			this->groupStarts.push_back(groupStart);
+			this->joinedGroups.push_back(NoGroup);
+
+			groupStart += groupSize;
+		}
+
+		bool joined{ false };
+
+		// A Consumer joining a group is marked with the index of the group, and
+		// a group being joined with its own index.
+		for (size_t groupIdx{ 0u }; groupIdx < this->groupSizes.size(); ++groupIdx)
+		{
+			if (this->groupSizes[groupIdx] != 1u || this->joinedGroups[groupIdx] != NoGroup)
+				continue;
+
+			auto* consumer = this->consumers[this->groupStarts[groupIdx]];
+
+			if (!consumer->MayJoinRtpRewrite(packet))
+				continue;
+
+			for (size_t leaderGroupIdx{ 0u }; leaderGroupIdx < this->groupSizes.size(); ++leaderGroupIdx)
+			{
+				// clang-format off
+				if (
+					leaderGroupIdx == groupIdx ||
+					(
+						this->joinedGroups[leaderGroupIdx] != NoGroup &&
+						this->joinedGroups[leaderGroupIdx] != leaderGroupIdx
+					)
+				)
+				// clang-format on
+				{
+					continue;
+				}
+
+				auto* leader = this->consumers[this->groupStarts[leaderGroupIdx]];
+
+				if (!consumer->CanJoinRtpRewrite(leader, packet))
+					continue;
+
+				this->joinedGroups[groupIdx]       = leaderGroupIdx;
+				this->joinedGroups[leaderGroupIdx] = leaderGroupIdx;
+				joined                             = true;
+
+				break;
+			}
+		}
+
+		if (!joined)
+			return;
+
+		this->regroupedConsumers.clear();
+		this->regroupedGroupSizes.clear();
+
+		for (size_t groupIdx{ 0u }; groupIdx < this->groupSizes.size(); ++groupIdx)
+		{
+			auto joinedGroup = this->joinedGroups[groupIdx];
+
+			// Moved to the group it joins.
+			if (joinedGroup != NoGroup && joinedGroup != groupIdx)
+				continue;
+
+			auto groupSize = this->groupSizes[groupIdx];
+			auto begin     = this->consumers.begin() + this->groupStarts[groupIdx];
+
+			this->regroupedConsumers.insert(this->regroupedConsumers.end(), begin, begin + groupSize);
+
+			if (joinedGroup == groupIdx)
+			{
+				for (size_t idx{ 0u }; idx < this->groupSizes.size(); ++idx)
+				{
+					if (idx == groupIdx || this->joinedGroups[idx] != groupIdx)
+						continue;
+
+					this->regroupedConsumers.push_back(this->consumers[this->groupStarts[idx]]);
+					++groupSize;
+				}
+			}
+
+			this->regroupedGroupSizes.push_back(groupSize);
+		}
+
+		std::swap(this->consumers, this->regroupedConsumers);
+		std::swap(this->groupSizes, this->regroupedGroupSizes);
+	}
+
+	/* Instance methods of BulkRequestGuard. */
+
+	Router::BulkRequestGuard::BulkRequestGuard(RTC::Router* router) : router(router)
+	{
+		MS_TRACE();
+
+		this->router->handlingBulkRequest = true;
+
+		for (auto& kv : this->router->mapTransports)
+		{
+			auto* transport = kv.second;
+
+			transport->BulkRequestStarted();
+		}
+	}
+
+	Router::BulkRequestGuard::~BulkRequestGuard()
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->router->mapTransports)
+		{
+			auto* transport = kv.second;
+
+			transport->BulkRequestEnded();
+		}
+
+		this->router->handlingBulkRequest = false;
+
+		this->router->RequestPendingKeyFrames();
+	}
 } // namespace RTC
@@ -251,7 +251,12 @@ namespace RTC
 
 		for (const auto& codec : this->codecs)
 		{
-			if (codec.mimeType.IsFeatureCodec() && codec.parameters.GetInteger(AptString) == payloadType)
+			// clang-format off
+			if (
+				codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::RTX &&
+				codec.parameters.GetInteger(AptString) == payloadType
+			)
+			// clang-format on
 			{
 				return std::addressof(codec);
 			}
@@ -3,6 +3,7 @@
 
 #include "RTC/RtpObserver.hpp"
 #include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
 
 namespace RTC
 {
@@ -41,4 +42,21 @@ namespace RTC
 
 		Resumed();
 	}
+
+	void RtpObserver::AddConsumer(RTC::Consumer* /*consumer*/, RTC::Producer* /*producer*/)
+	{
+		MS_TRACE();
+
+		MS_THROW_TYPE_ERROR("Consumers not supported by this RtpObserver");
+	}
+
+	void RtpObserver::RemoveConsumer(RTC::Consumer* /*consumer*/)
+	{
+		MS_TRACE();
+	}
+
+	void RtpObserver::ConsumerClosed(RTC::Consumer* /*consumer*/)
+	{
+		MS_TRACE();
+	}
 } // namespace RTC
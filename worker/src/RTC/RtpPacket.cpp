@@ -638,7 +638,21 @@ namespace RTC
 		MS_TRACE();
 
 		auto* buffer = new uint8_t[MtuSize + 100];
-		auto* ptr    = const_cast<uint8_t*>(buffer);
+		auto* packet = Clone(buffer);
+
+		// Store allocated buffer.
+		packet->buffer = buffer;
+
+		return packet;
+	}
+
+	// NOTE: The caller must ensure that the given buffer has space enough for
+	// MtuSize + 100 bytes and that it outlives the returned packet.
+	RtpPacket* RtpPacket::Clone(uint8_t* buffer) const
+	{
+		MS_TRACE();
+
+		auto* ptr = buffer;
 
 		size_t numBytes{ 0 };
 
@@ -710,12 +724,105 @@ namespace RTC
 		packet->videoOrientationExtensionId  = this->videoOrientationExtensionId;
 		// Assign the payload descriptor handler.
 		packet->payloadDescriptorHandler = this->payloadDescriptorHandler;
-		// Store allocated buffer.
-		packet->buffer = buffer;
 
 		return packet;
 	}
 
+	// Rewrites this packet with a copy of the given one, so a long-lived packet
+	// can be reused without allocating a new instance.
+	// NOTE: The buffer of this packet must have space enough for MtuSize + 100
+	// bytes (as the one given to Clone()).
+	void RtpPacket::CopyFrom(const RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(packet != this, "cannot copy a packet into itself");
+
+		auto* buffer = reinterpret_cast<uint8_t*>(this->header);
+		auto* ptr    = buffer;
+
+		size_t numBytes{ 0 };
+
+		// Copy the minimum header.
+		numBytes = HeaderSize;
+		std::memcpy(ptr, packet->GetData(), numBytes);
+
+		ptr += numBytes;
+
+		// Copy CSRC list.
+		if (packet->csrcList != nullptr)
+		{
+			numBytes = packet->header->csrcCount * sizeof(packet->header->ssrc);
+			std::memcpy(ptr, packet->csrcList, numBytes);
+
+			this->csrcList = buffer + HeaderSize;
+
+			ptr += numBytes;
+		}
+		else
+		{
+			this->csrcList = nullptr;
+		}
+
+		// Copy header extension.
+		if (packet->headerExtension != nullptr)
+		{
+			numBytes = 4 + packet->GetHeaderExtensionLength();
+			std::memcpy(ptr, packet->headerExtension, numBytes);
+
+			this->headerExtension = reinterpret_cast<HeaderExtension*>(ptr);
+
+			ptr += numBytes;
+		}
+		else
+		{
+			this->headerExtension = nullptr;
+		}
+
+		// Copy payload.
+		this->payload = ptr;
+
+		if (packet->payloadLength != 0u)
+		{
+			numBytes = packet->payloadLength;
+			std::memcpy(ptr, packet->payload, numBytes);
+
+			ptr += numBytes;
+		}
+
+		// Copy payload padding.
+		if (packet->payloadPadding != 0u)
+		{
+			*(ptr + static_cast<size_t>(packet->payloadPadding) - 1) = packet->payloadPadding;
+			ptr += size_t{ packet->payloadPadding };
+		}
+
+		MS_ASSERT(static_cast<size_t>(ptr - buffer) == packet->size, "ptr - buffer == packet->size");
+
+		this->payloadLength  = packet->payloadLength;
+		this->payloadPadding = packet->payloadPadding;
+		this->size           = packet->size;
+
+		// Keep already set extension ids.
+		this->midExtensionId               = packet->midExtensionId;
+		this->ridExtensionId               = packet->ridExtensionId;
+		this->rridExtensionId              = packet->rridExtensionId;
+		this->absSendTimeExtensionId       = packet->absSendTimeExtensionId;
+		this->transportWideCc01ExtensionId = packet->transportWideCc01ExtensionId;
+		this->frameMarking07ExtensionId    = packet->frameMarking07ExtensionId; // Remove once RFC.
+		this->frameMarkingExtensionId      = packet->frameMarkingExtensionId;
+		this->ssrcAudioLevelExtensionId    = packet->ssrcAudioLevelExtensionId;
+		this->videoOrientationExtensionId  = packet->videoOrientationExtensionId;
+		// Assign the payload descriptor handler.
+		this->payloadDescriptorHandler = packet->payloadDescriptorHandler;
+
+		// Parse RFC 5285 header extension (the previous ones must be forgotten).
+		std::fill(std::begin(this->oneByteExtensions), std::end(this->oneByteExtensions), nullptr);
+		this->mapTwoBytesExtensions.clear();
+
+		ParseExtensions();
+	}
+
 	// NOTE: The caller must ensure that the buffer/memmory of the packet has
 	// space enough for adding 2 extra bytes.
 	void RtpPacket::RtxEncode(uint8_t payloadType, uint32_t ssrc, uint16_t seq)
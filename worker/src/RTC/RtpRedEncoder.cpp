@@ -0,0 +1,160 @@
+#define MS_CLASS "RTC::RtpRedEncoder"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/RtpRedEncoder.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include <cstring> // std::memcpy()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Max timestamp offset of a redundant block (14 bits in the RED block header).
+	static constexpr uint32_t MaxTimestampOffset{ 0x3FFFu };
+	static constexpr size_t BlockHeaderLength{ 4u };
+	static constexpr size_t PrimaryBlockHeaderLength{ 1u };
+
+	/* Instance methods. */
+
+	RtpRedEncoder::RtpRedEncoder(uint8_t payloadType, size_t distance)
+	  : payloadType(payloadType), distance(distance)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(distance <= MaxDistance, "invalid distance");
+	}
+
+	RtpRedEncoder::~RtpRedEncoder()
+	{
+		MS_TRACE();
+
+		delete this->redPacket;
+	}
+
+	/**
+	 * Returns the RED packet for the given (already mangled) packet, or nullptr
+	 * if it cannot be wrapped and must be sent as it is.
+	 */
+	RTC::RtpPacket* RtpRedEncoder::Encode(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		// clang-format off
+		if (
+			packet->GetPayloadLength() == 0u ||
+			packet->GetSize() + PrimaryBlockHeaderLength > RTC::MtuSize
+		)
+		// clang-format on
+		{
+			return nullptr;
+		}
+
+		auto timestamp = packet->GetTimestamp();
+		auto available = RTC::MtuSize - packet->GetSize() - PrimaryBlockHeaderLength;
+
+		// Take as many previous frames as fit, the most recent ones first.
+		size_t numBlocks{ 0u };
+		size_t blocksLength{ 0u };
+
+		for (; numBlocks < this->numFrames; ++numBlocks)
+		{
+			auto idx = (this->nextFrameIdx + this->distance - 1u - numBlocks) % this->distance;
+			const auto& frame = this->frames[idx];
+			auto offset       = timestamp - frame.timestamp;
+
+			// clang-format off
+			if (
+				offset == 0u ||
+				offset > MaxTimestampOffset ||
+				BlockHeaderLength + frame.length > available
+			)
+			// clang-format on
+			{
+				break;
+			}
+
+			blocksLength += BlockHeaderLength + frame.length;
+			available -= BlockHeaderLength + frame.length;
+		}
+
+		// The RED packet is allocated once and then rewritten in place.
+		if (!this->redPacket)
+			this->redPacket = packet->Clone(this->buffer);
+		else
+			this->redPacket->CopyFrom(packet);
+
+		// Make room for the RED headers and the redundant blocks in front of the
+		// primary block.
+		this->redPacket->ShiftPayload(0u, blocksLength + PrimaryBlockHeaderLength);
+
+		auto primaryPayloadType = packet->GetPayloadType();
+		auto* headerPtr         = this->redPacket->GetPayload();
+		auto* dataPtr = headerPtr + (numBlocks * BlockHeaderLength) + PrimaryBlockHeaderLength;
+
+		// Redundant blocks go first, the oldest one first.
+		for (size_t i{ numBlocks }; i > 0u; --i)
+		{
+			auto idx          = (this->nextFrameIdx + this->distance - i) % this->distance;
+			const auto& frame = this->frames[idx];
+			auto offset       = timestamp - frame.timestamp;
+
+			headerPtr[0] = 0x80u | primaryPayloadType;
+			Utils::Byte::Set3Bytes(headerPtr, 1, (offset << 10) | static_cast<uint32_t>(frame.length));
+			std::memcpy(dataPtr, frame.data, frame.length);
+
+			headerPtr += BlockHeaderLength;
+			dataPtr += frame.length;
+		}
+
+		// Primary block header (the primary payload is already in place).
+		headerPtr[0] = primaryPayloadType & 0x7Fu;
+
+		this->redPacket->SetPayloadType(this->payloadType);
+
+		StoreFrame(packet);
+
+		return this->redPacket;
+	}
+
+	/**
+	 * Forgets previous frames, so they are not sent as redundant blocks.
+	 */
+	void RtpRedEncoder::Reset()
+	{
+		MS_TRACE();
+
+		this->numFrames    = 0u;
+		this->nextFrameIdx = 0u;
+	}
+
+	inline void RtpRedEncoder::StoreFrame(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		if (this->distance == 0u)
+			return;
+
+		auto length = packet->GetPayloadLength();
+
+		// A frame that does not fit into a redundant block breaks the sequence of
+		// previous frames.
+		if (length > MaxFrameLength)
+		{
+			Reset();
+
+			return;
+		}
+
+		auto& frame = this->frames[this->nextFrameIdx];
+
+		frame.timestamp = packet->GetTimestamp();
+		frame.length    = length;
+		std::memcpy(frame.data, packet->GetPayload(), length);
+
+		this->nextFrameIdx = (this->nextFrameIdx + 1u) % this->distance;
+
+		if (this->numFrames < this->distance)
+			++this->numFrames;
+	}
+} // namespace RTC
@@ -0,0 +1,352 @@
+#define MS_CLASS "RTC::RtpRetransmissionCache"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/RtpRetransmissionCache.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "Settings.hpp"
+#include "RTC/SeqManager.hpp"
+#include <algorithm> // std::max()
+#include <utility>   // std::swap()
+
+namespace RTC
+{
+	/* Static. */
+
+	static constexpr uint16_t MaxSeq = std::numeric_limits<uint16_t>::max();
+	// Memory taken by a stored packet (as allocated by RtpPacket::Clone()).
+	static constexpr size_t StoredPacketMemory{ sizeof(RTC::RtpPacket) + RTC::MtuSize + 100u };
+
+	/* Class variables. */
+
+	thread_local std::vector<RtpRetransmissionCache*> RtpRetransmissionCache::heap;
+	thread_local size_t RtpRetransmissionCache::totalMemory{ 0u };
+	thread_local uint64_t RtpRetransmissionCache::evictedPacketCount{ 0u };
+
+	/* Class methods. */
+
+	/**
+	 * Removes the oldest packet stored in any instance. Returns false if there
+	 * is no packet to remove.
+	 */
+	bool RtpRetransmissionCache::EvictOldestPacket()
+	{
+		MS_TRACE();
+
+		auto& heap = RtpRetransmissionCache::heap;
+
+		// Empty instances are at the bottom of the heap.
+		if (heap.empty() || heap.front()->buffer.empty())
+			return false;
+
+		heap.front()->RemoveFirst();
+
+		RtpRetransmissionCache::evictedPacketCount++;
+
+		return true;
+	}
+
+	void RtpRetransmissionCache::HeapSwap(size_t idx1, size_t idx2)
+	{
+		auto& heap = RtpRetransmissionCache::heap;
+
+		std::swap(heap[idx1], heap[idx2]);
+
+		heap[idx1]->heapIndex = idx1;
+		heap[idx2]->heapIndex = idx2;
+	}
+
+	/* Instance methods. */
+
+	RtpRetransmissionCache::RtpRetransmissionCache(uint32_t clockRate) : clockRate(clockRate)
+	{
+		MS_TRACE();
+
+		// Empty, so it belongs to the bottom of the heap.
+		this->heapIndex = RtpRetransmissionCache::heap.size();
+		RtpRetransmissionCache::heap.push_back(this);
+	}
+
+	RtpRetransmissionCache::~RtpRetransmissionCache()
+	{
+		MS_TRACE();
+
+		Clear();
+
+		auto& heap   = RtpRetransmissionCache::heap;
+		auto lastIdx = heap.size() - 1;
+		auto heapIdx = this->heapIndex;
+
+		// Replace it with the last instance in the heap.
+		if (heapIdx != lastIdx)
+		{
+			HeapSwap(heapIdx, lastIdx);
+			heap.pop_back();
+			heap[heapIdx]->UpdateHeapPosition();
+		}
+		else
+		{
+			heap.pop_back();
+		}
+	}
+
+	/**
+	 * Called once per RTP packet before it is provided to the Consumers. It
+	 * does not clone nor store anything.
+	 */
+	void RtpRetransmissionCache::SetCurrentPacket(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		// Keep the retransmission buffer size required for the previous packet
+		// until every RtpStreamSend has stored the current one.
+		if (this->currentRetransmissionBufferSize != 0u)
+		{
+			this->retransmissionBufferSize        = this->currentRetransmissionBufferSize;
+			this->currentRetransmissionBufferSize = 0u;
+		}
+
+		this->currentSeq          = packet->GetSequenceNumber();
+		this->currentTimestamp    = packet->GetTimestamp();
+		this->hasCurrentPacket    = true;
+		this->currentPacketStored = false;
+	}
+
+	/**
+	 * Called by each RtpStreamSend that needs to store the current packet. Given
+	 * packet may have been rewritten by the Consumer. The packet is cloned only
+	 * the first time. Given retransmission buffer size (ms) is the one of the
+	 * RtpStreamSend. Returns the sequence number of the packet in the cache.
+	 */
+	uint16_t RtpRetransmissionCache::StoreCurrentPacket(
+	  const RTC::RtpPacket* packet, uint32_t retransmissionBufferSize)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(this->hasCurrentPacket, "no current packet");
+
+		this->currentRetransmissionBufferSize =
+		  std::max(this->currentRetransmissionBufferSize, retransmissionBufferSize);
+
+		if (this->currentPacketStored)
+			return this->currentSeq;
+
+		this->currentPacketStored = true;
+
+		retransmissionBufferSize = std::max(this->retransmissionBufferSize, retransmissionBufferSize);
+
+		// Check if RTP packet is too old to be stored.
+		if (!this->buffer.empty())
+		{
+			const auto& firstItem = this->buffer.front();
+
+			if (RTC::SeqManager<uint32_t>::IsSeqLowerThan(this->currentTimestamp, firstItem.timestamp))
+			{
+				uint32_t diffTs{ firstItem.timestamp - this->currentTimestamp };
+
+				if (static_cast<uint32_t>(diffTs * 1000 / this->clockRate) >= retransmissionBufferSize)
+					return this->currentSeq;
+			}
+		}
+
+		ClearOldPackets(this->currentTimestamp, retransmissionBufferSize);
+
+		// Make room for the packet if the worker memory budget would be exceeded.
+		auto maxMemory = Settings::configuration.retransmissionBufferMaxMemory;
+
+		if (maxMemory != 0u)
+		{
+			while (RtpRetransmissionCache::totalMemory + StoredPacketMemory > maxMemory)
+			{
+				if (!RtpRetransmissionCache::EvictOldestPacket())
+					break;
+			}
+		}
+
+		std::shared_ptr<RTC::RtpPacket> clonedPacket(packet->Clone());
+
+		// Given packet may have been rewritten, so restore its original values.
+		clonedPacket->SetSequenceNumber(this->currentSeq);
+		clonedPacket->SetTimestamp(this->currentTimestamp);
+
+		Insert(this->currentSeq, this->currentTimestamp, DepLibUV::GetTimeMs(), clonedPacket);
+
+		return this->currentSeq;
+	}
+
+	RTC::RtpPacket* RtpRetransmissionCache::Get(uint16_t seq) const
+	{
+		MS_TRACE();
+
+		if (this->buffer.empty() || RTC::SeqManager<uint16_t>::IsSeqLowerThan(seq, this->startSeq))
+			return nullptr;
+
+		auto idx{ static_cast<uint16_t>(seq - this->startSeq) };
+
+		if (idx > static_cast<uint16_t>(this->buffer.size() - 1))
+			return nullptr;
+
+		return this->buffer[idx].packet.get();
+	}
+
+	void RtpRetransmissionCache::Clear()
+	{
+		MS_TRACE();
+
+		RtpRetransmissionCache::totalMemory -= this->memory;
+
+		this->buffer.clear();
+		this->startSeq    = 0u;
+		this->packetCount = 0u;
+		this->memory      = 0u;
+
+		UpdateHeapPosition();
+	}
+
+	void RtpRetransmissionCache::Insert(
+	  uint16_t seq, uint32_t timestamp, uint64_t nowMs, std::shared_ptr<RTC::RtpPacket>& packet)
+	{
+		MS_TRACE();
+
+		if (this->buffer.empty())
+		{
+			this->startSeq = seq;
+			this->buffer.emplace_back();
+		}
+		// Packet sequence number is higher than startSeq.
+		else if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(seq, this->startSeq))
+		{
+			auto idx{ static_cast<uint16_t>(seq - this->startSeq) };
+
+			// Packets can arrive out of order, add blank slots.
+			if (idx > static_cast<uint16_t>(this->buffer.size() - 1))
+				this->buffer.resize(static_cast<size_t>(idx) + 1);
+		}
+		// Packet sequence number is the same or lower than startSeq.
+		else
+		{
+			auto addToFront = static_cast<uint16_t>(this->startSeq - seq);
+
+			// Packets can arrive out of order, add blank slots.
+			for (uint16_t i{ 0 }; i < addToFront; ++i)
+			{
+				this->buffer.emplace_front();
+			}
+
+			this->startSeq = seq;
+		}
+
+		MS_ASSERT(
+		  this->buffer.size() <= MaxSeq,
+		  "RtpRetransmissionCache contains more than %" PRIu16 " entries",
+		  MaxSeq);
+
+		auto& item = this->buffer[static_cast<uint16_t>(seq - this->startSeq)];
+
+		// The slot may already be used by a different packet with same sequence
+		// number, in which case it is replaced.
+		if (!item.packet)
+		{
+			++this->packetCount;
+			this->memory += StoredPacketMemory;
+			RtpRetransmissionCache::totalMemory += StoredPacketMemory;
+		}
+
+		item.packet     = packet;
+		item.timestamp  = timestamp;
+		item.storedAtMs = nowMs;
+
+		UpdateHeapPosition();
+	}
+
+	void RtpRetransmissionCache::ClearOldPackets(
+	  uint32_t timestamp, uint32_t retransmissionBufferSize)
+	{
+		MS_TRACE();
+
+		// Go through all buffer items starting with the first and free all items
+		// that contain packets older than `retransmissionBufferSize`.
+		while (!this->buffer.empty())
+		{
+			const auto& firstItem = this->buffer.front();
+
+			// Processing RTP packet is older than first one.
+			if (RTC::SeqManager<uint32_t>::IsSeqLowerThan(timestamp, firstItem.timestamp))
+				break;
+
+			uint32_t diffTs{ timestamp - firstItem.timestamp };
+
+			// First RTP packet is recent enough.
+			if (static_cast<uint32_t>(diffTs * 1000 / this->clockRate) < retransmissionBufferSize)
+				break;
+
+			RemoveFirst();
+		}
+	}
+
+	void RtpRetransmissionCache::RemoveFirst()
+	{
+		MS_TRACE();
+
+		MS_ASSERT(!this->buffer.empty(), "buffer is empty");
+
+		this->buffer.pop_front();
+		this->startSeq++;
+		this->packetCount--;
+		this->memory -= StoredPacketMemory;
+		RtpRetransmissionCache::totalMemory -= StoredPacketMemory;
+
+		// Remove all empty slots from the beginning of the buffer.
+		while (!this->buffer.empty() && !this->buffer.front().packet)
+		{
+			this->buffer.pop_front();
+			this->startSeq++;
+		}
+
+		UpdateHeapPosition();
+	}
+
+	/**
+	 * Moves the instance up or down the heap after its first packet changed.
+	 */
+	void RtpRetransmissionCache::UpdateHeapPosition()
+	{
+		MS_TRACE();
+
+		auto& heap = RtpRetransmissionCache::heap;
+		auto idx   = this->heapIndex;
+		auto key   = GetFirstStoredAtMs();
+
+		while (idx > 0u)
+		{
+			auto parentIdx = (idx - 1u) / 2u;
+
+			if (heap[parentIdx]->GetFirstStoredAtMs() <= key)
+				break;
+
+			HeapSwap(idx, parentIdx);
+			idx = parentIdx;
+		}
+
+		while (true)
+		{
+			auto childIdx = 2u * idx + 1u;
+
+			if (childIdx >= heap.size())
+				break;
+
+			if (
+			  childIdx + 1u < heap.size() &&
+			  heap[childIdx + 1u]->GetFirstStoredAtMs() < heap[childIdx]->GetFirstStoredAtMs())
+			{
+				++childIdx;
+			}
+
+			if (key <= heap[childIdx]->GetFirstStoredAtMs())
+				break;
+
+			HeapSwap(idx, childIdx);
+			idx = childIdx;
+		}
+	}
+} // namespace RTC
@@ -3,6 +3,8 @@
 
 #include "RTC/RtpStream.hpp"
 #include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
 #include "RTC/SeqManager.hpp"
 
 namespace RTC
@@ -148,6 +150,36 @@ namespace RTC
 		return true;
 	}
 
+	RtpStream::SeqState RtpStream::GetSeqState() const
+	{
+		MS_TRACE();
+
+		SeqState seqState;
+
+		seqState.maxSeq      = this->maxSeq;
+		seqState.cycles      = this->cycles;
+		seqState.maxPacketTs = this->maxPacketTs;
+
+		return seqState;
+	}
+
+	/**
+	 * The stream continues as if it had received the packets of the given state,
+	 * but packets expected and lost are counted from now on.
+	 */
+	void RtpStream::SetSeqState(const SeqState& seqState)
+	{
+		MS_TRACE();
+
+		InitSeq(seqState.maxSeq);
+
+		this->started     = true;
+		this->cycles      = seqState.cycles;
+		this->baseSeq     = seqState.cycles + seqState.maxSeq + 1;
+		this->maxPacketTs = seqState.maxPacketTs;
+		this->maxPacketMs = DepLibUV::GetTimeMs();
+	}
+
 	void RtpStream::ResetScore(uint8_t score, bool notify)
 	{
 		MS_TRACE();
@@ -363,4 +395,40 @@ namespace RTC
 		jsonObject["spatialLayers"]  = this->spatialLayers;
 		jsonObject["temporalLayers"] = this->temporalLayers;
 	}
+
+	RtpStream::SeqState::SeqState(json& data)
+	{
+		MS_TRACE();
+
+		auto jsonMaxSeqIt      = data.find("maxSeq");
+		auto jsonCyclesIt      = data.find("cycles");
+		auto jsonMaxPacketTsIt = data.find("maxPacketTs");
+
+		// clang-format off
+		if (
+			jsonMaxSeqIt == data.end() ||
+			!Utils::Json::IsPositiveInteger(*jsonMaxSeqIt) ||
+			jsonCyclesIt == data.end() ||
+			!Utils::Json::IsPositiveInteger(*jsonCyclesIt) ||
+			jsonMaxPacketTsIt == data.end() ||
+			!Utils::Json::IsPositiveInteger(*jsonMaxPacketTsIt)
+		)
+		// clang-format on
+		{
+			MS_THROW_TYPE_ERROR("wrong RTP stream sequence state");
+		}
+
+		this->maxSeq      = jsonMaxSeqIt->get<uint16_t>();
+		this->cycles      = jsonCyclesIt->get<uint32_t>();
+		this->maxPacketTs = jsonMaxPacketTsIt->get<uint32_t>();
+	}
+
+	void RtpStream::SeqState::FillJson(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		jsonObject["maxSeq"]      = this->maxSeq;
+		jsonObject["cycles"]      = this->cycles;
+		jsonObject["maxPacketTs"] = this->maxPacketTs;
+	}
 } // namespace RTC
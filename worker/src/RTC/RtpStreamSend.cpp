@@ -3,6 +3,7 @@
 
 #include "RTC/RtpStreamSend.hpp"
 #include "Logger.hpp"
+#include "OverloadController.hpp"
 #include "Utils.hpp"
 #include "RTC/SeqManager.hpp"
 
@@ -16,6 +17,12 @@ namespace RTC
 	  MaxRequestedPackets + 1);
 	static constexpr uint32_t DefaultRtt{ 100u };
 	static constexpr uint16_t MaxSeq = std::numeric_limits<uint16_t>::max();
+	// Number of latest packets considered when looking for a padding packet.
+	static constexpr uint16_t MaxPaddingCandidates{ 50u };
+	// Padding packets are copies of stored packets, since those are shared with
+	// other streams.
+	thread_local static uint8_t PaddingPacketBuffer[RTC::MtuSize + 100];
+	thread_local static std::unique_ptr<RTC::RtpPacket> PaddingPacket;
 
 	/* Class Static. */
 
@@ -28,25 +35,24 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->packet.reset();
-		this->ssrc           = 0;
-		this->sequenceNumber = 0;
-		this->timestamp      = 0;
-		this->resentAtMs     = 0;
-		this->sentTimes      = 0;
+		this->retransmissionCache = nullptr;
+		this->resentAtMs          = 0;
+		this->timestamp           = 0;
+		this->cacheSequenceNumber = 0;
+		this->sentTimes           = 0;
+		this->paddedTimes         = 0;
 	}
 
-	RtpStreamSend::StorageItem* RtpStreamSend::StorageItemBuffer::GetFirst() const
+	RtpStreamSend::StorageItem* RtpStreamSend::StorageItemBuffer::GetFirst()
 	{
 		auto* storageItem = this->Get(this->startSeq);
 
 		MS_ASSERT(storageItem, "first storage item is missing");
-		MS_ASSERT(storageItem->packet, "storage item does not contain original packet");
 
 		return storageItem;
 	}
 
-	RtpStreamSend::StorageItem* RtpStreamSend::StorageItemBuffer::Get(uint16_t seq) const
+	RtpStreamSend::StorageItem* RtpStreamSend::StorageItemBuffer::Get(uint16_t seq)
 	{
 		if (RTC::SeqManager<uint16_t>::IsSeqLowerThan(seq, this->startSeq))
 			return nullptr;
@@ -56,7 +62,13 @@ namespace RTC
 		if (this->buffer.empty() || idx > static_cast<uint16_t>(this->buffer.size() - 1))
 			return nullptr;
 
-		return this->buffer.at(idx);
+		auto& storageItem = this->buffer[idx];
+
+		// Empty slot.
+		if (!storageItem.retransmissionCache)
+			return nullptr;
+
+		return std::addressof(storageItem);
 	}
 
 	size_t RtpStreamSend::StorageItemBuffer::GetBufferSize() const
@@ -64,12 +76,12 @@ namespace RTC
 		return this->buffer.size();
 	}
 
-	void RtpStreamSend::StorageItemBuffer::Insert(uint16_t seq, StorageItem* storageItem)
+	RtpStreamSend::StorageItem* RtpStreamSend::StorageItemBuffer::Insert(uint16_t seq)
 	{
 		if (this->buffer.empty())
 		{
 			this->startSeq = seq;
-			this->buffer.push_back(storageItem);
+			this->buffer.emplace_back();
 		}
 		// Packet sequence number is higher than startSeq.
 		else if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(seq, this->startSeq))
@@ -79,21 +91,12 @@ namespace RTC
 			// Packet arrived out of order, so we already have a slot allocated for it.
 			if (idx <= static_cast<uint16_t>(this->buffer.size() - 1))
 			{
-				MS_ASSERT(this->buffer[idx] == nullptr, "Must insert into empty slot");
-
-				this->buffer[idx] = storageItem;
+				MS_ASSERT(!this->buffer[idx].retransmissionCache, "Must insert into empty slot");
 			}
+			// Packets can arrive out of order, add blank slots.
 			else
 			{
-				// Calculate how many elements would it be necessary to add when pushing new item
-				// to the back of the deque.
-				auto addToBack = static_cast<uint16_t>(seq - (this->startSeq + this->buffer.size() - 1));
-
-				// Packets can arrive out of order, add blank slots.
-				for (uint16_t i{ 1 }; i < addToBack; ++i)
-					this->buffer.push_back(nullptr);
-
-				this->buffer.push_back(storageItem);
+				this->buffer.resize(static_cast<size_t>(idx) + 1);
 			}
 		}
 		// Packet sequence number is the same or lower than startSeq.
@@ -104,10 +107,11 @@ namespace RTC
 			auto addToFront = static_cast<uint16_t>(this->startSeq - seq);
 
 			// Packets can arrive out of order, add blank slots.
-			for (uint16_t i{ 1 }; i < addToFront; ++i)
-				this->buffer.push_front(nullptr);
+			for (uint16_t i{ 0 }; i < addToFront; ++i)
+			{
+				this->buffer.emplace_front();
+			}
 
-			this->buffer.push_front(storageItem);
 			this->startSeq = seq;
 		}
 
@@ -115,21 +119,20 @@ namespace RTC
 		  this->buffer.size() <= MaxSeq,
 		  "StorageItemBuffer contains more than %" PRIu16 " entries",
 		  MaxSeq);
+
+		return std::addressof(this->buffer[static_cast<uint16_t>(seq - this->startSeq)]);
 	}
 
 	void RtpStreamSend::StorageItemBuffer::RemoveFirst()
 	{
 		MS_ASSERT(!this->buffer.empty(), "buffer is empty");
 
-		auto* storageItem = this->buffer[0];
+		this->buffer.pop_front();
+		this->startSeq++;
 
-		delete storageItem;
-
-		this->buffer[0] = nullptr;
-
-		// Remove all `nullptr` elements from the beginning of the buffer.
+		// Remove all empty slots from the beginning of the buffer.
 		// NOTE: Calling front on an empty container is undefined.
-		while (!this->buffer.empty() && this->buffer.front() == nullptr)
+		while (!this->buffer.empty() && !this->buffer.front().retransmissionCache)
 		{
 			this->buffer.pop_front();
 			this->startSeq++;
@@ -138,26 +141,12 @@ namespace RTC
 
 	void RtpStreamSend::StorageItemBuffer::Clear()
 	{
-		for (auto* storageItem : this->buffer)
-		{
-			if (!storageItem)
-				continue;
-
-			// Reset the storage item (decrease RTP packet shared pointer counter).
-			storageItem->Reset();
-
-			delete storageItem;
-		}
-
+		// NOTE: Items just reference packets in the shared cache, which may not
+		// exist at this point, so they must not be dereferenced here.
 		this->buffer.clear();
 		this->startSeq = 0;
 	}
 
-	RtpStreamSend::StorageItemBuffer::~StorageItemBuffer()
-	{
-		Clear();
-	}
-
 	/* Instance methods. */
 
 	RtpStreamSend::RtpStreamSend(
@@ -199,7 +188,8 @@ namespace RTC
 		this->rtxSeq = Utils::Crypto::GetRandomUInt(0u, 0xFFFF);
 	}
 
-	bool RtpStreamSend::ReceivePacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	bool RtpStreamSend::ReceivePacket(
+	  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache)
 	{
 		MS_TRACE();
 
@@ -208,8 +198,8 @@ namespace RTC
 			return false;
 
 		// If NACK is enabled, store the packet into the buffer.
-		if (this->params.useNack)
-			StorePacket(packet, sharedPacket);
+		if (this->params.useNack && retransmissionCache)
+			StorePacket(packet, retransmissionCache);
 
 		// Increase transmission counter.
 		this->transmissionCounter.Update(packet);
@@ -223,12 +213,19 @@ namespace RTC
 
 		this->nackCount++;
 
+		// NACKs are still counted but ignored while the worker is overloaded.
+		bool dropRetransmissions =
+		  OverloadController::IsStepApplied(OverloadController::Step::RETRANSMISSIONS);
+
 		for (auto it = nackPacket->Begin(); it != nackPacket->End(); ++it)
 		{
 			RTC::RTCP::FeedbackRtpNackItem* item = *it;
 
 			this->nackPacketCount += item->CountRequestedPackets();
 
+			if (dropRetransmissions)
+				continue;
+
 			FillRetransmissionContainer(item->GetPacketId(), item->GetLostPacketBitmask());
 
 			for (auto* storageItem : RetransmissionContainer)
@@ -238,23 +235,23 @@ namespace RTC
 
 				// Note that this is an already RTX encoded packet if RTX is used
 				// (FillRetransmissionContainer() did it).
-				auto packet = storageItem->packet;
+				auto* packet = storageItem->GetPacket();
 
 				// Retransmit the packet.
 				static_cast<RTC::RtpStreamSend::Listener*>(this->listener)
-				  ->OnRtpStreamRetransmitRtpPacket(this, packet.get());
+				  ->OnRtpStreamRetransmitRtpPacket(this, packet);
 
 				// Mark the packet as retransmitted.
-				RTC::RtpStream::PacketRetransmitted(packet.get());
+				RTC::RtpStream::PacketRetransmitted(packet);
 
 				// Mark the packet as repaired (only if this is the first retransmission).
 				if (storageItem->sentTimes == 1)
-					RTC::RtpStream::PacketRepaired(packet.get());
+					RTC::RtpStream::PacketRepaired(packet);
 
 				if (HasRtx())
 				{
 					// Restore the packet.
-					packet->RtxDecode(RtpStream::GetPayloadType(), storageItem->ssrc);
+					packet->RtxDecode(RtpStream::GetPayloadType(), this->params.ssrc);
 				}
 			}
 		}
@@ -403,6 +400,90 @@ namespace RTC
 		return sdesChunk;
 	}
 
+	/**
+	 * Returns a RTX copy of a recently sent packet to be sent as padding (so it
+	 * also helps the remote recovering losses), or nullptr if there is none. It
+	 * takes the least padded packet, and among them the one whose size is
+	 * closest to the given one. The returned packet is valid until the next call.
+	 */
+	RTC::RtpPacket* RtpStreamSend::GetRtxPaddingPacket(size_t size)
+	{
+		MS_TRACE();
+
+		if (!HasRtx() || this->storageItemBuffer.GetBufferSize() == 0u)
+			return nullptr;
+
+		auto sizeDistance = [size](const RTC::RtpPacket* packet) -> size_t
+		{
+			return packet->GetSize() > size ? packet->GetSize() - size : size - packet->GetSize();
+		};
+
+		StorageItem* bestStorageItem{ nullptr };
+		RTC::RtpPacket* bestPacket{ nullptr };
+		uint16_t bestSeq{ 0u };
+
+		for (uint16_t i{ 0u }; i < MaxPaddingCandidates; ++i)
+		{
+			uint16_t seq      = this->maxSeq - i;
+			auto* storageItem = this->storageItemBuffer.Get(seq);
+
+			if (!storageItem)
+				continue;
+
+			auto* packet = storageItem->GetPacket();
+
+			// The packet may have already been removed from the shared cache.
+			if (!packet)
+				continue;
+
+			if (bestStorageItem)
+			{
+				if (storageItem->paddedTimes > bestStorageItem->paddedTimes)
+					continue;
+
+				// clang-format off
+				if (
+					storageItem->paddedTimes == bestStorageItem->paddedTimes &&
+					sizeDistance(packet) >= sizeDistance(bestPacket)
+				)
+				// clang-format on
+				{
+					continue;
+				}
+			}
+
+			bestStorageItem = storageItem;
+			bestPacket      = packet;
+			bestSeq         = seq;
+		}
+
+		if (!bestStorageItem)
+			return nullptr;
+
+		PaddingPacket.reset(bestPacket->Clone(PaddingPacketBuffer));
+
+		auto* packet = PaddingPacket.get();
+
+		// Put correct info into the packet.
+		packet->SetSsrc(this->params.ssrc);
+		packet->SetSequenceNumber(bestSeq);
+		packet->SetTimestamp(bestStorageItem->timestamp);
+
+		// Update MID RTP extension value.
+		if (!this->mid.empty())
+			packet->UpdateMid(mid);
+
+		// Increment RTX seq.
+		++this->rtxSeq;
+
+		packet->RtxEncode(this->params.rtxPayloadType, this->params.rtxSsrc, this->rtxSeq);
+
+		if (bestStorageItem->paddedTimes < std::numeric_limits<uint8_t>::max())
+			bestStorageItem->paddedTimes++;
+
+		return packet;
+	}
+
 	void RtpStreamSend::Pause()
 	{
 		MS_TRACE();
@@ -438,7 +519,8 @@ namespace RTC
 		MS_ABORT("invalid method call");
 	}
 
-	void RtpStreamSend::StorePacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void RtpStreamSend::StorePacket(
+	  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache)
 	{
 		MS_TRACE();
 
@@ -491,23 +573,15 @@ namespace RTC
 		// Allocate new buffer item.
 		else
 		{
-			// Allocate a new storage item.
-			storageItem = new StorageItem();
-
-			this->storageItemBuffer.Insert(seq, storageItem);
+			storageItem = this->storageItemBuffer.Insert(seq);
 		}
 
-		// Only clone once and only if necessary.
-		if (!sharedPacket.get())
-		{
-			sharedPacket.reset(packet->Clone());
-		}
-
-		// Store original packet and some extra info into the storage item.
-		storageItem->packet         = sharedPacket;
-		storageItem->ssrc           = packet->GetSsrc();
-		storageItem->sequenceNumber = packet->GetSequenceNumber();
-		storageItem->timestamp      = packet->GetTimestamp();
+		// Store the packet into the shared cache (it will only be cloned once for
+		// all the RtpStreamSend instances) and keep a reference to it.
+		storageItem->cacheSequenceNumber =
+		  retransmissionCache->StoreCurrentPacket(packet, this->retransmissionBufferSize);
+		storageItem->retransmissionCache = retransmissionCache;
+		storageItem->timestamp           = packet->GetTimestamp();
 	}
 
 	void RtpStreamSend::ClearOldPackets(const RtpPacket* packet)
@@ -588,17 +662,25 @@ namespace RTC
 			if (requested)
 			{
 				auto* storageItem = this->storageItemBuffer.Get(currentSeq);
-				std::shared_ptr<RTC::RtpPacket> packet{ nullptr };
+				RTC::RtpPacket* packet{ nullptr };
 				uint32_t diffMs;
 
+				// The packet may have already been removed from the shared cache.
+				if (storageItem)
+				{
+					packet = storageItem->GetPacket();
+
+					if (!packet)
+						storageItem = nullptr;
+				}
+
 				// Calculate the elapsed time between the max timestamp seen and the
 				// requested packet's timestamp (in ms).
 				if (storageItem)
 				{
-					packet = storageItem->packet;
 					// Put correct info into the packet.
-					packet->SetSsrc(storageItem->ssrc);
-					packet->SetSequenceNumber(storageItem->sequenceNumber);
+					packet->SetSsrc(this->params.ssrc);
+					packet->SetSequenceNumber(currentSeq);
 					packet->SetTimestamp(storageItem->timestamp);
 
 					// Update MID RTP extension value.
@@ -66,6 +66,10 @@ namespace RTC
 	void SeqManager<T>::Offset(T offset)
 	{
 		this->base += offset;
+
+		// Skipped outputs are taken by someone else (i.e. FEC packets), so a later
+		// Sync() must not reuse them.
+		this->maxOutput += offset;
 	}
 
 	template<typename T>
@@ -121,6 +125,24 @@ namespace RTC
 		return true;
 	}
 
+	// Used to continue the outputs of a SeqManager in another worker.
+	template<typename T>
+	void SeqManager<T>::Restore(T base, T maxOutput)
+	{
+		this->base      = base;
+		this->maxOutput = maxOutput;
+		this->maxInput  = maxOutput - base;
+
+		// Clear dropped set.
+		this->dropped.clear();
+	}
+
+	template<typename T>
+	T SeqManager<T>::GetBase() const
+	{
+		return this->base;
+	}
+
 	template<typename T>
 	T SeqManager<T>::GetMaxInput() const
 	{
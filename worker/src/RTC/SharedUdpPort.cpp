@@ -0,0 +1,440 @@
+#define MS_CLASS "RTC::SharedUdpPort"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/SharedUdpPort.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include <algorithm> // std::remove(), std::min()
+#include <cstring>   // std::memcpy()
+#include <utility>   // std::move()
+
+/* Static methods for UV callbacks. */
+
+inline static void onAsync(uv_async_t* handle)
+{
+	static_cast<RTC::SharedUdpPort*>(handle->data)->OnUvAsync();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_async_t*>(handle);
+}
+
+namespace RTC
+{
+	/* Static. */
+
+	// Max number of packets waiting to be read by the owning worker. Each slot
+	// takes a full size packet.
+	static constexpr size_t QueueCapacity{ 512u };
+	// Max number of changes of the owners maps kept for members to catch up.
+	static constexpr size_t MaxChanges{ 1024u };
+
+	/* Class variables. */
+
+	std::mutex SharedUdpPort::globalMutex;
+	absl::flat_hash_map<std::string, std::shared_ptr<SharedUdpPort::Group>>
+	  SharedUdpPort::mapKeyGroup;
+
+	/* Instance methods. */
+
+	SharedUdpPort::SharedUdpPort(Listener* listener, RTC::UdpSocket* udpSocket)
+	  : listener(listener), udpSocket(udpSocket), mailbox(std::make_shared<Mailbox>(QueueCapacity))
+	{
+		MS_TRACE();
+
+		int err;
+
+		this->mailbox->uvHandle       = new uv_async_t;
+		this->mailbox->uvHandle->data = static_cast<void*>(this);
+
+		err = uv_async_init(
+		  DepLibUV::GetLoop(), this->mailbox->uvHandle, static_cast<uv_async_cb>(onAsync));
+
+		if (err != 0)
+		{
+			delete this->mailbox->uvHandle;
+			this->mailbox->uvHandle = nullptr;
+
+			MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+		}
+
+		std::string key =
+		  udpSocket->GetLocalIp() + ":" + std::to_string(udpSocket->GetLocalPort());
+
+		std::lock_guard<std::mutex> lock(SharedUdpPort::globalMutex);
+
+		auto& group = SharedUdpPort::mapKeyGroup[key];
+
+		if (!group)
+			group = std::make_shared<Group>();
+
+		this->group = group;
+
+		std::lock_guard<std::mutex> groupLock(this->group->mutex);
+
+		this->group->members.push_back(this);
+		this->maps        = this->group->maps;
+		this->mapsVersion = this->group->version.load(std::memory_order_relaxed);
+
+		MS_DEBUG_TAG(
+		  ice,
+		  "joined shared UDP port [key:%s, members:%zu]",
+		  key.c_str(),
+		  this->group->members.size());
+	}
+
+	SharedUdpPort::~SharedUdpPort()
+	{
+		MS_TRACE();
+
+		std::string key =
+		  this->udpSocket->GetLocalIp() + ":" + std::to_string(this->udpSocket->GetLocalPort());
+
+		{
+			std::lock_guard<std::mutex> lock(SharedUdpPort::globalMutex);
+			std::lock_guard<std::mutex> groupLock(this->group->mutex);
+
+			auto& members = this->group->members;
+
+			members.erase(std::remove(members.begin(), members.end(), this), members.end());
+
+			Change change;
+
+			change.type    = Change::Type::REMOVE_MAILBOX;
+			change.mailbox = this->mailbox;
+
+			PublishChange(std::move(change));
+
+			if (members.empty())
+				SharedUdpPort::mapKeyGroup.erase(key);
+		}
+
+		uv_async_t* uvHandle;
+
+		// Other members may still forward packets to the mailbox until they apply
+		// the change above. Detach the handle so they do not signal it once
+		// closed. The mailbox itself is freed by the last of them.
+		{
+			std::lock_guard<std::mutex> lock(this->mailbox->mutex);
+
+			uvHandle                = this->mailbox->uvHandle;
+			this->mailbox->uvHandle = nullptr;
+		}
+
+		uv_close(reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onClose));
+	}
+
+	void SharedUdpPort::AddLocalIceUsernameFragment(const std::string& usernameFragment)
+	{
+		MS_TRACE();
+
+		std::lock_guard<std::mutex> lock(this->group->mutex);
+
+		auto& maps = this->group->maps;
+
+		if (
+		  maps.mapLocalIceUsernameFragmentMailbox.find(usernameFragment) !=
+		  maps.mapLocalIceUsernameFragmentMailbox.end())
+		{
+			MS_WARN_TAG(ice, "local ICE username fragment already exists in another worker");
+
+			return;
+		}
+
+		Change change;
+
+		change.type             = Change::Type::ADD_USERNAME_FRAGMENT;
+		change.usernameFragment = usernameFragment;
+		change.mailbox          = this->mailbox;
+
+		PublishChange(std::move(change));
+	}
+
+	void SharedUdpPort::RemoveLocalIceUsernameFragment(const std::string& usernameFragment)
+	{
+		MS_TRACE();
+
+		std::lock_guard<std::mutex> lock(this->group->mutex);
+
+		auto& maps = this->group->maps;
+		auto it    = maps.mapLocalIceUsernameFragmentMailbox.find(usernameFragment);
+
+		if (it == maps.mapLocalIceUsernameFragmentMailbox.end() || it->second != this->mailbox)
+			return;
+
+		Change change;
+
+		change.type             = Change::Type::REMOVE_USERNAME_FRAGMENT;
+		change.usernameFragment = usernameFragment;
+
+		PublishChange(std::move(change));
+	}
+
+	void SharedUdpPort::AddTuple(uint64_t tupleHash)
+	{
+		MS_TRACE();
+
+		std::lock_guard<std::mutex> lock(this->group->mutex);
+
+		Change change;
+
+		change.type      = Change::Type::ADD_TUPLE;
+		change.tupleHash = tupleHash;
+		change.mailbox   = this->mailbox;
+
+		PublishChange(std::move(change));
+	}
+
+	void SharedUdpPort::RemoveTuple(uint64_t tupleHash)
+	{
+		MS_TRACE();
+
+		std::lock_guard<std::mutex> lock(this->group->mutex);
+
+		auto& maps = this->group->maps;
+		auto it    = maps.mapTupleMailbox.find(tupleHash);
+
+		if (it == maps.mapTupleMailbox.end() || it->second != this->mailbox)
+			return;
+
+		Change change;
+
+		change.type      = Change::Type::REMOVE_TUPLE;
+		change.tupleHash = tupleHash;
+
+		PublishChange(std::move(change));
+	}
+
+	bool SharedUdpPort::ForwardStunPacket(
+	  absl::string_view usernameFragment,
+	  uint64_t tupleHash,
+	  const uint8_t* data,
+	  size_t len,
+	  const struct sockaddr* remoteAddr)
+	{
+		MS_TRACE();
+
+		SyncMaps();
+
+		Mailbox* owner{ nullptr };
+		auto it1 = this->maps.mapTupleMailbox.find(tupleHash);
+
+		if (it1 != this->maps.mapTupleMailbox.end())
+		{
+			owner = it1->second.get();
+		}
+		else
+		{
+			auto it2 = this->maps.mapLocalIceUsernameFragmentMailbox.find(usernameFragment);
+
+			if (it2 != this->maps.mapLocalIceUsernameFragmentMailbox.end())
+				owner = it2->second.get();
+		}
+
+		if (!owner || owner == this->mailbox.get())
+			return false;
+
+		Enqueue(owner, data, len, remoteAddr);
+
+		return true;
+	}
+
+	bool SharedUdpPort::ForwardNonStunPacket(
+	  uint64_t tupleHash, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr)
+	{
+		MS_TRACE();
+
+		SyncMaps();
+
+		auto it = this->maps.mapTupleMailbox.find(tupleHash);
+
+		if (it == this->maps.mapTupleMailbox.end() || it->second == this->mailbox)
+			return false;
+
+		Enqueue(it->second.get(), data, len, remoteAddr);
+
+		return true;
+	}
+
+	// NOTE: Called within the loop thread of the forwarding worker.
+	inline void SharedUdpPort::Enqueue(
+	  Mailbox* mailbox, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr)
+	{
+		MS_TRACE();
+
+		if (len > sizeof(Packet::data))
+		{
+			MS_WARN_DEV("packet too big, packet dropped [len:%zu]", len);
+
+			return;
+		}
+
+		auto pushed = mailbox->queue.PushInPlace(
+		  [data, len, remoteAddr](Packet& packet)
+		  {
+			  std::memcpy(packet.data, data, len);
+			  packet.len        = len;
+			  packet.remoteAddr = Utils::IP::CopyAddress(remoteAddr);
+		  });
+
+		if (!pushed)
+		{
+			MS_WARN_DEV("queue full, packet dropped");
+
+			return;
+		}
+
+		// NOTE: Just contended if the owner is leaving or other members forward
+		// to it at the same time.
+		std::lock_guard<std::mutex> lock(mailbox->mutex);
+
+		// The owner has left, the packet is dropped along with the mailbox.
+		if (!mailbox->uvHandle)
+			return;
+
+		uv_async_send(mailbox->uvHandle);
+	}
+
+	inline void SharedUdpPort::ApplyChange(Maps& maps, const Change& change)
+	{
+		MS_TRACE();
+
+		switch (change.type)
+		{
+			case Change::Type::ADD_USERNAME_FRAGMENT:
+			{
+				maps.mapLocalIceUsernameFragmentMailbox[change.usernameFragment] = change.mailbox;
+
+				break;
+			}
+
+			case Change::Type::REMOVE_USERNAME_FRAGMENT:
+			{
+				maps.mapLocalIceUsernameFragmentMailbox.erase(change.usernameFragment);
+
+				break;
+			}
+
+			case Change::Type::ADD_TUPLE:
+			{
+				maps.mapTupleMailbox[change.tupleHash] = change.mailbox;
+
+				break;
+			}
+
+			case Change::Type::REMOVE_TUPLE:
+			{
+				maps.mapTupleMailbox.erase(change.tupleHash);
+
+				break;
+			}
+
+			// Just once per member, when it leaves.
+			case Change::Type::REMOVE_MAILBOX:
+			{
+				for (auto it = maps.mapLocalIceUsernameFragmentMailbox.begin();
+				     it != maps.mapLocalIceUsernameFragmentMailbox.end();)
+				{
+					if (it->second == change.mailbox)
+						maps.mapLocalIceUsernameFragmentMailbox.erase(it++);
+					else
+						++it;
+				}
+
+				for (auto it = maps.mapTupleMailbox.begin(); it != maps.mapTupleMailbox.end();)
+				{
+					if (it->second == change.mailbox)
+						maps.mapTupleMailbox.erase(it++);
+					else
+						++it;
+				}
+
+				break;
+			}
+		}
+	}
+
+	void SharedUdpPort::PublishChange(Change change)
+	{
+		MS_TRACE();
+
+		ApplyChange(this->group->maps, change);
+
+		this->group->changes.push_back(std::move(change));
+
+		// Forget the changes already applied by every member.
+		uint64_t minVersion = this->group->version.load(std::memory_order_relaxed) + 1;
+
+		for (auto* member : this->group->members)
+		{
+			minVersion = std::min(minVersion, member->mapsVersion);
+		}
+
+		while (!this->group->changes.empty() && this->group->firstChangeVersion < minVersion)
+		{
+			this->group->changes.pop_front();
+			++this->group->firstChangeVersion;
+		}
+
+		// Do not keep changes without limit for members not forwarding packets.
+		// They copy the whole maps instead once they do.
+		while (this->group->changes.size() > MaxChanges)
+		{
+			this->group->changes.pop_front();
+			++this->group->firstChangeVersion;
+		}
+
+		this->group->version.fetch_add(1, std::memory_order_release);
+	}
+
+	inline void SharedUdpPort::SyncMaps()
+	{
+		MS_TRACE();
+
+		if (this->group->version.load(std::memory_order_acquire) == this->mapsVersion)
+			return;
+
+		std::lock_guard<std::mutex> lock(this->group->mutex);
+
+		auto& changes = this->group->changes;
+
+		if (this->mapsVersion < this->group->firstChangeVersion)
+		{
+			this->maps = this->group->maps;
+		}
+		else
+		{
+			for (auto idx = static_cast<size_t>(this->mapsVersion - this->group->firstChangeVersion);
+			     idx < changes.size();
+			     ++idx)
+			{
+				ApplyChange(this->maps, changes[idx]);
+			}
+		}
+
+		this->mapsVersion = this->group->version.load(std::memory_order_relaxed);
+	}
+
+	inline void SharedUdpPort::OnUvAsync()
+	{
+		MS_TRACE();
+
+		auto read = [this](Packet& packet)
+		{
+			this->listener->OnSharedUdpPortPacketReceived(
+			  this,
+			  packet.data,
+			  packet.len,
+			  reinterpret_cast<const struct sockaddr*>(std::addressof(packet.remoteAddr)));
+		};
+
+		// Packets are read in their queue slots.
+		while (this->mailbox->queue.PopInPlace(read))
+		{
+			continue;
+		}
+	}
+} // namespace RTC
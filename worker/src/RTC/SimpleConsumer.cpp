@@ -7,9 +7,19 @@
 #include "MediaSoupErrors.hpp"
 #include "Channel/ChannelNotifier.hpp"
 #include "RTC/Codecs/Tools.hpp"
+#include <cmath> // std::lround()
 
 namespace RTC
 {
+	/* Static. */
+
+	// Number of previous Opus frames carried by each RED packet.
+	static constexpr size_t RedDistance{ 2u };
+	// Max ratio of FEC packets to media packets.
+	static constexpr float MaxFecProtectionFactor{ 0.5f };
+	// Max number of FEC insertions tracked to map late packets.
+	static constexpr size_t MaxFecInsertions{ 32u };
+
 	/* Instance methods. */
 
 	SimpleConsumer::SimpleConsumer(
@@ -49,7 +59,72 @@ namespace RTC
 
 				this->encodingContext->SetIgnoreDtx(ignoreDtx);
 			}
+
+			auto jsonRedThresholdIt = data.find("redThreshold");
+
+			if (jsonRedThresholdIt != data.end() && jsonRedThresholdIt->is_number())
+			{
+				auto redThreshold = jsonRedThresholdIt->get<double>();
+
+				if (redThreshold < 0 || redThreshold > 1)
+					MS_THROW_TYPE_ERROR("invalid redThreshold");
+
+				for (const auto& codec : this->rtpParameters.codecs)
+				{
+					if (codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::RED)
+					{
+						this->redSupported   = true;
+						this->redPayloadType = codec.payloadType;
+
+						break;
+					}
+				}
+
+				// RTCP fraction lost is given in 1/256 units.
+				this->redFractionLostThreshold =
+				  static_cast<uint8_t>(std::min(std::lround(redThreshold * 256), 255L));
+			}
+		}
+
+		// ULPFEC (within RED) for video.
+		auto jsonFecMinRttIt = data.find("fecMinRtt");
+
+		// clang-format off
+		if (
+			this->kind == RTC::Media::Kind::VIDEO &&
+			jsonFecMinRttIt != data.end() &&
+			jsonFecMinRttIt->is_number()
+		)
+		// clang-format on
+		{
+			this->fecMinRtt = jsonFecMinRttIt->get<float>();
+
+			if (this->fecMinRtt < 0)
+				MS_THROW_TYPE_ERROR("invalid fecMinRtt");
+
+			bool redFound{ false };
+			bool ulpfecFound{ false };
+
+			for (const auto& codec : this->rtpParameters.codecs)
+			{
+				if (codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::RED)
+				{
+					redFound             = true;
+					this->redPayloadType = codec.payloadType;
+				}
+				else if (codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::ULPFEC)
+				{
+					ulpfecFound             = true;
+					this->ulpfecPayloadType = codec.payloadType;
+				}
+			}
+
+			this->fecSupported = redFound && ulpfecFound;
 		}
+
+		// A zero threshold enables RED right away.
+		if (this->redSupported)
+			UpdateRed();
 	}
 
 	SimpleConsumer::~SimpleConsumer()
@@ -102,6 +177,21 @@ namespace RTC
 		jsonObject["producerScores"] = *this->producerRtpStreamScores;
 	}
 
+	void SimpleConsumer::FillJsonRtpState(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		RTC::Consumer::FillJsonRtpStreamState(jsonObject, this->rtpStream, this->rtpSeqManager);
+	}
+
+	void SimpleConsumer::SetRtpState(json& data)
+	{
+		MS_TRACE();
+
+		// This may throw.
+		RTC::Consumer::SetRtpStreamState(data, this->rtpStream, this->rtpSeqManager);
+	}
+
 	void SimpleConsumer::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -204,6 +294,30 @@ namespace RTC
 		auto nowMs          = DepLibUV::GetTimeMs();
 		auto desiredBitrate = this->producerRtpStream->GetBitrate(nowMs);
 
+		// Leave room for FEC packets within the available bitrate headroom.
+		if (this->fecSupported)
+		{
+			uint32_t fecBitrate{ 0u };
+
+			if (desiredBitrate != 0u && bitrate > desiredBitrate)
+			{
+				fecBitrate = static_cast<uint32_t>(desiredBitrate * this->fecLossFactor);
+
+				if (fecBitrate > bitrate - desiredBitrate)
+					fecBitrate = bitrate - desiredBitrate;
+
+				this->fecHeadroomFactor = static_cast<float>(fecBitrate) / desiredBitrate;
+			}
+			else
+			{
+				this->fecHeadroomFactor = 0;
+			}
+
+			UpdateFecProtectionFactor();
+
+			desiredBitrate += fecBitrate;
+		}
+
 		if (desiredBitrate < bitrate)
 			return desiredBitrate;
 		else
@@ -239,6 +353,9 @@ namespace RTC
 		auto nowMs          = DepLibUV::GetTimeMs();
 		auto desiredBitrate = this->producerRtpStream->GetBitrate(nowMs);
 
+		// Ask for room for FEC packets too.
+		desiredBitrate += static_cast<uint32_t>(desiredBitrate * this->fecLossFactor);
+
 		// If consumer.rtpParameters.encodings[0].maxBitrate was given and it's
 		// greater than computed one, then use it.
 		auto maxBitrate = this->rtpParameters.encodings[0].maxBitrate;
@@ -249,7 +366,15 @@ namespace RTC
 		return desiredBitrate;
 	}
 
-	void SimpleConsumer::SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	bool SimpleConsumer::IsWaitingForKeyFrame(uint32_t /*mappedSsrc*/) const
+	{
+		MS_TRACE();
+
+		return IsActive() && this->syncRequired && this->keyFrameSupported;
+	}
+
+	void SimpleConsumer::SendRtpPacket(
+	  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache)
 	{
 		MS_TRACE();
 
@@ -300,6 +425,15 @@ namespace RTC
 			this->rtpSeqManager.Sync(packet->GetSequenceNumber() - 1);
 
 			this->syncRequired = false;
+
+			// Previous frames are not consecutive to this one.
+			if (this->redEncoder)
+				this->redEncoder->Reset();
+
+			if (this->fecEncoder)
+				this->fecEncoder->Reset();
+
+			this->fecInsertions.clear();
 		}
 
 		// Update RTP seq number and timestamp.
@@ -307,6 +441,29 @@ namespace RTC
 
 		this->rtpSeqManager.Input(packet->GetSequenceNumber(), seq);
 
+		// A late packet must not take the seq of FEC packets sent after the ones
+		// preceding it.
+		if (!this->fecInsertions.empty())
+		{
+			auto it = this->fecInsertions.rbegin();
+
+			for (; it != this->fecInsertions.rend(); ++it)
+			{
+				if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(packet->GetSequenceNumber(), it->first))
+					break;
+
+				seq -= it->second;
+			}
+
+			// Older FEC insertions are not tracked anymore, so drop it.
+			if (it == this->fecInsertions.rend() && this->fecInsertions.size() == MaxFecInsertions)
+			{
+				MS_DEBUG_DEV("dropping too late packet [seq:%" PRIu16 "]", packet->GetSequenceNumber());
+
+				return;
+			}
+		}
+
 		// Save original packet fields.
 		auto origSsrc = packet->GetSsrc();
 		auto origSeq  = packet->GetSequenceNumber();
@@ -327,14 +484,41 @@ namespace RTC
 			  origSeq);
 		}
 
+		auto* streamPacket = packet;
+		auto* sendPacket   = packet;
+
+		// Wrap the packet into a RED one if enabled.
+		if (this->redEncoder)
+		{
+			auto* redPacket = this->redEncoder->Encode(packet);
+
+			if (redPacket)
+			{
+				sendPacket = redPacket;
+
+				// Audio RED packets carry previous frames so they are specific to this
+				// Consumer and must not be stored in the retransmission cache shared
+				// with other Consumers. Video ones just wrap the packet, which is
+				// retransmitted as it is.
+				if (this->kind == RTC::Media::Kind::AUDIO)
+				{
+					streamPacket        = redPacket;
+					retransmissionCache = nullptr;
+				}
+			}
+		}
+
 		// Process the packet.
-		if (this->rtpStream->ReceivePacket(packet, sharedPacket))
+		if (this->rtpStream->ReceivePacket(streamPacket, retransmissionCache))
 		{
 			// Send the packet.
-			this->listener->OnConsumerSendRtpPacket(this, packet);
+			this->listener->OnConsumerSendRtpPacket(this, sendPacket);
 
 			// May emit 'trace' event.
-			EmitTraceEventRtpAndKeyFrameTypes(packet);
+			EmitTraceEventRtpAndKeyFrameTypes(sendPacket);
+
+			if (this->fecEncoder)
+				SendFecPackets(sendPacket, origSeq);
 		}
 		else
 		{
@@ -451,6 +635,12 @@ namespace RTC
 		MS_TRACE();
 
 		this->rtpStream->ReceiveRtcpReceiverReport(report);
+
+		if (this->redSupported)
+			UpdateRed();
+
+		if (this->fecSupported)
+			UpdateFec();
 	}
 
 	void SimpleConsumer::ReceiveRtcpXrReceiverReferenceTime(RTC::RTCP::ReceiverReferenceTime* report)
@@ -604,6 +794,115 @@ namespace RTC
 		this->listener->OnConsumerKeyFrameRequested(this, mappedSsrc);
 	}
 
+	void SimpleConsumer::UpdateRed()
+	{
+		MS_TRACE();
+
+		auto fractionLost = this->rtpStream->GetFractionLost();
+
+		// Disable RED once the fraction lost is well below the threshold so it does
+		// not flap around it.
+		if (!this->redEncoder && fractionLost >= this->redFractionLostThreshold)
+		{
+			MS_DEBUG_TAG(rtp, "RED enabled [fractionLost:%" PRIu8 "]", fractionLost);
+
+			this->redEncoder.reset(new RTC::RtpRedEncoder(this->redPayloadType, RedDistance));
+		}
+		else if (this->redEncoder && fractionLost < this->redFractionLostThreshold / 2)
+		{
+			MS_DEBUG_TAG(rtp, "RED disabled [fractionLost:%" PRIu8 "]", fractionLost);
+
+			this->redEncoder.reset();
+		}
+	}
+
+	void SimpleConsumer::UpdateFec()
+	{
+		MS_TRACE();
+
+		auto fractionLost = this->rtpStream->GetFractionLost();
+		auto rtt          = this->rtpStream->GetRtt();
+
+		// Retransmissions are enough to recover losses on low RTT links.
+		if (rtt >= this->fecMinRtt && fractionLost > 0u)
+		{
+			// RTCP fraction lost is given in 1/256 units.
+			this->fecLossFactor = std::min(2.0f * fractionLost / 256, MaxFecProtectionFactor);
+		}
+		else
+		{
+			this->fecLossFactor = 0;
+		}
+
+		if (!this->fecEncoder && this->fecLossFactor > 0)
+		{
+			MS_DEBUG_TAG(
+			  rtp,
+			  "FEC enabled [fractionLost:%" PRIu8 ", rtt:%f]",
+			  fractionLost,
+			  static_cast<double>(rtt));
+
+			this->fecEncoder.reset(new RTC::UlpfecEncoder(this->redPayloadType, this->ulpfecPayloadType));
+			this->redEncoder.reset(new RTC::RtpRedEncoder(this->redPayloadType, 0u));
+		}
+		else if (this->fecEncoder && this->fecLossFactor == 0)
+		{
+			MS_DEBUG_TAG(
+			  rtp,
+			  "FEC disabled [fractionLost:%" PRIu8 ", rtt:%f]",
+			  fractionLost,
+			  static_cast<double>(rtt));
+
+			this->fecEncoder.reset();
+			this->redEncoder.reset();
+		}
+
+		UpdateFecProtectionFactor();
+	}
+
+	void SimpleConsumer::UpdateFecProtectionFactor()
+	{
+		MS_TRACE();
+
+		if (!this->fecEncoder)
+			return;
+
+		auto protectionFactor = this->fecLossFactor;
+
+		// If the bitrate is managed by the transport congestion control, do not go
+		// beyond the available bitrate.
+		if (this->externallyManagedBitrate && this->fecHeadroomFactor < protectionFactor)
+			protectionFactor = this->fecHeadroomFactor;
+
+		this->fecEncoder->SetProtectionFactor(protectionFactor);
+	}
+
+	inline void SimpleConsumer::SendFecPackets(RTC::RtpPacket* packet, uint16_t origSeq)
+	{
+		MS_TRACE();
+
+		const auto& fecPackets = this->fecEncoder->AddPacket(packet);
+
+		if (fecPackets.empty())
+			return;
+
+		for (auto* fecPacket : fecPackets)
+		{
+			if (this->rtpStream->ReceivePacket(fecPacket, nullptr))
+				this->listener->OnConsumerSendRtpPacket(this, fecPacket);
+		}
+
+		auto count = static_cast<uint16_t>(fecPackets.size());
+
+		// Following packets must not take the seq of the FEC packets.
+		this->rtpSeqManager.Offset(count);
+
+		this->fecInsertions.emplace_back(origSeq, count);
+
+		if (this->fecInsertions.size() > MaxFecInsertions)
+			this->fecInsertions.pop_front();
+	}
+
 	inline void SimpleConsumer::EmitScore() const
 	{
 		MS_TRACE();
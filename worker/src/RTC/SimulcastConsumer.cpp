@@ -193,6 +193,21 @@ namespace RTC
 		jsonObject["producerScores"] = *this->producerRtpStreamScores;
 	}
 
+	void SimulcastConsumer::FillJsonRtpState(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		RTC::Consumer::FillJsonRtpStreamState(jsonObject, this->rtpStream, this->rtpSeqManager);
+	}
+
+	void SimulcastConsumer::SetRtpState(json& data)
+	{
+		MS_TRACE();
+
+		// This may throw.
+		RTC::Consumer::SetRtpStreamState(data, this->rtpStream, this->rtpSeqManager);
+	}
+
 	void SimulcastConsumer::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -386,8 +401,8 @@ namespace RTC
 		// If already in the preferred layers, do nothing.
 		// clang-format off
 		if (
-			this->provisionalTargetSpatialLayer == this->preferredSpatialLayer &&
-			this->provisionalTargetTemporalLayer == this->preferredTemporalLayer
+			this->provisionalTargetSpatialLayer == GetEffectivePreferredSpatialLayer() &&
+			this->provisionalTargetTemporalLayer == GetEffectivePreferredTemporalLayer()
 		)
 		// clang-format on
 		{
@@ -528,7 +543,7 @@ namespace RTC
 			}
 
 			// If this is the preferred or higher spatial layer, take it and exit.
-			if (spatialLayer >= this->preferredSpatialLayer)
+			if (spatialLayer >= GetEffectivePreferredSpatialLayer())
 				break;
 		}
 
@@ -590,7 +605,7 @@ namespace RTC
 			if (
 				this->rtpStream->GetActiveMs() > BweDowngradeMinActiveMs &&
 				this->targetSpatialLayer < this->currentSpatialLayer &&
-				this->currentSpatialLayer <= this->preferredSpatialLayer
+				this->currentSpatialLayer <= GetEffectivePreferredSpatialLayer()
 			)
 			// clang-format on
 			{
@@ -640,16 +655,209 @@ namespace RTC
 		return desiredBitrate;
 	}
 
+	bool SimulcastConsumer::IsWaitingForKeyFrame(uint32_t mappedSsrc) const
+	{
+		MS_TRACE();
+
+		if (!IsActive() || this->targetTemporalLayer == -1)
+			return false;
+
+		auto it = this->mapMappedSsrcSpatialLayer.find(mappedSsrc);
+
+		if (it == this->mapMappedSsrcSpatialLayer.end())
+			return false;
+
+		auto spatialLayer = it->second;
+
+		// Waiting for a key frame of the target spatial layer to switch to it.
+		if (this->currentSpatialLayer != this->targetSpatialLayer)
+			return spatialLayer == this->targetSpatialLayer;
+
+		return this->syncRequired && spatialLayer == this->currentSpatialLayer;
+	}
+
+	bool SimulcastConsumer::IsForwardingRtpStream(uint32_t mappedSsrc) const
+	{
+		MS_TRACE();
+
+		// NOTE: Must match the checks in SendRtpPacket() other than IsActive().
+		if (this->targetTemporalLayer == -1)
+			return false;
+
+		auto it = this->mapMappedSsrcSpatialLayer.find(mappedSsrc);
+
+		if (it == this->mapMappedSsrcSpatialLayer.end())
+			return false;
+
+		auto spatialLayer = it->second;
+
+		return spatialLayer == this->currentSpatialLayer || spatialLayer == this->targetSpatialLayer;
+	}
+
+	bool SimulcastConsumer::CanLeadRtpRewrite() const
+	{
+		MS_TRACE();
+
+		// Just while not switching layers, so the rewrite of every packet is the
+		// same for all the Consumers in the group.
+		// clang-format off
+		return (
+			this->rtpRewriteStarted &&
+			IsActive() &&
+			this->targetTemporalLayer != -1 &&
+			!this->syncRequired &&
+			this->currentSpatialLayer == this->targetSpatialLayer
+		);
+		// clang-format on
+	}
+
+	bool SimulcastConsumer::CanShareRtpRewrite(const RTC::Consumer* leader) const
+	{
+		MS_TRACE();
+
+		const auto* simulcastLeader = dynamic_cast<const RTC::SimulcastConsumer*>(leader);
+
+		// clang-format off
+		return (
+			simulcastLeader &&
+			simulcastLeader != this &&
+			simulcastLeader->rtpRewriteStarted &&
+			this->rtpRewriteStarted &&
+			IsActive() &&
+			!this->syncRequired &&
+			this->targetSpatialLayer == simulcastLeader->targetSpatialLayer &&
+			this->targetTemporalLayer == simulcastLeader->targetTemporalLayer &&
+			this->currentSpatialLayer == simulcastLeader->currentSpatialLayer &&
+			this->tsReferenceSpatialLayer == simulcastLeader->tsReferenceSpatialLayer
+		);
+		// clang-format on
+	}
+
+	bool SimulcastConsumer::MayJoinRtpRewrite(const RTC::RtpPacket* packet) const
+	{
+		MS_TRACE();
+
+		// clang-format off
+		return (
+			!this->rtpRewriteStarted &&
+			!this->rtpStream->IsStarted() &&
+			this->syncRequired &&
+			IsActive() &&
+			this->targetTemporalLayer != -1 &&
+			packet->IsKeyFrame()
+		);
+		// clang-format on
+	}
+
+	bool SimulcastConsumer::CanJoinRtpRewrite(
+	  const RTC::Consumer* leader, const RTC::RtpPacket* packet) const
+	{
+		MS_TRACE();
+
+		const auto* simulcastLeader = dynamic_cast<const RTC::SimulcastConsumer*>(leader);
+
+		// clang-format off
+		if (
+			!simulcastLeader ||
+			simulcastLeader == this ||
+			!MayJoinRtpRewrite(packet) ||
+			this->targetSpatialLayer != simulcastLeader->targetSpatialLayer ||
+			this->targetTemporalLayer != simulcastLeader->targetTemporalLayer ||
+			this->supportedCodecPayloadTypes != simulcastLeader->supportedCodecPayloadTypes
+		)
+		// clang-format on
+		{
+			return false;
+		}
+
+		auto it = this->mapMappedSsrcSpatialLayer.find(packet->GetSsrc());
+
+		if (it == this->mapMappedSsrcSpatialLayer.end() || it->second != this->targetSpatialLayer)
+			return false;
+
+		if (simulcastLeader->rtpRewriteStarted)
+		{
+			return (
+			  simulcastLeader->CanLeadRtpRewrite() &&
+			  simulcastLeader->currentSpatialLayer == this->targetSpatialLayer);
+		}
+
+		// A not yet started leader syncs with this key frame as this Consumer would.
+		return simulcastLeader->MayJoinRtpRewrite(packet);
+	}
+
+	void SimulcastConsumer::LeaveRtpRewrite(const RTC::Consumer* leader)
+	{
+		MS_TRACE();
+
+		// Nothing has been shared yet.
+		if (!this->rtpRewriteStarted)
+			return;
+
+		// NOTE: Groups just contain SimulcastConsumers (see CanJoinRtpRewrite()).
+		CopyRtpRewrite(static_cast<const RTC::SimulcastConsumer*>(leader));
+
+		MS_DEBUG_DEV(
+		  "RTP rewrite group left [consumerId:%s, leaderId:%s]", this->id.c_str(), leader->id.c_str());
+	}
+
+	void SimulcastConsumer::SetLastNDowngraded(bool lastNDowngraded)
+	{
+		MS_TRACE();
+
+		if (lastNDowngraded == this->lastNDowngraded)
+			return;
+
+		this->lastNDowngraded = lastNDowngraded;
+
+		MS_DEBUG_DEV(
+		  "last-N downgrade %s [consumerId:%s]",
+		  lastNDowngraded ? "enabled" : "disabled",
+		  this->id.c_str());
+
+		if (IsActive())
+			MayChangeLayers(/*force*/ true);
+	}
+
+	void SimulcastConsumer::SetOverloadDowngraded(bool overloadDowngraded)
+	{
+		MS_TRACE();
+
+		if (overloadDowngraded == this->overloadDowngraded)
+			return;
+
+		this->overloadDowngraded = overloadDowngraded;
+
+		MS_DEBUG_DEV(
+		  "overload downgrade %s [consumerId:%s]",
+		  overloadDowngraded ? "enabled" : "disabled",
+		  this->id.c_str());
+
+		if (IsActive())
+			MayChangeLayers(/*force*/ true);
+	}
+
 	void SimulcastConsumer::SendRtpPacket(
-	  RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache)
 	{
 		MS_TRACE();
 
-		if (!IsActive())
+		if (!RewriteRtpPacket(packet))
 			return;
 
+		SendRewrittenRtpPacket(packet, this, retransmissionCache);
+		RestoreRtpPacket(packet);
+	}
+
+	bool SimulcastConsumer::RewriteRtpPacket(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		if (!IsActive())
+			return false;
+
 		if (this->targetTemporalLayer == -1)
-			return;
+			return false;
 
 		auto payloadType = packet->GetPayloadType();
 
@@ -659,7 +867,7 @@ namespace RTC
 		{
 			MS_DEBUG_DEV("payload type not supported [payloadType:%" PRIu8 "]", payloadType);
 
-			return;
+			return false;
 		}
 
 		auto spatialLayer = this->mapMappedSsrcSpatialLayer.at(packet->GetSsrc());
@@ -671,7 +879,7 @@ namespace RTC
 		{
 			// Ignore if not a key frame.
 			if (!packet->IsKeyFrame())
-				return;
+				return false;
 
 			shouldSwitchCurrentSpatialLayer = true;
 
@@ -683,12 +891,12 @@ namespace RTC
 		// drop it.
 		else if (spatialLayer != this->currentSpatialLayer)
 		{
-			return;
+			return false;
 		}
 
 		// If we need to sync and this is not a key frame, ignore the packet.
 		if (this->syncRequired && !packet->IsKeyFrame())
-			return;
+			return false;
 
 		// Whether this is the first packet after re-sync.
 		bool isSyncPacket = this->syncRequired;
@@ -792,7 +1000,7 @@ namespace RTC
 
 					this->keyFrameForTsOffsetRequested = true;
 
-					return;
+					return false;
 				}
 
 				if (tsExtraOffset > 0u)
@@ -831,7 +1039,7 @@ namespace RTC
 			if (SeqManager<uint16_t>::IsSeqLowerThan(
 			      packet->GetSequenceNumber(), this->snReferenceSpatialLayer))
 			{
-				return;
+				return false;
 			}
 			else if (SeqManager<uint16_t>::IsSeqHigherThan(
 			           packet->GetSequenceNumber(), this->snReferenceSpatialLayer + MaxSequenceNumberGap))
@@ -857,6 +1065,8 @@ namespace RTC
 			// Reset the score of our RtpStream to 10.
 			this->rtpStream->ResetScore(10u, /*notify*/ false);
 
+			this->listener->OnConsumerForwardedRtpStreamsChange(this);
+
 			// Emit the layersChange event.
 			EmitLayersChange();
 
@@ -875,7 +1085,7 @@ namespace RTC
 			{
 				this->rtpSeqManager.Drop(packet->GetSequenceNumber());
 
-				return;
+				return false;
 			}
 
 			if (previousTemporalLayer != this->encodingContext->GetCurrentTemporalLayer())
@@ -889,12 +1099,11 @@ namespace RTC
 		this->rtpSeqManager.Input(packet->GetSequenceNumber(), seq);
 
 		// Save original packet fields.
-		auto origSsrc      = packet->GetSsrc();
-		auto origSeq       = packet->GetSequenceNumber();
-		auto origTimestamp = packet->GetTimestamp();
+		this->rewrittenOrigSsrc      = packet->GetSsrc();
+		this->rewrittenOrigSeq       = packet->GetSequenceNumber();
+		this->rewrittenOrigTimestamp = packet->GetTimestamp();
 
-		// Rewrite packet.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
+		// Rewrite packet. The SSRC is set by every Consumer sending it.
 		packet->SetSequenceNumber(seq);
 		packet->SetTimestamp(timestamp);
 
@@ -904,19 +1113,60 @@ namespace RTC
 			  rtp,
 			  "sending sync packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32 "]",
-			  packet->GetSsrc(),
+			  this->rtpParameters.encodings[0].ssrc,
 			  packet->GetSequenceNumber(),
 			  packet->GetTimestamp(),
-			  origSsrc,
-			  origSeq,
-			  origTimestamp);
+			  this->rewrittenOrigSsrc,
+			  this->rewrittenOrigSeq,
+			  this->rewrittenOrigTimestamp);
 		}
 
+		this->rtpRewriteStarted = true;
+
+		return true;
+	}
+
+	void SimulcastConsumer::SendRewrittenRtpPacket(
+	  RTC::RtpPacket* packet,
+	  const RTC::Consumer* leader,
+	  RTC::RtpRetransmissionCache* retransmissionCache)
+	{
+		MS_TRACE();
+
+		// NOTE: Groups just contain SimulcastConsumers (see CanJoinRtpRewrite()).
+		const auto* simulcastLeader = static_cast<const RTC::SimulcastConsumer*>(leader);
+
+		if (!this->rtpRewriteStarted)
+		{
+			JoinRtpRewrite(simulcastLeader);
+		}
+		else if (simulcastLeader != this)
+		{
+			auto temporalLayer = simulcastLeader->encodingContext->GetCurrentTemporalLayer();
+
+			if (temporalLayer != this->encodingContext->GetCurrentTemporalLayer())
+			{
+				this->encodingContext->SetCurrentTemporalLayer(temporalLayer);
+
+				EmitLayersChange();
+			}
+		}
+
+		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
+
 		// Process the packet.
-		if (this->rtpStream->ReceivePacket(packet, sharedPacket))
+		if (this->rtpStream->ReceivePacket(packet, retransmissionCache))
 		{
-			if (this->rtpSeqManager.GetMaxOutput() == packet->GetSequenceNumber())
+			// Grouped Consumers take it from the leader when leaving the group.
+			// clang-format off
+			if (
+				simulcastLeader == this &&
+				this->rtpSeqManager.GetMaxOutput() == packet->GetSequenceNumber()
+			)
+			// clang-format on
+			{
 				this->lastSentPacketHasMarker = packet->HasMarker();
+			}
 
 			// Send the packet.
 			this->listener->OnConsumerSendRtpPacket(this, packet);
@@ -933,15 +1183,20 @@ namespace RTC
 			  packet->GetSsrc(),
 			  packet->GetSequenceNumber(),
 			  packet->GetTimestamp(),
-			  origSsrc,
-			  origSeq,
-			  origTimestamp);
+			  simulcastLeader->rewrittenOrigSsrc,
+			  simulcastLeader->rewrittenOrigSeq,
+			  simulcastLeader->rewrittenOrigTimestamp);
 		}
+	}
+
+	void SimulcastConsumer::RestoreRtpPacket(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
 
 		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
-		packet->SetTimestamp(origTimestamp);
+		packet->SetSsrc(this->rewrittenOrigSsrc);
+		packet->SetSequenceNumber(this->rewrittenOrigSeq);
+		packet->SetTimestamp(this->rewrittenOrigTimestamp);
 
 		// Restore the original payload if needed.
 		packet->RestorePayload();
@@ -1337,15 +1592,15 @@ namespace RTC
 			newTargetSpatialLayer = spatialLayer;
 
 			// If this is the preferred or higher spatial layer take it and exit.
-			if (spatialLayer >= this->preferredSpatialLayer)
+			if (spatialLayer >= GetEffectivePreferredSpatialLayer())
 				break;
 		}
 
 		if (newTargetSpatialLayer != -1)
 		{
-			if (newTargetSpatialLayer == this->preferredSpatialLayer)
-				newTargetTemporalLayer = this->preferredTemporalLayer;
-			else if (newTargetSpatialLayer < this->preferredSpatialLayer)
+			if (newTargetSpatialLayer == GetEffectivePreferredSpatialLayer())
+				newTargetTemporalLayer = GetEffectivePreferredTemporalLayer();
+			else if (newTargetSpatialLayer < GetEffectivePreferredSpatialLayer())
 				newTargetTemporalLayer = this->rtpStream->GetTemporalLayers() - 1;
 			else
 				newTargetTemporalLayer = 0;
@@ -1386,6 +1641,8 @@ namespace RTC
 			MS_DEBUG_TAG(
 			  simulcast, "target layers changed [spatial:-1, temporal:-1, consumerId:%s]", this->id.c_str());
 
+			this->listener->OnConsumerForwardedRtpStreamsChange(this);
+
 			EmitLayersChange();
 
 			return;
@@ -1406,6 +1663,8 @@ namespace RTC
 		  this->targetTemporalLayer,
 		  this->id.c_str());
 
+		this->listener->OnConsumerForwardedRtpStreamsChange(this);
+
 		// If the target spatial layer is different than the current one, request
 		// a key frame.
 		if (this->targetSpatialLayer != this->currentSpatialLayer)
@@ -1441,6 +1700,62 @@ namespace RTC
 		// clang-format on
 	}
 
+	void SimulcastConsumer::CopyRtpRewrite(const RTC::SimulcastConsumer* consumer)
+	{
+		MS_TRACE();
+
+		// Keep the target layers of this Consumer.
+		auto targetSpatialLayer  = this->encodingContext->GetTargetSpatialLayer();
+		auto targetTemporalLayer = this->encodingContext->GetTargetTemporalLayer();
+
+		this->encodingContext.reset(consumer->encodingContext->Clone());
+		this->encodingContext->SetTargetSpatialLayer(targetSpatialLayer);
+		this->encodingContext->SetTargetTemporalLayer(targetTemporalLayer);
+
+		this->rtpSeqManager                       = consumer->rtpSeqManager;
+		this->tsOffset                            = consumer->tsOffset;
+		this->lastSentPacketHasMarker             = consumer->lastSentPacketHasMarker;
+		this->snReferenceSpatialLayer             = consumer->snReferenceSpatialLayer;
+		this->checkingForOldPacketsInSpatialLayer = consumer->checkingForOldPacketsInSpatialLayer;
+	}
+
+	void SimulcastConsumer::JoinRtpRewrite(const RTC::SimulcastConsumer* leader)
+	{
+		MS_TRACE();
+
+		MS_DEBUG_TAG(
+		  simulcast,
+		  "RTP rewrite group joined [consumerId:%s, leaderId:%s]",
+		  this->id.c_str(),
+		  leader->id.c_str());
+
+		// Nothing has been sent yet, so take the rewrite state of the leader
+		// (including the packet being sent) and its current layers.
+		CopyRtpRewrite(leader);
+
+		this->rtpRewriteStarted            = true;
+		this->syncRequired                 = false;
+		this->spatialLayerToSync           = -1;
+		this->keyFrameForTsOffsetRequested = false;
+		this->tsReferenceSpatialLayer      = leader->tsReferenceSpatialLayer;
+		this->currentSpatialLayer          = leader->currentSpatialLayer;
+
+		this->encodingContext->SetTargetTemporalLayer(this->targetTemporalLayer);
+		this->encodingContext->SetCurrentTemporalLayer(
+		  leader->encodingContext->GetCurrentTemporalLayer());
+
+		// Reset the score of our RtpStream to 10.
+		this->rtpStream->ResetScore(10u, /*notify*/ false);
+
+		this->listener->OnConsumerForwardedRtpStreamsChange(this);
+
+		// Emit the layersChange event.
+		EmitLayersChange();
+
+		// Emit the score event.
+		EmitScore();
+	}
+
 	inline void SimulcastConsumer::EmitScore() const
 	{
 		MS_TRACE();
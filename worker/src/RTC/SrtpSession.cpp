@@ -5,6 +5,7 @@
 #include "DepLibSRTP.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
 #include <cstring> // std::memset(), std::memcpy()
 
 namespace RTC
@@ -13,6 +14,9 @@ namespace RTC
 
 	static constexpr size_t EncryptBufferSize{ 65536 };
 	thread_local static uint8_t EncryptBuffer[EncryptBufferSize];
+	// Max number of SRTCP packets protected to advance the SRTCP index of an
+	// imported stream.
+	static constexpr uint32_t MaxRtcpIndexAdvance{ 1u << 20 };
 
 	/* Class methods. */
 
@@ -28,6 +32,25 @@ namespace RTC
 		}
 	}
 
+	size_t SrtpSession::GetMasterLength(CryptoSuite cryptoSuite)
+	{
+		switch (cryptoSuite)
+		{
+			case CryptoSuite::AEAD_AES_256_GCM:
+				return SRTP_AES_GCM_256_KEY_LEN_WSALT;
+
+			case CryptoSuite::AEAD_AES_128_GCM:
+				return SRTP_AES_GCM_128_KEY_LEN_WSALT;
+
+			case CryptoSuite::AES_CM_128_HMAC_SHA1_80:
+			case CryptoSuite::AES_CM_128_HMAC_SHA1_32:
+				return SRTP_AES_ICM_128_KEY_LEN_WSALT;
+
+			default:
+				return 0u;
+		}
+	}
+
 	void SrtpSession::OnSrtpEvent(srtp_event_data_t* data)
 	{
 		MS_TRACE();
@@ -55,58 +78,30 @@ namespace RTC
 	/* Instance methods. */
 
 	SrtpSession::SrtpSession(Type type, CryptoSuite cryptoSuite, uint8_t* key, size_t keyLen)
+	  : SrtpSession(type, cryptoSuite, key, keyLen, std::vector<StreamState>())
 	{
-		MS_TRACE();
-
-		srtp_policy_t policy; // NOLINT(cppcoreguidelines-pro-type-member-init)
-
-		// Set all policy fields to 0.
-		std::memset(&policy, 0, sizeof(srtp_policy_t));
-
-		switch (cryptoSuite)
-		{
-			case CryptoSuite::AEAD_AES_256_GCM:
-			{
-				srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtp);
-				srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtcp);
-
-				break;
-			}
-
-			case CryptoSuite::AEAD_AES_128_GCM:
-			{
-				srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtp);
-				srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtcp);
-
-				break;
-			}
-
-			case CryptoSuite::AES_CM_128_HMAC_SHA1_80:
-			{
-				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
-				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
-
-				break;
-			}
+	}
 
-			case CryptoSuite::AES_CM_128_HMAC_SHA1_32:
-			{
-				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_32(&policy.rtp);
-				// NOTE: Must be 80 for RTCP.
-				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+	/**
+	 * The given streams are added with their state, so the session continues the
+	 * one of a migrated transport. The key is not kept once the streams are
+	 * added.
+	 */
+	SrtpSession::SrtpSession(
+	  Type type,
+	  CryptoSuite cryptoSuite,
+	  uint8_t* key,
+	  size_t keyLen,
+	  const std::vector<StreamState>& streamStates)
+	  : type(type), cryptoSuite(cryptoSuite)
+	{
+		MS_TRACE();
 
-				break;
-			}
+		DepLibSRTP::EnsureInitialized();
 
-			default:
-			{
-				MS_ABORT("unknown SRTP crypto suite");
-			}
-		}
+		srtp_policy_t policy; // NOLINT(cppcoreguidelines-pro-type-member-init)
 
-		MS_ASSERT(
-		  (int)keyLen == policy.rtp.cipher_key_len,
-		  "given keyLen does not match policy.rtp.cipher_keyLen");
+		FillPolicy(policy, key, keyLen);
 
 		switch (type)
 		{
@@ -120,17 +115,18 @@ namespace RTC
 		}
 
 		policy.ssrc.value = 0;
-		policy.key        = key;
-		// Required for sending RTP retransmission without RTX.
-		policy.allow_repeat_tx = 1;
-		policy.window_size     = 1024;
-		policy.next            = nullptr;
 
 		// Set the SRTP session.
 		srtp_err_status_t err = srtp_create(&this->session, &policy);
 
 		if (DepLibSRTP::IsError(err))
 			MS_THROW_ERROR("srtp_create() failed: %s", DepLibSRTP::GetErrorString(err));
+
+		for (auto& state : streamStates)
+		{
+			if (!AddStream(policy, state))
+				MS_WARN_TAG(srtp, "could not add stream [ssrc:%" PRIu32 "]", state.ssrc);
+		}
 	}
 
 	SrtpSession::~SrtpSession()
@@ -146,6 +142,124 @@ namespace RTC
 		}
 	}
 
+	/**
+	 * State of the given streams (those not in the session are skipped) and of
+	 * the streams used just for sending RTCP.
+	 */
+	std::vector<SrtpSession::StreamState> SrtpSession::GetStreamStates(
+	  const std::vector<uint32_t>& ssrcs) const
+	{
+		MS_TRACE();
+
+		std::vector<StreamState> states;
+		auto mapSsrcRtcpIndex = this->mapSsrcRtcpIndex;
+
+		for (auto ssrc : ssrcs)
+		{
+			StreamState state;
+
+			state.ssrc = ssrc;
+
+			if (DepLibSRTP::IsError(srtp_get_stream_roc(this->session, ssrc, &state.roc)))
+				continue;
+
+			auto it = mapSsrcRtcpIndex.find(ssrc);
+
+			if (it != mapSsrcRtcpIndex.end())
+			{
+				state.rtcpIndex = it->second;
+
+				mapSsrcRtcpIndex.erase(it);
+			}
+
+			states.push_back(state);
+		}
+
+		for (auto& kv : mapSsrcRtcpIndex)
+		{
+			StreamState state;
+
+			state.ssrc      = kv.first;
+			state.rtcpIndex = kv.second;
+
+			states.push_back(state);
+		}
+
+		return states;
+	}
+
+	/**
+	 * Streams are created with the first packet, so the stream is added here if
+	 * it does not exist yet. libsrtp applies the ROC with the first RTP packet of
+	 * the stream. The SRTCP index of a sending stream is advanced by protecting
+	 * as many RTCP packets since there is no API to set it. The SRTCP replay
+	 * window of a receiving stream starts with the first SRTCP packet.
+	 */
+	bool SrtpSession::AddStream(srtp_policy_t& policy, const StreamState& state)
+	{
+		MS_TRACE();
+
+		uint32_t roc;
+		srtp_err_status_t err;
+
+		if (DepLibSRTP::IsError(srtp_get_stream_roc(this->session, state.ssrc, &roc)))
+		{
+			policy.ssrc.type  = ssrc_specific;
+			policy.ssrc.value = state.ssrc;
+
+			err = srtp_add_stream(this->session, &policy);
+
+			if (DepLibSRTP::IsError(err))
+			{
+				MS_WARN_TAG(srtp, "srtp_add_stream() failed: %s", DepLibSRTP::GetErrorString(err));
+
+				return false;
+			}
+		}
+
+		if (state.roc != 0u)
+		{
+			err = srtp_set_stream_roc(this->session, state.ssrc, state.roc);
+
+			if (DepLibSRTP::IsError(err))
+			{
+				MS_WARN_TAG(srtp, "srtp_set_stream_roc() failed: %s", DepLibSRTP::GetErrorString(err));
+
+				return false;
+			}
+		}
+
+		if (this->type != Type::OUTBOUND || state.rtcpIndex == 0u)
+			return true;
+
+		if (state.rtcpIndex > MaxRtcpIndexAdvance)
+		{
+			MS_WARN_TAG(
+			  srtp,
+			  "SRTCP index too high, not advancing it [ssrc:%" PRIu32 ", index:%" PRIu32 "]",
+			  state.ssrc,
+			  state.rtcpIndex);
+
+			return false;
+		}
+
+		// Empty Receiver Report with the SSRC of the stream.
+		uint8_t rtcp[8]{ 0x80, 201, 0x00, 0x01 };
+
+		Utils::Byte::Set4Bytes(rtcp, 4, state.ssrc);
+
+		for (uint32_t i{ 0u }; i < state.rtcpIndex; ++i)
+		{
+			const uint8_t* data = rtcp;
+			int len             = sizeof(rtcp);
+
+			if (!EncryptRtcp(&data, &len))
+				return false;
+		}
+
+		return true;
+	}
+
 	bool SrtpSession::EncryptRtp(const uint8_t** data, int* len)
 	{
 		MS_TRACE();
@@ -214,6 +328,9 @@ namespace RTC
 			return false;
 		}
 
+		// libsrtp uses the stream of the SSRC of the first RTCP packet.
+		++this->mapSsrcRtcpIndex[Utils::Byte::Get4Bytes(EncryptBuffer, 4)];
+
 		// Update the given data pointer.
 		*data = (const uint8_t*)EncryptBuffer;
 
@@ -235,4 +352,64 @@ namespace RTC
 
 		return true;
 	}
+
+	void SrtpSession::FillPolicy(srtp_policy_t& policy, uint8_t* key, size_t keyLen) const
+	{
+		MS_TRACE();
+
+		// Set all policy fields to 0.
+		std::memset(&policy, 0, sizeof(srtp_policy_t));
+
+		switch (this->cryptoSuite)
+		{
+			case CryptoSuite::AEAD_AES_256_GCM:
+			{
+				srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtp);
+				srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtcp);
+
+				break;
+			}
+
+			case CryptoSuite::AEAD_AES_128_GCM:
+			{
+				srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtp);
+				srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtcp);
+
+				break;
+			}
+
+			case CryptoSuite::AES_CM_128_HMAC_SHA1_80:
+			{
+				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
+				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+
+				break;
+			}
+
+			case CryptoSuite::AES_CM_128_HMAC_SHA1_32:
+			{
+				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_32(&policy.rtp);
+				// NOTE: Must be 80 for RTCP.
+				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+
+				break;
+			}
+
+			default:
+			{
+				MS_ABORT("unknown SRTP crypto suite");
+			}
+		}
+
+		MS_ASSERT(
+		  (int)keyLen == policy.rtp.cipher_key_len,
+		  "given keyLen does not match policy.rtp.cipher_keyLen");
+
+		// NOTE: libsrtp copies the key.
+		policy.key = key;
+		// Required for sending RTP retransmission without RTX.
+		policy.allow_repeat_tx = 1;
+		policy.window_size     = 1024;
+		policy.next            = nullptr;
+	}
 } // namespace RTC
@@ -15,12 +15,17 @@ namespace RTC
 
 	/* Class methods. */
 
-	StunPacket* StunPacket::Parse(const uint8_t* data, size_t len)
+	/**
+	 * Parses the given data into the given StunPacket, so it can be allocated in
+	 * the stack. The StunPacket just points to the given data, which must
+	 * outlive it. Returns false if the data is not a valid STUN packet.
+	 */
+	bool StunPacket::Parse(const uint8_t* data, size_t len, StunPacket& packet)
 	{
 		MS_TRACE();
 
 		if (!StunPacket::IsStun(data, len))
-			return nullptr;
+			return false;
 
 		/*
 		  The message type field is decomposed further into the following
@@ -55,7 +60,7 @@ namespace RTC
 			  "length field + 20 does not match total size (or it is not multiple of 4 bytes), "
 			  "packet discarded");
 
-			return nullptr;
+			return false;
 		}
 
 		// Get STUN method.
@@ -64,9 +69,9 @@ namespace RTC
 		// Get STUN class.
 		uint16_t msgClass = ((data[0] & 0x01) << 1) | ((data[1] & 0x10) >> 4);
 
-		// Create a new StunPacket (data + 8 points to the received TransactionID field).
-		auto* packet = new StunPacket(
-		  static_cast<Class>(msgClass), static_cast<Method>(msgMethod), data + 8, data, len);
+		// Reset the given StunPacket (data + 8 points to the received TransactionID field).
+		packet =
+		  StunPacket(static_cast<Class>(msgClass), static_cast<Method>(msgMethod), data + 8, data, len);
 
 		/*
 		    STUN Attributes
@@ -108,8 +113,7 @@ namespace RTC
 			{
 				MS_WARN_TAG(ice, "the attribute length exceeds the remaining size, packet discarded");
 
-				delete packet;
-				return nullptr;
+				return false;
 			}
 
 			// FINGERPRINT must be the last attribute.
@@ -117,8 +121,7 @@ namespace RTC
 			{
 				MS_WARN_TAG(ice, "attribute after FINGERPRINT is not allowed, packet discarded");
 
-				delete packet;
-				return nullptr;
+				return false;
 			}
 
 			// After a MESSAGE-INTEGRITY attribute just FINGERPRINT is allowed.
@@ -129,8 +132,7 @@ namespace RTC
 				  "attribute after MESSAGE-INTEGRITY other than FINGERPRINT is not allowed, "
 				  "packet discarded");
 
-				delete packet;
-				return nullptr;
+				return false;
 			}
 
 			const uint8_t* attrValuePos = data + pos + 4;
@@ -139,7 +141,7 @@ namespace RTC
 			{
 				case Attribute::USERNAME:
 				{
-					packet->SetUsername(
+					packet.SetUsername(
 					  reinterpret_cast<const char*>(attrValuePos), static_cast<size_t>(attrLength));
 
 					break;
@@ -152,11 +154,10 @@ namespace RTC
 					{
 						MS_WARN_TAG(ice, "attribute PRIORITY must be 4 bytes length, packet discarded");
 
-						delete packet;
-						return nullptr;
+						return false;
 					}
 
-					packet->SetPriority(Utils::Byte::Get4Bytes(attrValuePos, 0));
+					packet.SetPriority(Utils::Byte::Get4Bytes(attrValuePos, 0));
 
 					break;
 				}
@@ -168,11 +169,10 @@ namespace RTC
 					{
 						MS_WARN_TAG(ice, "attribute ICE-CONTROLLING must be 8 bytes length, packet discarded");
 
-						delete packet;
-						return nullptr;
+						return false;
 					}
 
-					packet->SetIceControlling(Utils::Byte::Get8Bytes(attrValuePos, 0));
+					packet.SetIceControlling(Utils::Byte::Get8Bytes(attrValuePos, 0));
 
 					break;
 				}
@@ -184,11 +184,10 @@ namespace RTC
 					{
 						MS_WARN_TAG(ice, "attribute ICE-CONTROLLED must be 8 bytes length, packet discarded");
 
-						delete packet;
-						return nullptr;
+						return false;
 					}
 
-					packet->SetIceControlled(Utils::Byte::Get8Bytes(attrValuePos, 0));
+					packet.SetIceControlled(Utils::Byte::Get8Bytes(attrValuePos, 0));
 
 					break;
 				}
@@ -200,11 +199,10 @@ namespace RTC
 					{
 						MS_WARN_TAG(ice, "attribute USE-CANDIDATE must be 0 bytes length, packet discarded");
 
-						delete packet;
-						return nullptr;
+						return false;
 					}
 
-					packet->SetUseCandidate();
+					packet.SetUseCandidate();
 
 					break;
 				}
@@ -216,12 +214,11 @@ namespace RTC
 					{
 						MS_WARN_TAG(ice, "attribute NOMINATION must be 4 bytes length, packet discarded");
 
-						delete packet;
-						return nullptr;
+						return false;
 					}
 
-					packet->SetHasNomination();
-					packet->SetNomination(Utils::Byte::Get4Bytes(attrValuePos, 0));
+					packet.SetHasNomination();
+					packet.SetNomination(Utils::Byte::Get4Bytes(attrValuePos, 0));
 
 					break;
 				}
@@ -233,12 +230,11 @@ namespace RTC
 					{
 						MS_WARN_TAG(ice, "attribute MESSAGE-INTEGRITY must be 20 bytes length, packet discarded");
 
-						delete packet;
-						return nullptr;
+						return false;
 					}
 
 					hasMessageIntegrity = true;
-					packet->SetMessageIntegrity(attrValuePos);
+					packet.SetMessageIntegrity(attrValuePos);
 
 					break;
 				}
@@ -250,14 +246,13 @@ namespace RTC
 					{
 						MS_WARN_TAG(ice, "attribute FINGERPRINT must be 4 bytes length, packet discarded");
 
-						delete packet;
-						return nullptr;
+						return false;
 					}
 
 					hasFingerprint     = true;
 					fingerprintAttrPos = pos;
 					fingerprint        = Utils::Byte::Get4Bytes(attrValuePos, 0);
-					packet->SetFingerprint();
+					packet.SetFingerprint();
 
 					break;
 				}
@@ -269,15 +264,14 @@ namespace RTC
 					{
 						MS_WARN_TAG(ice, "attribute ERROR-CODE must be >= 4bytes length, packet discarded");
 
-						delete packet;
-						return nullptr;
+						return false;
 					}
 
 					uint8_t errorClass  = Utils::Byte::Get1Byte(attrValuePos, 2);
 					uint8_t errorNumber = Utils::Byte::Get1Byte(attrValuePos, 3);
 					auto errorCode      = static_cast<uint16_t>(errorClass * 100 + errorNumber);
 
-					packet->SetErrorCode(errorCode);
+					packet.SetErrorCode(errorCode);
 
 					break;
 				}
@@ -295,8 +289,7 @@ namespace RTC
 		{
 			MS_WARN_TAG(ice, "computed packet size does not match total size, packet discarded");
 
-			delete packet;
-			return nullptr;
+			return false;
 		}
 
 		// If it has FINGERPRINT attribute then verify it.
@@ -314,12 +307,11 @@ namespace RTC
 				  "computed FINGERPRINT value does not match the value in the packet, "
 				  "packet discarded");
 
-				delete packet;
-				return nullptr;
+				return false;
 			}
 		}
 
-		return packet;
+		return true;
 	}
 
 	/* Instance methods. */
@@ -332,11 +324,6 @@ namespace RTC
 		MS_TRACE();
 	}
 
-	StunPacket::~StunPacket()
-	{
-		MS_TRACE();
-	}
-
 	void StunPacket::Dump() const
 	{
 		MS_TRACE();
@@ -381,7 +368,7 @@ namespace RTC
 		if (this->errorCode != 0u)
 			MS_DUMP("  errorCode: %" PRIu16, this->errorCode);
 		if (!this->username.empty())
-			MS_DUMP("  username: %s", this->username.c_str());
+			MS_DUMP("  username: %.*s", static_cast<int>(this->username.size()), this->username.data());
 		if (this->priority != 0u)
 			MS_DUMP("  priority: %" PRIu32, this->priority);
 		if (this->iceControlling != 0u)
@@ -418,7 +405,7 @@ namespace RTC
 	}
 
 	StunPacket::Authentication StunPacket::CheckAuthentication(
-	  const std::string& localUsername, const std::string& localPassword)
+	  const std::string& localUsername, Utils::Crypto::HmacSha1* localHmacSha1)
 	{
 		MS_TRACE();
 
@@ -435,8 +422,8 @@ namespace RTC
 				size_t localUsernameLen = localUsername.length();
 
 				if (
-				  this->username.length() <= localUsernameLen || this->username.at(localUsernameLen) != ':' ||
-				  (this->username.compare(0, localUsernameLen, localUsername) != 0))
+				  this->username.length() <= localUsernameLen || this->username[localUsernameLen] != ':' ||
+				  std::memcmp(this->username.data(), localUsername.data(), localUsernameLen) != 0)
 				{
 					return Authentication::UNAUTHORIZED;
 				}
@@ -461,8 +448,8 @@ namespace RTC
 			Utils::Byte::Set2Bytes(this->data, 2, static_cast<uint16_t>(this->size - 20 - 8));
 
 		// Calculate the HMAC-SHA1 of the message according to MESSAGE-INTEGRITY rules.
-		const uint8_t* computedMessageIntegrity = Utils::Crypto::GetHmacSha1(
-		  localPassword, this->data, (this->messageIntegrity - 4) - this->data);
+		const uint8_t* computedMessageIntegrity =
+		  localHmacSha1->Compute(this->data, (this->messageIntegrity - 4) - this->data);
 
 		Authentication result;
 
@@ -479,7 +466,7 @@ namespace RTC
 		return result;
 	}
 
-	StunPacket* StunPacket::CreateSuccessResponse()
+	StunPacket StunPacket::CreateSuccessResponse() const
 	{
 		MS_TRACE();
 
@@ -487,10 +474,10 @@ namespace RTC
 		  this->klass == Class::REQUEST,
 		  "attempt to create a success response for a non Request STUN packet");
 
-		return new StunPacket(Class::SUCCESS_RESPONSE, this->method, this->transactionId, nullptr, 0);
+		return StunPacket(Class::SUCCESS_RESPONSE, this->method, this->transactionId, nullptr, 0);
 	}
 
-	StunPacket* StunPacket::CreateErrorResponse(uint16_t errorCode)
+	StunPacket StunPacket::CreateErrorResponse(uint16_t errorCode) const
 	{
 		MS_TRACE();
 
@@ -498,15 +485,14 @@ namespace RTC
 		  this->klass == Class::REQUEST,
 		  "attempt to create an error response for a non Request STUN packet");
 
-		auto* response =
-		  new StunPacket(Class::ERROR_RESPONSE, this->method, this->transactionId, nullptr, 0);
+		StunPacket response(Class::ERROR_RESPONSE, this->method, this->transactionId, nullptr, 0);
 
-		response->SetErrorCode(errorCode);
+		response.SetErrorCode(errorCode);
 
 		return response;
 	}
 
-	void StunPacket::Authenticate(const std::string& password)
+	void StunPacket::Authenticate(Utils::Crypto::HmacSha1* hmacSha1)
 	{
 		// Just for Request, Indication and SuccessResponse messages.
 		if (this->klass == Class::ERROR_RESPONSE)
@@ -516,7 +502,7 @@ namespace RTC
 			return;
 		}
 
-		this->password = password;
+		this->hmacSha1 = hmacSha1;
 	}
 
 	void StunPacket::Serialize(uint8_t* buffer)
@@ -530,7 +516,7 @@ namespace RTC
 		  ((this->xorMappedAddress != nullptr) && this->method == StunPacket::Method::BINDING &&
 		   this->klass == Class::SUCCESS_RESPONSE);
 		bool addErrorCode        = ((this->errorCode != 0u) && this->klass == Class::ERROR_RESPONSE);
-		bool addMessageIntegrity = (this->klass != Class::ERROR_RESPONSE && !this->password.empty());
+		bool addMessageIntegrity = (this->klass != Class::ERROR_RESPONSE && this->hmacSha1 != nullptr);
 		bool addFingerprint{ true }; // Do always.
 
 		// Update data pointer.
@@ -621,7 +607,7 @@ namespace RTC
 		{
 			Utils::Byte::Set2Bytes(buffer, pos, static_cast<uint16_t>(Attribute::USERNAME));
 			Utils::Byte::Set2Bytes(buffer, pos + 2, static_cast<uint16_t>(this->username.length()));
-			std::memcpy(buffer + pos + 4, this->username.c_str(), this->username.length());
+			std::memcpy(buffer + pos + 4, this->username.data(), this->username.length());
 			pos += 4 + usernamePaddedLen;
 		}
 
@@ -763,8 +749,7 @@ namespace RTC
 				Utils::Byte::Set2Bytes(buffer, 2, static_cast<uint16_t>(this->size - 20 - 8));
 
 			// Calculate the HMAC-SHA1 of the packet according to MESSAGE-INTEGRITY rules.
-			const uint8_t* computedMessageIntegrity =
-			  Utils::Crypto::GetHmacSha1(this->password, buffer, pos);
+			const uint8_t* computedMessageIntegrity = this->hmacSha1->Compute(buffer, pos);
 
 			Utils::Byte::Set2Bytes(buffer, pos, static_cast<uint16_t>(Attribute::MESSAGE_INTEGRITY));
 			Utils::Byte::Set2Bytes(buffer, pos + 2, 20);
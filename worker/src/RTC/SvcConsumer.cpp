@@ -172,6 +172,21 @@ namespace RTC
 		jsonObject["producerScores"] = *this->producerRtpStreamScores;
 	}
 
+	void SvcConsumer::FillJsonRtpState(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		RTC::Consumer::FillJsonRtpStreamState(jsonObject, this->rtpStream, this->rtpSeqManager);
+	}
+
+	void SvcConsumer::SetRtpState(json& data)
+	{
+		MS_TRACE();
+
+		// This may throw.
+		RTC::Consumer::SetRtpStreamState(data, this->rtpStream, this->rtpSeqManager);
+	}
+
 	void SvcConsumer::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -267,6 +282,42 @@ namespace RTC
 		}
 	}
 
+	void SvcConsumer::SetLastNDowngraded(bool lastNDowngraded)
+	{
+		MS_TRACE();
+
+		if (lastNDowngraded == this->lastNDowngraded)
+			return;
+
+		this->lastNDowngraded = lastNDowngraded;
+
+		MS_DEBUG_DEV(
+		  "last-N downgrade %s [consumerId:%s]",
+		  lastNDowngraded ? "enabled" : "disabled",
+		  this->id.c_str());
+
+		if (IsActive())
+			MayChangeLayers(/*force*/ true);
+	}
+
+	void SvcConsumer::SetOverloadDowngraded(bool overloadDowngraded)
+	{
+		MS_TRACE();
+
+		if (overloadDowngraded == this->overloadDowngraded)
+			return;
+
+		this->overloadDowngraded = overloadDowngraded;
+
+		MS_DEBUG_DEV(
+		  "overload downgrade %s [consumerId:%s]",
+		  overloadDowngraded ? "enabled" : "disabled",
+		  this->id.c_str());
+
+		if (IsActive())
+			MayChangeLayers(/*force*/ true);
+	}
+
 	void SvcConsumer::ProducerRtpStream(RTC::RtpStream* rtpStream, uint32_t /*mappedSsrc*/)
 	{
 		MS_TRACE();
@@ -342,8 +393,8 @@ namespace RTC
 		// If already in the preferred layers, do nothing.
 		// clang-format off
 		if (
-			this->provisionalTargetSpatialLayer == this->preferredSpatialLayer &&
-			this->provisionalTargetTemporalLayer == this->preferredTemporalLayer
+			this->provisionalTargetSpatialLayer == GetEffectivePreferredSpatialLayer() &&
+			this->provisionalTargetTemporalLayer == GetEffectivePreferredTemporalLayer()
 		)
 		// clang-format on
 		{
@@ -430,7 +481,7 @@ namespace RTC
 			}
 
 			// If this is the preferred or higher spatial layer, take it and exit.
-			if (spatialLayer >= this->preferredSpatialLayer)
+			if (spatialLayer >= GetEffectivePreferredSpatialLayer())
 				break;
 		}
 
@@ -495,7 +546,7 @@ namespace RTC
 			if (
 				this->rtpStream->GetActiveMs() > BweDowngradeMinActiveMs &&
 				this->encodingContext->GetTargetSpatialLayer() < this->encodingContext->GetCurrentSpatialLayer() &&
-				this->encodingContext->GetCurrentSpatialLayer() <= this->preferredSpatialLayer
+				this->encodingContext->GetCurrentSpatialLayer() <= GetEffectivePreferredSpatialLayer()
 			)
 			// clang-format on
 			{
@@ -532,7 +583,8 @@ namespace RTC
 		return desiredBitrate;
 	}
 
-	void SvcConsumer::SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void SvcConsumer::SendRtpPacket(
+	  RTC::RtpPacket* packet, RTC::RtpRetransmissionCache* retransmissionCache)
 	{
 		MS_TRACE();
 
@@ -633,7 +685,7 @@ namespace RTC
 		}
 
 		// Process the packet.
-		if (this->rtpStream->ReceivePacket(packet, sharedPacket))
+		if (this->rtpStream->ReceivePacket(packet, retransmissionCache))
 		{
 			// Send the packet.
 			this->listener->OnConsumerSendRtpPacket(this, packet);
@@ -983,15 +1035,15 @@ namespace RTC
 
 			// If this is the preferred or higher spatial layer and has bitrate,
 			// take it and exit.
-			if (spatialLayer >= this->preferredSpatialLayer)
+			if (spatialLayer >= GetEffectivePreferredSpatialLayer())
 				break;
 		}
 
 		if (newTargetSpatialLayer != -1)
 		{
-			if (newTargetSpatialLayer == this->preferredSpatialLayer)
-				newTargetTemporalLayer = this->preferredTemporalLayer;
-			else if (newTargetSpatialLayer < this->preferredSpatialLayer)
+			if (newTargetSpatialLayer == GetEffectivePreferredSpatialLayer())
+				newTargetTemporalLayer = GetEffectivePreferredTemporalLayer();
+			else if (newTargetSpatialLayer < GetEffectivePreferredSpatialLayer())
 				newTargetTemporalLayer = this->rtpStream->GetTemporalLayers() - 1;
 			else
 				newTargetTemporalLayer = 0;
@@ -4,6 +4,8 @@
 #include "RTC/TcpConnection.hpp"
 #include "Logger.hpp"
 #include "Utils.hpp"
+#include "RTC/RTCP/Packet.hpp"
+#include "RTC/RtpPacket.hpp"
 #include <cstring> // std::memmove(), std::memcpy()
 
 namespace RTC
@@ -162,7 +164,10 @@ namespace RTC
 
 		uint8_t frameLen[2];
 
+		// Just RTP packets may be dropped if the connection cannot keep up.
+		bool droppable = !RTC::RTCP::Packet::IsRtcp(data, len) && RTC::RtpPacket::IsRtp(data, len);
+
 		Utils::Byte::Set2Bytes(frameLen, 0, len);
-		::TcpConnectionHandler::Write(frameLen, 2, data, len, cb);
+		::TcpConnectionHandler::Write(frameLen, 2, data, len, cb, droppable);
 	}
 } // namespace RTC
@@ -4,6 +4,7 @@
 #include "RTC/Transport.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "OverloadController.hpp"
 #include "Utils.hpp"
 #include "Channel/ChannelNotifier.hpp"
 #include "PayloadChannel/PayloadChannelNotifier.hpp"
@@ -315,6 +316,43 @@ namespace RTC
 		this->listener->OnTransportListenServerClosed(this);
 	}
 
+	void Transport::BulkRequestStarted()
+	{
+		MS_TRACE();
+
+		this->handlingBulkRequest = true;
+	}
+
+	void Transport::BulkRequestEnded()
+	{
+		MS_TRACE();
+
+		this->handlingBulkRequest = false;
+
+		if (!this->pendingBitrateDistribution)
+			return;
+
+		bool forceBitrate = this->pendingForceOutgoingDesiredBitrate;
+
+		this->pendingBitrateDistribution         = false;
+		this->pendingForceOutgoingDesiredBitrate = false;
+
+		DistributeAvailableOutgoingBitrate();
+		ComputeOutgoingDesiredBitrate(forceBitrate);
+	}
+
+	void Transport::SetOverloadDowngraded(bool overloadDowngraded)
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->mapConsumers)
+		{
+			auto* consumer = kv.second;
+
+			consumer->SetOverloadDowngraded(overloadDowngraded);
+		}
+	}
+
 	void Transport::FillJson(json& jsonObject) const
 	{
 		MS_TRACE();
@@ -892,6 +930,25 @@ namespace RTC
 					}
 				}
 
+				// rtpState is optional (given when continuing a Consumer of another
+				// worker).
+				auto jsonRtpStateIt = request->data.find("rtpState");
+
+				if (jsonRtpStateIt != request->data.end())
+				{
+					try
+					{
+						// This may throw.
+						consumer->SetRtpState(*jsonRtpStateIt);
+					}
+					catch (const MediaSoupError& error)
+					{
+						delete consumer;
+
+						throw;
+					}
+				}
+
 				// Notify the listener.
 				// This may throw if no Producer is found.
 				try
@@ -905,6 +962,10 @@ namespace RTC
 					throw;
 				}
 
+				// Start downgraded if the worker is already overloaded.
+				if (OverloadController::IsStepApplied(OverloadController::Step::LAYERS))
+					consumer->SetOverloadDowngraded(true);
+
 				// Insert into the maps.
 				this->mapConsumers[consumerId] = consumer;
 
@@ -1871,6 +1932,68 @@ namespace RTC
 		return consumer;
 	}
 
+	/**
+	 * Media and RTX SSRCs received by Producers (those already seen) and sent by
+	 * Consumers.
+	 */
+	void Transport::GetRtpStreamSsrcs(
+	  std::vector<uint32_t>& recvSsrcs, std::vector<uint32_t>& sendSsrcs) const
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->rtpListener.ssrcTable)
+		{
+			recvSsrcs.push_back(kv.first);
+		}
+
+		for (auto& kv : this->mapSsrcConsumer)
+		{
+			sendSsrcs.push_back(kv.first);
+		}
+
+		for (auto& kv : this->mapRtxSsrcConsumer)
+		{
+			sendSsrcs.push_back(kv.first);
+		}
+	}
+
+	/**
+	 * RTP state of Producers and Consumers indexed by their id, to be given to
+	 * those continuing them in another worker (see
+	 * WebRtcTransport::ExportState()).
+	 */
+	void Transport::FillJsonRtpState(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		jsonObject["producers"] = json::object();
+		auto jsonProducersIt    = jsonObject.find("producers");
+		jsonObject["consumers"] = json::object();
+		auto jsonConsumersIt    = jsonObject.find("consumers");
+
+		for (auto& kv : this->mapProducers)
+		{
+			auto* producer  = kv.second;
+			auto& jsonEntry = (*jsonProducersIt)[kv.first];
+
+			jsonEntry["rtpState"] = json::array();
+
+			producer->FillJsonRtpState(jsonEntry["rtpState"]);
+		}
+
+		for (auto& kv : this->mapConsumers)
+		{
+			auto* consumer  = kv.second;
+			auto& jsonEntry = (*jsonConsumersIt)[kv.first];
+
+			consumer->GetRtpParameters().FillJson(jsonEntry["rtpParameters"]);
+
+			jsonEntry["rtpState"] = json::object();
+
+			consumer->FillJsonRtpState(jsonEntry["rtpState"]);
+		}
+	}
+
 	void Transport::SetNewDataProducerIdFromInternal(json& internal, std::string& dataProducerId) const
 	{
 		MS_TRACE();
@@ -2656,7 +2779,7 @@ namespace RTC
 			sentInfo.sendingAtMs = DepLibUV::GetTimeMs();
 
 			auto* cb = new onSendCallback(
-			  [tccClient, &packetInfo, senderBwe, &sentInfo](bool sent)
+			  [tccClient, packetInfo, senderBwe, sentInfo](bool sent) mutable
 			  {
 				  if (sent)
 				  {
@@ -2671,7 +2794,7 @@ namespace RTC
 			SendRtpPacket(consumer, packet, cb);
 #else
 			const auto* cb = new onSendCallback(
-			  [tccClient, &packetInfo](bool sent)
+			  [tccClient, packetInfo](bool sent) mutable
 			  {
 				  if (sent)
 					  tccClient->PacketSent(packetInfo, DepLibUV::GetTimeMsInt64());
@@ -2728,7 +2851,7 @@ namespace RTC
 			sentInfo.sendingAtMs = DepLibUV::GetTimeMs();
 
 			auto* cb = new onSendCallback(
-			  [tccClient, &packetInfo, senderBwe, &sentInfo](bool sent)
+			  [tccClient, packetInfo, senderBwe, sentInfo](bool sent) mutable
 			  {
 				  if (sent)
 				  {
@@ -2743,7 +2866,7 @@ namespace RTC
 			SendRtpPacket(consumer, packet, cb);
 #else
 			const auto* cb = new onSendCallback(
-			  [tccClient, &packetInfo](bool sent)
+			  [tccClient, packetInfo](bool sent) mutable
 			  {
 				  if (sent)
 					  tccClient->PacketSent(packetInfo, DepLibUV::GetTimeMsInt64());
@@ -2780,6 +2903,13 @@ namespace RTC
 
 		MS_ASSERT(this->tccClient, "no TransportCongestionClient");
 
+		if (this->handlingBulkRequest)
+		{
+			this->pendingBitrateDistribution = true;
+
+			return;
+		}
+
 		DistributeAvailableOutgoingBitrate();
 		ComputeOutgoingDesiredBitrate();
 	}
@@ -2790,6 +2920,14 @@ namespace RTC
 
 		MS_ASSERT(this->tccClient, "no TransportCongestionClient");
 
+		if (this->handlingBulkRequest)
+		{
+			this->pendingBitrateDistribution         = true;
+			this->pendingForceOutgoingDesiredBitrate = true;
+
+			return;
+		}
+
 		DistributeAvailableOutgoingBitrate();
 
 		// This may be the latest active Consumer with BWE. If so we have to stop probation.
@@ -2830,6 +2968,13 @@ namespace RTC
 			ComputeOutgoingDesiredBitrate(/*forceBitrate*/ true);
 	}
 
+	inline void Transport::OnConsumerForwardedRtpStreamsChange(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		this->listener->OnTransportConsumerForwardedRtpStreamsChange(this, consumer);
+	}
+
 	inline void Transport::OnDataProducerMessageReceived(
 	  RTC::DataProducer* dataProducer, uint32_t ppid, const uint8_t* msg, size_t len)
 	{
@@ -3067,7 +3212,7 @@ namespace RTC
 			sentInfo.sendingAtMs = DepLibUV::GetTimeMs();
 
 			auto* cb = new onSendCallback(
-			  [tccClient, &packetInfo, senderBwe, &sentInfo](bool sent)
+			  [tccClient, packetInfo, senderBwe, sentInfo](bool sent) mutable
 			  {
 				  if (sent)
 				  {
@@ -3082,7 +3227,7 @@ namespace RTC
 			SendRtpPacket(nullptr, packet, cb);
 #else
 			const auto* cb = new onSendCallback(
-			  [tccClient, &packetInfo](bool sent)
+			  [tccClient, packetInfo](bool sent) mutable
 			  {
 				  if (sent)
 					  tccClient->PacketSent(packetInfo, DepLibUV::GetTimeMsInt64());
@@ -3109,6 +3254,30 @@ namespace RTC
 		  this->sendProbationTransmission.GetBitrate(DepLibUV::GetTimeMs()));
 	}
 
+	inline RTC::RtpPacket* Transport::OnTransportCongestionControlClientGetPaddingPacket(
+	  RTC::TransportCongestionControlClient* /*tccClient*/, size_t size)
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->mapConsumers)
+		{
+			auto* consumer = kv.second;
+
+			if (consumer->GetKind() != RTC::Media::Kind::VIDEO || !consumer->IsActive())
+				continue;
+
+			for (auto* rtpStream : consumer->GetRtpStreams())
+			{
+				auto* packet = rtpStream->GetRtxPaddingPacket(size);
+
+				if (packet)
+					return packet;
+			}
+		}
+
+		return nullptr;
+	}
+
 	inline void Transport::OnTransportCongestionControlServerSendRtcpPacket(
 	  RTC::TransportCongestionControlServer* /*tccServer*/, RTC::RTCP::Packet* packet)
 	{
@@ -3172,6 +3341,10 @@ namespace RTC
 					interval = RTC::RTCP::MaxVideoIntervalMs;
 			}
 
+			// Send RTCP less frequently while the worker is overloaded.
+			if (OverloadController::IsStepApplied(OverloadController::Step::RTCP))
+				interval *= 2;
+
 			/*
 			 * The interval between RTCP packets is varied randomly over the range
 			 * [0.5,1.5] times the calculated interval to avoid unintended synchronization
@@ -495,6 +495,13 @@ namespace RTC
 		MS_TRACE();
 		MS_ASSERT(this->probationGenerator, "probation generator not initialized")
 
+		// Prefer RTX copies of recently sent media, since they may also help the
+		// remote endpoint recovering losses.
+		auto* packet = this->listener->OnTransportCongestionControlClientGetPaddingPacket(this, size);
+
+		if (packet)
+			return packet;
+
 		return this->probationGenerator->GetNextPacket(size);
 	}
 
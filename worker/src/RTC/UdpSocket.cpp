@@ -2,12 +2,66 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "RTC/UdpSocket.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
 #include "RTC/PortManager.hpp"
 #include <string>
+#ifndef _WIN32
+#include <unistd.h> // close()
+#endif
 
 namespace RTC
 {
+	/* Static methods for UV callbacks. */
+
+	inline static void onClose(uv_handle_t* handle)
+	{
+		delete handle;
+	}
+
+	/* Static. */
+
+	static void CloseFd(int fd)
+	{
+#ifdef _WIN32
+		closesocket(static_cast<uv_os_sock_t>(fd));
+#else
+		close(fd);
+#endif
+	}
+
+	// The returned handle owns the given fd. If it throws the fd is closed.
+	static uv_udp_t* OpenUdp(int fd)
+	{
+		MS_TRACE();
+
+		int err;
+		auto* uvHandle = new uv_udp_t();
+
+		err = uv_udp_init(DepLibUV::GetLoop(), uvHandle);
+
+		if (err != 0)
+		{
+			delete uvHandle;
+			CloseFd(fd);
+
+			MS_THROW_ERROR("uv_udp_init() failed: %s", uv_strerror(err));
+		}
+
+		err = uv_udp_open(uvHandle, static_cast<uv_os_sock_t>(fd));
+
+		if (err != 0)
+		{
+			uv_close(reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onClose));
+			CloseFd(fd);
+
+			MS_THROW_ERROR("uv_udp_open() failed: %s", uv_strerror(err));
+		}
+
+		return uvHandle;
+	}
+
 	/* Instance methods. */
 
 	UdpSocket::UdpSocket(Listener* listener, std::string& ip)
@@ -18,10 +72,17 @@ namespace RTC
 		MS_TRACE();
 	}
 
-	UdpSocket::UdpSocket(Listener* listener, std::string& ip, uint16_t port)
+	UdpSocket::UdpSocket(Listener* listener, std::string& ip, uint16_t port, bool reusePort)
+	  : // This may throw.
+	    ::UdpSocketHandler::UdpSocketHandler(PortManager::BindUdp(ip, port, reusePort)),
+	    listener(listener), fixedPort(true)
+	{
+		MS_TRACE();
+	}
+
+	UdpSocket::UdpSocket(Listener* listener, int fd)
 	  : // This may throw.
-	    ::UdpSocketHandler::UdpSocketHandler(PortManager::BindUdp(ip, port)), listener(listener),
-	    fixedPort(true)
+	    ::UdpSocketHandler::UdpSocketHandler(OpenUdp(fd)), listener(listener), fixedPort(true)
 	{
 		MS_TRACE();
 	}
@@ -0,0 +1,252 @@
+#define MS_CLASS "RTC::UlpfecEncoder"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/UlpfecEncoder.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include "RTC/SeqManager.hpp"
+#include <cstring> // std::memcpy(), std::memset()
+
+namespace RTC
+{
+	/* Static. */
+
+	// RED primary block header.
+	static constexpr size_t RedHeaderLength{ 1u };
+	// FEC header plus the level 0 header with a short packet mask.
+	static constexpr size_t UlpfecHeaderLength{ 14u };
+
+	// Plain byte loop, so the compiler vectorizes it.
+	static inline void Xor(uint8_t* dst, const uint8_t* src, size_t len)
+	{
+		for (size_t i{ 0u }; i < len; ++i)
+		{
+			dst[i] ^= src[i];
+		}
+	}
+
+	/* Instance methods. */
+
+	UlpfecEncoder::UlpfecEncoder(uint8_t redPayloadType, uint8_t ulpfecPayloadType)
+	  : redPayloadType(redPayloadType), ulpfecPayloadType(ulpfecPayloadType)
+	{
+		MS_TRACE();
+
+		this->fecPackets.reserve(MaxFecPackets);
+	}
+
+	UlpfecEncoder::~UlpfecEncoder()
+	{
+		MS_TRACE();
+
+		ClearFecPackets();
+	}
+
+	/**
+	 * Called with every sent packet (RED or not). Returns the FEC packets to be
+	 * sent after it, if any.
+	 */
+	const std::vector<RTC::RtpPacket*>& UlpfecEncoder::AddPacket(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		ClearFecPackets();
+
+		if (packet->GetSize() > RTC::MtuSize)
+			return this->fecPackets;
+
+		auto seq = packet->GetSequenceNumber();
+
+		// Ignore retransmitted or reordered packets.
+		if (this->started && !RTC::SeqManager<uint16_t>::IsSeqHigherThan(seq, this->lastSeq))
+			return this->fecPackets;
+
+		this->started = true;
+		this->lastSeq = seq;
+
+		// Start a new group if the packet cannot be protected along with the
+		// previous ones.
+		// clang-format off
+		if (
+			this->numMediaPackets != 0u &&
+			static_cast<uint16_t>(seq - this->mediaPackets[0].seq) >= MaxMediaPackets
+		)
+		// clang-format on
+		{
+			this->numMediaPackets = 0u;
+		}
+
+		StoreMediaPacket(packet);
+
+		bool groupFull =
+		  static_cast<uint16_t>(seq - this->mediaPackets[0].seq) == MaxMediaPackets - 1u;
+
+		// Wait for the end of the frame unless no more packets fit into the group.
+		if (!packet->HasMarker() && !groupFull)
+			return this->fecPackets;
+
+		// Rounded down so FEC packets do not go beyond the protection factor.
+		auto numFecPackets = static_cast<size_t>(this->numMediaPackets * this->protectionFactor);
+
+		if (numFecPackets > this->numMediaPackets)
+			numFecPackets = this->numMediaPackets;
+
+		if (numFecPackets > MaxFecPackets)
+			numFecPackets = MaxFecPackets;
+
+		// Frames with few packets keep growing the group until a FEC packet is due.
+		if (numFecPackets == 0u)
+		{
+			if (groupFull)
+				this->numMediaPackets = 0u;
+
+			return this->fecPackets;
+		}
+
+		GenerateFecPackets(packet, numFecPackets);
+
+		this->numMediaPackets = 0u;
+
+		return this->fecPackets;
+	}
+
+	void UlpfecEncoder::Reset()
+	{
+		MS_TRACE();
+
+		this->numMediaPackets = 0u;
+		this->started         = false;
+	}
+
+	inline void UlpfecEncoder::StoreMediaPacket(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		auto& mediaPacket = this->mediaPackets[this->numMediaPackets++];
+		const auto* data  = packet->GetData();
+
+		mediaPacket.seq       = packet->GetSequenceNumber();
+		mediaPacket.byte0     = data[0];
+		mediaPacket.timestamp = packet->GetTimestamp();
+
+		// RED packets are protected as they are once unwrapped by the remote.
+		if (packet->GetPayloadType() == this->redPayloadType && packet->GetPayloadLength() != 0u)
+		{
+			const auto* payload = packet->GetPayload();
+			auto headerLength   = static_cast<size_t>(payload - data);
+			auto extraLength    = headerLength - RTC::RtpPacket::HeaderSize;
+
+			mediaPacket.byte1  = (data[1] & 0x80u) | (payload[0] & 0x7Fu);
+			mediaPacket.length = packet->GetSize() - RTC::RtpPacket::HeaderSize - RedHeaderLength;
+
+			// CSRCs and header extension, followed by the payload.
+			std::memcpy(mediaPacket.data, data + RTC::RtpPacket::HeaderSize, extraLength);
+			std::memcpy(
+			  mediaPacket.data + extraLength,
+			  payload + RedHeaderLength,
+			  packet->GetSize() - headerLength - RedHeaderLength);
+		}
+		else
+		{
+			mediaPacket.byte1  = data[1];
+			mediaPacket.length = packet->GetSize() - RTC::RtpPacket::HeaderSize;
+
+			std::memcpy(mediaPacket.data, data + RTC::RtpPacket::HeaderSize, mediaPacket.length);
+		}
+	}
+
+	void UlpfecEncoder::GenerateFecPackets(const RTC::RtpPacket* packet, size_t numFecPackets)
+	{
+		MS_TRACE();
+
+		auto baseSeq      = this->mediaPackets[0].seq;
+		auto headerLength =
+		  packet->GetSize() - packet->GetPayloadLength() - size_t{ packet->GetPayloadPadding() };
+
+		for (size_t i{ 0u }; i < numFecPackets; ++i)
+		{
+			uint16_t mask{ 0u };
+			uint8_t byte0{ 0u };
+			uint8_t byte1{ 0u };
+			uint32_t timestamp{ 0u };
+			uint16_t lengthRecovery{ 0u };
+			size_t protectionLength{ 0u };
+
+			// Packets of the group are interleaved among the FEC packets.
+			for (size_t j{ i }; j < this->numMediaPackets; j += numFecPackets)
+			{
+				const auto& mediaPacket = this->mediaPackets[j];
+
+				mask |= 0x8000u >> static_cast<uint16_t>(mediaPacket.seq - baseSeq);
+				byte0 ^= mediaPacket.byte0;
+				byte1 ^= mediaPacket.byte1;
+				timestamp ^= mediaPacket.timestamp;
+				lengthRecovery ^= static_cast<uint16_t>(mediaPacket.length);
+
+				if (mediaPacket.length > protectionLength)
+					protectionLength = mediaPacket.length;
+			}
+
+			auto payloadLength       = RedHeaderLength + UlpfecHeaderLength + protectionLength;
+			size_t paddedPayloadLength = Utils::Byte::PadTo4Bytes(static_cast<uint16_t>(payloadLength));
+
+			// The payload gets padded to 4 bytes.
+			if (headerLength + paddedPayloadLength > RTC::MtuSize)
+			{
+				MS_DEBUG_DEV("FEC packet too big [protectionLength:%zu]", protectionLength);
+
+				continue;
+			}
+
+			// FEC packets have the header (and header extensions) of the latest packet.
+			auto* fecPacket = packet->Clone(this->buffers[this->fecPackets.size()]);
+
+			fecPacket->SetPayloadDescriptorHandler(nullptr);
+			fecPacket->SetPayloadType(this->redPayloadType);
+			fecPacket->SetMarker(false);
+			fecPacket->SetSequenceNumber(
+			  packet->GetSequenceNumber() + 1u + static_cast<uint16_t>(this->fecPackets.size()));
+			fecPacket->SetPayloadLength(payloadLength);
+
+			auto* payload   = fecPacket->GetPayload();
+			auto* fecHeader = payload + RedHeaderLength;
+			auto* fecData   = fecHeader + UlpfecHeaderLength;
+
+			payload[0] = this->ulpfecPayloadType;
+
+			// FEC header (with E and L bits unset).
+			fecHeader[0] = byte0 & 0x3Fu;
+			fecHeader[1] = byte1;
+			Utils::Byte::Set2Bytes(fecHeader, 2, baseSeq);
+			Utils::Byte::Set4Bytes(fecHeader, 4, timestamp);
+			Utils::Byte::Set2Bytes(fecHeader, 8, lengthRecovery);
+
+			// Level 0 header.
+			Utils::Byte::Set2Bytes(fecHeader, 10, static_cast<uint16_t>(protectionLength));
+			Utils::Byte::Set2Bytes(fecHeader, 12, mask);
+
+			std::memset(fecData, 0, protectionLength);
+
+			for (size_t j{ i }; j < this->numMediaPackets; j += numFecPackets)
+			{
+				const auto& mediaPacket = this->mediaPackets[j];
+
+				Xor(fecData, mediaPacket.data, mediaPacket.length);
+			}
+
+			this->fecPackets.push_back(fecPacket);
+		}
+	}
+
+	inline void UlpfecEncoder::ClearFecPackets()
+	{
+		MS_TRACE();
+
+		for (auto* fecPacket : this->fecPackets)
+		{
+			delete fecPacket;
+		}
+
+		this->fecPackets.clear();
+	}
+} // namespace RTC
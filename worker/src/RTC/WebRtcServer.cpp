@@ -6,7 +6,8 @@
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
 #include "Channel/ChannelNotifier.hpp"
-#include <cmath> // std::pow()
+#include <cmath>   // std::pow()
+#include <cstring> // std::memchr()
 
 namespace RTC
 {
@@ -101,6 +102,14 @@ namespace RTC
 				MS_THROW_TYPE_ERROR("wrong listenInfo.port (not a positive number)");
 
 			listenInfo.port = jsonPortIt->get<uint16_t>();
+
+			auto jsonReusePortIt = jsonListenInfo.find("reusePort");
+
+			if (jsonReusePortIt != jsonListenInfo.end() && jsonReusePortIt->is_boolean())
+				listenInfo.reusePort = jsonReusePortIt->get<bool>();
+
+			if (listenInfo.reusePort && listenInfo.protocol != RTC::TransportTuple::Protocol::UDP)
+				MS_THROW_TYPE_ERROR("wrong listenInfo.reusePort (just valid for 'udp' protocol)");
 		}
 
 		try
@@ -110,9 +119,17 @@ namespace RTC
 				if (listenInfo.protocol == RTC::TransportTuple::Protocol::UDP)
 				{
 					// This may throw.
-					auto* udpSocket = new RTC::UdpSocket(this, listenInfo.ip, listenInfo.port);
+					auto* udpSocket =
+					  new RTC::UdpSocket(this, listenInfo.ip, listenInfo.port, listenInfo.reusePort);
 
 					this->udpSocketOrTcpServers.emplace_back(udpSocket, nullptr, listenInfo.announcedIp);
+
+					// Join the workers listening in the same IP and port.
+					if (listenInfo.reusePort)
+					{
+						// This may throw.
+						this->mapUdpSocketSharedUdpPort[udpSocket] = new RTC::SharedUdpPort(this, udpSocket);
+					}
 				}
 				else if (listenInfo.protocol == RTC::TransportTuple::Protocol::TCP)
 				{
@@ -127,6 +144,14 @@ namespace RTC
 		{
 			// Must delete everything since the destructor won't be called.
 
+			for (auto& kv : this->mapUdpSocketSharedUdpPort)
+			{
+				auto* sharedUdpPort = kv.second;
+
+				delete sharedUdpPort;
+			}
+			this->mapUdpSocketSharedUdpPort.clear();
+
 			for (auto& item : this->udpSocketOrTcpServers)
 			{
 				delete item.udpSocket;
@@ -145,6 +170,14 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		for (auto& kv : this->mapUdpSocketSharedUdpPort)
+		{
+			auto* sharedUdpPort = kv.second;
+
+			delete sharedUdpPort;
+		}
+		this->mapUdpSocketSharedUdpPort.clear();
+
 		for (auto& item : this->udpSocketOrTcpServers)
 		{
 			delete item.udpSocket;
@@ -186,8 +219,10 @@ namespace RTC
 
 				auto& jsonEntry = (*jsonUdpSocketsIt)[udpSocketIdx];
 
-				jsonEntry["ip"]   = item.udpSocket->GetLocalIp();
-				jsonEntry["port"] = item.udpSocket->GetLocalPort();
+				jsonEntry["ip"]        = item.udpSocket->GetLocalIp();
+				jsonEntry["port"]      = item.udpSocket->GetLocalPort();
+				jsonEntry["reusePort"] = this->mapUdpSocketSharedUdpPort.find(item.udpSocket) !=
+				                         this->mapUdpSocketSharedUdpPort.end();
 
 				++udpSocketIdx;
 			}
@@ -326,8 +361,8 @@ namespace RTC
 		return iceCandidates;
 	}
 
-	inline std::string WebRtcServer::GetLocalIceUsernameFragmentFromReceivedStunPacket(
-	  RTC::StunPacket* packet) const
+	inline absl::string_view WebRtcServer::GetLocalIceUsernameFragmentFromReceivedStunPacket(
+	  const RTC::StunPacket* packet) const
 	{
 		MS_TRACE();
 
@@ -336,14 +371,30 @@ namespace RTC
 		// local usernameFragment) which is the first value in the attribute value
 		// before the ":" symbol.
 
-		auto& username  = packet->GetUsername();
-		size_t colonPos = username.find(":");
+		auto username = packet->GetUsername();
+		const auto* colon =
+		  static_cast<const char*>(std::memchr(username.data(), ':', username.size()));
 
 		// If no colon is found just return the whole USERNAME attribute anyway.
-		if (colonPos == std::string::npos)
+		if (!colon)
 			return username;
 
-		return username.substr(0, colonPos);
+		return { username.data(), static_cast<size_t>(colon - username.data()) };
+	}
+
+	inline RTC::SharedUdpPort* WebRtcServer::GetSharedUdpPort(const RTC::TransportTuple* tuple) const
+	{
+		MS_TRACE();
+
+		if (tuple->GetProtocol() != RTC::TransportTuple::Protocol::UDP)
+			return nullptr;
+
+		auto it = this->mapUdpSocketSharedUdpPort.find(tuple->GetUdpSocket());
+
+		if (it == this->mapUdpSocketSharedUdpPort.end())
+			return nullptr;
+
+		return it->second;
 	}
 
 	inline void WebRtcServer::OnPacketReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
@@ -364,9 +415,9 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		RTC::StunPacket* packet = RTC::StunPacket::Parse(data, len);
+		RTC::StunPacket packet;
 
-		if (!packet)
+		if (!RTC::StunPacket::Parse(data, len, packet))
 		{
 			MS_WARN_TAG(ice, "ignoring wrong STUN packet received");
 
@@ -380,31 +431,39 @@ namespace RTC
 		{
 			auto* webRtcTransport = it1->second;
 
-			webRtcTransport->ProcessStunPacketFromWebRtcServer(tuple, packet);
-
-			delete packet;
+			webRtcTransport->ProcessStunPacketFromWebRtcServer(tuple, std::addressof(packet));
 
 			return;
 		}
 
-		// Otherwise try to match the local ICE username fragment.
-		auto key = GetLocalIceUsernameFragmentFromReceivedStunPacket(packet);
+		// Otherwise try to match the local ICE username fragment (no need to
+		// allocate a std::string for the lookup).
+		auto key = GetLocalIceUsernameFragmentFromReceivedStunPacket(std::addressof(packet));
 		auto it2 = this->mapLocalIceUsernameFragmentWebRtcTransport.find(key);
 
 		if (it2 == this->mapLocalIceUsernameFragmentWebRtcTransport.end())
 		{
-			MS_WARN_TAG(ice, "ignoring received STUN packet with unknown remote ICE usernameFragment");
+			// It may belong to another worker listening in the same IP and port.
+			auto* sharedUdpPort = GetSharedUdpPort(tuple);
+
+			// clang-format off
+			if (
+				sharedUdpPort &&
+				sharedUdpPort->ForwardStunPacket(key, tuple->hash, data, len, tuple->GetRemoteAddress())
+			)
+			// clang-format on
+			{
+				return;
+			}
 
-			delete packet;
+			MS_WARN_TAG(ice, "ignoring received STUN packet with unknown remote ICE usernameFragment");
 
 			return;
 		}
 
 		auto* webRtcTransport = it2->second;
 
-		webRtcTransport->ProcessStunPacketFromWebRtcServer(tuple, packet);
-
-		delete packet;
+		webRtcTransport->ProcessStunPacketFromWebRtcServer(tuple, std::addressof(packet));
 	}
 
 	inline void WebRtcServer::OnNonStunDataReceived(
@@ -416,6 +475,19 @@ namespace RTC
 
 		if (it == this->mapTupleWebRtcTransport.end())
 		{
+			// It may belong to another worker listening in the same IP and port.
+			auto* sharedUdpPort = GetSharedUdpPort(tuple);
+
+			// clang-format off
+			if (
+				sharedUdpPort &&
+				sharedUdpPort->ForwardNonStunPacket(tuple->hash, data, len, tuple->GetRemoteAddress())
+			)
+			// clang-format on
+			{
+				return;
+			}
+
 			MS_WARN_TAG(ice, "ignoring received non STUN data from unknown tuple");
 
 			return;
@@ -459,6 +531,13 @@ namespace RTC
 		  "local ICE username fragment already exists in the table");
 
 		this->mapLocalIceUsernameFragmentWebRtcTransport[usernameFragment] = webRtcTransport;
+
+		for (auto& kv : this->mapUdpSocketSharedUdpPort)
+		{
+			auto* sharedUdpPort = kv.second;
+
+			sharedUdpPort->AddLocalIceUsernameFragment(usernameFragment);
+		}
 	}
 
 	inline void WebRtcServer::OnWebRtcTransportLocalIceUsernameFragmentRemoved(
@@ -472,6 +551,13 @@ namespace RTC
 		  "local ICE username fragment not found in the table");
 
 		this->mapLocalIceUsernameFragmentWebRtcTransport.erase(usernameFragment);
+
+		for (auto& kv : this->mapUdpSocketSharedUdpPort)
+		{
+			auto* sharedUdpPort = kv.second;
+
+			sharedUdpPort->RemoveLocalIceUsernameFragment(usernameFragment);
+		}
 	}
 
 	inline void WebRtcServer::OnWebRtcTransportTransportTupleAdded(
@@ -487,6 +573,11 @@ namespace RTC
 		}
 
 		this->mapTupleWebRtcTransport[tuple->hash] = webRtcTransport;
+
+		auto* sharedUdpPort = GetSharedUdpPort(tuple);
+
+		if (sharedUdpPort)
+			sharedUdpPort->AddTuple(tuple->hash);
 	}
 
 	inline void WebRtcServer::OnWebRtcTransportTransportTupleRemoved(
@@ -502,6 +593,11 @@ namespace RTC
 		}
 
 		this->mapTupleWebRtcTransport.erase(tuple->hash);
+
+		auto* sharedUdpPort = GetSharedUdpPort(tuple);
+
+		if (sharedUdpPort)
+			sharedUdpPort->RemoveTuple(tuple->hash);
 	}
 
 	inline void WebRtcServer::OnUdpSocketPacketReceived(
@@ -514,6 +610,21 @@ namespace RTC
 		OnPacketReceived(&tuple, data, len);
 	}
 
+	inline void WebRtcServer::OnSharedUdpPortPacketReceived(
+	  RTC::SharedUdpPort* sharedUdpPort,
+	  const uint8_t* data,
+	  size_t len,
+	  const struct sockaddr* remoteAddr)
+	{
+		MS_TRACE();
+
+		// Packet received by another worker. Process it as if it was received by
+		// our UdpSocket in the same IP and port so responses are sent from it.
+		RTC::TransportTuple tuple(sharedUdpPort->GetUdpSocket(), remoteAddr);
+
+		OnPacketReceived(&tuple, data, len);
+	}
+
 	inline void WebRtcServer::OnRtcTcpConnectionClosed(
 	  RTC::TcpServer* /*tcpServer*/, RTC::TcpConnection* connection)
 	{
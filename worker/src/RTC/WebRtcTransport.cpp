@@ -6,7 +6,12 @@
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
 #include "Channel/ChannelNotifier.hpp"
+#include <absl/container/flat_hash_map.h>
+#include <openssl/crypto.h>
 #include <cmath> // std::pow()
+#ifndef _WIN32
+#include <unistd.h> // close()
+#endif
 
 namespace RTC
 {
@@ -26,13 +31,42 @@ namespace RTC
 		       std::pow(2, 0) * (256 - IceComponent);
 	}
 
+	// clang-format off
+	static absl::flat_hash_map<std::string, RTC::SrtpSession::CryptoSuite> string2SrtpCryptoSuite =
+	{
+		{ "AEAD_AES_256_GCM",        RTC::SrtpSession::CryptoSuite::AEAD_AES_256_GCM        },
+		{ "AEAD_AES_128_GCM",        RTC::SrtpSession::CryptoSuite::AEAD_AES_128_GCM        },
+		{ "AES_CM_128_HMAC_SHA1_80", RTC::SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_80 },
+		{ "AES_CM_128_HMAC_SHA1_32", RTC::SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_32 }
+	};
+	static absl::flat_hash_map<RTC::SrtpSession::CryptoSuite, std::string> srtpCryptoSuite2String =
+	{
+		{ RTC::SrtpSession::CryptoSuite::AEAD_AES_256_GCM,        "AEAD_AES_256_GCM"        },
+		{ RTC::SrtpSession::CryptoSuite::AEAD_AES_128_GCM,        "AEAD_AES_128_GCM"        },
+		{ RTC::SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_80, "AES_CM_128_HMAC_SHA1_80" },
+		{ RTC::SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_32, "AES_CM_128_HMAC_SHA1_32" }
+	};
+	// clang-format on
+
 	/* Instance methods. */
 
-	WebRtcTransport::WebRtcTransport(const std::string& id, RTC::Transport::Listener* listener, json& data)
+	WebRtcTransport::WebRtcTransport(
+	  const std::string& id, RTC::Transport::Listener* listener, json& data, FdImporter* fdImporter)
 	  : RTC::Transport::Transport(id, listener, data)
 	{
 		MS_TRACE();
 
+		auto jsonImportStateIt = data.find("importState");
+
+		// Continue the session of a WebRtcTransport exported by another worker.
+		if (jsonImportStateIt != data.end())
+		{
+			// This may throw.
+			ImportState(*jsonImportStateIt, fdImporter);
+
+			return;
+		}
+
 		bool enableUdp{ true };
 		auto jsonEnableUdpIt = data.find("enableUdp");
 
@@ -654,6 +688,23 @@ namespace RTC
 				break;
 			}
 
+			case Channel::ChannelRequest::MethodId::TRANSPORT_EXPORT_STATE:
+			{
+				auto jsonSocketPathIt = request->data.find("socketPath");
+
+				if (jsonSocketPathIt == request->data.end() || !jsonSocketPathIt->is_string())
+					MS_THROW_TYPE_ERROR("missing socketPath");
+
+				json data = json::object();
+
+				// This may throw.
+				ExportState(jsonSocketPathIt->get<std::string>(), data);
+
+				request->Accept(data);
+
+				break;
+			}
+
 			default:
 			{
 				// Pass it to the parent class.
@@ -715,12 +766,574 @@ namespace RTC
 		this->iceServer->RemoveTuple(tuple);
 	}
 
+	/**
+	 * Restores the ICE, DTLS and SRTP state exported by a WebRtcTransport in
+	 * another worker (see ExportState()) so the remote endpoint does not notice
+	 * the migration. Its UDP sockets are taken from the given FdImporter, to
+	 * which that worker has already sent them.
+	 */
+	void WebRtcTransport::ImportState(json& jsonImportState, FdImporter* fdImporter)
+	{
+		MS_TRACE();
+
+		if (!jsonImportState.is_object())
+			MS_THROW_TYPE_ERROR("wrong importState (not an object)");
+		else if (this->sctpAssociation)
+			MS_THROW_TYPE_ERROR("cannot import state with SCTP enabled");
+		else if (!fdImporter)
+			MS_THROW_ERROR("no FdImporter given");
+
+		auto jsonIceParametersIt = jsonImportState.find("iceParameters");
+
+		if (jsonIceParametersIt == jsonImportState.end() || !jsonIceParametersIt->is_object())
+			MS_THROW_TYPE_ERROR("missing importState.iceParameters");
+
+		auto jsonUsernameFragmentIt = jsonIceParametersIt->find("usernameFragment");
+
+		// clang-format off
+		if (
+			jsonUsernameFragmentIt == jsonIceParametersIt->end() ||
+			!jsonUsernameFragmentIt->is_string()
+		)
+		// clang-format on
+		{
+			MS_THROW_TYPE_ERROR("missing importState.iceParameters.usernameFragment");
+		}
+
+		auto jsonPasswordIt = jsonIceParametersIt->find("password");
+
+		if (jsonPasswordIt == jsonIceParametersIt->end() || !jsonPasswordIt->is_string())
+			MS_THROW_TYPE_ERROR("missing importState.iceParameters.password");
+
+		RTC::IceServer::IceState iceState;
+		auto jsonIceStateIt = jsonImportState.find("iceState");
+
+		if (jsonIceStateIt == jsonImportState.end() || !jsonIceStateIt->is_string())
+			MS_THROW_TYPE_ERROR("missing importState.iceState");
+		else if (jsonIceStateIt->get<std::string>() == "connected")
+			iceState = RTC::IceServer::IceState::CONNECTED;
+		else if (jsonIceStateIt->get<std::string>() == "completed")
+			iceState = RTC::IceServer::IceState::COMPLETED;
+		else
+			MS_THROW_TYPE_ERROR("invalid importState.iceState");
+
+		auto jsonUdpSocketsIt = jsonImportState.find("udpSockets");
+
+		if (jsonUdpSocketsIt == jsonImportState.end())
+			MS_THROW_TYPE_ERROR("missing importState.udpSockets");
+		else if (!jsonUdpSocketsIt->is_array())
+			MS_THROW_TYPE_ERROR("wrong importState.udpSockets (not an array)");
+		else if (jsonUdpSocketsIt->empty())
+			MS_THROW_TYPE_ERROR("wrong importState.udpSockets (empty array)");
+		else if (jsonUdpSocketsIt->size() > 8)
+			MS_THROW_TYPE_ERROR("wrong importState.udpSockets (too many sockets)");
+
+		std::vector<std::string> announcedIps(jsonUdpSocketsIt->size());
+
+		for (size_t i{ 0 }; i < jsonUdpSocketsIt->size(); ++i)
+		{
+			auto& jsonUdpSocket = (*jsonUdpSocketsIt)[i];
+
+			if (!jsonUdpSocket.is_object())
+				MS_THROW_TYPE_ERROR("wrong importState.udpSockets entry (not an object)");
+
+			auto jsonAnnouncedIpIt = jsonUdpSocket.find("announcedIp");
+
+			if (jsonAnnouncedIpIt != jsonUdpSocket.end())
+			{
+				if (!jsonAnnouncedIpIt->is_string())
+					MS_THROW_TYPE_ERROR("wrong udpSocket.announcedIp (not an string)");
+
+				announcedIps[i] = jsonAnnouncedIpIt->get<std::string>();
+			}
+		}
+
+		auto jsonSelectedTupleIt = jsonImportState.find("iceSelectedTuple");
+
+		if (jsonSelectedTupleIt == jsonImportState.end() || !jsonSelectedTupleIt->is_object())
+			MS_THROW_TYPE_ERROR("missing importState.iceSelectedTuple");
+
+		auto jsonSocketIndexIt = jsonSelectedTupleIt->find("socketIndex");
+
+		// clang-format off
+		if (
+			jsonSocketIndexIt == jsonSelectedTupleIt->end() ||
+			!Utils::Json::IsPositiveInteger(*jsonSocketIndexIt) ||
+			jsonSocketIndexIt->get<size_t>() >= jsonUdpSocketsIt->size()
+		)
+		// clang-format on
+		{
+			MS_THROW_TYPE_ERROR("wrong importState.iceSelectedTuple.socketIndex");
+		}
+
+		auto socketIndex = jsonSocketIndexIt->get<size_t>();
+
+		auto jsonRemoteIpIt = jsonSelectedTupleIt->find("remoteIp");
+
+		if (jsonRemoteIpIt == jsonSelectedTupleIt->end() || !jsonRemoteIpIt->is_string())
+			MS_THROW_TYPE_ERROR("missing importState.iceSelectedTuple.remoteIp");
+
+		auto jsonRemotePortIt = jsonSelectedTupleIt->find("remotePort");
+
+		// clang-format off
+		if (
+			jsonRemotePortIt == jsonSelectedTupleIt->end() ||
+			!Utils::Json::IsPositiveInteger(*jsonRemotePortIt)
+		)
+		// clang-format on
+		{
+			MS_THROW_TYPE_ERROR("missing importState.iceSelectedTuple.remotePort");
+		}
+
+		auto remoteIp   = jsonRemoteIpIt->get<std::string>();
+		auto remotePort = jsonRemotePortIt->get<uint16_t>();
+		struct sockaddr_storage remoteAddrStorage; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		int err;
+
+		switch (Utils::IP::GetFamily(remoteIp))
+		{
+			case AF_INET:
+			{
+				err = uv_ip4_addr(
+				  remoteIp.c_str(),
+				  static_cast<int>(remotePort),
+				  reinterpret_cast<struct sockaddr_in*>(&remoteAddrStorage));
+
+				if (err != 0)
+					MS_THROW_ERROR("uv_ip4_addr() failed: %s", uv_strerror(err));
+
+				break;
+			}
+
+			case AF_INET6:
+			{
+				err = uv_ip6_addr(
+				  remoteIp.c_str(),
+				  static_cast<int>(remotePort),
+				  reinterpret_cast<struct sockaddr_in6*>(&remoteAddrStorage));
+
+				if (err != 0)
+					MS_THROW_ERROR("uv_ip6_addr() failed: %s", uv_strerror(err));
+
+				break;
+			}
+
+			default:
+			{
+				MS_THROW_TYPE_ERROR("invalid importState.iceSelectedTuple.remoteIp");
+			}
+		}
+
+		auto jsonDtlsLocalRoleIt = jsonImportState.find("dtlsLocalRole");
+
+		if (jsonDtlsLocalRoleIt == jsonImportState.end() || !jsonDtlsLocalRoleIt->is_string())
+			MS_THROW_TYPE_ERROR("missing importState.dtlsLocalRole");
+
+		auto dtlsLocalRole = RTC::DtlsTransport::StringToRole(jsonDtlsLocalRoleIt->get<std::string>());
+
+		// clang-format off
+		if (
+			dtlsLocalRole != RTC::DtlsTransport::Role::CLIENT &&
+			dtlsLocalRole != RTC::DtlsTransport::Role::SERVER
+		)
+		// clang-format on
+		{
+			MS_THROW_TYPE_ERROR("invalid importState.dtlsLocalRole");
+		}
+
+		auto jsonSrtpParametersIt = jsonImportState.find("srtpParameters");
+
+		if (jsonSrtpParametersIt == jsonImportState.end() || !jsonSrtpParametersIt->is_object())
+			MS_THROW_TYPE_ERROR("missing importState.srtpParameters");
+
+		auto jsonCryptoSuiteIt = jsonSrtpParametersIt->find("cryptoSuite");
+
+		if (jsonCryptoSuiteIt == jsonSrtpParametersIt->end() || !jsonCryptoSuiteIt->is_string())
+			MS_THROW_TYPE_ERROR("missing importState.srtpParameters.cryptoSuite");
+
+		auto cryptoSuiteIt = string2SrtpCryptoSuite.find(jsonCryptoSuiteIt->get<std::string>());
+
+		if (cryptoSuiteIt == string2SrtpCryptoSuite.end())
+			MS_THROW_TYPE_ERROR("invalid importState.srtpParameters.cryptoSuite");
+
+		auto srtpCryptoSuite = cryptoSuiteIt->second;
+
+		auto jsonLocalKeyIt  = jsonSrtpParametersIt->find("localKeyBase64");
+		auto jsonRemoteKeyIt = jsonSrtpParametersIt->find("remoteKeyBase64");
+
+		// clang-format off
+		if (
+			jsonLocalKeyIt == jsonSrtpParametersIt->end() ||
+			!jsonLocalKeyIt->is_string() ||
+			jsonRemoteKeyIt == jsonSrtpParametersIt->end() ||
+			!jsonRemoteKeyIt->is_string()
+		)
+		// clang-format on
+		{
+			MS_THROW_TYPE_ERROR("missing importState.srtpParameters keys");
+		}
+
+		// SRTP stream states (may be missing if there are no streams yet).
+		std::vector<RTC::SrtpSession::StreamState> recvStreams;
+		std::vector<RTC::SrtpSession::StreamState> sendStreams;
+
+		auto parseStreams = [&jsonImportState](
+		                      const char* key, std::vector<RTC::SrtpSession::StreamState>& streams) {
+			auto jsonStreamsIt = jsonImportState.find(key);
+
+			if (jsonStreamsIt == jsonImportState.end())
+				return;
+			else if (!jsonStreamsIt->is_array())
+				MS_THROW_TYPE_ERROR("wrong importState.%s (not an array)", key);
+
+			for (auto& jsonStream : *jsonStreamsIt)
+			{
+				if (!jsonStream.is_object())
+					MS_THROW_TYPE_ERROR("wrong importState.%s entry (not an object)", key);
+
+				auto jsonSsrcIt      = jsonStream.find("ssrc");
+				auto jsonRocIt       = jsonStream.find("roc");
+				auto jsonRtcpIndexIt = jsonStream.find("rtcpIndex");
+
+				// clang-format off
+				if (
+					jsonSsrcIt == jsonStream.end() ||
+					!Utils::Json::IsPositiveInteger(*jsonSsrcIt) ||
+					jsonRocIt == jsonStream.end() ||
+					!Utils::Json::IsPositiveInteger(*jsonRocIt) ||
+					jsonRtcpIndexIt == jsonStream.end() ||
+					!Utils::Json::IsPositiveInteger(*jsonRtcpIndexIt)
+				)
+				// clang-format on
+				{
+					MS_THROW_TYPE_ERROR("wrong importState.%s entry", key);
+				}
+
+				RTC::SrtpSession::StreamState state;
+
+				state.ssrc      = jsonSsrcIt->get<uint32_t>();
+				state.roc       = jsonRocIt->get<uint32_t>();
+				state.rtcpIndex = jsonRtcpIndexIt->get<uint32_t>();
+
+				streams.push_back(state);
+			}
+		};
+
+		// These may throw.
+		parseStreams("recvStreams", recvStreams);
+		parseStreams("sendStreams", sendStreams);
+
+		// Take the UDP sockets sent by the exporting worker.
+		// This may throw.
+		auto fds = fdImporter->Import(announcedIps.size());
+		size_t numOwnedFds{ 0 };
+		std::vector<RTC::UdpSocket*> udpSockets;
+
+		try
+		{
+			uint16_t iceLocalPreferenceDecrement{ 0 };
+
+			this->iceCandidates.reserve(fds.size());
+
+			for (size_t i{ 0 }; i < fds.size(); ++i)
+			{
+				uint16_t iceLocalPreference =
+				  IceCandidateDefaultLocalPriority - iceLocalPreferenceDecrement;
+				uint32_t icePriority = generateIceCandidatePriority(iceLocalPreference);
+
+				// The UdpSocket owns the fd even if it throws.
+				++numOwnedFds;
+
+				// This may throw.
+				auto* udpSocket = new RTC::UdpSocket(this, fds[i]);
+
+				udpSockets.push_back(udpSocket);
+				this->udpSockets[udpSocket] = announcedIps[i];
+
+				if (announcedIps[i].empty())
+					this->iceCandidates.emplace_back(udpSocket, icePriority);
+				else
+					this->iceCandidates.emplace_back(udpSocket, icePriority, announcedIps[i]);
+
+				iceLocalPreferenceDecrement += 100;
+			}
+
+			// Create a ICE server with same credentials.
+			this->iceServer = new RTC::IceServer(
+			  this, jsonUsernameFragmentIt->get<std::string>(), jsonPasswordIt->get<std::string>());
+
+			// Create a DTLS transport.
+			this->dtlsTransport = new RTC::DtlsTransport(this);
+
+			size_t keyLen;
+			auto masterLength = RTC::SrtpSession::GetMasterLength(srtpCryptoSuite);
+			// This may throw.
+			auto* key = Utils::String::Base64Decode(jsonLocalKeyIt->get<std::string>(), keyLen);
+
+			if (keyLen != masterLength)
+				MS_THROW_TYPE_ERROR("invalid decoded SRTP local key length");
+
+			// NOTE: SrtpSession copies the key.
+			this->srtpSendSession = new RTC::SrtpSession(
+			  RTC::SrtpSession::Type::OUTBOUND, srtpCryptoSuite, key, keyLen, sendStreams);
+
+			// Don't leave the key in the decode buffer.
+			OPENSSL_cleanse(key, keyLen);
+
+			// This may throw.
+			key = Utils::String::Base64Decode(jsonRemoteKeyIt->get<std::string>(), keyLen);
+
+			if (keyLen != masterLength)
+				MS_THROW_TYPE_ERROR("invalid decoded SRTP remote key length");
+
+			this->srtpRecvSession = new RTC::SrtpSession(
+			  RTC::SrtpSession::Type::INBOUND, srtpCryptoSuite, key, keyLen, recvStreams);
+
+			OPENSSL_cleanse(key, keyLen);
+
+			RTC::TransportTuple tuple(
+			  udpSockets[socketIndex], reinterpret_cast<struct sockaddr*>(&remoteAddrStorage));
+
+			this->iceServer->ImportSelectedTuple(&tuple, iceState);
+			this->dtlsTransport->SetConnected(dtlsLocalRole);
+
+			this->dtlsRole      = dtlsLocalRole;
+			this->connectCalled = true;
+		}
+		catch (const MediaSoupError& error)
+		{
+			// Must delete everything since the destructor won't be called.
+
+#ifndef _WIN32
+			for (size_t i{ numOwnedFds }; i < fds.size(); ++i)
+			{
+				close(fds[i]);
+			}
+#endif
+
+			delete this->srtpSendSession;
+			this->srtpSendSession = nullptr;
+
+			delete this->srtpRecvSession;
+			this->srtpRecvSession = nullptr;
+
+			delete this->dtlsTransport;
+			this->dtlsTransport = nullptr;
+
+			delete this->iceServer;
+			this->iceServer = nullptr;
+
+			for (auto& kv : this->udpSockets)
+			{
+				auto* udpSocket = kv.first;
+
+				delete udpSocket;
+			}
+			this->udpSockets.clear();
+
+			this->iceCandidates.clear();
+
+			throw;
+		}
+
+		MS_DEBUG_TAG(ice, "state imported [id:%s]", this->id.c_str());
+
+		// Tell the parent class.
+		RTC::Transport::Connected();
+	}
+
+	/**
+	 * Fills the state to be given to a WebRtcTransport created in another worker
+	 * (see ImportState()) and sends the UDP sockets to the FdImporter listening
+	 * on the given path in that worker. This transport stops receiving and
+	 * sending and it should be closed once the new one is created.
+	 *
+	 * Producers and Consumers are created again in the new transport by the app,
+	 * given the RTP state of their streams (and Consumer SeqManagers) filled
+	 * here, so the remote endpoint sees the same RTP streams.
+	 *
+	 * SRTP keys are not kept, they are derived again from the DTLS association,
+	 * so a WebRtcTransport created with an exported state cannot be exported.
+	 */
+	void WebRtcTransport::ExportState(const std::string& socketPath, json& data)
+	{
+		MS_TRACE();
+
+		if (this->exported)
+			MS_THROW_ERROR("state already exported");
+		else if (this->webRtcTransportListener)
+			MS_THROW_ERROR("cannot export state of a WebRtcTransport using a WebRtcServer");
+		else if (this->sctpAssociation)
+			MS_THROW_ERROR("cannot export state with SCTP enabled");
+		else if (!this->tcpServers.empty())
+			MS_THROW_ERROR("cannot export state with TCP enabled");
+		else if (!IsConnected() || !this->srtpSendSession || !this->srtpRecvSession)
+			MS_THROW_ERROR("not connected");
+
+		auto* selectedTuple = this->iceServer->GetSelectedTuple();
+
+		if (selectedTuple->GetProtocol() != RTC::TransportTuple::Protocol::UDP)
+			MS_THROW_ERROR("selected tuple is not UDP");
+
+		// SRTP keys are not kept, so derive them again from the DTLS association.
+		auto srtpCryptoSuite = this->srtpSendSession->GetCryptoSuite();
+		auto masterLength    = RTC::SrtpSession::GetMasterLength(srtpCryptoSuite);
+		std::vector<uint8_t> localKey(masterLength);
+		std::vector<uint8_t> remoteKey(masterLength);
+
+		if (!this->dtlsTransport->GetSrtpKeys(srtpCryptoSuite, localKey.data(), remoteKey.data()))
+			MS_THROW_ERROR("cannot export state of an imported WebRtcTransport");
+
+		std::vector<int> fds;
+
+		fds.reserve(this->udpSockets.size());
+
+		// Add udpSockets and iceSelectedTuple.
+		data["udpSockets"]       = json::array();
+		auto jsonUdpSocketsIt    = data.find("udpSockets");
+		data["iceSelectedTuple"] = json::object();
+		auto jsonSelectedTupleIt = data.find("iceSelectedTuple");
+
+		try
+		{
+			for (auto& kv : this->udpSockets)
+			{
+				auto* udpSocket   = kv.first;
+				auto& announcedIp = kv.second;
+
+				if (selectedTuple->GetLocalAddress() == udpSocket->GetLocalAddress())
+					(*jsonSelectedTupleIt)["socketIndex"] = fds.size();
+
+				// This may throw.
+				fds.push_back(udpSocket->DupFd());
+
+				jsonUdpSocketsIt->emplace_back(json::value_t::object);
+
+				auto& jsonEntry = jsonUdpSocketsIt->back();
+
+				jsonEntry["ip"]   = udpSocket->GetLocalIp();
+				jsonEntry["port"] = udpSocket->GetLocalPort();
+
+				if (!announcedIp.empty())
+					jsonEntry["announcedIp"] = announcedIp;
+			}
+
+			// This may throw.
+			FdImporter::Export(socketPath, fds);
+		}
+		catch (const MediaSoupError& error)
+		{
+#ifndef _WIN32
+			for (auto fd : fds)
+			{
+				close(fd);
+			}
+#endif
+
+			OPENSSL_cleanse(localKey.data(), localKey.size());
+			OPENSSL_cleanse(remoteKey.data(), remoteKey.size());
+
+			throw;
+		}
+
+		// The importing worker has its own copies of them now.
+#ifndef _WIN32
+		for (auto fd : fds)
+		{
+			close(fd);
+		}
+#endif
+
+		int family;
+		std::string remoteIp;
+		uint16_t remotePort;
+
+		Utils::IP::GetAddressInfo(selectedTuple->GetRemoteAddress(), family, remoteIp, remotePort);
+
+		(*jsonSelectedTupleIt)["remoteIp"]   = remoteIp;
+		(*jsonSelectedTupleIt)["remotePort"] = remotePort;
+
+		data["socketPath"] = socketPath;
+
+		// Add iceParameters.
+		data["iceParameters"]    = json::object();
+		auto jsonIceParametersIt = data.find("iceParameters");
+
+		(*jsonIceParametersIt)["usernameFragment"] = this->iceServer->GetUsernameFragment();
+		(*jsonIceParametersIt)["password"]         = this->iceServer->GetPassword();
+
+		// Add iceState.
+		if (this->iceServer->GetState() == RTC::IceServer::IceState::COMPLETED)
+			data["iceState"] = "completed";
+		else
+			data["iceState"] = "connected";
+
+		// Add dtlsLocalRole.
+		if (this->dtlsTransport->GetLocalRole() == RTC::DtlsTransport::Role::CLIENT)
+			data["dtlsLocalRole"] = "client";
+		else
+			data["dtlsLocalRole"] = "server";
+
+		// Add srtpParameters.
+		data["srtpParameters"]    = json::object();
+		auto jsonSrtpParametersIt = data.find("srtpParameters");
+
+		(*jsonSrtpParametersIt)["cryptoSuite"] = srtpCryptoSuite2String[srtpCryptoSuite];
+		(*jsonSrtpParametersIt)["localKeyBase64"] =
+		  Utils::String::Base64Encode(localKey.data(), localKey.size());
+		(*jsonSrtpParametersIt)["remoteKeyBase64"] =
+		  Utils::String::Base64Encode(remoteKey.data(), remoteKey.size());
+
+		OPENSSL_cleanse(localKey.data(), localKey.size());
+		OPENSSL_cleanse(remoteKey.data(), remoteKey.size());
+
+		// Add recvStreams and sendStreams.
+		std::vector<uint32_t> recvSsrcs;
+		std::vector<uint32_t> sendSsrcs;
+
+		GetRtpStreamSsrcs(recvSsrcs, sendSsrcs);
+
+		data["recvStreams"] = json::array();
+		data["sendStreams"] = json::array();
+
+		for (auto& state : this->srtpRecvSession->GetStreamStates(recvSsrcs))
+		{
+			data["recvStreams"].push_back(
+			  { { "ssrc", state.ssrc }, { "roc", state.roc }, { "rtcpIndex", state.rtcpIndex } });
+		}
+
+		for (auto& state : this->srtpSendSession->GetStreamStates(sendSsrcs))
+		{
+			data["sendStreams"].push_back(
+			  { { "ssrc", state.ssrc }, { "roc", state.roc }, { "rtcpIndex", state.rtcpIndex } });
+		}
+
+		// Add producers and consumers.
+		FillJsonRtpState(data);
+
+		// From now on the new WebRtcTransport owns the session.
+		this->exported = true;
+
+		for (auto& kv : this->udpSockets)
+		{
+			auto* udpSocket = kv.first;
+
+			udpSocket->StopReceiving();
+		}
+
+		MS_DEBUG_TAG(ice, "state exported [id:%s]", this->id.c_str());
+
+		// Tell the parent class.
+		RTC::Transport::Disconnected();
+	}
+
 	inline bool WebRtcTransport::IsConnected() const
 	{
 		MS_TRACE();
 
 		// clang-format off
 		return (
+			!this->exported &&
 			(
 				this->iceServer->GetState() == RTC::IceServer::IceState::CONNECTED ||
 				this->iceServer->GetState() == RTC::IceServer::IceState::COMPLETED
@@ -1005,9 +1618,9 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		RTC::StunPacket* packet = RTC::StunPacket::Parse(data, len);
+		RTC::StunPacket packet;
 
-		if (!packet)
+		if (!RTC::StunPacket::Parse(data, len, packet))
 		{
 			MS_WARN_DEV("ignoring wrong STUN packet received");
 
@@ -1015,9 +1628,7 @@ namespace RTC
 		}
 
 		// Pass it to the IceServer.
-		this->iceServer->ProcessStunPacket(packet, tuple);
-
-		delete packet;
+		this->iceServer->ProcessStunPacket(std::addressof(packet), tuple);
 	}
 
 	inline void WebRtcTransport::OnDtlsDataReceived(
@@ -1457,6 +2068,11 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// The remote endpoint is now served by the WebRtcTransport that imported
+		// our state (i.e. don't send it a DTLS close alert).
+		if (this->exported)
+			return;
+
 		if (!this->iceServer->GetSelectedTuple())
 		{
 			MS_WARN_TAG(dtls, "no selected tuple set, cannot send DTLS packet");
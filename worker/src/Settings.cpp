@@ -4,6 +4,7 @@
 #include "Settings.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "OverloadController.hpp"
 #include "Utils.hpp"
 #include <cctype>   // isprint()
 #include <iterator> // std::ostream_iterator
@@ -52,17 +53,26 @@ void Settings::SetConfiguration(int argc, char* argv[])
 	// clang-format off
 	struct option options[] =
 	{
-		{ "logLevel",            optional_argument, nullptr, 'l' },
-		{ "logTags",             optional_argument, nullptr, 't' },
-		{ "rtcMinPort",          optional_argument, nullptr, 'm' },
-		{ "rtcMaxPort",          optional_argument, nullptr, 'M' },
-		{ "dtlsCertificateFile", optional_argument, nullptr, 'c' },
-		{ "dtlsPrivateKeyFile",  optional_argument, nullptr, 'p' },
+		{ "logLevel",                      optional_argument, nullptr, 'l' },
+		{ "logTags",                       optional_argument, nullptr, 't' },
+		{ "rtcMinPort",                    optional_argument, nullptr, 'm' },
+		{ "rtcMaxPort",                    optional_argument, nullptr, 'M' },
+		{ "dtlsCertificateFile",           optional_argument, nullptr, 'c' },
+		{ "dtlsPrivateKeyFile",            optional_argument, nullptr, 'p' },
+		{ "retransmissionBufferMaxMemory", optional_argument, nullptr, 'r' },
+		{ "dtlsHandshakeThreads",          optional_argument, nullptr, 'd' },
+		{ "useIoUring",                    optional_argument, nullptr, 'u' },
+		{ "overloadLoopLagThreshold",      optional_argument, nullptr, 'o' },
+		{ "overloadLoopBusyThreshold",     optional_argument, nullptr, 'b' },
+		{ "overloadDegradationSteps",      optional_argument, nullptr, 's' },
+		{ "udpSocketPoolSize",             optional_argument, nullptr, 'U' },
+		{ "logRingSize",                   optional_argument, nullptr, 'R' },
 		{ nullptr, 0, nullptr, 0 }
 	};
 	// clang-format on
 	std::string stringValue;
 	std::vector<std::string> logTags;
+	std::vector<std::string> overloadDegradationSteps;
 
 	/* Parse command line options. */
 
@@ -138,6 +148,151 @@ void Settings::SetConfiguration(int argc, char* argv[])
 				break;
 			}
 
+			case 'r':
+			{
+				int64_t value{ 0 };
+
+				try
+				{
+					value = std::stoll(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				SetRetransmissionBufferMaxMemory(value);
+
+				break;
+			}
+
+			case 'd':
+			{
+				int value{ 0 };
+
+				try
+				{
+					value = std::stoi(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (value < 0 || value > 64)
+					MS_THROW_TYPE_ERROR("dtlsHandshakeThreads must be between 0 and 64");
+
+				Settings::configuration.dtlsHandshakeThreads = static_cast<uint16_t>(value);
+
+				break;
+			}
+
+			case 'u':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue == "true")
+					Settings::configuration.useIoUring = true;
+				else if (stringValue == "false")
+					Settings::configuration.useIoUring = false;
+				else
+					MS_THROW_TYPE_ERROR("useIoUring must be true or false");
+
+				break;
+			}
+
+			case 'o':
+			{
+				int64_t value{ 0 };
+
+				try
+				{
+					value = std::stoll(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (value < 0 || value > 60000)
+					MS_THROW_TYPE_ERROR("overloadLoopLagThreshold must be between 0 and 60000");
+
+				Settings::configuration.overloadLoopLagThreshold = static_cast<uint32_t>(value);
+
+				break;
+			}
+
+			case 'b':
+			{
+				int value{ 0 };
+
+				try
+				{
+					value = std::stoi(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (value < 1 || value > 100)
+					MS_THROW_TYPE_ERROR("overloadLoopBusyThreshold must be between 1 and 100");
+
+				Settings::configuration.overloadLoopBusyThreshold = static_cast<uint8_t>(value);
+
+				break;
+			}
+
+			case 's':
+			{
+				stringValue = std::string(optarg);
+				overloadDegradationSteps.push_back(stringValue);
+
+				break;
+			}
+
+			case 'U':
+			{
+				int value{ 0 };
+
+				try
+				{
+					value = std::stoi(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (value < 0 || value > 1024)
+					MS_THROW_TYPE_ERROR("udpSocketPoolSize must be between 0 and 1024");
+
+				Settings::configuration.udpSocketPoolSize = static_cast<uint16_t>(value);
+
+				break;
+			}
+
+			case 'R':
+			{
+				int value{ 0 };
+
+				try
+				{
+					value = std::stoi(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (value < 0 || value > 65536)
+					MS_THROW_TYPE_ERROR("logRingSize must be between 0 and 65536");
+
+				Settings::configuration.logRingSize = static_cast<uint32_t>(value);
+
+				break;
+			}
+
 			// Invalid option.
 			case '?':
 			{
@@ -167,6 +322,10 @@ void Settings::SetConfiguration(int argc, char* argv[])
 	if (!logTags.empty())
 		Settings::SetLogTags(logTags);
 
+	// Set overloadDegradationSteps.
+	if (!overloadDegradationSteps.empty())
+		Settings::SetOverloadDegradationSteps(overloadDegradationSteps);
+
 	// Validate RTC ports.
 	if (Settings::configuration.rtcMaxPort < Settings::configuration.rtcMinPort)
 		MS_THROW_TYPE_ERROR("rtcMaxPort cannot be less than rtcMinPort");
@@ -232,6 +391,36 @@ void Settings::PrintConfiguration()
 		MS_DEBUG_TAG(
 		  info, "  dtlsPrivateKeyFile  : %s", Settings::configuration.dtlsPrivateKeyFile.c_str());
 	}
+	MS_DEBUG_TAG(
+	  info,
+	  "  retransmissionBufferMaxMemory : %zu",
+	  Settings::configuration.retransmissionBufferMaxMemory);
+	MS_DEBUG_TAG(
+	  info, "  dtlsHandshakeThreads : %" PRIu16, Settings::configuration.dtlsHandshakeThreads);
+	MS_DEBUG_TAG(info, "  useIoUring : %s", Settings::configuration.useIoUring ? "true" : "false");
+	MS_DEBUG_TAG(
+	  info, "  udpSocketPoolSize : %" PRIu16, Settings::configuration.udpSocketPoolSize);
+	MS_DEBUG_TAG(info, "  logRingSize : %" PRIu32, Settings::configuration.logRingSize);
+	if (Settings::configuration.overloadLoopLagThreshold != 0u)
+	{
+		std::ostringstream overloadDegradationStepsStream;
+
+		std::copy(
+		  Settings::configuration.overloadDegradationSteps.begin(),
+		  Settings::configuration.overloadDegradationSteps.end(),
+		  std::ostream_iterator<std::string>(overloadDegradationStepsStream, " "));
+
+		MS_DEBUG_TAG(
+		  info,
+		  "  overloadLoopLagThreshold : %" PRIu32,
+		  Settings::configuration.overloadLoopLagThreshold);
+		MS_DEBUG_TAG(
+		  info,
+		  "  overloadLoopBusyThreshold : %" PRIu8,
+		  Settings::configuration.overloadLoopBusyThreshold);
+		MS_DEBUG_TAG(
+		  info, "  overloadDegradationSteps : %s", overloadDegradationStepsStream.str().c_str());
+	}
 
 	MS_DEBUG_TAG(info, "</configuration>");
 }
@@ -246,6 +435,8 @@ void Settings::HandleRequest(Channel::ChannelRequest* request)
 		{
 			auto jsonLogLevelIt = request->data.find("logLevel");
 			auto jsonLogTagsIt  = request->data.find("logTags");
+			auto jsonRetransmissionBufferMaxMemoryIt =
+			  request->data.find("retransmissionBufferMaxMemory");
 
 			// Update logLevel if requested.
 			if (jsonLogLevelIt != request->data.end() && jsonLogLevelIt->is_string())
@@ -270,6 +461,16 @@ void Settings::HandleRequest(Channel::ChannelRequest* request)
 				Settings::SetLogTags(logTags);
 			}
 
+			// Update retransmissionBufferMaxMemory if requested.
+			if (
+			  jsonRetransmissionBufferMaxMemoryIt != request->data.end() &&
+			  jsonRetransmissionBufferMaxMemoryIt->is_number_integer())
+			{
+				// This may throw.
+				Settings::SetRetransmissionBufferMaxMemory(
+				  jsonRetransmissionBufferMaxMemoryIt->get<int64_t>());
+			}
+
 			// Print the new effective configuration.
 			Settings::PrintConfiguration();
 
@@ -382,3 +583,29 @@ void Settings::SetDtlsCertificateAndPrivateKeyFiles()
 		MS_THROW_TYPE_ERROR("dtlsPrivateKeyFile: %s", error.what());
 	}
 }
+
+void Settings::SetRetransmissionBufferMaxMemory(int64_t value)
+{
+	MS_TRACE();
+
+	if (value < 0)
+		MS_THROW_TYPE_ERROR("invalid negative value for retransmissionBufferMaxMemory");
+
+	Settings::configuration.retransmissionBufferMaxMemory = static_cast<size_t>(value);
+}
+
+void Settings::SetOverloadDegradationSteps(const std::vector<std::string>& steps)
+{
+	MS_TRACE();
+
+	for (const auto& step : steps)
+	{
+		if (OverloadController::string2Step.find(step) == OverloadController::string2Step.end())
+			MS_THROW_TYPE_ERROR("invalid value '%s' for overloadDegradationSteps", step.c_str());
+
+		if (std::count(steps.begin(), steps.end(), step) > 1)
+			MS_THROW_TYPE_ERROR("duplicated value '%s' in overloadDegradationSteps", step.c_str());
+	}
+
+	Settings::configuration.overloadDegradationSteps = steps;
+}
@@ -109,4 +109,66 @@ namespace Utils
 
 		return Crypto::hmacSha1Buffer;
 	}
+
+	/* Instance methods. */
+
+	Crypto::HmacSha1::HmacSha1()
+	{
+		MS_TRACE();
+
+		this->ctx = EVP_MAC_CTX_new(Crypto::mac);
+
+		MS_ASSERT(this->ctx, "OpenSSL EVP_MAC_CTX_new() failed");
+	}
+
+	Crypto::HmacSha1::~HmacSha1()
+	{
+		MS_TRACE();
+
+		EVP_MAC_CTX_free(this->ctx);
+	}
+
+	void Crypto::HmacSha1::SetKey(const std::string& key)
+	{
+		MS_TRACE();
+
+		int ret;
+
+		OSSL_PARAM sha1[] = { { "digest", OSSL_PARAM_UTF8_STRING, (void*)"sha1", 4, 0 }, OSSL_PARAM_END };
+
+		ret = EVP_MAC_init(
+		  this->ctx, reinterpret_cast<const unsigned char*>(key.c_str()), key.length(), sha1);
+
+		MS_ASSERT(ret == 1, "OpenSSL EVP_MAC_init() failed with key '%s'", key.c_str());
+
+		this->hasKey = true;
+	}
+
+	const uint8_t* Crypto::HmacSha1::Compute(const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(this->hasKey, "no key set");
+
+		int ret;
+
+		// Reset the context while keeping the already processed key.
+		ret = EVP_MAC_init(this->ctx, nullptr, 0, nullptr);
+
+		MS_ASSERT(ret == 1, "OpenSSL EVP_MAC_init() failed");
+
+		ret = EVP_MAC_update(this->ctx, data, len);
+
+		MS_ASSERT(ret == 1, "OpenSSL EVP_MAC_update() failed with data length %zu bytes", len);
+
+		size_t resultLen;
+
+		ret = EVP_MAC_final(this->ctx, Crypto::hmacSha1Buffer, &resultLen, SHA_DIGEST_LENGTH);
+
+		MS_ASSERT(ret == 1, "OpenSSL EVP_MAC_final() failed with data length %zu bytes", len);
+		MS_ASSERT(
+		  resultLen == SHA_DIGEST_LENGTH, "OpenSSL EVP_MAC_final() resultLen is %zu instead of 20", resultLen);
+
+		return Crypto::hmacSha1Buffer;
+	}
 } // namespace Utils
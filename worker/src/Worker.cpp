@@ -8,6 +8,8 @@
 #include "MediaSoupErrors.hpp"
 #include "Settings.hpp"
 #include "Channel/ChannelNotifier.hpp"
+#include "RTC/PortManager.hpp"
+#include "RTC/RtpRetransmissionCache.hpp"
 
 /* Instance methods. */
 
@@ -36,6 +38,27 @@ Worker::Worker(::Channel::ChannelSocket* channel, PayloadChannel::PayloadChannel
 	// Create the Checker instance in DepUsrSCTP.
 	DepUsrSCTP::CreateChecker();
 
+	// Log through the LogRing if enabled.
+	if (Settings::configuration.logRingSize != 0u)
+		Logger::StartRing(Settings::configuration.logRingSize);
+
+	// Create the OverloadController if enabled.
+	if (Settings::configuration.overloadLoopLagThreshold != 0u)
+	{
+		std::vector<OverloadController::Step> steps;
+
+		for (const auto& step : Settings::configuration.overloadDegradationSteps)
+		{
+			steps.push_back(OverloadController::string2Step[step]);
+		}
+
+		this->overloadController = new OverloadController(
+		  this,
+		  Settings::configuration.overloadLoopLagThreshold,
+		  Settings::configuration.overloadLoopBusyThreshold,
+		  steps);
+	}
+
 	// Tell the Node process that we are running.
 	Channel::ChannelNotifier::Emit(Logger::pid, "running");
 
@@ -64,6 +87,9 @@ void Worker::Close()
 	// Delete the SignalsHandler.
 	delete this->signalsHandler;
 
+	// Delete the OverloadController.
+	delete this->overloadController;
+
 	// Delete all Routers.
 	for (auto& kv : this->mapRouters)
 	{
@@ -82,9 +108,15 @@ void Worker::Close()
 	}
 	this->mapWebRtcServers.clear();
 
+	// Close the pre-bound UDP sockets.
+	RTC::PortManager::CloseUdpSocketPools();
+
 	// Close the Checker instance in DepUsrSCTP.
 	DepUsrSCTP::CloseChecker();
 
+	// Send pending logs and stop the LogRing.
+	Logger::StopRing();
+
 	// Close the Channel.
 	this->channel->Close();
 
@@ -183,6 +215,13 @@ void Worker::FillJsonResourceUsage(json& jsonObject) const
 
 	// Add ru_nivcsw (uint64_t, involuntary context switches).
 	jsonObject["ru_nivcsw"] = uvRusage.ru_nivcsw;
+
+	// Add retransmissionBufferMemory (memory used by RTP retransmission buffers).
+	jsonObject["retransmissionBufferMemory"] = RTC::RtpRetransmissionCache::GetTotalMemory();
+
+	// Add retransmissionBufferEvictedPackets (packets evicted due to memory limit).
+	jsonObject["retransmissionBufferEvictedPackets"] =
+	  RTC::RtpRetransmissionCache::GetEvictedPacketCount();
 }
 
 void Worker::SetNewWebRtcServerIdFromInternal(json& internal, std::string& webRtcServerId) const
@@ -575,3 +614,29 @@ inline RTC::WebRtcServer* Worker::OnRouterNeedWebRtcServer(
 
 	return webRtcServer;
 }
+
+inline void Worker::OnOverloadControllerLevelChange(
+  OverloadController* overloadController, size_t /*previousLevel*/)
+{
+	MS_TRACE();
+
+	bool layersDowngraded = OverloadController::IsStepApplied(OverloadController::Step::LAYERS);
+
+	if (layersDowngraded != this->layersDowngraded)
+	{
+		this->layersDowngraded = layersDowngraded;
+
+		for (auto& kv : this->mapRouters)
+		{
+			auto* router = kv.second;
+
+			router->SetOverloadDowngraded(layersDowngraded);
+		}
+	}
+
+	json data = json::object();
+
+	overloadController->FillJson(data);
+
+	Channel::ChannelNotifier::Emit(Logger::pid, "overloadstatechange", data);
+}
@@ -0,0 +1,320 @@
+#define MS_CLASS "FdImporter"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "handles/FdImporter.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include <cerrno>
+#include <cstdlib> // mkdtemp()
+#include <cstring> // std::memset(), std::memcpy(), std::strerror()
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/* Static. */
+
+// Max number of fds that can be passed.
+static constexpr size_t MaxFds{ 64u };
+
+#ifndef _WIN32
+static void fillAddress(const std::string& path, struct sockaddr_un& addr)
+{
+	if (path.size() >= sizeof(addr.sun_path))
+		MS_THROW_TYPE_ERROR("path too long");
+
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	std::memcpy(addr.sun_path, path.c_str(), path.size());
+}
+
+static bool setNonBlocking(int fd)
+{
+	int flags = fcntl(fd, F_GETFL, 0);
+
+	return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Whether the process at the other end of the given Unix socket runs as the
+// same user as this one.
+static bool isPeerSameUser(int fd)
+{
+#ifdef SO_PEERCRED
+	struct ucred cred; // NOLINT(cppcoreguidelines-pro-type-member-init)
+	socklen_t len = sizeof(cred);
+
+	if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0)
+		return false;
+
+	return cred.uid == geteuid();
+#else
+	uid_t uid;
+	gid_t gid;
+
+	if (getpeereid(fd, &uid, &gid) != 0)
+		return false;
+
+	return uid == geteuid();
+#endif
+}
+#endif
+
+/* Class methods. */
+
+#ifdef _WIN32
+void FdImporter::Export(const std::string& /*path*/, const std::vector<int>& /*fds*/)
+{
+	MS_TRACE();
+
+	MS_THROW_ERROR("not supported on Windows");
+}
+#else
+void FdImporter::Export(const std::string& path, const std::vector<int>& fds)
+{
+	MS_TRACE();
+
+	if (fds.empty() || fds.size() > MaxFds)
+		MS_THROW_TYPE_ERROR("invalid number of fds [numFds:%zu]", fds.size());
+
+	struct sockaddr_un addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	// This may throw.
+	fillAddress(path, addr);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (fd < 0)
+		MS_THROW_ERROR("socket() failed: %s", std::strerror(errno));
+
+	// Never wait for the importing worker. Its socket is listening so connect()
+	// completes at once and the fds fit in the socket buffer.
+	// clang-format off
+	if (
+		!setNonBlocking(fd) ||
+		connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0
+	)
+	// clang-format on
+	{
+		int error = errno;
+
+		close(fd);
+
+		MS_THROW_ERROR("connect() failed: %s", std::strerror(error));
+	}
+
+	if (!isPeerSameUser(fd))
+	{
+		close(fd);
+
+		MS_THROW_ERROR("FdImporter run by another user");
+	}
+
+	uint8_t byte{ 0u };
+	struct iovec iov; // NOLINT(cppcoreguidelines-pro-type-member-init)
+	struct msghdr msg; // NOLINT(cppcoreguidelines-pro-type-member-init)
+	alignas(struct cmsghdr) uint8_t control[CMSG_SPACE(sizeof(int) * MaxFds)];
+	size_t fdsLen = sizeof(int) * fds.size();
+
+	iov.iov_base = &byte;
+	iov.iov_len  = 1u;
+
+	std::memset(&msg, 0, sizeof(msg));
+	std::memset(control, 0, sizeof(control));
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1u;
+	msg.msg_control    = control;
+	msg.msg_controllen = CMSG_SPACE(fdsLen);
+
+	struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type  = SCM_RIGHTS;
+	cmsg->cmsg_len   = CMSG_LEN(fdsLen);
+	std::memcpy(CMSG_DATA(cmsg), fds.data(), fdsLen);
+
+	if (sendmsg(fd, &msg, 0) < 0)
+	{
+		int error = errno;
+
+		close(fd);
+
+		MS_THROW_ERROR("sendmsg() failed: %s", std::strerror(error));
+	}
+
+	// The fds in flight stay open after closing the socket.
+	close(fd);
+
+	MS_DEBUG_TAG(rtp, "%zu fds exported [path:%s]", fds.size(), path.c_str());
+}
+#endif
+
+/* Instance methods. */
+
+#ifdef _WIN32
+FdImporter::FdImporter()
+{
+	MS_TRACE();
+
+	MS_THROW_ERROR("not supported on Windows");
+}
+#else
+FdImporter::FdImporter()
+{
+	MS_TRACE();
+
+	// mkdtemp() creates the directory with 0700 permissions, so just this user
+	// can connect to the socket in it.
+	char dirPath[] = "/tmp/mediasoup-XXXXXX";
+
+	if (!mkdtemp(dirPath))
+		MS_THROW_ERROR("mkdtemp() failed: %s", std::strerror(errno));
+
+	this->dirPath = dirPath;
+	this->path    = this->dirPath + "/fds.sock";
+
+	struct sockaddr_un addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	fillAddress(this->path, addr);
+
+	this->listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (this->listenFd < 0)
+	{
+		int error = errno;
+
+		Close();
+
+		MS_THROW_ERROR("socket() failed: %s", std::strerror(error));
+	}
+
+	// Import() must not wait for a connection.
+	// clang-format off
+	if (
+		!setNonBlocking(this->listenFd) ||
+		bind(this->listenFd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 ||
+		chmod(this->path.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+		listen(this->listenFd, 1) != 0
+	)
+	// clang-format on
+	{
+		int error = errno;
+
+		Close();
+
+		MS_THROW_ERROR("cannot listen on Unix socket: %s", std::strerror(error));
+	}
+}
+#endif
+
+FdImporter::~FdImporter()
+{
+	MS_TRACE();
+
+	Close();
+}
+
+#ifdef _WIN32
+std::vector<int> FdImporter::Import(size_t /*numFds*/)
+{
+	MS_TRACE();
+
+	MS_THROW_ERROR("not supported on Windows");
+}
+#else
+std::vector<int> FdImporter::Import(size_t numFds)
+{
+	MS_TRACE();
+
+	if (numFds == 0u || numFds > MaxFds)
+		MS_THROW_TYPE_ERROR("invalid number of fds [numFds:%zu]", numFds);
+
+	int fd = accept(this->listenFd, nullptr, nullptr);
+
+	if (fd < 0)
+	{
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			MS_THROW_ERROR("no fds exported to this FdImporter");
+		else
+			MS_THROW_ERROR("accept() failed: %s", std::strerror(errno));
+	}
+
+	if (!isPeerSameUser(fd))
+	{
+		close(fd);
+
+		MS_THROW_ERROR("fds exported by another user");
+	}
+
+	uint8_t byte;
+	struct iovec iov; // NOLINT(cppcoreguidelines-pro-type-member-init)
+	struct msghdr msg; // NOLINT(cppcoreguidelines-pro-type-member-init)
+	alignas(struct cmsghdr) uint8_t control[CMSG_SPACE(sizeof(int) * MaxFds)];
+
+	iov.iov_base = &byte;
+	iov.iov_len  = 1u;
+
+	std::memset(&msg, 0, sizeof(msg));
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1u;
+	msg.msg_control    = control;
+	msg.msg_controllen = CMSG_SPACE(sizeof(int) * numFds);
+
+	// Export() completed before the connection was accepted, so the data is
+	// already here.
+	ssize_t ret = recvmsg(fd, &msg, MSG_DONTWAIT);
+	int error   = errno;
+
+	close(fd);
+
+	if (ret <= 0)
+		MS_THROW_ERROR("recvmsg() failed: %s", ret == 0 ? "connection closed" : std::strerror(error));
+
+	std::vector<int> fds;
+	struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+
+	if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+	{
+		size_t received = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+
+		fds.resize(received);
+		std::memcpy(fds.data(), CMSG_DATA(cmsg), received * sizeof(int));
+	}
+
+	if (fds.size() != numFds || (msg.msg_flags & MSG_CTRUNC))
+	{
+		for (auto receivedFd : fds)
+		{
+			close(receivedFd);
+		}
+
+		MS_THROW_ERROR("wrong number of fds received [expected:%zu, received:%zu]", numFds, fds.size());
+	}
+
+	MS_DEBUG_TAG(rtp, "%zu fds imported [path:%s]", fds.size(), this->path.c_str());
+
+	return fds;
+}
+#endif
+
+void FdImporter::Close()
+{
+	MS_TRACE();
+
+#ifndef _WIN32
+	if (this->listenFd >= 0)
+	{
+		close(this->listenFd);
+
+		this->listenFd = -1;
+	}
+
+	if (!this->path.empty())
+		unlink(this->path.c_str());
+
+	if (!this->dirPath.empty())
+		rmdir(this->dirPath.c_str());
+#endif
+}
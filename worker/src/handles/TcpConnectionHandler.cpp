@@ -6,7 +6,16 @@
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
-#include <cstring> // std::memcpy()
+#include <algorithm> // std::min()
+#include <cstring>   // std::memcpy()
+#include <utility>   // std::move()
+
+/* Static. */
+
+// Max bytes queued in a connection while a previous write is in progress.
+// Once exceeded, droppable data is dropped and, if still exceeded, the
+// connection is closed.
+static constexpr size_t MaxPendingDataSize{ 131072u };
 
 /* Static methods for UV callbacks. */
 
@@ -40,6 +49,14 @@ inline static void onWrite(uv_write_t* req, int status)
 	delete writeData;
 }
 
+inline static void onCheck(uv_check_t* handle)
+{
+	auto* connection = static_cast<TcpConnectionHandler*>(handle->data);
+
+	if (connection)
+		connection->OnUvCheck();
+}
+
 inline static void onClose(uv_handle_t* handle)
 {
 	delete handle;
@@ -87,16 +104,39 @@ void TcpConnectionHandler::Close()
 
 	int err;
 
+	// Write queued data so it's sent before the shutdown.
+	if (!this->hasError && !this->isClosedByPeer)
+		SendPendingData();
+	else
+		DiscardPendingData();
+
 	this->closed = true;
 
 	// Tell the UV handle that the TcpConnectionHandler has been closed.
 	this->uvHandle->data = nullptr;
 
+	// Close the check handle.
+	if (this->uvCheckHandle)
+	{
+		this->uvCheckHandle->data = nullptr;
+
+		uv_close(reinterpret_cast<uv_handle_t*>(this->uvCheckHandle), static_cast<uv_close_cb>(onClose));
+	}
+
 	// Don't read more.
-	err = uv_read_stop(reinterpret_cast<uv_stream_t*>(this->uvHandle));
+	if (this->ioUringRecvId != 0u)
+	{
+		DepIoUring::StopRecv(this->ioUringRecvId);
 
-	if (err != 0)
-		MS_ABORT("uv_read_stop() failed: %s", uv_strerror(err));
+		this->ioUringRecvId = 0u;
+	}
+	else
+	{
+		err = uv_read_stop(reinterpret_cast<uv_stream_t*>(this->uvHandle));
+
+		if (err != 0)
+			MS_ABORT("uv_read_stop() failed: %s", uv_strerror(err));
+	}
 
 	// If there is no error and the peer didn't close its connection side then close gracefully.
 	if (!this->hasError && !this->isClosedByPeer)
@@ -145,6 +185,20 @@ void TcpConnectionHandler::Setup(
 		MS_THROW_ERROR("uv_tcp_init() failed: %s", uv_strerror(err));
 	}
 
+	// Set the check handle used to write queued data once per loop iteration.
+	this->uvCheckHandle       = new uv_check_t;
+	this->uvCheckHandle->data = static_cast<void*>(this);
+
+	err = uv_check_init(DepLibUV::GetLoop(), this->uvCheckHandle);
+
+	if (err != 0)
+	{
+		delete this->uvCheckHandle;
+		this->uvCheckHandle = nullptr;
+
+		MS_THROW_ERROR("uv_check_init() failed: %s", uv_strerror(err));
+	}
+
 	// Set the listener.
 	this->listener = listener;
 
@@ -161,13 +215,23 @@ void TcpConnectionHandler::Start()
 	if (this->closed)
 		return;
 
-	int err = uv_read_start(
-	  reinterpret_cast<uv_stream_t*>(this->uvHandle),
-	  static_cast<uv_alloc_cb>(onAlloc),
-	  static_cast<uv_read_cb>(onRead));
+	// Receive through io_uring if enabled, otherwise through libuv.
+	if (DepIoUring::IsEnabled())
+	{
+		this->ioUringRecvId =
+		  DepIoUring::StartRecv(reinterpret_cast<uv_handle_t*>(this->uvHandle), this);
+	}
 
-	if (err != 0)
-		MS_THROW_ERROR("uv_read_start() failed: %s", uv_strerror(err));
+	if (this->ioUringRecvId == 0u)
+	{
+		int err = uv_read_start(
+		  reinterpret_cast<uv_stream_t*>(this->uvHandle),
+		  static_cast<uv_alloc_cb>(onAlloc),
+		  static_cast<uv_read_cb>(onRead));
+
+		if (err != 0)
+			MS_THROW_ERROR("uv_read_start() failed: %s", uv_strerror(err));
+	}
 
 	// Get the peer address.
 	if (!SetPeerAddress())
@@ -179,11 +243,12 @@ void TcpConnectionHandler::Write(
   size_t len1,
   const uint8_t* data2,
   size_t len2,
-  TcpConnectionHandler::onSendCallback* cb)
+  TcpConnectionHandler::onSendCallback* cb,
+  bool droppable)
 {
 	MS_TRACE();
 
-	if (this->closed)
+	if (this->closed || this->overflowed)
 	{
 		if (cb)
 		{
@@ -194,7 +259,9 @@ void TcpConnectionHandler::Write(
 		return;
 	}
 
-	if (len1 == 0 && len2 == 0)
+	size_t totalLen = len1 + len2;
+
+	if (totalLen == 0 || totalLen > MaxPendingDataSize)
 	{
 		if (cb)
 		{
@@ -205,21 +272,128 @@ void TcpConnectionHandler::Write(
 		return;
 	}
 
-	size_t totalLen = len1 + len2;
-	uv_buf_t buffers[2];
+	// Don't let the queue grow without limit if the connection cannot keep up.
+	// Queued droppable data is older than the given one so drop it first.
+	if (this->pendingData.size() + totalLen > MaxPendingDataSize)
+	{
+		MS_WARN_DEV(
+		  "too much pending data, dropping droppable data [pendingLen:%zu, peerIp:%s, peerPort:%" PRIu16
+		  "]",
+		  this->pendingData.size(),
+		  this->peerIp.c_str(),
+		  this->peerPort);
+
+		DropDroppablePendingData();
+	}
+
+	if (this->pendingData.size() + totalLen > MaxPendingDataSize)
+	{
+		if (cb)
+		{
+			(*cb)(false);
+			delete cb;
+		}
+
+		if (droppable)
+			return;
+
+		// Non droppable data (such as STUN or DTLS) is never discarded while the
+		// connection goes on, so close it. Do it once the current loop iteration
+		// ends since the caller may still use the connection.
+		MS_WARN_TAG(
+		  info,
+		  "too much non droppable pending data, closing the connection [peerIp:%s, peerPort:%" PRIu16
+		  "]",
+		  this->peerIp.c_str(),
+		  this->peerPort);
+
+		this->overflowed = true;
+
+		DiscardPendingData();
+
+		if (uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvCheckHandle)) == 0)
+		{
+			int err = uv_check_start(this->uvCheckHandle, static_cast<uv_check_cb>(onCheck));
+
+			if (err != 0)
+				MS_ABORT("uv_check_start() failed: %s", uv_strerror(err));
+		}
+
+		return;
+	}
+
+	this->pendingData.insert(this->pendingData.end(), data1, data1 + len1);
+	this->pendingData.insert(this->pendingData.end(), data2, data2 + len2);
+	this->pendingWrites.push_back({ totalLen, cb, droppable });
+
+	// Write it once the current loop iteration ends (unless a write is in
+	// progress, in which case it's written once it completes).
+	if (!this->writing && uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvCheckHandle)) == 0)
+	{
+		int err = uv_check_start(this->uvCheckHandle, static_cast<uv_check_cb>(onCheck));
+
+		if (err != 0)
+			MS_ABORT("uv_check_start() failed: %s", uv_strerror(err));
+	}
+}
+
+void TcpConnectionHandler::ErrorReceiving()
+{
+	MS_TRACE();
+
+	Close();
+
+	this->listener->OnTcpConnectionClosed(this);
+}
+
+void TcpConnectionHandler::SendPendingData()
+{
+	MS_TRACE();
+
+	if (this->pendingData.empty())
+		return;
+
+	TcpConnectionHandler::onSendCallback* cb{ nullptr };
+	auto callbacks = std::make_shared<std::vector<onSendCallback*>>();
+
+	for (auto& pendingWrite : this->pendingWrites)
+	{
+		if (pendingWrite.cb)
+			callbacks->push_back(pendingWrite.cb);
+	}
+
+	this->pendingWrites.clear();
+
+	if (callbacks->size() == 1u)
+	{
+		cb = (*callbacks)[0];
+	}
+	else if (!callbacks->empty())
+	{
+		cb = new onSendCallback([callbacks](bool sent) {
+			for (auto* callback : *callbacks)
+			{
+				(*callback)(sent);
+				delete callback;
+			}
+		});
+	}
+
+	size_t totalLen = this->pendingData.size();
+	uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(this->pendingData.data()), totalLen);
 	int written{ 0 };
 	int err;
 
 	// First try uv_try_write(). In case it can not directly write all the given
 	// data then build a uv_req_t and use uv_write().
 
-	buffers[0] = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data1)), len1);
-	buffers[1] = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data2)), len2);
-	written    = uv_try_write(reinterpret_cast<uv_stream_t*>(this->uvHandle), buffers, 2);
+	written = uv_try_write(reinterpret_cast<uv_stream_t*>(this->uvHandle), &buffer, 1);
 
 	// All the data was written. Done.
 	if (written == static_cast<int>(totalLen))
 	{
+		this->pendingData.clear();
+
 		// Update sent bytes.
 		this->sentBytes += written;
 
@@ -250,26 +424,16 @@ void TcpConnectionHandler::Write(
 	auto* writeData   = new UvWriteData(pendingLen);
 
 	writeData->req.data = static_cast<void*>(writeData);
+	writeData->cb       = cb;
 
-	// If the first buffer was not entirely written then splice it.
-	if (static_cast<size_t>(written) < len1)
-	{
-		std::memcpy(
-		  writeData->store, data1 + static_cast<size_t>(written), len1 - static_cast<size_t>(written));
-		std::memcpy(writeData->store + (len1 - static_cast<size_t>(written)), data2, len2);
-	}
-	// Otherwise just take the pending data in the second buffer.
-	else
-	{
-		std::memcpy(
-		  writeData->store,
-		  data2 + (static_cast<size_t>(written) - len1),
-		  len2 - (static_cast<size_t>(written) - len1));
-	}
+	std::memcpy(writeData->store, this->pendingData.data() + written, pendingLen);
+
+	this->pendingData.clear();
 
-	writeData->cb = cb;
+	// Update sent bytes.
+	this->sentBytes += written;
 
-	uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(writeData->store), pendingLen);
+	buffer = uv_buf_init(reinterpret_cast<char*>(writeData->store), pendingLen);
 
 	err = uv_write(
 	  &writeData->req,
@@ -292,16 +456,70 @@ void TcpConnectionHandler::Write(
 	{
 		// Update sent bytes.
 		this->sentBytes += pendingLen;
+
+		// Queue data until the write completes.
+		this->writing = true;
 	}
 }
 
-void TcpConnectionHandler::ErrorReceiving()
+void TcpConnectionHandler::DropDroppablePendingData()
 {
 	MS_TRACE();
 
-	Close();
+	std::vector<onSendCallback*> droppedCallbacks;
+	size_t offset{ 0u };
+	size_t keptLen{ 0u };
+	auto keptIt = this->pendingWrites.begin();
 
-	this->listener->OnTcpConnectionClosed(this);
+	// Compact the kept data at the beginning of the queue.
+	for (auto& pendingWrite : this->pendingWrites)
+	{
+		if (pendingWrite.droppable)
+		{
+			if (pendingWrite.cb)
+				droppedCallbacks.push_back(pendingWrite.cb);
+		}
+		else
+		{
+			if (offset != keptLen)
+			{
+				std::memmove(
+				  this->pendingData.data() + keptLen, this->pendingData.data() + offset, pendingWrite.len);
+			}
+
+			keptLen += pendingWrite.len;
+			*keptIt = pendingWrite;
+			++keptIt;
+		}
+
+		offset += pendingWrite.len;
+	}
+
+	this->pendingWrites.erase(keptIt, this->pendingWrites.end());
+	this->pendingData.resize(keptLen);
+
+	for (auto* cb : droppedCallbacks)
+	{
+		(*cb)(false);
+		delete cb;
+	}
+}
+
+void TcpConnectionHandler::DiscardPendingData()
+{
+	MS_TRACE();
+
+	for (auto& pendingWrite : this->pendingWrites)
+	{
+		if (pendingWrite.cb)
+		{
+			(*pendingWrite.cb)(false);
+			delete pendingWrite.cb;
+		}
+	}
+
+	this->pendingWrites.clear();
+	this->pendingData.clear();
 }
 
 bool TcpConnectionHandler::SetPeerAddress()
@@ -405,10 +623,15 @@ inline void TcpConnectionHandler::OnUvWrite(int status, TcpConnectionHandler::on
 
 	// NOTE: Do not delete cb here since it will be delete in onWrite() above.
 
+	this->writing = false;
+
 	if (status == 0)
 	{
 		if (cb)
 			(*cb)(true);
+
+		// Write data queued meanwhile.
+		SendPendingData();
 	}
 	else
 	{
@@ -420,8 +643,69 @@ inline void TcpConnectionHandler::OnUvWrite(int status, TcpConnectionHandler::on
 		if (cb)
 			(*cb)(false);
 
+		DiscardPendingData();
+
 		Close();
 
 		this->listener->OnTcpConnectionClosed(this);
 	}
 }
+
+inline void TcpConnectionHandler::OnUvCheck()
+{
+	MS_TRACE();
+
+	uv_check_stop(this->uvCheckHandle);
+
+	if (this->overflowed)
+	{
+		this->hasError = true;
+
+		Close();
+
+		this->listener->OnTcpConnectionClosed(this);
+
+		return;
+	}
+
+	// If a write is in progress, queued data is written once it completes.
+	if (!this->writing)
+		SendPendingData();
+}
+
+size_t TcpConnectionHandler::OnIoUringRecv(
+  const uint8_t* data, size_t len, const struct sockaddr* /*addr*/)
+{
+	MS_TRACE();
+
+	uv_buf_t buf;
+
+	// Copy the received data as if libuv read it.
+	OnUvReadAlloc(len, std::addressof(buf));
+
+	if (buf.len == 0u)
+	{
+		OnUvRead(UV_ENOBUFS, std::addressof(buf));
+
+		return 0u;
+	}
+
+	size_t readLen = std::min(len, static_cast<size_t>(buf.len));
+
+	std::memcpy(buf.base, data, readLen);
+
+	// NOTE: This may delete the connection, so don't access members after it.
+	OnUvRead(static_cast<ssize_t>(readLen), std::addressof(buf));
+
+	return readLen;
+}
+
+void TcpConnectionHandler::OnIoUringRecvEnded(int error)
+{
+	MS_TRACE();
+
+	this->ioUringRecvId = 0u;
+
+	// Same handling as libuv read errors (0 means closed by the peer).
+	OnUvRead(error == 0 ? static_cast<ssize_t>(UV_EOF) : static_cast<ssize_t>(error), nullptr);
+}
@@ -5,7 +5,11 @@
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
-#include <cstring> // std::memcpy()
+#include <cerrno>
+#include <cstring> // std::memcpy(), std::strerror()
+#ifndef _WIN32
+#include <unistd.h> // dup()
+#endif
 
 /* Static. */
 
@@ -61,19 +65,32 @@ UdpSocketHandler::UdpSocketHandler(uv_udp_t* uvHandle) : uvHandle(uvHandle)
 
 	this->uvHandle->data = static_cast<void*>(this);
 
-	err = uv_udp_recv_start(
-	  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+	// Receive through io_uring if enabled, otherwise through libuv.
+	if (DepIoUring::IsEnabled())
+	{
+		this->ioUringRecvId =
+		  DepIoUring::StartRecv(reinterpret_cast<uv_handle_t*>(this->uvHandle), this);
+	}
 
-	if (err != 0)
+	if (this->ioUringRecvId == 0u)
 	{
-		uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+		err = uv_udp_recv_start(
+		  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+
+		if (err != 0)
+		{
+			uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
 
-		MS_THROW_ERROR("uv_udp_recv_start() failed: %s", uv_strerror(err));
+			MS_THROW_ERROR("uv_udp_recv_start() failed: %s", uv_strerror(err));
+		}
 	}
 
 	// Set local address.
 	if (!SetLocalAddress())
 	{
+		if (this->ioUringRecvId != 0u)
+			DepIoUring::StopRecv(this->ioUringRecvId);
+
 		uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
 
 		MS_THROW_ERROR("error setting local IP and port");
@@ -101,14 +118,62 @@ void UdpSocketHandler::Close()
 	this->uvHandle->data = nullptr;
 
 	// Don't read more.
-	int err = uv_udp_recv_stop(this->uvHandle);
+	StopReceiving();
 
-	if (err != 0)
-		MS_ABORT("uv_udp_recv_stop() failed: %s", uv_strerror(err));
+	// Datagrams queued for io_uring just hold the fd, which is about to be
+	// closed (and maybe reused), no matter how we were receiving.
+	if (DepIoUring::IsEnabled())
+		DepIoUring::FlushSends(this->uvHandle);
 
 	uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
 }
 
+void UdpSocketHandler::StopReceiving()
+{
+	MS_TRACE();
+
+	if (!this->receiving)
+		return;
+
+	this->receiving = false;
+
+	if (this->ioUringRecvId != 0u)
+	{
+		DepIoUring::StopRecv(this->ioUringRecvId);
+
+		this->ioUringRecvId = 0u;
+	}
+	else
+	{
+		int err = uv_udp_recv_stop(this->uvHandle);
+
+		if (err != 0)
+			MS_ABORT("uv_udp_recv_stop() failed: %s", uv_strerror(err));
+	}
+}
+
+int UdpSocketHandler::DupFd() const
+{
+	MS_TRACE();
+
+	uv_os_fd_t fd;
+	int err = uv_fileno(reinterpret_cast<const uv_handle_t*>(this->uvHandle), &fd);
+
+	if (err != 0)
+		MS_THROW_ERROR("uv_fileno() failed: %s", uv_strerror(err));
+
+#ifdef _WIN32
+	MS_THROW_ERROR("not supported on Windows");
+#else
+	int dupFd = dup(fd);
+
+	if (dupFd < 0)
+		MS_THROW_ERROR("dup() failed: %s", std::strerror(errno));
+
+	return dupFd;
+#endif
+}
+
 void UdpSocketHandler::Dump() const
 {
 	MS_DUMP("<UdpSocketHandler>");
@@ -145,6 +210,22 @@ void UdpSocketHandler::Send(
 		return;
 	}
 
+	// If enabled, queue the datagram so it's sent along with the rest of
+	// datagrams sent within this loop iteration.
+	if (DepIoUring::IsEnabled())
+	{
+		if (DepIoUring::PrepareSend(this->uvHandle, data, len, addr, cb))
+		{
+			// Update sent bytes.
+			this->sentBytes += len;
+
+			return;
+		}
+
+		// Otherwise it's sent below, after those already queued.
+		DepIoUring::SubmitSends();
+	}
+
 	// First try uv_udp_try_send(). In case it can not directly send the datagram
 	// then build a uv_req_t and use uv_udp_send().
 
@@ -305,3 +386,35 @@ inline void UdpSocketHandler::OnUvSend(int status, UdpSocketHandler::onSendCallb
 			(*cb)(false);
 	}
 }
+
+size_t UdpSocketHandler::OnIoUringRecv(
+  const uint8_t* data, size_t len, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	// Update received bytes.
+	this->recvBytes += len;
+
+	// Notify the subclass.
+	UserOnUdpDatagramReceived(data, len, addr);
+
+	return len;
+}
+
+void UdpSocketHandler::OnIoUringRecvEnded(int error)
+{
+	MS_TRACE();
+
+	MS_WARN_TAG(info, "io_uring receiving failed, using libuv: %s", uv_strerror(error));
+
+	this->ioUringRecvId = 0u;
+
+	if (!this->receiving)
+		return;
+
+	int err = uv_udp_recv_start(
+	  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+
+	if (err != 0)
+		MS_ERROR("uv_udp_recv_start() failed: %s", uv_strerror(err));
+}
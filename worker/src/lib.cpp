@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "common.hpp"
+#include "DepIoUring.hpp"
 #include "DepLibSRTP.hpp"
 #include "DepLibUV.hpp"
 #include "DepLibWebRTC.hpp"
@@ -163,6 +164,7 @@ extern "C" int mediasoup_worker_run(
 		DepLibSRTP::ClassInit();
 		DepUsrSCTP::ClassInit();
 		DepLibWebRTC::ClassInit();
+		DepIoUring::ClassInit();
 		Utils::Crypto::ClassInit();
 		RTC::DtlsTransport::ClassInit();
 		RTC::SrtpSession::ClassInit();
@@ -183,6 +185,7 @@ extern "C" int mediasoup_worker_run(
 		DepLibWebRTC::ClassDestroy();
 		RTC::DtlsTransport::ClassDestroy();
 		DepUsrSCTP::ClassDestroy();
+		DepIoUring::ClassDestroy();
 		DepLibUV::ClassDestroy();
 
 #ifdef MS_EXECUTABLE
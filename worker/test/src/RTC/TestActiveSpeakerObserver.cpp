@@ -0,0 +1,328 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "Channel/ChannelNotifier.hpp"
+#include "Channel/ChannelSocket.hpp"
+#include "RTC/ActiveSpeakerObserver.hpp"
+#include "RTC/Producer.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcpy()
+#include <string>
+#include <vector>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include "Utils.hpp"
+#include <chrono>
+#include <iostream>
+#endif
+
+using namespace RTC;
+
+namespace
+{
+	// Offset of the ssrc-audio-level extension value in the packet below.
+	constexpr size_t AudioLevelOffset{ 17u };
+
+	// clang-format off
+	uint8_t rtpBuffer[] =
+	{
+		0b10010000, 0b01100100, 0b00000000, 0b00000001, // PT:100, with extensions.
+		0b00000000, 0b00000000, 0b00000000, 0b00000001,
+		0b00000000, 0b00000000, 0b00000000, 0b00000001,
+		0xBE, 0xDE, 0x00, 0x01, // One-Byte extensions header.
+		0x10, 0x7F, 0x00, 0x00, // ssrc-audio-level extension (id:1, len:1).
+		0x11, 0x22, 0x33, 0x44  // Payload.
+	};
+	// clang-format on
+
+	class TestProducerListener : public Producer::Listener
+	{
+	public:
+		void OnProducerPaused(Producer* /*producer*/) override
+		{
+		}
+		void OnProducerResumed(Producer* /*producer*/) override
+		{
+		}
+		void OnProducerNewRtpStream(
+		  Producer* /*producer*/, RtpStream* /*rtpStream*/, uint32_t /*mappedSsrc*/) override
+		{
+		}
+		void OnProducerRtpStreamScore(
+		  Producer* /*producer*/,
+		  RtpStream* /*rtpStream*/,
+		  uint8_t /*score*/,
+		  uint8_t /*previousScore*/) override
+		{
+		}
+		void OnProducerRtcpSenderReport(
+		  Producer* /*producer*/, RtpStream* /*rtpStream*/, bool /*first*/) override
+		{
+		}
+		void OnProducerRtpPacketReceived(Producer* /*producer*/, RtpPacket* /*packet*/) override
+		{
+		}
+		void OnProducerSendRtcpPacket(Producer* /*producer*/, RTCP::Packet* /*packet*/) override
+		{
+		}
+		void OnProducerNeedWorstRemoteFractionLost(
+		  Producer* /*producer*/,
+		  uint32_t /*mappedSsrc*/,
+		  uint8_t& /*worstRemoteFractionLost*/) override
+		{
+		}
+	};
+
+	// Exposes the periodic update, which is otherwise run by the observer timer.
+	class TestActiveSpeakerObserver : public ActiveSpeakerObserver
+	{
+	public:
+		TestActiveSpeakerObserver(json& data) : ActiveSpeakerObserver("observer", data)
+		{
+		}
+
+	public:
+		void Update()
+		{
+			OnTimer(nullptr);
+		}
+	};
+
+	ChannelReadFreeFn ChannelRead(
+	  uint8_t** /*message*/,
+	  uint32_t* /*messageLen*/,
+	  size_t* /*messageCtx*/,
+	  const void* /*handle*/,
+	  ChannelReadCtx /*ctx*/)
+	{
+		return nullptr;
+	}
+
+	void ChannelWrite(const uint8_t* message, uint32_t messageLen, ChannelWriteCtx ctx)
+	{
+		auto* notifications = static_cast<std::vector<json>*>(ctx);
+
+		notifications->push_back(json::parse(message, message + messageLen));
+	}
+
+	Producer* CreateProducer(const std::string& id, uint32_t ssrc, Producer::Listener* listener)
+	{
+		json data = {
+			{ "kind", "audio" },
+			{ "rtpParameters",
+			  { { "codecs",
+			      { { { "mimeType", "audio/opus" },
+			          { "payloadType", 100 },
+			          { "clockRate", 48000 },
+			          { "channels", 2 } } } },
+			    { "encodings", { { { "ssrc", ssrc } } } },
+			    { "headerExtensions",
+			      { { { "uri", "urn:ietf:params:rtp-hdrext:ssrc-audio-level" }, { "id", 1 } } } } } },
+			{ "rtpMapping",
+			  { { "codecs", { { { "payloadType", 100 }, { "mappedPayloadType", 100 } } } },
+			    { "encodings", { { { "ssrc", ssrc }, { "mappedSsrc", ssrc } } } } } }
+		};
+
+		return new Producer(id, listener, data);
+	}
+
+	// Audio level packets, the level being the volume (0 silence, 127 max).
+	void ReceiveLevel(
+	  ActiveSpeakerObserver& observer,
+	  Producer* producer,
+	  RtpPacket* packet,
+	  uint8_t* buffer,
+	  uint8_t volume,
+	  size_t count = 1u)
+	{
+		// The extension carries the level in -dBov (0 being the loudest).
+		buffer[AudioLevelOffset] = 127u - volume;
+
+		for (size_t i{ 0u }; i < count; ++i)
+		{
+			observer.ReceiveRtpPacket(producer, packet);
+		}
+	}
+} // namespace
+
+SCENARIO("ActiveSpeakerObserver", "[rtp][activespeaker]")
+{
+	std::vector<json> notifications;
+	auto* channel = new Channel::ChannelSocket(
+	  ChannelRead, nullptr, ChannelWrite, static_cast<ChannelWriteCtx>(&notifications));
+
+	Channel::ChannelNotifier::ClassInit(channel);
+
+	uint8_t buffer[1500];
+
+	std::memcpy(buffer, rtpBuffer, sizeof(rtpBuffer));
+
+	auto* packet = RtpPacket::Parse(buffer, sizeof(rtpBuffer));
+
+	REQUIRE(packet);
+
+	packet->SetSsrcAudioLevelExtensionId(1);
+
+	TestProducerListener producerListener;
+
+	SECTION("dominant and last-N speakers are notified")
+	{
+		json data = { { "interval", 100 }, { "lastN", 2 } };
+		TestActiveSpeakerObserver observer(data);
+
+		auto* producerA = CreateProducer("a", 1111, &producerListener);
+		auto* producerB = CreateProducer("b", 2222, &producerListener);
+		auto* producerC = CreateProducer("c", 3333, &producerListener);
+
+		observer.AddProducer(producerA);
+		observer.AddProducer(producerB);
+		observer.AddProducer(producerC);
+
+		REQUIRE(notifications.size() == 2);
+		REQUIRE(notifications[0]["event"] == "lastnchange");
+		REQUIRE(notifications[0]["data"]["producerIds"] == json::array({ "a" }));
+		REQUIRE(notifications[1]["event"] == "lastnchange");
+		REQUIRE(notifications[1]["data"]["producerIds"] == json::array({ "a", "b" }));
+
+		notifications.clear();
+
+		// Set the background noise level of every speaker.
+		ReceiveLevel(observer, producerA, packet, buffer, 10);
+		ReceiveLevel(observer, producerB, packet, buffer, 10);
+		ReceiveLevel(observer, producerC, packet, buffer, 10);
+
+		// B speaks.
+		ReceiveLevel(observer, producerA, packet, buffer, 0, 50);
+		ReceiveLevel(observer, producerB, packet, buffer, 120, 50);
+		ReceiveLevel(observer, producerC, packet, buffer, 0, 50);
+
+		observer.Update();
+
+		// Last-N speakers (A and B) did not change.
+		REQUIRE(notifications.size() == 1);
+		REQUIRE(notifications[0]["event"] == "dominantspeaker");
+		REQUIRE(notifications[0]["data"]["producerId"] == "b");
+
+		notifications.clear();
+
+		// C speaks.
+		ReceiveLevel(observer, producerB, packet, buffer, 0, 50);
+		ReceiveLevel(observer, producerC, packet, buffer, 120, 50);
+
+		observer.Update();
+
+		REQUIRE(notifications.size() == 2);
+		REQUIRE(notifications[0]["event"] == "dominantspeaker");
+		REQUIRE(notifications[0]["data"]["producerId"] == "c");
+		REQUIRE(notifications[1]["event"] == "lastnchange");
+		REQUIRE(notifications[1]["data"]["producerIds"] == json::array({ "c", "b" }));
+
+		notifications.clear();
+
+		// Removing B moves C into its slot. Then A speaks.
+		observer.RemoveProducer(producerB);
+
+		REQUIRE(notifications.size() == 1);
+		REQUIRE(notifications[0]["event"] == "lastnchange");
+		REQUIRE(notifications[0]["data"]["producerIds"] == json::array({ "c", "a" }));
+
+		notifications.clear();
+
+		ReceiveLevel(observer, producerA, packet, buffer, 120, 50);
+		ReceiveLevel(observer, producerC, packet, buffer, 0, 50);
+
+		observer.Update();
+
+		// Last-N speakers (C and A) did not change.
+		REQUIRE(notifications.size() == 1);
+		REQUIRE(notifications[0]["event"] == "dominantspeaker");
+		REQUIRE(notifications[0]["data"]["producerId"] == "a");
+
+		notifications.clear();
+
+		// Removing the dominant speaker makes the remaining one dominant.
+		observer.RemoveProducer(producerA);
+
+		REQUIRE(notifications.size() == 2);
+		REQUIRE(notifications[0]["event"] == "dominantspeaker");
+		REQUIRE(notifications[0]["data"]["producerId"] == "c");
+		REQUIRE(notifications[1]["event"] == "lastnchange");
+		REQUIRE(notifications[1]["data"]["producerIds"] == json::array({ "c" }));
+
+		observer.RemoveProducer(producerC);
+
+		delete producerA;
+		delete producerB;
+		delete producerC;
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		size_t numSpeakers{ 2000u };
+		size_t numUpdates{ 1000u };
+		json data = { { "interval", 300 } };
+		TestActiveSpeakerObserver observer(data);
+		std::vector<Producer*> producers;
+
+		for (size_t i{ 0u }; i < numSpeakers; ++i)
+		{
+			auto* producer =
+			  CreateProducer(std::to_string(i), static_cast<uint32_t>(i + 1), &producerListener);
+
+			observer.AddProducer(producer);
+			producers.push_back(producer);
+
+			ReceiveLevel(observer, producer, packet, buffer, 10);
+		}
+
+		std::chrono::duration<double> receiveDur{ 0 };
+		std::chrono::duration<double> updateDur{ 0 };
+
+		for (size_t n{ 0u }; n < numUpdates; ++n)
+		{
+			auto start = std::chrono::system_clock::now();
+
+			// A few speakers talk at a time, and the rest send background noise.
+			for (size_t i{ 0u }; i < numSpeakers; ++i)
+			{
+				uint8_t volume = (i % 500 == n % 500) ? 120 : Utils::Crypto::GetRandomUInt(0, 20);
+
+				ReceiveLevel(observer, producers[i], packet, buffer, volume);
+			}
+
+			receiveDur += std::chrono::system_clock::now() - start;
+
+			start = std::chrono::system_clock::now();
+
+			observer.Update();
+
+			updateDur += std::chrono::system_clock::now() - start;
+		}
+
+		std::cout << "ActiveSpeakerObserver with " << numSpeakers << " speakers:" << std::endl;
+		std::cout << "  receive: \t" << receiveDur.count() / (numUpdates * numSpeakers) * 1e9
+		          << " ns per packet" << std::endl;
+		std::cout << "  update: \t" << updateDur.count() / numUpdates * 1e6 << " us per interval"
+		          << std::endl;
+
+		for (auto* producer : producers)
+		{
+			observer.RemoveProducer(producer);
+
+			delete producer;
+		}
+	}
+#endif
+
+	delete packet;
+
+	Channel::ChannelNotifier::ClassInit(nullptr);
+
+	delete channel;
+
+	// Let the loop close the observer timer and the channel handle.
+	DepLibUV::RunLoop();
+}
@@ -0,0 +1,330 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "Settings.hpp"
+#include "Utils.hpp"
+#include "RTC/DtlsTransport.hpp"
+#include "handles/Timer.hpp"
+#include <catch2/catch.hpp>
+#include <deque>
+#include <thread>
+#include <vector>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include "DepLibSRTP.hpp"
+#include "DepLibWebRTC.hpp"
+#include "DepOpenSSL.hpp"
+#include "DepUsrSCTP.hpp"
+#include "RTC/SrtpSession.hpp"
+#include <chrono>
+#include <iostream>
+#endif
+
+using namespace RTC;
+
+// Runs a DTLS handshake between a client and a server DtlsTransport within
+// the loop. DTLS data is delivered to the peer within a Timer callback.
+class TestDtlsTransportPair : public DtlsTransport::Listener, public Timer::Listener
+{
+public:
+	TestDtlsTransportPair()
+	  : client(new DtlsTransport(this)), server(new DtlsTransport(this)), timer(new Timer(this))
+	{
+		DtlsTransport::Fingerprint fingerprint;
+
+		for (auto& localFingerprint : this->client->GetLocalFingerprints())
+		{
+			if (localFingerprint.algorithm == DtlsTransport::FingerprintAlgorithm::SHA256)
+				fingerprint = localFingerprint;
+		}
+
+		// Both DtlsTransports use the same certificate.
+		this->client->SetRemoteFingerprint(fingerprint);
+		this->server->SetRemoteFingerprint(fingerprint);
+	}
+
+	~TestDtlsTransportPair() override
+	{
+		delete this->client;
+		delete this->server;
+		delete this->timer;
+	}
+
+public:
+	void Run()
+	{
+		this->server->Run(DtlsTransport::Role::SERVER);
+		this->client->Run(DtlsTransport::Role::CLIENT);
+
+		DepLibUV::RunLoop();
+	}
+
+	/* Pure virtual methods inherited from DtlsTransport::Listener. */
+public:
+	void OnDtlsTransportConnecting(const DtlsTransport* /*dtlsTransport*/) override
+	{
+	}
+
+	void OnDtlsTransportConnected(
+	  const DtlsTransport* dtlsTransport,
+	  SrtpSession::CryptoSuite /*srtpCryptoSuite*/,
+	  uint8_t* srtpLocalKey,
+	  size_t srtpLocalKeyLen,
+	  uint8_t* srtpRemoteKey,
+	  size_t srtpRemoteKeyLen,
+	  std::string& /*remoteCert*/) override
+	{
+		if (dtlsTransport == this->client)
+		{
+			this->clientConnected = true;
+			this->clientLocalKey.assign(srtpLocalKey, srtpLocalKey + srtpLocalKeyLen);
+		}
+		else
+		{
+			this->serverConnected = true;
+			this->serverRemoteKey.assign(srtpRemoteKey, srtpRemoteKey + srtpRemoteKeyLen);
+		}
+
+		// May be called once a handshake task is done, so check in the timer
+		// whether the DtlsTransports can be closed.
+		this->timer->Start(0);
+	}
+
+	void OnDtlsTransportFailed(const DtlsTransport* /*dtlsTransport*/) override
+	{
+		this->failed = true;
+
+		this->timer->Start(0);
+	}
+
+	void OnDtlsTransportClosed(const DtlsTransport* /*dtlsTransport*/) override
+	{
+		this->failed = true;
+
+		this->timer->Start(0);
+	}
+
+	void OnDtlsTransportSendData(
+	  const DtlsTransport* dtlsTransport, const uint8_t* data, size_t len) override
+	{
+		if (dtlsTransport == this->client)
+			this->toServer.emplace_back(data, data + len);
+		else
+			this->toClient.emplace_back(data, data + len);
+
+		this->timer->Start(0);
+	}
+
+	void OnDtlsTransportApplicationDataReceived(
+	  const DtlsTransport* /*dtlsTransport*/, const uint8_t* /*data*/, size_t /*len*/) override
+	{
+	}
+
+	/* Pure virtual methods inherited from Timer::Listener. */
+public:
+	void OnTimer(Timer* /*timer*/) override
+	{
+		while (this->client && (!this->toServer.empty() || !this->toClient.empty()))
+		{
+			auto toServer = std::move(this->toServer);
+			auto toClient = std::move(this->toClient);
+
+			this->toServer.clear();
+			this->toClient.clear();
+
+			for (auto& data : toServer)
+			{
+				this->server->ProcessDtlsData(data.data(), data.size());
+			}
+
+			for (auto& data : toClient)
+			{
+				this->client->ProcessDtlsData(data.data(), data.size());
+			}
+		}
+
+		// Close the DtlsTransports (and hence their DTLS timers and crypto thread
+		// pool) so the loop ends.
+		if (this->client && ((this->clientConnected && this->serverConnected) || this->failed))
+		{
+			delete this->client;
+			delete this->server;
+
+			this->client = nullptr;
+			this->server = nullptr;
+		}
+	}
+
+public:
+	DtlsTransport* client{ nullptr };
+	DtlsTransport* server{ nullptr };
+	Timer* timer{ nullptr };
+	std::deque<std::vector<uint8_t>> toServer;
+	std::deque<std::vector<uint8_t>> toClient;
+	bool clientConnected{ false };
+	bool serverConnected{ false };
+	bool failed{ false };
+	std::vector<uint8_t> clientLocalKey;
+	std::vector<uint8_t> serverRemoteKey;
+};
+
+SCENARIO("DTLS transport", "[dtls]")
+{
+	auto previousDtlsHandshakeThreads = Settings::configuration.dtlsHandshakeThreads;
+
+	SECTION("handshake within the loop thread")
+	{
+		Settings::configuration.dtlsHandshakeThreads = 0u;
+
+		TestDtlsTransportPair pair;
+
+		pair.Run();
+
+		REQUIRE(!pair.failed);
+		REQUIRE(pair.clientConnected);
+		REQUIRE(pair.serverConnected);
+		REQUIRE(!pair.clientLocalKey.empty());
+		REQUIRE(pair.clientLocalKey == pair.serverRemoteKey);
+	}
+
+	SECTION("handshake within the crypto thread pool")
+	{
+		Settings::configuration.dtlsHandshakeThreads = 2u;
+
+		TestDtlsTransportPair pair;
+
+		pair.Run();
+
+		REQUIRE(!pair.failed);
+		REQUIRE(pair.clientConnected);
+		REQUIRE(pair.serverConnected);
+		REQUIRE(!pair.clientLocalKey.empty());
+		REQUIRE(pair.clientLocalKey == pair.serverRemoteKey);
+	}
+
+	SECTION("DtlsTransport can be closed while running a handshake task")
+	{
+		Settings::configuration.dtlsHandshakeThreads = 1u;
+
+		{
+			TestDtlsTransportPair pair;
+
+			pair.server->Run(DtlsTransport::Role::SERVER);
+			pair.client->Run(DtlsTransport::Role::CLIENT);
+
+			// Deliver the ClientHello so the server runs a handshake task.
+			auto toServer = std::move(pair.toServer);
+
+			pair.toServer.clear();
+
+			for (auto& data : toServer)
+			{
+				pair.server->ProcessDtlsData(data.data(), data.size());
+			}
+
+			REQUIRE(!pair.serverConnected);
+		}
+	}
+
+	SECTION("workers in the same process share the generated certificate")
+	{
+		std::vector<DtlsTransport::Fingerprint> localFingerprints;
+		std::vector<DtlsTransport::Fingerprint> workerLocalFingerprints;
+		bool workerConnected{ false };
+
+		{
+			TestDtlsTransportPair pair;
+
+			localFingerprints = pair.client->GetLocalFingerprints();
+		}
+
+		// Initialize DtlsTransport within another thread as a worker would do and
+		// run a handshake with the shared SSL_CTX.
+		std::thread thread(
+		  [&workerLocalFingerprints, &workerConnected]()
+		  {
+			  Settings::configuration.logLevel = LogLevel::LOG_NONE;
+
+			  DepLibUV::ClassInit();
+			  Utils::Crypto::ClassInit();
+			  DtlsTransport::ClassInit();
+
+			  {
+				  TestDtlsTransportPair pair;
+
+				  workerLocalFingerprints = pair.client->GetLocalFingerprints();
+
+				  pair.Run();
+
+				  workerConnected = pair.clientConnected && pair.serverConnected;
+			  }
+
+			  DtlsTransport::ClassDestroy();
+			  Utils::Crypto::ClassDestroy();
+			  DepLibUV::ClassDestroy();
+		  });
+
+		thread.join();
+
+		REQUIRE(workerConnected);
+		REQUIRE(!localFingerprints.empty());
+		REQUIRE(workerLocalFingerprints.size() == localFingerprints.size());
+
+		for (size_t i{ 0u }; i < localFingerprints.size(); ++i)
+		{
+			REQUIRE(workerLocalFingerprints[i].algorithm == localFingerprints[i].algorithm);
+			REQUIRE(workerLocalFingerprints[i].value == localFingerprints[i].value);
+		}
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		size_t numWorkers = 32;
+		std::vector<std::thread> threads;
+
+		auto start = std::chrono::system_clock::now();
+
+		// Same static initialization as each worker does at startup.
+		for (size_t i{ 0u }; i < numWorkers; ++i)
+		{
+			threads.emplace_back(
+			  []()
+			  {
+				  Settings::configuration.logLevel = LogLevel::LOG_NONE;
+
+				  DepLibUV::ClassInit();
+				  DepOpenSSL::ClassInit();
+				  DepLibSRTP::ClassInit();
+				  DepUsrSCTP::ClassInit();
+				  DepLibWebRTC::ClassInit();
+				  Utils::Crypto::ClassInit();
+				  DtlsTransport::ClassInit();
+				  SrtpSession::ClassInit();
+
+				  DepLibSRTP::ClassDestroy();
+				  Utils::Crypto::ClassDestroy();
+				  DepLibWebRTC::ClassDestroy();
+				  DtlsTransport::ClassDestroy();
+				  DepUsrSCTP::ClassDestroy();
+				  DepLibUV::ClassDestroy();
+			  });
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+		std::cout << "worker startup: \t" << dur.count() / numWorkers << " seconds per worker ("
+		          << numWorkers << " workers)" << std::endl;
+	}
+#endif
+
+	Settings::configuration.dtlsHandshakeThreads = previousDtlsHandshakeThreads;
+
+	// Let the loop close the remaining handles.
+	DepLibUV::RunLoop();
+}
@@ -0,0 +1,149 @@
+#include "common.hpp"
+#include "RTC/Codecs/PayloadDescriptorHandler.hpp"
+#include "RTC/KeyFrameCache.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcpy()
+
+using namespace RTC;
+
+namespace
+{
+	class KeyFramePayloadDescriptorHandler : public Codecs::PayloadDescriptorHandler
+	{
+	public:
+		explicit KeyFramePayloadDescriptorHandler(bool isKeyFrame) : isKeyFrame(isKeyFrame){};
+		~KeyFramePayloadDescriptorHandler() = default;
+		void Dump() const
+		{
+			return;
+		};
+		bool Process(Codecs::EncodingContext* /*context*/, uint8_t* /*data*/, bool& /*marker*/)
+		{
+			return true;
+		};
+		void Restore(uint8_t* /*data*/)
+		{
+			return;
+		};
+		uint8_t GetSpatialLayer() const
+		{
+			return 0;
+		};
+		uint8_t GetTemporalLayer() const
+		{
+			return 0;
+		};
+		bool IsKeyFrame() const
+		{
+			return this->isKeyFrame;
+		};
+
+	private:
+		bool isKeyFrame{ false };
+	};
+
+	void ReceivePacket(
+	  KeyFrameCache& keyFrameCache,
+	  RtpPacket* packet,
+	  uint16_t seq,
+	  uint32_t timestamp,
+	  bool isKeyFrame)
+	{
+		packet->SetPayloadDescriptorHandler(new KeyFramePayloadDescriptorHandler(isKeyFrame));
+		packet->SetSequenceNumber(seq);
+		packet->SetTimestamp(timestamp);
+
+		keyFrameCache.ReceivePacket(packet);
+	}
+} // namespace
+
+SCENARIO("key frame cache", "[rtp][keyframe]")
+{
+	// clang-format off
+	uint8_t rtpBuffer[] =
+	{
+		0b10000000, 0b01111011, 0b01010010, 0b00001110,
+		0b01011011, 0b01101011, 0b11001010, 0b10110101,
+		0, 0, 0, 2,
+		0x11, 0x22, 0x33, 0x44 // Payload.
+	};
+	// clang-format on
+
+	uint8_t buffer[1500];
+
+	std::memcpy(buffer, rtpBuffer, sizeof(rtpBuffer));
+
+	auto* packet = RtpPacket::Parse(buffer, sizeof(rtpBuffer));
+
+	REQUIRE(packet);
+
+	SECTION("packets are cached from the latest key frame")
+	{
+		KeyFrameCache keyFrameCache(10000);
+
+		// No key frame yet.
+		ReceivePacket(keyFrameCache, packet, 1000, 1000, false);
+
+		REQUIRE(!keyFrameCache.HasKeyFrame());
+		REQUIRE(keyFrameCache.GetPackets().empty());
+
+		// Key frame in two packets followed by a delta frame.
+		ReceivePacket(keyFrameCache, packet, 1001, 2000, true);
+		ReceivePacket(keyFrameCache, packet, 1002, 2000, true);
+		ReceivePacket(keyFrameCache, packet, 1003, 3000, false);
+
+		REQUIRE(keyFrameCache.HasKeyFrame());
+		REQUIRE(keyFrameCache.GetPackets().size() == 3);
+		REQUIRE(keyFrameCache.GetSize() == 3 * sizeof(rtpBuffer));
+		REQUIRE(keyFrameCache.GetPackets()[0]->GetSequenceNumber() == 1001);
+		REQUIRE(keyFrameCache.GetPackets()[0]->IsKeyFrame());
+		REQUIRE(keyFrameCache.GetPackets()[2]->GetSequenceNumber() == 1003);
+		REQUIRE(keyFrameCache.GetPackets()[2]->GetTimestamp() == 3000);
+
+		// Retransmitted packet previous to the key frame is ignored.
+		ReceivePacket(keyFrameCache, packet, 1000, 1000, false);
+
+		REQUIRE(keyFrameCache.GetPackets().size() == 3);
+
+		// A new key frame replaces everything.
+		ReceivePacket(keyFrameCache, packet, 1004, 4000, true);
+
+		REQUIRE(keyFrameCache.HasKeyFrame());
+		REQUIRE(keyFrameCache.GetPackets().size() == 1);
+		REQUIRE(keyFrameCache.GetPackets()[0]->GetSequenceNumber() == 1004);
+
+		keyFrameCache.Clear();
+
+		REQUIRE(!keyFrameCache.HasKeyFrame());
+		REQUIRE(keyFrameCache.GetSize() == 0);
+	}
+
+	SECTION("cache is discarded once max size is exceeded")
+	{
+		KeyFrameCache keyFrameCache(3 * sizeof(rtpBuffer));
+
+		ReceivePacket(keyFrameCache, packet, 1000, 1000, true);
+		ReceivePacket(keyFrameCache, packet, 1001, 2000, false);
+		ReceivePacket(keyFrameCache, packet, 1002, 3000, false);
+
+		REQUIRE(keyFrameCache.GetPackets().size() == 3);
+
+		ReceivePacket(keyFrameCache, packet, 1003, 4000, false);
+
+		REQUIRE(!keyFrameCache.HasKeyFrame());
+		REQUIRE(keyFrameCache.GetSize() == 0);
+
+		// Delta frames are not cached until a new key frame arrives.
+		ReceivePacket(keyFrameCache, packet, 1004, 5000, false);
+
+		REQUIRE(!keyFrameCache.HasKeyFrame());
+
+		ReceivePacket(keyFrameCache, packet, 1005, 6000, true);
+
+		REQUIRE(keyFrameCache.HasKeyFrame());
+		REQUIRE(keyFrameCache.GetPackets().size() == 1);
+	}
+
+	delete packet;
+}
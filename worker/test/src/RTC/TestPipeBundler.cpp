@@ -0,0 +1,191 @@
+#include "common.hpp"
+#include "Utils.hpp"
+#include "RTC/PipeBundler.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memset()
+#include <vector>
+
+using namespace RTC;
+
+namespace
+{
+	class TestPipeBundlerListener : public PipeBundler::Listener
+	{
+	public:
+		void OnPipeBundlerSend(
+		  PipeBundler* /*pipeBundler*/, const uint8_t* data, size_t len, PipeBundler::onSendCallback* cb) override
+		{
+			this->datagrams.emplace_back(data, data + len);
+
+			if (cb)
+			{
+				(*cb)(true);
+				delete cb;
+			}
+		}
+
+	public:
+		std::vector<std::vector<uint8_t>> datagrams;
+	};
+
+	std::vector<uint8_t> CreatePacket(size_t len, uint8_t byte)
+	{
+		std::vector<uint8_t> packet(len);
+
+		std::memset(packet.data(), byte, len);
+
+		// Make it look like a RTP packet.
+		packet[0] = 0b10000000;
+		packet[1] = 100u;
+
+		return packet;
+	}
+
+	std::vector<std::vector<uint8_t>> Unbundle(const std::vector<uint8_t>& datagram)
+	{
+		std::vector<std::vector<uint8_t>> packets;
+
+		REQUIRE(PipeBundler::IsBundle(datagram.data(), datagram.size()));
+		REQUIRE(PipeBundler::Unbundle(
+		  datagram.data(), datagram.size(), [&packets](const uint8_t* data, size_t len) {
+			  packets.emplace_back(data, data + len);
+		  }));
+
+		return packets;
+	}
+} // namespace
+
+SCENARIO("Pipe bundler", "[pipe][bundler]")
+{
+	TestPipeBundlerListener listener;
+	size_t numSent{ 0u };
+
+	auto createCallback = [&numSent]() {
+		return new PipeBundler::onSendCallback([&numSent](bool sent) {
+			if (sent)
+				++numSent;
+		});
+	};
+
+	SECTION("packets are bundled until flushed")
+	{
+		PipeBundler bundler(&listener, 1u);
+		auto packet1 = CreatePacket(100u, 0x11);
+		auto packet2 = CreatePacket(200u, 0x22);
+		auto packet3 = CreatePacket(300u, 0x33);
+
+		REQUIRE(bundler.Add(packet1.data(), packet1.size(), createCallback()));
+		REQUIRE(bundler.Add(packet2.data(), packet2.size(), nullptr));
+		REQUIRE(bundler.Add(packet3.data(), packet3.size(), createCallback()));
+		REQUIRE(listener.datagrams.empty());
+
+		bundler.Flush();
+
+		REQUIRE(listener.datagrams.size() == 1u);
+		REQUIRE(numSent == 2u);
+
+		auto packets = Unbundle(listener.datagrams[0]);
+
+		REQUIRE(packets.size() == 3u);
+		REQUIRE(packets[0] == packet1);
+		REQUIRE(packets[1] == packet2);
+		REQUIRE(packets[2] == packet3);
+
+		// Nothing else to send.
+		bundler.Flush();
+
+		REQUIRE(listener.datagrams.size() == 1u);
+	}
+
+	SECTION("a single packet is not bundled")
+	{
+		PipeBundler bundler(&listener, 1u);
+		auto packet = CreatePacket(100u, 0x11);
+
+		REQUIRE(bundler.Add(packet.data(), packet.size(), createCallback()));
+
+		bundler.Flush();
+
+		REQUIRE(listener.datagrams.size() == 1u);
+		REQUIRE(listener.datagrams[0] == packet);
+		REQUIRE(!PipeBundler::IsBundle(packet.data(), packet.size()));
+		REQUIRE(numSent == 1u);
+	}
+
+	SECTION("the bundle is sent once full")
+	{
+		PipeBundler bundler(&listener, 1u);
+		auto packet = CreatePacket(600u, 0x11);
+
+		REQUIRE(bundler.Add(packet.data(), packet.size(), nullptr));
+		REQUIRE(bundler.Add(packet.data(), packet.size(), nullptr));
+		REQUIRE(listener.datagrams.empty());
+
+		// It doesn't fit into the current bundle.
+		REQUIRE(bundler.Add(packet.data(), packet.size(), nullptr));
+		REQUIRE(listener.datagrams.size() == 1u);
+		REQUIRE(listener.datagrams[0].size() <= PipeBundler::MaxBundleSize);
+		REQUIRE(Unbundle(listener.datagrams[0]).size() == 2u);
+
+		bundler.Flush();
+
+		REQUIRE(listener.datagrams.size() == 2u);
+		REQUIRE(listener.datagrams[1] == packet);
+	}
+
+	SECTION("too big packets are not bundled and pending ones are sent first")
+	{
+		PipeBundler bundler(&listener, 1u);
+		auto packet    = CreatePacket(100u, 0x11);
+		auto bigPacket = CreatePacket(PipeBundler::MaxPacketSize + 1u, 0x22);
+
+		REQUIRE(bundler.Add(packet.data(), packet.size(), nullptr));
+		REQUIRE(!bundler.Add(bigPacket.data(), bigPacket.size(), nullptr));
+		REQUIRE(listener.datagrams.size() == 1u);
+		REQUIRE(listener.datagrams[0] == packet);
+	}
+
+	SECTION("pending callbacks are called with false on destruction")
+	{
+		size_t numNotSent{ 0u };
+
+		{
+			PipeBundler bundler(&listener, 1u);
+			auto packet = CreatePacket(100u, 0x11);
+
+			bundler.Add(
+			  packet.data(),
+			  packet.size(),
+			  new PipeBundler::onSendCallback([&numNotSent](bool sent) {
+				  if (!sent)
+					  ++numNotSent;
+			  }));
+		}
+
+		REQUIRE(listener.datagrams.empty());
+		REQUIRE(numNotSent == 1u);
+	}
+
+	SECTION("malformed bundles are detected")
+	{
+		PipeBundler bundler(&listener, 1u);
+		auto packet = CreatePacket(100u, 0x11);
+
+		REQUIRE(bundler.Add(packet.data(), packet.size(), nullptr));
+		REQUIRE(bundler.Add(packet.data(), packet.size(), nullptr));
+
+		bundler.Flush();
+
+		auto datagram = listener.datagrams[0];
+		size_t numPackets{ 0u };
+
+		// Truncate the last packet.
+		datagram.resize(datagram.size() - 1u);
+
+		REQUIRE(!PipeBundler::Unbundle(
+		  datagram.data(), datagram.size(), [&numPackets](const uint8_t* /*data*/, size_t /*len*/) {
+			  ++numPackets;
+		  }));
+		REQUIRE(numPackets == 1u);
+	}
+}
@@ -0,0 +1,107 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
+#include "Utils.hpp"
+#include "RTC/PortManager.hpp"
+#include <catch2/catch.hpp>
+#include <set>
+#include <vector>
+
+using namespace RTC;
+
+namespace
+{
+	void onClose(uv_handle_t* handle)
+	{
+		delete handle;
+	}
+
+	uint16_t GetPort(uv_udp_t* uvHandle)
+	{
+		struct sockaddr_storage localAddr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		int len = sizeof(localAddr);
+		int family;
+		std::string ip;
+		uint16_t port;
+
+		int err = uv_udp_getsockname(uvHandle, reinterpret_cast<struct sockaddr*>(&localAddr), &len);
+
+		REQUIRE(err == 0);
+
+		Utils::IP::GetAddressInfo(
+		  reinterpret_cast<const struct sockaddr*>(&localAddr), family, ip, port);
+
+		return port;
+	}
+} // namespace
+
+SCENARIO("Port manager", "[portmanager]")
+{
+	std::string ip{ "127.0.0.1" };
+	auto rtcMinPort = Settings::configuration.rtcMinPort;
+	auto rtcMaxPort = Settings::configuration.rtcMaxPort;
+
+	Settings::configuration.rtcMinPort = 43000u;
+	Settings::configuration.rtcMaxPort = 43009u;
+
+	SECTION("all ports in the range are given once and reused once unbound")
+	{
+		std::vector<uv_udp_t*> uvHandles;
+		std::set<uint16_t> ports;
+
+		// Some ports may be used by other processes.
+		while (true)
+		{
+			uv_udp_t* uvHandle{ nullptr };
+
+			try
+			{
+				uvHandle = PortManager::BindUdp(ip);
+			}
+			catch (const MediaSoupError& /*error*/)
+			{
+				break;
+			}
+
+			auto port = GetPort(uvHandle);
+
+			REQUIRE(port >= 43000u);
+			REQUIRE(port <= 43009u);
+			REQUIRE(ports.find(port) == ports.end());
+
+			uvHandles.push_back(uvHandle);
+			ports.insert(port);
+		}
+
+		REQUIRE(!uvHandles.empty());
+		REQUIRE(uvHandles.size() <= 10u);
+
+		// Release one of them.
+		auto port = GetPort(uvHandles.back());
+
+		uv_close(reinterpret_cast<uv_handle_t*>(uvHandles.back()), onClose);
+		uvHandles.pop_back();
+		PortManager::UnbindUdp(ip, port);
+
+		// Let libuv close the socket.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		auto* uvHandle = PortManager::BindUdp(ip);
+
+		REQUIRE(GetPort(uvHandle) == port);
+
+		uvHandles.push_back(uvHandle);
+
+		for (auto* uvHandle : uvHandles)
+		{
+			PortManager::UnbindUdp(ip, GetPort(uvHandle));
+			uv_close(reinterpret_cast<uv_handle_t*>(uvHandle), onClose);
+		}
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+
+	Settings::configuration.rtcMinPort = rtcMinPort;
+	Settings::configuration.rtcMaxPort = rtcMaxPort;
+}
@@ -0,0 +1,218 @@
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpRedEncoder.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcpy(), std::memcmp(), std::memset()
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <chrono>
+#include <iostream>
+#endif
+
+using namespace RTC;
+
+namespace
+{
+	constexpr uint8_t OpusPayloadType{ 100u };
+	constexpr uint8_t RedPayloadType{ 101u };
+
+	RtpPacket* Encode(
+	  RtpRedEncoder& redEncoder, RtpPacket* packet, uint32_t timestamp, uint8_t payloadByte)
+	{
+		packet->SetTimestamp(timestamp);
+		std::memset(packet->GetPayload(), payloadByte, packet->GetPayloadLength());
+
+		return redEncoder.Encode(packet);
+	}
+} // namespace
+
+SCENARIO("RTP RED encoder", "[rtp][red]")
+{
+	// clang-format off
+	uint8_t rtpBuffer[] =
+	{
+		0b10000000, 0b01100100, 0b00000000, 0b00000001, // PT:100.
+		0b00000000, 0b00000000, 0b00000000, 0b00000001,
+		0b00000000, 0b00000000, 0b00000000, 0b00000001,
+		0x11, 0x22, 0x33, 0x44 // Payload.
+	};
+	// clang-format on
+
+	uint8_t buffer[1500];
+
+	std::memcpy(buffer, rtpBuffer, sizeof(rtpBuffer));
+
+	auto* packet = RtpPacket::Parse(buffer, sizeof(rtpBuffer));
+
+	REQUIRE(packet);
+
+	SECTION("previous frames are carried as redundant blocks")
+	{
+		RtpRedEncoder redEncoder(RedPayloadType, 2u);
+
+		// No previous frames, just the primary block.
+		auto* redPacket = Encode(redEncoder, packet, 1000, 0xAA);
+
+		REQUIRE(redPacket);
+		REQUIRE(redPacket->GetPayloadType() == RedPayloadType);
+		REQUIRE(redPacket->GetSsrc() == packet->GetSsrc());
+		REQUIRE(redPacket->GetTimestamp() == 1000);
+		REQUIRE(redPacket->GetPayloadLength() == 1 + 4);
+
+		// clang-format off
+		uint8_t expected1[] =
+		{
+			OpusPayloadType,
+			0xAA, 0xAA, 0xAA, 0xAA
+		};
+		// clang-format on
+
+		REQUIRE(std::memcmp(redPacket->GetPayload(), expected1, sizeof(expected1)) == 0);
+
+		// Given packet is not modified.
+		REQUIRE(packet->GetPayloadType() == OpusPayloadType);
+		REQUIRE(packet->GetPayloadLength() == 4);
+
+		// One previous frame.
+		redPacket = Encode(redEncoder, packet, 1960, 0xBB);
+
+		REQUIRE(redPacket->GetPayloadLength() == 4 + 1 + 4 + 4);
+
+		// clang-format off
+		uint8_t expected2[] =
+		{
+			0x80 | OpusPayloadType, 0x0F, 0x00, 0x04, // Offset:960, length:4.
+			OpusPayloadType,
+			0xAA, 0xAA, 0xAA, 0xAA,
+			0xBB, 0xBB, 0xBB, 0xBB
+		};
+		// clang-format on
+
+		REQUIRE(std::memcmp(redPacket->GetPayload(), expected2, sizeof(expected2)) == 0);
+
+		// Two previous frames, the oldest one first.
+		redPacket = Encode(redEncoder, packet, 2920, 0xCC);
+
+		REQUIRE(redPacket->GetPayloadLength() == 4 + 4 + 1 + 4 + 4 + 4);
+
+		// clang-format off
+		uint8_t expected3[] =
+		{
+			0x80 | OpusPayloadType, 0x1E, 0x00, 0x04, // Offset:1920, length:4.
+			0x80 | OpusPayloadType, 0x0F, 0x00, 0x04, // Offset:960, length:4.
+			OpusPayloadType,
+			0xAA, 0xAA, 0xAA, 0xAA,
+			0xBB, 0xBB, 0xBB, 0xBB,
+			0xCC, 0xCC, 0xCC, 0xCC
+		};
+		// clang-format on
+
+		REQUIRE(std::memcmp(redPacket->GetPayload(), expected3, sizeof(expected3)) == 0);
+
+		// No more than two previous frames.
+		redPacket = Encode(redEncoder, packet, 3880, 0xDD);
+
+		REQUIRE(redPacket->GetPayloadLength() == 4 + 4 + 1 + 4 + 4 + 4);
+		REQUIRE(redPacket->GetPayload()[9] == 0xBB);
+
+		// Previous frames too old for the timestamp offset are not carried.
+		redPacket = Encode(redEncoder, packet, 3880 + 16384, 0xEE);
+
+		REQUIRE(redPacket->GetPayloadLength() == 1 + 4);
+
+		// Previous frames are forgotten once reset.
+		redEncoder.Reset();
+
+		redPacket = Encode(redEncoder, packet, 3880 + 16384 + 960, 0xFF);
+
+		REQUIRE(redPacket->GetPayloadLength() == 1 + 4);
+		REQUIRE(redPacket->GetPayload()[0] == OpusPayloadType);
+	}
+
+	SECTION("RED packet is rewritten in place for packets with a different header")
+	{
+		RtpRedEncoder redEncoder(RedPayloadType, 2u);
+
+		auto* redPacket = Encode(redEncoder, packet, 1000, 0xAA);
+
+		REQUIRE(redPacket);
+		REQUIRE(!redPacket->HasHeaderExtension());
+
+		// clang-format off
+		uint8_t rtpBuffer2[] =
+		{
+			0b10010000, 0b01100100, 0b00000000, 0b00000010, // PT:100, X:1.
+			0b00000000, 0b00000000, 0b00000111, 0b11000000,
+			0b00000000, 0b00000000, 0b00000000, 0b00000001,
+			0xBE, 0xDE, 0x00, 0x01, // Header extension.
+			0x10, 0xFF, 0x00, 0x00, // Extension id:1, length:1.
+			0x55, 0x66, 0x77, 0x88 // Payload.
+		};
+		// clang-format on
+
+		uint8_t buffer2[1500];
+
+		std::memcpy(buffer2, rtpBuffer2, sizeof(rtpBuffer2));
+
+		auto* packet2 = RtpPacket::Parse(buffer2, sizeof(rtpBuffer2));
+
+		REQUIRE(packet2);
+
+		// Same RED packet instance.
+		REQUIRE(redEncoder.Encode(packet2) == redPacket);
+		REQUIRE(redPacket->GetSequenceNumber() == 2);
+		REQUIRE(redPacket->GetTimestamp() == 1984);
+		REQUIRE(redPacket->HasOneByteExtensions());
+		REQUIRE(redPacket->HasExtension(1));
+		REQUIRE(redPacket->GetSize() == 12 + 8 + 4 + 1 + 4 + 4);
+
+		// clang-format off
+		uint8_t expected[] =
+		{
+			0x80 | OpusPayloadType, 0x0F, 0x60, 0x04, // Offset:984, length:4.
+			OpusPayloadType,
+			0xAA, 0xAA, 0xAA, 0xAA,
+			0x55, 0x66, 0x77, 0x88
+		};
+		// clang-format on
+
+		REQUIRE(std::memcmp(redPacket->GetPayload(), expected, sizeof(expected)) == 0);
+
+		// And back to a packet without header extension.
+		REQUIRE(Encode(redEncoder, packet, 2944, 0xCC) == redPacket);
+		REQUIRE(!redPacket->HasHeaderExtension());
+		REQUIRE(!redPacket->HasExtension(1));
+		REQUIRE(redPacket->GetPayloadLength() == 4 + 4 + 1 + 4 + 4 + 4);
+
+		delete packet2;
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		size_t numPackets{ 1000000u };
+		// Typical Opus frame (20 ms at 32 kbps).
+		size_t payloadLength{ 80u };
+		RtpRedEncoder redEncoder(RedPayloadType, 2u);
+
+		packet->SetPayloadLength(payloadLength);
+
+		auto start = std::chrono::system_clock::now();
+
+		for (size_t i{ 0u }; i < numPackets; ++i)
+		{
+			packet->SetTimestamp(static_cast<uint32_t>(i * 960));
+
+			redEncoder.Encode(packet);
+		}
+
+		std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+		std::cout << "RED encoding: \t" << dur.count() / numPackets * 1e9
+		          << " ns per packet and Consumer" << std::endl;
+	}
+#endif
+
+	delete packet;
+}
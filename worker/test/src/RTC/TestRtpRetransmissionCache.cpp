@@ -0,0 +1,226 @@
+#include "common.hpp"
+#include "Settings.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpRetransmissionCache.hpp"
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstring> // std::memcpy()
+#include <thread>
+
+using namespace RTC;
+
+static void StorePacket(
+  RtpRetransmissionCache& retransmissionCache,
+  RtpPacket* packet,
+  uint16_t seq,
+  uint32_t timestamp,
+  uint32_t retransmissionBufferSize = 2000u)
+{
+	packet->SetSequenceNumber(seq);
+	packet->SetTimestamp(timestamp);
+
+	retransmissionCache.SetCurrentPacket(packet);
+	retransmissionCache.StoreCurrentPacket(packet, retransmissionBufferSize);
+}
+
+SCENARIO("RTP retransmission cache", "[rtp][rtx]")
+{
+	// clang-format off
+	uint8_t rtpBuffer[] =
+	{
+		0b10000000, 0b01111011, 0b01010010, 0b00001110,
+		0b01011011, 0b01101011, 0b11001010, 0b10110101,
+		0, 0, 0, 2
+	};
+	// clang-format on
+
+	uint8_t buffer[1500];
+
+	std::memcpy(buffer, rtpBuffer, sizeof(rtpBuffer));
+
+	auto* packet = RtpPacket::Parse(buffer, sizeof(rtpBuffer));
+
+	REQUIRE(packet);
+
+	SECTION("packet is stored once with its original sequence number and timestamp")
+	{
+		RtpRetransmissionCache retransmissionCache(90000);
+
+		packet->SetSequenceNumber(1000);
+		packet->SetTimestamp(1533790901);
+
+		retransmissionCache.SetCurrentPacket(packet);
+
+		// Rewrite the packet as a Consumer would do.
+		packet->SetSequenceNumber(5);
+		packet->SetTimestamp(1234);
+
+		REQUIRE(retransmissionCache.StoreCurrentPacket(packet, 2000u) == 1000);
+		REQUIRE(retransmissionCache.StoreCurrentPacket(packet, 2000u) == 1000);
+		REQUIRE(retransmissionCache.GetPacketCount() == 1);
+
+		auto* storedPacket = retransmissionCache.Get(1000);
+
+		REQUIRE(storedPacket);
+		REQUIRE(storedPacket != packet);
+		REQUIRE(storedPacket->GetSequenceNumber() == 1000);
+		REQUIRE(storedPacket->GetTimestamp() == 1533790901);
+		REQUIRE(retransmissionCache.Get(999) == nullptr);
+		REQUIRE(retransmissionCache.Get(1001) == nullptr);
+	}
+
+	SECTION("packets are kept for the largest retransmission buffer size")
+	{
+		RtpRetransmissionCache retransmissionCache(90000);
+
+		// 100 ms at 90000 Hz.
+		StorePacket(retransmissionCache, packet, 1000, 1533790901, 200u);
+		StorePacket(retransmissionCache, packet, 1001, 1533790901 + 9000, 200u);
+
+		REQUIRE(retransmissionCache.GetPacketCount() == 2);
+
+		StorePacket(retransmissionCache, packet, 1002, 1533790901 + 18000, 200u);
+
+		REQUIRE(retransmissionCache.GetPacketCount() == 2);
+		REQUIRE(retransmissionCache.Get(1000) == nullptr);
+
+		// Another stream with a larger retransmission buffer size stores the
+		// packet, so older packets are kept for it.
+		packet->SetSequenceNumber(1003);
+		packet->SetTimestamp(1533790901 + 27000);
+
+		retransmissionCache.SetCurrentPacket(packet);
+		retransmissionCache.StoreCurrentPacket(packet, 200u);
+		retransmissionCache.StoreCurrentPacket(packet, 1000u);
+
+		REQUIRE(retransmissionCache.GetPacketCount() == 2);
+
+		StorePacket(retransmissionCache, packet, 1004, 1533790901 + 36000, 200u);
+
+		REQUIRE(retransmissionCache.GetPacketCount() == 3);
+		REQUIRE(retransmissionCache.Get(1002) != nullptr);
+	}
+
+	SECTION("memory is accounted worker wide")
+	{
+		REQUIRE(RtpRetransmissionCache::GetTotalMemory() == 0);
+
+		{
+			RtpRetransmissionCache retransmissionCache1(90000);
+			RtpRetransmissionCache retransmissionCache2(90000);
+
+			StorePacket(retransmissionCache1, packet, 1000, 1533790901);
+			StorePacket(retransmissionCache2, packet, 2000, 1533790901);
+			StorePacket(retransmissionCache2, packet, 2001, 1533790901);
+
+			REQUIRE(retransmissionCache1.GetMemory() > 0);
+			REQUIRE(retransmissionCache2.GetMemory() == 2 * retransmissionCache1.GetMemory());
+			REQUIRE(
+			  RtpRetransmissionCache::GetTotalMemory() ==
+			  retransmissionCache1.GetMemory() + retransmissionCache2.GetMemory());
+
+			retransmissionCache2.Clear();
+
+			REQUIRE(RtpRetransmissionCache::GetTotalMemory() == retransmissionCache1.GetMemory());
+		}
+
+		REQUIRE(RtpRetransmissionCache::GetTotalMemory() == 0);
+	}
+
+	SECTION("oldest packets are evicted once retransmissionBufferMaxMemory is reached")
+	{
+		RtpRetransmissionCache retransmissionCache1(90000);
+		RtpRetransmissionCache retransmissionCache2(90000);
+
+		StorePacket(retransmissionCache1, packet, 1000, 1533790901);
+
+		auto packetMemory       = retransmissionCache1.GetMemory();
+		auto evictedPacketCount = RtpRetransmissionCache::GetEvictedPacketCount();
+		auto previousMaxMemory  = Settings::configuration.retransmissionBufferMaxMemory;
+		auto& maxMemory         = Settings::configuration.retransmissionBufferMaxMemory;
+
+		maxMemory = 3 * packetMemory;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+		StorePacket(retransmissionCache2, packet, 2000, 1533790901);
+		StorePacket(retransmissionCache1, packet, 1001, 1533790901);
+
+		REQUIRE(RtpRetransmissionCache::GetTotalMemory() == 3 * packetMemory);
+		REQUIRE(RtpRetransmissionCache::GetEvictedPacketCount() == evictedPacketCount);
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+		// The oldest packet (first one in retransmissionCache1) must be evicted.
+		StorePacket(retransmissionCache2, packet, 2001, 1533790901);
+
+		REQUIRE(RtpRetransmissionCache::GetTotalMemory() == 3 * packetMemory);
+		REQUIRE(RtpRetransmissionCache::GetEvictedPacketCount() == evictedPacketCount + 1);
+		REQUIRE(retransmissionCache1.Get(1000) == nullptr);
+		REQUIRE(retransmissionCache1.Get(1001) != nullptr);
+		REQUIRE(retransmissionCache2.Get(2000) != nullptr);
+		REQUIRE(retransmissionCache2.Get(2001) != nullptr);
+
+		// Reducing the limit evicts as many packets as needed.
+		maxMemory = 1 * packetMemory;
+
+		StorePacket(retransmissionCache1, packet, 1002, 1533790901);
+
+		REQUIRE(RtpRetransmissionCache::GetTotalMemory() == packetMemory);
+		REQUIRE(RtpRetransmissionCache::GetEvictedPacketCount() == evictedPacketCount + 4);
+		REQUIRE(retransmissionCache1.GetPacketCount() == 1);
+		REQUIRE(retransmissionCache1.Get(1002) != nullptr);
+		REQUIRE(retransmissionCache2.GetPacketCount() == 0);
+
+		maxMemory = previousMaxMemory;
+	}
+
+	SECTION("oldest packet is still found once instances are cleared or destroyed")
+	{
+		RtpRetransmissionCache retransmissionCache1(90000);
+		auto* retransmissionCache2 = new RtpRetransmissionCache(90000);
+		RtpRetransmissionCache retransmissionCache3(90000);
+
+		StorePacket(*retransmissionCache2, packet, 2000, 1533790901);
+
+		auto packetMemory       = retransmissionCache2->GetMemory();
+		auto evictedPacketCount = RtpRetransmissionCache::GetEvictedPacketCount();
+		auto previousMaxMemory  = Settings::configuration.retransmissionBufferMaxMemory;
+		auto& maxMemory         = Settings::configuration.retransmissionBufferMaxMemory;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+		StorePacket(retransmissionCache1, packet, 1000, 1533790901);
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+		StorePacket(retransmissionCache3, packet, 3000, 1533790901);
+
+		delete retransmissionCache2;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+		// The oldest remaining packet is the one in retransmissionCache1.
+		maxMemory = 2 * packetMemory;
+
+		StorePacket(retransmissionCache3, packet, 3001, 1533790901);
+
+		REQUIRE(RtpRetransmissionCache::GetEvictedPacketCount() == evictedPacketCount + 1);
+		REQUIRE(retransmissionCache1.GetPacketCount() == 0);
+		REQUIRE(retransmissionCache3.GetPacketCount() == 2);
+
+		retransmissionCache3.Clear();
+
+		StorePacket(retransmissionCache1, packet, 1001, 1533790901);
+		StorePacket(retransmissionCache1, packet, 1002, 1533790901);
+		StorePacket(retransmissionCache1, packet, 1003, 1533790901);
+
+		REQUIRE(RtpRetransmissionCache::GetEvictedPacketCount() == evictedPacketCount + 2);
+		REQUIRE(retransmissionCache1.Get(1001) == nullptr);
+		REQUIRE(retransmissionCache1.Get(1003) != nullptr);
+
+		maxMemory = previousMaxMemory;
+	}
+
+	delete packet;
+}
@@ -4,6 +4,7 @@
 #include "RTC/RtpStream.hpp"
 #include "RTC/RtpStreamRecv.hpp"
 #include <catch2/catch.hpp>
+#include <memory> // std::unique_ptr
 #include <vector>
 
 using namespace RTC;
@@ -203,6 +204,31 @@ SCENARIO("receive RTP packets and trigger NACK", "[rtp][rtpstream]")
 		rtpStream.ReceivePacket(packet);
 	}
 
+	SECTION("continue imported sequence state")
+	{
+		RtpStreamRecvListener listener;
+		RtpStreamRecv rtpStream(&listener, params, SendNackDelay);
+		RtpStream::SeqState seqState;
+
+		seqState.maxSeq      = 0xffff;
+		seqState.cycles      = 3u << 16;
+		seqState.maxPacketTs = 4u;
+
+		rtpStream.SetSeqState(seqState);
+
+		REQUIRE(rtpStream.IsStarted());
+
+		packet->SetSequenceNumber(0);
+		rtpStream.ReceivePacket(packet);
+
+		// New cycle and nothing lost.
+		std::unique_ptr<RTCP::ReceiverReport> report(rtpStream.GetRtcpReceiverReport());
+
+		REQUIRE(report->GetLastSeq() == (4u << 16));
+		REQUIRE(report->GetTotalLost() == 0);
+		REQUIRE(report->GetFractionLost() == 0);
+	}
+
 	// Must run the loop to wait for UV timers and close them.
 	DepLibUV::RunLoop();
 
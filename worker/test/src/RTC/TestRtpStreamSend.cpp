@@ -1,6 +1,8 @@
 #include "common.hpp"
+#include "Utils.hpp"
 #include "RTC/RTCP/FeedbackRtpNack.hpp"
 #include "RTC/RtpPacket.hpp"
+#include "RTC/RtpRetransmissionCache.hpp"
 #include "RTC/RtpStream.hpp"
 #include "RTC/RtpStreamSend.hpp"
 #include <catch2/catch.hpp>
@@ -20,14 +22,17 @@ static RtpPacket* CreateRtpPacket(uint8_t* buffer, uint16_t seq, uint32_t timest
 	return packet;
 }
 
-static void SendRtpPacket(std::vector<std::pair<RtpStreamSend*, uint32_t>> streams, RtpPacket* packet)
+static void SendRtpPacket(
+  std::vector<std::pair<RtpStreamSend*, uint32_t>> streams,
+  RtpPacket* packet,
+  RtpRetransmissionCache& retransmissionCache)
 {
-	std::shared_ptr<RtpPacket> sharedPacket;
+	retransmissionCache.SetCurrentPacket(packet);
 
 	for (auto& stream : streams)
 	{
 		packet->SetSsrc(stream.second);
-		stream.first->ReceivePacket(packet, sharedPacket);
+		stream.first->ReceivePacket(packet, std::addressof(retransmissionCache));
 	}
 }
 
@@ -99,16 +104,17 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 		params.mimeType.type = RTC::RtpCodecMimeType::Type::VIDEO;
 
 		std::string mid;
+		RtpRetransmissionCache retransmissionCache(params.clockRate);
 		RtpStreamSend* stream = new RtpStreamSend(&testRtpStreamListener, params, mid);
 
 		// Receive all the packets (some of them not in order and/or duplicated).
-		SendRtpPacket({ { stream, params.ssrc } }, packet1);
-		SendRtpPacket({ { stream, params.ssrc } }, packet3);
-		SendRtpPacket({ { stream, params.ssrc } }, packet2);
-		SendRtpPacket({ { stream, params.ssrc } }, packet3);
-		SendRtpPacket({ { stream, params.ssrc } }, packet4);
-		SendRtpPacket({ { stream, params.ssrc } }, packet5);
-		SendRtpPacket({ { stream, params.ssrc } }, packet5);
+		SendRtpPacket({ { stream, params.ssrc } }, packet1, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet3, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet2, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet3, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet4, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet5, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet5, retransmissionCache);
 
 		// Create a NACK item that request for all the packets.
 		RTCP::FeedbackRtpNackPacket nackPacket(0, params.ssrc);
@@ -164,16 +170,17 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 		params.mimeType.type = RTC::RtpCodecMimeType::Type::VIDEO;
 
 		std::string mid;
+		RtpRetransmissionCache retransmissionCache(params.clockRate);
 		RtpStreamSend* stream = new RtpStreamSend(&testRtpStreamListener, params, mid);
 
 		// Receive all the packets (some of them not in order and/or duplicated).
-		SendRtpPacket({ { stream, params.ssrc } }, packet1);
-		SendRtpPacket({ { stream, params.ssrc } }, packet3);
-		SendRtpPacket({ { stream, params.ssrc } }, packet2);
-		SendRtpPacket({ { stream, params.ssrc } }, packet3);
-		SendRtpPacket({ { stream, params.ssrc } }, packet4);
-		SendRtpPacket({ { stream, params.ssrc } }, packet5);
-		SendRtpPacket({ { stream, params.ssrc } }, packet5);
+		SendRtpPacket({ { stream, params.ssrc } }, packet1, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet3, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet2, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet3, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet4, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet5, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet5, retransmissionCache);
 
 		// Create a NACK item that request for all the packets.
 		RTCP::FeedbackRtpNackPacket nackPacket(0, params.ssrc);
@@ -217,16 +224,17 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 		params.mimeType.type = RTC::RtpCodecMimeType::Type::AUDIO;
 
 		std::string mid;
+		RtpRetransmissionCache retransmissionCache(params.clockRate);
 		RtpStreamSend* stream = new RtpStreamSend(&testRtpStreamListener, params, mid);
 
 		// Receive all the packets (some of them not in order and/or duplicated).
-		SendRtpPacket({ { stream, params.ssrc } }, packet1);
-		SendRtpPacket({ { stream, params.ssrc } }, packet3);
-		SendRtpPacket({ { stream, params.ssrc } }, packet2);
-		SendRtpPacket({ { stream, params.ssrc } }, packet3);
-		SendRtpPacket({ { stream, params.ssrc } }, packet4);
-		SendRtpPacket({ { stream, params.ssrc } }, packet5);
-		SendRtpPacket({ { stream, params.ssrc } }, packet5);
+		SendRtpPacket({ { stream, params.ssrc } }, packet1, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet3, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet2, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet3, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet4, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet5, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet5, retransmissionCache);
 
 		// Create a NACK item that request for all the packets.
 		RTCP::FeedbackRtpNackPacket nackPacket(0, params.ssrc);
@@ -265,6 +273,7 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 		params1.mimeType.type = RTC::RtpCodecMimeType::Type::VIDEO;
 
 		std::string mid;
+		RtpRetransmissionCache retransmissionCache(params1.clockRate);
 		RtpStreamSend* stream1 = new RtpStreamSend(&testRtpStreamListener1, params1, mid);
 
 		RtpStream::Params params2;
@@ -277,8 +286,13 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 		RtpStreamSend* stream2 = new RtpStreamSend(&testRtpStreamListener2, params2, mid);
 
 		// Receive all the packets in both streams.
-		SendRtpPacket({ { stream1, params1.ssrc }, { stream2, params2.ssrc } }, packet1);
-		SendRtpPacket({ { stream1, params1.ssrc }, { stream2, params2.ssrc } }, packet2);
+		SendRtpPacket(
+		  { { stream1, params1.ssrc }, { stream2, params2.ssrc } }, packet1, retransmissionCache);
+		SendRtpPacket(
+		  { { stream1, params1.ssrc }, { stream2, params2.ssrc } }, packet2, retransmissionCache);
+
+		// Packets are stored just once regardless of the number of streams.
+		REQUIRE(retransmissionCache.GetPacketCount() == 2);
 
 		// Create a NACK item that request for all the packets.
 		RTCP::FeedbackRtpNackPacket nackPacket(0, params1.ssrc);
@@ -340,11 +354,12 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 		params1.mimeType.type = RTC::RtpCodecMimeType::Type::VIDEO;
 
 		std::string mid;
+		RtpRetransmissionCache retransmissionCache(params1.clockRate);
 		RtpStreamSend* stream = new RtpStreamSend(&testRtpStreamListener1, params1, mid);
 
 		// Receive all the packets.
-		SendRtpPacket({ { stream, params1.ssrc } }, packet1);
-		SendRtpPacket({ { stream, params1.ssrc } }, packet2);
+		SendRtpPacket({ { stream, params1.ssrc } }, packet1, retransmissionCache);
+		SendRtpPacket({ { stream, params1.ssrc } }, packet2, retransmissionCache);
 
 		// Create a NACK item that request for all the packets.
 		RTCP::FeedbackRtpNackPacket nackPacket(0, params1.ssrc);
@@ -392,11 +407,12 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 		params1.mimeType.type = RTC::RtpCodecMimeType::Type::VIDEO;
 
 		std::string mid;
+		RtpRetransmissionCache retransmissionCache(params1.clockRate);
 		RtpStreamSend* stream = new RtpStreamSend(&testRtpStreamListener1, params1, mid);
 
 		// Receive all the packets.
-		SendRtpPacket({ { stream, params1.ssrc } }, packet1);
-		SendRtpPacket({ { stream, params1.ssrc } }, packet2);
+		SendRtpPacket({ { stream, params1.ssrc } }, packet1, retransmissionCache);
+		SendRtpPacket({ { stream, params1.ssrc } }, packet2, retransmissionCache);
 
 		// Create a NACK item that request for all the packets.
 		RTCP::FeedbackRtpNackPacket nackPacket(0, params1.ssrc);
@@ -421,6 +437,83 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 		delete stream;
 	}
 
+	SECTION("get RTX copies of stored packets as padding")
+	{
+		auto packet1 = CreateRtpPacket(rtpBuffer2, 21006, 1533790901);
+		auto packet2 = CreateRtpPacket(rtpBuffer3, 21007, 1533790901);
+		auto packet3 = CreateRtpPacket(rtpBuffer4, 21008, 1533793871);
+
+		packet1->SetPayloadLength(100);
+		packet2->SetPayloadLength(400);
+		packet3->SetPayloadLength(1000);
+
+		// Create a RtpStreamSend instance.
+		TestRtpStreamListener testRtpStreamListener;
+
+		RtpStream::Params params;
+
+		params.ssrc          = 1111;
+		params.clockRate     = 90000;
+		params.useNack       = true;
+		params.mimeType.type = RTC::RtpCodecMimeType::Type::VIDEO;
+
+		std::string mid;
+		RtpRetransmissionCache retransmissionCache(params.clockRate);
+		RtpStreamSend* stream = new RtpStreamSend(&testRtpStreamListener, params, mid);
+
+		SendRtpPacket({ { stream, params.ssrc } }, packet1, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet2, retransmissionCache);
+		SendRtpPacket({ { stream, params.ssrc } }, packet3, retransmissionCache);
+
+		// No padding packets without RTX.
+		REQUIRE(!stream->GetRtxPaddingPacket(1000));
+
+		stream->SetRtx(124, 2222);
+
+		// The closest one to the given size first, then those not padded yet.
+		auto* paddingPacket = stream->GetRtxPaddingPacket(1000);
+
+		REQUIRE(paddingPacket);
+		REQUIRE(paddingPacket->GetSsrc() == 2222);
+		REQUIRE(paddingPacket->GetPayloadType() == 124);
+		REQUIRE(paddingPacket->GetTimestamp() == packet3->GetTimestamp());
+		REQUIRE(paddingPacket->GetSize() == packet3->GetSize() + 2);
+		REQUIRE(Utils::Byte::Get2Bytes(paddingPacket->GetPayload(), 0) == 21008);
+
+		auto rtxSeq = paddingPacket->GetSequenceNumber();
+
+		paddingPacket = stream->GetRtxPaddingPacket(1000);
+
+		REQUIRE(paddingPacket->GetSequenceNumber() == static_cast<uint16_t>(rtxSeq + 1));
+		REQUIRE(Utils::Byte::Get2Bytes(paddingPacket->GetPayload(), 0) == 21007);
+
+		paddingPacket = stream->GetRtxPaddingPacket(1000);
+
+		REQUIRE(Utils::Byte::Get2Bytes(paddingPacket->GetPayload(), 0) == 21006);
+
+		paddingPacket = stream->GetRtxPaddingPacket(1000);
+
+		REQUIRE(Utils::Byte::Get2Bytes(paddingPacket->GetPayload(), 0) == 21008);
+
+		// Stored packets are not modified.
+		RTCP::FeedbackRtpNackPacket nackPacket(0, params.ssrc);
+		auto* nackItem = new RTCP::FeedbackRtpNackItem(21008, 0b0000000000000000);
+
+		nackPacket.AddItem(nackItem);
+
+		stream->ReceiveNack(&nackPacket);
+
+		REQUIRE(testRtpStreamListener.retransmittedPackets.size() == 1);
+
+		auto* rtxPacket = testRtpStreamListener.retransmittedPackets[0];
+
+		CheckRtxPacket(rtxPacket, packet3->GetSequenceNumber(), packet3->GetTimestamp());
+		REQUIRE(rtxPacket->GetSize() == packet3->GetSize());
+		REQUIRE(rtxPacket->GetSsrc() == params.ssrc);
+
+		delete stream;
+	}
+
 #ifdef PERFORMANCE_TEST
 	SECTION("Performance")
 	{
@@ -436,6 +529,7 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 
 		std::string mid;
 		RtpStreamSend* stream = new RtpStreamSend(&testRtpStreamListener, params, mid);
+		RtpRetransmissionCache retransmissionCache(params.clockRate);
 
 		size_t iterations = 10000000;
 
@@ -447,13 +541,14 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 			auto* packet = RtpPacket::Parse(rtpBuffer1, 1500);
 			packet->SetSsrc(1111);
 
-			std::shared_ptr<RtpPacket> sharedPacket(packet);
+			retransmissionCache.SetCurrentPacket(packet);
+			stream->ReceivePacket(packet, std::addressof(retransmissionCache));
 
-			stream->ReceivePacket(packet, sharedPacket);
+			delete packet;
 		}
 
 		std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
-		std::cout << "nullptr && initialized shared_ptr: \t" << dur.count() << " seconds" << std::endl;
+		std::cout << "video (stored packets): \t" << dur.count() << " seconds" << std::endl;
 
 		delete stream;
 
@@ -464,17 +559,18 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 
 		for (size_t i = 0; i < iterations; i++)
 		{
-			std::shared_ptr<RtpPacket> sharedPacket;
-
 			// Create packet.
 			auto* packet = RtpPacket::Parse(rtpBuffer1, 1500);
 			packet->SetSsrc(1111);
 
-			stream->ReceivePacket(packet, sharedPacket);
+			retransmissionCache.SetCurrentPacket(packet);
+			stream->ReceivePacket(packet, std::addressof(retransmissionCache));
+
+			delete packet;
 		}
 
 		dur = std::chrono::system_clock::now() - start;
-		std::cout << "raw && empty shared_ptr duration: \t" << dur.count() << " seconds" << std::endl;
+		std::cout << "audio (no stored packets): \t" << dur.count() << " seconds" << std::endl;
 
 		delete stream;
 	}
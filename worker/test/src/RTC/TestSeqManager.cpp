@@ -287,6 +287,54 @@ SCENARIO("SeqManager", "[rtc]")
 		validate(seqManager, inputs);
 	}
 
+	SECTION("offset outputs are not reused after sync")
+	{
+		SeqManager<uint16_t> seqManager;
+		uint16_t output;
+
+		seqManager.Input(10, output);
+
+		REQUIRE(output == 10);
+
+		// Outputs 11 and 12 are taken by other packets (i.e. FEC packets sent
+		// after the media packet).
+		seqManager.Offset(2);
+
+		REQUIRE(seqManager.GetMaxOutput() == 12);
+
+		// Sync right after them (i.e. a key frame after a stream switch).
+		seqManager.Sync(499);
+		seqManager.Input(500, output);
+
+		REQUIRE(output == 13);
+
+		seqManager.Input(501, output);
+
+		REQUIRE(output == 14);
+	}
+
+	SECTION("restored outputs continue after sync")
+	{
+		SeqManager<uint16_t> seqManager;
+		uint16_t output;
+
+		// State of a SeqManager in another worker.
+		seqManager.Restore(1000, 65535);
+
+		REQUIRE(seqManager.GetBase() == 1000);
+		REQUIRE(seqManager.GetMaxInput() == 64535);
+
+		seqManager.Input(64536, output);
+
+		REQUIRE(output == 0);
+
+		// Sync with a different input (i.e. a key frame of a new Producer stream).
+		seqManager.Sync(99);
+		seqManager.Input(100, output);
+
+		REQUIRE(output == 1);
+	}
+
 	SECTION("drop many inputs at the beginning (using uint16_t)")
 	{
 		// clang-format off
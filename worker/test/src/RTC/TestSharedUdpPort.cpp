@@ -0,0 +1,184 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/SharedUdpPort.hpp"
+#include "RTC/UdpSocket.hpp"
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace RTC;
+
+namespace
+{
+	class TestUdpSocketListener : public UdpSocket::Listener
+	{
+	public:
+		void OnUdpSocketPacketReceived(
+		  UdpSocket* /*socket*/,
+		  const uint8_t* /*data*/,
+		  size_t /*len*/,
+		  const struct sockaddr* /*remoteAddr*/) override
+		{
+		}
+	};
+
+	class TestSharedUdpPortListener : public SharedUdpPort::Listener
+	{
+	public:
+		void OnSharedUdpPortPacketReceived(
+		  SharedUdpPort* /*sharedUdpPort*/,
+		  const uint8_t* data,
+		  size_t len,
+		  const struct sockaddr* /*remoteAddr*/) override
+		{
+			this->packets.emplace_back(data, data + len);
+		}
+
+	public:
+		std::vector<std::vector<uint8_t>> packets;
+	};
+} // namespace
+
+SCENARIO("Shared UDP port", "[sharedudpport]")
+{
+	std::string ip{ "127.0.0.1" };
+	uint16_t port{ 43100u };
+	TestUdpSocketListener udpSocketListener;
+	TestSharedUdpPortListener listener1;
+	TestSharedUdpPortListener listener2;
+	struct sockaddr_in remoteAddr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+	uint8_t data[] = { 0x01, 0x02, 0x03, 0x04 };
+
+	uv_ip4_addr("127.0.0.1", 5000, &remoteAddr);
+
+	// Both sockets are bound to the same IP and port.
+	UdpSocket udpSocket1(&udpSocketListener, ip, port, true);
+	UdpSocket udpSocket2(&udpSocketListener, ip, port, true);
+
+	SECTION("packets are forwarded to the member owning the usernameFragment or tuple")
+	{
+		auto* sharedUdpPort1 = new SharedUdpPort(&listener1, &udpSocket1);
+		auto* sharedUdpPort2 = new SharedUdpPort(&listener2, &udpSocket2);
+
+		// Nobody owns them yet.
+		REQUIRE(!sharedUdpPort2->ForwardStunPacket(
+		  "foo", 1234u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+
+		sharedUdpPort1->AddLocalIceUsernameFragment("foo");
+
+		REQUIRE(sharedUdpPort2->ForwardStunPacket(
+		  "foo", 1234u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+
+		// A member does not forward to itself.
+		REQUIRE(!sharedUdpPort1->ForwardStunPacket(
+		  "foo", 1234u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+
+		REQUIRE(!sharedUdpPort2->ForwardNonStunPacket(
+		  1234u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+
+		sharedUdpPort1->AddTuple(1234u);
+
+		REQUIRE(sharedUdpPort2->ForwardNonStunPacket(
+		  1234u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(listener1.packets.size() == 2u);
+		REQUIRE(listener1.packets[0] == std::vector<uint8_t>(data, data + sizeof(data)));
+		REQUIRE(listener2.packets.empty());
+
+		// Entries are gone once the member leaves.
+		delete sharedUdpPort1;
+
+		REQUIRE(!sharedUdpPort2->ForwardNonStunPacket(
+		  1234u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+
+		delete sharedUdpPort2;
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+
+	SECTION("members not forwarding for a long time catch up with the owners")
+	{
+		auto* sharedUdpPort1 = new SharedUdpPort(&listener1, &udpSocket1);
+		auto* sharedUdpPort2 = new SharedUdpPort(&listener2, &udpSocket2);
+
+		sharedUdpPort1->AddTuple(1u);
+
+		// Applies the pending change.
+		REQUIRE(sharedUdpPort2->ForwardNonStunPacket(
+		  1u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+
+		// More changes than those kept for members to catch up.
+		for (uint64_t tupleHash{ 2u }; tupleHash < 5000u; ++tupleHash)
+		{
+			sharedUdpPort1->AddTuple(tupleHash);
+		}
+
+		sharedUdpPort1->RemoveTuple(1u);
+
+		REQUIRE(!sharedUdpPort2->ForwardNonStunPacket(
+		  1u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+		REQUIRE(sharedUdpPort2->ForwardNonStunPacket(
+		  2u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+		REQUIRE(sharedUdpPort2->ForwardNonStunPacket(
+		  4999u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)));
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(listener1.packets.size() == 3u);
+
+		delete sharedUdpPort1;
+		delete sharedUdpPort2;
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+
+	SECTION("owners can change and leave while another thread forwards packets")
+	{
+		auto* sharedUdpPort1 = new SharedUdpPort(&listener1, &udpSocket1);
+		auto* sharedUdpPort2 = new SharedUdpPort(&listener2, &udpSocket2);
+		std::atomic<bool> stop{ false };
+		std::atomic<size_t> forwarded{ 0u };
+
+		sharedUdpPort1->AddTuple(1234u);
+
+		std::thread forwarder(
+		  [&]()
+		  {
+			  while (!stop.load())
+			  {
+				  if (sharedUdpPort2->ForwardNonStunPacket(
+				        1234u, data, sizeof(data), reinterpret_cast<const struct sockaddr*>(&remoteAddr)))
+				  {
+					  ++forwarded;
+				  }
+			  }
+		  });
+
+		for (size_t i{ 0u }; i < 1000u; ++i)
+		{
+			sharedUdpPort1->RemoveTuple(1234u);
+			sharedUdpPort1->AddTuple(1234u);
+
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		}
+
+		// The forwarding thread may still write into its mailbox until it sees the
+		// member has left.
+		delete sharedUdpPort1;
+
+		stop = true;
+		forwarder.join();
+
+		REQUIRE(forwarded.load() > 0u);
+		REQUIRE(listener1.packets.size() <= forwarded.load());
+		REQUIRE(listener2.packets.empty());
+
+		delete sharedUdpPort2;
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+}
@@ -0,0 +1,145 @@
+#include "common.hpp"
+#include "Utils.hpp"
+#include "RTC/SrtpSession.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcmp()
+#include <vector>
+
+using namespace RTC;
+
+namespace
+{
+	constexpr uint32_t Ssrc{ 1234567u };
+
+	// RTP packet with seq 1000 and ssrc 1234567.
+	// clang-format off
+	uint8_t rtpPacket[] =
+	{
+		0x80, 0x01, 0x03, 0xe8,
+		0x00, 0x00, 0x00, 0x01,
+		0x00, 0x12, 0xd6, 0x87,
+		0x11, 0x22, 0x33, 0x44,
+		0x55, 0x66, 0x77, 0x88
+	};
+
+	// RTCP Receiver Report with no report blocks and sender ssrc 1234567.
+	uint8_t rtcpPacket[] =
+	{
+		0x80, 0xc9, 0x00, 0x01,
+		0x00, 0x12, 0xd6, 0x87
+	};
+	// clang-format on
+
+	std::vector<uint8_t> Encrypt(SrtpSession& session)
+	{
+		const uint8_t* data = rtpPacket;
+		int len             = sizeof(rtpPacket);
+
+		REQUIRE(session.EncryptRtp(&data, &len));
+
+		return std::vector<uint8_t>(data, data + len);
+	}
+
+	std::vector<uint8_t> EncryptRtcp(SrtpSession& session)
+	{
+		const uint8_t* data = rtcpPacket;
+		int len             = sizeof(rtcpPacket);
+
+		REQUIRE(session.EncryptRtcp(&data, &len));
+
+		return std::vector<uint8_t>(data, data + len);
+	}
+
+	SrtpSession::StreamState MakeStreamState(uint32_t roc, uint32_t rtcpIndex)
+	{
+		SrtpSession::StreamState state;
+
+		state.ssrc      = Ssrc;
+		state.roc       = roc;
+		state.rtcpIndex = rtcpIndex;
+
+		return state;
+	}
+} // namespace
+
+SCENARIO("SRTP session", "[srtp]")
+{
+	auto cryptoSuite = SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_80;
+	auto keyLen      = SrtpSession::GetMasterLength(cryptoSuite);
+	std::vector<uint8_t> key(keyLen);
+
+	Utils::Crypto::GetRandomString(keyLen).copy(reinterpret_cast<char*>(key.data()), keyLen);
+
+	SECTION("stream state is set and retrieved")
+	{
+		SrtpSession session(SrtpSession::Type::OUTBOUND, cryptoSuite, key.data(), keyLen);
+
+		REQUIRE(session.GetStreamStates({ Ssrc }).empty());
+
+		SrtpSession importedSession(
+		  SrtpSession::Type::OUTBOUND, cryptoSuite, key.data(), keyLen, { MakeStreamState(5u, 42u) });
+
+		// The ROC is applied with the first packet.
+		Encrypt(importedSession);
+
+		auto states = importedSession.GetStreamStates({ Ssrc, 1u });
+
+		REQUIRE(states.size() == 1);
+		REQUIRE(states[0].ssrc == Ssrc);
+		REQUIRE(states[0].roc == 5u);
+		REQUIRE(states[0].rtcpIndex == 42u);
+		REQUIRE(importedSession.GetCryptoSuite() == cryptoSuite);
+	}
+
+	SECTION("imported state is needed to decrypt a migrated stream")
+	{
+		SrtpSession sendSession(
+		  SrtpSession::Type::OUTBOUND, cryptoSuite, key.data(), keyLen, { MakeStreamState(3u, 0u) });
+
+		auto srtpPacket = Encrypt(sendSession);
+
+		SrtpSession recvSession(SrtpSession::Type::INBOUND, cryptoSuite, key.data(), keyLen);
+		auto packet = srtpPacket;
+		int len     = static_cast<int>(packet.size());
+
+		// Without the ROC the authentication tag does not match.
+		REQUIRE(!recvSession.DecryptSrtp(packet.data(), &len));
+
+		SrtpSession importedRecvSession(
+		  SrtpSession::Type::INBOUND, cryptoSuite, key.data(), keyLen, { MakeStreamState(3u, 0u) });
+
+		packet = srtpPacket;
+		len    = static_cast<int>(packet.size());
+
+		REQUIRE(importedRecvSession.DecryptSrtp(packet.data(), &len));
+		REQUIRE(static_cast<size_t>(len) == sizeof(rtpPacket));
+		REQUIRE(std::memcmp(packet.data(), rtpPacket, len) == 0);
+		REQUIRE(importedRecvSession.GetStreamStates({ Ssrc })[0].roc == 3u);
+	}
+
+	SECTION("imported SRTCP index continues")
+	{
+		SrtpSession sendSession(
+		  SrtpSession::Type::OUTBOUND, cryptoSuite, key.data(), keyLen, { MakeStreamState(0u, 100u) });
+
+		auto srtcpPacket = EncryptRtcp(sendSession);
+		// E flag and SRTCP index, followed by the 10 bytes authentication tag.
+		auto* trailer = srtcpPacket.data() + srtcpPacket.size() - 14;
+
+		REQUIRE((Utils::Byte::Get4Bytes(trailer, 0) & 0x7FFFFFFF) == 101u);
+
+		// RTCP only streams are also given.
+		auto states = sendSession.GetStreamStates({});
+
+		REQUIRE(states.size() == 1);
+		REQUIRE(states[0].ssrc == Ssrc);
+		REQUIRE(states[0].rtcpIndex == 101u);
+
+		SrtpSession recvSession(SrtpSession::Type::INBOUND, cryptoSuite, key.data(), keyLen);
+		auto packet = srtcpPacket;
+		int len     = static_cast<int>(packet.size());
+
+		REQUIRE(recvSession.DecryptSrtcp(packet.data(), &len));
+		REQUIRE(static_cast<size_t>(len) == sizeof(rtcpPacket));
+	}
+}
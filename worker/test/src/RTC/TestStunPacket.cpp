@@ -0,0 +1,246 @@
+#include "common.hpp"
+#include "Utils.hpp"
+#include "RTC/StunPacket.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcpy(), std::memcmp()
+#include <string>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <chrono>
+#include <iostream>
+#endif
+
+using namespace RTC;
+
+SCENARIO("STUN packet", "[stun]")
+{
+	// Sample request from RFC 5769 (section 2.1).
+	// - USERNAME: "evtj:h6vY"
+	// - password: "VOkJxbRl1RmTxUk/WvJxBt"
+	// clang-format off
+	uint8_t stunBuffer[] =
+	{
+		0x00, 0x01, 0x00, 0x58,
+		0x21, 0x12, 0xa4, 0x42,
+		0xb7, 0xe7, 0xa7, 0x01,
+		0xbc, 0x34, 0xd6, 0x86,
+		0xfa, 0x87, 0xdf, 0xae,
+		0x80, 0x22, 0x00, 0x10, // SOFTWARE.
+		0x53, 0x54, 0x55, 0x4e,
+		0x20, 0x74, 0x65, 0x73,
+		0x74, 0x20, 0x63, 0x6c,
+		0x69, 0x65, 0x6e, 0x74,
+		0x00, 0x24, 0x00, 0x04, // PRIORITY.
+		0x6e, 0x00, 0x01, 0xff,
+		0x80, 0x29, 0x00, 0x08, // ICE-CONTROLLED.
+		0x93, 0x2f, 0xf9, 0xb1,
+		0x51, 0x26, 0x3b, 0x36,
+		0x00, 0x06, 0x00, 0x09, // USERNAME.
+		0x65, 0x76, 0x74, 0x6a,
+		0x3a, 0x68, 0x36, 0x76,
+		0x59, 0x20, 0x20, 0x20,
+		0x00, 0x08, 0x00, 0x14, // MESSAGE-INTEGRITY.
+		0x9a, 0xea, 0xa7, 0x0c,
+		0xbf, 0xd8, 0xcb, 0x56,
+		0x78, 0x1e, 0xf2, 0xb5,
+		0xb2, 0xd3, 0xf2, 0x49,
+		0xc1, 0xb5, 0x71, 0xa2,
+		0x80, 0x28, 0x00, 0x04, // FINGERPRINT.
+		0xe5, 0x7a, 0x3b, 0xcf
+	};
+	// clang-format on
+
+	const std::string password("VOkJxbRl1RmTxUk/WvJxBt");
+
+	uint8_t buffer[1500];
+
+	std::memcpy(buffer, stunBuffer, sizeof(stunBuffer));
+
+	Utils::Crypto::HmacSha1 hmacSha1;
+
+	hmacSha1.SetKey(password);
+
+	SECTION("parse sample request")
+	{
+		StunPacket packet;
+
+		REQUIRE(StunPacket::Parse(buffer, sizeof(stunBuffer), packet));
+		REQUIRE(packet.GetClass() == StunPacket::Class::REQUEST);
+		REQUIRE(packet.GetMethod() == StunPacket::Method::BINDING);
+		REQUIRE(packet.GetData() == buffer);
+		REQUIRE(packet.GetSize() == sizeof(stunBuffer));
+		REQUIRE(packet.GetUsername() == "evtj:h6vY");
+		REQUIRE(packet.GetPriority() == 0x6e0001ff);
+		REQUIRE(packet.GetIceControlled() == 0x932ff9b151263b36);
+		REQUIRE(packet.HasMessageIntegrity());
+		REQUIRE(packet.HasFingerprint());
+		REQUIRE(!packet.HasUseCandidate());
+	}
+
+	SECTION("parse fails on wrong data")
+	{
+		StunPacket packet;
+
+		// Length field does not match.
+		REQUIRE(!StunPacket::Parse(buffer, sizeof(stunBuffer) - 4, packet));
+
+		// Wrong FINGERPRINT.
+		buffer[sizeof(stunBuffer) - 1] ^= 0xff;
+
+		REQUIRE(!StunPacket::Parse(buffer, sizeof(stunBuffer), packet));
+	}
+
+	SECTION("check authentication")
+	{
+		StunPacket packet;
+
+		REQUIRE(StunPacket::Parse(buffer, sizeof(stunBuffer), packet));
+		REQUIRE(
+		  packet.CheckAuthentication("evtj", std::addressof(hmacSha1)) ==
+		  StunPacket::Authentication::OK);
+		// Data must be restored after checking authentication.
+		REQUIRE(std::memcmp(buffer, stunBuffer, sizeof(stunBuffer)) == 0);
+		// Same HMAC-SHA1 calculator can be used again.
+		REQUIRE(
+		  packet.CheckAuthentication("evtj", std::addressof(hmacSha1)) ==
+		  StunPacket::Authentication::OK);
+		REQUIRE(
+		  packet.CheckAuthentication("h6vY", std::addressof(hmacSha1)) ==
+		  StunPacket::Authentication::UNAUTHORIZED);
+
+		Utils::Crypto::HmacSha1 wrongHmacSha1;
+
+		wrongHmacSha1.SetKey("wrong password");
+
+		REQUIRE(
+		  packet.CheckAuthentication("evtj", std::addressof(wrongHmacSha1)) ==
+		  StunPacket::Authentication::UNAUTHORIZED);
+
+		// Keying it again with the right password must make it work.
+		wrongHmacSha1.SetKey(password);
+
+		REQUIRE(
+		  packet.CheckAuthentication("evtj", std::addressof(wrongHmacSha1)) ==
+		  StunPacket::Authentication::OK);
+	}
+
+	SECTION("authenticated success response is serialized and parsed back")
+	{
+		StunPacket packet;
+
+		REQUIRE(StunPacket::Parse(buffer, sizeof(stunBuffer), packet));
+
+		auto response = packet.CreateSuccessResponse();
+
+		struct sockaddr_in addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		std::memset(std::addressof(addr), 0, sizeof(addr));
+		addr.sin_family      = AF_INET;
+		addr.sin_port        = htons(32853);
+		addr.sin_addr.s_addr = htonl(0xc0000201);
+
+		response.SetXorMappedAddress(reinterpret_cast<const struct sockaddr*>(std::addressof(addr)));
+		response.Authenticate(std::addressof(hmacSha1));
+
+		uint8_t responseBuffer[1500];
+
+		response.Serialize(responseBuffer);
+
+		REQUIRE(response.GetData() == responseBuffer);
+		REQUIRE(response.HasMessageIntegrity());
+		REQUIRE(response.HasFingerprint());
+
+		StunPacket parsedResponse;
+
+		REQUIRE(StunPacket::Parse(responseBuffer, response.GetSize(), parsedResponse));
+		REQUIRE(parsedResponse.GetClass() == StunPacket::Class::SUCCESS_RESPONSE);
+		REQUIRE(parsedResponse.HasMessageIntegrity());
+		REQUIRE(parsedResponse.HasFingerprint());
+		// Transaction ID must match the one in the request.
+		REQUIRE(std::memcmp(responseBuffer + 8, stunBuffer + 8, 12) == 0);
+
+		// MESSAGE-INTEGRITY must be computed with the given HMAC-SHA1 calculator.
+		// Its attribute is located before the FINGERPRINT (8 bytes) one.
+		size_t messageIntegrityPos = response.GetSize() - 8 - 24;
+
+		Utils::Byte::Set2Bytes(responseBuffer, 2, static_cast<uint16_t>(response.GetSize() - 20 - 8));
+
+		const uint8_t* expected =
+		  Utils::Crypto::GetHmacSha1(password, responseBuffer, messageIntegrityPos);
+
+		REQUIRE(std::memcmp(responseBuffer + messageIntegrityPos + 4, expected, 20) == 0);
+	}
+
+	SECTION("error response has no MESSAGE-INTEGRITY")
+	{
+		StunPacket packet;
+
+		REQUIRE(StunPacket::Parse(buffer, sizeof(stunBuffer), packet));
+
+		auto response = packet.CreateErrorResponse(401);
+
+		response.Authenticate(std::addressof(hmacSha1));
+
+		uint8_t responseBuffer[1500];
+
+		response.Serialize(responseBuffer);
+
+		StunPacket parsedResponse;
+
+		REQUIRE(StunPacket::Parse(responseBuffer, response.GetSize(), parsedResponse));
+		REQUIRE(parsedResponse.GetClass() == StunPacket::Class::ERROR_RESPONSE);
+		REQUIRE(parsedResponse.GetErrorCode() == 401);
+		REQUIRE(!parsedResponse.HasMessageIntegrity());
+		REQUIRE(parsedResponse.HasFingerprint());
+	}
+
+	SECTION("HMAC-SHA1 calculator matches Utils::Crypto::GetHmacSha1()")
+	{
+		for (size_t len{ 0u }; len < sizeof(stunBuffer); len += 7)
+		{
+			uint8_t expected[20];
+
+			std::memcpy(expected, Utils::Crypto::GetHmacSha1(password, stunBuffer, len), 20);
+
+			REQUIRE(std::memcmp(hmacSha1.Compute(stunBuffer, len), expected, 20) == 0);
+		}
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		std::string localUsername("evtj");
+		size_t iterations = 1000000;
+
+		struct sockaddr_in addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		std::memset(std::addressof(addr), 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+
+		uint8_t responseBuffer[1500];
+
+		auto start = std::chrono::system_clock::now();
+
+		// Same processing as IceServer does for each received Binding request.
+		for (size_t i = 0; i < iterations; i++)
+		{
+			StunPacket packet;
+
+			StunPacket::Parse(buffer, sizeof(stunBuffer), packet);
+			packet.CheckAuthentication(localUsername, std::addressof(hmacSha1));
+
+			auto response = packet.CreateSuccessResponse();
+
+			response.SetXorMappedAddress(reinterpret_cast<const struct sockaddr*>(std::addressof(addr)));
+			response.Authenticate(std::addressof(hmacSha1));
+			response.Serialize(responseBuffer);
+		}
+
+		std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+		std::cout << "binding requests: \t" << dur.count() << " seconds ("
+		          << static_cast<uint64_t>(iterations / dur.count()) << " per second)" << std::endl;
+	}
+#endif
+}
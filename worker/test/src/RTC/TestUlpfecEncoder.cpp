@@ -0,0 +1,268 @@
+#include "common.hpp"
+#include "Utils.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpRedEncoder.hpp"
+#include "RTC/UlpfecEncoder.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcpy(), std::memcmp(), std::memset()
+#include <vector>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <chrono>
+#include <iostream>
+#endif
+
+using namespace RTC;
+
+namespace
+{
+	constexpr uint8_t VideoPayloadType{ 96u };
+	constexpr uint8_t RedPayloadType{ 110u };
+	constexpr uint8_t UlpfecPayloadType{ 111u };
+
+	struct SentPacket
+	{
+		uint8_t byte1;
+		std::vector<uint8_t> data;
+	};
+
+	void PreparePacket(RtpPacket* packet, uint16_t seq, size_t length, bool marker)
+	{
+		packet->SetSequenceNumber(seq);
+		packet->SetMarker(marker);
+		packet->SetPayloadLength(length);
+		std::memset(packet->GetPayload(), static_cast<uint8_t>(seq), length);
+	}
+
+	// Recovers the packet protected by the given FEC packet along with the given
+	// received ones.
+	SentPacket Recover(const RtpPacket* fecPacket, const std::vector<const SentPacket*>& received)
+	{
+		const auto* fecHeader = fecPacket->GetPayload() + 1;
+		auto lengthRecovery   = Utils::Byte::Get2Bytes(fecHeader, 8);
+		auto protectionLength = Utils::Byte::Get2Bytes(fecHeader, 10);
+		SentPacket recovered;
+
+		recovered.byte1 = fecHeader[1];
+		recovered.data.assign(fecHeader + 14, fecHeader + 14 + protectionLength);
+
+		for (const auto* sentPacket : received)
+		{
+			recovered.byte1 ^= sentPacket->byte1;
+			lengthRecovery ^= static_cast<uint16_t>(sentPacket->data.size());
+
+			for (size_t i{ 0u }; i < sentPacket->data.size(); ++i)
+			{
+				recovered.data[i] ^= sentPacket->data[i];
+			}
+		}
+
+		recovered.data.resize(lengthRecovery);
+
+		return recovered;
+	}
+} // namespace
+
+SCENARIO("ULPFEC encoder", "[rtp][fec]")
+{
+	// clang-format off
+	uint8_t rtpBuffer[] =
+	{
+		0b10000000, 0b01100000, 0b00000000, 0b00000001, // PT:96, seq:1.
+		0b00000000, 0b00000000, 0b00000000, 0b00000001,
+		0b00000000, 0b00000000, 0b00000000, 0b00000001,
+		0x11, 0x22, 0x33, 0x44 // Payload.
+	};
+	// clang-format on
+
+	uint8_t buffer[1500];
+
+	std::memcpy(buffer, rtpBuffer, sizeof(rtpBuffer));
+
+	auto* packet = RtpPacket::Parse(buffer, sizeof(rtpBuffer));
+
+	REQUIRE(packet);
+
+	SECTION("FEC packets are generated at the end of the frame")
+	{
+		UlpfecEncoder fecEncoder(RedPayloadType, UlpfecPayloadType);
+
+		fecEncoder.SetProtectionFactor(0.5f);
+
+		for (uint16_t seq{ 1u }; seq <= 4u; ++seq)
+		{
+			PreparePacket(packet, seq, 4u * seq, seq == 4u);
+
+			const auto& fecPackets = fecEncoder.AddPacket(packet);
+
+			if (seq < 4u)
+				REQUIRE(fecPackets.empty());
+			else
+				REQUIRE(fecPackets.size() == 2);
+		}
+
+		// Retransmitted packets are ignored.
+		PreparePacket(packet, 3u, 12u, false);
+
+		REQUIRE(fecEncoder.AddPacket(packet).empty());
+
+		// Single packet frames are grouped until a FEC packet is due.
+		PreparePacket(packet, 5u, 100u, true);
+
+		REQUIRE(fecEncoder.AddPacket(packet).empty());
+
+		PreparePacket(packet, 6u, 100u, true);
+
+		const auto& fecPackets = fecEncoder.AddPacket(packet);
+
+		REQUIRE(fecPackets.size() == 1);
+		REQUIRE(fecPackets[0]->GetSequenceNumber() == 7);
+		REQUIRE(Utils::Byte::Get2Bytes(fecPackets[0]->GetPayload() + 1, 2) == 5);
+		REQUIRE(Utils::Byte::Get2Bytes(fecPackets[0]->GetPayload() + 1, 12) == 0xC000);
+
+		// Groups do not span more than 16 packets.
+		fecEncoder.Reset();
+
+		for (uint16_t seq{ 1u }; seq <= 40u; ++seq)
+		{
+			PreparePacket(packet, seq, 100u, false);
+
+			if (seq % 16u == 0u)
+				REQUIRE(fecEncoder.AddPacket(packet).size() == 8);
+			else
+				REQUIRE(fecEncoder.AddPacket(packet).empty());
+		}
+	}
+
+	SECTION("FEC packets protect interleaved packets and allow recovering them")
+	{
+		UlpfecEncoder fecEncoder(RedPayloadType, UlpfecPayloadType);
+		std::vector<SentPacket> sentPackets;
+		std::vector<RtpPacket*> fecPackets;
+
+		fecEncoder.SetProtectionFactor(0.5f);
+
+		for (uint16_t seq{ 1u }; seq <= 4u; ++seq)
+		{
+			PreparePacket(packet, seq, 4u * seq, seq == 4u);
+
+			sentPackets.push_back(
+			  { packet->GetData()[1],
+			    std::vector<uint8_t>(packet->GetData() + 12, packet->GetData() + packet->GetSize()) });
+
+			fecPackets = fecEncoder.AddPacket(packet);
+		}
+
+		REQUIRE(fecPackets.size() == 2);
+
+		for (size_t i{ 0u }; i < fecPackets.size(); ++i)
+		{
+			const auto* fecPacket = fecPackets[i];
+			const auto* fecHeader = fecPacket->GetPayload() + 1;
+
+			REQUIRE(fecPacket->GetPayloadType() == RedPayloadType);
+			REQUIRE(fecPacket->GetSequenceNumber() == 5 + i);
+			REQUIRE(fecPacket->GetSsrc() == packet->GetSsrc());
+			REQUIRE(!fecPacket->HasMarker());
+			REQUIRE(fecPacket->GetPayload()[0] == UlpfecPayloadType);
+			REQUIRE((fecHeader[0] & 0xC0) == 0);
+			REQUIRE(Utils::Byte::Get2Bytes(fecHeader, 2) == 1);
+		}
+
+		// Packets 1 and 3 in the first FEC packet, 2 and 4 in the second one.
+		REQUIRE(Utils::Byte::Get2Bytes(fecPackets[0]->GetPayload() + 1, 10) == 12);
+		REQUIRE(Utils::Byte::Get2Bytes(fecPackets[0]->GetPayload() + 1, 12) == 0xA000);
+		REQUIRE(Utils::Byte::Get2Bytes(fecPackets[1]->GetPayload() + 1, 10) == 16);
+		REQUIRE(Utils::Byte::Get2Bytes(fecPackets[1]->GetPayload() + 1, 12) == 0x5000);
+
+		// Packet 3 is lost.
+		auto recovered = Recover(fecPackets[0], { &sentPackets[0] });
+
+		REQUIRE(recovered.byte1 == sentPackets[2].byte1);
+		REQUIRE(recovered.data == sentPackets[2].data);
+
+		// Packet 4 is lost (it has the marker bit).
+		recovered = Recover(fecPackets[1], { &sentPackets[1] });
+
+		REQUIRE(recovered.byte1 == (0x80 | VideoPayloadType));
+		REQUIRE(recovered.data == sentPackets[3].data);
+	}
+
+	SECTION("RED packets are protected once unwrapped")
+	{
+		RtpRedEncoder redEncoder(RedPayloadType, 0u);
+		UlpfecEncoder fecEncoder(RedPayloadType, UlpfecPayloadType);
+		std::vector<SentPacket> sentPackets;
+		std::vector<RtpPacket*> fecPackets;
+
+		fecEncoder.SetProtectionFactor(0.5f);
+
+		for (uint16_t seq{ 1u }; seq <= 2u; ++seq)
+		{
+			PreparePacket(packet, seq, 8u, seq == 2u);
+
+			sentPackets.push_back(
+			  { packet->GetData()[1],
+			    std::vector<uint8_t>(packet->GetData() + 12, packet->GetData() + packet->GetSize()) });
+
+			auto* redPacket = redEncoder.Encode(packet);
+
+			REQUIRE(redPacket);
+			REQUIRE(redPacket->GetPayloadLength() == 1 + 8);
+
+			fecPackets = fecEncoder.AddPacket(redPacket);
+		}
+
+		REQUIRE(fecPackets.size() == 1);
+
+		auto recovered = Recover(fecPackets[0], { &sentPackets[0] });
+
+		REQUIRE(recovered.byte1 == (0x80 | VideoPayloadType));
+		REQUIRE(recovered.data == sentPackets[1].data);
+	}
+
+	SECTION("no FEC packets with a zero protection factor")
+	{
+		UlpfecEncoder fecEncoder(RedPayloadType, UlpfecPayloadType);
+
+		for (uint16_t seq{ 1u }; seq <= 32u; ++seq)
+		{
+			PreparePacket(packet, seq, 100u, true);
+
+			REQUIRE(fecEncoder.AddPacket(packet).empty());
+		}
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		size_t numPackets{ 1000000u };
+		// Typical video packet and frame.
+		size_t payloadLength{ 1100u };
+		size_t packetsPerFrame{ 10u };
+		size_t numFecPackets{ 0u };
+		UlpfecEncoder fecEncoder(RedPayloadType, UlpfecPayloadType);
+
+		fecEncoder.SetProtectionFactor(0.5f);
+
+		auto start = std::chrono::system_clock::now();
+
+		for (size_t i{ 0u }; i < numPackets; ++i)
+		{
+			packet->SetSequenceNumber(static_cast<uint16_t>(i));
+			packet->SetMarker(i % packetsPerFrame == packetsPerFrame - 1);
+			packet->SetPayloadLength(payloadLength);
+
+			numFecPackets += fecEncoder.AddPacket(packet).size();
+		}
+
+		std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+		std::cout << "FEC encoding: \t" << numPackets * packet->GetSize() / dur.count() / 1e6
+		          << " MB/s of media (" << numFecPackets << " FEC packets)" << std::endl;
+	}
+#endif
+
+	delete packet;
+}
@@ -0,0 +1,104 @@
+#include "common.hpp"
+#include "LockFreeQueue.hpp"
+#include <catch2/catch.hpp>
+#include <thread>
+#include <vector>
+
+SCENARIO("Lock-free queue", "[lockfreequeue]")
+{
+	SECTION("items are popped in order and pushing fails once full")
+	{
+		LockFreeQueue<size_t> queue(3u);
+		size_t item;
+
+		REQUIRE(queue.GetCapacity() == 4u);
+		REQUIRE(!queue.Pop(item));
+
+		for (size_t i{ 0u }; i < 4u; ++i)
+		{
+			item = i;
+
+			REQUIRE(queue.Push(item));
+		}
+
+		item = 4u;
+
+		REQUIRE(!queue.Push(item));
+
+		for (size_t i{ 0u }; i < 4u; ++i)
+		{
+			REQUIRE(queue.Pop(item));
+			REQUIRE(item == i);
+		}
+
+		REQUIRE(!queue.Pop(item));
+	}
+
+	SECTION("items are filled and read in place")
+	{
+		LockFreeQueue<std::vector<uint8_t>> queue(2u);
+
+		REQUIRE(queue.PushInPlace([](std::vector<uint8_t>& slot) { slot.assign(3u, 0xAA); }));
+		REQUIRE(queue.PushInPlace([](std::vector<uint8_t>& slot) { slot.assign(1u, 0xBB); }));
+		REQUIRE(!queue.PushInPlace([](std::vector<uint8_t>& /*slot*/) { FAIL("queue is full"); }));
+
+		size_t len{ 0u };
+
+		REQUIRE(queue.PopInPlace([&len](std::vector<uint8_t>& slot) { len = slot.size(); }));
+		REQUIRE(len == 3u);
+		REQUIRE(queue.PopInPlace([&len](std::vector<uint8_t>& slot) { len = slot.size(); }));
+		REQUIRE(len == 1u);
+		REQUIRE(!queue.PopInPlace([](std::vector<uint8_t>& /*slot*/) { FAIL("queue is empty"); }));
+	}
+
+	SECTION("items pushed by several threads are all popped once")
+	{
+		static constexpr size_t NumThreads{ 4u };
+		static constexpr size_t NumItemsPerThread{ 10000u };
+
+		LockFreeQueue<size_t> queue(256u);
+		std::vector<std::thread> threads;
+		std::vector<size_t> counts(NumThreads * NumItemsPerThread, 0u);
+
+		for (size_t t{ 0u }; t < NumThreads; ++t)
+		{
+			threads.emplace_back(
+			  [&queue, t]()
+			  {
+				  for (size_t i{ 0u }; i < NumItemsPerThread; ++i)
+				  {
+					  size_t item = (t * NumItemsPerThread) + i;
+
+					  while (!queue.Push(item))
+					  {
+						  std::this_thread::yield();
+					  }
+				  }
+			  });
+		}
+
+		size_t popped{ 0u };
+		size_t item;
+
+		while (popped < counts.size())
+		{
+			if (queue.Pop(item))
+			{
+				++counts[item];
+				++popped;
+			}
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		REQUIRE(!queue.Pop(item));
+
+		for (auto count : counts)
+		{
+			REQUIRE(count == 1u);
+		}
+	}
+}
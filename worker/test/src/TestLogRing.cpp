@@ -0,0 +1,72 @@
+#include "common.hpp"
+#include "LogRing.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::strlen()
+#include <string>
+
+namespace
+{
+	enum class TestEnum : uint8_t
+	{
+		FOO = 7
+	};
+
+	template<typename... Args>
+	std::string Format(const char* format, Args... args)
+	{
+		LogRing::Entry entry; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		char buffer[1024];
+
+		LogRing::Encode(entry, format, args...);
+
+		size_t len = LogRing::Format(entry, buffer, sizeof(buffer));
+
+		REQUIRE(len == std::strlen(buffer));
+
+		return std::string(buffer, len);
+	}
+} // namespace
+
+SCENARIO("Log ring", "[logring]")
+{
+	SECTION("recorded arguments are formatted as printf() does")
+	{
+		std::string foo{ "foo" };
+
+		REQUIRE(Format("Dfoo::bar() | no args") == "Dfoo::bar() | no args");
+		REQUIRE(
+		  Format("%s::%s() | value:%" PRIu64, "RTC::Foo", "Bar", uint64_t{ 18446744073709551615u }) ==
+		  "RTC::Foo::Bar() | value:18446744073709551615");
+		REQUIRE(Format("%" PRIi8 ",%" PRIu16 ",%zu", int8_t{ -3 }, uint16_t{ 65535u }, size_t{ 12u }) ==
+		  "-3,65535,12");
+		REQUIRE(Format("%-5s|%5d|%05.1f|%#x|%c", foo.c_str(), 42, 3.14159, 255u, 'z') ==
+		  "foo  |   42|003.1|0xff|z");
+		REQUIRE(Format("%s %s", "true", static_cast<const char*>(nullptr)) ==
+		  "true (null)");
+		REQUIRE(Format("%.*s", 2, "abcdef") == "ab");
+		REQUIRE(Format("%" PRIu8 "%%", TestEnum::FOO) == "7%");
+	}
+
+	SECTION("missing and truncated arguments are printed as '?'")
+	{
+		std::string longString(LogRing::MaxArgsLen * 2, 'a');
+
+		REQUIRE(Format("%s and %d", "foo") == "foo and ?");
+
+		auto line = Format("%s|%d", longString.c_str(), 1);
+
+		// The string is truncated so it fits (with its type and NUL) in the entry.
+		REQUIRE(line == std::string(LogRing::MaxArgsLen - 2, 'a') + "|?");
+	}
+
+	SECTION("formatted line is truncated to the buffer size")
+	{
+		LogRing::Entry entry; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		char buffer[8];
+
+		LogRing::Encode(entry, "%s:%d", "abcdef", 1234);
+
+		REQUIRE(LogRing::Format(entry, buffer, sizeof(buffer)) == 7u);
+		REQUIRE(std::string(buffer) == "abcdef:");
+	}
+}
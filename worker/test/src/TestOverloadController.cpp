@@ -0,0 +1,95 @@
+#include "common.hpp"
+#include "OverloadController.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace
+{
+	class TestOverloadControllerListener : public OverloadController::Listener
+	{
+	public:
+		void OnOverloadControllerLevelChange(
+		  OverloadController* overloadController, size_t /*previousLevel*/) override
+		{
+			this->levels.push_back(overloadController->GetLevel());
+		}
+
+	public:
+		std::vector<size_t> levels;
+	};
+} // namespace
+
+SCENARIO("Overload controller", "[overload]")
+{
+	TestOverloadControllerListener listener;
+	std::vector<OverloadController::Step> steps{ OverloadController::Step::RETRANSMISSIONS,
+		                                           OverloadController::Step::LAYERS,
+		                                           OverloadController::Step::RTCP };
+
+	SECTION("steps are applied in order while overloaded and undone once relaxed")
+	{
+		OverloadController overloadController(&listener, 50u, 90u, steps);
+
+		REQUIRE(!OverloadController::IsStepApplied(OverloadController::Step::RETRANSMISSIONS));
+
+		// A single overloaded sample is not enough.
+		overloadController.ProcessSample(100u, 50u);
+
+		REQUIRE(overloadController.GetLevel() == 0u);
+
+		overloadController.ProcessSample(10u, 95u);
+
+		REQUIRE(overloadController.GetLevel() == 1u);
+		REQUIRE(OverloadController::IsStepApplied(OverloadController::Step::RETRANSMISSIONS));
+		REQUIRE(!OverloadController::IsStepApplied(OverloadController::Step::LAYERS));
+
+		for (size_t i{ 0u }; i < 10u; ++i)
+		{
+			overloadController.ProcessSample(100u, 100u);
+		}
+
+		REQUIRE(overloadController.GetLevel() == 3u);
+		REQUIRE(OverloadController::IsStepApplied(OverloadController::Step::RTCP));
+		REQUIRE(listener.levels == std::vector<size_t>{ 1u, 2u, 3u });
+
+		// Samples between the relax and overload thresholds keep the level.
+		for (size_t i{ 0u }; i < 10u; ++i)
+		{
+			overloadController.ProcessSample(30u, 50u);
+		}
+
+		REQUIRE(overloadController.GetLevel() == 3u);
+
+		for (size_t i{ 0u }; i < 8u; ++i)
+		{
+			overloadController.ProcessSample(0u, 10u);
+		}
+
+		REQUIRE(overloadController.GetLevel() == 2u);
+		REQUIRE(!OverloadController::IsStepApplied(OverloadController::Step::RTCP));
+		REQUIRE(OverloadController::IsStepApplied(OverloadController::Step::LAYERS));
+
+		json data = json::object();
+
+		overloadController.FillJson(data);
+
+		REQUIRE(data["level"] == 2u);
+		REQUIRE(data["appliedSteps"] == json::array({ "retransmissions", "layers" }));
+		REQUIRE(data["loopLag"] == 0u);
+		REQUIRE(data["loopBusy"] == 10u);
+	}
+
+	SECTION("steps are unapplied once the controller is destroyed")
+	{
+		{
+			OverloadController overloadController(&listener, 50u, 90u, steps);
+
+			overloadController.ProcessSample(100u, 100u);
+			overloadController.ProcessSample(100u, 100u);
+
+			REQUIRE(OverloadController::IsStepApplied(OverloadController::Step::RETRANSMISSIONS));
+		}
+
+		REQUIRE(!OverloadController::IsStepApplied(OverloadController::Step::RETRANSMISSIONS));
+	}
+}
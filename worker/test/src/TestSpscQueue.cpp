@@ -0,0 +1,92 @@
+#include "common.hpp"
+#include "SpscQueue.hpp"
+#include <catch2/catch.hpp>
+#include <thread>
+#include <vector>
+
+SCENARIO("SPSC queue", "[spscqueue]")
+{
+	SECTION("items are popped in order and pushing fails once full")
+	{
+		SpscQueue<size_t> queue(3u);
+		size_t item;
+
+		REQUIRE(queue.GetCapacity() == 4u);
+		REQUIRE(!queue.Pop(item));
+
+		for (size_t i{ 0u }; i < 4u; ++i)
+		{
+			item = i;
+
+			REQUIRE(queue.Push(item));
+		}
+
+		item = 4u;
+
+		REQUIRE(!queue.Push(item));
+
+		for (size_t i{ 0u }; i < 4u; ++i)
+		{
+			REQUIRE(queue.Pop(item));
+			REQUIRE(item == i);
+		}
+
+		REQUIRE(!queue.Pop(item));
+	}
+
+	SECTION("items are filled and read in place")
+	{
+		SpscQueue<std::vector<uint8_t>> queue(2u);
+
+		REQUIRE(queue.PushInPlace([](std::vector<uint8_t>& slot) { slot.assign(3u, 0xAA); }));
+		REQUIRE(queue.PushInPlace([](std::vector<uint8_t>& slot) { slot.assign(1u, 0xBB); }));
+		REQUIRE(!queue.PushInPlace([](std::vector<uint8_t>& /*slot*/) { FAIL("queue is full"); }));
+
+		size_t len{ 0u };
+
+		REQUIRE(queue.PopInPlace([&len](std::vector<uint8_t>& slot) { len = slot.size(); }));
+		REQUIRE(len == 3u);
+		REQUIRE(queue.PopInPlace([&len](std::vector<uint8_t>& slot) { len = slot.size(); }));
+		REQUIRE(len == 1u);
+		REQUIRE(!queue.PopInPlace([](std::vector<uint8_t>& /*slot*/) { FAIL("queue is empty"); }));
+	}
+
+	SECTION("items pushed by another thread are popped in order")
+	{
+		static constexpr size_t NumItems{ 100000u };
+
+		SpscQueue<size_t> queue(64u);
+
+		std::thread producer(
+		  [&queue]()
+		  {
+			  for (size_t i{ 0u }; i < NumItems; ++i)
+			  {
+				  size_t item = i;
+
+				  while (!queue.Push(item))
+				  {
+					  std::this_thread::yield();
+				  }
+			  }
+		  });
+
+		size_t popped{ 0u };
+		size_t item;
+		bool ordered{ true };
+
+		while (popped < NumItems)
+		{
+			if (queue.Pop(item))
+			{
+				ordered = ordered && item == popped;
+				++popped;
+			}
+		}
+
+		producer.join();
+
+		REQUIRE(ordered);
+		REQUIRE(!queue.Pop(item));
+	}
+}
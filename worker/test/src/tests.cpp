@@ -8,6 +8,7 @@
 #include "LogLevel.hpp"
 #include "Settings.hpp"
 #include "Utils.hpp"
+#include "RTC/DtlsTransport.hpp"
 #include <catch2/catch.hpp>
 #include <cstdlib> // std::getenv()
 
@@ -35,6 +36,7 @@ int main(int argc, char* argv[])
 	DepUsrSCTP::ClassInit();
 	DepLibWebRTC::ClassInit();
 	Utils::Crypto::ClassInit();
+	RTC::DtlsTransport::ClassInit();
 
 	int status = Catch::Session().run(argc, argv);
 
@@ -42,6 +44,7 @@ int main(int argc, char* argv[])
 	DepLibSRTP::ClassDestroy();
 	Utils::Crypto::ClassDestroy();
 	DepLibWebRTC::ClassDestroy();
+	RTC::DtlsTransport::ClassDestroy();
 	DepUsrSCTP::ClassDestroy();
 	DepLibUV::ClassDestroy();
 